@@ -0,0 +1,73 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+package org.theko.sound.benchmarks;
+
+import static org.theko.sound.benchmarks.BenchmarkSignals.CHANNELS;
+import static org.theko.sound.benchmarks.BenchmarkSignals.FRAMES;
+
+import java.util.concurrent.TimeUnit;
+
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OperationsPerInvocation;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.theko.sound.util.AudioBufferUtilities;
+
+/**
+ * The gain, pan and level helpers of {@link AudioBufferUtilities}, in ns/frame.
+ *
+ * @since 0.3.1-beta
+ * @author Theko
+ */
+@State(Scope.Thread)
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.NANOSECONDS)
+@OperationsPerInvocation(FRAMES)
+public class AudioBufferUtilitiesBenchmark {
+
+    private float[][] samples;
+    private float[][] output;
+
+    @Setup
+    public void setup() {
+        samples = BenchmarkSignals.noise(CHANNELS, FRAMES);
+        output = new float[CHANNELS][FRAMES];
+    }
+
+    @Benchmark
+    public float[][] adjustGainAndPan() {
+        AudioBufferUtilities.adjustGainAndPan(samples, output, 0.8f, 0.25f);
+        return output;
+    }
+
+    @Benchmark
+    public float getAbsMaxVolume() {
+        return AudioBufferUtilities.getAbsMaxVolume(samples);
+    }
+
+    @Benchmark
+    public float[][] mixAdd() {
+        AudioBufferUtilities.mixAdd(samples, output, 0.5f);
+        return output;
+    }
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+package org.theko.sound.benchmarks;
+
+import static org.theko.sound.benchmarks.BenchmarkSignals.CHANNELS;
+import static org.theko.sound.benchmarks.BenchmarkSignals.FRAMES;
+import static org.theko.sound.benchmarks.BenchmarkSignals.SAMPLE_RATE;
+
+import java.util.concurrent.TimeUnit;
+
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OperationsPerInvocation;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.theko.sound.AudioMixer;
+
+/**
+ * {@link AudioMixer#render} with several inputs that copy a prepared block, in ns/frame.
+ * The inputs cost next to nothing, so the result is the mixer's own overhead.
+ *
+ * @since 0.3.1-beta
+ * @author Theko
+ */
+@State(Scope.Thread)
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.NANOSECONDS)
+@OperationsPerInvocation(FRAMES)
+public class AudioMixerBenchmark {
+
+    @Param({"1", "8", "32"})
+    public int inputs;
+
+    private AudioMixer mixer;
+    private float[][] output;
+
+    @Setup
+    public void setup() {
+        float[][] block = BenchmarkSignals.noise(CHANNELS, FRAMES);
+        mixer = new AudioMixer();
+        for (int i = 0; i < inputs; i++) {
+            mixer.addInput((samples, sampleRate) -> {
+                for (int ch = 0; ch < samples.length; ch++) {
+                    System.arraycopy(block[ch % CHANNELS], 0, samples[ch], 0, Math.min(FRAMES, samples[ch].length));
+                }
+            });
+        }
+        output = new float[CHANNELS][FRAMES];
+    }
+
+    @Benchmark
+    public float[][] render() {
+        mixer.render(output, SAMPLE_RATE);
+        return output;
+    }
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+package org.theko.sound.benchmarks;
+
+import java.util.SplittableRandom;
+
+/**
+ * Shared sizes and deterministic test signals of the benchmarks.
+ * <p>
+ * Block benchmarks process {@link #FRAMES} frames per invocation and declare it with
+ * {@code @OperationsPerInvocation}, so JMH reports nanoseconds and allocated bytes per frame.
+ *
+ * @since 0.3.1-beta
+ * @author Theko
+ */
+final class BenchmarkSignals {
+
+    static final int FRAMES = 2048;
+    static final int CHANNELS = 2;
+    static final int SAMPLE_RATE = 48000;
+
+    private BenchmarkSignals() {
+        throw new UnsupportedOperationException("This class cannot be instantiated.");
+    }
+
+    /**
+     * Returns white noise at -6 dBFS, the same for every run.
+     */
+    static float[][] noise(int channels, int frames) {
+        SplittableRandom random = new SplittableRandom(0x5EED);
+        float[][] samples = new float[channels][frames];
+        for (float[] channel : samples) {
+            for (int i = 0; i < frames; i++) {
+                channel[i] = (float) (random.nextDouble() - 0.5);
+            }
+        }
+        return samples;
+    }
+}
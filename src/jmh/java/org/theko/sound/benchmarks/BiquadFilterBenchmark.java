@@ -0,0 +1,89 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+package org.theko.sound.benchmarks;
+
+import static org.theko.sound.benchmarks.BenchmarkSignals.FRAMES;
+import static org.theko.sound.benchmarks.BenchmarkSignals.SAMPLE_RATE;
+
+import java.util.concurrent.TimeUnit;
+
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OperationsPerInvocation;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.theko.sound.dsp.BiquadFilter;
+import org.theko.sound.dsp.FilterType;
+
+/**
+ * {@link BiquadFilter#process} over a block, sample by sample and with the block methods, in ns/frame.
+ *
+ * @since 0.3.1-beta
+ * @author Theko
+ */
+@State(Scope.Thread)
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.NANOSECONDS)
+@OperationsPerInvocation(FRAMES)
+public class BiquadFilterBenchmark {
+
+    @Param({"LOWPASS", "PEAK"})
+    public FilterType type;
+
+    @Param({"2", "8"})
+    public int order;
+
+    private BiquadFilter filter;
+    private float[] block;
+    private float[][] stereo;
+
+    @Setup
+    public void setup() {
+        filter = new BiquadFilter(type, order);
+        filter.setParams(2000.0f, 0.707f, 1.5f);
+        filter.update(SAMPLE_RATE);
+        block = BenchmarkSignals.noise(1, FRAMES)[0];
+        stereo = BenchmarkSignals.noise(2, FRAMES);
+    }
+
+    @Benchmark
+    public float[] process() {
+        float[] block = this.block;
+        for (int i = 0; i < block.length; i++) {
+            block[i] = filter.process(block[i], SAMPLE_RATE);
+        }
+        return block;
+    }
+
+    @Benchmark
+    public float[] processBlock() {
+        filter.process(block, block, SAMPLE_RATE);
+        return block;
+    }
+
+    @Benchmark
+    @OperationsPerInvocation(2 * FRAMES)
+    public float[][] processStereoBlock() {
+        filter.process(stereo, SAMPLE_RATE);
+        return stereo;
+    }
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+package org.theko.sound.benchmarks;
+
+import java.util.Arrays;
+import java.util.concurrent.TimeUnit;
+
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OperationsPerInvocation;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.theko.sound.dsp.FFT;
+import org.theko.sound.dsp.FFTPlan;
+
+/**
+ * {@link FFT#fft} and the real-input {@link FFTPlan#forwardReal}, in ns per transform.
+ *
+ * @since 0.3.1-beta
+ * @author Theko
+ */
+@State(Scope.Thread)
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.NANOSECONDS)
+public class FFTBenchmark {
+
+    @Param({"512", "2048", "8192"})
+    public int size;
+
+    private float[] signal;
+    private float[] real;
+    private float[] imag;
+    private float[] binsReal;
+    private float[] binsImag;
+
+    @Setup
+    public void setup() {
+        signal = BenchmarkSignals.noise(1, size)[0];
+        real = new float[size];
+        imag = new float[size];
+        binsReal = new float[size / 2 + 1];
+        binsImag = new float[size / 2 + 1];
+        FFTPlan.of(size); // Exclude the table setup
+    }
+
+    @Benchmark
+    public float[] fft() {
+        System.arraycopy(signal, 0, real, 0, size);
+        Arrays.fill(imag, 0.0f);
+        FFT.fft(real, imag);
+        return real;
+    }
+
+    @Benchmark
+    public float[] forwardReal() {
+        FFTPlan.of(size).forwardReal(signal, binsReal, binsImag);
+        return binsReal;
+    }
+}
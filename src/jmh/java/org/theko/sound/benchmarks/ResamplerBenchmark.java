@@ -0,0 +1,95 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+package org.theko.sound.benchmarks;
+
+import static org.theko.sound.benchmarks.BenchmarkSignals.CHANNELS;
+import static org.theko.sound.benchmarks.BenchmarkSignals.FRAMES;
+
+import java.util.concurrent.TimeUnit;
+
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OperationsPerInvocation;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.theko.sound.resamplers.CubicResampler;
+import org.theko.sound.resamplers.KochanekBartelsResampler;
+import org.theko.sound.resamplers.LanczosResampler;
+import org.theko.sound.resamplers.LinearResampler;
+import org.theko.sound.resamplers.NearestResampler;
+import org.theko.sound.resamplers.PolyphaseResampler;
+import org.theko.sound.resamplers.Resampler;
+import org.theko.sound.resamplers.StreamingResampler;
+
+/**
+ * Every {@link Resampler} implementation on common rate conversions, in ns per output frame.
+ *
+ * @since 0.3.1-beta
+ * @author Theko
+ */
+@State(Scope.Thread)
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.NANOSECONDS)
+@OperationsPerInvocation(FRAMES)
+public class ResamplerBenchmark {
+
+    @Param({"nearest", "linear", "cubic", "lanczos", "kochanekBartels", "polyphase"})
+    public String method;
+
+    /** Source and target rate. */
+    @Param({"44100:48000", "48000:44100", "48000:96000"})
+    public String rates;
+
+    private Resampler resampler;
+    private float[][] input;
+    private float[][] output;
+
+    @Setup
+    public void setup() {
+        String[] parts = rates.split(":");
+        int sourceRate = Integer.parseInt(parts[0]);
+        int targetRate = Integer.parseInt(parts[1]);
+
+        resampler = switch (method) {
+            case "nearest" -> new NearestResampler();
+            case "linear" -> new LinearResampler();
+            case "cubic" -> new CubicResampler();
+            case "lanczos" -> new LanczosResampler();
+            case "kochanekBartels" -> new KochanekBartelsResampler();
+            case "polyphase" -> new PolyphaseResampler();
+            default -> throw new IllegalArgumentException("Unknown resampler: " + method);
+        };
+        if (resampler instanceof StreamingResampler streaming) {
+            resampler = streaming.newStream();
+        }
+
+        int sourceFrames = (int) Math.round((double) FRAMES * sourceRate / targetRate);
+        input = BenchmarkSignals.noise(CHANNELS, sourceFrames);
+        output = new float[CHANNELS][FRAMES];
+    }
+
+    @Benchmark
+    public float[][] resample() {
+        resampler.resample(input, output, FRAMES);
+        return output;
+    }
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+package org.theko.sound.benchmarks;
+
+import static org.theko.sound.benchmarks.BenchmarkSignals.CHANNELS;
+import static org.theko.sound.benchmarks.BenchmarkSignals.FRAMES;
+import static org.theko.sound.benchmarks.BenchmarkSignals.SAMPLE_RATE;
+
+import java.util.concurrent.TimeUnit;
+
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OperationsPerInvocation;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.theko.sound.AudioFormat;
+import org.theko.sound.samples.SamplesConverter;
+
+/**
+ * {@link SamplesConverter} between planar floats and interleaved PCM, in ns/frame.
+ *
+ * @since 0.3.1-beta
+ * @author Theko
+ */
+@State(Scope.Thread)
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.NANOSECONDS)
+@OperationsPerInvocation(FRAMES)
+public class SamplesConverterBenchmark {
+
+    @Param({"PCM_SIGNED:16", "PCM_SIGNED:24", "PCM_FLOAT:32", "PCM_UNSIGNED:8"})
+    public String format;
+
+    private AudioFormat audioFormat;
+    private float[][] samples;
+    private float[][] decoded;
+    private byte[] bytes;
+
+    @Setup
+    public void setup() {
+        String[] parts = format.split(":");
+        audioFormat = new AudioFormat(SAMPLE_RATE, Integer.parseInt(parts[1]), CHANNELS,
+                AudioFormat.Encoding.valueOf(parts[0]), false);
+        samples = BenchmarkSignals.noise(CHANNELS, FRAMES);
+        decoded = new float[CHANNELS][FRAMES];
+        bytes = SamplesConverter.toBytes(samples, audioFormat);
+    }
+
+    @Benchmark
+    public byte[] toBytes() {
+        SamplesConverter.toBytes(samples, bytes, audioFormat);
+        return bytes;
+    }
+
+    @Benchmark
+    public float[][] toSamples() {
+        SamplesConverter.toSamples(bytes, decoded, audioFormat);
+        return decoded;
+    }
+}
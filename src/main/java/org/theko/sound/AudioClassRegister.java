@@ -26,6 +26,8 @@ import org.theko.sound.backends.AudioBackend;
 import org.theko.sound.backends.AudioBackends;
 import org.theko.sound.backends.dummy.DummyAudioBackend;
 import org.theko.sound.backends.javasound.JavaSoundBackend;
+import org.theko.sound.backends.pulseaudio.PulseAudioBackend;
+import org.theko.sound.backends.wasapi.WASAPIExclusiveBackend;
 import org.theko.sound.backends.wasapi.WASAPISharedBackend;
 import org.theko.sound.codecs.AudioCodec;
 import org.theko.sound.codecs.AudioCodecs;
@@ -52,6 +54,8 @@ public final class AudioClassRegister {
     private static final Set<Class<? extends AudioBackend>> definedBackends = Set.of(
         JavaSoundBackend.class,
         WASAPISharedBackend.class,
+        WASAPIExclusiveBackend.class,
+        PulseAudioBackend.class,
         DummyAudioBackend.class
     );
 
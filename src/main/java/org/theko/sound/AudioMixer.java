@@ -17,6 +17,7 @@
 package org.theko.sound;
 
 import static org.theko.sound.properties.AudioSystemProperties.MIXER_DEFAULT_ENABLE_EFFECTS;
+import static org.theko.sound.properties.AudioSystemProperties.MIXER_DEFAULT_PARALLEL_RENDER;
 import static org.theko.sound.properties.AudioSystemProperties.MIXER_DEFAULT_REVERSE_POLARITY;
 import static org.theko.sound.properties.AudioSystemProperties.MIXER_DEFAULT_SWAP_CHANNELS;
 
@@ -24,6 +25,9 @@ import java.util.ArrayList;
 import java.util.Arrays;
 import java.util.Collections;
 import java.util.List;
+import java.util.concurrent.ForkJoinTask;
+import java.util.concurrent.RecursiveAction;
+import java.util.concurrent.atomic.AtomicLong;
 
 import org.slf4j.Logger;
 import org.slf4j.LoggerFactory;
@@ -36,6 +40,7 @@ import org.theko.sound.effects.IncompatibleEffectTypeException;
 import org.theko.sound.effects.MultipleVaryingSizeEffectsException;
 import org.theko.sound.effects.VaryingSizeEffect;
 import org.theko.sound.samples.SamplesValidation;
+import org.theko.sound.util.AudioBufferPool;
 import org.theko.sound.util.AudioBufferUtilities;
 
 
@@ -51,6 +56,8 @@ import org.theko.sound.util.AudioBufferUtilities;
  *   <li>Support for pre-gain and post-gain adjustment, pan, and stereo separation.</li>
  *   <li>Enable or disable effects processing, swap channels, and reverse polarity.</li>
  *   <li>Handles effects that require varying input/output buffer sizes.</li>
+ *   <li>Renders from scratch buffers of the thread's {@link AudioBufferPool}, so steady-state rendering does not allocate.</li>
+ *   <li>Optionally renders independent inputs in parallel, see {@link #getParallelRenderControl()}.</li>
  *   <li>Ensures thread-safe and robust error handling for input and effect management.</li>
  * </ul>
  * <p>
@@ -87,19 +94,27 @@ public class AudioMixer implements AudioNode, Controllable {
     private final BooleanControl enableEffectsControl = new BooleanControl("Enable Effects", MIXER_DEFAULT_ENABLE_EFFECTS);
     private final BooleanControl swapChannelsControl = new BooleanControl("Swap Channels", MIXER_DEFAULT_SWAP_CHANNELS);
     private final BooleanControl reversePolarityControl = new BooleanControl("Reverse Polarity", MIXER_DEFAULT_REVERSE_POLARITY);
+    private final BooleanControl parallelRenderControl = new BooleanControl("Parallel Render", MIXER_DEFAULT_PARALLEL_RENDER);
 
     private final List<AudioControl> mixerControls = List.of(
         preGainControl, postGainControl, panControl,
         enableEffectsControl,
-        swapChannelsControl, reversePolarityControl
+        swapChannelsControl, reversePolarityControl,
+        parallelRenderControl
     );
 
+    /** Bumped on any input or effect change of any mixer, render plans compiled before are stale. */
+    private static final AtomicLong topologyVersion = new AtomicLong();
+
+    private MixerRenderPlan renderPlan = null;
+    private GroupTask[] groupTasks = null;
+    private final RenderAllTask renderAllTask = new RenderAllTask();
+    private int renderSampleRate;
+
     private CollectedInputs collectedInputs = null;
     private float[][][] inputBuffers = null;
     private boolean[] validInputs = null;
 
-    private float[][] mixedBuffer = null;
-
     /**
      * Adds an audio input to the mixer.
      *
@@ -131,6 +146,7 @@ public class AudioMixer implements AudioNode, Controllable {
         }
 
         inputs.add(input);
+        topologyVersion.incrementAndGet();
     }
 
     private boolean hasMixer(AudioMixer mixer) {
@@ -169,6 +185,7 @@ public class AudioMixer implements AudioNode, Controllable {
             throw new MultipleVaryingSizeEffectsException();
         }
         effects.add(effect);
+        topologyVersion.incrementAndGet();
     }
 
     /**
@@ -205,7 +222,9 @@ public class AudioMixer implements AudioNode, Controllable {
             logger.error("Attempted to remove null input from AudioMixer");
             throw new IllegalArgumentException("Input cannot be null");
         }
-        return inputs.remove(input);
+        boolean removed = inputs.remove(input);
+        topologyVersion.incrementAndGet();
+        return removed;
     }
 
     /**
@@ -219,7 +238,9 @@ public class AudioMixer implements AudioNode, Controllable {
             logger.error("Attempted to remove null effect from AudioMixer");
             throw new IllegalArgumentException("Effect cannot be null");
         }
-        return effects.remove(effect);
+        boolean removed = effects.remove(effect);
+        topologyVersion.incrementAndGet();
+        return removed;
     }
 
     /**
@@ -300,6 +321,24 @@ public class AudioMixer implements AudioNode, Controllable {
         return reversePolarityControl;
     }
 
+    /**
+     * Gets the parallel render control of the mixer.
+     * <p>
+     * When enabled, inputs that do not share any node are rendered concurrently on a
+     * work-stealing pool (see {@code org.theko.sound.mixer.renderThreads}), and the mixer
+     * waits for all of them before mixing. Inputs are still summed in index order,
+     * so the output is the same as with serial rendering. Nested mixers with this control
+     * enabled split their own inputs over the same pool.
+     * <p>
+     * The dependency groups are compiled once per topology change. Input nodes that are
+     * not mixers must not share state with nodes of other inputs, other than through a {@link MixerSender}.
+     *
+     * @return the parallel render control
+     */
+    public BooleanControl getParallelRenderControl() {
+        return parallelRenderControl;
+    }
+
     /**
      * Returns an unmodifiable list of all audio controls managed by this mixer.
      * <p>
@@ -355,64 +394,79 @@ public class AudioMixer implements AudioNode, Controllable {
         int varyingSizeEffectIndex = getVaryingSizeEffectIndex();
 
         int channels = samples.length;
+        AudioBufferPool pool = AudioBufferPool.current();
         float[][] mixed = null;
 
-        // Process input and effects only if we have a positive input length
-        if (inputLength > 0) {
-            CollectedInputs collectedInputs = collectInputs(sampleRate, inputLength, channels);
-            try {
-                checkInputs(collectedInputs, inputLength, channels);
-            } catch (ChannelsCountMismatchException | LengthMismatchException ex) {
-                logger.error("Input channels or length mismatch.", ex);
-                throw new MixingException(ex);
-            }
-
-            // Mix all valid inputs together into the mixed buffer, applying pre-gain
-            mixed = mixInputs(collectedInputs, inputLength, channels);
-            AudioBufferUtilities.adjustGain(mixed, mixed, preGainControl.getValue());
-
-            if (enableEffectsControl.getValue()) {
-                // Process effects before the VaryingSizeEffect (if any)
-                // with the required input length for the varying size effect
-                int firstEffectsEnd = varyingSizeEffectIndex == -1 ? effects.size() : varyingSizeEffectIndex;
-                processEffectChain(mixed, sampleRate, 0, firstEffectsEnd);
+        try {
+            // Process input and effects only if we have a positive input length
+            if (inputLength > 0) {
+                CollectedInputs collectedInputs = collectInputs(pool, sampleRate, inputLength, channels);
+                try {
+                    checkInputs(collectedInputs, inputLength, channels);
+                    // Mix all valid inputs together into the mixed buffer, applying pre-gain
+                    mixed = mixInputs(pool, collectedInputs, inputLength, channels, preGainControl.getValue());
+                } catch (ChannelsCountMismatchException | LengthMismatchException ex) {
+                    logger.error("Input channels or length mismatch.", ex);
+                    throw new MixingException(ex);
+                } finally {
+                    releaseInputs(pool, collectedInputs);
+                }
 
-                if (varyingSizeEffectIndex != -1) {
-                    if (inputLength < outputLength) {
-                        mixed = AudioBufferUtilities.padArray(mixed, channels, outputLength, true /* fill new with last value */);
-                    }
-                    processEffect(mixed, sampleRate, effects.get(varyingSizeEffectIndex));
-                    // Cut the mixed buffer to the output length
-                    // if the varying size effect produced a longer buffer than the output
-                    if (inputLength > outputLength) {
-                        mixed = AudioBufferUtilities.cutArray(mixed, channels, outputLength);
+                if (enableEffectsControl.getValue()) {
+                    // Process effects before the VaryingSizeEffect (if any)
+                    // with the required input length for the varying size effect
+                    int firstEffectsEnd = varyingSizeEffectIndex == -1 ? effects.size() : varyingSizeEffectIndex;
+                    processEffectChain(mixed, sampleRate, 0, firstEffectsEnd);
+
+                    if (varyingSizeEffectIndex != -1) {
+                        if (inputLength < outputLength) {
+                            mixed = resize(pool, mixed, outputLength, true /* fill new with last value */);
+                        }
+                        processEffect(mixed, sampleRate, effects.get(varyingSizeEffectIndex));
+                        // Cut the mixed buffer to the output length
+                        // if the varying size effect produced a longer buffer than the output
+                        if (inputLength > outputLength) {
+                            mixed = resize(pool, mixed, outputLength, false);
+                        }
+                        // Process remaining effects
+                        processEffectChain(mixed, sampleRate, varyingSizeEffectIndex + 1, effects.size());
                     }
-                    // Process remaining effects
+                }
+            // Else if inputLength is zero, generate silence, and process effects if enabled
+            } else {
+                mixed = pool.borrowZeroed(channels, outputLength);
+                if (enableEffectsControl.getValue()) {
                     processEffectChain(mixed, sampleRate, varyingSizeEffectIndex + 1, effects.size());
                 }
             }
-        // Else if inputLength is zero, generate silence, and process effects if enabled
-        } else {
-            mixed = new float[channels][outputLength];
-            if (enableEffectsControl.getValue()) {
-                processEffectChain(mixed, sampleRate, varyingSizeEffectIndex + 1, effects.size());
+
+            if (swapChannelsControl.getValue()) {
+                AudioBufferUtilities.swapChannels(mixed, mixed);
+            }
+            if (reversePolarityControl.getValue()) {
+                AudioBufferUtilities.reversePolarity(mixed, mixed);
             }
-        }
 
-        if (swapChannelsControl.getValue()) {
-            AudioBufferUtilities.swapChannels(mixed, mixed);
-        }
-        if (reversePolarityControl.getValue()) {
-            AudioBufferUtilities.reversePolarity(mixed, mixed);
+            AudioBufferUtilities.adjustGainAndPan(mixed, mixed, postGainControl.getValue(), panControl.getValue());
+            try {
+                AudioBufferUtilities.copyArray(mixed, samples);
+            } catch (IllegalArgumentException ex) {
+                logger.error("Failed to copy mixed samples to output.", ex);
+                throw new MixingException(ex);
+            }
+        } finally {
+            pool.release(mixed);
         }
+    }
 
-        AudioBufferUtilities.adjustGainAndPan(mixed, mixed, postGainControl.getValue(), panControl.getValue());
-        try {
-            AudioBufferUtilities.copyArray(mixed, samples);
-        } catch (IllegalArgumentException ex) {
-            logger.error("Failed to copy mixed samples to output.", ex);
-            throw new MixingException(ex);
-        }
+    /**
+     * Moves the mixed samples into a pooled buffer of another length, releasing the old one.
+     */
+    private static float[][] resize(AudioBufferPool pool, float[][] mixed, int frames, boolean fillNewWithLast) {
+        float[][] resized = pool.borrow(mixed.length, frames);
+        AudioBufferUtilities.padArray(mixed, resized, fillNewWithLast);
+        pool.release(mixed);
+        return resized;
     }
 
     private int getTargetInputLength(int length) throws LengthMismatchException {
@@ -438,17 +492,9 @@ public class AudioMixer implements AudioNode, Controllable {
         return length;
     }
 
-    private CollectedInputs collectInputs(int sampleRate, int frameCount, int channels) {
-        if (inputBuffers == null
-            || inputBuffers.length != inputs.size()
-            || (inputs.size() > 0 &&
-                (inputBuffers[0].length != channels || inputBuffers[0][0].length != frameCount))) {
-
-            inputBuffers = new float[inputs.size()][channels][frameCount];
-        } else {
-            for (int i = 0; i < inputs.size(); i++) {
-                AudioBufferUtilities.fill(inputBuffers[i], 0.0f);
-            }
+    private CollectedInputs collectInputs(AudioBufferPool pool, int sampleRate, int frameCount, int channels) {
+        if (inputBuffers == null || inputBuffers.length != inputs.size()) {
+            inputBuffers = new float[inputs.size()][][];
         }
         if (validInputs == null || validInputs.length != inputs.size()) {
             validInputs = new boolean[inputs.size()];
@@ -457,15 +503,16 @@ public class AudioMixer implements AudioNode, Controllable {
         }
 
         for (int i = 0; i < inputs.size(); i++) {
-            try {
-                if (inputs.get(i) == null) {
-                    logger.warn("Null input at index {}", i);
-                    continue;
-                }
-                inputs.get(i).render(inputBuffers[i], sampleRate);
-                validInputs[i] = true;
-            } catch (Exception ex) {
-                logger.warn("Render failed for input[{}]", i, ex);
+            // Borrowed for this render only, the shape follows the requested input length
+            inputBuffers[i] = pool.borrowZeroed(channels, frameCount);
+        }
+
+        MixerRenderPlan plan = parallelRenderControl.getValue() ? getRenderPlan() : null;
+        if (plan != null && plan.getGroupCount() > 1) {
+            renderParallel(sampleRate);
+        } else {
+            for (int i = 0; i < inputs.size(); i++) {
+                renderInput(i, sampleRate);
             }
         }
 
@@ -478,6 +525,92 @@ public class AudioMixer implements AudioNode, Controllable {
         return collectedInputs;
     }
 
+    private void renderInput(int index, int sampleRate) {
+        AudioNode input = inputs.get(index);
+        try {
+            if (input == null) {
+                logger.warn("Null input at index {}", index);
+                return;
+            }
+            input.render(inputBuffers[index], sampleRate);
+            validInputs[index] = true;
+        } catch (Exception ex) {
+            logger.warn("Render failed for input[{}]", index, ex);
+        }
+    }
+
+    private MixerRenderPlan getRenderPlan() {
+        long version = topologyVersion.get();
+        MixerRenderPlan plan = renderPlan;
+        if (plan == null || !plan.isValid(version, inputs.size())) {
+            plan = MixerRenderPlan.compile(inputs, version);
+            renderPlan = plan;
+            groupTasks = new GroupTask[plan.getGroupCount()];
+            for (int g = 0; g < groupTasks.length; g++) {
+                groupTasks[g] = new GroupTask(plan.getGroup(g));
+            }
+            logger.debug("Compiled render plan: {} inputs in {} independent groups.", inputs.size(), plan.getGroupCount());
+        }
+        return plan;
+    }
+
+    /**
+     * Renders the inputs of one group of the render plan, in index order.
+     */
+    private final class GroupTask extends RecursiveAction {
+
+        private final int[] group;
+
+        GroupTask(int[] group) {
+            this.group = group;
+        }
+
+        @Override
+        protected void compute() {
+            for (int index : group) {
+                renderInput(index, renderSampleRate);
+            }
+        }
+    }
+
+    /**
+     * Forks all group tasks and joins them, the barrier of one render.
+     */
+    private final class RenderAllTask extends RecursiveAction {
+
+        @Override
+        protected void compute() {
+            ForkJoinTask.invokeAll(groupTasks);
+        }
+    }
+
+    /**
+     * Renders each group of the plan as a task of the render pool and waits for all of them.
+     * Every input writes only its own buffer and validity flag, the join publishes them to this thread.
+     * The tasks are kept with the plan and reinitialized for each render.
+     */
+    private void renderParallel(int sampleRate) {
+        renderSampleRate = sampleRate;
+        for (GroupTask task : groupTasks) {
+            task.reinitialize();
+        }
+        if (MixerRenderPool.isWorkerThread()) {
+            ForkJoinTask.invokeAll(groupTasks);
+        } else {
+            // Not a worker, forking here would use the common pool
+            renderAllTask.reinitialize();
+            MixerRenderPool.get().invoke(renderAllTask);
+        }
+    }
+
+    private void releaseInputs(AudioBufferPool pool, CollectedInputs collectedInputs) {
+        float[][][] buffers = collectedInputs.inputs;
+        for (int i = 0; i < buffers.length; i++) {
+            pool.release(buffers[i]);
+            buffers[i] = null;
+        }
+    }
+
     private void checkInputs(CollectedInputs collectedInputs, int frameCount, int channels) throws ChannelsCountMismatchException, LengthMismatchException {
         if (collectedInputs == null) {
             throw new NullPointerException("Collected inputs cannot be null.");
@@ -504,21 +637,13 @@ public class AudioMixer implements AudioNode, Controllable {
         }
     }
 
-    private float[][] mixInputs(CollectedInputs collectedInputs, int frameCount, int channels) {
-        if (mixedBuffer == null || mixedBuffer.length != channels || mixedBuffer[0].length != frameCount) {
-            mixedBuffer = new float[channels][frameCount];
-        } else {
-            AudioBufferUtilities.fill(mixedBuffer, 0.0f);
-        }
+    private float[][] mixInputs(AudioBufferPool pool, CollectedInputs collectedInputs, int frameCount, int channels, float gain) {
+        float[][] mixedBuffer = pool.borrowZeroed(channels, frameCount);
 
         for (int i = 0; i < collectedInputs.inputs.length; i++) {
             if (!collectedInputs.validInputs[i]) continue;
-            for (int ch = 0; ch < channels; ch++) {
-                for (int frame = 0; frame < collectedInputs.inputs[i][ch].length; frame++) {
-                    // Allow out of range (-1, +1) values
-                    mixedBuffer[ch][frame] += collectedInputs.inputs[i][ch][frame];
-                }
-            }
+            // Pre-gain is applied while accumulating, out of range (-1, +1) values are allowed
+            AudioBufferUtilities.mixAdd(collectedInputs.inputs[i], mixedBuffer, gain);
         }
 
         return mixedBuffer;
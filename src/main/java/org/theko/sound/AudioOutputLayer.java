@@ -18,15 +18,22 @@ package org.theko.sound;
 
 import static org.theko.sound.properties.AudioSystemProperties.AOL_DEFAULT_BUFFER;
 import static org.theko.sound.properties.AudioSystemProperties.AOL_ENABLE_SHUTDOWN_HOOK;
+import static org.theko.sound.properties.AudioSystemProperties.AOL_ENGINE_CONVERSION;
 import static org.theko.sound.properties.AudioSystemProperties.AOL_IGNORE_PLAYBACK_EXCEPTIONS;
+import static org.theko.sound.properties.AudioSystemProperties.AOL_LOW_LATENCY;
 import static org.theko.sound.properties.AudioSystemProperties.AOL_MAX_LENGTH_MISMATCHES;
 import static org.theko.sound.properties.AudioSystemProperties.AOL_MAX_WRITE_ERRORS;
 import static org.theko.sound.properties.AudioSystemProperties.AOL_PLAYBACK_STOP_TIMEOUT;
 import static org.theko.sound.properties.AudioSystemProperties.AOL_PLAYBACK_THREAD;
+import static org.theko.sound.properties.AudioSystemProperties.AOL_PULL_MODE;
+import static org.theko.sound.properties.AudioSystemProperties.AOL_RENDER_AHEAD;
 import static org.theko.sound.properties.AudioSystemProperties.AOL_RESAMPLER;
 import static org.theko.sound.properties.AudioSystemProperties.AOL_RESET_LENGTH_MISMATCHES;
 import static org.theko.sound.properties.AudioSystemProperties.AOL_RESET_WRITE_ERRORS;
+import static org.theko.sound.properties.AudioSystemProperties.AOL_SHARED_SESSION;
 
+import java.nio.ByteBuffer;
+import java.util.Optional;
 import java.util.concurrent.atomic.AtomicBoolean;
 import java.util.concurrent.atomic.AtomicInteger;
 import java.util.concurrent.atomic.AtomicReference;
@@ -42,6 +49,9 @@ import org.theko.sound.backends.AudioBackendInfo;
 import org.theko.sound.backends.AudioBackendNotFoundException;
 import org.theko.sound.backends.AudioBackends;
 import org.theko.sound.backends.AudioOutputBackend;
+import org.theko.sound.backends.AudioRenderCallback;
+import org.theko.sound.backends.AudioTimestamp;
+import org.theko.sound.backends.BackendTelemetry;
 import org.theko.sound.backends.BackendNotOpenException;
 import org.theko.sound.backends.DeviceInactiveException;
 import org.theko.sound.backends.DeviceInvalidatedException;
@@ -75,6 +85,18 @@ import org.theko.sound.util.TimeUtilities;
  * Also, this class adds a shutdown hook to close the audio output when the
  * JVM is shut down, ensuring proper cleanup.
  * <p>
+ * The backend is opened with room for {@code org.theko.sound.outputLayer.renderAhead}
+ * render buffers (one by default). More buffers let the playback thread render ahead of
+ * the device and absorb scheduling jitter, at the cost of latency.
+ * Non-blocking backends (partial writes) are supported.
+ * <p>
+ * If {@code org.theko.sound.outputLayer.pullMode} is enabled and the backend
+ * supports it, no playback thread is created: the backend's own render thread
+ * requests audio data from this layer through an {@link AudioRenderCallback}.
+ * <p>
+ * Every rendered block is timed per stage (render, resample, convert, write), see
+ * {@link #getTelemetry()}, which also returns the glitch counters of the backend stream.
+ * <p>
  * Usage example:
  * <pre>{@code
  * try (AudioOutputLayer aol = new AudioOutputLayer()) {
@@ -114,6 +136,7 @@ public class AudioOutputLayer implements AutoCloseable,
     private final AudioOutputBackend aob;
     private AudioPort openedPort;
     private AtomicInteger writeFailures = new AtomicInteger(0);
+    private final OutputLayerTelemetry.Recorder telemetry = new OutputLayerTelemetry.Recorder();
 
     /* Audio formats, open-computed lengths */
     private AudioFormat sourceFormat;
@@ -129,6 +152,8 @@ public class AudioOutputLayer implements AutoCloseable,
     private AudioNode rootNode;
     private boolean isPlaying;
     private boolean isPlaybackInterrupted;
+    private boolean isPullMode;
+    private boolean isSharedSession;
     private float resamplingFactor = 1.0f;
     private ResamplingProcessor resampler;
 
@@ -195,6 +220,14 @@ public class AudioOutputLayer implements AutoCloseable,
         return new OutputLayerEvent(this, outBufferSize);
     }
 
+    /**
+     * Event for the backend's render thread. Does not query the backend,
+     * which may be blocked waiting for this thread to finish.
+     */
+    private OutputLayerEvent getRenderThreadEvent() {
+        return new OutputLayerEvent(this, outputBufferSize);
+    }
+
     /**
      * Constructs an {@code AudioOutputLayer} with the default audio output backend for the platform.
      *
@@ -254,7 +287,19 @@ public class AudioOutputLayer implements AutoCloseable,
         }
 
         this.sourceFormat = audioFormat;
-        AudioFormat selectedFormat = findFormat(targetPort, audioFormat);
+        this.isSharedSession = applySharedSession();
+        boolean isEngineConversion = applyEngineConversion();
+        // A shared session always runs in the mix format of the port,
+        // with engine conversion the backend takes the source format as is
+        AudioFormat selectedFormat;
+        if (isSharedSession && targetPort.getMixFormat() != null) {
+            selectedFormat = targetPort.getMixFormat();
+        } else if (isEngineConversion) {
+            selectedFormat = audioFormat;
+            logger.debug("Audio format conversion is done by the audio engine.");
+        } else {
+            selectedFormat = findFormat(targetPort, audioFormat);
+        }
         if (!selectedFormat.equals(sourceFormat)) {
             resamplingFactor = (float) sourceFormat.getSampleRate() / (float) selectedFormat.getSampleRate();
             logger.debug(
@@ -264,6 +309,7 @@ public class AudioOutputLayer implements AutoCloseable,
             this.resamplingFactor = 1.0f;
         }
 
+        bufferSizeInFrames = alignToDevicePeriod(targetPort, selectedFormat, bufferSizeInFrames);
         calculateLengths(sourceFormat, selectedFormat, bufferSizeInFrames);
 
         String renderBufferSizeStr;
@@ -282,7 +328,7 @@ public class AudioOutputLayer implements AutoCloseable,
         outputLog.append("  Buffer time: ").append(FormatUtilities.formatTime(bufferTimeMicros*1000, TIME_FORMAT_PRECISION)).append(".\n");
 
         try {
-            this.openedFormat = aob.open(targetPort, selectedFormat, rawLength);
+            this.openedFormat = aob.open(targetPort, selectedFormat, rawLength * AOL_RENDER_AHEAD);
             if (openedFormat == null) {
                 throw new AudioBackendException("Failed to open audio output. Port: " + targetPort + ", format: " + openedFormat);
             }
@@ -295,8 +341,11 @@ public class AudioOutputLayer implements AutoCloseable,
         if (!openedFormat.equals(selectedFormat)) {
             logger.info("Selected format ({}) does not match opened format ({}).", selectedFormat, openedFormat);
             logger.debug("Re-calculating lengths with opened format...");
+            resamplingFactor = (float) sourceFormat.getSampleRate() / (float) openedFormat.getSampleRate();
             calculateLengths(sourceFormat, openedFormat, bufferSizeInFrames);
         }
+        // A streaming resampler must not continue the previous stream
+        resampler.reset();
 
         outputLog.append("  Opened Format: ").append(openedFormat.toString()).append(",\n");
 
@@ -304,17 +353,19 @@ public class AudioOutputLayer implements AutoCloseable,
         outputBufferSizeStr = AudioMeasure.ofFrames(outputBufferSize).onFormat(selectedFormat).getDetailedString();
 
         long driverLatency = aob.getMicrosecondLatency();
-        latencyMicros = bufferTimeMicros + driverLatency;
+        long queuedTimeMicros = getQueuedTimeMicros();
+        latencyMicros = queuedTimeMicros + driverLatency;
 
         String driverLatencyStr = (driverLatency > 0 ?
                 FormatUtilities.formatTime(driverLatency*1000, TIME_FORMAT_PRECISION) :
                 "N/A");
         outputLog.append("Latency info:\n");
         outputLog.append("  Latency (driver-only): ").append(driverLatencyStr).append(",\n");
-        outputLog.append("  Latency (buffer): ").append(FormatUtilities.formatTime(bufferTimeMicros*1000, TIME_FORMAT_PRECISION)).append(",\n");
+        outputLog.append("  Latency (backend buffer): ").append(FormatUtilities.formatTime(queuedTimeMicros*1000, TIME_FORMAT_PRECISION)).append(",\n");
         outputLog.append("  Effective latency: ").append(FormatUtilities.formatTime(latencyMicros*1000, TIME_FORMAT_PRECISION)).append(".");
         logger.info("Output layer opened. {}", outputLog.toString());
 
+        telemetry.reset(bufferTimeMicros * 1000L);
         isOpened = true;
 
         if (reopen) {
@@ -362,6 +413,99 @@ public class AudioOutputLayer implements AutoCloseable,
         return targetFormat;
     }
 
+    /**
+     * If a shared session is requested and supported, makes the backend join the shared
+     * session of the port, so that layers on the same port are mixed natively into one device stream.
+     *
+     * @return True if the backend will open the stream in the shared session
+     */
+    private boolean applySharedSession() {
+        if (!aob.isSharedSessionSupported()) {
+            if (AOL_SHARED_SESSION) logger.debug("Shared session is not supported by {}.", aob.getClass().getSimpleName());
+            return false;
+        }
+        try {
+            aob.setSharedSession(AOL_SHARED_SESSION);
+            return AOL_SHARED_SESSION;
+        } catch (AudioBackendException ex) {
+            logger.warn("Failed to enable the shared session, the backend opens its own stream.", ex);
+            return false;
+        }
+    }
+
+    /**
+     * If engine conversion is requested and supported, makes the backend accept the source
+     * format as is and leave the resampling and channel conversion to the system audio engine.
+     *
+     * @return True if the backend will be opened with the source format
+     */
+    private boolean applyEngineConversion() {
+        if (!aob.isEngineConversionSupported()) {
+            if (AOL_ENGINE_CONVERSION) logger.debug("Engine conversion is not supported by {}.", aob.getClass().getSimpleName());
+            return false;
+        }
+        try {
+            aob.setEngineConversion(AOL_ENGINE_CONVERSION);
+            return AOL_ENGINE_CONVERSION;
+        } catch (AudioBackendException ex) {
+            logger.warn("Failed to enable engine conversion, the format is converted by the output layer.", ex);
+            return false;
+        }
+    }
+
+    /**
+     * If low latency is requested, enables the low-latency mode of the backend and rounds
+     * the render buffer to a whole number of device periods, so that every device period
+     * is filled by whole renders.
+     *
+     * @param targetPort The output port
+     * @param targetFormat The format the backend will be opened with
+     * @param bufferSizeInFrames The requested render buffer size, in source frames
+     * @return The aligned render buffer size, in source frames
+     */
+    private int alignToDevicePeriod(AudioPort targetPort, AudioFormat targetFormat, int bufferSizeInFrames) {
+        if (!aob.isLowLatencySupported()) {
+            if (AOL_LOW_LATENCY) logger.debug("Low latency is not supported by {}.", aob.getClass().getSimpleName());
+            return bufferSizeInFrames;
+        }
+        try {
+            aob.setLowLatency(AOL_LOW_LATENCY);
+            if (!AOL_LOW_LATENCY) return bufferSizeInFrames;
+
+            int periodFrames = aob.getPeriodFrames(targetPort, targetFormat);
+            if (periodFrames <= 0) return bufferSizeInFrames;
+
+            int outputFrames = (int)(bufferSizeInFrames / resamplingFactor);
+            int periods = Math.max(1, Math.round((float)outputFrames / periodFrames));
+            int aligned = Math.max(1, Math.round(periods * periodFrames * resamplingFactor));
+            if (aligned != bufferSizeInFrames) {
+                logger.debug("Render buffer aligned to {} device periods of {} frames: {} -> {} frames.",
+                        periods, periodFrames, bufferSizeInFrames, aligned);
+            }
+            return aligned;
+        } catch (AudioBackendException ex) {
+            logger.warn("Failed to get the device period, render buffer is not aligned.", ex);
+            return bufferSizeInFrames;
+        }
+    }
+
+    /**
+     * Returns the time of audio the opened backend buffer holds, or the requested
+     * render-ahead time if the backend does not report its buffer size.
+     */
+    private long getQueuedTimeMicros() {
+        long requestedMicros = bufferTimeMicros * AOL_RENDER_AHEAD;
+        try {
+            int bufferBytes = aob.getBufferSize();
+            if (bufferBytes <= 0) return requestedMicros;
+            return AudioUnitsConverter.framesToMicroseconds(
+                bufferBytes / openedFormat.getFrameSize(), (int) openedFormat.getSampleRate());
+        } catch (AudioBackendException ex) {
+            logger.debug("Failed to get the backend buffer size.", ex);
+            return requestedMicros;
+        }
+    }
+
     private void calculateLengths(AudioFormat sourceFormat, AudioFormat targetFormat, int bufferSizeInFrames) {
         double resamplingFactor = (double)sourceFormat.getSampleRate() / (double)targetFormat.getSampleRate();
         this.renderBufferSize = bufferSizeInFrames;
@@ -437,6 +581,9 @@ public class AudioOutputLayer implements AutoCloseable,
      * Starts the audio output, processing audio data from the root node.
      * Creates a playback thread and starts it.
      * The thread is set as a daemon thread to not block JVM exit.
+     * <p>
+     * In pull mode, the render callback is passed to the backend instead,
+     * and no playback thread is created.
      *
      * @throws AudioBackendException If an error occurs while starting the backend
      * @throws RuntimeException If the playback thread cannot be started
@@ -446,6 +593,24 @@ public class AudioOutputLayer implements AutoCloseable,
         if (!isOpened) {
             throw new BackendNotOpenException("Audio output layer is not open.");
         }
+
+        // Streams in a shared session are mixed by the backend, they are always pushed
+        if (AOL_PULL_MODE && aob.isPullModeSupported() && !isSharedSession) {
+            aob.setRenderCallback(new PullRenderer());
+            try {
+                aob.start();
+            } catch (AudioBackendException ex) {
+                aob.setRenderCallback(null);
+                throw ex;
+            }
+            isPullMode = true;
+            writeFailures.set(0);
+            isPlaying = true;
+            logger.trace("Started AOL in pull mode.");
+            eventDispatcher.dispatch(OutputLayerEventType.START, getEvent());
+            return;
+        }
+
         aob.start();
 
         playbackThread = ThreadUtilities.startThread(
@@ -472,6 +637,15 @@ public class AudioOutputLayer implements AutoCloseable,
      */
     public void stop() throws AudioBackendException {
         if (!isPlaying) return;
+        if (isPullMode) {
+            aob.stop(); // Joins the backend's render thread
+            aob.setRenderCallback(null);
+            isPullMode = false;
+            isPlaying = false;
+            logger.trace("Stopped AOL (pull mode).");
+            eventDispatcher.dispatch(OutputLayerEventType.STOP, getEvent());
+            return;
+        }
         isPlaybackInterrupted = true;
         if (playbackThread != null && playbackThread.isAlive()) {
             playbackThread.interrupt();
@@ -523,6 +697,7 @@ public class AudioOutputLayer implements AutoCloseable,
             }
         }
         isOpened = false;
+        isSharedSession = false;
         logger.debug("Closed");
         eventDispatcher.dispatch(OutputLayerEventType.CLOSE, getEvent());
     }
@@ -647,6 +822,37 @@ public class AudioOutputLayer implements AutoCloseable,
         return aob.getMicrosecondPosition();
     }
 
+    /**
+     * Returns the latest clock reading of the audio output, see {@link AudioOutputBackend#getTimestamp()}.
+     * Schedulers can compute drift and fill level from it without polling the position.
+     * @return The latest timestamp, or empty if the backend does not provide one
+     * @throws AudioBackendException If an error occurs while reading the clock
+     * @throws BackendNotOpenException If the audio output is not open
+     */
+    public Optional<AudioTimestamp> getTimestamp() throws AudioBackendException {
+        return aob.getTimestamp();
+    }
+
+    /**
+     * Returns the render telemetry of this output layer: per-block times of the render,
+     * resample, convert and write stages and the block counters, together with the telemetry
+     * of the backend stream (see {@link AudioOutputBackend#getTelemetry()}).
+     * Does not block the playback thread, so it can be polled by a metrics exporter.
+     * @return The current telemetry, cumulative since the layer was opened
+     * @throws AudioBackendException If an error occurs while reading the backend telemetry
+     */
+    public OutputLayerTelemetry getTelemetry() throws AudioBackendException {
+        BackendTelemetry backend = null;
+        if (isOpened) {
+            try {
+                backend = aob.getTelemetry().orElse(null);
+            } catch (BackendNotOpenException ex) {
+                // Closed concurrently
+            }
+        }
+        return telemetry.snapshot(backend);
+    }
+
     /**
      * Returns the latency of this output layer in microseconds.
      * @return The latency in microseconds
@@ -681,14 +887,195 @@ public class AudioOutputLayer implements AutoCloseable,
         }
     }
 
+    /**
+     * Resamples, converts channels and encodes the rendered block into the opened format.
+     */
+    private void convertBlock(float[][] sampleBuffer, float[][] resampled, float[][] converted, ByteBuffer rawBuffer) {
+        float[][] block = resampleBlock(sampleBuffer, resampled, converted);
+        long convertStartNs = System.nanoTime();
+        try {
+            rawBuffer.clear();
+            SamplesConverter.toBytes(block, rawBuffer, openedFormat);
+            telemetry.record(OutputLayerTelemetry.Stage.CONVERT, System.nanoTime() - convertStartNs);
+        } catch (IllegalArgumentException ex) {
+            assert false : "Internal error: wrong arguments passed to conversion methods";
+            logger.error("Passed wrong arguments to the conversion methods.", ex);
+            throw new ProcessingException("Passed wrong arguments to the conversion methods.", ex);
+        }
+    }
+
+    /**
+     * Resamples and converts channels of the rendered block to the opened format,
+     * leaving the samples as floats.
+     *
+     * @return The resampled buffer, or the converted buffer if the channel counts differ
+     */
+    private float[][] resampleBlock(float[][] sampleBuffer, float[][] resampled, float[][] converted) {
+        long resampleStartNs = System.nanoTime();
+        try {
+            resampler.resample(sampleBuffer, resampled, resamplingFactor);
+            float[][] block = resampled;
+            if (sourceFormat.getChannels() != openedFormat.getChannels()) {
+                AudioBufferUtilities.channelsConvert(resampled, converted, sourceFormat.getChannels(), openedFormat.getChannels());
+                block = converted;
+            }
+            telemetry.record(OutputLayerTelemetry.Stage.RESAMPLE, System.nanoTime() - resampleStartNs);
+            return block;
+        } catch (IllegalArgumentException ex) {
+            assert false : "Internal error: wrong arguments passed to resampling/conversion methods";
+            logger.error("Passed wrong arguments to the resamping or conversion methods.", ex);
+            throw new ProcessingException("Passed wrong arguments to the resamping or conversion methods.", ex);
+        }
+    }
+
+    /**
+     * Writes the whole block to the backend. Non-blocking backends may accept only a part
+     * of it, so the rest is retried after {@code writeNsWait} until it fits.
+     *
+     * @return The number of bytes written, or -1 if the backend write failed
+     */
+    private int writeBlock(ByteBuffer rawBuffer, long writeNsWait) throws InterruptedException {
+        while (rawBuffer.hasRemaining()) {
+            if (aob.write(rawBuffer) == -1) return -1;
+            if (rawBuffer.hasRemaining()) {
+                if (isPlaybackInterrupted) break;
+                telemetry.onPartialWrite();
+                TimeUtilities.waitNanosPrecise(writeNsWait);
+            }
+        }
+        return rawBuffer.position();
+    }
+
+    /**
+     * Writes the whole float block to the backend, which converts it to the opened format
+     * natively. Retries partial writes like {@link #writeBlock(ByteBuffer, long)}.
+     *
+     * @return The number of frames written, or -1 if the backend write failed
+     */
+    private int writeFloatBlock(float[][] resampled, long writeNsWait) throws InterruptedException {
+        int frames = resampled[0].length;
+        int written = 0;
+        while (written < frames) {
+            int result = aob.writeFloat(resampled, written, frames - written);
+            if (result == -1) return -1;
+            written += result;
+            if (written < frames) {
+                if (isPlaybackInterrupted) break;
+                telemetry.onPartialWrite();
+                TimeUtilities.waitNanosPrecise(writeNsWait);
+            }
+        }
+        return written;
+    }
+
+    private void scheduleReopen() {
+        if (reopenInProgress.compareAndSet(false, true)) {
+            ThreadUtilities.startThread("AudioOutputLayer-Reopen", ThreadType.VIRTUAL, Thread.NORM_PRIORITY, true, () -> {
+                try {
+                    logger.debug("Trying to reopen audio device...");
+                    reopen();
+                } catch (Exception ex) {
+                    logger.error("Error while reopening device.", ex);
+                    eventDispatcher.dispatch(OutputLayerEventType.REOPEN_FAIL, getEvent());
+                } finally {
+                    reopenInProgress.set(false);
+                }
+            });
+        } else {
+            logger.debug("Reopen already in progress, skipping...");
+        }
+    }
+
+    /**
+     * Render callback for pull mode. Renders blocks of {@code renderBufferSize} frames
+     * from the root node and hands them to the backend in the sizes it requests.
+     * Runs on the backend's render thread, so it never calls into the backend.
+     */
+    private final class PullRenderer implements AudioRenderCallback {
+
+        private float[][] sampleBuffer = new float[openedFormat.getChannels()][renderBufferSize];
+        private final float[][] resampled = new float[openedFormat.getChannels()][resampledLength];
+        private final float[][] converted = new float[openedFormat.getChannels()][resampledLength];
+        private final byte[] rawBytes = new byte[rawLength];
+        private final ByteBuffer rawBuffer = ByteBuffer.wrap(rawBytes);
+        private int rawPosition = rawBytes.length; // No pending data
+        private int lengthMismatchCounter = 0;
+
+        @Override
+        public int render(byte[] buffer, int offset, int length) {
+            int written = 0;
+            while (written < length) {
+                if (rawPosition >= rawBytes.length) {
+                    if (!renderBlock()) break; // Backend fills the rest with silence
+                }
+                int toCopy = Math.min(length - written, rawBytes.length - rawPosition);
+                System.arraycopy(rawBytes, rawPosition, buffer, offset + written, toCopy);
+                rawPosition += toCopy;
+                written += toCopy;
+            }
+            return written;
+        }
+
+        private boolean renderBlock() {
+            AudioNode snapshot = rootNode;
+            if (snapshot == null) return false;
+
+            try {
+                long renderStartNs = System.nanoTime();
+                snapshot.render(sampleBuffer, (int)(sourceFormat.getSampleRate()));
+                telemetry.record(OutputLayerTelemetry.Stage.RENDER, System.nanoTime() - renderStartNs);
+
+                if (SamplesValidation.isValidSamples(sampleBuffer) != ValidationResult.VALID || !SamplesValidation.checkLength(sampleBuffer, renderBufferSize)) {
+                    logger.error("Length mismatch in render callback. Expected {} got {}. Counter: {}",
+                            renderBufferSize, sampleBuffer[0].length, lengthMismatchCounter);
+                    lengthMismatchCounter++;
+                    telemetry.onLengthMismatch();
+                    eventDispatcher.dispatch(OutputLayerEventType.LENGTH_MISMATCH, getRenderThreadEvent());
+                    sampleBuffer = new float[openedFormat.getChannels()][renderBufferSize];
+                    return false;
+                }
+
+                if (AOL_RESET_LENGTH_MISMATCHES && lengthMismatchCounter > 0) {
+                    lengthMismatchCounter = 0;
+                }
+
+                convertBlock(sampleBuffer, resampled, converted, rawBuffer);
+                rawPosition = 0;
+                telemetry.record(OutputLayerTelemetry.Stage.BLOCK, System.nanoTime() - renderStartNs);
+                telemetry.onBlock();
+                return true;
+            } catch (Exception ex) {
+                // Cannot propagate into the backend's render thread
+                logger.error("Exception in render callback.", ex);
+                eventDispatcher.dispatch(OutputLayerEventType.PLAYBACK_EXCEPTION, getRenderThreadEvent());
+                return false;
+            }
+        }
+
+        @Override
+        public void onDeviceInvalidated() {
+            logger.error("Device is invalidated or inactive (pull mode).");
+            eventDispatcher.dispatch(OutputLayerEventType.DEVICE_INVALIDATE, getRenderThreadEvent());
+            scheduleReopen();
+        }
+    }
+
     private void playback() {
         float[][] sampleBuffer = new float[openedFormat.getChannels()][renderBufferSize];
         float[][] resampled = new float[openedFormat.getChannels()][resampledLength];
-        byte[] rawBytes = new byte[rawLength];
+        float[][] converted = new float[openedFormat.getChannels()][resampledLength];
+        // Off-heap if the backend can read direct buffers without copying them
+        ByteBuffer rawBuffer = (aob.isDirectBufferSupported() ?
+                ByteBuffer.allocateDirect(rawLength) :
+                ByteBuffer.wrap(new byte[rawLength]));
+
+        // Lets the backend interleave and encode in one native pass
+        boolean floatWrite = aob.isFloatWriteSupported();
 
         int lengthMismatchCounter = 0;
 
         long bufferNsWait = Math.min(bufferTimeMicros - 1000, 100) * 1000L;
+        long writeNsWait = Math.max(bufferTimeMicros * 1000L / 4, 100_000L); // Backend full, poll a quarter buffer
         long renderStartNs, renderDurNs;
 
         while (!Thread.currentThread().isInterrupted() && !isPlaybackInterrupted) {
@@ -701,12 +1088,14 @@ public class AudioOutputLayer implements AutoCloseable,
                 }
 
                 snapshot.render(sampleBuffer, (int)(sourceFormat.getSampleRate()));
+                telemetry.record(OutputLayerTelemetry.Stage.RENDER, System.nanoTime() - renderStartNs);
 
                 // if changed the channels or samples length
                 if (SamplesValidation.isValidSamples(sampleBuffer) != ValidationResult.VALID || !SamplesValidation.checkLength(sampleBuffer, renderBufferSize)) {
                     logger.error("Length mismatch in output thread. Expected {} got {}. Counter: {}",
                             renderBufferSize, sampleBuffer[0].length, lengthMismatchCounter);
                     lengthMismatchCounter++;
+                    telemetry.onLengthMismatch();
                     eventDispatcher.dispatch(OutputLayerEventType.LENGTH_MISMATCH, getEvent());
                     // Initialize buffers again
                     if (lengthMismatchCounter < AOL_MAX_LENGTH_MISMATCHES) {
@@ -725,19 +1114,23 @@ public class AudioOutputLayer implements AutoCloseable,
                     lengthMismatchCounter = 0;
                 }
 
-                try {
-                    resampler.resample(sampleBuffer, resampled, resamplingFactor);
-                    if (sourceFormat.getChannels() != openedFormat.getChannels()) {
-                        resampled = AudioBufferUtilities.channelsConvert(resampled, sourceFormat.getChannels(), openedFormat.getChannels());
-                    }
-                    SamplesConverter.toBytes(resampled, rawBytes, openedFormat);
-                } catch (IllegalArgumentException ex) {
-                    assert false : "Internal error: wrong arguments passed to resampling/conversion methods";
-                    logger.error("Passed wrong arguments to the resamping or conversion methods.", ex);
-                    throw new ProcessingException("Passed wrong arguments to the resamping or conversion methods.", ex);
+                int written;
+                long writeStartNs;
+                if (floatWrite) {
+                    float[][] block = resampleBlock(sampleBuffer, resampled, converted);
+                    writeStartNs = System.nanoTime();
+                    written = writeFloatBlock(block, writeNsWait);
+                } else {
+                    convertBlock(sampleBuffer, resampled, converted, rawBuffer);
+                    writeStartNs = System.nanoTime();
+                    written = writeBlock(rawBuffer, writeNsWait);
                 }
+                long writeEndNs = System.nanoTime();
+                telemetry.record(OutputLayerTelemetry.Stage.WRITE, writeEndNs - writeStartNs);
+                telemetry.record(OutputLayerTelemetry.Stage.BLOCK, writeEndNs - renderStartNs);
 
-                if (aob.write(rawBytes, 0, rawBytes.length) == -1) {
+                if (written == -1) {
+                    telemetry.onWriteFailure();
                     writeFailures.incrementAndGet();
                     if (writeFailures.get() < AOL_MAX_WRITE_ERRORS) {
                         logger.warn("Audio backend write failed {} times.", writeFailures);
@@ -746,8 +1139,11 @@ public class AudioOutputLayer implements AutoCloseable,
                         logger.error("Audio backend write failed {} times. Aborting.", writeFailures);
                         throw new ProcessingException("Audio backend write failed " + writeFailures + " times.");
                     }
-                } else if (AOL_RESET_WRITE_ERRORS && writeFailures.get() > 0) {
-                    writeFailures.set(0);
+                } else {
+                    telemetry.onBlock();
+                    if (AOL_RESET_WRITE_ERRORS && writeFailures.get() > 0) {
+                        writeFailures.set(0);
+                    }
                 }
             } catch (BackendNotOpenException ex) {
                 logger.info("Backend is closed.");
@@ -756,22 +1152,7 @@ public class AudioOutputLayer implements AutoCloseable,
             } catch (DeviceInvalidatedException | DeviceInactiveException ex) {
                 logger.error("Device is invalidated or inactive.", ex);
                 eventDispatcher.dispatch(OutputLayerEventType.DEVICE_INVALIDATE, getEvent());
-
-                if (reopenInProgress.compareAndSet(false, true)) {
-                    ThreadUtilities.startThread("AudioOutputLayer-Reopen", ThreadType.VIRTUAL, Thread.NORM_PRIORITY, true, () -> {
-                        try {
-                            logger.debug("Trying to reopen audio device...");
-                            reopen();
-                        } catch (Exception ex2) {
-                            logger.error("Error while reopening device.", ex2);
-                            eventDispatcher.dispatch(OutputLayerEventType.REOPEN_FAIL, getEvent());
-                        } finally {
-                            reopenInProgress.set(false);
-                        }
-                    });
-                } else {
-                    logger.debug("Reopen already in progress, skipping...");
-                }
+                scheduleReopen();
                 return;
             } catch (AudioBackendException ex) {
                 logger.error("Error writing to audio backend.", ex);
@@ -30,6 +30,10 @@ import org.theko.sound.util.MathUtilities;
  * Represents an automation of audio controls over time.
  * It stores a list of keypoints (time, value, tension) which are used to interpolate the control values over time.
  * The automation can be played, looped, and scaled.
+ * <p>
+ * A playing automation updates its controls from the automation thread pool every update time,
+ * unless it is added to an effect as a {@link BlockModulator}. Then the effect evaluates it once
+ * per rendered block, with a ramp over the block, and no pool thread is used.
  *
  * @see AudioControlGroup
  * @see Keypoint
@@ -37,7 +41,7 @@ import org.theko.sound.util.MathUtilities;
  * @since 0.2.4-beta
  * @author Theko
  */
-public class Automation {
+public class Automation implements BlockModulator {
     private List<Keypoint> keypoints;
     private AudioControlGroup controls;
 
@@ -49,6 +53,9 @@ public class Automation {
     private volatile boolean isLooping;
     private float timeScale;
 
+    private volatile boolean renderSynchronous = false;
+    private boolean rampApplied = false;
+
     /**
      * Represents a keypoint in an automation.
      * It stores the time, value, and tension of the keypoint.
@@ -194,7 +201,9 @@ public class Automation {
     public void play() {
         if (!isPlaying) {
             isPlaying = true;
-            AutomationsThreadPool.submit(this::process);
+            if (!renderSynchronous) {
+                AutomationsThreadPool.submit(this::process);
+            }
         }
     }
 
@@ -347,7 +356,7 @@ public class Automation {
     protected void process() {
         long lastTime = System.nanoTime();
 
-        while (!Thread.currentThread().isInterrupted() && isPlaying) {
+        while (!Thread.currentThread().isInterrupted() && isPlaying && !renderSynchronous) {
             long now = System.nanoTime();
             float deltaTime = (now - lastTime) / 1_000_000_000f * timeScale;
             lastTime = now;
@@ -358,7 +367,8 @@ public class Automation {
                 float maxTime = keypoints.get(keypoints.size() - 1).getTime();
                 if (playhead > maxTime) {
                     if (isLooping) {
-                        playhead %= maxTime;
+                        // A single keypoint at 0 has no loop length
+                        playhead = maxTime > 0 ? playhead % maxTime : 0.0f;
                     } else {
                         stop();
                         break;
@@ -379,6 +389,59 @@ public class Automation {
         }
     }
 
+    @Override
+    public void renderBlock(int frames, int sampleRate) {
+        if (!renderSynchronous) return;
+        if (!isPlaying) {
+            if (rampApplied) {
+                controls.clearRamps();
+                rampApplied = false;
+            }
+            return;
+        }
+
+        float startValue = getValue(playhead);
+        playhead += (float) frames / sampleRate * timeScale;
+
+        if (keypoints.size() > 0) {
+            float maxTime = keypoints.get(keypoints.size() - 1).getTime();
+            if (playhead > maxTime) {
+                if (isLooping) {
+                    // Jump at the block boundary rather than ramping across the loop point
+                    playhead = maxTime > 0 ? playhead % maxTime : 0.0f;
+                    startValue = getValue(playhead);
+                } else {
+                    stop();
+                    controls.applyRamp(startValue, getValue(maxTime));
+                    rampApplied = true;
+                    return;
+                }
+            }
+        }
+
+        controls.applyRamp(startValue, getValue(playhead));
+        rampApplied = true;
+    }
+
+    @Override
+    public void setRenderSynchronous(boolean renderSynchronous) {
+        if (this.renderSynchronous == renderSynchronous) return;
+        this.renderSynchronous = renderSynchronous;
+        if (!renderSynchronous) {
+            controls.clearRamps();
+            rampApplied = false;
+            // Continue on the pool, the render loop exits by itself in the other direction
+            if (isPlaying) {
+                AutomationsThreadPool.submit(this::process);
+            }
+        }
+    }
+
+    @Override
+    public boolean isRenderSynchronous() {
+        return renderSynchronous;
+    }
+
     /**
      * Retrieves the value of the automation at the given time.
      *
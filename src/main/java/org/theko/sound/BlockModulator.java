@@ -0,0 +1,64 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.theko.sound;
+
+import org.theko.sound.controls.FloatControl;
+import org.theko.sound.effects.AudioEffect;
+
+/**
+ * A source of control values over time that can be evaluated by the render thread.
+ * <p>
+ * By default {@link Automation} and {@link LFO} update their controls from the automation
+ * thread pool, at a fixed interval. A modulator added to an {@link AudioEffect} with
+ * {@link AudioEffect#addModulator(BlockModulator)} becomes render-synchronous instead:
+ * the effect calls {@link #renderBlock(int, int)} once per block before processing it,
+ * the modulator advances its clock by the block duration and gives its float controls
+ * a ramp from the value at the block start to the value at the block end
+ * (see {@link FloatControl#getValueAt(int, int)}). No pool thread is used then,
+ * and the values are exact at block boundaries.
+ * <p>
+ * A modulator is hosted by at most one effect, so its clock advances once per block.
+ *
+ * @since 0.3.1-beta
+ * @author Theko
+ */
+public interface BlockModulator {
+
+    /**
+     * Advances the modulator by one block and applies the block ramp to its controls.
+     * Called by the host effect on the render thread, does nothing if not render-synchronous.
+     *
+     * @param frames The block length in frames
+     * @param sampleRate The sample rate in Hz
+     */
+    void renderBlock(int frames, int sampleRate);
+
+    /**
+     * Switches between render-synchronous evaluation and the automation thread pool.
+     * Called by the host effect when the modulator is added or removed.
+     *
+     * @param renderSynchronous True to be evaluated by {@link #renderBlock(int, int)}
+     */
+    void setRenderSynchronous(boolean renderSynchronous);
+
+    /**
+     * Checks if the modulator is evaluated by the render thread.
+     *
+     * @return True if hosted by an effect
+     */
+    boolean isRenderSynchronous();
+}
@@ -46,11 +46,15 @@ import org.theko.sound.controls.FloatControl;
  * // Start the LFO
  * lfo.start();
  * }</pre>
+ * <p>
+ * Added to an effect with {@link org.theko.sound.effects.AudioEffect#addModulator(BlockModulator)},
+ * the LFO is evaluated by the render thread once per block instead of the automation thread pool,
+ * and its float controls get a ramp over each block.
  *
  * @since 0.2.3-beta
  * @author Theko
  */
-public class LFO implements Controllable {
+public class LFO implements Controllable, BlockModulator {
 
     protected final FloatControl amount = new FloatControl("Amount", 0.0f, 1.0f, 0.5f);
     protected final FloatControl phase = new FloatControl("Phase", 0.0f, 1.0f, 0.0f);
@@ -74,6 +78,13 @@ public class LFO implements Controllable {
     /** Group of controls managed by this LFO. */
     protected final AudioControlGroup controlGroup;
 
+    /** Flag indicating whether the host effect evaluates this LFO on the render thread. */
+    protected volatile boolean renderSynchronous = false;
+
+    /** Time since start in seconds, advanced by rendered blocks. */
+    protected float renderTime = 0.0f;
+    private boolean rampApplied = false;
+
     /**
      * Creates a new LFO with the specified controls and update interval.
      *
@@ -142,8 +153,11 @@ public class LFO implements Controllable {
     /** Starts the LFO if it is not already running. */
     public void start() {
         if (!isPlaying) {
+            renderTime = 0.0f;
             isPlaying = true;
-            AutomationsThreadPool.submit(this::process);
+            if (!renderSynchronous) {
+                AutomationsThreadPool.submit(this::process);
+            }
         }
     }
 
@@ -160,7 +174,7 @@ public class LFO implements Controllable {
      */
     protected void process() {
         long startTime = System.nanoTime();
-        while (!Thread.currentThread().isInterrupted() && isPlaying) {
+        while (!Thread.currentThread().isInterrupted() && isPlaying && !renderSynchronous) {
             long currentTime = System.nanoTime();
             float timeDelta = (currentTime - startTime) / 1_000_000_000.0f;
             float value = getValue(timeDelta);
@@ -187,6 +201,40 @@ public class LFO implements Controllable {
         return base.getValue() + amount.getValue() * waveformValue * envelope;
     }
 
+    @Override
+    public void renderBlock(int frames, int sampleRate) {
+        if (!renderSynchronous) return;
+        if (!isPlaying) {
+            if (rampApplied) {
+                controlGroup.clearRamps();
+                rampApplied = false;
+            }
+            return;
+        }
+        float startValue = getValue(renderTime);
+        renderTime += (float) frames / sampleRate;
+        controlGroup.applyRamp(startValue, getValue(renderTime));
+        rampApplied = true;
+    }
+
+    @Override
+    public void setRenderSynchronous(boolean renderSynchronous) {
+        if (this.renderSynchronous == renderSynchronous) return;
+        this.renderSynchronous = renderSynchronous;
+        if (!renderSynchronous) {
+            controlGroup.clearRamps();
+            rampApplied = false;
+            if (isPlaying) {
+                AutomationsThreadPool.submit(this::process);
+            }
+        }
+    }
+
+    @Override
+    public boolean isRenderSynchronous() {
+        return renderSynchronous;
+    }
+
     /** @return the {@link AudioControlGroup} managed by this LFO. */
     public AudioControlGroup getControls() {
         return controlGroup;
@@ -0,0 +1,155 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.theko.sound;
+
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.IdentityHashMap;
+import java.util.List;
+import java.util.Map;
+
+import org.theko.sound.effects.AudioEffect;
+
+/**
+ * Independent groups of the inputs of one {@link AudioMixer}, compiled from the node graph.
+ * <p>
+ * Two inputs depend on each other if their subgraphs share a node (the same instance
+ * reachable from both), or if a {@link MixerSender} in one subgraph feeds a node of the other.
+ * Dependent inputs are merged into one group and rendered in index order on one thread,
+ * different groups may be rendered concurrently. Nodes other than mixers are opaque,
+ * only their identity is tracked.
+ * <p>
+ * A plan is compiled for one topology version of the mixer graph and is immutable.
+ *
+ * @since 0.3.1-beta
+ * @author Theko
+ */
+final class MixerRenderPlan {
+
+    private final long version;
+    private final int inputCount;
+    private final int[][] groups;
+
+    private MixerRenderPlan(long version, int inputCount, int[][] groups) {
+        this.version = version;
+        this.inputCount = inputCount;
+        this.groups = groups;
+    }
+
+    /**
+     * Compiles the plan of the given mixer inputs.
+     *
+     * @param inputs The inputs, null entries form their own group
+     * @param version The topology version the inputs were read at
+     * @return The plan
+     */
+    static MixerRenderPlan compile(List<AudioNode> inputs, long version) {
+        int count = inputs.size();
+        int[] parent = new int[count];
+        for (int i = 0; i < count; i++) parent[i] = i;
+
+        // First input that reached each node, any later one depends on it
+        Map<AudioNode, Integer> owners = new IdentityHashMap<>();
+        for (int i = 0; i < count; i++) {
+            List<AudioNode> reachable = new ArrayList<>();
+            collect(inputs.get(i), reachable, new IdentityHashMap<>());
+            for (AudioNode node : reachable) {
+                Integer owner = owners.putIfAbsent(node, i);
+                if (owner != null) union(parent, owner, i);
+            }
+        }
+
+        // Groups ordered by their first input, inputs ordered by index
+        int[] groupOf = new int[count];
+        Arrays.fill(groupOf, -1);
+        List<int[]> groups = new ArrayList<>();
+        int[] sizes = new int[count];
+        for (int i = 0; i < count; i++) sizes[find(parent, i)]++;
+        int[] fill = new int[count];
+        for (int i = 0; i < count; i++) {
+            int root = find(parent, i);
+            if (groupOf[root] == -1) {
+                groupOf[root] = groups.size();
+                groups.add(new int[sizes[root]]);
+            }
+            groups.get(groupOf[root])[fill[root]++] = i;
+        }
+        return new MixerRenderPlan(version, count, groups.toArray(new int[0][]));
+    }
+
+    private static void collect(AudioNode node, List<AudioNode> reachable, Map<AudioNode, Boolean> visited) {
+        if (node == null || visited.put(node, Boolean.TRUE) != null) return;
+        reachable.add(node);
+        if (node instanceof AudioMixer mixer) {
+            for (AudioNode input : mixer.getInputs()) {
+                collect(input, reachable, visited);
+            }
+            for (AudioEffect effect : mixer.getEffects()) {
+                reachable.add(effect);
+                // The sender node reads the samples this effect writes
+                if (effect instanceof MixerSender sender) {
+                    collect(sender.getSenderNode(), reachable, visited);
+                }
+            }
+        }
+    }
+
+    private static int find(int[] parent, int i) {
+        while (parent[i] != i) {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    }
+
+    private static void union(int[] parent, int a, int b) {
+        int rootA = find(parent, a);
+        int rootB = find(parent, b);
+        if (rootA < rootB) parent[rootB] = rootA;
+        else if (rootB < rootA) parent[rootA] = rootB;
+    }
+
+    /**
+     * Checks if the plan is still valid for the mixer inputs.
+     *
+     * @param currentVersion The current topology version
+     * @param currentInputCount The current number of inputs
+     * @return True if nothing changed since the plan was compiled
+     */
+    boolean isValid(long currentVersion, int currentInputCount) {
+        return version == currentVersion && inputCount == currentInputCount;
+    }
+
+    /**
+     * Returns the number of independent groups.
+     *
+     * @return The group count
+     */
+    int getGroupCount() {
+        return groups.length;
+    }
+
+    /**
+     * Returns the input indices of a group, in ascending order.
+     *
+     * @param group The group index
+     * @return The input indices, not to be modified
+     */
+    int[] getGroup(int group) {
+        return groups[group];
+    }
+}
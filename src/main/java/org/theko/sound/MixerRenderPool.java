@@ -0,0 +1,89 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.theko.sound;
+
+import static org.theko.sound.properties.AudioSystemProperties.AOL_PLAYBACK_THREAD;
+import static org.theko.sound.properties.AudioSystemProperties.MIXER_RENDER_THREADS;
+
+import java.util.concurrent.ForkJoinPool;
+import java.util.concurrent.ForkJoinWorkerThread;
+
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+/**
+ * Holds the work-stealing pool that renders the inputs of mixers in parallel render mode.
+ * <p>
+ * The pool is created on first use with {@code org.theko.sound.mixer.renderThreads} workers.
+ * Workers are daemon threads with the priority of the playback thread, each one renders
+ * from its own {@link org.theko.sound.util.AudioBufferPool}.
+ *
+ * @see AudioMixer#getParallelRenderControl()
+ *
+ * @since 0.3.1-beta
+ * @author Theko
+ */
+final class MixerRenderPool {
+
+    private static final Logger logger = LoggerFactory.getLogger(MixerRenderPool.class);
+
+    private static volatile ForkJoinPool pool;
+
+    private MixerRenderPool() {
+        throw new UnsupportedOperationException("This class cannot be instantiated.");
+    }
+
+    private static final class RenderWorker extends ForkJoinWorkerThread {
+
+        RenderWorker(ForkJoinPool pool) {
+            super(pool);
+            setName("AudioMixer-Render-" + getPoolIndex());
+            setDaemon(true);
+            setPriority(AOL_PLAYBACK_THREAD.priority);
+        }
+    }
+
+    /**
+     * Returns the render pool, creating it on first use.
+     *
+     * @return The pool
+     */
+    static ForkJoinPool get() {
+        ForkJoinPool current = pool;
+        if (current == null) {
+            synchronized (MixerRenderPool.class) {
+                current = pool;
+                if (current == null) {
+                    current = new ForkJoinPool(MIXER_RENDER_THREADS, RenderWorker::new, null, false);
+                    pool = current;
+                    logger.debug("Mixer render pool started with {} threads.", MIXER_RENDER_THREADS);
+                }
+            }
+        }
+        return current;
+    }
+
+    /**
+     * Checks if the calling thread is a worker of the render pool.
+     * Tasks forked on a worker join the work-stealing queues, other threads must submit them.
+     *
+     * @return True if called from a render worker
+     */
+    static boolean isWorkerThread() {
+        return Thread.currentThread() instanceof RenderWorker;
+    }
+}
@@ -0,0 +1,245 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.theko.sound;
+
+import java.util.Optional;
+import java.util.concurrent.atomic.AtomicLongArray;
+
+import org.theko.sound.backends.BackendTelemetry;
+import org.theko.sound.util.Histogram;
+
+/**
+ * Snapshot of the render telemetry of an {@link AudioOutputLayer}: per-block times of the
+ * render, resample, convert and write stages, the block counters, and the telemetry of the
+ * backend stream if it records one.
+ * <p>
+ * Values are cumulative since the layer was opened, so rates and means over an interval are
+ * the differences between two snapshots. Taking a snapshot does not block the playback thread.
+ * Stages a block does not go through are not recorded: the convert stage is skipped when the
+ * backend encodes float samples natively, and the write stage in pull mode, where the backend
+ * copies the block itself.
+ *
+ * @see AudioOutputLayer#getTelemetry()
+ *
+ * @since 0.3.1-beta
+ * @author Theko
+ */
+public final class OutputLayerTelemetry {
+
+    /**
+     * Timed stages of a rendered block.
+     */
+    public enum Stage {
+        /** Rendering the root node. */
+        RENDER,
+        /** Resampling and channels conversion. */
+        RESAMPLE,
+        /** Encoding into the opened format. */
+        CONVERT,
+        /** Writing into the backend, including waits for free space. */
+        WRITE,
+        /** The whole block, from the start of the render to the end of the write. */
+        BLOCK
+    }
+
+    private static final Stage[] STAGES = Stage.values();
+
+    private final long blocks;
+    private final long lengthMismatches;
+    private final long writeFailures;
+    private final long partialWrites;
+    private final long blockNanos;
+    private final long[] totalNanos;
+    private final long[] maxNanos;
+    private final Histogram[] histograms;
+    private final BackendTelemetry backend;
+
+    private OutputLayerTelemetry(long blocks, long lengthMismatches, long writeFailures, long partialWrites,
+                                 long blockNanos, long[] totalNanos, long[] maxNanos, Histogram[] histograms,
+                                 BackendTelemetry backend) {
+        this.blocks = blocks;
+        this.lengthMismatches = lengthMismatches;
+        this.writeFailures = writeFailures;
+        this.partialWrites = partialWrites;
+        this.blockNanos = blockNanos;
+        this.totalNanos = totalNanos;
+        this.maxNanos = maxNanos;
+        this.histograms = histograms;
+        this.backend = backend;
+    }
+
+    /**
+     * @return The blocks rendered and handed to the backend
+     */
+    public long getBlocks() {
+        return blocks;
+    }
+
+    /**
+     * @return The blocks dropped because the root node returned a wrong length or invalid samples
+     */
+    public long getLengthMismatches() {
+        return lengthMismatches;
+    }
+
+    /**
+     * @return The failed backend writes, not reset by successful ones
+     */
+    public long getWriteFailures() {
+        return writeFailures;
+    }
+
+    /**
+     * @return The writes the backend accepted only in part, so the playback thread waited for space
+     */
+    public long getPartialWrites() {
+        return partialWrites;
+    }
+
+    /**
+     * @return The duration of the audio in one block, the time budget of {@link Stage#BLOCK}, in nanoseconds
+     */
+    public long getBlockNanos() {
+        return blockNanos;
+    }
+
+    /**
+     * @param stage The stage
+     * @return The time spent in the stage, in nanoseconds
+     */
+    public long getTotalNanos(Stage stage) {
+        return totalNanos[stage.ordinal()];
+    }
+
+    /**
+     * @param stage The stage
+     * @return The longest time of the stage in one block, in nanoseconds
+     */
+    public long getMaxNanos(Stage stage) {
+        return maxNanos[stage.ordinal()];
+    }
+
+    /**
+     * @param stage The stage
+     * @return The mean time of the stage per block, in nanoseconds, or 0 if it was not recorded
+     */
+    public long getMeanNanos(Stage stage) {
+        long count = histograms[stage.ordinal()].getTotalCount();
+        return count > 0 ? totalNanos[stage.ordinal()] / count : 0;
+    }
+
+    /**
+     * @param stage The stage
+     * @return The times of the stage per block, a time histogram
+     */
+    public Histogram getHistogram(Stage stage) {
+        return histograms[stage.ordinal()];
+    }
+
+    /**
+     * @return The telemetry of the backend stream, or empty if the backend does not record it
+     */
+    public Optional<BackendTelemetry> getBackendTelemetry() {
+        return Optional.ofNullable(backend);
+    }
+
+    @Override
+    public String toString() {
+        return String.format("OutputLayerTelemetry{Blocks: %d, Length mismatches: %d, Write failures: %d, Partial writes: %d, Mean block: %d ns, Max block: %d ns, Backend: %s}",
+            blocks, lengthMismatches, writeFailures, partialWrites, getMeanNanos(Stage.BLOCK), getMaxNanos(Stage.BLOCK), backend);
+    }
+
+    /**
+     * Records the telemetry of one output layer. Written by one thread at a time
+     * (the playback thread or the backend's render thread) without locks or allocations,
+     * read by {@link #snapshot} from any thread.
+     */
+    static final class Recorder {
+
+        private static final int BLOCKS = 0;
+        private static final int LENGTH_MISMATCHES = 1;
+        private static final int WRITE_FAILURES = 2;
+        private static final int PARTIAL_WRITES = 3;
+        private static final int BLOCK_NANOS = 4;
+        private static final int STAGES_OFFSET = 5;
+
+        // Per stage: total, max, histogram
+        private static final int STAGE_FIELDS = 2 + Histogram.TIME_BUCKETS;
+
+        private final AtomicLongArray fields = new AtomicLongArray(STAGES_OFFSET + STAGES.length * STAGE_FIELDS);
+
+        /**
+         * Clears the values. Called while nothing is being recorded.
+         *
+         * @param blockNanos The duration of the audio in one block, in nanoseconds
+         */
+        void reset(long blockNanos) {
+            for (int i = 0; i < fields.length(); i++) {
+                fields.setRelease(i, 0);
+            }
+            fields.setRelease(BLOCK_NANOS, blockNanos);
+        }
+
+        void record(Stage stage, long nanos) {
+            int base = STAGES_OFFSET + stage.ordinal() * STAGE_FIELDS;
+            add(base, nanos);
+            if (nanos > fields.getPlain(base + 1)) fields.setOpaque(base + 1, nanos);
+            add(base + 2 + Histogram.timeBucket(nanos), 1);
+        }
+
+        void onBlock() {
+            add(BLOCKS, 1);
+        }
+
+        void onLengthMismatch() {
+            add(LENGTH_MISMATCHES, 1);
+        }
+
+        void onWriteFailure() {
+            add(WRITE_FAILURES, 1);
+        }
+
+        void onPartialWrite() {
+            add(PARTIAL_WRITES, 1);
+        }
+
+        // Single writer: a plain read-modify-write, no locked instruction
+        private void add(int index, long value) {
+            fields.setOpaque(index, fields.getPlain(index) + value);
+        }
+
+        OutputLayerTelemetry snapshot(BackendTelemetry backend) {
+            long[] totalNanos = new long[STAGES.length];
+            long[] maxNanos = new long[STAGES.length];
+            Histogram[] histograms = new Histogram[STAGES.length];
+            long[] counts = new long[Histogram.TIME_BUCKETS];
+            for (int s = 0; s < STAGES.length; s++) {
+                int base = STAGES_OFFSET + s * STAGE_FIELDS;
+                totalNanos[s] = fields.getOpaque(base);
+                maxNanos[s] = fields.getOpaque(base + 1);
+                for (int i = 0; i < counts.length; i++) {
+                    counts[i] = fields.getOpaque(base + 2 + i);
+                }
+                histograms[s] = Histogram.ofTimes(counts);
+            }
+            return new OutputLayerTelemetry(
+                fields.getOpaque(BLOCKS), fields.getOpaque(LENGTH_MISMATCHES),
+                fields.getOpaque(WRITE_FAILURES), fields.getOpaque(PARTIAL_WRITES),
+                fields.getOpaque(BLOCK_NANOS), totalNanos, maxNanos, histograms, backend);
+        }
+    }
+}
@@ -20,6 +20,7 @@ import java.io.BufferedInputStream;
 import java.io.File;
 import java.io.FileInputStream;
 import java.io.FileNotFoundException;
+import java.util.Arrays;
 
 import org.slf4j.Logger;
 import org.slf4j.LoggerFactory;
@@ -30,8 +31,10 @@ import org.theko.sound.codecs.AudioCodec;
 import org.theko.sound.codecs.AudioCodecException;
 import org.theko.sound.codecs.AudioCodecInfo;
 import org.theko.sound.codecs.AudioCodecNotFoundException;
+import org.theko.sound.codecs.AudioDecodeCache;
 import org.theko.sound.codecs.AudioCodecs;
 import org.theko.sound.codecs.AudioDecodeResult;
+import org.theko.sound.codecs.AudioDecodeStream;
 import org.theko.sound.codecs.AudioMetadata;
 import org.theko.sound.controls.Controllable;
 import org.theko.sound.controls.FloatControl;
@@ -45,6 +48,7 @@ import org.theko.sound.events.AudioControlEventType;
 import org.theko.sound.events.SoundSourceEvent;
 import org.theko.sound.events.SoundSourceEventType;
 import org.theko.sound.events.SoundSourceListener;
+import org.theko.sound.properties.AudioSystemProperties;
 import org.theko.sound.samples.SamplesValidation;
 import org.theko.sound.samples.SamplesValidation.ValidationResult;
 import org.theko.sound.util.AudioBufferUtilities;
@@ -91,7 +95,10 @@ public class SoundSource implements AudioNode, Controllable, AutoCloseable,
     private static final Logger logger = LoggerFactory.getLogger(SoundSource.class);
     private final EventDispatcher<SoundSourceEvent, SoundSourceListener, SoundSourceEventType> eventDispatcher = new EventDispatcher<>();
 
-    private float[][] samplesData;
+    private volatile float[][] samplesData;
+    private boolean sharedSamples = false; // samplesData belongs to AudioDecodeCache
+    private volatile AudioDecodeStream stream;
+    private int frameLength = 0;
     private AudioFormat audioFormat;
     private AudioMetadata tags;
 
@@ -109,6 +116,8 @@ public class SoundSource implements AudioNode, Controllable, AutoCloseable,
      * It implements the {@link AudioNode} interface and overrides the {@link AudioNode#render(float[][], int)} method.
      */
     public class Playback implements AudioNode {
+        private float[][] streamBlock;
+
         @Override
         public void render(float[][] samples, int sampleRate) {
             if (!isPlaying) {
@@ -118,13 +127,13 @@ public class SoundSource implements AudioNode, Controllable, AutoCloseable,
 
             int length = samples[0].length;
 
-            int available = samplesData[0].length - playedFrames;
+            int available = frameLength - playedFrames;
             int safeLength = Math.min(length, available);
 
             if (safeLength <= 0) {
                 if (loop) {
                     playedFrames = 0;
-                    safeLength = Math.min(length, samplesData[0].length);
+                    safeLength = Math.min(length, frameLength);
                     dispatch(SoundSourceEventType.LOOP);
                 } else {
                     isPlaying = false;
@@ -135,11 +144,19 @@ public class SoundSource implements AudioNode, Controllable, AutoCloseable,
                 }
             }
 
+            float[][] source = samplesData;
+            int sourceOffset = playedFrames;
+            if (source == null) {
+                // Streaming: convert only this block
+                source = readStreamBlock(playedFrames, safeLength);
+                sourceOffset = 0;
+            }
+
             for (int ch = 0; ch < samples.length; ch++) {
-                float[] src = (ch < samplesData.length) ? samplesData[ch] : null;
+                float[] src = (ch < source.length) ? source[ch] : null;
                 for (int i = 0; i < length; i++) {
                     if (i < safeLength && src != null) {
-                        samples[ch][i] = src[playedFrames + i];
+                        samples[ch][i] = src[sourceOffset + i];
                     } else {
                         samples[ch][i] = 0.0f;
                     }
@@ -148,6 +165,24 @@ public class SoundSource implements AudioNode, Controllable, AutoCloseable,
 
             playedFrames += safeLength;
         }
+
+        private float[][] readStreamBlock(int position, int frames) {
+            AudioDecodeStream stream = SoundSource.this.stream;
+            if (stream == null) {
+                return new float[0][]; // Closed while rendering
+            }
+            int channels = stream.getAudioFormat().getChannels();
+            if (streamBlock == null || streamBlock.length != channels || streamBlock[0].length < frames) {
+                streamBlock = new float[channels][frames];
+            }
+            int read = stream.read(position, streamBlock, 0, frames);
+            if (read < frames) {
+                for (float[] channel : streamBlock) {
+                    Arrays.fill(channel, read, frames, 0.0f);
+                }
+            }
+            return streamBlock;
+        }
     }
 
     /**
@@ -280,13 +315,61 @@ public class SoundSource implements AudioNode, Controllable, AutoCloseable,
      * @throws RuntimeException If setting up the inner audio mixer or playback effect fails
      */
     public void open(float[][] samples, AudioFormat format, AudioMetadata tags) {
+        openSamples(samples, format, tags, false);
+    }
+
+    private void openSamples(float[][] samples, AudioFormat format, AudioMetadata tags, boolean shared) {
         SamplesValidation.validateSamples(samples);
         if (format == null) {
             throw new IllegalArgumentException("Audio format cannot be null.");
         }
+        AudioDecodeStream previous = this.stream;
         this.samplesData = samples;
+        this.sharedSamples = shared;
+        this.stream = null;
+        this.frameLength = samples[0].length;
         this.audioFormat = format;
         this.tags = tags;
+        closeStream(previous);
+
+        initialize();
+        reset(); // Reset the playback position
+        dispatch(SoundSourceEventType.OPEN);
+    }
+
+    /**
+     * Opens the sound source with a stream, which is read block by block during playback.
+     * <p>
+     * The samples are not loaded into memory, so opening is fast and memory use does not depend
+     * on the stream length. Seeking only moves the read position. {@link #getSamples()} and
+     * {@link #applyEffect(AudioEffect)} read the whole stream into memory first.
+     * The sound source takes ownership of the stream and closes it when it is closed or reopened.
+     *
+     * @param stream The stream to open
+     * @throws IllegalArgumentException If the stream is null, has no audio format, or is longer than
+     * {@link Integer#MAX_VALUE} frames
+     * @throws RuntimeException If setting up the inner audio mixer or playback effect fails
+     *
+     * @since 0.3.1-beta
+     */
+    public void open(AudioDecodeStream stream) {
+        if (stream == null) {
+            throw new IllegalArgumentException("Stream cannot be null.");
+        }
+        if (stream.getAudioFormat() == null) {
+            throw new IllegalArgumentException("Audio format cannot be null.");
+        }
+        if (stream.getFrameLength() > Integer.MAX_VALUE) {
+            throw new IllegalArgumentException("Stream is too long: " + stream.getFrameLength() + " frames.");
+        }
+        AudioDecodeStream previous = this.stream;
+        this.samplesData = null;
+        this.sharedSamples = false;
+        this.stream = stream;
+        this.frameLength = (int) stream.getFrameLength();
+        this.audioFormat = stream.getAudioFormat();
+        this.tags = stream.getMetadata();
+        if (previous != stream) closeStream(previous);
 
         initialize();
         reset(); // Reset the playback position
@@ -295,6 +378,11 @@ public class SoundSource implements AudioNode, Controllable, AutoCloseable,
 
     /**
      * Opens the specified audio file, decodes it, and prepares this SoundSource for playback.
+     * <p>
+     * Files of at least {@code org.theko.sound.codecs.streamingThreshold} MiB are opened as a stream
+     * (see {@link #open(AudioDecodeStream)}) if their codec supports it. Other files are decoded
+     * through the {@link AudioDecodeCache}, when it is enabled, so sources opened on the same file
+     * share its samples.
      *
      * @param file The audio file to open. Supported formats depend on available codecs
      * @throws FileNotFoundException If the file does not exist or cannot be read
@@ -354,7 +442,7 @@ public class SoundSource implements AudioNode, Controllable, AutoCloseable,
      * @return true if the sound source has valid audio data, false otherwise
      */
     public boolean hasAudioData() {
-        return samplesData != null && samplesData.length > 0 && audioFormat != null;
+        return ((samplesData != null && samplesData.length > 0) || stream != null) && audioFormat != null;
     }
 
     /**
@@ -363,7 +451,7 @@ public class SoundSource implements AudioNode, Controllable, AutoCloseable,
      */
     public void start() {
         if (isPlaying) return;
-        if (playedFrames >= samplesData[0].length) playedFrames = 0;
+        if (playedFrames >= frameLength) playedFrames = 0;
         isPlaying = true;
         logger.trace("Playback started");
         dispatch(SoundSourceEventType.START);
@@ -410,6 +498,14 @@ public class SoundSource implements AudioNode, Controllable, AutoCloseable,
     public void close() {
         stop();
         reset();
+        if (samplesData == null) {
+            // A stream holds the only copy of the samples
+            audioFormat = null;
+            frameLength = 0;
+        }
+        AudioDecodeStream previous = stream;
+        stream = null;
+        closeStream(previous);
         logger.trace("Closed");
         dispatch(SoundSourceEventType.CLOSE);
     }
@@ -568,7 +664,7 @@ public class SoundSource implements AudioNode, Controllable, AutoCloseable,
         if (!hasAudioData()) {
             throw new IllegalStateException("Sound source is not opened.");
         }
-        playedFrames = MathUtilities.clamp(frames, 0, samplesData[0].length);
+        playedFrames = MathUtilities.clamp(frames, 0, frameLength);
         dispatch(SoundSourceEventType.POSITION_CHANGE);
     }
 
@@ -599,9 +695,9 @@ public class SoundSource implements AudioNode, Controllable, AutoCloseable,
         if (!hasAudioData()) {
             throw new IllegalStateException("Sound source is not opened.");
         }
-        if (position < 0 || position > samplesData[0].length) {
-            logger.error("Position {} must be between 0 and {}", position, samplesData[0].length);
-            throw new IllegalArgumentException("Position " + position + " must be between 0 and " + samplesData[0].length);
+        if (position < 0 || position > frameLength) {
+            logger.error("Position {} must be between 0 and {}", position, frameLength);
+            throw new IllegalArgumentException("Position " + position + " must be between 0 and " + frameLength);
         }
         playedFrames = position;
         dispatch(SoundSourceEventType.POSITION_CHANGE);
@@ -656,7 +752,7 @@ public class SoundSource implements AudioNode, Controllable, AutoCloseable,
         if (!hasAudioData()) {
             throw new IllegalStateException("Sound source is not opened.");
         }
-        return samplesData[0].length / (double)audioFormat.getSampleRate();
+        return frameLength / (double)audioFormat.getSampleRate();
     }
 
     /**
@@ -665,6 +761,10 @@ public class SoundSource implements AudioNode, Controllable, AutoCloseable,
      * <p>The returned array is a 2D float array of shape [channels][frames],
      * where each element is a normalized floating-point sample in the range [-1.0, 1.0].
      *
+     * <p>A sound source opened with a stream reads the whole stream into memory on the first call.
+     * A sound source that shares its samples with other sources through the {@link AudioDecodeCache}
+     * takes a private copy of them on the first call, so the returned samples can be modified.
+     *
      * @return The audio samples associated with this sound source (a ref)
      * @throws IllegalStateException if the sound source is not opened
      */
@@ -672,7 +772,7 @@ public class SoundSource implements AudioNode, Controllable, AutoCloseable,
         if (!hasAudioData()) {
             throw new IllegalStateException("Sound source is not opened.");
         }
-        return samplesData;
+        return loadSamples();
     }
 
     /**
@@ -722,6 +822,7 @@ public class SoundSource implements AudioNode, Controllable, AutoCloseable,
         if (effect == null) {
             throw new IllegalArgumentException("Effect cannot be null.");
         }
+        loadSamples();
 
         float mix = effect.getMixLevelControl().getValue();
         if (!effect.getEnableControl().getValue() || mix <= 0.0f) {
@@ -770,6 +871,7 @@ public class SoundSource implements AudioNode, Controllable, AutoCloseable,
                 }
             }
             samplesData = newSamples;
+            frameLength = targetLength;
         }
     }
 
@@ -811,28 +913,25 @@ public class SoundSource implements AudioNode, Controllable, AutoCloseable,
             logger.debug("Using codec: {}", codec.getName());
             AudioCodec audioCodec = AudioCodecs.getCodec(codec);
 
-            AudioDecodeResult decodeResult = null;
-            try (BufferedInputStream bis = new BufferedInputStream(new FileInputStream(file), 1024 * 256)) {
-                decodeResult = audioCodec.decode(bis);
-            } catch (FileNotFoundException e) {
-                logger.error("File not found: {}", file.getName(), e);
-                throw new AudioCodecException("File not found: " + file.getName(), e);
-            } catch (Exception e) {
-                logger.error("Failed to decode audio file: {}", file.getName(), e);
-                throw new AudioCodecException("Failed to decode audio file: " + file.getName(), e);
+            int threshold = AudioSystemProperties.CODECS_STREAMING_THRESHOLD;
+            if (audioCodec.isStreamingSupported() && threshold >= 0 && file.length() >= (long) threshold * 1024 * 1024) {
+                AudioDecodeStream decodeStream = audioCodec.openStream(file.toPath());
+                if (decodeStream.getFrameLength() <= Integer.MAX_VALUE) {
+                    this.open(decodeStream);
+                    logger.trace("Opened audio file as a stream: {}", file.getName());
+                    return;
+                }
+                logger.warn("Audio file is too long for a sound source: {} frames.", decodeStream.getFrameLength());
+                decodeStream.close();
+                throw new AudioCodecException("Audio file is too long: " + file.getName());
             }
 
-            // Check decoded result
-            if (decodeResult == null ||
-                SamplesValidation.isValidSamples(decodeResult.getSamples()) != ValidationResult.VALID ||
-                decodeResult.getAudioFormat() == null) {
-                logger.error("Failed to decode audio file, result is invalid: {}", file.getName());
-                throw new AudioCodecException("Failed to decode audio file, result is invalid: " + file.getName());
-            }
-            logger.trace("Successfully decoded audio file: {}", file.getName());
+            AudioDecodeCache.Lookup lookup = AudioDecodeCache.lookup(file, f -> decode(audioCodec, f));
+            AudioDecodeResult decodeResult = lookup.getResult();
 
             // Open this sound source with the decoded audio data
-            this.open(decodeResult.getSamples(), decodeResult.getAudioFormat(), decodeResult.getMetadata());
+            openSamples(decodeResult.getSamples(), decodeResult.getAudioFormat(), decodeResult.getMetadata(),
+                    lookup.isShared());
 
             logger.trace("Opened audio file: {}", file.getName());
         } catch (AudioCodecNotFoundException ex) {
@@ -844,6 +943,56 @@ public class SoundSource implements AudioNode, Controllable, AutoCloseable,
         }
     }
 
+    private static AudioDecodeResult decode(AudioCodec audioCodec, File file) throws AudioCodecException {
+        AudioDecodeResult decodeResult = null;
+        try (BufferedInputStream bis = new BufferedInputStream(new FileInputStream(file), 1024 * 256)) {
+            decodeResult = audioCodec.decode(bis);
+        } catch (FileNotFoundException e) {
+            logger.error("File not found: {}", file.getName(), e);
+            throw new AudioCodecException("File not found: " + file.getName(), e);
+        } catch (Exception e) {
+            logger.error("Failed to decode audio file: {}", file.getName(), e);
+            throw new AudioCodecException("Failed to decode audio file: " + file.getName(), e);
+        }
+
+        // Check decoded result
+        if (decodeResult == null ||
+            SamplesValidation.isValidSamples(decodeResult.getSamples()) != ValidationResult.VALID ||
+            decodeResult.getAudioFormat() == null) {
+            logger.error("Failed to decode audio file, result is invalid: {}", file.getName());
+            throw new AudioCodecException("Failed to decode audio file, result is invalid: " + file.getName());
+        }
+        logger.trace("Successfully decoded audio file: {}", file.getName());
+        return decodeResult;
+    }
+
+    private float[][] loadSamples() {
+        float[][] samples = samplesData;
+        if (samples != null && sharedSamples) {
+            // Copy on first write, the cached samples are shared with other sources
+            logger.debug("Copying {} shared frames.", frameLength);
+            float[][] copy = new float[samples.length][];
+            for (int ch = 0; ch < samples.length; ch++) {
+                copy[ch] = samples[ch].clone();
+            }
+            samples = copy;
+            samplesData = samples;
+            sharedSamples = false;
+        } else if (samples == null) {
+            // The stream stays open until the source is closed, a block may still be rendering from it
+            logger.debug("Reading {} streamed frames into memory.", frameLength);
+            samples = stream.readAll();
+            samplesData = samples;
+        }
+        return samples;
+    }
+
+    private static void closeStream(AudioDecodeStream stream) {
+        if (stream != null) {
+            stream.close();
+        }
+    }
+
     private void dispatch(SoundSourceEventType type) {
         eventDispatcher.dispatch(type, new SoundSourceEvent(this));
     }
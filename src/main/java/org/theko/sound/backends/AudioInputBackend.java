@@ -16,6 +16,9 @@
 
 package org.theko.sound.backends;
 
+import java.nio.ByteBuffer;
+import java.util.Optional;
+
 import org.theko.sound.AudioFormat;
 import org.theko.sound.AudioPort;
 import org.theko.sound.UnsupportedAudioFormatException;
@@ -128,6 +131,36 @@ public interface AudioInputBackend extends AudioBackend, AutoCloseable {
      */
     int read(byte[] buffer, int offset, int length) throws AudioBackendException;
 
+    /**
+     * Reads audio data into the buffer, from its position up to its limit,
+     * and advances the buffer's position by the number of bytes read.
+     * <p>
+     * Backends with native access may fill direct buffers without copying through
+     * the Java heap. The default implementation reads heap buffers through their
+     * backing array, and reads other buffers through a temporary array.
+     *
+     * @param buffer The buffer to store audio data
+     * @return The number of bytes actually read
+     * @throws AudioBackendException If an error occurs during reading
+     * @throws BackendNotOpenException If the audio input is not open
+     */
+    default int read(ByteBuffer buffer) throws AudioBackendException {
+        int read;
+        if (buffer.hasArray()) {
+            read = read(buffer.array(), buffer.arrayOffset() + buffer.position(), buffer.remaining());
+            if (read > 0) {
+                buffer.position(buffer.position() + read);
+            }
+        } else {
+            byte[] data = new byte[buffer.remaining()];
+            read = read(data, 0, data.length);
+            if (read > 0) {
+                buffer.put(data, 0, read);
+            }
+        }
+        return read;
+    }
+
     /**
      * Returns the number of bytes available for reading.
      *
@@ -173,6 +206,19 @@ public interface AudioInputBackend extends AudioBackend, AutoCloseable {
      */
     long getMicrosecondLatency() throws AudioBackendException;
 
+    /**
+     * Returns the glitch counters and timing histograms of the stream, recorded by the
+     * backend's capture thread. Backends that record them answer without a native call.
+     * The default implementation returns an empty optional.
+     *
+     * @return The current telemetry, or empty if the backend does not record it
+     * @throws AudioBackendException If an error occurs while reading the telemetry
+     * @throws BackendNotOpenException If the audio input is not open
+     */
+    default Optional<BackendTelemetry> getTelemetry() throws AudioBackendException {
+        return Optional.empty();
+    }
+
     /**
      * Retrieves the current audio port being used by the backend.
      *
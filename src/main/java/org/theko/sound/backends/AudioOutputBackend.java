@@ -16,6 +16,9 @@
 
 package org.theko.sound.backends;
 
+import java.nio.ByteBuffer;
+import java.util.Optional;
+
 import org.theko.sound.AudioFormat;
 import org.theko.sound.AudioPort;
 import org.theko.sound.UnsupportedAudioFormatException;
@@ -127,6 +130,35 @@ public interface AudioOutputBackend extends AudioBackend, AutoCloseable {
      */
     int write(byte[] data, int offset, int length) throws AudioBackendException;
 
+    /**
+     * Writes audio data from the buffer's position up to its limit into the backend,
+     * and advances the buffer's position by the number of bytes written.
+     * <p>
+     * Backends with native access may read direct buffers without copying them
+     * into the Java heap. The default implementation writes heap buffers through
+     * their backing array, and copies other buffers into a temporary array.
+     *
+     * @param buffer The buffer with the audio data to be written
+     * @return The number of bytes successfully written, or -1 if the write failed
+     * @throws AudioBackendException If an error occurs while writing data
+     * @throws BackendNotOpenException If the audio output is not open
+     */
+    default int write(ByteBuffer buffer) throws AudioBackendException {
+        if (!buffer.hasRemaining()) return 0;
+        int written;
+        if (buffer.hasArray()) {
+            written = write(buffer.array(), buffer.arrayOffset() + buffer.position(), buffer.remaining());
+        } else {
+            byte[] data = new byte[buffer.remaining()];
+            buffer.duplicate().get(data);
+            written = write(data, 0, data.length);
+        }
+        if (written > 0) {
+            buffer.position(buffer.position() + written);
+        }
+        return written;
+    }
+
     /**
      * Returns the amount of free space in the audio output buffer.
      *
@@ -164,6 +196,33 @@ public interface AudioOutputBackend extends AudioBackend, AutoCloseable {
     long getMicrosecondPosition() throws AudioBackendException;
 
 
+    /**
+     * Returns the frame position played by the device together with the system time it was
+     * played at, the stream latency and the amount of queued audio, read consistently.
+     * Backends that publish the clock from their render thread answer without a native call.
+     * The default implementation returns an empty optional.
+     *
+     * @return The latest timestamp, or empty if the backend does not provide one
+     * @throws AudioBackendException If an error occurs while reading the clock
+     * @throws BackendNotOpenException If the audio output is not open
+     */
+    default Optional<AudioTimestamp> getTimestamp() throws AudioBackendException {
+        return Optional.empty();
+    }
+
+    /**
+     * Returns the glitch counters and timing histograms of the stream, recorded by the
+     * backend's render thread. Backends that record them answer without a native call.
+     * The default implementation returns an empty optional.
+     *
+     * @return The current telemetry, or empty if the backend does not record it
+     * @throws AudioBackendException If an error occurs while reading the telemetry
+     * @throws BackendNotOpenException If the audio output is not open
+     */
+    default Optional<BackendTelemetry> getTelemetry() throws AudioBackendException {
+        return Optional.empty();
+    }
+
     /**
      * Returns the current latency in the audio output stream in microseconds.
      *
@@ -181,5 +240,154 @@ public interface AudioOutputBackend extends AudioBackend, AutoCloseable {
      * @throws BackendNotOpenException If the audio output is not open
      */
     AudioPort getCurrentAudioPort() throws AudioBackendException;
-}
 
+    /**
+     * Writes planar floating-point samples into the backend. The backend interleaves, clips,
+     * dithers and converts them to the opened format itself, in one pass.
+     * The default implementation throws {@link UnsupportedOperationException}.
+     *
+     * @param samples The samples, organized as [channels][frames], with the channel count of the opened format
+     * @param offset The frame offset in each channel from which to write
+     * @param frames The number of frames to write
+     * @return The number of frames successfully written, or -1 if the write failed
+     * @throws AudioBackendException If an error occurs while writing data
+     * @throws BackendNotOpenException If the audio output is not open
+     * @throws UnsupportedOperationException If float writes are not supported by this backend
+     * @see #isFloatWriteSupported()
+     */
+    default int writeFloat(float[][] samples, int offset, int frames) throws AudioBackendException {
+        throw new UnsupportedOperationException("Float write is not supported by " + getClass().getSimpleName() + ".");
+    }
+
+    /**
+     * Checks if {@link #writeFloat(float[][], int, int)} is supported for the opened format.
+     * The default implementation returns {@code false}.
+     *
+     * @return {@code true} if float writes are supported, {@code false} otherwise
+     */
+    default boolean isFloatWriteSupported() {
+        return false;
+    }
+
+    /**
+     * Checks if this backend reads direct buffers passed to {@link #write(ByteBuffer)}
+     * without copying them into the Java heap. The default implementation returns {@code false}.
+     *
+     * @return {@code true} if direct buffers are written without a heap copy, {@code false} otherwise
+     */
+    default boolean isDirectBufferSupported() {
+        return false;
+    }
+
+    /**
+     * Checks if this backend can run in pull mode, where the backend owns the render
+     * thread and requests audio data through an {@link AudioRenderCallback}.
+     * The default implementation returns {@code false}.
+     *
+     * @return {@code true} if pull mode is supported, {@code false} otherwise
+     */
+    default boolean isPullModeSupported() {
+        return false;
+    }
+
+    /**
+     * Sets the render callback used in pull mode. Must be called before {@link #start()};
+     * passing {@code null} switches the backend back to push mode ({@link #write}).
+     * The default implementation throws {@link UnsupportedOperationException}.
+     *
+     * @param callback The render callback, or {@code null} to disable pull mode
+     * @throws AudioBackendException If the callback cannot be set in the current state
+     * @throws UnsupportedOperationException If pull mode is not supported by this backend
+     */
+    default void setRenderCallback(AudioRenderCallback callback) throws AudioBackendException {
+        throw new UnsupportedOperationException("Pull mode is not supported by " + getClass().getSimpleName() + ".");
+    }
+
+    /**
+     * Checks if this backend can open a low-latency stream, with a device period
+     * smaller than the default one. The default implementation returns {@code false}.
+     *
+     * @return {@code true} if low-latency streams are supported, {@code false} otherwise
+     */
+    default boolean isLowLatencySupported() {
+        return false;
+    }
+
+    /**
+     * Requests the smallest device period the port supports for the next {@link #open}.
+     * Backends fall back to the default period if the device or the system does not support it.
+     * The default implementation throws {@link UnsupportedOperationException}.
+     *
+     * @param lowLatency {@code true} to request the smallest period, {@code false} for the default one
+     * @throws AudioBackendException If the mode cannot be changed while the backend is open
+     * @throws UnsupportedOperationException If low-latency streams are not supported by this backend
+     */
+    default void setLowLatency(boolean lowLatency) throws AudioBackendException {
+        throw new UnsupportedOperationException("Low latency is not supported by " + getClass().getSimpleName() + ".");
+    }
+
+    /**
+     * Returns the device period, in frames, a stream with the given port and format
+     * is (or would be) driven with, taking the low-latency setting into account.
+     * Buffer sizes that are multiples of the period avoid partially filled periods.
+     * The default implementation returns {@code -1}.
+     *
+     * @param port The audio port
+     * @param audioFormat The audio format of the stream
+     * @return The device period in frames, or {@code -1} if it is unknown
+     * @throws AudioBackendException If an error occurs while querying the period
+     */
+    default int getPeriodFrames(AudioPort port, AudioFormat audioFormat) throws AudioBackendException {
+        return -1;
+    }
+
+    /**
+     * Checks if this backend can mix several streams opened on the same port natively,
+     * into one device stream driven by a single render thread.
+     * The default implementation returns {@code false}.
+     *
+     * @return {@code true} if shared sessions are supported, {@code false} otherwise
+     */
+    default boolean isSharedSessionSupported() {
+        return false;
+    }
+
+    /**
+     * Requests the next {@link #open} to join the shared session of the port, instead of opening
+     * its own device stream. Streams in a session are opened with the session format, and cannot
+     * use pull mode. Backends fall back to their own stream if the port cannot be shared.
+     * The default implementation throws {@link UnsupportedOperationException}.
+     *
+     * @param sharedSession {@code true} to join the shared session of the port
+     * @throws AudioBackendException If the mode cannot be changed while the backend is open
+     * @throws UnsupportedOperationException If shared sessions are not supported by this backend
+     */
+    default void setSharedSession(boolean sharedSession) throws AudioBackendException {
+        throw new UnsupportedOperationException("Shared sessions are not supported by " + getClass().getSimpleName() + ".");
+    }
+
+    /**
+     * Checks whether the system audio engine can convert the stream format for this backend.
+     * The default implementation returns {@code false}.
+     *
+     * @return {@code true} if engine format conversion is supported, {@code false} otherwise
+     */
+    default boolean isEngineConversionSupported() {
+        return false;
+    }
+
+    /**
+     * Requests the next {@link #open} to accept the requested format as is, and to let the
+     * system audio engine convert the sample rate, channel layout and sample format to the device
+     * format. {@link #open} then returns the requested format, so the caller does not have to resample
+     * or remix. Backends fall back to the closest supported format if the engine cannot convert.
+     * The default implementation throws {@link UnsupportedOperationException}.
+     *
+     * @param engineConversion {@code true} to let the audio engine convert the format
+     * @throws AudioBackendException If the mode cannot be changed while the backend is open
+     * @throws UnsupportedOperationException If engine format conversion is not supported by this backend
+     */
+    default void setEngineConversion(boolean engineConversion) throws AudioBackendException {
+        throw new UnsupportedOperationException("Engine format conversion is not supported by " + getClass().getSimpleName() + ".");
+    }
+}
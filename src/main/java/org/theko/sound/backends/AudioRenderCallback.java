@@ -0,0 +1,54 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.theko.sound.backends;
+
+/**
+ * A callback used by output backends running in pull mode.
+ * <p>
+ * In pull mode the backend owns the render thread: it waits for the device to request
+ * more data and then calls {@link #render(byte[], int, int)} to fill the requested amount
+ * of bytes, in the format returned by {@link AudioOutputBackend#open}.
+ * <p>
+ * The callback is invoked from a backend-owned (possibly native) real-time thread.
+ * Implementations should not block, and should avoid calling back into the output backend.
+ *
+ * @see AudioOutputBackend#setRenderCallback(AudioRenderCallback)
+ *
+ * @since 0.3.1-beta
+ * @author Theko
+ */
+@FunctionalInterface
+public interface AudioRenderCallback {
+
+    /**
+     * Fills the buffer with audio data for the device.
+     *
+     * @param buffer The buffer to fill
+     * @param offset The offset in the buffer at which to start writing
+     * @param length The number of bytes requested by the device
+     * @return The number of bytes written; the rest of the requested length is filled with silence
+     */
+    int render(byte[] buffer, int offset, int length);
+
+    /**
+     * Called when the render thread stops because the device was invalidated or removed.
+     * The default implementation does nothing.
+     */
+    default void onDeviceInvalidated() {
+        // No default handling.
+    }
+}
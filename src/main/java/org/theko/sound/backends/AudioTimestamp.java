@@ -0,0 +1,136 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.theko.sound.backends;
+
+/**
+ * A consistent clock reading of an output stream: the frame position played by the device,
+ * the system time it was sampled at, the stream latency and the amount of queued audio.
+ * <p>
+ * The time is comparable with {@link System#nanoTime()}, so the position can be extrapolated
+ * to any moment with {@link #getFramePositionAt(long)} and the drift between the device clock
+ * and another clock can be measured from two readings without polling.
+ *
+ * @see AudioOutputBackend#getTimestamp()
+ *
+ * @since 0.3.1-beta
+ * @author Theko
+ */
+public final class AudioTimestamp {
+
+    private final long framePosition;
+    private final long nanoTime;
+    private final int sampleRate;
+    private final long latencyMicros;
+    private final long bufferedFrames;
+    private final long devicePosition;
+    private final long deviceFrequency;
+
+    /**
+     * Creates a timestamp.
+     *
+     * @param framePosition The frame position played by the device
+     * @param nanoTime The {@link System#nanoTime()} time of the frame position
+     * @param sampleRate The sample rate of the stream, in Hz
+     * @param latencyMicros The stream latency, in microseconds, or -1 if unknown
+     * @param bufferedFrames The frames queued for playback, or -1 if unknown
+     * @param devicePosition The raw device clock position, or -1 if unknown
+     * @param deviceFrequency The device clock frequency, in units per second, or -1 if unknown
+     */
+    public AudioTimestamp(long framePosition, long nanoTime, int sampleRate, long latencyMicros,
+                          long bufferedFrames, long devicePosition, long deviceFrequency) {
+        if (sampleRate <= 0) throw new IllegalArgumentException("Sample rate must be positive.");
+        this.framePosition = framePosition;
+        this.nanoTime = nanoTime;
+        this.sampleRate = sampleRate;
+        this.latencyMicros = latencyMicros;
+        this.bufferedFrames = bufferedFrames;
+        this.devicePosition = devicePosition;
+        this.deviceFrequency = deviceFrequency;
+    }
+
+    /**
+     * @return The frame position played by the device
+     */
+    public long getFramePosition() {
+        return framePosition;
+    }
+
+    /**
+     * @return The {@link System#nanoTime()} time at which the frame position was played
+     */
+    public long getNanoTime() {
+        return nanoTime;
+    }
+
+    /**
+     * @return The sample rate of the stream, in Hz
+     */
+    public int getSampleRate() {
+        return sampleRate;
+    }
+
+    /**
+     * @return The stream latency, in microseconds, or -1 if unknown
+     */
+    public long getLatencyMicros() {
+        return latencyMicros;
+    }
+
+    /**
+     * @return The frames queued for playback at the time of the reading, or -1 if unknown
+     */
+    public long getBufferedFrames() {
+        return bufferedFrames;
+    }
+
+    /**
+     * @return The raw device clock position, in {@link #getDeviceFrequency()} units, or -1 if unknown
+     */
+    public long getDevicePosition() {
+        return devicePosition;
+    }
+
+    /**
+     * @return The device clock frequency, in units per second, or -1 if unknown
+     */
+    public long getDeviceFrequency() {
+        return deviceFrequency;
+    }
+
+    /**
+     * Extrapolates the frame position to the given time, assuming the nominal sample rate.
+     *
+     * @param nanoTime A {@link System#nanoTime()} time
+     * @return The estimated frame position played at that time
+     */
+    public long getFramePositionAt(long nanoTime) {
+        return framePosition + (nanoTime - this.nanoTime) * sampleRate / 1_000_000_000L;
+    }
+
+    /**
+     * @return The position played by the device, in microseconds
+     */
+    public long getMicrosecondPosition() {
+        return framePosition * 1_000_000L / sampleRate;
+    }
+
+    @Override
+    public String toString() {
+        return String.format("AudioTimestamp{Frame: %d, Time: %d ns, Sample rate: %d Hz, Latency: %d us, Buffered: %d frames}",
+            framePosition, nanoTime, sampleRate, latencyMicros, bufferedFrames);
+    }
+}
@@ -0,0 +1,180 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.theko.sound.backends;
+
+import org.theko.sound.util.Histogram;
+
+/**
+ * Glitch counters and timing histograms of a backend stream, recorded by its native render
+ * or capture thread.
+ * <p>
+ * The counters only grow while the stream is open, so rates are the differences between
+ * two snapshots. A snapshot is read without stopping the stream thread: each value is
+ * up to date on its own, values read together may be one device period apart.
+ * <p>
+ * For an input stream, glitches are discontinuities reported by the device and frames
+ * dropped because the capture buffer was full, and silent buffers are packets the device
+ * flagged as silent.
+ *
+ * @see AudioOutputBackend#getTelemetry()
+ * @see AudioInputBackend#getTelemetry()
+ *
+ * @since 0.3.1-beta
+ * @author Theko
+ */
+public final class BackendTelemetry {
+
+    private final long periods;
+    private final long glitches;
+    private final long silentBuffers;
+    private final long wakeTimeouts;
+    private final long deviceInvalidations;
+    private final long maxWakeJitterNanos;
+    private final long maxBufferNanos;
+    private final int bufferFrames;
+    private final long periodNanos;
+    private final Histogram wakeJitter;
+    private final Histogram padding;
+    private final Histogram bufferTime;
+
+    /**
+     * Creates a telemetry snapshot.
+     *
+     * @param periods The buffer events handled by the stream thread
+     * @param glitches The underruns of an output or the overruns of an input
+     * @param silentBuffers The buffers released or captured as silence
+     * @param wakeTimeouts The waits for a buffer event that timed out
+     * @param deviceInvalidations The times the stream thread stopped on an invalidated device
+     * @param maxWakeJitterNanos The largest deviation of a wake-up from the period, in nanoseconds
+     * @param maxBufferNanos The longest time a device buffer was held, in nanoseconds
+     * @param bufferFrames The device buffer size, in frames
+     * @param periodNanos The expected interval between wake-ups, in nanoseconds
+     * @param wakeJitter The deviations of the wake-ups from the period, a time histogram
+     * @param padding The frames queued in the device buffer at the wake-ups, over {@code [0, bufferFrames)}
+     * @param bufferTime The times the device buffers were held, a time histogram
+     */
+    public BackendTelemetry(long periods, long glitches, long silentBuffers, long wakeTimeouts,
+                            long deviceInvalidations, long maxWakeJitterNanos, long maxBufferNanos,
+                            int bufferFrames, long periodNanos,
+                            Histogram wakeJitter, Histogram padding, Histogram bufferTime) {
+        if (wakeJitter == null || padding == null || bufferTime == null) {
+            throw new IllegalArgumentException("Histograms must not be null.");
+        }
+        this.periods = periods;
+        this.glitches = glitches;
+        this.silentBuffers = silentBuffers;
+        this.wakeTimeouts = wakeTimeouts;
+        this.deviceInvalidations = deviceInvalidations;
+        this.maxWakeJitterNanos = maxWakeJitterNanos;
+        this.maxBufferNanos = maxBufferNanos;
+        this.bufferFrames = bufferFrames;
+        this.periodNanos = periodNanos;
+        this.wakeJitter = wakeJitter;
+        this.padding = padding;
+        this.bufferTime = bufferTime;
+    }
+
+    /**
+     * @return The buffer events handled by the stream thread
+     */
+    public long getPeriods() {
+        return periods;
+    }
+
+    /**
+     * @return The underruns of an output, or the discontinuities and overflows of an input
+     */
+    public long getGlitches() {
+        return glitches;
+    }
+
+    /**
+     * @return The buffers released (output) or captured (input) as silence
+     */
+    public long getSilentBuffers() {
+        return silentBuffers;
+    }
+
+    /**
+     * @return The waits for a buffer event that timed out
+     */
+    public long getWakeTimeouts() {
+        return wakeTimeouts;
+    }
+
+    /**
+     * @return The times the stream thread stopped because the device was invalidated
+     */
+    public long getDeviceInvalidations() {
+        return deviceInvalidations;
+    }
+
+    /**
+     * @return The largest deviation of a wake-up from the period, in nanoseconds
+     */
+    public long getMaxWakeJitterNanos() {
+        return maxWakeJitterNanos;
+    }
+
+    /**
+     * @return The longest time a device buffer was held, in nanoseconds
+     */
+    public long getMaxBufferNanos() {
+        return maxBufferNanos;
+    }
+
+    /**
+     * @return The device buffer size, in frames, the range of {@link #getPaddingHistogram()}
+     */
+    public int getBufferFrames() {
+        return bufferFrames;
+    }
+
+    /**
+     * @return The expected interval between wake-ups, in nanoseconds
+     */
+    public long getPeriodNanos() {
+        return periodNanos;
+    }
+
+    /**
+     * @return The deviations of the wake-ups from the period, in nanoseconds
+     */
+    public Histogram getWakeJitterHistogram() {
+        return wakeJitter;
+    }
+
+    /**
+     * @return The frames queued in the device buffer at the wake-ups
+     */
+    public Histogram getPaddingHistogram() {
+        return padding;
+    }
+
+    /**
+     * @return The times from acquiring a device buffer to releasing it, in nanoseconds
+     */
+    public Histogram getBufferTimeHistogram() {
+        return bufferTime;
+    }
+
+    @Override
+    public String toString() {
+        return String.format("BackendTelemetry{Periods: %d, Glitches: %d, Silent: %d, Timeouts: %d, Invalidations: %d, Max jitter: %d ns, Max buffer time: %d ns}",
+            periods, glitches, silentBuffers, wakeTimeouts, deviceInvalidations, maxWakeJitterNanos, maxBufferNanos);
+    }
+}
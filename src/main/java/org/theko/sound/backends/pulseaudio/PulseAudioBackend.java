@@ -0,0 +1,268 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.theko.sound.backends.pulseaudio;
+
+import java.io.File;
+import java.util.Collection;
+import java.util.List;
+import java.util.Optional;
+import java.util.concurrent.atomic.AtomicReference;
+import java.util.stream.Collectors;
+
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+import org.theko.sound.AudioFlow;
+import org.theko.sound.AudioFormat;
+import org.theko.sound.AudioPort;
+import org.theko.sound.backends.AudioBackend;
+import org.theko.sound.backends.AudioBackendException;
+import org.theko.sound.backends.AudioBackendType;
+import org.theko.sound.backends.AudioInputBackend;
+import org.theko.sound.backends.AudioOutputBackend;
+import org.theko.sound.backends.BackendNotOpenException;
+import org.theko.sound.util.FileUtilities;
+import org.theko.sound.util.NativeAudioKernels;
+import org.theko.sound.util.PlatformUtilities;
+import org.theko.sound.util.ResourceLoader;
+import org.theko.sound.util.ResourceNotFoundException;
+import org.theko.sound.util.PlatformUtilities.Platform;
+
+/**
+ * {@code PulseAudioBackend} is an implementation of the {@link AudioBackend} interface
+ * that provides audio backend functionality using the PulseAudio asynchronous API.
+ * <p>
+ * It works with a PulseAudio server and with PipeWire through {@code pipewire-pulse},
+ * which most current Linux distributions run by default.
+ * Sinks are reported as output ports and sources as input ports, monitors of sinks are skipped.
+ * The server converts the sample format, rate and channel layout of a stream to the device,
+ * so every format with a PulseAudio sample specification is supported on any port,
+ * including big-endian ones.
+ * <p>
+ * The backend loads the native library on class initialization, each backend instance
+ * and each stream keeps its own connection to the server.
+ *
+ * @author Theko
+ * @since 0.3.1-beta
+ *
+ * @see PulseAudioOutput
+ * @see PulseAudioInput
+ */
+@AudioBackendType(name = "PulseAudio",
+                description = "PulseAudio (and PipeWire) backend for Linux",
+                platforms = { Platform.LINUX },
+                priority = 10,
+                input = true, output = true)
+public sealed class PulseAudioBackend implements AudioBackend permits PulseAudioOutput, PulseAudioInput {
+
+    private static final Logger logger = LoggerFactory.getLogger(PulseAudioBackend.class);
+
+    private static final File lib64, libArm64;
+    private long backendContextPtr = 0;
+    private boolean isInitialized = false;
+
+    private static final boolean isSupported;
+
+    private static final String[] SYSTEM_LIBRARY_DIRS = {
+        "/usr/lib", "/usr/lib64", "/lib", "/lib64",
+        "/usr/lib/x86_64-linux-gnu", "/lib/x86_64-linux-gnu",
+        "/usr/lib/aarch64-linux-gnu", "/lib/aarch64-linux-gnu"
+    };
+
+    static {
+        lib64 = loadLibrary("native/libThekoPulse64.so", "X64");
+        libArm64 = loadLibrary("native/libThekoPulseArm64.so", "ARM64");
+
+        isSupported = isAvailableOnThisPlatformStatic();
+
+        if (!isSupported) {
+            logger.debug("PulseAudio backend is not supported on this platform.");
+        } else {
+            File libToLoad = switch (PlatformUtilities.getArchitecture()) {
+                case X86_64 -> lib64;
+                case ARM_64 -> libArm64;
+                default -> {
+                    logger.error("Unsupported architecture.");
+                    yield null;
+                }
+            };
+            if (libToLoad != null) {
+                try {
+                    System.load(libToLoad.getAbsolutePath());
+                    logger.info("Loaded PulseAudio library: {}", libToLoad.getName());
+                    NativeAudioKernels.onLibraryLoaded();
+                } catch (UnsatisfiedLinkError e) {
+                    logger.error("Failed to load PulseAudio library: {}", libToLoad.getAbsolutePath(), e);
+                    logger.warn("Library failed to load; API operations may be unstable. See stack trace for details: {}", e.getMessage());
+                }
+            } else {
+                logger.error("PulseAudio library is null for architecture {}", PlatformUtilities.getArchitecture());
+            }
+        }
+    }
+
+    private static File loadLibrary(String resourcePath, String archLabel) {
+        try {
+            return ResourceLoader.getResourceFile(resourcePath);
+        } catch (ResourceNotFoundException e) {
+            logger.debug("{} library was not found: {}", archLabel, resourcePath);
+            return null;
+        }
+    }
+
+    protected static boolean isAvailableOnThisPlatformStatic() {
+        boolean isLinux = PlatformUtilities.getPlatform() == Platform.LINUX;
+        boolean hasLibraryResource = switch (PlatformUtilities.getArchitecture()) {
+            case X86_64 -> lib64 != null;
+            case ARM_64 -> libArm64 != null;
+            default -> false;
+        };
+        boolean hasSysLibrary = isLinux && hasPulseSystemLib();
+
+        logger.trace("isLinux: {}, hasLibraryResource: {}, hasSysLibrary: {}", isLinux, hasLibraryResource, hasSysLibrary);
+
+        return isLinux && hasLibraryResource && hasSysLibrary;
+    }
+
+    private static boolean hasPulseSystemLib() {
+        for (String dir : SYSTEM_LIBRARY_DIRS) {
+            if (FileUtilities.existsAny(new File(dir), "libpulse.so.0")) return true;
+        }
+        return false;
+    }
+
+    @Override
+    public boolean isAvailableOnThisPlatform() {
+        return isSupported;
+    }
+
+    @Override
+    public void initialize() throws AudioBackendException {
+        if (isInitialized) return;
+        this.backendContextPtr = nInit();
+        if (backendContextPtr == 0) {
+            throw new AudioBackendException("Failed to initialize PulseAudio backend.");
+        }
+        isInitialized = true;
+    }
+
+    @Override
+    public void shutdown() throws AudioBackendException {
+        if (!isInitialized) return;
+        nShutdown(backendContextPtr);
+        backendContextPtr = 0;
+        isInitialized = false;
+    }
+
+    @Override
+    public Collection<AudioPort> getAllPorts() throws BackendNotOpenException {
+        boolean initBefore = false;
+        if (!isInitialized()) {
+            initBefore = true;
+            initialize();
+        }
+        try {
+            AudioPort[] ports = nGetAllPorts(backendContextPtr);
+            return (ports == null || ports.length == 0) ? List.of() : List.of(ports);
+        } finally {
+            if (initBefore) {
+                shutdown();
+            }
+        }
+    }
+
+    @Override
+    public Collection<AudioPort> getAvailablePorts(AudioFlow flow) throws BackendNotOpenException {
+        if (flow == null) return List.of();
+
+        return getAllPorts().stream()
+                .filter(port -> port.getFlow() == flow)
+                .collect(Collectors.toList());
+    }
+
+    @Override
+    public Collection<AudioPort> getAvailablePorts(AudioFlow flow, AudioFormat audioFormat) throws BackendNotOpenException {
+        if (flow == null || audioFormat == null) return List.of();
+
+        return getAllPorts().stream()
+                .filter(port -> port.getFlow() == flow && isFormatSupported(port, audioFormat))
+                .collect(Collectors.toList());
+    }
+
+    @Override
+    public Optional<AudioPort> getDefaultPort(AudioFlow flow) throws BackendNotOpenException {
+        if (flow == null) return Optional.empty();
+
+        boolean initBefore = false;
+        if (!isInitialized()) {
+            initBefore = true;
+            initialize();
+        }
+        try {
+            return Optional.ofNullable(nGetDefaultPort(backendContextPtr, flow));
+        } finally {
+            if (initBefore) {
+                shutdown();
+            }
+        }
+    }
+
+    @Override
+    public Optional<AudioPort> getPort(AudioFlow flow, AudioFormat audioFormat) throws BackendNotOpenException {
+        if (flow == null || audioFormat == null) return Optional.empty();
+        return getAvailablePorts(flow, audioFormat).stream().findFirst();
+    }
+
+    @Override
+    public boolean isFormatSupported(AudioPort port, AudioFormat audioFormat, AtomicReference<AudioFormat> closestFormat) {
+        if (port == null || !isAudioPortSupported(port)) return false;
+        if (audioFormat == null) return false;
+
+        logger.trace("Checking if audio format: {} is supported for port: {}", audioFormat, port);
+        // Does not need a server connection
+        return nIsFormatSupported(port, audioFormat, closestFormat);
+    }
+
+    @Override
+    public boolean isFormatSupported(AudioPort port, AudioFormat audioFormat) {
+        return isFormatSupported(port, audioFormat, null);
+    }
+
+    @Override
+    public AudioInputBackend getInputBackend() {
+        return new PulseAudioInput();
+    }
+
+    @Override
+    public AudioOutputBackend getOutputBackend() {
+        return new PulseAudioOutput();
+    }
+
+    @Override
+    public boolean isInitialized() {
+        return isInitialized;
+    }
+
+    public boolean isAudioPortSupported(AudioPort port) {
+        return port != null && port.getLink() != null && port.getLink().getClass().equals(PulseAudioPortHandle.class);
+    }
+
+    private synchronized native long nInit();
+    private synchronized native void nShutdown(long backendContextPtr);
+    private synchronized native AudioPort[] nGetAllPorts(long backendContextPtr);
+    private synchronized native AudioPort nGetDefaultPort(long backendContextPtr, AudioFlow flow);
+    private synchronized native boolean nIsFormatSupported(AudioPort port, AudioFormat audioFormat, AtomicReference<AudioFormat> closestFormat);
+}
@@ -0,0 +1,332 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.theko.sound.backends.pulseaudio;
+
+import java.nio.ByteBuffer;
+import java.util.concurrent.atomic.AtomicReference;
+
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+import org.theko.sound.AudioFlow;
+import org.theko.sound.AudioFormat;
+import org.theko.sound.AudioPort;
+import org.theko.sound.AudioUnitsConverter;
+import org.theko.sound.backends.AudioBackendException;
+import org.theko.sound.backends.AudioInputBackend;
+import org.theko.sound.backends.BackendNotOpenException;
+
+/**
+ * {@code PulseAudioInput} is an implementation of the {@link AudioInputBackend} interface
+ * that captures audio through a PulseAudio record stream.
+ * <p>
+ * Captured fragments are read straight from the stream memory of the server connection.
+ * {@link #read(byte[], int, int)} waits for the next fragment while none is pending,
+ * {@link #read(ByteBuffer)} with a direct buffer returns what is already captured without blocking.
+ * {@link #available()} reports the captured bytes and {@link #getBufferSize()}
+ * the maximum length of the server buffer.
+ * <p>
+ * Server-side overflows and holes in the captured data are counted, see {@link #getOverflowCount()}
+ * and {@link #getDiscontinuityCount()}. With {@link #setLowLatency(boolean)}, the server is asked
+ * for smaller fragments.
+ *
+ * @see PulseAudioBackend
+ *
+ * @author Theko
+ * @since 0.3.1-beta
+ */
+public final class PulseAudioInput extends PulseAudioBackend implements AudioInputBackend {
+
+    private static final Logger logger = LoggerFactory.getLogger(PulseAudioInput.class);
+
+    private long inputContextPtr;
+
+    private boolean isOpen = false;
+    private boolean isStarted = false;
+    private int bufferSize = -1;
+    private AudioFormat audioFormat = null;
+    private AudioPort port = null;
+    private boolean lowLatency = false;
+
+    @Override
+    public synchronized AudioFormat open(AudioPort port, AudioFormat audioFormat, int bufferSize) throws AudioBackendException {
+        if (isOpen()) throw new AudioBackendException("Backend is already open.");
+        if (port == null) {
+            // Get default input port
+            port = super.getDefaultPort(AudioFlow.IN).orElse(null);
+            if (port == null) throw new IllegalArgumentException("Port is null.");
+        }
+        if (port.getFlow() != AudioFlow.IN) throw new IllegalArgumentException("Port is not an input port.");
+        if (port.getLink() == null) throw new IllegalArgumentException("Port link is null.");
+        if (audioFormat == null) throw new IllegalArgumentException("Audio format is null.");
+        if (bufferSize <= 0) throw new IllegalArgumentException("Buffer size is less than or equal to zero.");
+
+        if (!isInitialized()) {
+            logger.debug("Initializing PulseAudio.");
+            initialize();
+        }
+        logger.debug("Opening input port: {}, audio format: {}, buffer size: {}", port, audioFormat, bufferSize);
+        AtomicReference<AudioFormat> openedFormat = new AtomicReference<>();
+        this.inputContextPtr = nOpen(port, audioFormat, bufferSize, openedFormat, lowLatency);
+        if (this.inputContextPtr == 0) throw new AudioBackendException("Failed to open input.");
+
+        this.bufferSize = bufferSize;
+        this.audioFormat = audioFormat;
+        this.port = port;
+        isOpen = true;
+
+        return openedFormat.get();
+    }
+
+    @Override
+    public AudioFormat open(AudioPort port, AudioFormat audioFormat) throws AudioBackendException {
+        return this.open(port, audioFormat, audioFormat.getByteRate() / 4 /* 0.25 seconds */);
+    }
+
+    @Override
+    public boolean isOpen() throws AudioBackendException {
+        return super.isInitialized() && isOpen && inputContextPtr != 0;
+    }
+
+    /**
+     * Checks if the audio input backend is started.
+     *
+     * @return True if the backend is started and opened, false otherwise
+     * @throws AudioBackendException If an error occurs during the operation
+     */
+    public boolean isStarted() throws AudioBackendException {
+        return isOpen() && isStarted;
+    }
+
+    @Override
+    public void close() throws AudioBackendException {
+        if (!isOpen()) {
+            logger.debug("Cannot close. Backend is not open.");
+            return;
+        }
+        if (isStarted) stop();
+        long discontinuities = nGetDiscontinuityCount(inputContextPtr);
+        long overflows = nGetOverflowCount(inputContextPtr);
+        if (discontinuities > 0 || overflows > 0) {
+            logger.info("Capture glitches: {} discontinuities, {} overflows.", discontinuities, overflows);
+        }
+        if (isOpen || inputContextPtr != 0) nClose(inputContextPtr);
+        if (super.isInitialized()) super.shutdown();
+        isOpen = false;
+        isStarted = false;
+        bufferSize = -1;
+        audioFormat = null;
+        port = null;
+        inputContextPtr = 0;
+        logger.debug("Closed.");
+    }
+
+    @Override
+    public void start() throws AudioBackendException, BackendNotOpenException {
+        if (!isOpen()) throw new BackendNotOpenException("Cannot start. Backend is not open.");
+        if (isStarted) return;
+        nStart(inputContextPtr);
+        isStarted = true;
+    }
+
+    @Override
+    public void stop() throws AudioBackendException, BackendNotOpenException {
+        if (!isOpen()) throw new BackendNotOpenException("Cannot stop. Backend is not open.");
+        if (!isStarted) return;
+        nStop(inputContextPtr);
+        isStarted = false;
+    }
+
+    @Override
+    public void flush() throws AudioBackendException, BackendNotOpenException {
+        if (!isOpen()) throw new BackendNotOpenException("Cannot flush. Backend is not open.");
+        nFlush(inputContextPtr);
+    }
+
+    @Override
+    public void drain() throws AudioBackendException, BackendNotOpenException {
+        if (!isOpen()) throw new BackendNotOpenException("Cannot drain. Backend is not open.");
+        nDrain(inputContextPtr);
+    }
+
+    @Override
+    public int read(byte[] data, int offset, int length) throws AudioBackendException, BackendNotOpenException {
+        if (!isOpen()) throw new BackendNotOpenException("Cannot read. Backend is not open.");
+        int waitMs = getWaitTimeout();
+        int totalRead = 0;
+        while (totalRead < length) {
+            int read = nRead(inputContextPtr, data, offset + totalRead, length - totalRead);
+            if (read == -1) break;
+            totalRead += read;
+            if (read == 0 && !nWaitForData(inputContextPtr, waitMs) && !isStarted()) break;
+        }
+        return totalRead;
+    }
+
+    @Override
+    public int read(ByteBuffer buffer) throws AudioBackendException, BackendNotOpenException {
+        if (!isOpen()) throw new BackendNotOpenException("Cannot read. Backend is not open.");
+        if (!buffer.isDirect()) return AudioInputBackend.super.read(buffer);
+
+        int read = nReadDirect(inputContextPtr, buffer, buffer.position(), buffer.remaining());
+        if (read > 0) {
+            buffer.position(buffer.position() + read);
+        }
+        return Math.max(read, 0);
+    }
+
+    @Override
+    public int available() throws AudioBackendException, BackendNotOpenException {
+        if (!isOpen()) throw new BackendNotOpenException("Cannot get available. Backend is not open.");
+        return nAvailable(inputContextPtr);
+    }
+
+    @Override
+    public int getBufferSize() throws AudioBackendException, BackendNotOpenException {
+        if (!isOpen()) throw new BackendNotOpenException("Cannot get buffer size. Backend is not open.");
+        int bufferSize = this.bufferSize;
+        try {
+            int nativeBufferSize = nGetBufferSize(inputContextPtr);
+            if (nativeBufferSize == -1) {
+                return bufferSize;
+            }
+            return nativeBufferSize;
+        } catch (AudioBackendException e) {
+            logger.error("Failed to get native buffer size.", e);
+            return bufferSize;
+        }
+    }
+
+    @Override
+    public long getFramePosition() throws AudioBackendException, BackendNotOpenException {
+        if (!isOpen()) throw new BackendNotOpenException("Cannot get frame position. Backend is not open.");
+        return nGetFramePosition(inputContextPtr);
+    }
+
+    @Override
+    public long getMicrosecondPosition() throws AudioBackendException, BackendNotOpenException {
+        if (!isOpen()) throw new BackendNotOpenException("Cannot get microsecond position. Backend is not open.");
+        return AudioUnitsConverter.framesToMicroseconds(getFramePosition(), audioFormat.getSampleRate());
+    }
+
+    @Override
+    public long getMicrosecondLatency() throws AudioBackendException, BackendNotOpenException {
+        if (!isOpen()) throw new BackendNotOpenException("Cannot get latency. Backend is not open.");
+        long latency = (long) ((bufferSize / (float) audioFormat.getSampleRate()) * 1000000);
+        try {
+            long nativeLatency = nGetMicrosecondLatency(inputContextPtr);
+            if (nativeLatency == -1) {
+                return latency;
+            }
+            return nativeLatency;
+        } catch (AudioBackendException ex) {
+            logger.error("Error getting latency", ex);
+            return latency;
+        }
+    }
+
+    @Override
+    public AudioPort getCurrentAudioPort() throws AudioBackendException, BackendNotOpenException {
+        if (!isOpen()) throw new BackendNotOpenException("Cannot get current audio port. Backend is not open.");
+        AudioPort port = this.port;
+        try {
+            AudioPort nativePort = nGetCurrentAudioPort(inputContextPtr);
+            if (nativePort == null) {
+                return port;
+            }
+            return nativePort;
+        } catch (AudioBackendException ex) {
+            logger.error("Error getting current audio port", ex);
+            return port;
+        }
+    }
+
+    /**
+     * Returns the number of holes in the captured data, where the server skipped
+     * part of the stream, usually due to a glitch.
+     *
+     * @return The number of discontinuities since the backend was opened
+     * @throws BackendNotOpenException If the backend is not open
+     */
+    public long getDiscontinuityCount() throws AudioBackendException, BackendNotOpenException {
+        if (!isOpen()) throw new BackendNotOpenException("Cannot get discontinuity count. Backend is not open.");
+        return nGetDiscontinuityCount(inputContextPtr);
+    }
+
+    /**
+     * Returns the number of times the server buffer of the stream overflowed,
+     * that is, the data was not read fast enough and captured audio was lost.
+     *
+     * @return The overflow count since the backend was opened
+     * @throws BackendNotOpenException If the backend is not open
+     */
+    public long getOverflowCount() throws AudioBackendException, BackendNotOpenException {
+        if (!isOpen()) throw new BackendNotOpenException("Cannot get overflow count. Backend is not open.");
+        return nGetOverflowCount(inputContextPtr);
+    }
+
+    /**
+     * Requests smaller fragments from the server for the next {@link #open} call.
+     *
+     * @param lowLatency True to use smaller fragments
+     * @throws AudioBackendException If the backend is open
+     */
+    public void setLowLatency(boolean lowLatency) throws AudioBackendException {
+        if (isOpen()) throw new AudioBackendException("Cannot change low latency mode while the backend is open.");
+        this.lowLatency = lowLatency;
+    }
+
+    /**
+     * Returns the fragment size of the opened stream, in frames.
+     * The fragment size is negotiated with the server when the stream connects,
+     * so it is unknown before the backend is opened.
+     *
+     * @param port The audio port, or null for the opened port
+     * @param audioFormat The audio format
+     * @return The fragment size in frames, or -1 if unknown
+     * @throws AudioBackendException If an error occurs during the operation
+     */
+    public int getPeriodFrames(AudioPort port, AudioFormat audioFormat) throws AudioBackendException {
+        if (isOpen() && (port == null || port == this.port) && audioFormat == this.audioFormat) {
+            return nGetPeriodFrames(inputContextPtr);
+        }
+        return -1;
+    }
+
+    private int getWaitTimeout() {
+        int periodFrames = nGetPeriodFrames(inputContextPtr);
+        if (periodFrames <= 0) return 10;
+        return Math.max(1, (int) (periodFrames * 1000L / audioFormat.getSampleRate()));
+    }
+
+    private synchronized native long nOpen(AudioPort port, AudioFormat audioFormat, int bufferSize, AtomicReference<AudioFormat> audioFormatRef, boolean lowLatency);
+    private synchronized native void nClose(long inputContextPtr);
+    private synchronized native void nStart(long inputContextPtr);
+    private synchronized native void nStop(long inputContextPtr);
+    private synchronized native void nFlush(long inputContextPtr);
+    private synchronized native void nDrain(long inputContextPtr);
+    private synchronized native int nRead(long inputContextPtr, byte[] data, int offset, int length);
+    private synchronized native int nReadDirect(long inputContextPtr, ByteBuffer buffer, int offset, int length);
+    private native boolean nWaitForData(long inputContextPtr, int timeoutMs);
+    private synchronized native int nAvailable(long inputContextPtr);
+    private synchronized native int nGetBufferSize(long inputContextPtr);
+    private synchronized native long nGetFramePosition(long inputContextPtr);
+    private synchronized native long nGetMicrosecondLatency(long inputContextPtr);
+    private synchronized native int nGetPeriodFrames(long inputContextPtr);
+    private synchronized native long nGetOverflowCount(long inputContextPtr);
+    private synchronized native long nGetDiscontinuityCount(long inputContextPtr);
+    private synchronized native AudioPort nGetCurrentAudioPort(long inputContextPtr);
+}
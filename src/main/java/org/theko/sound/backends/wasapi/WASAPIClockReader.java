@@ -0,0 +1,94 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.theko.sound.backends.wasapi;
+
+import java.lang.invoke.MethodHandles;
+import java.lang.invoke.VarHandle;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+
+import org.theko.sound.backends.AudioTimestamp;
+
+/**
+ * Reads the clock snapshot that the native render thread publishes every device period,
+ * straight from native memory and without a JNI call.
+ * <p>
+ * The snapshot is a seqlock of little-endian 64-bit fields (see {@code clock_snapshot.hpp}):
+ * a reading is consistent when the sequence is even and unchanged across the reads.
+ *
+ * @since 0.3.1-beta
+ * @author Theko
+ */
+final class WASAPIClockReader {
+
+    private static final VarHandle LONGS = MethodHandles.byteBufferViewVarHandle(long[].class, ByteOrder.LITTLE_ENDIAN);
+
+    private static final int SEQUENCE = 0;
+    private static final int FRAME_POSITION = 8;
+    private static final int QPC_TIME = 16;
+    private static final int DEVICE_POSITION = 24;
+    private static final int DEVICE_FREQUENCY = 32;
+    private static final int STREAM_LATENCY = 40;
+    private static final int BUFFERED_FRAMES = 48;
+    private static final int SAMPLE_RATE = 56;
+    private static final int SIZE = 64;
+
+    private static final int MAX_ATTEMPTS = 64;
+
+    private final ByteBuffer buffer;
+
+    /**
+     * @param buffer The direct buffer over the native snapshot, valid until the stream is closed
+     */
+    WASAPIClockReader(ByteBuffer buffer) {
+        if (buffer == null || !buffer.isDirect() || buffer.capacity() < SIZE) {
+            throw new IllegalArgumentException("Invalid clock buffer.");
+        }
+        this.buffer = buffer;
+    }
+
+    /**
+     * @return The latest published reading, or null if nothing was published yet
+     *         or the writer kept it busy for all attempts
+     */
+    AudioTimestamp read() {
+        for (int attempt = 0; attempt < MAX_ATTEMPTS; attempt++) {
+            long sequence = (long) LONGS.getAcquire(buffer, SEQUENCE);
+            if (sequence == 0) return null;
+            if ((sequence & 1) != 0) {
+                Thread.onSpinWait();
+                continue;
+            }
+
+            long framePosition = (long) LONGS.get(buffer, FRAME_POSITION);
+            long qpcTime = (long) LONGS.get(buffer, QPC_TIME);
+            long devicePosition = (long) LONGS.get(buffer, DEVICE_POSITION);
+            long deviceFrequency = (long) LONGS.get(buffer, DEVICE_FREQUENCY);
+            long streamLatency = (long) LONGS.get(buffer, STREAM_LATENCY);
+            long bufferedFrames = (long) LONGS.get(buffer, BUFFERED_FRAMES);
+            long sampleRate = (long) LONGS.get(buffer, SAMPLE_RATE);
+
+            VarHandle.acquireFence();
+            if ((long) LONGS.get(buffer, SEQUENCE) != sequence || sampleRate <= 0) continue;
+
+            // IAudioClock reports QPC time in 100-ns units, System.nanoTime() is QPC-based on Windows
+            return new AudioTimestamp(framePosition, qpcTime * 100, (int) sampleRate,
+                streamLatency / 10, bufferedFrames, devicePosition, deviceFrequency);
+        }
+        return null;
+    }
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.theko.sound.backends.wasapi;
+
+/**
+ * Shared-mode engine periods supported by a WASAPI endpoint for a stream format,
+ * as reported by {@code IAudioClient3::GetSharedModeEnginePeriod} (Windows 10 and newer).
+ * <p>
+ * Any period between {@link #getMinFrames()} and {@link #getMaxFrames()} that is a multiple
+ * of {@link #getFundamentalFrames()} can be used by a low-latency shared stream.
+ *
+ * @see WASAPISharedBackend#getEnginePeriods(org.theko.sound.AudioPort, org.theko.sound.AudioFormat)
+ *
+ * @since 0.3.1-beta
+ * @author Theko
+ */
+public final class WASAPIEnginePeriods {
+
+    private final int defaultFrames;
+    private final int fundamentalFrames;
+    private final int minFrames;
+    private final int maxFrames;
+    private final int sampleRate;
+
+    WASAPIEnginePeriods(int defaultFrames, int fundamentalFrames, int minFrames, int maxFrames, int sampleRate) {
+        this.defaultFrames = defaultFrames;
+        this.fundamentalFrames = fundamentalFrames;
+        this.minFrames = minFrames;
+        this.maxFrames = maxFrames;
+        this.sampleRate = sampleRate;
+    }
+
+    /**
+     * @return The default engine period, in frames
+     */
+    public int getDefaultFrames() {
+        return defaultFrames;
+    }
+
+    /**
+     * @return The granularity of the supported periods, in frames
+     */
+    public int getFundamentalFrames() {
+        return fundamentalFrames;
+    }
+
+    /**
+     * @return The smallest supported period, in frames
+     */
+    public int getMinFrames() {
+        return minFrames;
+    }
+
+    /**
+     * @return The largest supported period, in frames
+     */
+    public int getMaxFrames() {
+        return maxFrames;
+    }
+
+    /**
+     * @return The sample rate the periods were queried for, in Hz
+     */
+    public int getSampleRate() {
+        return sampleRate;
+    }
+
+    /**
+     * @return The smallest supported period, in microseconds
+     */
+    public long getMinMicroseconds() {
+        return sampleRate > 0 ? minFrames * 1_000_000L / sampleRate : -1;
+    }
+
+    /**
+     * @return The default engine period, in microseconds
+     */
+    public long getDefaultMicroseconds() {
+        return sampleRate > 0 ? defaultFrames * 1_000_000L / sampleRate : -1;
+    }
+
+    @Override
+    public String toString() {
+        return String.format("WASAPIEnginePeriods{Default: %d, Fundamental: %d, Min: %d, Max: %d frames, Sample rate: %d Hz}",
+            defaultFrames, fundamentalFrames, minFrames, maxFrames, sampleRate);
+    }
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.theko.sound.backends.wasapi;
+
+import java.util.Arrays;
+import java.util.Comparator;
+import java.util.List;
+import java.util.Objects;
+import java.util.Optional;
+import java.util.concurrent.atomic.AtomicReference;
+import java.util.stream.Collectors;
+
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+import org.theko.sound.AudioFlow;
+import org.theko.sound.AudioFormat;
+import org.theko.sound.AudioPort;
+import org.theko.sound.backends.AudioBackendType;
+import org.theko.sound.backends.AudioInputBackend;
+import org.theko.sound.backends.AudioOutputBackend;
+import org.theko.sound.backends.BackendNotOpenException;
+import org.theko.sound.util.PlatformUtilities.Platform;
+
+/**
+ * {@code WASAPIExclusiveBackend} provides audio output through the Windows Audio Session API (WASAPI)
+ * in exclusive mode.
+ * <p>
+ * In exclusive mode the stream bypasses the Windows audio engine: there is no system mixer and
+ * no system resampler, so audio in a format the device supports natively reaches it bit-perfect,
+ * with the device period as the only buffering latency. Format support is checked against the
+ * device itself, so {@link org.theko.sound.AudioOutputLayer} opens the device at the source sample rate
+ * whenever the device supports it, instead of resampling to the mix format.
+ * <p>
+ * Exclusive access takes the device away from all other applications, so this backend is never
+ * selected automatically. If the device cannot be opened exclusively, the output falls back to
+ * {@link WASAPISharedOutput} unless {@code org.theko.sound.backends.wasapiExclusiveFallback} is disabled.
+ * Input uses the shared mode backend.
+ *
+ * @see WASAPIExclusiveOutput
+ * @see WASAPISharedBackend
+ *
+ * @since 0.3.1-beta
+ * @author Theko
+ */
+@AudioBackendType(name = "WASAPIExclusive",
+                description = "WASAPI backend in exclusive mode for Windows",
+                platforms = { Platform.WINDOWS },
+                priority = 5,
+                autoSelect = false,
+                input = false, output = true)
+public sealed class WASAPIExclusiveBackend extends WASAPISharedBackend permits WASAPIExclusiveOutput {
+
+    private static final Logger logger = LoggerFactory.getLogger(WASAPIExclusiveBackend.class);
+
+    @Override
+    public boolean isFormatSupported(AudioPort port, AudioFormat audioFormat, AtomicReference<AudioFormat> closestFormat) throws BackendNotOpenException {
+        if (port == null || !isAudioPortSupported(port) || port.getFlow() != AudioFlow.OUT) return false;
+        if (audioFormat == null) return false;
+
+        boolean initBefore = false;
+        if (!isInitialized()) {
+            initBefore = true;
+            initialize();
+        }
+        try {
+            logger.trace("Checking if audio format: {} is supported in exclusive mode for port: {}", audioFormat, port);
+            if (nIsExclusiveFormatSupported(port, audioFormat)) return true;
+
+            if (closestFormat != null) {
+                findClosestFormat(getExclusiveFormats(port), audioFormat).ifPresent(closestFormat::set);
+            }
+            return false;
+        } finally {
+            if (initBefore) {
+                shutdown();
+            }
+        }
+    }
+
+    /**
+     * Probes the formats the device accepts in exclusive mode. The device format, if it
+     * is supported, comes first, followed by common PCM and float formats at the device's
+     * channel count.
+     *
+     * @param port The output port
+     * @return The supported formats, or an empty list if the port cannot be probed
+     * @throws BackendNotOpenException If the backend cannot be initialized
+     */
+    public List<AudioFormat> getExclusiveFormats(AudioPort port) throws BackendNotOpenException {
+        if (port == null || !isAudioPortSupported(port) || port.getFlow() != AudioFlow.OUT) return List.of();
+
+        boolean initBefore = false;
+        if (!isInitialized()) {
+            initBefore = true;
+            initialize();
+        }
+        try {
+            AudioFormat[] formats = nGetExclusiveFormats(port);
+            if (formats == null) return List.of();
+            return Arrays.stream(formats).filter(Objects::nonNull).collect(Collectors.toUnmodifiableList());
+        } finally {
+            if (initBefore) {
+                shutdown();
+            }
+        }
+    }
+
+    /*
+     * Prefers a format at the same sample rate, so the caller only converts the sample
+     * encoding and never resamples, then the same channel count, then the best resolution.
+     */
+    private static Optional<AudioFormat> findClosestFormat(List<AudioFormat> formats, AudioFormat target) {
+        return formats.stream().max(Comparator
+                .comparing((AudioFormat f) -> f.getSampleRate() == target.getSampleRate())
+                .thenComparing(f -> f.getChannels() == target.getChannels())
+                .thenComparing(f -> f.getEncoding() == target.getEncoding())
+                .thenComparingInt(f -> -Math.abs(f.getBitsPerSample() - target.getBitsPerSample())));
+    }
+
+    @Override
+    public AudioInputBackend getInputBackend() {
+        return new WASAPISharedInput();
+    }
+
+    @Override
+    public AudioOutputBackend getOutputBackend() {
+        return new WASAPIExclusiveOutput();
+    }
+
+    private synchronized native boolean nIsExclusiveFormatSupported(AudioPort port, AudioFormat audioFormat);
+    private synchronized native AudioFormat[] nGetExclusiveFormats(AudioPort port);
+}
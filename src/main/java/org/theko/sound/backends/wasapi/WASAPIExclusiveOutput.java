@@ -0,0 +1,379 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.theko.sound.backends.wasapi;
+
+import static org.theko.sound.properties.AudioSystemProperties.BACKENDS_WASAPI_EXCLUSIVE_FALLBACK;
+
+import java.nio.ByteBuffer;
+import java.util.Optional;
+import java.util.concurrent.atomic.AtomicReference;
+
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+import org.theko.sound.AudioFlow;
+import org.theko.sound.AudioFormat;
+import org.theko.sound.AudioPort;
+import org.theko.sound.AudioUnitsConverter;
+import org.theko.sound.UnsupportedAudioFormatException;
+import org.theko.sound.backends.AudioBackendException;
+import org.theko.sound.backends.AudioOutputBackend;
+import org.theko.sound.backends.AudioTimestamp;
+import org.theko.sound.backends.BackendNotOpenException;
+import org.theko.sound.backends.BackendTelemetry;
+
+/**
+ * {@code WASAPIExclusiveOutput} is an implementation of the {@link AudioOutputBackend} interface
+ * that provides audio output using the Windows Audio Session API (WASAPI) in exclusive mode.
+ * <p>
+ * The stream is event-driven: the endpoint buffer holds exactly one device period, which
+ * a native render thread, registered with MMCSS ("Pro Audio"), fills from a ring buffer every
+ * period. {@link #write} is non-blocking and copies data into the ring buffer, like
+ * {@link WASAPISharedOutput}. The period is the default device period, or the minimum one
+ * with {@link #setLowLatency(boolean)}, aligned to the driver's buffer alignment.
+ * <p>
+ * Only formats the device accepts in exclusive mode can be opened, there is no closest match.
+ * If the device cannot be opened exclusively (the format is not supported, it is in use or
+ * exclusive mode is not allowed), the output opens a {@link WASAPISharedOutput} instead and
+ * forwards every call to it, unless {@code org.theko.sound.backends.wasapiExclusiveFallback} is disabled.
+ *
+ * @see WASAPIExclusiveBackend
+ *
+ * @since 0.3.1-beta
+ * @author Theko
+ */
+public final class WASAPIExclusiveOutput extends WASAPIExclusiveBackend implements AudioOutputBackend {
+
+    private static final Logger logger = LoggerFactory.getLogger(WASAPIExclusiveOutput.class);
+
+    private long outputContextPtr;
+
+    private boolean isOpen = false;
+    private boolean isStarted = false;
+    private int bufferSize = -1;
+    private AudioFormat audioFormat = null;
+    private AudioPort port = null;
+    private boolean lowLatency = false;
+    private WASAPIClockReader clock = null; // Over the native clock snapshot, valid until nClose
+    private final Object nativeReadLock = new Object(); // Held by readers, and by close() around nClose
+    private WASAPITelemetryReader telemetry = null; // Over the native stream telemetry, valid until nClose
+    private WASAPISharedOutput sharedFallback = null; // Set while opened in shared mode
+
+    @Override
+    public synchronized AudioFormat open(AudioPort port, AudioFormat audioFormat, int bufferSize)
+        throws AudioBackendException, UnsupportedAudioFormatException {
+        if (isOpen()) throw new AudioBackendException("Backend is already open.");
+        if (port == null) {
+            // Get default output port
+            port = super.getDefaultPort(AudioFlow.OUT).orElse(null);
+            if (port == null) throw new IllegalArgumentException("Port is null.");
+        }
+        if (port.getFlow() != AudioFlow.OUT) throw new IllegalArgumentException("Port is not an output port.");
+        if (port.getLink() == null) throw new IllegalArgumentException("Port link is null.");
+        if (audioFormat == null) throw new IllegalArgumentException("Audio format is null.");
+        if (audioFormat.isBigEndian()) throw new UnsupportedAudioFormatException("Big endian audio format is not supported.");
+        if (bufferSize <= 0) throw new IllegalArgumentException("Buffer size is less than or equal to zero.");
+
+        if (!isInitialized()) {
+            logger.debug("Initializing WASAPI.");
+            initialize();
+        }
+        AtomicReference<AudioFormat> openedFormat = new AtomicReference<>();
+        logger.debug("Opening exclusive output, port: {}, audio format: {}, buffer size: {}", port, audioFormat, bufferSize);
+        try {
+            this.outputContextPtr = nOpen(port, audioFormat, bufferSize, openedFormat, lowLatency);
+            if (this.outputContextPtr == 0) throw new AudioBackendException("Failed to open exclusive output.");
+        } catch (AudioBackendException ex) {
+            this.outputContextPtr = 0;
+            if (!BACKENDS_WASAPI_EXCLUSIVE_FALLBACK) throw ex;
+            logger.info("Failed to open output in exclusive mode ({}), falling back to shared mode.", ex.getMessage());
+            return openShared(port, audioFormat, bufferSize);
+        }
+
+        ByteBuffer clockBuffer = nGetClockBuffer(outputContextPtr);
+        this.clock = clockBuffer != null ? new WASAPIClockReader(clockBuffer) : null;
+        ByteBuffer telemetryBuffer = nGetTelemetryBuffer(outputContextPtr);
+        this.telemetry = telemetryBuffer != null ? new WASAPITelemetryReader(telemetryBuffer) : null;
+
+        this.bufferSize = bufferSize;
+        this.audioFormat = openedFormat.get();
+        this.port = port;
+        isOpen = true;
+
+        return openedFormat.get();
+    }
+
+    private AudioFormat openShared(AudioPort port, AudioFormat audioFormat, int bufferSize)
+        throws AudioBackendException, UnsupportedAudioFormatException {
+        WASAPISharedOutput shared = new WASAPISharedOutput();
+        shared.setLowLatency(lowLatency);
+        AudioFormat opened = shared.open(port, audioFormat, bufferSize);
+        this.sharedFallback = shared;
+        this.bufferSize = bufferSize;
+        this.audioFormat = opened;
+        this.port = port;
+        isOpen = true;
+        return opened;
+    }
+
+    @Override
+    public AudioFormat open(AudioPort port, AudioFormat audioFormat)
+        throws AudioBackendException, UnsupportedAudioFormatException {
+        return this.open(port, audioFormat, audioFormat.getByteRate() / 4 /* 0.25 seconds */);
+    }
+
+    /**
+     * Checks if the output is opened in exclusive mode, and not through the shared mode fallback.
+     *
+     * @return {@code true} if the output is open in exclusive mode, {@code false} otherwise
+     * @throws AudioBackendException If an error occurs during the operation
+     */
+    public boolean isExclusive() throws AudioBackendException {
+        return isOpen() && sharedFallback == null;
+    }
+
+    @Override
+    public boolean isOpen() throws AudioBackendException {
+        if (sharedFallback != null) return isOpen && sharedFallback.isOpen();
+        return super.isInitialized() && isOpen && outputContextPtr != 0;
+    }
+
+    /**
+     * Checks if the audio output backend is started.
+     *
+     * @return True if the backend is started and opened, false otherwise
+     * @throws AudioBackendException If an error occurs during the operation
+     */
+    public boolean isStarted() throws AudioBackendException {
+        return isOpen() && isStarted;
+    }
+
+    @Override
+    public void close() throws AudioBackendException {
+        if (!isOpen()) {
+            logger.debug("Cannot close. Backend is not open.");
+            return;
+        }
+        if (isStarted) stop();
+        synchronized (nativeReadLock) {
+            // No reader is inside the native blocks once nClose frees them
+            clock = null;
+            telemetry = null;
+            if (sharedFallback != null) {
+                sharedFallback.close();
+            } else if (outputContextPtr != 0) {
+                nClose(outputContextPtr);
+            }
+        }
+        if (super.isInitialized()) super.shutdown();
+        isOpen = false;
+        isStarted = false;
+        bufferSize = -1;
+        audioFormat = null;
+        port = null;
+        sharedFallback = null;
+        outputContextPtr = 0;
+        logger.debug("Closed.");
+    }
+
+    @Override
+    public void start() throws AudioBackendException, BackendNotOpenException {
+        if (!isOpen()) throw new BackendNotOpenException("Cannot start. Backend is not open.");
+        if (isStarted) return;
+        if (sharedFallback != null) {
+            sharedFallback.start();
+        } else {
+            nStart(outputContextPtr);
+        }
+        isStarted = true;
+    }
+
+    @Override
+    public void stop() throws AudioBackendException, BackendNotOpenException {
+        if (!isOpen()) throw new BackendNotOpenException("Cannot stop. Backend is not open.");
+        if (!isStarted) return;
+        if (sharedFallback != null) {
+            sharedFallback.stop();
+        } else {
+            nStop(outputContextPtr);
+        }
+        isStarted = false;
+    }
+
+    @Override
+    public void flush() throws AudioBackendException, BackendNotOpenException {
+        if (!isOpen()) throw new BackendNotOpenException("Cannot flush. Backend is not open.");
+        if (sharedFallback != null) {
+            sharedFallback.flush();
+            return;
+        }
+        nFlush(outputContextPtr);
+    }
+
+    @Override
+    public void drain() throws AudioBackendException, BackendNotOpenException {
+        if (!isOpen()) throw new BackendNotOpenException("Cannot drain. Backend is not open.");
+        if (sharedFallback != null) {
+            sharedFallback.drain();
+            return;
+        }
+        nDrain(outputContextPtr);
+    }
+
+    @Override
+    public int write(byte[] data, int offset, int length) throws AudioBackendException, BackendNotOpenException {
+        if (!isOpen()) throw new BackendNotOpenException("Cannot write. Backend is not open.");
+        if (sharedFallback != null) return sharedFallback.write(data, offset, length);
+        return nWrite(outputContextPtr, data, offset, length);
+    }
+
+    @Override
+    public int write(ByteBuffer buffer) throws AudioBackendException, BackendNotOpenException {
+        if (!isOpen()) throw new BackendNotOpenException("Cannot write. Backend is not open.");
+        if (sharedFallback != null) return sharedFallback.write(buffer);
+        if (!buffer.isDirect()) return AudioOutputBackend.super.write(buffer);
+
+        int written = nWriteDirect(outputContextPtr, buffer, buffer.position(), buffer.remaining());
+        if (written > 0) {
+            buffer.position(buffer.position() + written);
+        }
+        return written;
+    }
+
+    @Override
+    public int writeFloat(float[][] samples, int offset, int frames) throws AudioBackendException, BackendNotOpenException {
+        if (sharedFallback != null) return sharedFallback.writeFloat(samples, offset, frames);
+        return AudioOutputBackend.super.writeFloat(samples, offset, frames);
+    }
+
+    @Override
+    public boolean isFloatWriteSupported() {
+        return sharedFallback != null && sharedFallback.isFloatWriteSupported();
+    }
+
+    @Override
+    public int available() throws AudioBackendException, BackendNotOpenException {
+        if (!isOpen()) throw new BackendNotOpenException("Cannot get available. Backend is not open.");
+        if (sharedFallback != null) return sharedFallback.available();
+        return nAvailable(outputContextPtr);
+    }
+
+    @Override
+    public int getBufferSize() throws AudioBackendException, BackendNotOpenException {
+        if (!isOpen()) throw new BackendNotOpenException("Cannot get buffer size. Backend is not open.");
+        if (sharedFallback != null) return sharedFallback.getBufferSize();
+        int nativeBufferSize = nGetBufferSize(outputContextPtr);
+        return nativeBufferSize == -1 ? bufferSize : nativeBufferSize;
+    }
+
+    @Override
+    public long getFramePosition() throws AudioBackendException, BackendNotOpenException {
+        if (!isOpen()) throw new BackendNotOpenException("Cannot get frame position. Backend is not open.");
+        if (sharedFallback != null) return sharedFallback.getFramePosition();
+        return nGetFramePosition(outputContextPtr);
+    }
+
+    @Override
+    public Optional<AudioTimestamp> getTimestamp() throws AudioBackendException, BackendNotOpenException {
+        if (!isOpen()) throw new BackendNotOpenException("Cannot get timestamp. Backend is not open.");
+        synchronized (nativeReadLock) {
+            if (sharedFallback != null) return sharedFallback.getTimestamp();
+            WASAPIClockReader clock = this.clock;
+            if (clock == null) return Optional.empty();
+            // Published every period while started, refreshed on demand otherwise
+            if (!isStarted && !nUpdateClock(outputContextPtr)) return Optional.empty();
+            return Optional.ofNullable(clock.read());
+        }
+    }
+
+    @Override
+    public Optional<BackendTelemetry> getTelemetry() throws AudioBackendException, BackendNotOpenException {
+        if (!isOpen()) throw new BackendNotOpenException("Cannot get telemetry. Backend is not open.");
+        synchronized (nativeReadLock) {
+            if (sharedFallback != null) return sharedFallback.getTelemetry();
+            WASAPITelemetryReader telemetry = this.telemetry;
+            return telemetry != null ? Optional.of(telemetry.read()) : Optional.empty();
+        }
+    }
+
+    @Override
+    public long getMicrosecondPosition() throws AudioBackendException, BackendNotOpenException {
+        if (!isOpen()) throw new BackendNotOpenException("Cannot get microsecond position. Backend is not open.");
+        return AudioUnitsConverter.framesToMicroseconds(getFramePosition(), audioFormat.getSampleRate());
+    }
+
+    @Override
+    public long getMicrosecondLatency() throws AudioBackendException, BackendNotOpenException {
+        if (!isOpen()) throw new BackendNotOpenException("Cannot get latency. Backend is not open.");
+        if (sharedFallback != null) return sharedFallback.getMicrosecondLatency();
+        long nativeLatency = nGetMicrosecondLatency(outputContextPtr);
+        if (nativeLatency == -1) {
+            return AudioUnitsConverter.framesToMicroseconds(bufferSize / audioFormat.getFrameSize(), audioFormat.getSampleRate());
+        }
+        return nativeLatency;
+    }
+
+    @Override
+    public AudioPort getCurrentAudioPort() throws AudioBackendException, BackendNotOpenException {
+        if (!isOpen()) throw new BackendNotOpenException("Cannot get current audio port. Backend is not open.");
+        if (sharedFallback != null) return sharedFallback.getCurrentAudioPort();
+        AudioPort nativePort = nGetCurrentAudioPort(outputContextPtr);
+        return nativePort != null ? nativePort : port;
+    }
+
+    @Override
+    public boolean isDirectBufferSupported() {
+        return true;
+    }
+
+    @Override
+    public boolean isLowLatencySupported() {
+        return true;
+    }
+
+    @Override
+    public void setLowLatency(boolean lowLatency) throws AudioBackendException {
+        if (isOpen()) throw new AudioBackendException("Cannot change low latency mode while the backend is open.");
+        this.lowLatency = lowLatency;
+    }
+
+    @Override
+    public int getPeriodFrames(AudioPort port, AudioFormat audioFormat) throws AudioBackendException {
+        if (sharedFallback != null) return sharedFallback.getPeriodFrames(port, audioFormat);
+        if (isOpen() && port == this.port) {
+            return nGetPeriodFrames(outputContextPtr);
+        }
+        return -1; // Known only once the driver has aligned the period
+    }
+
+    private synchronized native long nOpen(AudioPort port, AudioFormat audioFormat, int bufferSize, AtomicReference<AudioFormat> audioFormatRef, boolean lowLatency);
+    private synchronized native void nClose(long outputContextPtr);
+    private synchronized native void nStart(long outputContextPtr);
+    private synchronized native void nStop(long outputContextPtr);
+    private synchronized native void nFlush(long outputContextPtr);
+    private synchronized native void nDrain(long outputContextPtr);
+    private synchronized native int nWrite(long outputContextPtr, byte[] data, int offset, int length);
+    private synchronized native int nWriteDirect(long outputContextPtr, ByteBuffer buffer, int offset, int length);
+    private synchronized native int nAvailable(long outputContextPtr);
+    private synchronized native int nGetBufferSize(long outputContextPtr);
+    private synchronized native long nGetFramePosition(long outputContextPtr);
+    private synchronized native ByteBuffer nGetClockBuffer(long outputContextPtr);
+    private synchronized native ByteBuffer nGetTelemetryBuffer(long outputContextPtr);
+    private synchronized native boolean nUpdateClock(long outputContextPtr);
+    private synchronized native long nGetMicrosecondLatency(long outputContextPtr);
+    private synchronized native int nGetPeriodFrames(long outputContextPtr);
+    private synchronized native AudioPort nGetCurrentAudioPort(long outputContextPtr);
+}
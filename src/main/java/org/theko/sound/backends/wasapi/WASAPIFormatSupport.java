@@ -0,0 +1,131 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.theko.sound.backends.wasapi;
+
+import java.util.ArrayList;
+import java.util.List;
+import java.util.Optional;
+
+import org.theko.sound.AudioFormat;
+import org.theko.sound.AudioPort;
+
+/**
+ * Shared-mode support of a set of candidate formats on a WASAPI endpoint.
+ * <p>
+ * All candidates are tested natively with a single {@code IAudioClient}, and the results are cached
+ * per endpoint until it reports a change, so repeated negotiation does not activate the device again.
+ * For every unsupported candidate, the closest format suggested by the audio engine is kept, if any.
+ *
+ * @see WASAPISharedBackend#getFormatSupport(AudioPort, AudioFormat...)
+ *
+ * @since 0.3.1-beta
+ * @author Theko
+ */
+public final class WASAPIFormatSupport {
+
+    static final int UNSUPPORTED = 0;
+    static final int SUPPORTED = 1;
+    static final int CLOSEST = 2;
+
+    private final AudioPort port;
+    private final AudioFormat[] formats;
+    private final int[] results;
+    private final AudioFormat[] closestFormats;
+
+    WASAPIFormatSupport(AudioPort port, AudioFormat[] formats, int[] results, AudioFormat[] closestFormats) {
+        this.port = port;
+        this.formats = formats;
+        this.results = results;
+        this.closestFormats = closestFormats;
+    }
+
+    /**
+     * @return The audio port the formats were tested on
+     */
+    public AudioPort getPort() {
+        return port;
+    }
+
+    /**
+     * @return The number of candidate formats
+     */
+    public int size() {
+        return formats.length;
+    }
+
+    /**
+     * @param index The candidate index
+     * @return The candidate format
+     */
+    public AudioFormat getFormat(int index) {
+        return formats[index];
+    }
+
+    /**
+     * @param index The candidate index
+     * @return True if the candidate format is supported as is
+     */
+    public boolean isSupported(int index) {
+        return results[index] == SUPPORTED;
+    }
+
+    /**
+     * @param index The candidate index
+     * @return The closest supported format, if the candidate is not supported and the engine suggested one
+     */
+    public Optional<AudioFormat> getClosestFormat(int index) {
+        return results[index] == CLOSEST ? Optional.ofNullable(closestFormats[index]) : Optional.empty();
+    }
+
+    /**
+     * @return The supported candidates, in the order they were passed
+     */
+    public List<AudioFormat> getSupportedFormats() {
+        List<AudioFormat> supported = new ArrayList<>();
+        for (int i = 0; i < formats.length; i++) {
+            if (results[i] == SUPPORTED) supported.add(formats[i]);
+        }
+        return supported;
+    }
+
+    /**
+     * Returns the first supported candidate, or else the closest format suggested for the first
+     * candidate that has one.
+     *
+     * @return The best match, or empty if no candidate is usable
+     */
+    public Optional<AudioFormat> getBestMatch() {
+        for (int i = 0; i < formats.length; i++) {
+            if (results[i] == SUPPORTED) return Optional.of(formats[i]);
+        }
+        for (int i = 0; i < formats.length; i++) {
+            if (results[i] == CLOSEST && closestFormats[i] != null) return Optional.of(closestFormats[i]);
+        }
+        return Optional.empty();
+    }
+
+    @Override
+    public String toString() {
+        int supported = 0, closest = 0;
+        for (int result : results) {
+            if (result == SUPPORTED) supported++;
+            else if (result == CLOSEST) closest++;
+        }
+        return String.format("WASAPIFormatSupport{Port: %s, Candidates: %d, Supported: %d, With closest: %d}",
+            port.getName(), formats.length, supported, closest);
+    }
+}
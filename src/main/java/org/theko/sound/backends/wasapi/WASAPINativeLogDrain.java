@@ -0,0 +1,100 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.theko.sound.backends.wasapi;
+
+import static org.theko.sound.properties.AudioSystemProperties.BACKENDS_NATIVE_ASYNC_LOGGING;
+import static org.theko.sound.properties.AudioSystemProperties.BACKENDS_NATIVE_LOG_DRAIN_INTERVAL;
+
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+import org.theko.sound.properties.ThreadType;
+import org.theko.sound.util.ThreadUtilities;
+
+/**
+ * Delivers the log records of the WASAPI native library to SLF4J.
+ * <p>
+ * Native code formats enabled messages into a preallocated lock-free queue, so
+ * render threads never call into the JVM to log. This daemon thread drains the queue
+ * in batches and periodically refreshes the enabled levels cached by the native loggers.
+ * Disabled with {@code org.theko.sound.backends.nativeAsyncLogging=false}, in which
+ * case native code logs synchronously.
+ *
+ * @since 0.3.1-beta
+ * @author Theko
+ */
+final class WASAPINativeLogDrain {
+
+    private static final Logger logger = LoggerFactory.getLogger(WASAPINativeLogDrain.class);
+
+    private static final long LEVEL_REFRESH_INTERVAL_MS = 1000;
+
+    private static Thread drainThread;
+
+    private WASAPINativeLogDrain() {
+        throw new UnsupportedOperationException("This class cannot be instantiated.");
+    }
+
+    /**
+     * Switches the native library to asynchronous logging and starts the drain thread.
+     * Must be called after the native library is loaded. Does nothing if already started
+     * or if asynchronous native logging is disabled.
+     */
+    static synchronized void start() {
+        if (drainThread != null || !BACKENDS_NATIVE_ASYNC_LOGGING) return;
+        try {
+            nSetAsync(true);
+        } catch (UnsatisfiedLinkError ex) {
+            logger.warn("Native log queue is not available, native logging stays synchronous.", ex);
+            return;
+        }
+        drainThread = ThreadUtilities.startThread(
+            "WASAPI-NativeLogDrain", ThreadType.PLATFORM, Thread.MIN_PRIORITY, true, WASAPINativeLogDrain::run);
+    }
+
+    private static void run() {
+        long lastRefresh = System.currentTimeMillis();
+        try {
+            while (!Thread.currentThread().isInterrupted()) {
+                int drained = nDrain();
+
+                int dropped = nTakeDropped();
+                if (dropped > 0) {
+                    logger.warn("Native log queue overflow, {} records dropped.", dropped);
+                }
+
+                long now = System.currentTimeMillis();
+                if (now - lastRefresh >= LEVEL_REFRESH_INTERVAL_MS) {
+                    nRefreshLevels();
+                    lastRefresh = now;
+                }
+
+                if (drained == 0) {
+                    Thread.sleep(BACKENDS_NATIVE_LOG_DRAIN_INTERVAL);
+                }
+            }
+        } catch (InterruptedException ex) {
+            Thread.currentThread().interrupt();
+        } finally {
+            nSetAsync(false); // Delivers the rest and switches back to synchronous logging
+        }
+    }
+
+    private static native void nSetAsync(boolean enabled);
+    private static native int nDrain();
+    private static native int nTakeDropped();
+    private static native void nRefreshLevels();
+}
@@ -18,7 +18,6 @@ package org.theko.sound.backends.wasapi;
 
 import java.util.concurrent.atomic.AtomicReference;
 import java.io.File;
-import java.util.Arrays;
 import java.util.Collection;
 import java.util.List;
 import java.util.Optional;
@@ -36,6 +35,7 @@ import org.theko.sound.backends.AudioInputBackend;
 import org.theko.sound.backends.AudioOutputBackend;
 import org.theko.sound.backends.BackendNotOpenException;
 import org.theko.sound.util.FileUtilities;
+import org.theko.sound.util.NativeAudioKernels;
 import org.theko.sound.util.PlatformUtilities;
 import org.theko.sound.util.ResourceLoader;
 import org.theko.sound.util.ResourceNotFoundException;
@@ -51,9 +51,9 @@ import org.theko.sound.util.PlatformUtilities.Platform;
  * <p>
  * The backend loads the native WASAPI DLL on class initialization and manages the lifecycle of the native resources.
  * It supports querying all available audio ports, filtering by flow and format, and retrieving default ports.
- *
- * <p>
- * Note: Input backend functionality is not realized and will throw {@link UnsupportedOperationException}.
+ * Ports are kept in a native snapshot, updated from endpoint notifications, and cached here
+ * until the snapshot generation changes, so repeated lookups do not enumerate the devices again.
+ * Shared-mode format checks are cached per endpoint in the same way, see {@link #getFormatSupport(AudioPort, AudioFormat...)}.
  *
  * @author Theko
  * @since 0.2.3-beta
@@ -67,8 +67,8 @@ import org.theko.sound.util.PlatformUtilities.Platform;
                 description = "WASAPI backend in shared mode for Windows",
                 platforms = { Platform.WINDOWS },
                 priority = 10,
-                input = false, output = true)
-public sealed class WASAPISharedBackend implements AudioBackend permits WASAPISharedOutput, WASAPISharedInput {
+                input = true, output = true)
+public sealed class WASAPISharedBackend implements AudioBackend permits WASAPISharedOutput, WASAPISharedInput, WASAPIExclusiveBackend {
 
     private static final Logger logger = LoggerFactory.getLogger(WASAPISharedBackend.class);
 
@@ -78,6 +78,10 @@ public sealed class WASAPISharedBackend implements AudioBackend permits WASAPISh
 
     private static final boolean isSupported;
 
+    private static final Object portsCacheLock = new Object();
+    private static List<AudioPort> cachedPorts = null;
+    private static long cachedPortsGeneration = -1;
+
     static {
         lib64 = loadLibrary("native/WASApiShrd64.dll", "X64");
         lib32 = loadLibrary("native/WASApiShrd32.dll", "X32");
@@ -99,6 +103,8 @@ public sealed class WASAPISharedBackend implements AudioBackend permits WASAPISh
                 try {
                     System.load(libToLoad.getAbsolutePath());
                     logger.info("Loaded WASAPI library: {}", libToLoad.getName());
+                    WASAPINativeLogDrain.start();
+                    NativeAudioKernels.onLibraryLoaded();
                 } catch (UnsatisfiedLinkError e) {
                     logger.error("Failed to load WASAPI library: {}", libToLoad.getAbsolutePath(), e);
                     logger.warn("Library failed to load; API operations may be unstable. See stack trace for details: {}", e.getMessage());
@@ -165,18 +171,30 @@ public sealed class WASAPISharedBackend implements AudioBackend permits WASAPISh
 
     @Override
     public Collection<AudioPort> getAllPorts() throws BackendNotOpenException {
+        long generation = nGetPortsGeneration();
+        synchronized (portsCacheLock) {
+            if (generation != -1 && generation == cachedPortsGeneration) {
+                return cachedPorts;
+            }
+        }
+
         boolean initBefore = false;
         if (!isInitialized()) {
             initBefore = true;
             initialize();
         }
         try {
+            // Read before the ports, a change in between is picked up by the next call
+            generation = nGetPortsGeneration();
             AudioPort[] ports = nGetAllPorts(backendContextPtr);
-            if (ports == null || ports.length == 0) {
-                return List.of();
-            }
+            List<AudioPort> result = (ports == null || ports.length == 0) ? List.of() : List.of(ports);
 
-            return Arrays.asList(ports);
+            synchronized (portsCacheLock) {
+                cachedPorts = result;
+                cachedPortsGeneration = generation;
+            }
+            logger.debug("Port snapshot updated, generation: {}, ports: {}.", generation, result.size());
+            return result;
         } finally {
             if (initBefore) {
                 shutdown();
@@ -262,6 +280,105 @@ public sealed class WASAPISharedBackend implements AudioBackend permits WASAPISh
         return isFormatSupported(port, audioFormat, null);
     }
 
+    /**
+     * Tests the candidate formats on the port in shared mode, with a single native round-trip.
+     * Results are cached per endpoint until the device reports a change.
+     *
+     * @param port The audio port
+     * @param formats The candidate formats
+     * @return The support table of the candidates, in the order they were passed
+     * @throws BackendNotOpenException If the backend cannot be initialized
+     */
+    public WASAPIFormatSupport getFormatSupport(AudioPort port, AudioFormat... formats) throws BackendNotOpenException {
+        if (port == null || !isAudioPortSupported(port)) throw new IllegalArgumentException("Port is not supported.");
+        if (formats == null) throw new IllegalArgumentException("Formats are null.");
+
+        AudioFormat[] candidates = formats.clone();
+        AudioFormat[] closestFormats = new AudioFormat[candidates.length];
+        if (candidates.length == 0) {
+            return new WASAPIFormatSupport(port, candidates, new int[0], closestFormats);
+        }
+
+        boolean initBefore = false;
+        if (!isInitialized()) {
+            initBefore = true;
+            initialize();
+        }
+        try {
+            int[] results = nGetFormatSupport(port, candidates, closestFormats);
+            if (results == null || results.length != candidates.length) {
+                results = new int[candidates.length]; // All unsupported
+            }
+            WASAPIFormatSupport support = new WASAPIFormatSupport(port, candidates, results, closestFormats);
+            logger.trace("Format support: {}", support);
+            return support;
+        } finally {
+            if (initBefore) {
+                shutdown();
+            }
+        }
+    }
+
+    /**
+     * Tests every combination of the sample rates, bit depths and channel counts on the port in shared mode.
+     * 8-bit formats are unsigned PCM, the others signed little-endian PCM.
+     *
+     * @param port The audio port
+     * @param sampleRates The sample rates, in Hz
+     * @param bitDepths The bits per sample
+     * @param channels The channel counts
+     * @return The support table, ordered by sample rate, then bit depth, then channel count
+     * @throws BackendNotOpenException If the backend cannot be initialized
+     */
+    public WASAPIFormatSupport getFormatSupport(AudioPort port, int[] sampleRates, int[] bitDepths, int[] channels)
+        throws BackendNotOpenException {
+        if (sampleRates == null || bitDepths == null || channels == null) {
+            throw new IllegalArgumentException("Format grid is null.");
+        }
+
+        AudioFormat[] grid = new AudioFormat[sampleRates.length * bitDepths.length * channels.length];
+        int index = 0;
+        for (int sampleRate : sampleRates) {
+            for (int bits : bitDepths) {
+                AudioFormat.Encoding encoding = bits == 8 ? AudioFormat.Encoding.PCM_UNSIGNED : AudioFormat.Encoding.PCM_SIGNED;
+                for (int channelCount : channels) {
+                    grid[index++] = new AudioFormat(sampleRate, bits, channelCount, encoding, false);
+                }
+            }
+        }
+        return getFormatSupport(port, grid);
+    }
+
+    /**
+     * Queries the shared-mode engine periods of the port for the audio format.
+     * Requires {@code IAudioClient3}, available on Windows 10 and newer.
+     *
+     * @param port The audio port
+     * @param audioFormat The audio format of the stream
+     * @return The engine periods, or empty if they are not available
+     * @throws BackendNotOpenException If the backend cannot be initialized
+     */
+    public Optional<WASAPIEnginePeriods> getEnginePeriods(AudioPort port, AudioFormat audioFormat) throws BackendNotOpenException {
+        if (port == null || !isAudioPortSupported(port)) return Optional.empty();
+        if (audioFormat == null) return Optional.empty();
+
+        boolean initBefore = false;
+        if (!isInitialized()) {
+            initBefore = true;
+            initialize();
+        }
+        try {
+            int[] periods = nGetEnginePeriods(port, audioFormat);
+            if (periods == null || periods.length < 4) return Optional.empty();
+            return Optional.of(new WASAPIEnginePeriods(
+                periods[0], periods[1], periods[2], periods[3], audioFormat.getSampleRate()));
+        } finally {
+            if (initBefore) {
+                shutdown();
+            }
+        }
+    }
+
     @Override
     public AudioInputBackend getInputBackend() {
         return new WASAPISharedInput();
@@ -285,5 +402,8 @@ public sealed class WASAPISharedBackend implements AudioBackend permits WASAPISh
     private synchronized native void nShutdown(long backendContextPtr);
     private synchronized native AudioPort[] nGetAllPorts(long backendContextPtr);
     private synchronized native AudioPort nGetDefaultPort(long backendContextPtr, AudioFlow flow);
+    private static native long nGetPortsGeneration();
     private synchronized native boolean nIsFormatSupported(AudioPort port, AudioFormat audioFormat, AtomicReference<AudioFormat> closestFormat);
+    private synchronized native int[] nGetFormatSupport(AudioPort port, AudioFormat[] formats, AudioFormat[] closestFormats);
+    private synchronized native int[] nGetEnginePeriods(AudioPort port, AudioFormat audioFormat);
 }
@@ -16,6 +16,10 @@
 
 package org.theko.sound.backends.wasapi;
 
+import java.nio.ByteBuffer;
+import java.util.Optional;
+import java.util.concurrent.atomic.AtomicReference;
+
 import org.slf4j.Logger;
 import org.slf4j.LoggerFactory;
 import org.theko.sound.AudioFlow;
@@ -25,10 +29,23 @@ import org.theko.sound.AudioUnitsConverter;
 import org.theko.sound.backends.AudioBackendException;
 import org.theko.sound.backends.AudioInputBackend;
 import org.theko.sound.backends.BackendNotOpenException;
+import org.theko.sound.backends.BackendTelemetry;
 
 /**
  * {@code WASAPISharedInput} is an implementation of the {@link AudioInputBackend} interface
  * that provides audio input backend functionality using the Windows Audio Session API (WASAPI) in shared mode.
+ * <p>
+ * Capture is event-driven: a native thread, registered with MMCSS ("Pro Audio"), drains the
+ * {@code IAudioCaptureClient} packets every device period into a lock-free ring buffer.
+ * {@link #read(byte[], int, int)} copies from the ring buffer and waits on the capture event
+ * while it is empty, {@link #read(ByteBuffer)} with a direct buffer returns what is already
+ * captured without blocking. {@link #available()} and {@link #getBufferSize()} report the
+ * captured bytes and the capacity of the ring buffer.
+ * <p>
+ * Packets flagged as discontinuous by the audio engine and frames dropped because the ring
+ * buffer was full are counted, see {@link #getDiscontinuityCount()} and {@link #getDroppedFrames()}.
+ * With {@link #setLowLatency(boolean)}, the stream is opened through {@code IAudioClient3} with the
+ * smallest engine period of the endpoint, falling back to the default period where it is not available.
  *
  * @see WASAPISharedBackend
  *
@@ -45,7 +62,11 @@ public final class WASAPISharedInput extends WASAPISharedBackend implements Audi
     private boolean isStarted = false;
     private int bufferSize = -1;
     private AudioFormat audioFormat = null;
+    private AudioFormat deviceFormat = null; // Format negotiated by nOpen
     private AudioPort port = null;
+    private boolean lowLatency = false;
+    private WASAPITelemetryReader telemetry = null; // Over the native stream telemetry, valid until nClose
+    private final Object nativeReadLock = new Object(); // Held by readers, and by close() around nClose
 
     @Override
     public synchronized AudioFormat open(AudioPort port, AudioFormat audioFormat, int bufferSize) throws AudioBackendException {
@@ -66,14 +87,20 @@ public final class WASAPISharedInput extends WASAPISharedBackend implements Audi
             initialize();
         }
         logger.debug("Opening input port: {}, audio format: {}, buffer size: {}", port, audioFormat, bufferSize);
-        AudioFormat result = nOpen(port, audioFormat, bufferSize);
+        AtomicReference<AudioFormat> openedFormat = new AtomicReference<>();
+        this.inputContextPtr = nOpen(port, audioFormat, bufferSize, openedFormat, lowLatency);
+        if (this.inputContextPtr == 0) throw new AudioBackendException("Failed to open input.");
+
+        ByteBuffer telemetryBuffer = nGetTelemetryBuffer(inputContextPtr);
+        this.telemetry = telemetryBuffer != null ? new WASAPITelemetryReader(telemetryBuffer) : null;
 
         this.bufferSize = bufferSize;
         this.audioFormat = audioFormat;
+        this.deviceFormat = openedFormat.get();
         this.port = port;
         isOpen = true;
 
-        return result;
+        return openedFormat.get();
     }
 
     @Override
@@ -103,12 +130,22 @@ public final class WASAPISharedInput extends WASAPISharedBackend implements Audi
             return;
         }
         if (isStarted) stop();
-        if (isOpen || inputContextPtr != 0) nClose();
+        long discontinuities = nGetDiscontinuityCount(inputContextPtr);
+        long droppedFrames = nGetDroppedFrames(inputContextPtr);
+        if (discontinuities > 0 || droppedFrames > 0) {
+            logger.info("Capture glitches: {} discontinuities, {} dropped frames.", discontinuities, droppedFrames);
+        }
+        synchronized (nativeReadLock) {
+            // No reader is inside the native telemetry once nClose frees it
+            telemetry = null;
+            if (isOpen || inputContextPtr != 0) nClose(inputContextPtr);
+        }
         if (super.isInitialized()) super.shutdown();
         isOpen = false;
         isStarted = false;
         bufferSize = -1;
         audioFormat = null;
+        deviceFormat = null;
         port = null;
         inputContextPtr = 0;
         logger.debug("Closed.");
@@ -118,7 +155,7 @@ public final class WASAPISharedInput extends WASAPISharedBackend implements Audi
     public void start() throws AudioBackendException, BackendNotOpenException {
         if (!isOpen()) throw new BackendNotOpenException("Cannot start. Backend is not open.");
         if (isStarted) return;
-        nStart();
+        nStart(inputContextPtr);
         isStarted = true;
     }
 
@@ -126,39 +163,55 @@ public final class WASAPISharedInput extends WASAPISharedBackend implements Audi
     public void stop() throws AudioBackendException, BackendNotOpenException {
         if (!isOpen()) throw new BackendNotOpenException("Cannot stop. Backend is not open.");
         if (!isStarted) return;
-        nStop();
+        nStop(inputContextPtr);
         isStarted = false;
     }
 
     @Override
     public void flush() throws AudioBackendException, BackendNotOpenException {
         if (!isOpen()) throw new BackendNotOpenException("Cannot flush. Backend is not open.");
-        nFlush();
+        nFlush(inputContextPtr);
     }
 
     @Override
     public void drain() throws AudioBackendException, BackendNotOpenException {
         if (!isOpen()) throw new BackendNotOpenException("Cannot drain. Backend is not open.");
-        nDrain();
+        nDrain(inputContextPtr);
     }
 
     @Override
     public int read(byte[] data, int offset, int length) throws AudioBackendException, BackendNotOpenException {
         if (!isOpen()) throw new BackendNotOpenException("Cannot read. Backend is not open.");
-        //return nRead(data, offset, length);
+        int waitMs = getWaitTimeout();
+        // The native side reads whole frames only, a partial frame could never be filled
+        int frameSize = deviceFormat.getFrameSize();
+        length -= length % frameSize;
         int totalRead = 0;
         while (totalRead < length) {
-            int read = nRead(data, offset + totalRead, length - totalRead);
+            int read = nRead(inputContextPtr, data, offset + totalRead, length - totalRead);
             if (read == -1) break;
             totalRead += read;
+            if (read == 0 && !nWaitForData(inputContextPtr, waitMs) && !isStarted()) break;
         }
         return totalRead;
     }
 
+    @Override
+    public int read(ByteBuffer buffer) throws AudioBackendException, BackendNotOpenException {
+        if (!isOpen()) throw new BackendNotOpenException("Cannot read. Backend is not open.");
+        if (!buffer.isDirect()) return AudioInputBackend.super.read(buffer);
+
+        int read = nReadDirect(inputContextPtr, buffer, buffer.position(), buffer.remaining());
+        if (read > 0) {
+            buffer.position(buffer.position() + read);
+        }
+        return Math.max(read, 0);
+    }
+
     @Override
     public int available() throws AudioBackendException, BackendNotOpenException {
         if (!isOpen()) throw new BackendNotOpenException("Cannot get available. Backend is not open.");
-        return nAvailable();
+        return nAvailable(inputContextPtr);
     }
 
     @Override
@@ -166,7 +219,7 @@ public final class WASAPISharedInput extends WASAPISharedBackend implements Audi
         if (!isOpen()) throw new BackendNotOpenException("Cannot get buffer size. Backend is not open.");
         int bufferSize = this.bufferSize;
         try {
-            int nativeBufferSize = nGetBufferSize();
+            int nativeBufferSize = nGetBufferSize(inputContextPtr);
             if (nativeBufferSize == -1) {
                 return bufferSize;
             }
@@ -180,13 +233,13 @@ public final class WASAPISharedInput extends WASAPISharedBackend implements Audi
     @Override
     public long getFramePosition() throws AudioBackendException, BackendNotOpenException {
         if (!isOpen()) throw new BackendNotOpenException("Cannot get frame position. Backend is not open.");
-        return nGetFramePosition();
+        return nGetFramePosition(inputContextPtr);
     }
 
     @Override
     public long getMicrosecondPosition() throws AudioBackendException, BackendNotOpenException {
         if (!isOpen()) throw new BackendNotOpenException("Cannot get microsecond position. Backend is not open.");
-        return AudioUnitsConverter.framesToMicroseconds(getFramePosition(), audioFormat.getSampleRate());
+        return AudioUnitsConverter.framesToMicroseconds(getFramePosition(), deviceFormat.getSampleRate());
     }
 
     @Override
@@ -194,7 +247,7 @@ public final class WASAPISharedInput extends WASAPISharedBackend implements Audi
         if (!isOpen()) throw new BackendNotOpenException("Cannot get latency. Backend is not open.");
         long latency = (long) ((bufferSize / (float) audioFormat.getSampleRate()) * 1000000);
         try {
-            long nativeLatency = nGetMicrosecondLatency();
+            long nativeLatency = nGetMicrosecondLatency(inputContextPtr);
             if (nativeLatency == -1) {
                 return latency;
             }
@@ -210,7 +263,7 @@ public final class WASAPISharedInput extends WASAPISharedBackend implements Audi
         if (!isOpen()) throw new BackendNotOpenException("Cannot get current audio port. Backend is not open.");
         AudioPort port = this.port;
         try {
-            AudioPort nativePort = nGetCurrentAudioPort();
+            AudioPort nativePort = nGetCurrentAudioPort(inputContextPtr);
             if (nativePort == null) {
                 return port;
             }
@@ -221,16 +274,93 @@ public final class WASAPISharedInput extends WASAPISharedBackend implements Audi
         }
     }
 
-    private synchronized native AudioFormat nOpen(AudioPort port, AudioFormat audioFormat, int bufferSize);
-    private synchronized native void nClose();
-    private synchronized native void nStart();
-    private synchronized native void nStop();
-    private synchronized native void nFlush();
-    private synchronized native void nDrain();
-    private synchronized native int nRead(byte[] data, int offset, int length);
-    private synchronized native int nAvailable();
-    private synchronized native int nGetBufferSize();
-    private synchronized native long nGetFramePosition();
-    private synchronized native long nGetMicrosecondLatency();
-    private synchronized native AudioPort nGetCurrentAudioPort();
+    /**
+     * Returns the number of captured packets flagged by the audio engine as
+     * discontinuous ({@code AUDCLNT_BUFFERFLAGS_DATA_DISCONTINUITY}), usually due to a glitch.
+     *
+     * @return The number of discontinuities since the backend was opened
+     * @throws BackendNotOpenException If the backend is not open
+     */
+    public long getDiscontinuityCount() throws AudioBackendException, BackendNotOpenException {
+        if (!isOpen()) throw new BackendNotOpenException("Cannot get discontinuity count. Backend is not open.");
+        return nGetDiscontinuityCount(inputContextPtr);
+    }
+
+    /**
+     * Returns the number of captured frames dropped because the ring buffer was full,
+     * that is, because the data was not read fast enough.
+     *
+     * @return The number of dropped frames since the backend was opened
+     * @throws BackendNotOpenException If the backend is not open
+     */
+    public long getDroppedFrames() throws AudioBackendException, BackendNotOpenException {
+        if (!isOpen()) throw new BackendNotOpenException("Cannot get dropped frames. Backend is not open.");
+        return nGetDroppedFrames(inputContextPtr);
+    }
+
+    @Override
+    public Optional<BackendTelemetry> getTelemetry() throws AudioBackendException, BackendNotOpenException {
+        if (!isOpen()) throw new BackendNotOpenException("Cannot get telemetry. Backend is not open.");
+        synchronized (nativeReadLock) {
+            WASAPITelemetryReader telemetry = this.telemetry;
+            return telemetry != null ? Optional.of(telemetry.read()) : Optional.empty();
+        }
+    }
+
+    /**
+     * Enables the low-latency shared mode of {@code IAudioClient3} for the next {@link #open} call.
+     *
+     * @param lowLatency True to use the smallest engine period of the endpoint
+     * @throws AudioBackendException If the backend is open
+     */
+    public void setLowLatency(boolean lowLatency) throws AudioBackendException {
+        if (isOpen()) throw new AudioBackendException("Cannot change low latency mode while the backend is open.");
+        this.lowLatency = lowLatency;
+    }
+
+    /**
+     * Returns the engine period of the opened stream, or the period the stream would use
+     * for the given port and format.
+     *
+     * @param port The audio port, or null for the default input port
+     * @param audioFormat The audio format
+     * @return The period in frames, or -1 if unknown
+     * @throws AudioBackendException If an error occurs during the operation
+     */
+    public int getPeriodFrames(AudioPort port, AudioFormat audioFormat) throws AudioBackendException {
+        if (isOpen() && port == this.port && audioFormat == this.audioFormat) {
+            return nGetPeriodFrames(inputContextPtr);
+        }
+        if (port == null) {
+            port = super.getDefaultPort(AudioFlow.IN).orElse(null);
+        }
+        return getEnginePeriods(port, audioFormat)
+                .map(periods -> lowLatency ? periods.getMinFrames() : periods.getDefaultFrames())
+                .orElse(-1);
+    }
+
+    private int getWaitTimeout() {
+        int periodFrames = nGetPeriodFrames(inputContextPtr);
+        if (periodFrames <= 0) return 10;
+        return Math.max(1, (int) (periodFrames * 1000L / deviceFormat.getSampleRate()));
+    }
+
+    private synchronized native long nOpen(AudioPort port, AudioFormat audioFormat, int bufferSize, AtomicReference<AudioFormat> audioFormatRef, boolean lowLatency);
+    private synchronized native void nClose(long inputContextPtr);
+    private synchronized native void nStart(long inputContextPtr);
+    private synchronized native void nStop(long inputContextPtr);
+    private synchronized native void nFlush(long inputContextPtr);
+    private synchronized native void nDrain(long inputContextPtr);
+    private synchronized native int nRead(long inputContextPtr, byte[] data, int offset, int length);
+    private synchronized native int nReadDirect(long inputContextPtr, ByteBuffer buffer, int offset, int length);
+    private native boolean nWaitForData(long inputContextPtr, int timeoutMs);
+    private synchronized native int nAvailable(long inputContextPtr);
+    private synchronized native int nGetBufferSize(long inputContextPtr);
+    private synchronized native long nGetFramePosition(long inputContextPtr);
+    private synchronized native long nGetMicrosecondLatency(long inputContextPtr);
+    private synchronized native int nGetPeriodFrames(long inputContextPtr);
+    private synchronized native long nGetDiscontinuityCount(long inputContextPtr);
+    private synchronized native long nGetDroppedFrames(long inputContextPtr);
+    private synchronized native ByteBuffer nGetTelemetryBuffer(long inputContextPtr);
+    private synchronized native AudioPort nGetCurrentAudioPort(long inputContextPtr);
 }
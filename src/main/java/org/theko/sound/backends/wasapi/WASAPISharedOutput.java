@@ -16,6 +16,8 @@
 
 package org.theko.sound.backends.wasapi;
 
+import java.nio.ByteBuffer;
+import java.util.Optional;
 import java.util.concurrent.atomic.AtomicReference;
 
 import org.slf4j.Logger;
@@ -27,11 +29,41 @@ import org.theko.sound.AudioUnitsConverter;
 import org.theko.sound.UnsupportedAudioFormatException;
 import org.theko.sound.backends.AudioBackendException;
 import org.theko.sound.backends.AudioOutputBackend;
+import org.theko.sound.backends.AudioRenderCallback;
+import org.theko.sound.backends.AudioTimestamp;
 import org.theko.sound.backends.BackendNotOpenException;
+import org.theko.sound.backends.BackendTelemetry;
 
 /**
  * {@code WASAPISharedOutput} is an implementation of the {@link AudioOutputBackend} interface
  * that provides audio output backend functionality using the Windows Audio Session API (WASAPI) in shared mode.
+ * <p>
+ * In push mode, {@link #write} is non-blocking: data is copied into a native
+ * single-producer/single-consumer ring buffer, which an event-driven render thread drains
+ * into the device. {@link #write} returns the number of bytes that fit (possibly {@code 0}),
+ * and {@link #available()} and {@link #getBufferSize()} report the free space and the capacity
+ * of the ring buffer, in bytes. Direct buffers passed to {@link #write(ByteBuffer)} are copied
+ * into the ring buffer without going through the Java heap.
+ * {@link #writeFloat(float[][], int, int)} converts planar floats to the device format
+ * (16/24/32-bit PCM or 32-bit float) natively with SIMD kernels, straight into the ring buffer.
+ * <p>
+ * Supports pull mode: when a {@link AudioRenderCallback} is set before {@link #start()},
+ * the native layer runs its own event-driven render thread, registered with MMCSS ("Pro Audio"),
+ * and requests audio data from the callback every device period instead of accepting {@link #write} calls.
+ * <p>
+ * With {@link #setLowLatency(boolean)}, the stream is opened through {@code IAudioClient3} with the
+ * smallest engine period of the endpoint (Windows 10 and newer), falling back to the default period
+ * where it is not available.
+ * <p>
+ * With {@link #setSharedSession(boolean)}, all outputs opened on the same endpoint share one
+ * {@code IAudioClient} in the endpoint mix format (32-bit float): a single native render thread
+ * sums their ring buffers with SIMD kernels once per engine period. Streams in a session use
+ * push mode and the default engine period, and do not publish a stream clock.
+ * <p>
+ * With {@link #setEngineConversion(boolean)}, a format the endpoint does not support is opened
+ * as is, with {@code AUDCLNT_STREAMFLAGS_AUTOCONVERTPCM}: the audio engine resamples and remixes it
+ * to the mix format. Where the flag is rejected, the closest supported format is opened instead.
+ * Engine conversion uses the default engine period.
  *
  * @see WASAPISharedBackend
  *
@@ -48,7 +80,15 @@ public final class WASAPISharedOutput extends WASAPISharedBackend implements Aud
     private boolean isStarted = false;
     private int bufferSize = -1;
     private AudioFormat audioFormat = null;
+    private AudioFormat deviceFormat = null; // Format negotiated by nOpen
     private AudioPort port = null;
+    private AudioRenderCallback renderCallback = null;
+    private boolean lowLatency = false;
+    private boolean sharedSession = false;
+    private boolean engineConversion = false;
+    private WASAPIClockReader clock = null; // Over the native clock snapshot, valid until nClose
+    private final Object nativeReadLock = new Object(); // Held by readers, and by close() around nClose
+    private WASAPITelemetryReader telemetry = null; // Over the native stream telemetry, valid until nClose
 
     @Override
     public synchronized AudioFormat open(AudioPort port, AudioFormat audioFormat, int bufferSize)
@@ -71,11 +111,17 @@ public final class WASAPISharedOutput extends WASAPISharedBackend implements Aud
         }
         AtomicReference<AudioFormat> openedFormat = new AtomicReference<>();
         logger.debug("Opening output, port: {}, audio format: {}, buffer size: {}", port, audioFormat, bufferSize);
-        this.outputContextPtr = nOpen(port, audioFormat, bufferSize, openedFormat);
+        this.outputContextPtr = nOpen(port, audioFormat, bufferSize, openedFormat, lowLatency, sharedSession, engineConversion);
         if (this.outputContextPtr == 0) throw new AudioBackendException("Failed to open output.");
 
+        ByteBuffer clockBuffer = nGetClockBuffer(outputContextPtr);
+        this.clock = clockBuffer != null ? new WASAPIClockReader(clockBuffer) : null;
+        ByteBuffer telemetryBuffer = nGetTelemetryBuffer(outputContextPtr);
+        this.telemetry = telemetryBuffer != null ? new WASAPITelemetryReader(telemetryBuffer) : null;
+
         this.bufferSize = bufferSize;
         this.audioFormat = audioFormat;
+        this.deviceFormat = openedFormat.get();
         this.port = port;
         isOpen = true;
 
@@ -110,13 +156,20 @@ public final class WASAPISharedOutput extends WASAPISharedBackend implements Aud
             return;
         }
         if (isStarted) stop();
-        if (isOpen || outputContextPtr != 0) nClose(outputContextPtr);
+        synchronized (nativeReadLock) {
+            // No reader is inside the native blocks once nClose frees them
+            clock = null;
+            telemetry = null;
+            if (isOpen || outputContextPtr != 0) nClose(outputContextPtr);
+        }
         if (super.isInitialized()) super.shutdown();
         isOpen = false;
         isStarted = false;
         bufferSize = -1;
         audioFormat = null;
+        deviceFormat = null;
         port = null;
+        renderCallback = null;
         outputContextPtr = 0;
         logger.debug("Closed.");
     }
@@ -125,7 +178,7 @@ public final class WASAPISharedOutput extends WASAPISharedBackend implements Aud
     public void start() throws AudioBackendException, BackendNotOpenException {
         if (!isOpen()) throw new BackendNotOpenException("Cannot start. Backend is not open.");
         if (isStarted) return;
-        nStart(outputContextPtr);
+        nStart(outputContextPtr, renderCallback);
         isStarted = true;
     }
 
@@ -152,9 +205,45 @@ public final class WASAPISharedOutput extends WASAPISharedBackend implements Aud
     @Override
     public int write(byte[] data, int offset, int length) throws AudioBackendException, BackendNotOpenException {
         if (!isOpen()) throw new BackendNotOpenException("Cannot write. Backend is not open.");
+        if (renderCallback != null) throw new AudioBackendException("Cannot write. Backend is in pull mode.");
         return nWrite(outputContextPtr, data, offset, length);
     }
 
+    @Override
+    public int write(ByteBuffer buffer) throws AudioBackendException, BackendNotOpenException {
+        if (!isOpen()) throw new BackendNotOpenException("Cannot write. Backend is not open.");
+        if (renderCallback != null) throw new AudioBackendException("Cannot write. Backend is in pull mode.");
+        if (!buffer.isDirect()) return AudioOutputBackend.super.write(buffer);
+
+        int written = nWriteDirect(outputContextPtr, buffer, buffer.position(), buffer.remaining());
+        if (written > 0) {
+            buffer.position(buffer.position() + written);
+        }
+        return written;
+    }
+
+    @Override
+    public int writeFloat(float[][] samples, int offset, int frames) throws AudioBackendException, BackendNotOpenException {
+        if (!isOpen()) throw new BackendNotOpenException("Cannot write. Backend is not open.");
+        if (renderCallback != null) throw new AudioBackendException("Cannot write. Backend is in pull mode.");
+        return nWriteFloat(outputContextPtr, samples, offset, frames);
+    }
+
+    @Override
+    public boolean isFloatWriteSupported() {
+        AudioFormat format = deviceFormat;
+        if (format == null || !isOpen()) return false;
+        switch (format.getEncoding()) {
+            case PCM_FLOAT:
+                return format.getBytesPerSample() == 4;
+            case PCM_SIGNED:
+                int bytes = format.getBytesPerSample();
+                return bytes == 2 || bytes == 3 || bytes == 4;
+            default:
+                return false;
+        }
+    }
+
     @Override
     public int available() throws AudioBackendException, BackendNotOpenException {
         if (!isOpen()) throw new BackendNotOpenException("Cannot get available. Backend is not open.");
@@ -183,6 +272,27 @@ public final class WASAPISharedOutput extends WASAPISharedBackend implements Aud
         return nGetFramePosition(outputContextPtr);
     }
 
+    @Override
+    public Optional<AudioTimestamp> getTimestamp() throws AudioBackendException, BackendNotOpenException {
+        if (!isOpen()) throw new BackendNotOpenException("Cannot get timestamp. Backend is not open.");
+        synchronized (nativeReadLock) {
+            WASAPIClockReader clock = this.clock;
+            if (clock == null) return Optional.empty();
+            // Published every period while started, refreshed on demand otherwise
+            if (!isStarted && !nUpdateClock(outputContextPtr)) return Optional.empty();
+            return Optional.ofNullable(clock.read());
+        }
+    }
+
+    @Override
+    public Optional<BackendTelemetry> getTelemetry() throws AudioBackendException, BackendNotOpenException {
+        if (!isOpen()) throw new BackendNotOpenException("Cannot get telemetry. Backend is not open.");
+        synchronized (nativeReadLock) {
+            WASAPITelemetryReader telemetry = this.telemetry;
+            return telemetry != null ? Optional.of(telemetry.read()) : Optional.empty();
+        }
+    }
+
     @Override
     public long getMicrosecondPosition() throws AudioBackendException, BackendNotOpenException {
         if (!isOpen()) throw new BackendNotOpenException("Cannot get microsecond position. Backend is not open.");
@@ -221,16 +331,87 @@ public final class WASAPISharedOutput extends WASAPISharedBackend implements Aud
         }
     }
 
-    private synchronized native long nOpen(AudioPort port, AudioFormat audioFormat, int bufferSize, AtomicReference<AudioFormat> audioFormatRef);
+    @Override
+    public boolean isDirectBufferSupported() {
+        return true;
+    }
+
+    @Override
+    public boolean isPullModeSupported() {
+        return true;
+    }
+
+    @Override
+    public void setRenderCallback(AudioRenderCallback callback) throws AudioBackendException {
+        if (isStarted()) throw new AudioBackendException("Cannot set render callback while the backend is started.");
+        if (callback != null && sharedSession) throw new AudioBackendException("Pull mode is not available in a shared session.");
+        this.renderCallback = callback;
+        logger.debug("Render callback {}.", callback != null ? "set, pull mode enabled" : "removed, push mode enabled");
+    }
+
+    @Override
+    public boolean isLowLatencySupported() {
+        return true;
+    }
+
+    @Override
+    public void setLowLatency(boolean lowLatency) throws AudioBackendException {
+        if (isOpen()) throw new AudioBackendException("Cannot change low latency mode while the backend is open.");
+        this.lowLatency = lowLatency;
+    }
+
+    @Override
+    public boolean isSharedSessionSupported() {
+        return true;
+    }
+
+    @Override
+    public void setSharedSession(boolean sharedSession) throws AudioBackendException {
+        if (isOpen()) throw new AudioBackendException("Cannot change shared session mode while the backend is open.");
+        if (sharedSession && renderCallback != null) throw new AudioBackendException("Pull mode is not available in a shared session.");
+        this.sharedSession = sharedSession;
+    }
+
+    @Override
+    public boolean isEngineConversionSupported() {
+        return true;
+    }
+
+    @Override
+    public void setEngineConversion(boolean engineConversion) throws AudioBackendException {
+        if (isOpen()) throw new AudioBackendException("Cannot change engine conversion mode while the backend is open.");
+        this.engineConversion = engineConversion;
+    }
+
+    @Override
+    public int getPeriodFrames(AudioPort port, AudioFormat audioFormat) throws AudioBackendException {
+        if (isOpen() && port == this.port && audioFormat == this.audioFormat) {
+            return nGetPeriodFrames(outputContextPtr);
+        }
+        if (port == null) {
+            port = super.getDefaultPort(AudioFlow.OUT).orElse(null);
+        }
+        return getEnginePeriods(port, audioFormat)
+                .map(periods -> lowLatency ? periods.getMinFrames() : periods.getDefaultFrames())
+                .orElse(-1);
+    }
+
+    private synchronized native long nOpen(AudioPort port, AudioFormat audioFormat, int bufferSize, AtomicReference<AudioFormat> audioFormatRef, boolean lowLatency, boolean sharedSession, boolean engineConversion);
     private synchronized native void nClose(long outputContextPtr);
-    private synchronized native void nStart(long outputContextPtr);
+    private synchronized native void nStart(long outputContextPtr, AudioRenderCallback renderCallback);
     private synchronized native void nStop(long outputContextPtr);
     private synchronized native void nFlush(long outputContextPtr);
     private synchronized native void nDrain(long outputContextPtr);
     private synchronized native int nWrite(long outputContextPtr, byte[] data, int offset, int length);
+    private synchronized native int nWriteDirect(long outputContextPtr, ByteBuffer buffer, int offset, int length);
+    private synchronized native int nWriteFloat(long outputContextPtr, float[][] samples, int offset, int frames);
     private synchronized native int nAvailable(long outputContextPtr);
     private synchronized native int nGetBufferSize(long outputContextPtr);
     private synchronized native long nGetFramePosition(long outputContextPtr);
+    private synchronized native ByteBuffer nGetClockBuffer(long outputContextPtr);
+    private synchronized native ByteBuffer nGetTelemetryBuffer(long outputContextPtr);
+    private synchronized native boolean nUpdateClock(long outputContextPtr);
     private synchronized native long nGetMicrosecondLatency(long outputContextPtr);
+    private synchronized native int nGetPeriodFrames(long outputContextPtr);
     private synchronized native AudioPort nGetCurrentAudioPort(long outputContextPtr);
 }
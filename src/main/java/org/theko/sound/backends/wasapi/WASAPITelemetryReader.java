@@ -0,0 +1,92 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.theko.sound.backends.wasapi;
+
+import java.lang.invoke.MethodHandles;
+import java.lang.invoke.VarHandle;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+
+import org.theko.sound.backends.BackendTelemetry;
+import org.theko.sound.util.Histogram;
+
+/**
+ * Reads the telemetry that the native stream thread records, straight from native memory
+ * and without a JNI call.
+ * <p>
+ * The telemetry is an array of little-endian 64-bit fields (see {@code stream_telemetry.hpp}),
+ * each with a single writer that only increases it, so fields are read one by one without a sequence.
+ *
+ * @since 0.3.1-beta
+ * @author Theko
+ */
+final class WASAPITelemetryReader {
+
+    private static final VarHandle LONGS = MethodHandles.byteBufferViewVarHandle(long[].class, ByteOrder.LITTLE_ENDIAN);
+
+    private static final int PERIODS = 0;
+    private static final int GLITCHES = 8;
+    private static final int SILENT_BUFFERS = 16;
+    private static final int WAKE_TIMEOUTS = 24;
+    private static final int DEVICE_INVALIDATIONS = 32;
+    private static final int MAX_WAKE_JITTER = 40;
+    private static final int MAX_BUFFER_TIME = 48;
+    private static final int BUFFER_FRAMES = 56;
+    private static final int PERIOD_TIME = 64;
+    private static final int WAKE_JITTER_HISTOGRAM = 72;
+    private static final int BUCKETS = Histogram.TIME_BUCKETS;
+    private static final int PADDING_HISTOGRAM = WAKE_JITTER_HISTOGRAM + BUCKETS * 8;
+    private static final int BUFFER_TIME_HISTOGRAM = PADDING_HISTOGRAM + BUCKETS * 8;
+    private static final int SIZE = BUFFER_TIME_HISTOGRAM + BUCKETS * 8;
+
+    private final ByteBuffer buffer;
+
+    /**
+     * @param buffer The direct buffer over the native telemetry, valid until the stream is closed
+     */
+    WASAPITelemetryReader(ByteBuffer buffer) {
+        if (buffer == null || !buffer.isDirect() || buffer.capacity() < SIZE) {
+            throw new IllegalArgumentException("Invalid telemetry buffer.");
+        }
+        this.buffer = buffer;
+    }
+
+    /**
+     * @return The current values
+     */
+    BackendTelemetry read() {
+        return new BackendTelemetry(
+            field(PERIODS), field(GLITCHES), field(SILENT_BUFFERS), field(WAKE_TIMEOUTS),
+            field(DEVICE_INVALIDATIONS), field(MAX_WAKE_JITTER), field(MAX_BUFFER_TIME),
+            (int) field(BUFFER_FRAMES), field(PERIOD_TIME),
+            Histogram.ofTimes(buckets(WAKE_JITTER_HISTOGRAM)),
+            Histogram.ofLinear(buckets(PADDING_HISTOGRAM), field(BUFFER_FRAMES)),
+            Histogram.ofTimes(buckets(BUFFER_TIME_HISTOGRAM)));
+    }
+
+    private long field(int offset) {
+        return (long) LONGS.getOpaque(buffer, offset);
+    }
+
+    private long[] buckets(int offset) {
+        long[] counts = new long[BUCKETS];
+        for (int i = 0; i < BUCKETS; i++) {
+            counts[i] = field(offset + i * 8);
+        }
+        return counts;
+    }
+}
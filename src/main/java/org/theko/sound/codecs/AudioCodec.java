@@ -17,6 +17,7 @@
 package org.theko.sound.codecs;
 
 import java.io.InputStream;
+import java.nio.file.Path;
 import java.util.List;
 
 import org.theko.sound.AudioFormat;
@@ -55,6 +56,32 @@ public abstract class AudioCodec {
      */
     public abstract AudioDecodeResult decode(InputStream is) throws AudioCodecException;
 
+    /**
+     * Opens a file for decoding on demand, see {@link AudioDecodeStream}.
+     * Only codecs that return true from {@link #isStreamingSupported()} implement it.
+     *
+     * @param file the audio file to open
+     * @return the opened stream, to be closed by the caller
+     * @throws AudioCodecException if the file is not a valid audio file for this codec,
+     * or the codec does not support streaming
+     *
+     * @since 0.3.1-beta
+     */
+    public AudioDecodeStream openStream(Path file) throws AudioCodecException {
+        throw new AudioCodecException("Codec " + getInfo().getName() + " does not support streaming decode.");
+    }
+
+    /**
+     * Checks if the codec can decode files on demand with {@link #openStream(Path)}.
+     *
+     * @return true if streaming decode is supported, false otherwise
+     *
+     * @since 0.3.1-beta
+     */
+    public boolean isStreamingSupported() {
+        return false;
+    }
+
     /**
      * Calls the encode method.
      *
@@ -0,0 +1,338 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.theko.sound.codecs;
+
+import static org.theko.sound.properties.AudioSystemProperties.CODECS_CACHE_SIZE;
+
+import java.io.File;
+import java.io.IOException;
+import java.util.HashMap;
+import java.util.Iterator;
+import java.util.LinkedHashMap;
+import java.util.Map;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.CompletionException;
+
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+/**
+ * Process-wide cache of decoded audio files.
+ * <p>
+ * Sound sources that open the same file share one decoded copy of its samples instead of
+ * decoding it again. Entries are keyed by the canonical path, size and modification time
+ * of the file, so a changed file is decoded again and its stale entry is dropped.
+ * The least recently used entries are evicted once the decoded samples exceed
+ * {@code org.theko.sound.codecs.cacheSize} MiB, 0 disables the cache.
+ * Concurrent requests for a file that is being decoded wait for that decode.
+ * <p>
+ * Cached samples are shared read-only: {@link org.theko.sound.SoundSource} copies them
+ * before the first write (see {@link org.theko.sound.SoundSource#getSamples()}).
+ *
+ * @since 0.3.1-beta
+ * @author Theko
+ */
+public final class AudioDecodeCache {
+
+    private static final Logger logger = LoggerFactory.getLogger(AudioDecodeCache.class);
+
+    private static final long CAPACITY = (long) CODECS_CACHE_SIZE * 1024 * 1024;
+
+    private static final Object LOCK = new Object();
+
+    // Guarded by LOCK
+    private static final LinkedHashMap<Key, AudioDecodeResult> entries = new LinkedHashMap<>(16, 0.75f, true);
+    private static final Map<Key, Pending> loading = new HashMap<>();
+    private static long size = 0;
+
+    /**
+     * Decodes a file, called on a cache miss.
+     */
+    @FunctionalInterface
+    public interface Decoder {
+        /**
+         * Decodes the file.
+         *
+         * @param file The file to decode
+         * @return The decode result, with valid samples
+         * @throws AudioCodecException If decoding fails
+         */
+        AudioDecodeResult decode(File file) throws AudioCodecException;
+    }
+
+    /**
+     * A decode result and whether its samples are shared with other callers.
+     */
+    public static final class Lookup {
+        private final AudioDecodeResult result;
+        private final boolean shared;
+
+        private Lookup(AudioDecodeResult result, boolean shared) {
+            this.result = result;
+            this.shared = shared;
+        }
+
+        /**
+         * Returns the decode result.
+         *
+         * @return The decode result
+         */
+        public AudioDecodeResult getResult() {
+            return result;
+        }
+
+        /**
+         * Checks if the samples are held by the cache or by other callers, and must not be modified.
+         *
+         * @return True if the samples are shared, false if the caller owns them
+         */
+        public boolean isShared() {
+            return shared;
+        }
+    }
+
+    private AudioDecodeCache() {
+        throw new UnsupportedOperationException("This class cannot be instantiated.");
+    }
+
+    /**
+     * Checks if the cache is enabled.
+     *
+     * @return True if {@code org.theko.sound.codecs.cacheSize} is above 0
+     */
+    public static boolean isEnabled() {
+        return CAPACITY > 0;
+    }
+
+    /**
+     * Returns the decoded file from the cache, decoding and caching it on a miss.
+     * Files larger than the whole cache are decoded but not cached.
+     *
+     * @param file The file to decode
+     * @param decoder Decodes the file on a miss
+     * @return The decode result, its samples must not be modified
+     * @throws AudioCodecException If decoding fails
+     */
+    public static AudioDecodeResult get(File file, Decoder decoder) throws AudioCodecException {
+        return lookup(file, decoder).getResult();
+    }
+
+    /**
+     * Returns the decoded file like {@link #get(File, Decoder)}, and whether its samples are shared.
+     * Samples that were neither cached nor handed to concurrent requests belong to the caller.
+     *
+     * @param file The file to decode
+     * @param decoder Decodes the file on a miss
+     * @return The decode result and its sharing state
+     * @throws AudioCodecException If decoding fails
+     */
+    public static Lookup lookup(File file, Decoder decoder) throws AudioCodecException {
+        if (!isEnabled()) {
+            return new Lookup(decoder.decode(file), false);
+        }
+        Key key = Key.of(file);
+
+        Pending pending;
+        boolean owner = false;
+        synchronized (LOCK) {
+            AudioDecodeResult cached = entries.get(key);
+            if (cached != null) {
+                logger.trace("Decode cache hit: {}", file.getName());
+                return new Lookup(cached, true);
+            }
+            pending = loading.get(key);
+            if (pending == null) {
+                pending = new Pending();
+                loading.put(key, pending);
+                owner = true;
+            } else {
+                pending.waiters++;
+            }
+        }
+
+        if (!owner) {
+            return new Lookup(await(pending.future), true);
+        }
+
+        try {
+            AudioDecodeResult result = decoder.decode(file);
+            boolean cached = put(key, result);
+            boolean shared;
+            synchronized (LOCK) {
+                // No request can join after this, the waiter count is final
+                loading.remove(key, pending);
+                shared = cached || pending.waiters > 0;
+            }
+            pending.future.complete(result);
+            return new Lookup(result, shared);
+        } catch (Throwable ex) {
+            // Errors too (e.g. OutOfMemoryError), or the waiters would block forever
+            pending.future.completeExceptionally(ex);
+            throw ex;
+        } finally {
+            synchronized (LOCK) {
+                loading.remove(key, pending);
+            }
+        }
+    }
+
+    /**
+     * Removes all cached entries of a file.
+     *
+     * @param file The file
+     */
+    public static void invalidate(File file) {
+        String path = Key.pathOf(file);
+        synchronized (LOCK) {
+            removeIf(path, null);
+        }
+    }
+
+    /**
+     * Removes all cached entries.
+     */
+    public static void clear() {
+        synchronized (LOCK) {
+            entries.clear();
+            size = 0;
+        }
+    }
+
+    /**
+     * Returns the size of the cached samples.
+     *
+     * @return The size, in bytes
+     */
+    public static long getSize() {
+        synchronized (LOCK) {
+            return size;
+        }
+    }
+
+    /**
+     * Returns the number of cached files.
+     *
+     * @return The entry count
+     */
+    public static int getEntryCount() {
+        synchronized (LOCK) {
+            return entries.size();
+        }
+    }
+
+    /**
+     * Caches the result, evicting the least recently used entries.
+     *
+     * @return False if the result is larger than the whole cache and was not cached
+     */
+    private static boolean put(Key key, AudioDecodeResult result) {
+        long bytes = sizeOf(result.getSamples());
+        if (bytes > CAPACITY) {
+            logger.debug("Not caching {}, {} bytes exceed the cache size.", key.path, bytes);
+            return false;
+        }
+        synchronized (LOCK) {
+            removeIf(key.path, key); // Older versions of the file
+            entries.put(key, result);
+            size += bytes;
+
+            Iterator<Map.Entry<Key, AudioDecodeResult>> it = entries.entrySet().iterator();
+            while (size > CAPACITY && it.hasNext()) {
+                Map.Entry<Key, AudioDecodeResult> eldest = it.next();
+                size -= sizeOf(eldest.getValue().getSamples());
+                it.remove();
+                logger.trace("Evicted from decode cache: {}", eldest.getKey().path);
+            }
+        }
+        return true;
+    }
+
+    private static void removeIf(String path, Key keep) {
+        Iterator<Map.Entry<Key, AudioDecodeResult>> it = entries.entrySet().iterator();
+        while (it.hasNext()) {
+            Map.Entry<Key, AudioDecodeResult> entry = it.next();
+            if (entry.getKey().path.equals(path) && !entry.getKey().equals(keep)) {
+                size -= sizeOf(entry.getValue().getSamples());
+                it.remove();
+            }
+        }
+    }
+
+    private static AudioDecodeResult await(CompletableFuture<AudioDecodeResult> pending) throws AudioCodecException {
+        try {
+            return pending.join();
+        } catch (CompletionException ex) {
+            Throwable cause = ex.getCause();
+            if (cause instanceof AudioCodecException codecException) throw codecException;
+            if (cause instanceof RuntimeException runtimeException) throw runtimeException;
+            if (cause instanceof Error error) throw error;
+            throw new AudioCodecException("Failed to decode audio file.", cause);
+        }
+    }
+
+    private static long sizeOf(float[][] samples) {
+        long bytes = 0;
+        for (float[] channel : samples) {
+            bytes += (long) channel.length * Float.BYTES;
+        }
+        return bytes;
+    }
+
+    private static final class Pending {
+        private final CompletableFuture<AudioDecodeResult> future = new CompletableFuture<>();
+        private int waiters = 0; // Guarded by LOCK
+    }
+
+    private static final class Key {
+        private final String path;
+        private final long length;
+        private final long lastModified;
+
+        private Key(String path, long length, long lastModified) {
+            this.path = path;
+            this.length = length;
+            this.lastModified = lastModified;
+        }
+
+        static Key of(File file) {
+            return new Key(pathOf(file), file.length(), file.lastModified());
+        }
+
+        static String pathOf(File file) {
+            try {
+                return file.getCanonicalPath();
+            } catch (IOException ex) {
+                return file.getAbsolutePath();
+            }
+        }
+
+        @Override
+        public boolean equals(Object obj) {
+            if (this == obj) return true;
+            if (!(obj instanceof Key other)) return false;
+            return length == other.length && lastModified == other.lastModified && path.equals(other.path);
+        }
+
+        @Override
+        public int hashCode() {
+            int result = path.hashCode();
+            result = 31 * result + Long.hashCode(length);
+            result = 31 * result + Long.hashCode(lastModified);
+            return result;
+        }
+    }
+}
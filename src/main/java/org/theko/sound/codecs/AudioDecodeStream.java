@@ -0,0 +1,97 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+package org.theko.sound.codecs;
+
+import org.theko.sound.AudioFormat;
+
+/**
+ * A decoded audio file that is read on demand instead of being held in memory.
+ * <p>
+ * Only the header is parsed when the stream is opened. The samples are converted
+ * block by block with {@link #read(long, float[][], int, int)}, which takes an absolute
+ * frame position, so seeking is free and memory use does not depend on the file length.
+ * Reads do not change any shared state, a stream may be read from one thread while
+ * another thread picks the next position.
+ *
+ * @see AudioCodec#openStream(java.nio.file.Path)
+ * @see AudioDecodeResult
+ *
+ * @since 0.3.1-beta
+ * @author Theko
+ */
+public abstract class AudioDecodeStream extends AudioCodecResult implements AutoCloseable {
+
+    /**
+     * Constructs an AudioDecodeStream with the specified codec information, audio format, and tags.
+     *
+     * @param codecInfo Information about the audio codec used for decoding
+     * @param format The format of the decoded audio
+     * @param tags The list of audio tags associated with the decoded audio
+     */
+    protected AudioDecodeStream(AudioCodecInfo codecInfo, AudioFormat format, AudioMetadata tags) {
+        super(codecInfo, format, tags);
+    }
+
+    /**
+     * Returns the length of the stream.
+     *
+     * @return The number of frames in the stream
+     */
+    public abstract long getFrameLength();
+
+    /**
+     * Converts frames starting at {@code framePosition} into normalized samples.
+     * Reads fewer frames than requested at the end of the stream.
+     *
+     * @param framePosition The first frame to read
+     * @param output The output samples, [channels][at least offset + frames]
+     * @param offset The first frame index to write in {@code output}
+     * @param frames The maximum number of frames to read
+     * @return The number of frames read, 0 at or past the end of the stream
+     * @throws IllegalArgumentException if the position is negative or the output array is too small
+     * @throws IllegalStateException if the stream is closed
+     */
+    public abstract int read(long framePosition, float[][] output, int offset, int frames);
+
+    /**
+     * Reads the whole stream into memory.
+     *
+     * @return The samples as a 2D float array ([channels][samples])
+     * @throws IllegalStateException if the stream is longer than a Java array or is closed
+     */
+    public float[][] readAll() {
+        long length = getFrameLength();
+        if (length > Integer.MAX_VALUE) {
+            throw new IllegalStateException("Stream is too long to be read into memory: " + length + " frames.");
+        }
+        float[][] samples = new float[getAudioFormat().getChannels()][(int) length];
+        int position = 0;
+        while (position < length) {
+            int read = read(position, samples, position, (int) length - position);
+            if (read <= 0) break;
+            position += read;
+        }
+        return samples;
+    }
+
+    /**
+     * Releases the file behind the stream. Reading a closed stream throws an exception.
+     */
+    @Override
+    public abstract void close();
+}
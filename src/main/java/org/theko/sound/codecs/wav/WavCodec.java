@@ -20,11 +20,15 @@ import static org.theko.sound.properties.AudioSystemProperties.LOG_METADATA;
 
 import java.io.ByteArrayOutputStream;
 import java.io.DataInputStream;
+import java.io.EOFException;
 import java.io.IOException;
 import java.io.InputStream;
 import java.nio.ByteBuffer;
 import java.nio.ByteOrder;
+import java.nio.channels.FileChannel;
 import java.nio.charset.StandardCharsets;
+import java.nio.file.Path;
+import java.nio.file.StandardOpenOption;
 import java.util.ArrayList;
 import java.util.Arrays;
 import java.util.HashMap;
@@ -40,6 +44,7 @@ import org.theko.sound.codecs.AudioCodec;
 import org.theko.sound.codecs.AudioCodecException;
 import org.theko.sound.codecs.AudioCodecType;
 import org.theko.sound.codecs.AudioDecodeResult;
+import org.theko.sound.codecs.AudioDecodeStream;
 import org.theko.sound.codecs.AudioEncodeConfig;
 import org.theko.sound.codecs.AudioEncodeResult;
 import org.theko.sound.codecs.AudioMetadata;
@@ -68,6 +73,9 @@ import org.theko.sound.util.FormatUtilities;
  * }
  * </pre>
  *
+ * <p>Large files can be opened with {@link #openStream(Path)} instead, which memory-maps
+ * the 'data' chunk and converts samples only when they are read.
+ *
  * <p>Note:
  * <ul>
  *   <li>The class assumes that the input WAVE file conforms to the RIFF specification.</li>
@@ -220,31 +228,8 @@ public class WavCodec extends AudioCodec {
             float[][] pcm;
 
             long toPcmConvertStartNs = System.nanoTime();
-            switch (encoding) {
-                case PCM_SIGNED_16: case PCM_SIGNED_24: case PCM_SIGNED_32:
-                    format = format.convertTo(Encoding.PCM_SIGNED);
-                    pcm = SamplesConverter.toSamples(audioData, format);
-                    break;
-                case PCM_UNSIGNED_8:
-                    format = format.convertTo(Encoding.PCM_UNSIGNED);
-                    pcm = SamplesConverter.toSamples(audioData, format);
-                    break;
-                case IEEE_FLOAT_32: case IEEE_FLOAT_64:
-                    format = format.convertTo(Encoding.PCM_FLOAT);
-                    pcm = SamplesConverter.toSamples(audioData, format);
-                    break;
-                case ULAW:
-                    format = format.convertTo(Encoding.ULAW);
-                    pcm = SamplesConverter.toSamples(audioData, format);
-                    break;
-                case ALAW:
-                    format = format.convertTo(Encoding.ALAW);
-                    pcm = SamplesConverter.toSamples(audioData, format);
-                    break;
-                default:
-                    logger.error("Invalid audio encoding: " + encoding.name());
-                    throw new AudioCodecException("Invalid audio encoding: " + encoding.name());
-            }
+            format = toSamplesFormat(format, encoding);
+            pcm = SamplesConverter.toSamples(audioData, format);
 
             long toPcmConvertNs = System.nanoTime() - toPcmConvertStartNs;
 
@@ -286,6 +271,159 @@ public class WavCodec extends AudioCodec {
         }
     }
 
+    /**
+     * Opens a WAVE file for decoding on demand.
+     * <p>
+     * Only the RIFF chunk headers, the 'fmt ' chunk and the LIST chunk are read. The 'data'
+     * chunk is memory-mapped and converted to samples block by block when it is read, so opening
+     * does not depend on the file length and the samples never take up heap memory.
+     * As in {@link #decode(InputStream)}, a 'data' chunk with an invalid size is read until the end of the file.
+     *
+     * @param file the WAVE file
+     * @return the opened stream, to be closed by the caller
+     * @throws AudioCodecException if the file is not a valid WAVE file or cannot be read
+     *
+     * @since 0.3.1-beta
+     */
+    @Override
+    public AudioDecodeStream openStream(Path file) throws AudioCodecException {
+        FileChannel channel = null;
+        try {
+            long startNs = System.nanoTime();
+            channel = FileChannel.open(file, StandardOpenOption.READ);
+            long fileSize = channel.size();
+
+            ByteBuffer header = ByteBuffer.allocate(12).order(ByteOrder.LITTLE_ENDIAN);
+            readFully(channel, header, 0);
+            byte[] riffHeader = new byte[4];
+            byte[] waveHeader = new byte[4];
+            header.get(riffHeader);
+            header.getInt(); // Skip file size (not used)
+            header.get(waveHeader);
+            if (!Arrays.equals(RIFF_BYTES, riffHeader)) {
+                logger.error("Not a valid RIFF file.");
+                throw new AudioCodecException("Not a valid RIFF file.");
+            }
+            if (!Arrays.equals(WAVE_BYTES, waveHeader)) {
+                logger.error("Not a valid WAVE file.");
+                throw new AudioCodecException("Not a valid WAVE file.");
+            }
+
+            WaveFormat fullFormat = null;
+            long dataOffset = -1;
+            long dataSize = 0;
+            List<AudioTag> tags = new ArrayList<>();
+
+            // Walk the chunk headers, the chunk bodies are only read for 'fmt ' and LIST
+            ByteBuffer chunkHeader = ByteBuffer.allocate(8).order(ByteOrder.LITTLE_ENDIAN);
+            long position = 12;
+            while (position + 8 <= fileSize) {
+                chunkHeader.clear();
+                readFully(channel, chunkHeader, position);
+                byte[] chunkIdBytes = new byte[4];
+                chunkHeader.get(chunkIdBytes);
+                long chunkSize = chunkHeader.getInt() & 0xFFFFFFFFL;
+                long bodyOffset = position + 8;
+                long available = fileSize - bodyOffset;
+
+                logger.trace("Chunk ID: {}, size: {} bytes", new String(chunkIdBytes, StandardCharsets.US_ASCII), chunkSize);
+                if (Arrays.equals(DATA_BYTES, chunkIdBytes)) {
+                    dataOffset = bodyOffset;
+                    if (chunkSize > available) {
+                        logger.debug("Streamed data chunk with size {} (invalid size) bytes. Using {} bytes until EOF.", chunkSize, available);
+                        chunkSize = available;
+                    }
+                    dataSize = chunkSize;
+                } else if (Arrays.equals(FORMAT_BYTES, chunkIdBytes) || Arrays.equals(LIST_BYTES, chunkIdBytes)) {
+                    if (chunkSize > available) {
+                        logger.error("Invalid WAV file: chunk exceeds the file size.");
+                        throw new AudioCodecException("Invalid WAV file: chunk exceeds the file size.");
+                    }
+                    ByteBuffer body = ByteBuffer.allocate((int) chunkSize);
+                    readFully(channel, body, bodyOffset);
+                    if (Arrays.equals(FORMAT_BYTES, chunkIdBytes)) {
+                        fullFormat = parseFormatChunk(body.array());
+                        logger.trace("Audio format: {}, encoding: {}", fullFormat.format, fullFormat.encoding);
+                    } else {
+                        parseListChunk(body.array(), tags);
+                    }
+                } else {
+                    logger.info("Skip chunk \"{}\" with size {} bytes.", new String(chunkIdBytes, StandardCharsets.US_ASCII), chunkSize);
+                }
+                position = bodyOffset + chunkSize + (chunkSize & 1);
+            }
+
+            if (fullFormat == null) {
+                logger.error("Invalid WAV file: missing 'fmt' chunk.");
+                throw new AudioCodecException("Invalid WAV file: missing 'fmt' chunk.");
+            }
+            if (dataOffset < 0) {
+                logger.error("Invalid WAV file: missing 'data' chunk.");
+                throw new AudioCodecException("Invalid WAV file: missing 'data' chunk.");
+            }
+            if (fullFormat.encoding == null) {
+                logger.error("Invalid Audio Encoding");
+                throw new AudioCodecException("Invalid Audio Encoding");
+            }
+
+            AudioFormat format = toSamplesFormat(fullFormat.format, fullFormat.encoding);
+            WavDecodeStream stream = new WavDecodeStream(getInfo(), format, new AudioMetadata(tags), channel, dataOffset, dataSize);
+
+            if (logger.isDebugEnabled()) {
+                StringBuilder opened = new StringBuilder();
+                opened.append("Opened WAVE stream:\n");
+                opened.append("  format=").append(format.toString()).append(",\n");
+                opened.append("  samples=").append(stream.getFrameLength()).append(" frames,\n");
+                opened.append("  elapsed=").append(FormatUtilities.formatTime(System.nanoTime() - startNs, 3));
+                if (LOG_METADATA)
+                    opened.append(",\n  metadata=").append(tags);
+                logger.debug(opened.toString());
+            }
+            return stream;
+        } catch (IOException | AudioCodecException ex) {
+            if (channel != null) {
+                try {
+                    channel.close();
+                } catch (IOException closeEx) {
+                    ex.addSuppressed(closeEx);
+                }
+            }
+            if (ex instanceof AudioCodecException) throw (AudioCodecException) ex;
+            throw new AudioCodecException(ex);
+        }
+    }
+
+    @Override
+    public boolean isStreamingSupported() {
+        return true;
+    }
+
+    /**
+     * Returns the format of the samples data for the given WAVE encoding.
+     *
+     * @param format the format parsed from the 'fmt ' chunk
+     * @param encoding the WAVE encoding
+     * @return the format with the matching {@link Encoding}
+     * @throws AudioCodecException if the encoding is not supported
+     */
+    protected static AudioFormat toSamplesFormat(AudioFormat format, WavAudioEncoding encoding) throws AudioCodecException {
+        switch (encoding) {
+            case PCM_SIGNED_16: case PCM_SIGNED_24: case PCM_SIGNED_32:
+                return format.convertTo(Encoding.PCM_SIGNED);
+            case PCM_UNSIGNED_8:
+                return format.convertTo(Encoding.PCM_UNSIGNED);
+            case IEEE_FLOAT_32: case IEEE_FLOAT_64:
+                return format.convertTo(Encoding.PCM_FLOAT);
+            case ULAW:
+                return format.convertTo(Encoding.ULAW);
+            case ALAW:
+                return format.convertTo(Encoding.ALAW);
+            default:
+                logger.error("Invalid audio encoding: " + encoding.name());
+                throw new AudioCodecException("Invalid audio encoding: " + encoding.name());
+        }
+    }
+
     /**
      * Parses the 'fmt ' chunk of a WAVE file and returns the audio format.
      *
@@ -527,6 +665,24 @@ public class WavCodec extends AudioCodec {
         }
     }
 
+    /**
+     * Fills the buffer from the channel, starting at the given file position, and flips it.
+     *
+     * @param channel the channel to read from
+     * @param buffer the buffer to fill
+     * @param position the file position to read from
+     * @throws IOException if the end of the file is reached before the buffer is full
+     */
+    protected static void readFully(FileChannel channel, ByteBuffer buffer, long position) throws IOException {
+        long offset = position;
+        while (buffer.hasRemaining()) {
+            int read = channel.read(buffer, offset);
+            if (read < 0) throw new EOFException("Unexpected end of file at " + offset + ".");
+            offset += read;
+        }
+        buffer.flip();
+    }
+
     /**
      * Reads a 4-byte little-endian integer from the given DataInputStream.
      *
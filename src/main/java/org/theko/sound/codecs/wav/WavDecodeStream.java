@@ -0,0 +1,116 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+package org.theko.sound.codecs.wav;
+
+import java.io.IOException;
+import java.nio.MappedByteBuffer;
+import java.nio.channels.FileChannel;
+
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+import org.theko.sound.AudioFormat;
+import org.theko.sound.codecs.AudioCodecInfo;
+import org.theko.sound.codecs.AudioDecodeStream;
+import org.theko.sound.codecs.AudioMetadata;
+import org.theko.sound.samples.SamplesConverter;
+
+/**
+ * Memory-mapped 'data' chunk of a WAVE file, see {@link WavCodec#openStream(java.nio.file.Path)}.
+ * <p>
+ * The chunk is mapped read-only in segments of up to 1 GiB (a mapping is limited to 2 GiB),
+ * each holding a whole number of frames. The operating system pages the file in as it is read,
+ * the heap only holds the samples of the block being converted.
+ *
+ * @since 0.3.1-beta
+ * @author Theko
+ */
+final class WavDecodeStream extends AudioDecodeStream {
+
+    private static final Logger logger = LoggerFactory.getLogger(WavDecodeStream.class);
+
+    private static final int MAX_SEGMENT_BYTES = 1 << 30;
+
+    private final FileChannel channel;
+    private final MappedByteBuffer[] segments;
+    private final int frameSize;
+    private final int framesPerSegment;
+    private final long frameLength;
+    private volatile boolean closed = false;
+
+    WavDecodeStream(AudioCodecInfo codecInfo, AudioFormat format, AudioMetadata tags,
+            FileChannel channel, long dataOffset, long dataSize) throws IOException {
+        super(codecInfo, format, tags);
+        this.channel = channel;
+        this.frameSize = format.getBytesPerSample() * format.getChannels();
+        this.framesPerSegment = MAX_SEGMENT_BYTES / frameSize;
+        this.frameLength = dataSize / frameSize;
+
+        int segmentCount = (int) ((frameLength + framesPerSegment - 1) / framesPerSegment);
+        this.segments = new MappedByteBuffer[segmentCount];
+        for (int i = 0; i < segmentCount; i++) {
+            long firstFrame = (long) i * framesPerSegment;
+            long frames = Math.min(framesPerSegment, frameLength - firstFrame);
+            segments[i] = channel.map(FileChannel.MapMode.READ_ONLY, dataOffset + firstFrame * frameSize, frames * frameSize);
+        }
+    }
+
+    @Override
+    public long getFrameLength() {
+        return frameLength;
+    }
+
+    @Override
+    public int read(long framePosition, float[][] output, int offset, int frames) {
+        if (closed) {
+            throw new IllegalStateException("Stream is closed.");
+        }
+        if (framePosition < 0) {
+            throw new IllegalArgumentException("Frame position cannot be negative.");
+        }
+        if (frames <= 0 || framePosition >= frameLength) {
+            return 0;
+        }
+
+        int total = (int) Math.min(frames, frameLength - framePosition);
+        int done = 0;
+        while (done < total) {
+            long frame = framePosition + done;
+            int segment = (int) (frame / framesPerSegment);
+            int inSegment = (int) (frame % framesPerSegment);
+            int count = Math.min(total - done, framesPerSegment - inSegment);
+
+            // Absolute slice, the position of the shared mapping is never touched
+            SamplesConverter.toSamples(segments[segment].slice(inSegment * frameSize, count * frameSize),
+                    output, offset + done, count, getAudioFormat());
+            done += count;
+        }
+        return total;
+    }
+
+    @Override
+    public void close() {
+        if (closed) return;
+        closed = true;
+        try {
+            // The mappings stay valid until they are garbage collected
+            channel.close();
+        } catch (IOException ex) {
+            logger.warn("Failed to close WAVE stream.", ex);
+        }
+    }
+}
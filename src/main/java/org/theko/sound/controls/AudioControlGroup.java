@@ -129,6 +129,34 @@ public class AudioControlGroup implements Serializable {
         }
     }
 
+    /**
+     * Applies a block ramp to the Float controls of the group and the end value to the others.
+     *
+     * @param start The value at the start of the block
+     * @param end The value at the end of the block
+     * @see FloatControl#setBlockRamp(float, float)
+     */
+    public void applyRamp(float start, float end) {
+        for (FloatControl control : floatControls) {
+            control.setBlockRamp(start, end);
+        }
+        for (BooleanControl control : booleanControls) {
+            control.setValue(end > 0.5f);
+        }
+        for (EnumControl control : enumControls) {
+            control.setValue((int)end);
+        }
+    }
+
+    /**
+     * Removes the block ramps of all Float controls in the group.
+     */
+    public void clearRamps() {
+        for (FloatControl control : floatControls) {
+            control.clearBlockRamp();
+        }
+    }
+
     /**
      * Applies a value to all Float controls in the group.
      *
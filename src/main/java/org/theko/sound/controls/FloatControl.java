@@ -45,6 +45,12 @@ public class FloatControl extends AudioControl {
     protected float value;
     protected final float min, max;
 
+    // Ramp of the current block, only used by the render thread
+    protected float rampStart;
+    protected boolean ramping = false;
+
+    // Changed on every value write, polled by render-thread consumers
+    private volatile int version;
 
     public FloatControl(String name, float min, float max, float value) {
         super(name);
@@ -61,6 +67,7 @@ public class FloatControl extends AudioControl {
      */
     public void setValue(float value) {
         this.value = MathUtilities.clamp(value, min, max);
+        version++;
         eventDispatcher.dispatch(AudioControlEventType.VALUE_CHANGE, new AudioControlEvent(this));
     }
 
@@ -75,6 +82,7 @@ public class FloatControl extends AudioControl {
      */
     public void setNormalized(float value) {
         this.value = MathUtilities.remapClamped(value, 0f, 1f, min, max);
+        version++;
         eventDispatcher.dispatch(AudioControlEventType.VALUE_CHANGE, new AudioControlEvent(this));
     }
 
@@ -87,6 +95,62 @@ public class FloatControl extends AudioControl {
         return value;
     }
 
+    /**
+     * Sets the value at the end of the current block and the value at its start.
+     * Called on the render thread by a render-synchronous {@link org.theko.sound.BlockModulator},
+     * {@link #getValueAt(int, int)} then interpolates between them.
+     * The value is stored without a value change event, so the render thread dispatches nothing.
+     *
+     * @param start The value at the first frame of the block
+     * @param end The value after the last frame of the block, the new value of this control
+     */
+    public void setBlockRamp(float start, float end) {
+        this.rampStart = MathUtilities.clamp(start, min, max);
+        this.value = MathUtilities.clamp(end, min, max);
+        this.ramping = rampStart != value;
+        version++;
+    }
+
+    /**
+     * Retrieves the version of the value, which changes on every value write, block ramps included.
+     * Block ramps dispatch no events, so render-thread consumers compare this version
+     * once per block instead of listening for value changes.
+     *
+     * @return The current version of the value
+     */
+    public int getVersion() {
+        return version;
+    }
+
+    /**
+     * Removes the block ramp, {@link #getValueAt(int, int)} returns the value again.
+     */
+    public void clearBlockRamp() {
+        ramping = false;
+    }
+
+    /**
+     * Checks if the value changes within the current block.
+     *
+     * @return True if a block ramp with different start and end values is set
+     */
+    public boolean isRamping() {
+        return ramping;
+    }
+
+    /**
+     * Retrieves the value at a frame of the current block.
+     * Without a block ramp this is the current value.
+     *
+     * @param frame The frame index within the block
+     * @param frames The block length in frames
+     * @return The value at the frame
+     */
+    public float getValueAt(int frame, int frames) {
+        if (!ramping) return value;
+        return rampStart + (value - rampStart) * frame / frames;
+    }
+
     /**
      * Retrieves the minimum bound of the range for this control.
      *
@@ -1,16 +1,35 @@
 package org.theko.sound.dsp;
 
+import java.util.Arrays;
 import java.util.List;
 
-import org.theko.events.EventConsumer;
 import org.theko.sound.controls.AudioControl;
 import org.theko.sound.controls.Controllable;
 import org.theko.sound.controls.FloatControl;
-import org.theko.sound.events.AudioControlEvent;
-import org.theko.sound.events.AudioControlEventType;
-
+import org.theko.sound.samples.SamplesValidation;
+
+/**
+ * A cascade of second order IIR sections (biquads), the order is twice the number of stages.
+ * <p>
+ * The block methods run the cascade stage by stage over the whole block, with the
+ * coefficients and the state of a stage held in locals, and process channels in pairs
+ * so the two recursions overlap. Coefficients are designed only after a control changes
+ * or the sample rate changes. In the block methods a control change is approached over
+ * about 10 ms, one coefficient set per block, which avoids zipper noise.
+ * <p>
+ * The filter keeps the state of each channel it processed, the single-channel methods use channel 0.
+ */
 public class BiquadFilter extends CutoffAudioFilter implements Controllable {
 
+    /** Time constant of the parameter smoothing of the block methods, in milliseconds. */
+    private static final int SMOOTHING_MS = 10;
+
+    /** Relative parameter distance at which the smoothing snaps to the target. */
+    private static final float SMOOTHING_EPSILON = 1e-3f;
+
+    /** Values of the filter state of each stage: x1, x2, y1, y2. */
+    private static final int STATE_SIZE = 4;
+
     public class Stage extends CutoffAudioFilter implements Controllable {
 
         private float b0, b1, b2, a1, a2;
@@ -23,17 +42,18 @@ public class BiquadFilter extends CutoffAudioFilter implements Controllable {
 
         protected final List<AudioControl> filterControls = List.of(cutoff, q, gain);
 
+        // Parameters of the current coefficients, they approach the controls in the block methods
+        private float designCutoff, designQ, designGain;
+        private boolean changed = true;
+
+        // Control versions of the last poll, block ramps change them without events
+        private int cutoffVersion, qVersion, gainVersion;
+
         private int lastSampleRate = -1;
 
         public Stage(FilterType filterType) {
             super(filterType);
-
-            // Add listeners
-            EventConsumer<AudioControlEvent, AudioControlEventType> consumer =
-                    (event, type) -> update(lastSampleRate);
-            this.cutoff.addConsumer(consumer);
-            this.q.addConsumer(consumer);
-            this.gain.addConsumer(consumer);
+            pollControls();
         }
 
         @Override
@@ -49,12 +69,27 @@ public class BiquadFilter extends CutoffAudioFilter implements Controllable {
             return gain;
         }
 
+        /**
+         * Designs the coefficients for the current control values, without smoothing.
+         *
+         * @param sampleRate the sample rate in Hz
+         */
         public void update(int sampleRate) {
-            float A = (float)Math.sqrt(gain.getValue());
-            float omega = (float) (2.0 * Math.PI * cutoff.getValue() / sampleRate);
+            pollControls();
+            changed = false;
+            designCutoff = cutoff.getValue();
+            designQ = q.getValue();
+            designGain = gain.getValue();
+            design(sampleRate);
+            lastSampleRate = sampleRate;
+        }
+
+        private void design(int sampleRate) {
+            float A = (float)Math.sqrt(designGain);
+            float omega = (float) (2.0 * Math.PI * designCutoff / sampleRate);
             float sn = (float) Math.sin(omega);
             float cs = (float) Math.cos(omega);
-            float alpha = sn / (2.0f * q.getValue());
+            float alpha = sn / (2.0f * designQ);
 
             float a0;
 
@@ -124,12 +159,68 @@ public class BiquadFilter extends CutoffAudioFilter implements Controllable {
             a2 /= a0;
         }
 
-        @Override
-        public float process(float input, int sampleRate) {
+        /**
+         * Designs the coefficients if a control or the sample rate changed since the last sample.
+         */
+        private void prepareSample(int sampleRate) {
+            pollControls();
+            if (sampleRate != lastSampleRate || changed) {
+                update(sampleRate);
+            }
+        }
+
+        /**
+         * Moves the parameters one block of {@code length} frames towards the control values
+         * and designs the coefficients for them. A new sample rate is applied at once.
+         */
+        private void prepareBlock(int sampleRate, int length) {
+            pollControls();
             if (sampleRate != lastSampleRate) {
                 update(sampleRate);
-                lastSampleRate = sampleRate;
+                return;
+            }
+            if (!changed) return;
+            changed = false;
+
+            float k = (float) (1.0 - Math.exp(-length * 1000.0 / ((double) SMOOTHING_MS * sampleRate)));
+            float targetCutoff = cutoff.getValue();
+            float targetQ = q.getValue();
+            float targetGain = gain.getValue();
+
+            // The cutoff moves in octaves, Q and gain linearly
+            designCutoff = (float) (designCutoff * Math.pow(targetCutoff / designCutoff, k));
+            designQ += (targetQ - designQ) * k;
+            designGain += (targetGain - designGain) * k;
+
+            boolean settled = isClose(designCutoff, targetCutoff)
+                          && isClose(designQ, targetQ)
+                          && isClose(designGain, targetGain);
+            if (settled) {
+                designCutoff = targetCutoff;
+                designQ = targetQ;
+                designGain = targetGain;
+            } else {
+                changed = true;
+            }
+            design(sampleRate);
+        }
+
+        /**
+         * Marks the coefficients as changed if a control was written since the last poll.
+         */
+        private void pollControls() {
+            int cutoffNow = cutoff.getVersion(), qNow = q.getVersion(), gainNow = gain.getVersion();
+            if (cutoffNow != cutoffVersion || qNow != qVersion || gainNow != gainVersion) {
+                cutoffVersion = cutoffNow;
+                qVersion = qNow;
+                gainVersion = gainNow;
+                changed = true;
             }
+        }
+
+        @Override
+        public float process(float input, int sampleRate) {
+            prepareSample(sampleRate);
             float y0 = b0 * input + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2;
 
             x2 = x1;
@@ -143,6 +234,9 @@ public class BiquadFilter extends CutoffAudioFilter implements Controllable {
         @Override
         public AudioFilter copyFilter() {
             Stage copy = new Stage(filterType);
+            copy.cutoff.setValue(cutoff.getValue());
+            copy.q.setValue(q.getValue());
+            copy.gain.setValue(gain.getValue());
             copy.b0 = b0;
             copy.b1 = b1;
             copy.b2 = b2;
@@ -170,6 +264,12 @@ public class BiquadFilter extends CutoffAudioFilter implements Controllable {
 
     private Stage[] biquads;
 
+    // Control versions last forwarded to the stages
+    private int cutoffVersion, qVersion, gainVersion;
+
+    // Filter state, [channel][stage * STATE_SIZE + {x1, x2, y1, y2}]
+    private float[][] state;
+
     public BiquadFilter(FilterType filterType, int order) {
         super(filterType);
         if (order % 2 != 0) {
@@ -184,25 +284,7 @@ public class BiquadFilter extends CutoffAudioFilter implements Controllable {
         for (int i = 0; i < stages; i++) {
             biquads[i] = new Stage(filterType);
         }
-
-        // Add listeners
-        cutoff.addConsumer((event, type) -> {
-            for (Stage biquad : biquads) {
-                biquad.cutoff.setValue(cutoff.getValue());
-            }
-        });
-
-        q.addConsumer((event, type) -> {
-            for (Stage biquad : biquads) {
-                biquad.q.setValue(q.getValue());
-            }
-        });
-
-        gain.addConsumer((event, type) -> {
-            for (Stage biquad : biquads) {
-                biquad.gain.setValue(gain.getValue());
-            }
-        });
+        state = new float[1][stages * STATE_SIZE];
     }
 
     public FilterType getFilterType() {
@@ -232,6 +314,7 @@ public class BiquadFilter extends CutoffAudioFilter implements Controllable {
     }
 
     public void update(int sampleRate) {
+        syncStages();
         for (Stage biquad : biquads) {
             biquad.update(sampleRate);
         }
@@ -239,12 +322,171 @@ public class BiquadFilter extends CutoffAudioFilter implements Controllable {
 
     @Override
     public float process(float sample, int sampleRate) {
-        for (Stage biquad : biquads) {
-            sample = biquad.process(sample, sampleRate);
+        syncStages();
+        float[] st = state[0];
+        for (int s = 0; s < biquads.length; s++) {
+            Stage stage = biquads[s];
+            stage.prepareSample(sampleRate);
+            int o = s * STATE_SIZE;
+            float y0 = stage.b0 * sample + stage.b1 * st[o] + stage.b2 * st[o + 1] - stage.a1 * st[o + 2] - stage.a2 * st[o + 3];
+            st[o + 1] = st[o];
+            st[o] = sample;
+            st[o + 3] = st[o + 2];
+            st[o + 2] = y0;
+            sample = y0;
         }
         return sample;
     }
 
+    /**
+     * Filters a block of one channel, with the state of channel 0.
+     *
+     * @param samples the input samples
+     * @param output the output samples, may be the input array
+     * @param sampleRate the sample rate in Hz
+     * @throws IllegalArgumentException if the samples and output arrays do not have the same length
+     */
+    @Override
+    public void process(float[] samples, float[] output, int sampleRate) {
+        SamplesValidation.validateSamples(samples);
+        SamplesValidation.validateSamples(output);
+        if (SamplesValidation.checkSamplesDimensions(samples, output) != SamplesValidation.DimensionsResult.EXACT) {
+            throw new IllegalArgumentException("Samples and output arrays must have the same length.");
+        }
+        syncStages();
+        int length = samples.length;
+        float[] input = samples;
+        for (int s = 0; s < biquads.length; s++) {
+            Stage stage = biquads[s];
+            stage.prepareBlock(sampleRate, length);
+            runStage(input, output, length, state[0], s * STATE_SIZE, stage);
+            input = output;
+        }
+    }
+
+    /**
+     * Filters a block of all channels in place. Each channel keeps its own state,
+     * the coefficients are shared.
+     *
+     * @param block the samples, [channel][frame]
+     * @param sampleRate the sample rate in Hz
+     * @throws IllegalArgumentException if the block is empty or its channels have different lengths
+     */
+    public void process(float[][] block, int sampleRate) {
+        SamplesValidation.validateSamples(block);
+        if (!SamplesValidation.checkLength(block)) {
+            throw new IllegalArgumentException("Samples length must be the same for all channels.");
+        }
+        int channels = block.length;
+        int length = block[0].length;
+        ensureChannels(channels);
+        syncStages();
+
+        for (int s = 0; s < biquads.length; s++) {
+            Stage stage = biquads[s];
+            stage.prepareBlock(sampleRate, length);
+            int o = s * STATE_SIZE;
+            int ch = 0;
+            for (; ch + 1 < channels; ch += 2) {
+                runStagePair(block[ch], block[ch + 1], length, state[ch], state[ch + 1], o, stage);
+            }
+            if (ch < channels) {
+                runStage(block[ch], block[ch], length, state[ch], o, stage);
+            }
+        }
+    }
+
+    /**
+     * Clears the state of all channels.
+     */
+    public void reset() {
+        for (float[] channel : state) {
+            Arrays.fill(channel, 0.0f);
+        }
+    }
+
+    /**
+     * Forwards the filter controls written since the last call to the stages.
+     * The controls are polled rather than listened to, so the block ramps of
+     * render-synchronous modulators reach the stages too, without events.
+     */
+    private void syncStages() {
+        int cutoffNow = cutoff.getVersion();
+        if (cutoffNow != cutoffVersion) {
+            cutoffVersion = cutoffNow;
+            for (Stage biquad : biquads) {
+                biquad.cutoff.setBlockRamp(cutoff.getValueAt(0, 1), cutoff.getValue());
+            }
+        }
+        int qNow = q.getVersion();
+        if (qNow != qVersion) {
+            qVersion = qNow;
+            for (Stage biquad : biquads) {
+                biquad.q.setBlockRamp(q.getValueAt(0, 1), q.getValue());
+            }
+        }
+        int gainNow = gain.getVersion();
+        if (gainNow != gainVersion) {
+            gainVersion = gainNow;
+            for (Stage biquad : biquads) {
+                biquad.gain.setBlockRamp(gain.getValueAt(0, 1), gain.getValue());
+            }
+        }
+    }
+
+    private void ensureChannels(int channels) {
+        if (state.length >= channels) return;
+        int oldChannels = state.length;
+        state = Arrays.copyOf(state, channels);
+        for (int ch = oldChannels; ch < channels; ch++) {
+            state[ch] = new float[biquads.length * STATE_SIZE];
+        }
+    }
+
+    private static void runStage(float[] in, float[] out, int length, float[] st, int o, Stage stage) {
+        final float b0 = stage.b0, b1 = stage.b1, b2 = stage.b2, a1 = stage.a1, a2 = stage.a2;
+        float x1 = st[o], x2 = st[o + 1], y1 = st[o + 2], y2 = st[o + 3];
+        for (int i = 0; i < length; i++) {
+            float x0 = in[i];
+            float y0 = b0 * x0 + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2;
+            x2 = x1;
+            x1 = x0;
+            y2 = y1;
+            y1 = y0;
+            out[i] = y0;
+        }
+        st[o] = x1;
+        st[o + 1] = x2;
+        st[o + 2] = y1;
+        st[o + 3] = y2;
+    }
+
+    /**
+     * Runs one stage over two channels in the same loop, the two independent
+     * recursions hide each other's latency.
+     */
+    private static void runStagePair(float[] left, float[] right, int length, float[] stLeft, float[] stRight, int o, Stage stage) {
+        final float b0 = stage.b0, b1 = stage.b1, b2 = stage.b2, a1 = stage.a1, a2 = stage.a2;
+        float lx1 = stLeft[o], lx2 = stLeft[o + 1], ly1 = stLeft[o + 2], ly2 = stLeft[o + 3];
+        float rx1 = stRight[o], rx2 = stRight[o + 1], ry1 = stRight[o + 2], ry2 = stRight[o + 3];
+        for (int i = 0; i < length; i++) {
+            float lx0 = left[i];
+            float rx0 = right[i];
+            float ly0 = b0 * lx0 + b1 * lx1 + b2 * lx2 - a1 * ly1 - a2 * ly2;
+            float ry0 = b0 * rx0 + b1 * rx1 + b2 * rx2 - a1 * ry1 - a2 * ry2;
+            lx2 = lx1; lx1 = lx0; ly2 = ly1; ly1 = ly0;
+            rx2 = rx1; rx1 = rx0; ry2 = ry1; ry1 = ry0;
+            left[i] = ly0;
+            right[i] = ry0;
+        }
+        stLeft[o] = lx1; stLeft[o + 1] = lx2; stLeft[o + 2] = ly1; stLeft[o + 3] = ly2;
+        stRight[o] = rx1; stRight[o + 1] = rx2; stRight[o + 2] = ry1; stRight[o + 3] = ry2;
+    }
+
+    private static boolean isClose(float value, float target) {
+        return Math.abs(value - target) <= SMOOTHING_EPSILON * Math.max(Math.abs(target), 1e-6f);
+    }
+
     @Override
     public AudioFilter copyFilter() {
         BiquadFilter copy = new BiquadFilter(filterType, getOrder());
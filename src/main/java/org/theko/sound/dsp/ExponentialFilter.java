@@ -18,12 +18,9 @@ package org.theko.sound.dsp;
 
 import java.util.List;
 
-import org.theko.events.EventConsumer;
 import org.theko.sound.controls.AudioControl;
 import org.theko.sound.controls.Controllable;
 import org.theko.sound.controls.FloatControl;
-import org.theko.sound.events.AudioControlEvent;
-import org.theko.sound.events.AudioControlEventType;
 
 
 public class ExponentialFilter extends CutoffAudioFilter implements Controllable {
@@ -40,14 +37,11 @@ public class ExponentialFilter extends CutoffAudioFilter implements Controllable
 
         private int lastSampleRate = -1;
 
+        // Cutoff version of the last coefficient update, block ramps change it without events
+        private int cutoffVersion;
+
         public Stage(FilterType filterType) {
             super(filterType);
-
-            // Add listeners
-            EventConsumer<AudioControlEvent, AudioControlEventType> consumer =
-                    (event, type) -> update(lastSampleRate);
-            cutoff.addConsumer(consumer);
-            gain.addConsumer(consumer);
         }
 
         public FilterType getFilterType() {
@@ -95,15 +89,15 @@ public class ExponentialFilter extends CutoffAudioFilter implements Controllable
         }
 
         public void update(int sampleRate) {
+            cutoffVersion = cutoff.getVersion();
             a = 1.0f - (float)Math.exp(-2 * Math.PI * cutoff.getValue() / sampleRate);
             lastSampleRate = sampleRate;
         }
 
         @Override
         public float process(float input, int sampleRate) {
-            if (lastSampleRate != sampleRate) {
-                a = 1.0f - (float)Math.exp(-2 * Math.PI * cutoff.getValue() / sampleRate);
-                lastSampleRate = sampleRate;
+            if (lastSampleRate != sampleRate || cutoff.getVersion() != cutoffVersion) {
+                update(sampleRate);
             }
             switch (filterType) {
                 case LOWPASS:  return lp(input);
@@ -141,25 +135,15 @@ public class ExponentialFilter extends CutoffAudioFilter implements Controllable
 
     private final Stage[] stages;
 
+    // Control versions last forwarded to the stages
+    private int cutoffVersion, gainVersion;
+
     public ExponentialFilter(FilterType filterType, int stagesCount) {
         super(filterType);
         this.stages = new Stage[stagesCount];
         for (int i = 0; i < stagesCount; i++) {
             stages[i] = new Stage(filterType);
         }
-
-        // Add listeners
-        cutoff.addConsumer((event, type) -> {
-            for (Stage stage : stages) {
-                stage.cutoff.setValue(cutoff.getValue());
-            }
-        });
-
-        gain.addConsumer((event, type) -> {
-            for (Stage stage : stages) {
-                stage.gain.setValue(gain.getValue());
-            }
-        });
     }
 
     public FilterType getFilterType() {
@@ -180,6 +164,7 @@ public class ExponentialFilter extends CutoffAudioFilter implements Controllable
     }
 
     public void update(int sampleRate) {
+        syncStages();
         for (Stage stage : stages) {
             stage.update(sampleRate);
         }
@@ -187,6 +172,7 @@ public class ExponentialFilter extends CutoffAudioFilter implements Controllable
 
     @Override
     public float process(float input, int sampleRate) {
+        syncStages();
         float output = input;
         for (Stage stage : stages) {
             output = stage.process(output, sampleRate);
@@ -194,6 +180,28 @@ public class ExponentialFilter extends CutoffAudioFilter implements Controllable
         return output;
     }
 
+    /**
+     * Forwards the filter controls written since the last call to the stages.
+     * The controls are polled rather than listened to, so the block ramps of
+     * render-synchronous modulators reach the stages too, without events.
+     */
+    private void syncStages() {
+        int cutoffNow = cutoff.getVersion();
+        if (cutoffNow != cutoffVersion) {
+            cutoffVersion = cutoffNow;
+            for (Stage stage : stages) {
+                stage.cutoff.setBlockRamp(cutoff.getValueAt(0, 1), cutoff.getValue());
+            }
+        }
+        int gainNow = gain.getVersion();
+        if (gainNow != gainVersion) {
+            gainVersion = gainNow;
+            for (Stage stage : stages) {
+                stage.gain.setBlockRamp(gain.getValueAt(0, 1), gain.getValue());
+            }
+        }
+    }
+
     @Override
     public ExponentialFilter copyFilter() {
         ExponentialFilter copy = new ExponentialFilter(filterType, stages.length);
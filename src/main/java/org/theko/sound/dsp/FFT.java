@@ -22,6 +22,8 @@ package org.theko.sound.dsp;
  * <p>
  * This implementation uses the Cooley-Tukey radix-2 decimation-in-time algorithm and operates in-place
  * on the provided arrays. The input arrays must have a length that is a power of two.
+ * The transforms run on the cached {@link FFTPlan} of that length; use {@link FFTPlan#forwardReal}
+ * directly for real signals.
  *
  * <p>
  * Usage example:
@@ -50,54 +52,13 @@ public final class FFT {
      * @param real the real part of the complex sequence
      * @param imag the imaginary part of the complex sequence
      * @throws IllegalArgumentException if the length of the two arrays is not
-     *         equal
+     *         equal, or is not a power of two
      */
     public static void fft(float[] real, float[] imag) {
-        int n = real.length;
-        int logN = Integer.numberOfTrailingZeros(n); // log2(n)
-
-        // Reorder the real and imaginary parts using bit reversal
-        for (int i = 0; i < n; i++) {
-            int j = Integer.reverse(i) >>> (32 - logN);
-            if (i < j) {
-                swap(real, i, j);
-                swap(imag, i, j);
-            }
-        }
-
-        // Perform the Cooley-Tukey FFT algorithm
-        for (int size = 2; size <= n; size *= 2) {
-            int halfSize = size / 2;
-            float wAngle = (float) (-2 * Math.PI / size);
-            float wReal = (float) Math.cos(wAngle);
-            float wImag = (float) Math.sin(wAngle);
-
-            // Process each subarray of the size
-            for (int start = 0; start < n; start += size) {
-                float uReal = 1.0f;
-                float uImag = 0.0f;
-
-                // Process each pair of elements in the subarray
-                for (int i = 0; i < halfSize; i++) {
-                    int evenIndex = start + i;
-                    int oddIndex = start + i + halfSize;
-
-                    // Compute the complex products and add them to the even and odd elements
-                    float tReal = uReal * real[oddIndex] - uImag * imag[oddIndex];
-                    float tImag = uReal * imag[oddIndex] + uImag * real[oddIndex];
-
-                    real[oddIndex] = real[evenIndex] - tReal;
-                    imag[oddIndex] = imag[evenIndex] - tImag;
-                    real[evenIndex] += tReal;
-                    imag[evenIndex] += tImag;
-
-                    // Compute the new values of uReal and uImag
-                    float tmpReal = uReal * wReal - uImag * wImag;
-                    uImag = uReal * wImag + uImag * wReal;
-                    uReal = tmpReal;
-                }
-            }
+        if (real.length != imag.length) {
+            throw new IllegalArgumentException("Real and imaginary arrays must have the same length.");
         }
+        FFTPlan.of(real.length).forward(real, imag);
     }
 
     /**
@@ -116,36 +77,9 @@ public final class FFT {
      *             and output.
      */
     public static void ifft(float[] real, float[] imag) {
-        // Negate the imaginary parts
-        int n = real.length;
-        for (int i = 0; i < n; i++) {
-            imag[i] = -imag[i];
+        if (real.length != imag.length) {
+            throw new IllegalArgumentException("Real and imaginary arrays must have the same length.");
         }
-
-        // Call the FFT method
-        fft(real, imag);
-
-        // Scale down the real and imaginary components
-        for (int i = 0; i < n; i++) {
-            real[i] /= n;
-            imag[i] /= n;
-        }
-
-        // Negate the imaginary parts again to complete the inverse transformation
-        for (int i = 0; i < n; i++) {
-            imag[i] = -imag[i];
-        }
-    }
-
-    /**
-     * Swaps two elements in an array of floats
-     * @param arr the array
-     * @param i the first index
-     * @param j the second index
-     */
-    private static void swap(float[] arr, int i, int j) {
-        float temp = arr[i];
-        arr[i] = arr[j];
-        arr[j] = temp;
+        FFTPlan.of(real.length).inverse(real, imag);
     }
 }
@@ -0,0 +1,313 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.theko.sound.dsp;
+
+import java.util.Arrays;
+import java.util.Map;
+import java.util.concurrent.ConcurrentHashMap;
+
+/**
+ * Precomputed FFT of one power-of-two size.
+ * <p>
+ * A plan holds the bit-reversal permutation and the twiddle factors of its size, each
+ * twiddle computed directly in double precision (no recurrence), so a transform does no
+ * trigonometry. The complex transform runs two radix-2 stages per pass over the data
+ * (radix-2&sup2; butterflies), which halves the memory traffic of a plain radix-2 FFT.
+ * {@link #forwardReal} transforms a real signal of {@code n} samples with a complex FFT
+ * of {@code n / 2} points, half the work of transforming it with a zero imaginary part.
+ * <p>
+ * Plans are immutable and thread-safe, {@link #of(int)} returns a shared plan per size.
+ *
+ * <pre>
+ * FFTPlan plan = FFTPlan.of(2048);
+ * plan.forwardReal(samples, binsReal, binsImag); // 1025 bins
+ * </pre>
+ *
+ * @since 0.3.1-beta
+ * @author Theko
+ *
+ * @see FFT
+ */
+public final class FFTPlan {
+
+    private static final Map<Integer, FFTPlan> PLANS = new ConcurrentHashMap<>();
+
+    private final int size;
+    private final int logSize;
+
+    /** Index pairs to swap for the bit-reversal permutation, [i0, j0, i1, j1, ...]. */
+    private final int[] swaps;
+
+    /** w^k = exp(-2&pi;ik / size) for k &lt; size / 2. */
+    private final float[] twiddleReal;
+    private final float[] twiddleImag;
+
+    /** Half-size plan and post-processing twiddles of the real transform, null for sizes below 4. */
+    private final FFTPlan half;
+    private final float[] realTwiddleReal;
+    private final float[] realTwiddleImag;
+
+    private FFTPlan(int size) {
+        this.size = size;
+        this.logSize = Integer.numberOfTrailingZeros(size);
+
+        int swapCount = 0;
+        int[] pairs = new int[size];
+        for (int i = 0; i < size; i++) {
+            int j = (logSize == 0) ? 0 : Integer.reverse(i) >>> (32 - logSize);
+            if (i < j) {
+                pairs[swapCount++] = i;
+                pairs[swapCount++] = j;
+            }
+        }
+        this.swaps = Arrays.copyOf(pairs, swapCount);
+
+        int halfSize = size / 2;
+        this.twiddleReal = new float[Math.max(1, halfSize)];
+        this.twiddleImag = new float[Math.max(1, halfSize)];
+        for (int k = 0; k < halfSize; k++) {
+            double angle = -2.0 * Math.PI * k / size;
+            twiddleReal[k] = (float) Math.cos(angle);
+            twiddleImag[k] = (float) Math.sin(angle);
+        }
+        twiddleReal[0] = 1.0f;
+
+        if (size >= 4) {
+            this.half = of(halfSize);
+            int quarter = size / 4;
+            this.realTwiddleReal = new float[quarter + 1];
+            this.realTwiddleImag = new float[quarter + 1];
+            for (int k = 0; k <= quarter; k++) {
+                double angle = -2.0 * Math.PI * k / size;
+                realTwiddleReal[k] = (float) Math.cos(angle);
+                realTwiddleImag[k] = (float) Math.sin(angle);
+            }
+        } else {
+            this.half = null;
+            this.realTwiddleReal = null;
+            this.realTwiddleImag = null;
+        }
+    }
+
+    /**
+     * Returns the plan for the given size, creating and caching it on first use.
+     *
+     * @param size The transform size, a power of two
+     * @return The plan
+     * @throws IllegalArgumentException if the size is not a positive power of two
+     */
+    public static FFTPlan of(int size) {
+        if (size <= 0 || Integer.bitCount(size) != 1) {
+            throw new IllegalArgumentException("FFT size must be a positive power of two, got " + size + ".");
+        }
+        FFTPlan plan = PLANS.get(size);
+        if (plan != null) return plan;
+        // Not computeIfAbsent: the constructor recursively creates the half-size plan
+        plan = new FFTPlan(size);
+        FFTPlan existing = PLANS.putIfAbsent(size, plan);
+        return existing != null ? existing : plan;
+    }
+
+    /**
+     * Returns the transform size.
+     *
+     * @return The size, in complex points (or real samples for {@link #forwardReal})
+     */
+    public int getSize() {
+        return size;
+    }
+
+    /**
+     * Computes the forward complex FFT in place.
+     *
+     * @param real The real parts, at least {@code size} long
+     * @param imag The imaginary parts, at least {@code size} long
+     * @throws IllegalArgumentException if an array is shorter than the plan size
+     */
+    public void forward(float[] real, float[] imag) {
+        checkLength(real, size);
+        checkLength(imag, size);
+        transform(real, imag);
+    }
+
+    /**
+     * Computes the inverse complex FFT in place, scaled by {@code 1 / size}.
+     *
+     * @param real The real parts, at least {@code size} long
+     * @param imag The imaginary parts, at least {@code size} long
+     * @throws IllegalArgumentException if an array is shorter than the plan size
+     */
+    public void inverse(float[] real, float[] imag) {
+        checkLength(real, size);
+        checkLength(imag, size);
+        // ifft(x) = conj(fft(conj(x))) / n
+        for (int i = 0; i < size; i++) imag[i] = -imag[i];
+        transform(real, imag);
+        float scale = 1.0f / size;
+        for (int i = 0; i < size; i++) {
+            real[i] *= scale;
+            imag[i] = -imag[i] * scale;
+        }
+    }
+
+    /**
+     * Computes the spectrum of a real signal.
+     * Writes bins {@code 0..size / 2}, the rest of the spectrum is their complex conjugate.
+     * The imaginary parts of bin 0 and bin {@code size / 2} are zero.
+     *
+     * @param input The real signal, at least {@code size} samples, not modified
+     * @param outReal The real parts of the bins, at least {@code size / 2 + 1} long
+     * @param outImag The imaginary parts of the bins, at least {@code size / 2 + 1} long
+     * @throws IllegalArgumentException if an array is too short
+     */
+    public void forwardReal(float[] input, float[] outReal, float[] outImag) {
+        checkLength(input, size);
+        checkLength(outReal, size / 2 + 1);
+        checkLength(outImag, size / 2 + 1);
+
+        if (half == null) {
+            // Sizes 1 and 2
+            float x0 = input[0];
+            float x1 = size == 2 ? input[1] : 0.0f;
+            outReal[0] = x0 + x1;
+            outImag[0] = 0.0f;
+            if (size == 2) {
+                outReal[1] = x0 - x1;
+                outImag[1] = 0.0f;
+            }
+            return;
+        }
+
+        // Pack even samples as real and odd samples as imaginary parts
+        int m = size / 2;
+        for (int i = 0; i < m; i++) {
+            outReal[i] = input[2 * i];
+            outImag[i] = input[2 * i + 1];
+        }
+        half.transform(outReal, outImag);
+
+        // Split the half-size spectrum Z into the real spectrum X:
+        // X[k] = E + W^k * O, X[m - k] = conj(E - W^k * O), with
+        // E = (Z[k] + conj(Z[m - k])) / 2, O = (Z[k] - conj(Z[m - k])) / 2i
+        float z0r = outReal[0], z0i = outImag[0];
+        outReal[0] = z0r + z0i;
+        outImag[0] = 0.0f;
+        outReal[m] = z0r - z0i;
+        outImag[m] = 0.0f;
+
+        for (int k = 1; k < (m + 1) / 2; k++) {
+            int j = m - k;
+            float ar = outReal[k], ai = outImag[k];
+            float cr = outReal[j], ci = outImag[j];
+
+            float er = 0.5f * (ar + cr);
+            float ei = 0.5f * (ai - ci);
+            float or = 0.5f * (ai + ci);
+            float oi = -0.5f * (ar - cr);
+
+            float wr = realTwiddleReal[k], wi = realTwiddleImag[k];
+            float tr = wr * or - wi * oi;
+            float ti = wr * oi + wi * or;
+
+            outReal[k] = er + tr;
+            outImag[k] = ei + ti;
+            outReal[j] = er - tr;
+            outImag[j] = -(ei - ti);
+        }
+        if (m >= 2) {
+            // The middle bin pairs with itself: X[m / 2] = conj(Z[m / 2])
+            outImag[m / 2] = -outImag[m / 2];
+        }
+    }
+
+    private void transform(float[] real, float[] imag) {
+        if (size == 1) return;
+
+        final int[] swaps = this.swaps;
+        for (int s = 0; s < swaps.length; s += 2) {
+            int i = swaps[s], j = swaps[s + 1];
+            float tr = real[i]; real[i] = real[j]; real[j] = tr;
+            float ti = imag[i]; imag[i] = imag[j]; imag[j] = ti;
+        }
+
+        int h = 1;
+        if ((logSize & 1) != 0) {
+            // Odd number of stages: one radix-2 pass with trivial twiddles
+            for (int i = 0; i < size; i += 2) {
+                float br = real[i + 1], bi = imag[i + 1];
+                real[i + 1] = real[i] - br;
+                imag[i + 1] = imag[i] - bi;
+                real[i] += br;
+                imag[i] += bi;
+            }
+            h = 2;
+        }
+        for (; h < size; h *= 4) {
+            radix22Pass(real, imag, h);
+        }
+    }
+
+    /**
+     * Runs the radix-2 stages with half sizes {@code h} and {@code 2h} in one pass,
+     * as 4-point butterflies over blocks of {@code 4h} points.
+     */
+    private void radix22Pass(float[] real, float[] imag, int h) {
+        final float[] twr = twiddleReal;
+        final float[] twi = twiddleImag;
+        final int stride1 = size / (2 * h); // w_{2h}^j = w^{j * stride1}
+        final int stride2 = stride1 / 2;    // w_{4h}^j = w^{j * stride2}
+        final int block = 4 * h;
+
+        for (int start = 0; start < size; start += block) {
+            for (int j = 0; j < h; j++) {
+                int i0 = start + j, i1 = i0 + h, i2 = i1 + h, i3 = i2 + h;
+
+                float w1r = twr[j * stride1], w1i = twi[j * stride1];
+                float w2r = twr[j * stride2], w2i = twi[j * stride2];
+
+                // First stage: (i0, i1) and (i2, i3) with w_{2h}^j
+                float t1r = w1r * real[i1] - w1i * imag[i1];
+                float t1i = w1r * imag[i1] + w1i * real[i1];
+                float t3r = w1r * real[i3] - w1i * imag[i3];
+                float t3i = w1r * imag[i3] + w1i * real[i3];
+
+                float a0r = real[i0] + t1r, a0i = imag[i0] + t1i;
+                float a1r = real[i0] - t1r, a1i = imag[i0] - t1i;
+                float a2r = real[i2] + t3r, a2i = imag[i2] + t3i;
+                float a3r = real[i2] - t3r, a3i = imag[i2] - t3i;
+
+                // Second stage: (i0, i2) with w_{4h}^j, (i1, i3) with w_{4h}^{j + h} = -i * w_{4h}^j
+                float u2r = w2r * a2r - w2i * a2i;
+                float u2i = w2r * a2i + w2i * a2r;
+                float v3r = w2r * a3r - w2i * a3i;
+                float v3i = w2r * a3i + w2i * a3r;
+                float u3r = v3i, u3i = -v3r;
+
+                real[i0] = a0r + u2r; imag[i0] = a0i + u2i;
+                real[i2] = a0r - u2r; imag[i2] = a0i - u2i;
+                real[i1] = a1r + u3r; imag[i1] = a1i + u3i;
+                real[i3] = a1r - u3r; imag[i3] = a1i - u3i;
+            }
+        }
+    }
+
+    private static void checkLength(float[] array, int length) {
+        if (array == null || array.length < length) {
+            throw new IllegalArgumentException("Array must hold at least " + length + " values.");
+        }
+    }
+}
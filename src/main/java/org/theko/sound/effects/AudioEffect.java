@@ -17,17 +17,21 @@
 package org.theko.sound.effects;
 
 import java.util.ArrayList;
+import java.util.Arrays;
 import java.util.Collections;
 import java.util.List;
 import java.util.Objects;
 
 import org.theko.sound.AudioNode;
+import org.theko.sound.BlockModulator;
 import org.theko.sound.LengthMismatchException;
 import org.theko.sound.controls.AudioControl;
 import org.theko.sound.controls.BooleanControl;
 import org.theko.sound.controls.Controllable;
 import org.theko.sound.controls.FloatControl;
 import org.theko.sound.samples.SamplesValidation;
+import org.theko.sound.util.AudioBufferPool;
+import org.theko.sound.util.AudioBufferUtilities;
 
 /**
  * AudioEffect is an abstract class representing an audio effect that can be applied to audio samples.
@@ -65,6 +69,11 @@ public abstract class AudioEffect implements AudioNode, Controllable {
      */
     private final List<AudioControl> allControls = new ArrayList<>(mixingControls);
 
+    /**
+     * The modulators evaluated before each rendered block, replaced on change.
+     */
+    private volatile BlockModulator[] modulators = new BlockModulator[0];
+
     /**
      * The type of audio effect, which can be either REALTIME or OFFLINE_PROCESSING.
      */
@@ -126,6 +135,7 @@ public abstract class AudioEffect implements AudioNode, Controllable {
             throw new RuntimeException(new LengthMismatchException("Samples length must be the same for all channels."));
         }
 
+        renderModulators(samples[0].length, sampleRate);
         effectRender(samples, sampleRate);
     }
 
@@ -133,13 +143,15 @@ public abstract class AudioEffect implements AudioNode, Controllable {
      * Renders the audio effect on the given samples.
      * <p>
      * If the effect is disabled or the mix level is 0.0, the samples will not be processed.
+     * The modulators of the effect still advance by the block.
      * <p>
      * If the sample rate is not positive, an IllegalArgumentException will be thrown.
      * <p>
      * If the samples have different lengths, a RuntimeException with a LengthMismatchException will be thrown.
      * <p>
      * If the effect should be mixed with the original samples (i.e. the mix level is less than 1.0), then
-     * a copy of the input samples will be created and the effect will be applied on the copy.
+     * the effect will be applied on a copy of the input samples, borrowed from the {@link AudioBufferPool}
+     * of the rendering thread.
      * The effect buffer will then be mixed back with the original samples.
      * <p>
      * The effectRender method will be called with the effect buffer and the sample rate.
@@ -149,11 +161,6 @@ public abstract class AudioEffect implements AudioNode, Controllable {
      * @throws RuntimeException If the samples have different lengths, with a LengthMismatchException as the cause
      */
     public final void renderWithMixing(float[][] samples, int sampleRate) {
-        if (!enable.getValue() || mixLevel.getValue() <= 0.0f) {
-            return; // Effect is disabled, do not process samples
-        }
-        boolean shouldMix = mixLevel.getValue() < 1.0f;
-
         if (sampleRate <= 0) {
             throw new IllegalArgumentException("Sample rate must be positive.");
         }
@@ -164,24 +171,96 @@ public abstract class AudioEffect implements AudioNode, Controllable {
             throw new RuntimeException(new LengthMismatchException("Samples length must be the same for all channels."));
         }
 
-        float[][] effectBuffer = samples;
-        if (shouldMix) {
-            // Create a copy of the input samples to apply the effect on, so we can mix it back with the original samples later
-            effectBuffer = new float[samples.length][];
-            for (int ch = 0; ch < samples.length; ch++) {
-                effectBuffer[ch] = new float[samples[ch].length];
-                System.arraycopy(samples[ch], 0, effectBuffer[ch], 0, samples[ch].length);
-            }
+        int length = samples[0].length;
+        renderModulators(length, sampleRate);
+
+        // A ramping mix level is applied per sample, it may start or end above 0.0
+        boolean mixRamping = mixLevel.isRamping();
+        if (!enable.getValue() || (mixLevel.getValue() <= 0.0f && !mixRamping)) {
+            return; // Effect is disabled, do not process samples
         }
-        effectRender(effectBuffer, sampleRate);
-        if (shouldMix) {
+        boolean shouldMix = mixRamping || mixLevel.getValue() < 1.0f;
+
+        if (!shouldMix) {
+            effectRender(samples, sampleRate);
+            return;
+        }
+
+        // Apply the effect on a pooled copy of the input samples, so we can mix it back with the original samples later
+        AudioBufferPool pool = AudioBufferPool.current();
+        float[][] effectBuffer = pool.borrow(samples.length, length);
+        try {
+            AudioBufferUtilities.copyArray(samples, effectBuffer);
+            effectRender(effectBuffer, sampleRate);
+
             // Mix the effect buffer back with the original samples
             float mixLevelValue = mixLevel.getValue();
             for (int ch = 0; ch < samples.length; ch++) {
-                for (int i = 0; i < samples[ch].length; i++) {
+                for (int i = 0; i < length; i++) {
+                    if (mixRamping) mixLevelValue = mixLevel.getValueAt(i, length);
                     samples[ch][i] = (samples[ch][i] * (1.0f - mixLevelValue)) + (effectBuffer[ch][i] * mixLevelValue);
                 }
             }
+        } finally {
+            pool.release(effectBuffer);
+        }
+    }
+
+    /**
+     * Adds a modulator that is evaluated by this effect once per rendered block, on the render thread.
+     * The modulator becomes render-synchronous and stops using the automation thread pool.
+     * Effects read sample-accurate values of ramping controls with {@link FloatControl#getValueAt(int, int)}.
+     *
+     * @param modulator The modulator, such as an {@link org.theko.sound.Automation} or {@link org.theko.sound.LFO}
+     * @throws IllegalArgumentException if the modulator is null or already hosted by an effect
+     */
+    public synchronized void addModulator(BlockModulator modulator) {
+        if (modulator == null) {
+            throw new IllegalArgumentException("Modulator cannot be null.");
+        }
+        if (modulator.isRenderSynchronous()) {
+            throw new IllegalArgumentException("Modulator is already hosted by an effect.");
+        }
+        modulator.setRenderSynchronous(true);
+        BlockModulator[] updated = Arrays.copyOf(modulators, modulators.length + 1);
+        updated[modulators.length] = modulator;
+        modulators = updated;
+    }
+
+    /**
+     * Removes a modulator from this effect, it continues on the automation thread pool if playing.
+     *
+     * @param modulator The modulator to remove
+     * @return true if the modulator was hosted by this effect
+     */
+    public synchronized boolean removeModulator(BlockModulator modulator) {
+        for (int i = 0; i < modulators.length; i++) {
+            if (modulators[i] == modulator) {
+                BlockModulator[] updated = new BlockModulator[modulators.length - 1];
+                System.arraycopy(modulators, 0, updated, 0, i);
+                System.arraycopy(modulators, i + 1, updated, i, modulators.length - i - 1);
+                modulators = updated;
+                modulator.setRenderSynchronous(false);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Returns the modulators evaluated by this effect.
+     *
+     * @return An unmodifiable list of the modulators
+     */
+    public List<BlockModulator> getModulators() {
+        return List.of(modulators);
+    }
+
+    private void renderModulators(int frames, int sampleRate) {
+        // Copy-on-write array, iterated without allocation
+        BlockModulator[] current = modulators;
+        for (BlockModulator modulator : current) {
+            modulator.renderBlock(frames, sampleRate);
         }
     }
 
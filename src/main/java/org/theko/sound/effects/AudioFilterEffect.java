@@ -23,6 +23,7 @@ import org.theko.sound.controls.FloatControl;
 import org.theko.sound.dsp.ChannelSplittedFilter;
 import org.theko.sound.dsp.CutoffAudioFilter;
 import org.theko.sound.dsp.FilterType;
+import org.theko.sound.util.AudioBufferPool;
 
 /**
  * A basic audio filter effect that applies low-pass, high-pass, or band-pass filtering to an audio signal.
@@ -62,6 +63,11 @@ public class AudioFilterEffect<T extends CutoffAudioFilter> extends AudioEffect
 
     private int lastChannels = -1;
 
+    // Changed after the filters are recreated, so their cutoff is forwarded again
+    private volatile int filtersGeneration;
+    // Cutoff version and filters generation last forwarded to the filters
+    private int cutoffVersion, syncedGeneration = -1;
+
     /**
      * Creates a new instance of the {@link AudioFilterEffect} class.
      */
@@ -72,13 +78,6 @@ public class AudioFilterEffect<T extends CutoffAudioFilter> extends AudioEffect
 
         createNewFilters(2 /* default channels */);
 
-        cutoff.addConsumer((event, type) -> {
-            synchronized (this) {
-                lowPassFilter.getFilters().forEach(filter -> filter.setCutoffValue(cutoff.getValue()));
-                bandPassFilter.getFilters().forEach(filter -> filter.setCutoffValue(cutoff.getValue()));
-                highPassFilter.getFilters().forEach(filter -> filter.setCutoffValue(cutoff.getValue()));
-            }
-        });
         passes.addConsumer((event, type) -> {
             synchronized (this) {
                 createNewFilters(lastChannels);
@@ -147,18 +146,58 @@ public class AudioFilterEffect<T extends CutoffAudioFilter> extends AudioEffect
             }
             lastChannels = samples.length;
         }
-        for (int ch = 0; ch < samples.length; ch++) {
-            for (int i = 0; i < samples[ch].length; i++) {
-                float input = samples[ch][i];
-                float low = lowPassFilter.process(input, ch, sampleRate);
-                float high = highPassFilter.process(input, ch, sampleRate);
-                float band = bandPassFilter.process(input, ch, sampleRate);
-
-                float mixed = low * lowPass.getValue()
-                            + high * highPass.getValue()
-                            + band * bandPass.getValue();
-                samples[ch][i] = mixed;
+
+        // The filters may be recreated by a control change while rendering,
+        // the generation is read first so a partly recreated set is synced again
+        int generation = filtersGeneration;
+        ChannelSplittedFilter<T> lowFilter = lowPassFilter;
+        ChannelSplittedFilter<T> highFilter = highPassFilter;
+        ChannelSplittedFilter<T> bandFilter = bandPassFilter;
+
+        // Polled rather than listened to, so the block ramps of render-synchronous modulators apply too
+        int cutoffNow = cutoff.getVersion();
+        if (cutoffNow != cutoffVersion || generation != syncedGeneration) {
+            cutoffVersion = cutoffNow;
+            syncedGeneration = generation;
+            forwardCutoff(lowFilter);
+            forwardCutoff(highFilter);
+            forwardCutoff(bandFilter);
+        }
+
+        // Each band filters the whole block, then the bands are mixed
+        AudioBufferPool pool = AudioBufferPool.current();
+        int channels = samples.length;
+        int length = samples[0].length;
+        float[][] low = pool.borrow(channels, length);
+        float[][] high = pool.borrow(channels, length);
+        float[][] band = pool.borrow(channels, length);
+        try {
+            lowFilter.process(samples, low, sampleRate);
+            highFilter.process(samples, high, sampleRate);
+            bandFilter.process(samples, band, sampleRate);
+
+            float lowMix = lowPass.getValue();
+            float highMix = highPass.getValue();
+            float bandMix = bandPass.getValue();
+            for (int ch = 0; ch < channels; ch++) {
+                float[] out = samples[ch];
+                float[] l = low[ch], h = high[ch], b = band[ch];
+                for (int i = 0; i < length; i++) {
+                    out[i] = l[i] * lowMix + h[i] * highMix + b[i] * bandMix;
+                }
             }
+        } finally {
+            pool.release(low);
+            pool.release(high);
+            pool.release(band);
+        }
+    }
+
+    private void forwardCutoff(ChannelSplittedFilter<T> filter) {
+        float start = cutoff.getValueAt(0, 1);
+        float end = cutoff.getValue();
+        for (int ch = 0; ch < filter.getChannelCount(); ch++) {
+            filter.getFilter(ch).getCutoff().setBlockRamp(start, end);
         }
     }
 
@@ -187,6 +226,7 @@ public class AudioFilterEffect<T extends CutoffAudioFilter> extends AudioEffect
         } catch (ReflectiveOperationException e) {
             throw new RuntimeException(e);
         }
+        filtersGeneration++;
     }
 
     public ChannelSplittedFilter<T> getLowPassFilter() {
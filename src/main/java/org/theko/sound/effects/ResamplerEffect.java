@@ -18,9 +18,13 @@ package org.theko.sound.effects;
 
 import static org.theko.sound.properties.AudioSystemProperties.RESAMPLER_EFFECT;
 
+import java.util.Arrays;
+
 import org.theko.sound.controls.FloatControl;
 import org.theko.sound.resamplers.ResamplingProcessor;
 import org.theko.sound.resamplers.Resampler;
+import org.theko.sound.util.AudioBufferPool;
+import org.theko.sound.util.MathUtilities;
 
 /**
  * ResamplerEffect is an audio effect that allows for real-time resampling of audio samples.
@@ -68,18 +72,22 @@ public class ResamplerEffect extends AudioEffect implements VaryingSizeEffect {
             return;
         }
 
-        float[][] resampled = resampler.resample(samples, speedControl.getValue());
+        int sourceLength = samples[0].length;
+        int newLength = MathUtilities.clamp((int) (sourceLength / speedControl.getValue()), 1, sourceLength * 50);
 
-        int channels = Math.min(samples.length, resampled.length);
-        for (int ch = 0; ch < channels; ch++) {
-            int minCopy = Math.min(samples[ch].length, resampled[ch].length);
-            for (int i = 0; i < minCopy; i++) {
-                samples[ch][i] = resampled[ch][i];
-            }
-            // Zero out the rest if output is shorter than buffer
-            for (int i = minCopy; i < samples[ch].length; i++) {
-                samples[ch][i] = 0.0f;
+        AudioBufferPool pool = AudioBufferPool.current();
+        float[][] resampled = pool.borrow(samples.length, newLength);
+        try {
+            resampler.resample(samples, resampled, newLength);
+
+            for (int ch = 0; ch < samples.length; ch++) {
+                int minCopy = Math.min(samples[ch].length, newLength);
+                System.arraycopy(resampled[ch], 0, samples[ch], 0, minCopy);
+                // Zero out the rest if output is shorter than buffer
+                Arrays.fill(samples[ch], minCopy, samples[ch].length, 0.0f);
             }
+        } finally {
+            pool.release(resampled);
         }
     }
 
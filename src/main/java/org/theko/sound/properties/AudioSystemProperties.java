@@ -25,6 +25,7 @@ import org.slf4j.Logger;
 import org.slf4j.LoggerFactory;
 import org.theko.sound.AudioMeasure;
 import org.theko.sound.resamplers.LinearResampler;
+import org.theko.sound.resamplers.PolyphaseResampler;
 import org.theko.sound.resamplers.Resampler;
 import org.theko.sound.util.FormatUtilities;
 import org.theko.sound.util.MathUtilities;
@@ -245,7 +246,7 @@ public final class AudioSystemProperties {
             Class<?> clazz;
             try {
                 // search in default resamplers package
-                clazz = Class.forName("org.theko.sound.resampling." + resampleMethodStr);
+                clazz = Class.forName("org.theko.sound.resamplers." + resampleMethodStr);
             } catch (ClassNotFoundException e) {
                 // if not found, search for full class
                 clazz = Class.forName(resampleMethodStr);
@@ -279,6 +280,19 @@ public final class AudioSystemProperties {
     public static final boolean BACKENDS_REQUIRE_DUPLEX_SELECT = getBoolean("org.theko.sound.backends.requireDuplexSelect",
         false /* allow different backends for input and output */);
 
+    public static final boolean BACKENDS_NATIVE_ASYNC_LOGGING = getBoolean(
+        "org.theko.sound.backends.nativeAsyncLogging", true);
+
+    public static final int BACKENDS_NATIVE_LOG_DRAIN_INTERVAL = getIntInRange(
+        "org.theko.sound.backends.nativeLogDrainInterval", 1, 1000,
+        false /* use default when out of range */, 20);
+
+    public static final boolean BACKENDS_NATIVE_KERNELS = getBoolean(
+        "org.theko.sound.backends.nativeKernels", true /* use SIMD kernels of a loaded native library */);
+
+    public static final boolean BACKENDS_WASAPI_EXCLUSIVE_FALLBACK = getBoolean(
+        "org.theko.sound.backends.wasapiExclusiveFallback", true /* open in shared mode if exclusive fails */);
+
     // Output Layer
     public static final ThreadConfiguration AOL_PLAYBACK_THREAD = getThreadConfig(
         "org.theko.sound.outputLayer.thread", new ThreadConfiguration(ThreadType.PLATFORM, 7));
@@ -306,12 +320,28 @@ public final class AudioSystemProperties {
     public static final AudioMeasure AOL_DEFAULT_BUFFER = getAudioMeasure(
         "org.theko.sound.outputLayer.defaultBuffer", AudioMeasure.ofFrames(2048));
 
+    public static final int AOL_RENDER_AHEAD = getIntInRange(
+        "org.theko.sound.outputLayer.renderAhead", 1, 16,
+        false /* use default when out of range */, 1);
+
     public static final Resampler AOL_RESAMPLER = getResampleMethod(
-        "org.theko.sound.outputLayer.resampler", new LinearResampler());
+        "org.theko.sound.outputLayer.resampler", new PolyphaseResampler());
 
     public static final boolean AOL_ENABLE_SHUTDOWN_HOOK = getBoolean(
         "org.theko.sound.outputLayer.enableShutdownHook", true);
 
+    public static final boolean AOL_PULL_MODE = getBoolean(
+        "org.theko.sound.outputLayer.pullMode", false /* use own playback thread */);
+
+    public static final boolean AOL_LOW_LATENCY = getBoolean(
+        "org.theko.sound.outputLayer.lowLatency", false /* default device period */);
+
+    public static final boolean AOL_SHARED_SESSION = getBoolean(
+        "org.theko.sound.outputLayer.sharedSession", false /* own device stream per layer */);
+
+    public static final boolean AOL_ENGINE_CONVERSION = getBoolean(
+        "org.theko.sound.outputLayer.engineConversion", false /* convert in the output layer */);
+
     // Resampler
     public static final Resampler SHARED_RESAMPLER = getResampleMethod(
         "org.theko.sound.resampler.shared", new LinearResampler());
@@ -329,6 +359,12 @@ public final class AudioSystemProperties {
     public static final boolean MIXER_DEFAULT_REVERSE_POLARITY = getBoolean(
         "org.theko.sound.mixer.default.reversePolarity", false);
 
+    public static final boolean MIXER_DEFAULT_PARALLEL_RENDER = getBoolean(
+        "org.theko.sound.mixer.default.parallelRender", false /* render inputs on the calling thread */);
+
+    public static final int MIXER_RENDER_THREADS = getIntInRange(
+        "org.theko.sound.mixer.renderThreads", 1, CPU_AVAILABLE_CORES*4, true, Math.max(1, CPU_AVAILABLE_CORES - 1));
+
     // Codec
     public static final boolean WAVE_CODEC_CLEAN_TAG_TEXT = getBoolean(
         "org.theko.sound.codecs.wave.cleanTagText", true);
@@ -336,6 +372,14 @@ public final class AudioSystemProperties {
     public static final boolean LOG_METADATA = getBoolean(
         "org.theko.sound.codecs.log.metadata", true);
 
+    public static final int CODECS_STREAMING_THRESHOLD = getIntInRange(
+        "org.theko.sound.codecs.streamingThreshold", -1, Integer.MAX_VALUE,
+        false /* MiB, -1 never streams */, 32);
+
+    public static final int CODECS_CACHE_SIZE = getIntInRange(
+        "org.theko.sound.codecs.cacheSize", 0, 1024 * 1024,
+        false /* MiB of decoded samples, 0 disables the cache */, 0);
+
     // Misc
     public static final int AUTOMATIONS_THREADS = getIntInRange(
         "org.theko.sound.automation.threads", 1, CPU_AVAILABLE_CORES*4, true, CPU_AVAILABLE_CORES);
@@ -389,38 +433,59 @@ public final class AudioSystemProperties {
             logger.info(
                 "Audio system properties:\n" +
                 "  Backends require duplex select: {}\n" +
+                "  Backends native async logging: {}, drain interval: {} ms\n" +
+                "  Backends native audio kernels: {}\n" +
+                "  Backends WASAPI exclusive fallback to shared: {}\n" +
                 "  OutputLayer playback thread: {}\n" +
-                "  OutputLayer default buffer: {}\n" +
+                "  OutputLayer default buffer: {}, render ahead: {} buffers\n" +
                 "  OutputLayer resampler: {}\n" +
                 "  OutputLayer playback thread stop timeout: {} ms\n" +
                 "  OutputLayer max length mismatches: {}, reset after valid render: {}\n" +
                 "  OutputLayer max write errors: {}, reset after successful write: {}\n" +
                 "  OutputLayer ignore playback exceptions: {}\n" +
                 "  OutputLayer shutdown hook enabled: {}\n" +
+                "  OutputLayer pull mode: {}\n" +
+                "  OutputLayer low latency: {}\n" +
+                "  OutputLayer shared session: {}\n" +
+                "  OutputLayer engine conversion: {}\n" +
                 "  Resampler (Shared): {}\n" +
                 "  Resampler (Effect, default): {}\n" +
-                "  Mixer (default): Enable effects: {}, Swap channels: {}, Reverse polarity: {}\n" +
+                "  Mixer (default): Enable effects: {}, Swap channels: {}, Reverse polarity: {}, Parallel render: {}\n" +
+                "  Mixer render threads: {}\n" +
                 "  Log metadata in codecs: {}\n" +
                 "  Wave codec clean metadata text: {}\n" +
+                "  Codecs streaming threshold: {} MiB\n" +
+                "  Codecs decode cache size: {} MiB\n" +
                 "  Automation threads: {}\n" +
                 "  Automation thread pool shutdown timeout: {}\n" +
                 "  Automation update time: {} ms",
                 BACKENDS_REQUIRE_DUPLEX_SELECT,
+                BACKENDS_NATIVE_ASYNC_LOGGING, BACKENDS_NATIVE_LOG_DRAIN_INTERVAL,
+                BACKENDS_NATIVE_KERNELS,
+                BACKENDS_WASAPI_EXCLUSIVE_FALLBACK,
                 FormatUtilities.formatThreadInfo(AOL_PLAYBACK_THREAD),
-                AOL_DEFAULT_BUFFER,
+                AOL_DEFAULT_BUFFER, AOL_RENDER_AHEAD,
                 AOL_RESAMPLER,
                 AOL_PLAYBACK_STOP_TIMEOUT.toString(),
                 AOL_MAX_LENGTH_MISMATCHES, AOL_RESET_LENGTH_MISMATCHES,
                 AOL_MAX_WRITE_ERRORS, AOL_RESET_WRITE_ERRORS,
                 AOL_IGNORE_PLAYBACK_EXCEPTIONS,
                 AOL_ENABLE_SHUTDOWN_HOOK,
+                AOL_PULL_MODE,
+                AOL_LOW_LATENCY,
+                AOL_SHARED_SESSION,
+                AOL_ENGINE_CONVERSION,
                 SHARED_RESAMPLER,
                 RESAMPLER_EFFECT,
                 MIXER_DEFAULT_ENABLE_EFFECTS,
                 MIXER_DEFAULT_SWAP_CHANNELS,
                 MIXER_DEFAULT_REVERSE_POLARITY,
+                MIXER_DEFAULT_PARALLEL_RENDER,
+                MIXER_RENDER_THREADS,
                 LOG_METADATA,
                 WAVE_CODEC_CLEAN_TAG_TEXT,
+                CODECS_STREAMING_THRESHOLD,
+                CODECS_CACHE_SIZE,
                 AUTOMATIONS_THREADS,
                 AUTOMATIONS_THREAD_POOL_SHUTDOWN_TIMEOUT,
                 AUTOMATIONS_UPDATE_TIME
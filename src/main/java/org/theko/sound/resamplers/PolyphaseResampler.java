@@ -0,0 +1,280 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.theko.sound.resamplers;
+
+import java.util.Arrays;
+
+/**
+ * PolyphaseResampler is a streaming windowed-sinc resampler with a precomputed polyphase filter table.
+ * <p>
+ * The ratio of a block is {@code input length / targetLength}, reduced to a fraction. For fixed
+ * conversions, such as 44.1 kHz to 48 kHz (147/160), the table holds one Kaiser-windowed sinc
+ * filter per exact output phase, so producing a sample is a single inner product. Ratios with too
+ * many phases use a 256-phase table and interpolate between the two nearest phases.
+ * The table is rebuilt only when the ratio changes. When downsampling, the cutoff follows
+ * the target Nyquist frequency and the filter gets longer accordingly.
+ * <p>
+ * Consecutive calls are consecutive blocks of one stream (see {@link StreamingResampler}),
+ * the output is delayed by half the filter length. Equal input and target lengths are copied through.
+ *
+ * @since 0.3.1-beta
+ * @author Theko
+ */
+public class PolyphaseResampler implements StreamingResampler {
+
+    private static final int MAX_HALF_TAPS = 128;
+    private static final int HISTORY = 2 * MAX_HALF_TAPS - 1;
+
+    private static final int MAX_EXACT_PHASES = 1024;
+    private static final int MAX_TABLE_SIZE = 65536;
+    private static final int INTERPOLATED_PHASES = 256;
+
+    /** Passband edge, relative to the lower Nyquist frequency. */
+    private static final double ROLLOFF = 0.94;
+    private static final double KAISER_BETA = 8.0;
+
+    /** Half of the filter length at unity ratio, in input samples. */
+    private final int zeroCrossings;
+
+    // Filter for the current ratio, step = ratioIn / ratioOut
+    private long ratioIn = 0;
+    private long ratioOut = 0;
+    private int taps;
+    private int phases;
+    private boolean exactPhases;
+    private float[] table;
+
+    // Stream state
+    private float[][] work; // [channel][HISTORY + block]
+    private long position = 0; // integer read position, relative to the block start
+    private long phaseAcc = 0; // fractional read position, in units of 1 / ratioOut
+
+    /**
+     * Constructs a PolyphaseResampler with a specific filter size.
+     *
+     * @param zeroCrossings Zero crossings of the sinc on each side, from 4 to 64.
+     * Higher values give a steeper transition band at a higher CPU load.
+     */
+    public PolyphaseResampler(int zeroCrossings) {
+        if (zeroCrossings < 4 || zeroCrossings > MAX_HALF_TAPS / 2) {
+            throw new IllegalArgumentException("Zero crossings must be in range [4, " + (MAX_HALF_TAPS / 2) + "].");
+        }
+        this.zeroCrossings = zeroCrossings;
+    }
+
+    /**
+     * Constructs a PolyphaseResampler with 16 zero crossings on each side (32 taps at unity ratio).
+     */
+    public PolyphaseResampler() {
+        this(16);
+    }
+
+    @Override
+    public StreamingResampler newStream() {
+        return new PolyphaseResampler(zeroCrossings);
+    }
+
+    @Override
+    public void reset() {
+        position = 0;
+        phaseAcc = 0;
+        if (work != null) {
+            for (float[] channel : work) {
+                Arrays.fill(channel, 0, HISTORY, 0.0f);
+            }
+        }
+    }
+
+    @Override
+    public void resample(float[][] input, float[][] output, int targetLength) {
+        if (input == null || input.length == 0 || targetLength <= 0) return;
+
+        int channels = input.length;
+        int sourceLength = input[0].length;
+        if (sourceLength == 0) return;
+
+        ensureWork(channels, sourceLength);
+        for (int ch = 0; ch < channels; ch++) {
+            System.arraycopy(input[ch], 0, work[ch], HISTORY, sourceLength);
+        }
+
+        if (sourceLength == targetLength) {
+            for (int ch = 0; ch < channels; ch++) {
+                System.arraycopy(input[ch], 0, output[ch], 0, targetLength);
+            }
+        } else {
+            configure(sourceLength, targetLength);
+            filterBlock(output, channels, sourceLength, targetLength);
+        }
+
+        // Keep the tail of the block as history for the next one
+        for (int ch = 0; ch < channels; ch++) {
+            System.arraycopy(work[ch], sourceLength, work[ch], 0, HISTORY);
+        }
+    }
+
+    private void filterBlock(float[][] output, int channels, int sourceLength, int targetLength) {
+        final float[] table = this.table;
+        final int taps = this.taps;
+        final int offset = HISTORY - (taps - 1);
+        final long ratioIn = this.ratioIn;
+        final long ratioOut = this.ratioOut;
+        final long whole = ratioIn / ratioOut;
+        final long rest = ratioIn % ratioOut;
+
+        long pos = 0;
+        long acc = 0;
+        for (int ch = 0; ch < channels; ch++) {
+            float[] x = work[ch];
+            float[] out = output[ch];
+            pos = position;
+            acc = phaseAcc;
+
+            for (int i = 0; i < targetLength; i++) {
+                int start = offset + (int) pos;
+                if (exactPhases) {
+                    out[i] = dot(x, start, table, (int) acc * taps, taps);
+                } else {
+                    double phase = (double) acc * phases / ratioOut;
+                    int row = (int) phase;
+                    float mix = (float) (phase - row);
+                    float a = dot(x, start, table, row * taps, taps);
+                    float b = dot(x, start, table, (row + 1) * taps, taps);
+                    out[i] = a + (b - a) * mix;
+                }
+
+                pos += whole;
+                acc += rest;
+                if (acc >= ratioOut) {
+                    acc -= ratioOut;
+                    pos++;
+                }
+            }
+        }
+        // After targetLength steps the position advanced by exactly the block length
+        position = pos - sourceLength;
+        phaseAcc = acc;
+    }
+
+    /**
+     * Computes the inner product with 4 independent accumulators, taps are a multiple of 4.
+     */
+    private static float dot(float[] x, int xOffset, float[] h, int hOffset, int length) {
+        float s0 = 0.0f, s1 = 0.0f, s2 = 0.0f, s3 = 0.0f;
+        for (int i = 0; i < length; i += 4) {
+            s0 += x[xOffset + i] * h[hOffset + i];
+            s1 += x[xOffset + i + 1] * h[hOffset + i + 1];
+            s2 += x[xOffset + i + 2] * h[hOffset + i + 2];
+            s3 += x[xOffset + i + 3] * h[hOffset + i + 3];
+        }
+        return (s0 + s1) + (s2 + s3);
+    }
+
+    private void ensureWork(int channels, int sourceLength) {
+        if (work == null || work.length != channels) {
+            work = new float[channels][HISTORY + sourceLength];
+            position = 0;
+            phaseAcc = 0;
+        } else if (work[0].length < HISTORY + sourceLength) {
+            for (int ch = 0; ch < channels; ch++) {
+                work[ch] = Arrays.copyOf(work[ch], HISTORY + sourceLength);
+            }
+        }
+    }
+
+    private void configure(int sourceLength, int targetLength) {
+        long gcd = gcd(sourceLength, targetLength);
+        long in = sourceLength / gcd;
+        long out = targetLength / gcd;
+        if (in == ratioIn && out == ratioOut) return;
+
+        // A new ratio restarts the read position, the history is kept
+        ratioIn = in;
+        ratioOut = out;
+        position = 0;
+        phaseAcc = 0;
+
+        double step = (double) in / out;
+        double cutoff = ROLLOFF / Math.max(1.0, step);
+        int halfTaps = (int) Math.min(MAX_HALF_TAPS, Math.ceil(zeroCrossings * Math.max(1.0, step)));
+        halfTaps = (halfTaps + 1) & ~1; // taps are a multiple of 4
+        taps = 2 * halfTaps;
+
+        exactPhases = out <= MAX_EXACT_PHASES && out * taps <= MAX_TABLE_SIZE;
+        phases = exactPhases ? (int) out : INTERPOLATED_PHASES;
+        int rows = exactPhases ? phases : phases + 1;
+        table = buildTable(rows, phases, halfTaps, cutoff);
+    }
+
+    /**
+     * Builds the filter rows, row {@code r} interpolates at the fraction {@code r / phases}
+     * past the newest sample of its window (delayed by {@code halfTaps}). Each row is normalized to unity gain.
+     */
+    private static float[] buildTable(int rows, int phases, int halfTaps, double cutoff) {
+        int taps = 2 * halfTaps;
+        float[] table = new float[rows * taps];
+        double i0Beta = besselI0(KAISER_BETA);
+        double[] row = new double[taps];
+
+        for (int r = 0; r < rows; r++) {
+            double frac = (double) r / phases;
+            double sum = 0.0;
+            for (int m = 0; m < taps; m++) {
+                double d = m + 1 - halfTaps - frac;
+                double w = d / halfTaps;
+                double window = (Math.abs(w) >= 1.0) ? 0.0 : besselI0(KAISER_BETA * Math.sqrt(1.0 - w * w)) / i0Beta;
+                double value = cutoff * sinc(cutoff * d) * window;
+                row[m] = value;
+                sum += value;
+            }
+            for (int m = 0; m < taps; m++) {
+                table[r * taps + m] = (float) (row[m] / sum);
+            }
+        }
+        return table;
+    }
+
+    private static double sinc(double x) {
+        if (x == 0.0) return 1.0;
+        double pix = Math.PI * x;
+        return Math.sin(pix) / pix;
+    }
+
+    /**
+     * Zeroth order modified Bessel function of the first kind, by its power series.
+     */
+    private static double besselI0(double x) {
+        double sum = 1.0;
+        double term = 1.0;
+        double q = x * x / 4.0;
+        for (int k = 1; k < 64; k++) {
+            term *= q / ((double) k * k);
+            sum += term;
+            if (term < sum * 1e-12) break;
+        }
+        return sum;
+    }
+
+    private static long gcd(long a, long b) {
+        while (b != 0) {
+            long t = a % b;
+            a = b;
+            b = t;
+        }
+        return a;
+    }
+}
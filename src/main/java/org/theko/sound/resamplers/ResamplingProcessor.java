@@ -45,11 +45,14 @@ public class ResamplingProcessor {
 
     /**
      * Constructs an AudioResampler with the specified resample method.
+     * A {@link StreamingResampler} is not shared, the processor uses its own stream of it.
      *
      * @param resamplerMethod The resample method to use for audio resampling
      */
     public ResamplingProcessor(Resampler resamplerMethod) {
-        this.resampleMethod = resamplerMethod;
+        this.resampleMethod = (resamplerMethod instanceof StreamingResampler streaming)
+                ? streaming.newStream()
+                : resamplerMethod;
     }
 
     /**
@@ -69,6 +72,16 @@ public class ResamplingProcessor {
         return resampleMethod.getClass();
     }
 
+    /**
+     * Discards the stream state of a {@link StreamingResampler}, so the next block
+     * does not continue the previous ones. Does nothing for stateless resamplers.
+     */
+    public void reset() {
+        if (resampleMethod instanceof StreamingResampler streaming) {
+            streaming.reset();
+        }
+    }
+
     /**
      * Resamples the given audio samples to a new length.
      *
@@ -0,0 +1,43 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.theko.sound.resamplers;
+
+/**
+ * A {@link Resampler} that treats consecutive calls as consecutive blocks of one stream.
+ * <p>
+ * It keeps the input history and the fractional read position between blocks, so
+ * block boundaries are seamless. Because of that state, an instance must not be shared
+ * between streams: {@link ResamplingProcessor} takes its own instance with {@link #newStream()}.
+ *
+ * @since 0.3.1-beta
+ * @author Theko
+ */
+public interface StreamingResampler extends Resampler {
+
+    /**
+     * Returns a resampler with the same settings and an empty stream state.
+     *
+     * @return A new resampler for another stream
+     */
+    StreamingResampler newStream();
+
+    /**
+     * Discards the input history and the read position, the next block starts a new stream.
+     * Called when the stream is flushed or its format changes.
+     */
+    void reset();
+}
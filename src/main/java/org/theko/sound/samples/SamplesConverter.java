@@ -157,13 +157,64 @@ public final class SamplesConverter {
         }
 
         ByteBuffer buffer = ByteBuffer.wrap(data).order(isBigEndian ? ByteOrder.BIG_ENDIAN : ByteOrder.LITTLE_ENDIAN);
+        decode(buffer, outputSamples, 0, sampleCount, audioFormat);
+    }
+
+    /**
+     * Converts raw PCM data read from a {@link ByteBuffer} into normalized floating-point samples.
+     * Works the same as {@link #toSamples(byte[], float[][], AudioFormat)}, but reads only
+     * {@code frames} frames and allows direct or memory-mapped buffers to be used as the input.
+     *
+     * <p>The data is read starting at the buffer's current position, which is left unchanged.
+     * The samples are written to {@code outputSamples[ch][offset .. offset + frames - 1]}.
+     *
+     * @param inputBuffer buffer holding the raw PCM data, at least {@code frames * frameSize} bytes remaining
+     * @param outputSamples preallocated array of shape [channels][at least offset + frames]
+     * @param offset the first frame index to write in {@code outputSamples}
+     * @param frames the number of frames to convert
+     * @param audioFormat format describing the PCM data (sample size, byte order, etc.)
+     *
+     * @throws IllegalArgumentException if an argument is null, the buffer has not enough bytes remaining,
+     *                                  or the output array is too small
+     *
+     * @since 0.3.1-beta
+     */
+    public static void toSamples(ByteBuffer inputBuffer, float[][] outputSamples, int offset, int frames, AudioFormat audioFormat) {
+        if (inputBuffer == null || audioFormat == null || outputSamples == null) {
+            throw new IllegalArgumentException("Input buffer, audio format, and output samples must not be null.");
+        }
+        if (frames <= 0) {
+            return;
+        }
+
+        int channels = audioFormat.getChannels();
+        int dataLength = frames * channels * audioFormat.getBytesPerSample();
+        if (inputBuffer.remaining() < dataLength) {
+            throw new IllegalArgumentException("Input buffer must have at least " + dataLength + " bytes remaining");
+        }
+        if (offset < 0 || outputSamples.length != channels) {
+            throw new IllegalArgumentException("Output samples array must have 'channels' rows.");
+        }
+        for (int ch = 0; ch < channels; ch++) {
+            if (outputSamples[ch] == null || outputSamples[ch].length < offset + frames) {
+                throw new IllegalArgumentException("Output samples array must have at least 'offset + frames' columns.");
+            }
+        }
+
+        ByteBuffer buffer = inputBuffer.duplicate().order(audioFormat.isBigEndian() ? ByteOrder.BIG_ENDIAN : ByteOrder.LITTLE_ENDIAN);
+        decode(buffer, outputSamples, offset, frames, audioFormat);
+    }
+
+    private static void decode(ByteBuffer buffer, float[][] outputSamples, int offset, int sampleCount, AudioFormat audioFormat) {
+        int bytesPerSample = audioFormat.getBytesPerSample();
+        int channels = audioFormat.getChannels();
 
         switch (audioFormat.getEncoding()) {
             case PCM_UNSIGNED:
                 double invMax = 1.0 / ((1L << (bytesPerSample * 8)) - 1);
                 for (int i = 0; i < sampleCount; i++) {
                     for (int ch = 0; ch < channels; ch++) {
-                        outputSamples[ch][i] = unsignedToFloat(buffer, bytesPerSample, invMax);
+                        outputSamples[ch][offset + i] = unsignedToFloat(buffer, bytesPerSample, invMax);
                     }
                 }
                 break;
@@ -173,7 +224,7 @@ public final class SamplesConverter {
                     ShortBuffer shortBuffer = buffer.asShortBuffer();
                     for (int i = 0; i < sampleCount; i++) {
                         for (int ch = 0; ch < channels; ch++) {
-                            outputSamples[ch][i] = (float) (shortBuffer.get() * INV_32768);
+                            outputSamples[ch][offset + i] = (float) (shortBuffer.get() * INV_32768);
                         }
                     }
                     buffer.position(buffer.position() + sampleCount * channels * 2);
@@ -181,7 +232,7 @@ public final class SamplesConverter {
                     FloatBuffer floatBuffer = buffer.asFloatBuffer();
                     for (int i = 0; i < sampleCount; i++) {
                         for (int ch = 0; ch < channels; ch++) {
-                            outputSamples[ch][i] = floatBuffer.get();
+                            outputSamples[ch][offset + i] = floatBuffer.get();
                         }
                     }
                     buffer.position(buffer.position() + sampleCount * channels * 4);
@@ -191,7 +242,7 @@ public final class SamplesConverter {
                     double invFullRange = 1.0 / fullRange;
                     for (int i = 0; i < sampleCount; i++) {
                         for (int ch = 0; ch < channels; ch++) {
-                            outputSamples[ch][i] = signedToFloat(buffer, bytesPerSample, invFullRange);
+                            outputSamples[ch][offset + i] = signedToFloat(buffer, bytesPerSample, invFullRange);
                         }
                     }
                 }
@@ -202,7 +253,7 @@ public final class SamplesConverter {
                     FloatBuffer floatBuffer = buffer.asFloatBuffer();
                     for (int i = 0; i < sampleCount; i++) {
                         for (int ch = 0; ch < channels; ch++) {
-                            outputSamples[ch][i] = floatBuffer.get();
+                            outputSamples[ch][offset + i] = floatBuffer.get();
                         }
                     }
                     buffer.position(buffer.position() + sampleCount * channels * 4);
@@ -210,7 +261,7 @@ public final class SamplesConverter {
                     DoubleBuffer doubleBuffer = buffer.asDoubleBuffer();
                     for (int i = 0; i < sampleCount; i++) {
                         for (int ch = 0; ch < channels; ch++) {
-                            outputSamples[ch][i] = (float) doubleBuffer.get();
+                            outputSamples[ch][offset + i] = (float) doubleBuffer.get();
                         }
                     }
                     buffer.position(buffer.position() + sampleCount * channels * 8);
@@ -220,7 +271,7 @@ public final class SamplesConverter {
             case ULAW:
                 for (int i = 0; i < sampleCount; i++) {
                     for (int ch = 0; ch < channels; ch++) {
-                        outputSamples[ch][i] = ulawToFloat(buffer);
+                        outputSamples[ch][offset + i] = ulawToFloat(buffer);
                     }
                 }
                 break;
@@ -228,7 +279,7 @@ public final class SamplesConverter {
             case ALAW:
                 for (int i = 0; i < sampleCount; i++) {
                     for (int ch = 0; ch < channels; ch++) {
-                        outputSamples[ch][i] = alawToFloat(buffer);
+                        outputSamples[ch][offset + i] = alawToFloat(buffer);
                     }
                 }
                 break;
@@ -291,6 +342,55 @@ public final class SamplesConverter {
         }
 
         ByteBuffer buffer = ByteBuffer.wrap(outputBytes).order(isBigEndian ? ByteOrder.BIG_ENDIAN : ByteOrder.LITTLE_ENDIAN);
+        encode(samples, buffer, targetFormat, samplesLength);
+    }
+
+    /**
+     * Converts normalized floating-point samples into raw PCM data, written into a
+     * {@link ByteBuffer}. Works the same as {@link #toBytes(float[][], byte[], AudioFormat)},
+     * but allows direct (off-heap) buffers to be used as the output.
+     *
+     * <p>The data is written starting at the buffer's current position, which is left unchanged.
+     * The buffer must have at least {@code frames * channels * bytesPerSample} bytes remaining.
+     *
+     * @param samples 2D array of floating-point audio data, organized as [channels][frames]
+     * @param outputBuffer output buffer to store converted PCM data
+     * @param targetFormat target PCM format (encoding, sample size, endian, channels)
+     *
+     * @throws IllegalArgumentException if {@code outputBuffer} has not enough bytes remaining,
+     *                                  or the channels have different lengths.
+     *
+     * @since 0.3.1-beta
+     */
+    public static void toBytes(float[][] samples, ByteBuffer outputBuffer, AudioFormat targetFormat) {
+        if (samples == null || targetFormat == null || outputBuffer == null) {
+            throw new IllegalArgumentException("Samples, target format, and output buffer must not be null.");
+        }
+        if (samples.length == 0 || samples[0] == null || samples[0].length == 0) {
+            return;
+        }
+
+        int samplesLength = samples[0].length;
+        int channels = targetFormat.getChannels();
+
+        for (int i = 1; i < channels; i++) {
+            if (samples[i].length != samplesLength) {
+                throw new IllegalArgumentException("All channels must have the same length");
+            }
+        }
+
+        int dataLength = samplesLength * channels * targetFormat.getBytesPerSample();
+        if (outputBuffer.remaining() < dataLength) {
+            throw new IllegalArgumentException("Output buffer must have at least " + dataLength + " bytes remaining");
+        }
+
+        ByteBuffer buffer = outputBuffer.duplicate().order(targetFormat.isBigEndian() ? ByteOrder.BIG_ENDIAN : ByteOrder.LITTLE_ENDIAN);
+        encode(samples, buffer, targetFormat, samplesLength);
+    }
+
+    private static void encode(float[][] samples, ByteBuffer buffer, AudioFormat targetFormat, int samplesLength) {
+        int bytesPerSample = targetFormat.getBytesPerSample();
+        int channels = targetFormat.getChannels();
 
         switch (targetFormat.getEncoding()) {
             case PCM_UNSIGNED:
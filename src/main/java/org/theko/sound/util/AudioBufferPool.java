@@ -0,0 +1,184 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.theko.sound.util;
+
+import java.util.Arrays;
+
+/**
+ * Pool of scratch sample buffers, keyed by their shape (channels, frames).
+ * <p>
+ * Nodes borrow buffers while rendering and release them before {@code render} returns,
+ * so in steady state every period reuses the buffers of the previous one and rendering
+ * allocates nothing. A buffer is allocated only the first time a shape is borrowed more
+ * often than it was released, e.g. when the block size or the channel count changes.
+ * <p>
+ * A pool is confined to one thread, {@link #current()} returns the pool of the calling thread.
+ * An audio graph is rendered by one thread (the playback thread of its output layer, or
+ * the render thread of the backend in pull mode), so that pool is the arena of the graph.
+ * Borrowed buffers hold the data of their previous user, callers clear them if needed.
+ *
+ * <pre>
+ * AudioBufferPool pool = AudioBufferPool.current();
+ * float[][] scratch = pool.borrow(channels, frames);
+ * try {
+ *     // ...
+ * } finally {
+ *     pool.release(scratch);
+ * }
+ * </pre>
+ *
+ * @since 0.3.1-beta
+ * @author Theko
+ */
+public final class AudioBufferPool {
+
+    private static final ThreadLocal<AudioBufferPool> CURRENT = ThreadLocal.withInitial(AudioBufferPool::new);
+
+    /** Shapes kept at once, the least recently used one is dropped for a new shape. */
+    private static final int MAX_SHAPES = 32;
+
+    /** Free buffers kept per shape, further releases are left to the garbage collector. */
+    private static final int MAX_FREE_PER_SHAPE = 64;
+
+    private static final class Shape {
+        final int channels;
+        final int frames;
+        float[][][] free = new float[4][][];
+        int freeCount = 0;
+        long lastUse;
+
+        Shape(int channels, int frames) {
+            this.channels = channels;
+            this.frames = frames;
+        }
+    }
+
+    private final Shape[] shapes = new Shape[MAX_SHAPES];
+    private int shapeCount = 0;
+    private long useCounter = 0;
+    private long allocations = 0;
+
+    private AudioBufferPool() {
+    }
+
+    /**
+     * Returns the pool of the calling thread.
+     *
+     * @return The pool, created on first use
+     */
+    public static AudioBufferPool current() {
+        return CURRENT.get();
+    }
+
+    /**
+     * Borrows a buffer of the given shape. Its contents are unspecified.
+     *
+     * @param channels The number of channels
+     * @param frames The number of frames of each channel
+     * @return A buffer of exactly {@code channels} arrays of {@code frames} samples
+     * @throws IllegalArgumentException if the channels or frames are not positive
+     */
+    public float[][] borrow(int channels, int frames) {
+        if (channels <= 0 || frames <= 0) {
+            throw new IllegalArgumentException("Channels and frames must be positive.");
+        }
+        Shape shape = find(channels, frames);
+        if (shape != null && shape.freeCount > 0) {
+            float[][] buffer = shape.free[--shape.freeCount];
+            shape.free[shape.freeCount] = null;
+            return buffer;
+        }
+        allocations++;
+        return new float[channels][frames];
+    }
+
+    /**
+     * Borrows a buffer of the given shape, filled with zeros.
+     *
+     * @param channels The number of channels
+     * @param frames The number of frames of each channel
+     * @return A silent buffer of exactly {@code channels} arrays of {@code frames} samples
+     * @throws IllegalArgumentException if the channels or frames are not positive
+     */
+    public float[][] borrowZeroed(int channels, int frames) {
+        float[][] buffer = borrow(channels, frames);
+        for (float[] channel : buffer) {
+            Arrays.fill(channel, 0.0f);
+        }
+        return buffer;
+    }
+
+    /**
+     * Returns a borrowed buffer to the pool. The caller must not use it afterwards.
+     * Buffers that were not borrowed may be released too, if all their channels have the same length.
+     *
+     * @param buffer The buffer, null is ignored
+     */
+    public void release(float[][] buffer) {
+        if (buffer == null || buffer.length == 0 || buffer[0] == null || buffer[0].length == 0) return;
+        int channels = buffer.length;
+        int frames = buffer[0].length;
+        for (int ch = 1; ch < channels; ch++) {
+            if (buffer[ch] == null || buffer[ch].length != frames) return;
+        }
+
+        Shape shape = find(channels, frames);
+        if (shape == null) shape = add(channels, frames);
+        if (shape.freeCount == MAX_FREE_PER_SHAPE) return;
+        if (shape.freeCount == shape.free.length) {
+            shape.free = Arrays.copyOf(shape.free, shape.free.length * 2);
+        }
+        shape.free[shape.freeCount++] = buffer;
+    }
+
+    /**
+     * Returns the number of buffers allocated because no free buffer of the shape was pooled.
+     * Constant in steady state.
+     *
+     * @return The number of allocations since the pool was created
+     */
+    public long getAllocationCount() {
+        return allocations;
+    }
+
+    private Shape find(int channels, int frames) {
+        for (int i = 0; i < shapeCount; i++) {
+            Shape shape = shapes[i];
+            if (shape.frames == frames && shape.channels == channels) {
+                shape.lastUse = ++useCounter;
+                return shape;
+            }
+        }
+        return null;
+    }
+
+    private Shape add(int channels, int frames) {
+        int index = shapeCount;
+        if (shapeCount == MAX_SHAPES) {
+            index = 0;
+            for (int i = 1; i < MAX_SHAPES; i++) {
+                if (shapes[i].lastUse < shapes[index].lastUse) index = i;
+            }
+        } else {
+            shapeCount++;
+        }
+        Shape shape = new Shape(channels, frames);
+        shape.lastUse = ++useCounter;
+        shapes[index] = shape;
+        return shape;
+    }
+}
@@ -27,6 +27,9 @@ import org.theko.sound.samples.SamplesValidation.DimensionsResult;
  * It includes operations such as padding, copying, cloning, filling, reversing, polarity inversion,
  * channel swapping, gain adjustment, panning, and normalization. Methods are provided both for
  * mutating existing arrays and creating new arrays with the modified data.
+ * <p>The per-sample loops of gain, pan, mixing, channel conversion and volume analysis
+ * run on block kernels: scalar Java loops by default, or the SIMD kernels of a loaded
+ * native backend library (see {@link NativeAudioKernels}).
  *
  * @since 0.3.0-beta
  * @author Theko
@@ -55,6 +58,24 @@ public final class AudioBufferUtilities {
         if (channels <= 0 || frames <= 0) throw new IllegalArgumentException("New lengths must be > 0.");
 
         float[][] padded = new float[channels][frames];
+        padArray(original, padded, fillNewWithLast);
+        return padded;
+    }
+
+    /**
+     * Pads a 2D float array into a preallocated target, the into-buffer variant of
+     * {@link #padArray(float[][], int, int, boolean)}. Each target channel receives the
+     * start of the matching original channel, the rest is filled like the allocating variant does.
+     *
+     * @param original The original 2D float array to pad
+     * @param target The target array, its shape gives the new lengths
+     * @param fillNewWithLast If true, the new samples are the last available element of each row,
+     * if false, they are 0.0f.
+     * @throws IllegalArgumentException if the original or the target array is null
+     */
+    public static void padArray(float[][] original, float[][] target, boolean fillNewWithLast) {
+        if (original == null) throw new IllegalArgumentException("Original array cannot be null.");
+        if (target == null) throw new IllegalArgumentException("Target array cannot be null.");
 
         float defaultValue = 0.0f; // default value
         float lastOriginalValue = 0.0f;
@@ -69,30 +90,22 @@ public final class AudioBufferUtilities {
             }
         }
 
-        for (int i = 0; i < channels; i++) {
-            float[] row = new float[frames];
+        for (int i = 0; i < target.length; i++) {
+            float[] row = target[i];
+            int frames = row.length;
             float[] srcRow = i < original.length ? original[i] : null;
 
             float fillValue = fillNewWithLast
                     ? (srcRow != null && srcRow.length > 0 ? srcRow[srcRow.length - 1] : lastOriginalValue)
                     : defaultValue;
 
+            int copyLength = 0;
             if (srcRow != null) {
-                int copyLength = Math.min(srcRow.length, frames);
-                System.arraycopy(srcRow, 0, row, 0, copyLength);
-
-                for (int j = copyLength; j < frames; j++) {
-                    row[j] = fillValue;
-                }
-            } else {
-                for (int j = 0; j < frames; j++) {
-                    row[j] = fillValue;
-                }
+                copyLength = Math.min(srcRow.length, frames);
+                if (srcRow != row) System.arraycopy(srcRow, 0, row, 0, copyLength);
             }
-
-            padded[i] = row;
+            Arrays.fill(row, copyLength, frames, fillValue);
         }
-        return padded;
     }
 
     /**
@@ -112,19 +125,22 @@ public final class AudioBufferUtilities {
         if (channels <= 0 || frames <= 0) throw new IllegalArgumentException("New lengths must be > 0.");
 
         float[][] cut = new float[channels][frames];
-
-        for (int i = 0; i < channels; i++) {
-            float[] srcRow = i < original.length ? original[i] : null;
-            cut[i] = new float[frames];
-
-            if (srcRow != null) {
-                int copyLength = Math.min(srcRow.length, frames);
-                System.arraycopy(srcRow, 0, cut[i], 0, copyLength);
-            }
-        }
+        cutArray(original, cut);
         return cut;
     }
 
+    /**
+     * Cuts a 2D float array into a preallocated target, the into-buffer variant of
+     * {@link #cutArray(float[][], int, int)}. Samples past the original length are 0.0f.
+     *
+     * @param original The original 2D float array to cut
+     * @param target The target array, its shape gives the new lengths
+     * @throws IllegalArgumentException if the original or the target array is null
+     */
+    public static void cutArray(float[][] original, float[][] target) {
+        padArray(original, target, false);
+    }
+
     /**
      * Copies a 2D float array (matrix) from source to target.
      * The source and target arrays must have the same number of channels (rows).
@@ -238,15 +254,12 @@ public final class AudioBufferUtilities {
 
             // Stereo -> Mono
             if (sourceChannels > 1 && targetChannels == 1) {
+                AudioKernels kernels = AudioKernels.get();
                 float[] targetChannel = target[0];
-                for (int ch = 0; ch < sourceChannels; ch++) {
-                    for (int i = 0; i < length; i++) {
-                        targetChannel[i] += source[ch][i];
-                    }
-                }
                 float inv = 1f / sourceChannels;
-                for (int i = 0; i < length; i++) {
-                    targetChannel[i] *= inv;
+                kernels.scale(source[0], targetChannel, length, inv);
+                for (int ch = 1; ch < sourceChannels; ch++) {
+                    kernels.mixAdd(source[ch], targetChannel, length, inv);
                 }
             }
             // Mono -> Stereo
@@ -256,17 +269,14 @@ public final class AudioBufferUtilities {
                 }
             }
             else if (sourceChannels > targetChannels) {
+                AudioKernels kernels = AudioKernels.get();
                 for (int ch = 0; ch < targetChannels; ch++) {
                     float[] targetChannel = target[ch];
-                    Arrays.fill(targetChannel, 0f);
-                    for (int i = 0; i < length; i++) {
-                        float sum = 0f;
-                        int count = 0;
-                        for (int inCh = ch; inCh < sourceChannels; inCh += targetChannels) {
-                            sum += source[inCh][i];
-                            count++;
-                        }
-                        targetChannel[i] = sum / count;
+                    int count = (sourceChannels - ch + targetChannels - 1) / targetChannels;
+                    float inv = 1f / count;
+                    kernels.scale(source[ch], targetChannel, length, inv);
+                    for (int inCh = ch + targetChannels; inCh < sourceChannels; inCh += targetChannels) {
+                        kernels.mixAdd(source[inCh], targetChannel, length, inv);
                     }
                 }
             }
@@ -316,6 +326,32 @@ public final class AudioBufferUtilities {
         return target;
     }
 
+    /**
+     * Mixes the source samples into the target samples.
+     * Each target sample gets the matching source sample multiplied by the gain added to it,
+     * the result is not clipped. Extra target channels are left unchanged.
+     *
+     * @param source The 2D float array containing the samples to add
+     * @param target The 2D float array to mix into
+     * @param gain The gain to apply to the source samples. A value of 1.0f adds them unchanged
+     * @throws IllegalArgumentException if either array is null or empty, if the target has fewer channels
+     * than the source, or if the channel lengths do not match
+     */
+    public static void mixAdd(float[][] source, float[][] target, float gain) {
+        SamplesValidation.validateSamples(source);
+        SamplesValidation.validateSamples(target);
+        if (target.length < source.length) {
+            throw new IllegalArgumentException("Target has fewer channels than source.");
+        }
+        AudioKernels kernels = AudioKernels.get();
+        for (int ch = 0; ch < source.length; ch++) {
+            if (source[ch].length != target[ch].length) {
+                throw new IllegalArgumentException("Source and target channels must have the same length.");
+            }
+            kernels.mixAdd(source[ch], target[ch], source[ch].length, gain);
+        }
+    }
+
     // Audio-specific operations
 
     /**
@@ -516,11 +552,7 @@ public final class AudioBufferUtilities {
      */
     public static float getAbsMaxVolume(float[] samples) {
         SamplesValidation.validateSamples(samples);
-        float max = 0.0f;
-        for (float sample : samples) {
-            max = Math.max(max, Math.abs(sample));
-        }
-        return max;
+        return AudioKernels.get().peak(samples, samples.length);
     }
 
     /**
@@ -534,11 +566,10 @@ public final class AudioBufferUtilities {
      */
     public static float getAbsMaxVolume(float[][] samples) {
         SamplesValidation.validateSamples(samples);
+        AudioKernels kernels = AudioKernels.get();
         float max = 0.0f;
         for (float[] channel : samples) {
-            for (float sample : channel) {
-                max = Math.max(max, Math.abs(sample));
-            }
+            max = Math.max(max, kernels.peak(channel, channel.length));
         }
         return max;
     }
@@ -554,13 +585,7 @@ public final class AudioBufferUtilities {
      */
     public static float getAbsAvgVolume(float[] samples) {
         SamplesValidation.validateSamples(samples);
-        float sum = 0.0f;
-        int count = 0;
-        for (float sample : samples) {
-            sum += Math.abs(sample);
-            count++;
-        }
-        return sum / count;
+        return (float) (AudioKernels.get().sumAbs(samples, samples.length) / samples.length);
     }
 
     /**
@@ -574,15 +599,45 @@ public final class AudioBufferUtilities {
      */
     public static float getAbsAvgVolume(float[][] samples) {
         SamplesValidation.validateSamples(samples);
-        float sum = 0.0f;
-        int count = 0;
+        AudioKernels kernels = AudioKernels.get();
+        double sum = 0.0;
+        long count = 0;
         for (float[] channel : samples) {
-            for (float sample : channel) {
-                sum += Math.abs(sample);
-                count++;
-            }
+            sum += kernels.sumAbs(channel, channel.length);
+            count += channel.length;
         }
-        return sum / count;
+        return (float) (sum / count);
+    }
+
+    /**
+     * Calculates the RMS (root mean square) volume of the audio samples.
+     *
+     * @param samples The audio samples to analyze, represented as a 1D float array
+     * @return The RMS volume as a float
+     * @throws IllegalArgumentException if the samples array is null or empty
+     */
+    public static float getRmsVolume(float[] samples) {
+        SamplesValidation.validateSamples(samples);
+        return (float) Math.sqrt(AudioKernels.get().sumSquares(samples, samples.length) / samples.length);
+    }
+
+    /**
+     * Calculates the RMS (root mean square) volume of the audio samples over all channels.
+     *
+     * @param samples The audio samples to analyze, represented as a 2D float array
+     * @return The RMS volume as a float
+     * @throws IllegalArgumentException if the samples array is null or empty
+     */
+    public static float getRmsVolume(float[][] samples) {
+        SamplesValidation.validateSamples(samples);
+        AudioKernels kernels = AudioKernels.get();
+        double sum = 0.0;
+        long count = 0;
+        for (float[] channel : samples) {
+            sum += kernels.sumSquares(channel, channel.length);
+            count += channel.length;
+        }
+        return (float) Math.sqrt(sum / count);
     }
 
     /**
@@ -602,9 +657,7 @@ public final class AudioBufferUtilities {
         if (max < 1e-6f) {
             return; // Avoid division by zero
         }
-        for (int i = 0; i < samples.length; i++) {
-            output[i] = samples[i] / max;
-        }
+        AudioKernels.get().scale(samples, output, samples.length, 1.0f / max);
     }
 
     /**
@@ -623,9 +676,7 @@ public final class AudioBufferUtilities {
             return samples; // Avoid division by zero
         }
         float[] normalized = new float[samples.length];
-        for (int i = 0; i < samples.length; i++) {
-            normalized[i] = samples[i] / max;
-        }
+        AudioKernels.get().scale(samples, normalized, samples.length, 1.0f / max);
         return normalized;
     }
 
@@ -646,10 +697,9 @@ public final class AudioBufferUtilities {
         if (max < 1e-6f) {
             return; // Avoid division by zero
         }
+        AudioKernels kernels = AudioKernels.get();
         for (int i = 0; i < samples.length; i++) {
-            for (int j = 0; j < samples[i].length; j++) {
-                output[i][j] = samples[i][j] / max;
-            }
+            kernels.scale(samples[i], output[i], samples[i].length, 1.0f / max);
         }
     }
 
@@ -668,12 +718,11 @@ public final class AudioBufferUtilities {
         if (max < 1e-6f) {
             return samples; // Avoid division by zero
         }
+        AudioKernels kernels = AudioKernels.get();
         float[][] normalized = new float[samples.length][];
         for (int i = 0; i < samples.length; i++) {
             normalized[i] = new float[samples[i].length];
-            for (int j = 0; j < samples[i].length; j++) {
-                normalized[i][j] = samples[i][j] / max;
-            }
+            kernels.scale(samples[i], normalized[i], samples[i].length, 1.0f / max);
         }
         return normalized;
     }
@@ -692,9 +741,7 @@ public final class AudioBufferUtilities {
         SamplesValidation.validateSamples(samples);
         SamplesValidation.validateSamples(output);
         SamplesValidation.validateSamplesDimensions(samples, output);
-        for (int i = 0; i < samples.length; i++) {
-            output[i] = samples[i] * gain;
-        }
+        AudioKernels.get().scale(samples, output, samples.length, gain);
     }
 
     /**
@@ -710,9 +757,7 @@ public final class AudioBufferUtilities {
     public static float[] adjustGain(float[] samples, float gain) {
         SamplesValidation.validateSamples(samples);
         float[] adjusted = new float[samples.length];
-        for (int i = 0; i < samples.length; i++) {
-            adjusted[i] = samples[i] * gain;
-        }
+        AudioKernels.get().scale(samples, adjusted, samples.length, gain);
         return adjusted;
     }
 
@@ -730,10 +775,9 @@ public final class AudioBufferUtilities {
         SamplesValidation.validateSamples(samples);
         SamplesValidation.validateSamples(output);
         SamplesValidation.validateSamplesDimensions(samples, output);
+        AudioKernels kernels = AudioKernels.get();
         for (int i = 0; i < samples.length; i++) {
-            for (int j = 0; j < samples[i].length; j++) {
-                output[i][j] = samples[i][j] * gain;
-            }
+            kernels.scale(samples[i], output[i], samples[i].length, gain);
         }
     }
 
@@ -749,12 +793,11 @@ public final class AudioBufferUtilities {
      */
     public static float[][] adjustGain(float[][] samples, float gain) {
         SamplesValidation.validateSamples(samples);
+        AudioKernels kernels = AudioKernels.get();
         float[][] adjusted = new float[samples.length][];
         for (int i = 0; i < samples.length; i++) {
             adjusted[i] = new float[samples[i].length];
-            for (int j = 0; j < samples[i].length; j++) {
-                adjusted[i][j] = samples[i][j] * gain;
-            }
+            kernels.scale(samples[i], adjusted[i], samples[i].length, gain);
         }
         return adjusted;
     }
@@ -787,7 +830,6 @@ public final class AudioBufferUtilities {
             if (output[ch] == null || samples[ch] == null || output[ch].length != samples[ch].length) {
                 throw new IllegalArgumentException("Input and output arrays must have the same number of samples.");
             }
-            System.arraycopy(samples[ch], 0, output[ch], 0, samples[ch].length);
         }
 
         float leftVol = 1.0f;
@@ -798,12 +840,10 @@ public final class AudioBufferUtilities {
             rightVol = (float)Math.sin(angle);
         }
 
+        AudioKernels kernels = AudioKernels.get();
         for (int ch = 0; ch < samples.length; ch++) {
             float channelVol = getVolumeForChannel(ch, gain, leftVol, rightVol);
-            float[] channelSamples = output[ch];
-            for (int frame = 0; frame < channelSamples.length; frame++) {
-                channelSamples[frame] *= channelVol;
-            }
+            kernels.scale(samples[ch], output[ch], samples[ch].length, channelVol);
         }
 
         return true;
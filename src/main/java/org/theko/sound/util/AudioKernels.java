@@ -0,0 +1,79 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.theko.sound.util;
+
+/**
+ * Block kernels for the per-sample loops of {@link AudioBufferUtilities}.
+ * <p>
+ * Each kernel works on the first {@code length} samples of one channel, arguments
+ * are validated by the caller. {@link JavaAudioKernels} is always available,
+ * {@link NativeAudioKernels} replaces it once a native backend library that exports
+ * the SIMD kernels is loaded.
+ *
+ * @since 0.3.1-beta
+ * @author Theko
+ */
+sealed interface AudioKernels permits JavaAudioKernels, NativeAudioKernels {
+
+    /**
+     * Returns the kernels currently in use.
+     *
+     * @return The active kernels
+     */
+    static AudioKernels get() {
+        return Active.kernels;
+    }
+
+    /**
+     * Returns the name of the implementation, e.g. {@code "Java"} or {@code "AVX2"}.
+     *
+     * @return The implementation name
+     */
+    String getName();
+
+    /**
+     * Accumulates {@code src * gain} into {@code dst}.
+     */
+    void mixAdd(float[] src, float[] dst, int length, float gain);
+
+    /**
+     * Writes {@code src * gain} into {@code dst}, {@code src} and {@code dst} may be the same array.
+     */
+    void scale(float[] src, float[] dst, int length, float gain);
+
+    /**
+     * Returns the maximum absolute sample value.
+     */
+    float peak(float[] src, int length);
+
+    /**
+     * Returns the sum of squared samples, accumulated in double precision.
+     */
+    double sumSquares(float[] src, int length);
+
+    /**
+     * Returns the sum of absolute sample values, accumulated in double precision.
+     */
+    double sumAbs(float[] src, int length);
+
+    final class Active {
+        static volatile AudioKernels kernels = JavaAudioKernels.INSTANCE;
+
+        private Active() {
+        }
+    }
+}
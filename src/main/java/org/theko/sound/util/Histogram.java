@@ -0,0 +1,161 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.theko.sound.util;
+
+import java.util.Arrays;
+
+/**
+ * Immutable snapshot of a fixed-bucket histogram.
+ * <p>
+ * Bucket {@code i} counts the values below {@link #getUpperBound(int)} and at or above the
+ * upper bound of bucket {@code i - 1}, the last bucket is open-ended. Time histograms have
+ * {@value #TIME_BUCKETS} log2 buckets in nanoseconds: bucket 0 counts values below 1 us,
+ * bucket {@code i} values in [2<sup>i-1</sup>, 2<sup>i</sup>) us. The native backends record
+ * the same layout, so histograms from both sides can be compared bucket by bucket.
+ *
+ * @since 0.3.1-beta
+ * @author Theko
+ */
+public final class Histogram {
+
+    /** Number of buckets of a time histogram. */
+    public static final int TIME_BUCKETS = 16;
+
+    private final long[] counts;
+    private final long[] upperBounds;
+
+    private Histogram(long[] counts, long[] upperBounds) {
+        this.counts = counts;
+        this.upperBounds = upperBounds;
+    }
+
+    /**
+     * Creates a time histogram.
+     *
+     * @param counts The {@value #TIME_BUCKETS} bucket counts, copied
+     * @return The histogram
+     * @throws IllegalArgumentException if the number of counts is wrong
+     */
+    public static Histogram ofTimes(long[] counts) {
+        if (counts == null || counts.length != TIME_BUCKETS) {
+            throw new IllegalArgumentException("Time histogram needs " + TIME_BUCKETS + " buckets.");
+        }
+        long[] bounds = new long[TIME_BUCKETS];
+        for (int i = 0; i < TIME_BUCKETS - 1; i++) {
+            bounds[i] = (1L << i) * 1000L;
+        }
+        bounds[TIME_BUCKETS - 1] = Long.MAX_VALUE;
+        return new Histogram(counts.clone(), bounds);
+    }
+
+    /**
+     * Creates a histogram with buckets of equal width over {@code [0, range)}.
+     *
+     * @param counts The bucket counts, copied
+     * @param range The upper bound of the last bucket, values above it are counted in the last bucket
+     * @return The histogram
+     * @throws IllegalArgumentException if there are no counts or the range is negative
+     */
+    public static Histogram ofLinear(long[] counts, long range) {
+        if (counts == null || counts.length == 0) throw new IllegalArgumentException("Histogram needs buckets.");
+        if (range < 0) throw new IllegalArgumentException("Range must not be negative.");
+        long[] bounds = new long[counts.length];
+        for (int i = 0; i < counts.length - 1; i++) {
+            bounds[i] = range * (i + 1) / counts.length;
+        }
+        bounds[counts.length - 1] = Long.MAX_VALUE;
+        return new Histogram(counts.clone(), bounds);
+    }
+
+    /**
+     * Returns the time histogram bucket of a duration.
+     *
+     * @param nanos The duration, in nanoseconds
+     * @return The bucket index, from 0 to {@code TIME_BUCKETS - 1}
+     */
+    public static int timeBucket(long nanos) {
+        long micros = nanos / 1000L;
+        if (micros <= 0) return 0;
+        return Math.min(TIME_BUCKETS - 1, 64 - Long.numberOfLeadingZeros(micros));
+    }
+
+    /**
+     * @return The number of buckets
+     */
+    public int getBucketCount() {
+        return counts.length;
+    }
+
+    /**
+     * @param bucket The bucket index
+     * @return The number of values counted in the bucket
+     */
+    public long getCount(int bucket) {
+        return counts[bucket];
+    }
+
+    /**
+     * @param bucket The bucket index
+     * @return The exclusive upper bound of the bucket, {@link Long#MAX_VALUE} for the last one
+     */
+    public long getUpperBound(int bucket) {
+        return upperBounds[bucket];
+    }
+
+    /**
+     * @return The number of values counted in all buckets
+     */
+    public long getTotalCount() {
+        long total = 0;
+        for (long count : counts) total += count;
+        return total;
+    }
+
+    /**
+     * Returns the upper bound of the bucket holding the given quantile, an upper estimate of it.
+     *
+     * @param quantile The quantile, from 0 to 1, e.g. 0.99
+     * @return The upper bound of the bucket, or 0 if the histogram is empty
+     * @throws IllegalArgumentException if the quantile is out of range
+     */
+    public long getQuantileBound(double quantile) {
+        if (!(quantile >= 0.0 && quantile <= 1.0)) {
+            throw new IllegalArgumentException("Quantile must be in range [0, 1].");
+        }
+        long total = getTotalCount();
+        if (total == 0) return 0;
+        long rank = Math.max(1, (long) Math.ceil(quantile * total));
+        long seen = 0;
+        for (int i = 0; i < counts.length; i++) {
+            seen += counts[i];
+            if (seen >= rank) return upperBounds[i];
+        }
+        return upperBounds[counts.length - 1];
+    }
+
+    /**
+     * @return A copy of the bucket counts
+     */
+    public long[] getCounts() {
+        return counts.clone();
+    }
+
+    @Override
+    public String toString() {
+        return "Histogram{Counts: " + Arrays.toString(counts) + "}";
+    }
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.theko.sound.util;
+
+/**
+ * Scalar {@link AudioKernels}.
+ * <p>
+ * The element-wise kernels are plain counted loops without branches or cross-iteration
+ * dependencies, so HotSpot C2 compiles them to SIMD code. The reductions use several
+ * independent accumulators to hide the floating-point add latency.
+ *
+ * @since 0.3.1-beta
+ * @author Theko
+ */
+final class JavaAudioKernels implements AudioKernels {
+
+    static final JavaAudioKernels INSTANCE = new JavaAudioKernels();
+
+    private JavaAudioKernels() {
+    }
+
+    @Override
+    public String getName() {
+        return "Java";
+    }
+
+    @Override
+    public void mixAdd(float[] src, float[] dst, int length, float gain) {
+        for (int i = 0; i < length; i++) {
+            dst[i] += src[i] * gain;
+        }
+    }
+
+    @Override
+    public void scale(float[] src, float[] dst, int length, float gain) {
+        for (int i = 0; i < length; i++) {
+            dst[i] = src[i] * gain;
+        }
+    }
+
+    @Override
+    public float peak(float[] src, int length) {
+        float m0 = 0.0f, m1 = 0.0f, m2 = 0.0f, m3 = 0.0f;
+        int i = 0;
+        for (; i + 4 <= length; i += 4) {
+            m0 = Math.max(m0, Math.abs(src[i]));
+            m1 = Math.max(m1, Math.abs(src[i + 1]));
+            m2 = Math.max(m2, Math.abs(src[i + 2]));
+            m3 = Math.max(m3, Math.abs(src[i + 3]));
+        }
+        for (; i < length; i++) {
+            m0 = Math.max(m0, Math.abs(src[i]));
+        }
+        return Math.max(Math.max(m0, m1), Math.max(m2, m3));
+    }
+
+    @Override
+    public double sumSquares(float[] src, int length) {
+        double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+        int i = 0;
+        for (; i + 4 <= length; i += 4) {
+            double v0 = src[i], v1 = src[i + 1], v2 = src[i + 2], v3 = src[i + 3];
+            s0 += v0 * v0;
+            s1 += v1 * v1;
+            s2 += v2 * v2;
+            s3 += v3 * v3;
+        }
+        for (; i < length; i++) {
+            double v = src[i];
+            s0 += v * v;
+        }
+        return (s0 + s1) + (s2 + s3);
+    }
+
+    @Override
+    public double sumAbs(float[] src, int length) {
+        double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+        int i = 0;
+        for (; i + 4 <= length; i += 4) {
+            s0 += Math.abs(src[i]);
+            s1 += Math.abs(src[i + 1]);
+            s2 += Math.abs(src[i + 2]);
+            s3 += Math.abs(src[i + 3]);
+        }
+        for (; i < length; i++) {
+            s0 += Math.abs(src[i]);
+        }
+        return (s0 + s1) + (s2 + s3);
+    }
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.theko.sound.util;
+
+import static org.theko.sound.properties.AudioSystemProperties.BACKENDS_NATIVE_KERNELS;
+
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+/**
+ * Native SIMD kernels for {@link AudioBufferUtilities}.
+ * <p>
+ * The kernels are compiled into the native backend libraries (AVX-512, AVX2 or SSE2
+ * selected at runtime on x86, NEON on AArch64), so there is no separate library to ship.
+ * A backend calls {@link #onLibraryLoaded()} after loading its library, from then on
+ * the native kernels are used for blocks of at least {@value #MIN_NATIVE_LENGTH} samples,
+ * shorter blocks stay in Java where the JNI transition would cost more than it saves.
+ * Disabled with {@code org.theko.sound.backends.nativeKernels=false}.
+ *
+ * @since 0.3.1-beta
+ * @author Theko
+ */
+public final class NativeAudioKernels implements AudioKernels {
+
+    private static final Logger logger = LoggerFactory.getLogger(NativeAudioKernels.class);
+
+    static final int MIN_NATIVE_LENGTH = 128;
+
+    private static volatile NativeAudioKernels instance;
+
+    private final String name;
+
+    private NativeAudioKernels(String name) {
+        this.name = name;
+    }
+
+    /**
+     * Switches {@link AudioBufferUtilities} to the native kernels, if the library that
+     * was just loaded exports them. Safe to call more than once and from several backends.
+     */
+    public static synchronized void onLibraryLoaded() {
+        if (instance != null || !BACKENDS_NATIVE_KERNELS) return;
+        String kernelsName;
+        try {
+            kernelsName = nGetName();
+        } catch (UnsatisfiedLinkError ex) {
+            logger.debug("Native library does not export audio kernels.", ex);
+            return;
+        }
+        if (kernelsName == null || kernelsName.equals("scalar")) {
+            logger.debug("Native audio kernels have no SIMD support on this CPU, using Java kernels.");
+            return;
+        }
+        instance = new NativeAudioKernels(kernelsName);
+        AudioKernels.Active.kernels = instance;
+        logger.debug("Using native audio kernels: {}", kernelsName);
+    }
+
+    /**
+     * Checks if the native kernels are in use.
+     *
+     * @return True if {@link AudioBufferUtilities} uses the native kernels
+     */
+    public static boolean isActive() {
+        return instance != null && AudioKernels.get() == instance;
+    }
+
+    @Override
+    public String getName() {
+        return name;
+    }
+
+    @Override
+    public void mixAdd(float[] src, float[] dst, int length, float gain) {
+        if (length < MIN_NATIVE_LENGTH) {
+            JavaAudioKernels.INSTANCE.mixAdd(src, dst, length, gain);
+            return;
+        }
+        nMixAdd(src, dst, length, gain);
+    }
+
+    @Override
+    public void scale(float[] src, float[] dst, int length, float gain) {
+        if (length < MIN_NATIVE_LENGTH) {
+            JavaAudioKernels.INSTANCE.scale(src, dst, length, gain);
+            return;
+        }
+        nScale(src, dst, length, gain);
+    }
+
+    @Override
+    public float peak(float[] src, int length) {
+        if (length < MIN_NATIVE_LENGTH) return JavaAudioKernels.INSTANCE.peak(src, length);
+        return nPeak(src, length);
+    }
+
+    @Override
+    public double sumSquares(float[] src, int length) {
+        if (length < MIN_NATIVE_LENGTH) return JavaAudioKernels.INSTANCE.sumSquares(src, length);
+        return nSumSquares(src, length);
+    }
+
+    @Override
+    public double sumAbs(float[] src, int length) {
+        if (length < MIN_NATIVE_LENGTH) return JavaAudioKernels.INSTANCE.sumAbs(src, length);
+        return nSumAbs(src, length);
+    }
+
+    private static native String nGetName();
+    private static native void nMixAdd(float[] src, float[] dst, int length, float gain);
+    private static native void nScale(float[] src, float[] dst, int length, float gain);
+    private static native float nPeak(float[] src, int length);
+    private static native double nSumSquares(float[] src, int length);
+    private static native double nSumAbs(float[] src, int length);
+}
@@ -19,17 +19,18 @@ package org.theko.sound.visualizers;
 import static org.theko.sound.visualizers.SpectrumVisualizationUtilities.getScaledPositions;
 import static org.theko.sound.visualizers.SpectrumVisualizationUtilities.mapSpectrumCubic;
 
+import java.awt.AlphaComposite;
+import java.awt.Composite;
 import java.awt.Graphics2D;
 import java.awt.RenderingHints;
 import java.awt.image.BufferedImage;
 import java.awt.image.DataBufferInt;
-import java.util.Arrays;
 import java.util.Objects;
 import java.util.concurrent.atomic.AtomicBoolean;
 
 import javax.swing.JPanel;
 
-import org.theko.sound.dsp.FFT;
+import org.theko.sound.dsp.FFTPlan;
 import org.theko.sound.dsp.WindowFunction;
 import org.theko.sound.dsp.WindowType;
 import org.theko.sound.structs.Range;
@@ -38,6 +39,11 @@ import org.theko.sound.util.MathUtilities;
 /**
  * A class that represents a spectrogram visualizer.
  * It can be used to display the spectrogram of an audio stream.
+ * <p>
+ * The spectrogram is kept in a circular image: each update writes only the new columns,
+ * mapped to colors through a lookup table sampled from the {@link VolumeColorProcessor},
+ * and the image is drawn in two parts, split at the write position. An update costs
+ * O(height) besides the final blit, the history is never shifted.
  *
  * @see AudioVisualizer
  * @see GainedAudioVisualizer
@@ -76,18 +82,26 @@ public class SpectrogramVisualizer extends GainedAudioVisualizer {
 
     public static final Range<Float> FIXED_WIDTH_BAR_WIDTH_RANGE = new Range<>(0.0f, 1.0f);
 
+    /** Colors sampled from the volume color processor, for amplitudes 0..1. */
+    private static final int COLOR_LUT_SIZE = 1024;
+
     private float[] fftRingBuffer = null;
     private final AtomicBoolean shouldRedraw = new AtomicBoolean(false);
 
     protected class SpectrogramRender extends AudioVisualizer.Render {
 
+        // Circular spectrogram, the column at writeX is the oldest one
         private BufferedImage spectrogramBuffer;
         private int[] specPixels;
+        private int writeX = 0;
+
+        private int[] colorLut;
+        private VolumeColorProcessor lutProcessor;
 
         private float[] fftSpectrum;
         private float[] mappingPositions;
         private float[] interpolatedSpectrum;
-        private float[] real, imag;
+        private float[] windowed, real, imag;
         private float lastFrequencyScale = -1;
 
         private float timeSinceLastShift = 0f;
@@ -104,7 +118,7 @@ public class SpectrogramVisualizer extends GainedAudioVisualizer {
             fftSpectrum = null;
             mappingPositions = null;
             interpolatedSpectrum = null;
-            real = null; imag = null;
+            windowed = null; real = null; imag = null;
         }
 
         @Override
@@ -116,8 +130,7 @@ public class SpectrogramVisualizer extends GainedAudioVisualizer {
 
             // Do nothing if there is not enough samples
             if (fftRingBuffer == null || fftRingBuffer.length == 0 || !shouldRedraw.get()) {
-                if (spectrogramBuffer != null)
-                    g2d.drawImage(spectrogramBuffer, 0, 0, null);
+                drawSpectrogram(g2d);
                 return;
             }
 
@@ -140,34 +153,55 @@ public class SpectrogramVisualizer extends GainedAudioVisualizer {
 
             ensureBuffers();
             int[] pixels = specPixels;
-
+            int[] lut = ensureColorLut();
 
             int shift = Math.min(shiftPixels, w);
-            if (shiftPixels > 0) {
-                for (int y = 0; y < h; y++) {
-                    int base = y * w;
-
-                    System.arraycopy(
-                        pixels, base + shift,
-                        pixels, base,
-                        w - shift
-                    );
-                }
-            }
-
-            for (int x = 0; x < shift; x++) { // x = 0..shift-1
-                int targetX = w - shift + x;
+            for (int x = 0; x < shift; x++) {
+                int column = writeX;
                 for (int y = 0; y < h; y++) {
                     float amp = MathUtilities.clamp(interpolatedSpectrum[y], 0f, 1f);
                     int row = h - y - 1;
-                    pixels[row * w + targetX] = volumeColorProcessor.getColor(amp);
+                    pixels[row * w + column] = lut[(int) (amp * (COLOR_LUT_SIZE - 1) + 0.5f)];
                 }
+                writeX = (column + 1 == w) ? 0 : column + 1;
             }
 
-            g2d.drawImage(spectrogramBuffer, 0, 0, null);
+            drawSpectrogram(g2d);
             shouldRedraw.set(false);
         }
 
+        /**
+         * Draws the circular spectrogram, oldest column first.
+         */
+        private void drawSpectrogram(Graphics2D g2d) {
+            BufferedImage image = spectrogramBuffer;
+            if (image == null) return;
+            int w = image.getWidth();
+            int h = image.getHeight();
+            int split = w - writeX;
+
+            Composite composite = g2d.getComposite();
+            g2d.setComposite(AlphaComposite.Src);
+            g2d.drawImage(image, 0, 0, split, h, writeX, 0, w, h, null);
+            if (writeX > 0) {
+                g2d.drawImage(image, split, 0, w, h, 0, 0, writeX, h, null);
+            }
+            g2d.setComposite(composite);
+        }
+
+        private int[] ensureColorLut() {
+            VolumeColorProcessor processor = volumeColorProcessor;
+            if (colorLut == null || lutProcessor != processor) {
+                int[] lut = new int[COLOR_LUT_SIZE];
+                for (int i = 0; i < COLOR_LUT_SIZE; i++) {
+                    lut[i] = processor.getColor(i / (float) (COLOR_LUT_SIZE - 1));
+                }
+                colorLut = lut;
+                lutProcessor = processor;
+            }
+            return colorLut;
+        }
+
         private void ensureBuffers() {
             ensureSpectrogramBuffer();
 
@@ -199,21 +233,24 @@ public class SpectrogramVisualizer extends GainedAudioVisualizer {
             if (spectrogramBuffer == null) {
                 spectrogramBuffer = new BufferedImage(w, h, BufferedImage.TYPE_INT_ARGB);
                 specPixels = ((DataBufferInt) spectrogramBuffer.getRaster().getDataBuffer()).getData();
+                writeX = 0;
                 return;
             }
 
             if (spectrogramBuffer.getWidth() != w || spectrogramBuffer.getHeight() != h) {
-
-                BufferedImage old = spectrogramBuffer;
+                // Resized since the last update: unroll the history into the new size once
                 BufferedImage newBuf = new BufferedImage(w, h, BufferedImage.TYPE_INT_ARGB);
 
                 Graphics2D g = newBuf.createGraphics();
                 g.setRenderingHint(RenderingHints.KEY_INTERPOLATION, RenderingHints.VALUE_INTERPOLATION_BILINEAR);
-                g.drawImage(old, 0, 0, w, h, null);
+                g.scale((double) w / spectrogramBuffer.getWidth(), (double) h / spectrogramBuffer.getHeight());
+                drawSpectrogram(g);
                 g.dispose();
 
+                spectrogramBuffer.flush();
                 spectrogramBuffer = newBuf;
                 specPixels = ((DataBufferInt) newBuf.getRaster().getDataBuffer()).getData();
+                writeX = 0;
             }
         }
 
@@ -222,20 +259,21 @@ public class SpectrogramVisualizer extends GainedAudioVisualizer {
 
             int fftLength = fftWindowSize;
 
-            real = ensureBuffer(real, fftLength);
-            imag = ensureBuffer(imag, fftLength);
+            windowed = ensureBuffer(windowed, fftLength);
+            real = ensureBuffer(real, fftLength / 2 + 1);
+            imag = ensureBuffer(imag, fftLength / 2 + 1);
 
-            System.arraycopy(inputSamples, 0, real, 0, inputSamples.length);
-            Arrays.fill(imag, 0.0f);
+            System.arraycopy(inputSamples, 0, windowed, 0, inputSamples.length);
 
             if (Math.abs(gainControl.getValue() - 1.0f) > 1e-6f) {
                 for (int i = 0; i < inputSamples.length; i++) {
-                    real[i] *= gainControl.getValue();
+                    windowed[i] *= gainControl.getValue();
                 }
             }
 
-            WindowFunction.applyInPlace(real, windowType);
-            FFT.fft(real, imag);
+            WindowFunction.applyInPlace(windowed, windowType);
+            // Real input: half-size complex transform, only the bins below Nyquist are needed
+            FFTPlan.of(fftLength).forwardReal(windowed, real, imag);
 
             float maxAmplitude = 0.0f;
 
@@ -373,6 +411,8 @@ public class SpectrogramVisualizer extends GainedAudioVisualizer {
 
     /**
      * Sets the volume color processor used by the visualizer.
+     * The processor is sampled into a lookup table,
+     * so it should always return the same color for the same volume.
      *
      * @param volumeColorProcessor The volume color processor used by the visualizer
      * @throws NullPointerException if the volume color processor is null
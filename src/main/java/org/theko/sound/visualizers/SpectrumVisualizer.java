@@ -31,7 +31,7 @@ import java.util.Objects;
 
 import javax.swing.JPanel;
 
-import org.theko.sound.dsp.FFT;
+import org.theko.sound.dsp.FFTPlan;
 import org.theko.sound.dsp.WindowFunction;
 import org.theko.sound.dsp.WindowType;
 import org.theko.sound.structs.Range;
@@ -120,7 +120,7 @@ public class SpectrumVisualizer extends GainedAudioVisualizer {
         private float[] mappingPositions;
         private float[] interpolatedSpectrum;
         private float[] drawnSpectrum;
-        private float[] real, imag;
+        private float[] windowed, real, imag;
         private float lastFrequencyScale = -1;
 
         public SpectrumRender(int width, int height) {
@@ -135,7 +135,7 @@ public class SpectrumVisualizer extends GainedAudioVisualizer {
             mappingPositions = null;
             interpolatedSpectrum = null;
             drawnSpectrum = null;
-            real = null; imag = null;
+            windowed = null; real = null; imag = null;
         }
 
         @Override
@@ -246,20 +246,21 @@ public class SpectrumVisualizer extends GainedAudioVisualizer {
 
             int fftLength = fftWindowSize;
 
-            real = ensureBuffer(real, fftLength);
-            imag = ensureBuffer(imag, fftLength);
+            windowed = ensureBuffer(windowed, fftLength);
+            real = ensureBuffer(real, fftLength / 2 + 1);
+            imag = ensureBuffer(imag, fftLength / 2 + 1);
 
-            System.arraycopy(inputSamples, 0, real, 0, inputSamples.length);
-            Arrays.fill(imag, 0.0f);
+            System.arraycopy(inputSamples, 0, windowed, 0, inputSamples.length);
 
             if (Math.abs(gainControl.getValue() - 1.0f) > 1e-6f) {
                 for (int i = 0; i < inputSamples.length; i++) {
-                    real[i] *= gainControl.getValue();
+                    windowed[i] *= gainControl.getValue();
                 }
             }
 
-            WindowFunction.applyInPlace(real, windowType);
-            FFT.fft(real, imag);
+            WindowFunction.applyInPlace(windowed, windowType);
+            // Real input: half-size complex transform, only the bins below Nyquist are needed
+            FFTPlan.of(fftLength).forwardReal(windowed, real, imag);
 
             float maxAmplitude = 0.0f;
 
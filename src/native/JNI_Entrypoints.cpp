@@ -16,10 +16,24 @@
 
 #include <jni.h>
 
+#include "logger.hpp"
 #include "logger_manager.hpp"
+#include "cache/JNI_CacheRegistry.hpp"
 
 extern "C" {
     JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM* vm, void* reserved) {
+        JNIEnv* env = nullptr;
+        if (vm->GetEnv((void**) &env, JNI_VERSION_1_6) != JNI_OK) {
+            return JNI_ERR;
+        }
+
+        // Creates every class cache up front, so accessors never lock afterwards
+        int failed = initJNICaches(env);
+        if (failed > 0) {
+            Logger* logger = NATIVE_LOGGER(env, "NATIVE: JNI_OnLoad");
+            logger->warn(env, "%d JNI class caches failed to initialize, they will be created lazily.", failed);
+        }
+
         return JNI_VERSION_1_6;
     }
 
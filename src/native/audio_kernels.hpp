@@ -0,0 +1,431 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <math.h>
+#include <stddef.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define AUDIO_KERNELS_X86
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define AUDIO_KERNELS_NEON
+#endif
+
+/*
+ * Block kernels behind org.theko.sound.util.NativeAudioKernels.
+ *
+ * They work on one channel of planar float samples: gain-scaled accumulation (mixing),
+ * gain scaling (gain, pan law, normalization) and the peak / sum reductions used
+ * for metering. AVX-512, AVX2 and SSE2 are selected at runtime on x86 (cpuid, once per
+ * process), NEON is the baseline on AArch64. Reductions accumulate in double, so results
+ * do not depend on the kernel.
+ */
+namespace theko::sound::kernels {
+
+struct BlockKernels {
+    void (*mixAdd)(const float* src, float* dst, size_t n, float gain);   // dst += src * gain
+    void (*scale)(const float* src, float* dst, size_t n, float gain);    // dst = src * gain
+    float (*peak)(const float* src, size_t n);                            // max |src|
+    double (*sumSquares)(const float* src, size_t n);
+    double (*sumAbs)(const float* src, size_t n);
+    const char* name;
+};
+
+// --- Scalar ---
+
+static void mixAddScalar(const float* src, float* dst, size_t n, float gain) {
+    for (size_t i = 0; i < n; i++) dst[i] += src[i] * gain;
+}
+
+static void scaleScalar(const float* src, float* dst, size_t n, float gain) {
+    for (size_t i = 0; i < n; i++) dst[i] = src[i] * gain;
+}
+
+static float peakScalar(const float* src, size_t n) {
+    float max = 0.0f;
+    for (size_t i = 0; i < n; i++) {
+        float v = fabsf(src[i]);
+        if (v > max) max = v;
+    }
+    return max;
+}
+
+static double sumSquaresScalar(const float* src, size_t n) {
+    double sum = 0.0;
+    for (size_t i = 0; i < n; i++) sum += (double)src[i] * src[i];
+    return sum;
+}
+
+static double sumAbsScalar(const float* src, size_t n) {
+    double sum = 0.0;
+    for (size_t i = 0; i < n; i++) sum += fabsf(src[i]);
+    return sum;
+}
+
+#ifdef AUDIO_KERNELS_X86
+
+// --- SSE2 ---
+
+__attribute__((target("sse2")))
+static void mixAddSSE2(const float* src, float* dst, size_t n, float gain) {
+    const __m128 g = _mm_set1_ps(gain);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 d = _mm_loadu_ps(dst + i);
+        _mm_storeu_ps(dst + i, _mm_add_ps(d, _mm_mul_ps(_mm_loadu_ps(src + i), g)));
+    }
+    for (; i < n; i++) dst[i] += src[i] * gain;
+}
+
+__attribute__((target("sse2")))
+static void scaleSSE2(const float* src, float* dst, size_t n, float gain) {
+    const __m128 g = _mm_set1_ps(gain);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_loadu_ps(src + i), g));
+    }
+    for (; i < n; i++) dst[i] = src[i] * gain;
+}
+
+__attribute__((target("sse2")))
+static float peakSSE2(const float* src, size_t n) {
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    __m128 m = _mm_setzero_ps();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        m = _mm_max_ps(m, _mm_and_ps(_mm_loadu_ps(src + i), absMask));
+    }
+    alignas(16) float lanes[4];
+    _mm_store_ps(lanes, m);
+    float max = lanes[0];
+    for (int l = 1; l < 4; l++) if (lanes[l] > max) max = lanes[l];
+    for (; i < n; i++) {
+        float v = fabsf(src[i]);
+        if (v > max) max = v;
+    }
+    return max;
+}
+
+__attribute__((target("sse2")))
+static double sumSquaresSSE2(const float* src, size_t n) {
+    __m128d acc0 = _mm_setzero_pd(), acc1 = _mm_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 v = _mm_loadu_ps(src + i);
+        __m128d lo = _mm_cvtps_pd(v);
+        __m128d hi = _mm_cvtps_pd(_mm_movehl_ps(v, v));
+        acc0 = _mm_add_pd(acc0, _mm_mul_pd(lo, lo));
+        acc1 = _mm_add_pd(acc1, _mm_mul_pd(hi, hi));
+    }
+    alignas(16) double lanes[2];
+    _mm_store_pd(lanes, _mm_add_pd(acc0, acc1));
+    double sum = lanes[0] + lanes[1];
+    for (; i < n; i++) sum += (double)src[i] * src[i];
+    return sum;
+}
+
+__attribute__((target("sse2")))
+static double sumAbsSSE2(const float* src, size_t n) {
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    __m128d acc0 = _mm_setzero_pd(), acc1 = _mm_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 v = _mm_and_ps(_mm_loadu_ps(src + i), absMask);
+        acc0 = _mm_add_pd(acc0, _mm_cvtps_pd(v));
+        acc1 = _mm_add_pd(acc1, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+    }
+    alignas(16) double lanes[2];
+    _mm_store_pd(lanes, _mm_add_pd(acc0, acc1));
+    double sum = lanes[0] + lanes[1];
+    for (; i < n; i++) sum += fabsf(src[i]);
+    return sum;
+}
+
+// --- AVX2 ---
+
+__attribute__((target("avx2")))
+static void mixAddAVX2(const float* src, float* dst, size_t n, float gain) {
+    const __m256 g = _mm256_set1_ps(gain);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256 d0 = _mm256_loadu_ps(dst + i);
+        __m256 d1 = _mm256_loadu_ps(dst + i + 8);
+        d0 = _mm256_add_ps(d0, _mm256_mul_ps(_mm256_loadu_ps(src + i), g));
+        d1 = _mm256_add_ps(d1, _mm256_mul_ps(_mm256_loadu_ps(src + i + 8), g));
+        _mm256_storeu_ps(dst + i, d0);
+        _mm256_storeu_ps(dst + i + 8, d1);
+    }
+    for (; i + 8 <= n; i += 8) {
+        __m256 d = _mm256_loadu_ps(dst + i);
+        _mm256_storeu_ps(dst + i, _mm256_add_ps(d, _mm256_mul_ps(_mm256_loadu_ps(src + i), g)));
+    }
+    for (; i < n; i++) dst[i] += src[i] * gain;
+}
+
+__attribute__((target("avx2")))
+static void scaleAVX2(const float* src, float* dst, size_t n, float gain) {
+    const __m256 g = _mm256_set1_ps(gain);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_loadu_ps(src + i), g));
+    }
+    for (; i < n; i++) dst[i] = src[i] * gain;
+}
+
+__attribute__((target("avx2")))
+static float peakAVX2(const float* src, size_t n) {
+    const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+    __m256 m0 = _mm256_setzero_ps(), m1 = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        m0 = _mm256_max_ps(m0, _mm256_and_ps(_mm256_loadu_ps(src + i), absMask));
+        m1 = _mm256_max_ps(m1, _mm256_and_ps(_mm256_loadu_ps(src + i + 8), absMask));
+    }
+    alignas(32) float lanes[8];
+    _mm256_store_ps(lanes, _mm256_max_ps(m0, m1));
+    float max = lanes[0];
+    for (int l = 1; l < 8; l++) if (lanes[l] > max) max = lanes[l];
+    for (; i < n; i++) {
+        float v = fabsf(src[i]);
+        if (v > max) max = v;
+    }
+    return max;
+}
+
+__attribute__((target("avx2")))
+static double sumSquaresAVX2(const float* src, size_t n) {
+    __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 v = _mm256_loadu_ps(src + i);
+        __m256d lo = _mm256_cvtps_pd(_mm256_castps256_ps128(v));
+        __m256d hi = _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1));
+        acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(lo, lo));
+        acc1 = _mm256_add_pd(acc1, _mm256_mul_pd(hi, hi));
+    }
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, _mm256_add_pd(acc0, acc1));
+    double sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    for (; i < n; i++) sum += (double)src[i] * src[i];
+    return sum;
+}
+
+__attribute__((target("avx2")))
+static double sumAbsAVX2(const float* src, size_t n) {
+    const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+    __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 v = _mm256_and_ps(_mm256_loadu_ps(src + i), absMask);
+        acc0 = _mm256_add_pd(acc0, _mm256_cvtps_pd(_mm256_castps256_ps128(v)));
+        acc1 = _mm256_add_pd(acc1, _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1)));
+    }
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, _mm256_add_pd(acc0, acc1));
+    double sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    for (; i < n; i++) sum += fabsf(src[i]);
+    return sum;
+}
+
+// --- AVX-512 ---
+// Tails use masked loads and stores, and reductions stay in registers: 64-byte aligned
+// stack slots are not guaranteed by the Win64 ABI. mixAdd rounds once (FMA), so it may
+// differ from the other kernels in the last bit.
+
+__attribute__((target("avx512f")))
+static inline __mmask16 tailMask(size_t n) {
+    return (__mmask16)((1u << n) - 1u);
+}
+
+__attribute__((target("avx512f")))
+static void mixAddAVX512(const float* src, float* dst, size_t n, float gain) {
+    const __m512 g = _mm512_set1_ps(gain);
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m512 d0 = _mm512_loadu_ps(dst + i);
+        __m512 d1 = _mm512_loadu_ps(dst + i + 16);
+        d0 = _mm512_fmadd_ps(_mm512_loadu_ps(src + i), g, d0);
+        d1 = _mm512_fmadd_ps(_mm512_loadu_ps(src + i + 16), g, d1);
+        _mm512_storeu_ps(dst + i, d0);
+        _mm512_storeu_ps(dst + i + 16, d1);
+    }
+    for (; i + 16 <= n; i += 16) {
+        __m512 d = _mm512_loadu_ps(dst + i);
+        _mm512_storeu_ps(dst + i, _mm512_fmadd_ps(_mm512_loadu_ps(src + i), g, d));
+    }
+    if (i < n) {
+        __mmask16 m = tailMask(n - i);
+        __m512 d = _mm512_maskz_loadu_ps(m, dst + i);
+        d = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(m, src + i), g, d);
+        _mm512_mask_storeu_ps(dst + i, m, d);
+    }
+}
+
+__attribute__((target("avx512f")))
+static void scaleAVX512(const float* src, float* dst, size_t n, float gain) {
+    const __m512 g = _mm512_set1_ps(gain);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        _mm512_storeu_ps(dst + i, _mm512_mul_ps(_mm512_loadu_ps(src + i), g));
+    }
+    if (i < n) {
+        __mmask16 m = tailMask(n - i);
+        _mm512_mask_storeu_ps(dst + i, m, _mm512_mul_ps(_mm512_maskz_loadu_ps(m, src + i), g));
+    }
+}
+
+__attribute__((target("avx512f")))
+static float peakAVX512(const float* src, size_t n) {
+    __m512 m0 = _mm512_setzero_ps(), m1 = _mm512_setzero_ps();
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        m0 = _mm512_max_ps(m0, _mm512_abs_ps(_mm512_loadu_ps(src + i)));
+        m1 = _mm512_max_ps(m1, _mm512_abs_ps(_mm512_loadu_ps(src + i + 16)));
+    }
+    for (; i + 16 <= n; i += 16) {
+        m0 = _mm512_max_ps(m0, _mm512_abs_ps(_mm512_loadu_ps(src + i)));
+    }
+    if (i < n) {
+        m1 = _mm512_max_ps(m1, _mm512_abs_ps(_mm512_maskz_loadu_ps(tailMask(n - i), src + i)));
+    }
+    float max = _mm512_reduce_max_ps(_mm512_max_ps(m0, m1));
+    return max;
+}
+
+__attribute__((target("avx512f")))
+static double sumSquaresAVX512(const float* src, size_t n) {
+    __m512d acc0 = _mm512_setzero_pd(), acc1 = _mm512_setzero_pd();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512 v = _mm512_loadu_ps(src + i);
+        __m512d lo = _mm512_cvtps_pd(_mm512_castps512_ps256(v));
+        __m512d hi = _mm512_cvtps_pd(_mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(v), 1)));
+        acc0 = _mm512_add_pd(acc0, _mm512_mul_pd(lo, lo));
+        acc1 = _mm512_add_pd(acc1, _mm512_mul_pd(hi, hi));
+    }
+    double sum = _mm512_reduce_add_pd(_mm512_add_pd(acc0, acc1));
+    for (; i < n; i++) sum += (double)src[i] * src[i];
+    return sum;
+}
+
+__attribute__((target("avx512f")))
+static double sumAbsAVX512(const float* src, size_t n) {
+    __m512d acc0 = _mm512_setzero_pd(), acc1 = _mm512_setzero_pd();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512 v = _mm512_abs_ps(_mm512_loadu_ps(src + i));
+        acc0 = _mm512_add_pd(acc0, _mm512_cvtps_pd(_mm512_castps512_ps256(v)));
+        acc1 = _mm512_add_pd(acc1, _mm512_cvtps_pd(_mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(v), 1))));
+    }
+    double sum = _mm512_reduce_add_pd(_mm512_add_pd(acc0, acc1));
+    for (; i < n; i++) sum += fabsf(src[i]);
+    return sum;
+}
+
+#endif // AUDIO_KERNELS_X86
+
+#ifdef AUDIO_KERNELS_NEON
+
+// --- NEON ---
+
+static void mixAddNEON(const float* src, float* dst, size_t n, float gain) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        vst1q_f32(dst + i, vmlaq_n_f32(vld1q_f32(dst + i), vld1q_f32(src + i), gain));
+    }
+    for (; i < n; i++) dst[i] += src[i] * gain;
+}
+
+static void scaleNEON(const float* src, float* dst, size_t n, float gain) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        vst1q_f32(dst + i, vmulq_n_f32(vld1q_f32(src + i), gain));
+    }
+    for (; i < n; i++) dst[i] = src[i] * gain;
+}
+
+static float peakNEON(const float* src, size_t n) {
+    float32x4_t m = vdupq_n_f32(0.0f);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        m = vmaxq_f32(m, vabsq_f32(vld1q_f32(src + i)));
+    }
+    float max = vmaxvq_f32(m);
+    for (; i < n; i++) {
+        float v = fabsf(src[i]);
+        if (v > max) max = v;
+    }
+    return max;
+}
+
+static double sumSquaresNEON(const float* src, size_t n) {
+    float64x2_t acc0 = vdupq_n_f64(0.0), acc1 = vdupq_n_f64(0.0);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        float32x4_t v = vld1q_f32(src + i);
+        float64x2_t lo = vcvt_f64_f32(vget_low_f32(v));
+        float64x2_t hi = vcvt_high_f64_f32(v);
+        acc0 = vaddq_f64(acc0, vmulq_f64(lo, lo));
+        acc1 = vaddq_f64(acc1, vmulq_f64(hi, hi));
+    }
+    double sum = vaddvq_f64(vaddq_f64(acc0, acc1));
+    for (; i < n; i++) sum += (double)src[i] * src[i];
+    return sum;
+}
+
+static double sumAbsNEON(const float* src, size_t n) {
+    float64x2_t acc0 = vdupq_n_f64(0.0), acc1 = vdupq_n_f64(0.0);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        float32x4_t v = vabsq_f32(vld1q_f32(src + i));
+        acc0 = vaddq_f64(acc0, vcvt_f64_f32(vget_low_f32(v)));
+        acc1 = vaddq_f64(acc1, vcvt_high_f64_f32(v));
+    }
+    double sum = vaddvq_f64(vaddq_f64(acc0, acc1));
+    for (; i < n; i++) sum += fabsf(src[i]);
+    return sum;
+}
+
+#endif // AUDIO_KERNELS_NEON
+
+/**
+ * Returns the block kernels for the current CPU. Selected once, on first use.
+ */
+static const BlockKernels& getBlockKernels() {
+    static const BlockKernels kernels = []() -> BlockKernels {
+#if defined(AUDIO_KERNELS_X86)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) {
+            return { mixAddAVX512, scaleAVX512, peakAVX512, sumSquaresAVX512, sumAbsAVX512, "AVX-512" };
+        }
+        if (__builtin_cpu_supports("avx2")) {
+            return { mixAddAVX2, scaleAVX2, peakAVX2, sumSquaresAVX2, sumAbsAVX2, "AVX2" };
+        }
+        if (__builtin_cpu_supports("sse2")) {
+            return { mixAddSSE2, scaleSSE2, peakSSE2, sumSquaresSSE2, sumAbsSSE2, "SSE2" };
+        }
+#elif defined(AUDIO_KERNELS_NEON)
+        return { mixAddNEON, scaleNEON, peakNEON, sumSquaresNEON, sumAbsNEON, "NEON" };
+#endif
+        return { mixAddScalar, scaleScalar, peakScalar, sumSquaresScalar, sumAbsScalar, "scalar" };
+    }();
+    return kernels;
+}
+
+} // namespace theko::sound::kernels
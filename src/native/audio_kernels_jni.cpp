@@ -0,0 +1,110 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <jni.h>
+
+#include "audio_kernels.hpp"
+
+#include "org_theko_sound_util_NativeAudioKernels.h"
+
+using namespace theko::sound::kernels;
+
+/*
+ * The Java side validates the arrays and lengths, so these only pin the arrays.
+ * Critical access is held for the duration of one kernel call, which never blocks.
+ * Source and destination may be the same array.
+ */
+extern "C" {
+    static bool isInBounds(JNIEnv* env, jfloatArray array, jint length) {
+        return array && length >= 0 && length <= env->GetArrayLength(array);
+    }
+
+    JNIEXPORT jstring JNICALL
+    Java_org_theko_sound_util_NativeAudioKernels_nGetName
+    (JNIEnv* env, jclass clazz) {
+        return env->NewStringUTF(getBlockKernels().name);
+    }
+
+    JNIEXPORT void JNICALL
+    Java_org_theko_sound_util_NativeAudioKernels_nMixAdd
+    (JNIEnv* env, jclass clazz, jfloatArray src, jfloatArray dst, jint length, jfloat gain) {
+        if (!isInBounds(env, src, length) || !isInBounds(env, dst, length) || length == 0) return;
+
+        float* d = (float*)env->GetPrimitiveArrayCritical(dst, nullptr);
+        if (!d) return;
+        float* s = (float*)env->GetPrimitiveArrayCritical(src, nullptr);
+        if (!s) {
+            env->ReleasePrimitiveArrayCritical(dst, d, JNI_ABORT);
+            return;
+        }
+        getBlockKernels().mixAdd(s, d, (size_t)length, gain);
+        env->ReleasePrimitiveArrayCritical(src, s, JNI_ABORT);
+        env->ReleasePrimitiveArrayCritical(dst, d, 0);
+    }
+
+    JNIEXPORT void JNICALL
+    Java_org_theko_sound_util_NativeAudioKernels_nScale
+    (JNIEnv* env, jclass clazz, jfloatArray src, jfloatArray dst, jint length, jfloat gain) {
+        if (!isInBounds(env, src, length) || !isInBounds(env, dst, length) || length == 0) return;
+
+        float* d = (float*)env->GetPrimitiveArrayCritical(dst, nullptr);
+        if (!d) return;
+        float* s = (float*)env->GetPrimitiveArrayCritical(src, nullptr);
+        if (!s) {
+            env->ReleasePrimitiveArrayCritical(dst, d, JNI_ABORT);
+            return;
+        }
+        getBlockKernels().scale(s, d, (size_t)length, gain);
+        env->ReleasePrimitiveArrayCritical(src, s, JNI_ABORT);
+        env->ReleasePrimitiveArrayCritical(dst, d, 0);
+    }
+
+    JNIEXPORT jfloat JNICALL
+    Java_org_theko_sound_util_NativeAudioKernels_nPeak
+    (JNIEnv* env, jclass clazz, jfloatArray src, jint length) {
+        if (!isInBounds(env, src, length) || length == 0) return 0.0f;
+
+        float* s = (float*)env->GetPrimitiveArrayCritical(src, nullptr);
+        if (!s) return 0.0f;
+        float peak = getBlockKernels().peak(s, (size_t)length);
+        env->ReleasePrimitiveArrayCritical(src, s, JNI_ABORT);
+        return peak;
+    }
+
+    JNIEXPORT jdouble JNICALL
+    Java_org_theko_sound_util_NativeAudioKernels_nSumSquares
+    (JNIEnv* env, jclass clazz, jfloatArray src, jint length) {
+        if (!isInBounds(env, src, length) || length == 0) return 0.0;
+
+        float* s = (float*)env->GetPrimitiveArrayCritical(src, nullptr);
+        if (!s) return 0.0;
+        double sum = getBlockKernels().sumSquares(s, (size_t)length);
+        env->ReleasePrimitiveArrayCritical(src, s, JNI_ABORT);
+        return sum;
+    }
+
+    JNIEXPORT jdouble JNICALL
+    Java_org_theko_sound_util_NativeAudioKernels_nSumAbs
+    (JNIEnv* env, jclass clazz, jfloatArray src, jint length) {
+        if (!isInBounds(env, src, length) || length == 0) return 0.0;
+
+        float* s = (float*)env->GetPrimitiveArrayCritical(src, nullptr);
+        if (!s) return 0.0;
+        double sum = getBlockKernels().sumAbs(s, (size_t)length);
+        env->ReleasePrimitiveArrayCritical(src, s, JNI_ABORT);
+        return sum;
+    }
+}
@@ -0,0 +1,491 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#ifndef _WIN32
+#include <pulse/pulseaudio.h>
+
+#include <jni.h>
+#include <string>
+#include <vector>
+
+#include "helper_utilities.hpp"
+
+#include "cache/ThekoSound_AudioFlow.hpp"
+#include "cache/ThekoSound_AudioPort.hpp"
+#include "cache/ThekoSound_AudioFormat.hpp"
+#include "cache/ThekoSound_AudioFormat_Encoding.hpp"
+#include "cache/ThekoSound_PulseAudioPortHandle.hpp"
+
+#include "cache/ThekoSound_UnsupportedAudioEncodingException.hpp"
+#include "cache/ThekoSound_AudioBackendException.hpp"
+
+#include "logger.hpp"
+#include "logger_manager.hpp"
+
+#define PULSE_CLIENT_NAME "Theko-Sound"
+
+/**
+ * Connection to the PulseAudio server (or pipewire-pulse), driven by its own mainloop thread.
+ *
+ * Every call on the context or its streams must be made with the mainloop locked (PulseLock),
+ * callbacks run on the mainloop thread and wake up waiting callers with pa_threaded_mainloop_signal().
+ * JNI is never used from the mainloop thread.
+ */
+class PulseConnection {
+private:
+    static void onContextState(pa_context* context, void* userdata) {
+        pa_threaded_mainloop_signal((pa_threaded_mainloop*)userdata, 0);
+    }
+
+public:
+    pa_threaded_mainloop* mainloop = nullptr;
+    pa_context* context = nullptr;
+
+    PulseConnection() = default;
+    PulseConnection(const PulseConnection&) = delete;
+    PulseConnection& operator=(const PulseConnection&) = delete;
+
+    ~PulseConnection() {
+        disconnect();
+    }
+
+    /**
+     * Starts the mainloop and connects to the default server, without autospawning it.
+     * @return True if the context is ready
+     */
+    bool connect(const char* clientName) {
+        mainloop = pa_threaded_mainloop_new();
+        if (!mainloop) return false;
+
+        context = pa_context_new(pa_threaded_mainloop_get_api(mainloop), clientName);
+        if (!context) {
+            disconnect();
+            return false;
+        }
+        pa_context_set_state_callback(context, onContextState, mainloop);
+
+        pa_threaded_mainloop_lock(mainloop);
+        bool ready = false;
+        if (pa_threaded_mainloop_start(mainloop) >= 0 &&
+            pa_context_connect(context, nullptr, PA_CONTEXT_NOAUTOSPAWN, nullptr) >= 0) {
+            for (;;) {
+                pa_context_state_t state = pa_context_get_state(context);
+                if (state == PA_CONTEXT_READY) {
+                    ready = true;
+                    break;
+                }
+                if (!PA_CONTEXT_IS_GOOD(state)) break;
+                pa_threaded_mainloop_wait(mainloop);
+            }
+        }
+        pa_threaded_mainloop_unlock(mainloop);
+
+        if (!ready) disconnect();
+        return ready;
+    }
+
+    /**
+     * Stops the mainloop and releases the context. Must be called without the lock held.
+     */
+    void disconnect() {
+        if (mainloop) pa_threaded_mainloop_stop(mainloop);
+        if (context) {
+            pa_context_set_state_callback(context, nullptr, nullptr);
+            pa_context_disconnect(context);
+            pa_context_unref(context);
+            context = nullptr;
+        }
+        if (mainloop) {
+            pa_threaded_mainloop_free(mainloop);
+            mainloop = nullptr;
+        }
+    }
+
+    inline bool isReady() const {
+        return context && pa_context_get_state(context) == PA_CONTEXT_READY;
+    }
+
+    /**
+     * Waits with the lock held until the operation completes, its callback must signal the mainloop.
+     * @return False if the operation could not be started or was cancelled
+     */
+    bool wait(pa_operation* operation) {
+        if (!operation) return false;
+        pa_operation_state_t state;
+        while ((state = pa_operation_get_state(operation)) == PA_OPERATION_RUNNING) {
+            pa_threaded_mainloop_wait(mainloop);
+        }
+        pa_operation_unref(operation);
+        return state == PA_OPERATION_DONE;
+    }
+
+    inline const char* lastError() const {
+        return context ? pa_strerror(pa_context_errno(context)) : "No context";
+    }
+};
+
+/**
+ * Scoped mainloop lock.
+ */
+class PulseLock {
+private:
+    pa_threaded_mainloop* mainloop;
+
+public:
+    explicit PulseLock(PulseConnection& connection) : mainloop(connection.mainloop) {
+        pa_threaded_mainloop_lock(mainloop);
+    }
+
+    ~PulseLock() {
+        pa_threaded_mainloop_unlock(mainloop);
+    }
+
+    PulseLock(const PulseLock&) = delete;
+    PulseLock& operator=(const PulseLock&) = delete;
+};
+
+/**
+ * Sink or source description, copied on the mainloop thread and converted to AudioPort later.
+ */
+struct PulsePortInfo {
+    std::string name;        // Sink or source name, used as the port handle
+    std::string description; // Human-readable name
+    std::string vendor;
+    std::string product;
+    pa_sample_spec spec;
+    bool output;
+    bool active;
+};
+
+struct PulsePortQuery {
+    pa_threaded_mainloop* mainloop;
+    std::vector<PulsePortInfo>* ports;
+};
+
+struct PulseServerQuery {
+    pa_threaded_mainloop* mainloop;
+    std::string defaultSink;
+    std::string defaultSource;
+};
+
+static const char* pulseProperty(pa_proplist* proplist, const char* key, const char* fallback) {
+    const char* value = proplist ? pa_proplist_gets(proplist, key) : nullptr;
+    return (value && *value) ? value : fallback;
+}
+
+static void onSinkInfo(pa_context* context, const pa_sink_info* info, int eol, void* userdata) {
+    auto* query = (PulsePortQuery*)userdata;
+    if (eol != 0 || !info) {
+        pa_threaded_mainloop_signal(query->mainloop, 0);
+        return;
+    }
+
+    PulsePortInfo port;
+    port.name = info->name ? info->name : "";
+    port.description = info->description ? info->description : port.name;
+    port.vendor = pulseProperty(info->proplist, PA_PROP_DEVICE_VENDOR_NAME, info->driver ? info->driver : "Unknown");
+    port.product = pulseProperty(info->proplist, PA_PROP_DEVICE_PRODUCT_NAME, port.name.c_str());
+    port.spec = info->sample_spec;
+    port.output = true;
+    // Unplugged jacks keep their sink, but cannot play
+    port.active = info->state != PA_SINK_INVALID_STATE &&
+        !(info->active_port && info->active_port->available == PA_PORT_AVAILABLE_NO);
+    query->ports->push_back(port);
+}
+
+static void onSourceInfo(pa_context* context, const pa_source_info* info, int eol, void* userdata) {
+    auto* query = (PulsePortQuery*)userdata;
+    if (eol != 0 || !info) {
+        pa_threaded_mainloop_signal(query->mainloop, 0);
+        return;
+    }
+    // Monitors of sinks are not capture devices
+    if (info->monitor_of_sink != PA_INVALID_INDEX) return;
+
+    PulsePortInfo port;
+    port.name = info->name ? info->name : "";
+    port.description = info->description ? info->description : port.name;
+    port.vendor = pulseProperty(info->proplist, PA_PROP_DEVICE_VENDOR_NAME, info->driver ? info->driver : "Unknown");
+    port.product = pulseProperty(info->proplist, PA_PROP_DEVICE_PRODUCT_NAME, port.name.c_str());
+    port.spec = info->sample_spec;
+    port.output = false;
+    port.active = info->state != PA_SOURCE_INVALID_STATE &&
+        !(info->active_port && info->active_port->available == PA_PORT_AVAILABLE_NO);
+    query->ports->push_back(port);
+}
+
+static void onServerInfo(pa_context* context, const pa_server_info* info, void* userdata) {
+    auto* query = (PulseServerQuery*)userdata;
+    if (info) {
+        query->defaultSink = info->default_sink_name ? info->default_sink_name : "";
+        query->defaultSource = info->default_source_name ? info->default_source_name : "";
+    }
+    pa_threaded_mainloop_signal(query->mainloop, 0);
+}
+
+/**
+ * Lists the sinks and/or sources of the server. The mainloop must be locked.
+ */
+static bool queryPulsePorts(PulseConnection& connection, bool sinks, bool sources, std::vector<PulsePortInfo>* ports) {
+    PulsePortQuery query = { connection.mainloop, ports };
+    bool ok = true;
+    if (sinks) ok &= connection.wait(pa_context_get_sink_info_list(connection.context, onSinkInfo, &query));
+    if (sources) ok &= connection.wait(pa_context_get_source_info_list(connection.context, onSourceInfo, &query));
+    return ok;
+}
+
+/**
+ * Looks up a single sink or source by name. The mainloop must be locked.
+ */
+static bool queryPulsePort(PulseConnection& connection, bool output, const char* name, PulsePortInfo* port) {
+    std::vector<PulsePortInfo> ports;
+    PulsePortQuery query = { connection.mainloop, &ports };
+    pa_operation* operation = output
+        ? pa_context_get_sink_info_by_name(connection.context, name, onSinkInfo, &query)
+        : pa_context_get_source_info_by_name(connection.context, name, onSourceInfo, &query);
+    if (!connection.wait(operation) || ports.empty()) return false;
+    *port = ports.front();
+    return true;
+}
+
+/**
+ * Reads the default sink and source names. The mainloop must be locked.
+ */
+static bool queryPulseDefaults(PulseConnection& connection, std::string* defaultSink, std::string* defaultSource) {
+    PulseServerQuery query = { connection.mainloop, "", "" };
+    if (!connection.wait(pa_context_get_server_info(connection.context, onServerInfo, &query))) return false;
+    if (defaultSink) *defaultSink = query.defaultSink;
+    if (defaultSource) *defaultSource = query.defaultSource;
+    return true;
+}
+
+/**
+ * Converts a pa_sample_spec to a org.theko.sound.AudioFormat object.
+ *
+ * @param env the JNI environment
+ * @param spec the sample specification
+ * @return the AudioFormat object, or nullptr if the sample format has no AudioFormat equivalent (e.g. S24_32)
+ */
+static jobject pa_sample_spec_to_AudioFormat(JNIEnv* env, const pa_sample_spec* spec) {
+    Logger* logger = NATIVE_LOGGER(env, "NATIVE: PulseBridge.pa_sample_spec -> AudioFormat");
+
+    if (!spec) return nullptr;
+
+    jobject jAudioEncoding = nullptr;
+    int bits = 0;
+    bool bigEndian = false;
+    switch (spec->format) {
+        case PA_SAMPLE_U8:
+            jAudioEncoding = ThekoSound_AudioFormat_Encoding::getField__PCM_UNSIGNED(env);
+            bits = 8;
+            break;
+        case PA_SAMPLE_ALAW:
+            jAudioEncoding = ThekoSound_AudioFormat_Encoding::getField__ALAW(env);
+            bits = 8;
+            break;
+        case PA_SAMPLE_ULAW:
+            jAudioEncoding = ThekoSound_AudioFormat_Encoding::getField__ULAW(env);
+            bits = 8;
+            break;
+        case PA_SAMPLE_S16LE: case PA_SAMPLE_S16BE:
+            jAudioEncoding = ThekoSound_AudioFormat_Encoding::getField__PCM_SIGNED(env);
+            bits = 16;
+            bigEndian = spec->format == PA_SAMPLE_S16BE;
+            break;
+        case PA_SAMPLE_S24LE: case PA_SAMPLE_S24BE:
+            jAudioEncoding = ThekoSound_AudioFormat_Encoding::getField__PCM_SIGNED(env);
+            bits = 24;
+            bigEndian = spec->format == PA_SAMPLE_S24BE;
+            break;
+        case PA_SAMPLE_S32LE: case PA_SAMPLE_S32BE:
+            jAudioEncoding = ThekoSound_AudioFormat_Encoding::getField__PCM_SIGNED(env);
+            bits = 32;
+            bigEndian = spec->format == PA_SAMPLE_S32BE;
+            break;
+        case PA_SAMPLE_FLOAT32LE: case PA_SAMPLE_FLOAT32BE:
+            jAudioEncoding = ThekoSound_AudioFormat_Encoding::getField__PCM_FLOAT(env);
+            bits = 32;
+            bigEndian = spec->format == PA_SAMPLE_FLOAT32BE;
+            break;
+        default:
+            logger->debug(env, "No AudioFormat equivalent for sample format: %s.", pa_sample_format_to_string(spec->format));
+            return nullptr;
+    }
+
+    jobject jAudioFormat = ThekoSound_AudioFormat::createInstance(env, (jint)spec->rate, bits, (jint)spec->channels, jAudioEncoding, bigEndian);
+    if (jAudioEncoding) env->DeleteLocalRef(jAudioEncoding);
+    logger->trace(env, "Created Java AudioFormat object. Pointer: %s", FORMAT_PTR(jAudioFormat));
+
+    return jAudioFormat;
+}
+
+/**
+ * Converts a org.theko.sound.AudioFormat object to a pa_sample_spec.
+ *
+ * An unsupported encoding throws UnsupportedAudioEncodingException, a bit depth or channel count
+ * that PulseAudio cannot represent only returns false.
+ *
+ * @param env the JNI environment
+ * @param audioFormat the Java AudioFormat object to be converted
+ * @param spec the sample specification to fill
+ * @return true if the format was converted to a valid sample specification
+ */
+static bool AudioFormat_to_pa_sample_spec(JNIEnv* env, jobject audioFormat, pa_sample_spec* spec) {
+    Logger* logger = NATIVE_LOGGER(env, "NATIVE: PulseBridge.AudioFormat -> pa_sample_spec");
+
+    if (!audioFormat || !spec) return false;
+
+    int sampleRate = ThekoSound_AudioFormat::getSampleRate(env, audioFormat);
+    int bits = ThekoSound_AudioFormat::getBitsPerSample(env, audioFormat);
+    int channels = ThekoSound_AudioFormat::getChannels(env, audioFormat);
+    bool bigEndian = ThekoSound_AudioFormat::isBigEndian(env, audioFormat);
+    jobject audioEncoding = ThekoSound_AudioFormat::getEncoding(env, audioFormat);
+
+    logger->trace(env, "SampleRate=%d, Bits=%d, Channels=%d, BigEndian=%d, AudioEncoding=%p", sampleRate, bits, channels, bigEndian, audioEncoding);
+
+    if (!audioEncoding) {
+        logger->error(env, "Unsupported audio format encoding.");
+        env->ThrowNew(ThekoSound_UnsupportedAudioEncodingException::getClazz(env), "Unsupported audio format encoding.");
+        return false;
+    }
+
+    pa_sample_format_t format = PA_SAMPLE_INVALID;
+    if (env->IsSameObject(audioEncoding, ThekoSound_AudioFormat_Encoding::getField__PCM_UNSIGNED(env))) {
+        if (bits == 8) format = PA_SAMPLE_U8;
+    } else if (env->IsSameObject(audioEncoding, ThekoSound_AudioFormat_Encoding::getField__PCM_SIGNED(env))) {
+        if (bits == 16) format = bigEndian ? PA_SAMPLE_S16BE : PA_SAMPLE_S16LE;
+        else if (bits == 24) format = bigEndian ? PA_SAMPLE_S24BE : PA_SAMPLE_S24LE;
+        else if (bits == 32) format = bigEndian ? PA_SAMPLE_S32BE : PA_SAMPLE_S32LE;
+    } else if (env->IsSameObject(audioEncoding, ThekoSound_AudioFormat_Encoding::getField__PCM_FLOAT(env))) {
+        if (bits == 32) format = bigEndian ? PA_SAMPLE_FLOAT32BE : PA_SAMPLE_FLOAT32LE;
+    } else if (env->IsSameObject(audioEncoding, ThekoSound_AudioFormat_Encoding::getField__ALAW(env))) {
+        if (bits == 8) format = PA_SAMPLE_ALAW;
+    } else if (env->IsSameObject(audioEncoding, ThekoSound_AudioFormat_Encoding::getField__ULAW(env))) {
+        if (bits == 8) format = PA_SAMPLE_ULAW;
+    } else {
+        env->DeleteLocalRef(audioEncoding);
+        logger->error(env, "Unsupported audio format encoding.");
+        env->ThrowNew(ThekoSound_UnsupportedAudioEncodingException::getClazz(env), "Unsupported audio format encoding.");
+        return false;
+    }
+    env->DeleteLocalRef(audioEncoding);
+
+    spec->format = format;
+    spec->rate = sampleRate > 0 ? (uint32_t)sampleRate : 0;
+    spec->channels = (channels > 0 && channels <= (int)PA_CHANNELS_MAX) ? (uint8_t)channels : 0;
+
+    if (!pa_sample_spec_valid(spec)) {
+        logger->debug(env, "No valid sample specification for %d Hz, %d bits, %d channels.", sampleRate, bits, channels);
+        return false;
+    }
+    logger->trace(env, "Sample specification: %s, %u Hz, %u channels.", pa_sample_format_to_string(spec->format), spec->rate, spec->channels);
+    return true;
+}
+
+/**
+ * Creates the channel map of a stream, in the WAVEFORMATEXTENSIBLE channel order
+ * used for interleaved AudioFormat data.
+ */
+static inline void pulseChannelMap(const pa_sample_spec* spec, pa_channel_map* map) {
+    pa_channel_map_init_extend(map, spec->channels, PA_CHANNEL_MAP_WAVEEX);
+}
+
+/**
+ * Converts a sink or source description to a org.theko.sound.AudioPort object.
+ *
+ * @param env the JNI environment
+ * @param port the port description
+ * @return the AudioPort object, or nullptr if the conversion fails
+ */
+static jobject PulsePortInfo_to_AudioPort(JNIEnv* env, const PulsePortInfo& port) {
+    Logger* logger = NATIVE_LOGGER(env, "NATIVE: PulseBridge.PulsePortInfo -> AudioPort");
+
+    jstring jHandle = env->NewStringUTF(port.name.c_str());
+    if (!jHandle) {
+        const char* msg = "Failed to create PulseAudio port handle";
+        logger->error(env, msg);
+        env->ThrowNew(ThekoSound_AudioBackendException::getClazz(env), msg);
+        return nullptr;
+    }
+
+    jobject jNativeHandleObj = ThekoSound_PulseAudioPortHandle::createInstance(env, jHandle);
+    logger->trace(env, "Created PulseAudio native handle. Name: %s, Pointer: %s", port.name.c_str(), FORMAT_PTR(jNativeHandleObj));
+
+    jobject jFlowObj = port.output ? ThekoSound_AudioFlow::getField__OUT(env) : ThekoSound_AudioFlow::getField__IN(env);
+    jobject jAudioMixFormat = pa_sample_spec_to_AudioFormat(env, &port.spec);
+
+    jstring jName = env->NewStringUTF(port.description.c_str());
+    jstring jManufacturer = env->NewStringUTF(port.vendor.c_str());
+    jstring jVersion = env->NewStringUTF("Unknown");
+    jstring jDescription = env->NewStringUTF(port.product.c_str());
+
+    jobject jAudioPort = ThekoSound_AudioPort::createInstance(env, jNativeHandleObj, jFlowObj, port.active ? JNI_TRUE : JNI_FALSE,
+            jAudioMixFormat, jName, jManufacturer, jVersion, jDescription);
+    logger->trace(env, "Created AudioPort. Pointer: %s", FORMAT_PTR(jAudioPort));
+
+    env->DeleteLocalRef(jHandle);
+    if (jNativeHandleObj) env->DeleteLocalRef(jNativeHandleObj);
+    if (jFlowObj) env->DeleteLocalRef(jFlowObj);
+    if (jAudioMixFormat) env->DeleteLocalRef(jAudioMixFormat);
+    env->DeleteLocalRef(jName);
+    env->DeleteLocalRef(jManufacturer);
+    env->DeleteLocalRef(jVersion);
+    env->DeleteLocalRef(jDescription);
+
+    return jAudioPort;
+}
+
+/**
+ * Reads the sink or source name of an org.theko.sound.AudioPort.
+ *
+ * @param env The JNI environment
+ * @param jAudioPort The AudioPort to convert
+ * @param name The name to fill
+ * @return False if the port is not a PulseAudio port
+ */
+static bool AudioPort_to_pulse_name(JNIEnv* env, jobject jAudioPort, std::string* name) {
+    Logger* logger = NATIVE_LOGGER(env, "NATIVE: PulseBridge.AudioPort -> name");
+
+    if (!jAudioPort || !env->IsInstanceOf(jAudioPort, ThekoSound_AudioPort::getClazz(env))) {
+        logger->warn(env, "Invalid or null AudioPort.");
+        return false;
+    }
+
+    jobject jNativeHandle = ThekoSound_AudioPort::getLink(env, jAudioPort);
+    if (!jNativeHandle || !env->IsInstanceOf(jNativeHandle, ThekoSound_PulseAudioPortHandle::getClazz(env))) {
+        logger->warn(env, "Invalid or null native handle.");
+        if (jNativeHandle) env->DeleteLocalRef(jNativeHandle);
+        return false;
+    }
+
+    jstring jHandle = ThekoSound_PulseAudioPortHandle::getHandle(env, jNativeHandle);
+    env->DeleteLocalRef(jNativeHandle);
+    if (!jHandle) {
+        logger->warn(env, "Invalid or null handle.");
+        return false;
+    }
+
+    const char* handle = env->GetStringUTFChars(jHandle, nullptr);
+    if (handle) {
+        *name = handle;
+        env->ReleaseStringUTFChars(jHandle, handle);
+    }
+    env->DeleteLocalRef(jHandle);
+    return handle != nullptr;
+}
+#endif // !_WIN32
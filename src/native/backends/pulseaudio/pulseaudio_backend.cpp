@@ -0,0 +1,211 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <jni.h>
+
+#include <pulse/pulseaudio.h>
+#include <algorithm>
+#include <vector>
+
+#include "logger.hpp"
+#include "logger_manager.hpp"
+#include "helper_utilities.hpp"
+
+#include "org_theko_sound_backends_pulseaudio_PulseAudioBackend.h"
+#include "cache/Java_Concurrent_AtomicReference.hpp"
+
+#include "libpulse_bridge.hpp"
+
+namespace theko::sound::backend::pulseaudio {
+
+class BackendContext {
+public:
+    PulseConnection connection;
+};
+
+extern "C" {
+    static BackendContext* getContext(JNIEnv* env, Logger* logger, jlong ptr) {
+        auto* ctx = (BackendContext*)ptr;
+        if (!ctx) {
+            logger->warn(env, "PulseAudio backend not initialized.");
+            env->ThrowNew(ThekoSound_AudioBackendException::getClazz(env), "PulseAudio backend not initialized.");
+            return nullptr;
+        }
+        if (!ctx->connection.isReady()) {
+            logger->warn(env, "PulseAudio connection lost.");
+            env->ThrowNew(ThekoSound_AudioBackendException::getClazz(env), "PulseAudio connection lost.");
+            return nullptr;
+        }
+        return ctx;
+    }
+
+    JNIEXPORT jlong JNICALL
+    Java_org_theko_sound_backends_pulseaudio_PulseAudioBackend_nInit
+    (JNIEnv* env, jobject obj) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: PulseAudioBackend.nInit");
+
+        auto* ctx = new BackendContext();
+        if (!ctx->connection.connect(PULSE_CLIENT_NAME)) {
+            logger->error(env, "Failed to connect to the PulseAudio server (%s).", ctx->connection.lastError());
+            delete ctx;
+            env->ThrowNew(ThekoSound_AudioBackendException::getClazz(env), "Failed to connect to the PulseAudio server.");
+            return 0;
+        }
+
+        if (logger->isDebugEnabled()) {
+            PulseLock lock(ctx->connection);
+            logger->debug(env, "Connected to PulseAudio server: %s, protocol: %u. ContextPtr: %s",
+                pa_context_get_server(ctx->connection.context),
+                pa_context_get_server_protocol_version(ctx->connection.context), FORMAT_PTR(ctx));
+        }
+
+        return (jlong)ctx;
+    }
+
+    JNIEXPORT void JNICALL
+    Java_org_theko_sound_backends_pulseaudio_PulseAudioBackend_nShutdown
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: PulseAudioBackend.nShutdown");
+
+        auto* ctx = (BackendContext*)ptr;
+        if (!ctx) {
+            logger->warn(env, "PulseAudio backend not initialized.");
+            env->ThrowNew(ThekoSound_AudioBackendException::getClazz(env), "PulseAudio backend not initialized.");
+            return;
+        }
+        ctx->connection.disconnect();
+        delete ctx;
+
+        logger->debug(env, "Shutdown PulseAudio backend.");
+    }
+
+    JNIEXPORT jobjectArray JNICALL
+    Java_org_theko_sound_backends_pulseaudio_PulseAudioBackend_nGetAllPorts
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: PulseAudioBackend.nGetAllPorts");
+
+        auto* ctx = getContext(env, logger, ptr);
+        if (!ctx) return nullptr;
+
+        std::vector<PulsePortInfo> ports;
+        bool ok;
+        {
+            PulseLock lock(ctx->connection);
+            ok = queryPulsePorts(ctx->connection, true, true, &ports);
+        }
+        if (!ok) {
+            logger->warn(env, "Failed to list sinks and sources (%s).", ctx->connection.lastError());
+        }
+        logger->trace(env, "Found %d sinks and sources.", (int)ports.size());
+
+        // JNI work happens here, after the mainloop was released
+        std::vector<jobject> jports;
+        jports.reserve(ports.size());
+        for (const PulsePortInfo& port : ports) {
+            jobject jport = PulsePortInfo_to_AudioPort(env, port);
+            if (!jport) {
+                logger->warn(env, "Failed to convert port: %s.", port.name.c_str());
+                if (env->ExceptionCheck()) env->ExceptionClear();
+                continue;
+            }
+            jports.push_back(jport);
+        }
+
+        jobjectArray result = env->NewObjectArray((jsize)jports.size(), ThekoSound_AudioPort::getClazz(env), nullptr);
+        for (size_t i = 0; i < jports.size(); i++) {
+            if (result) env->SetObjectArrayElement(result, (jsize)i, jports[i]);
+            env->DeleteLocalRef(jports[i]);
+        }
+        return result;
+    }
+
+    JNIEXPORT jobject JNICALL
+    Java_org_theko_sound_backends_pulseaudio_PulseAudioBackend_nGetDefaultPort
+    (JNIEnv* env, jobject obj, jlong ptr, jobject flowObj) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: PulseAudioBackend.nGetDefaultPort");
+
+        if (!flowObj) return nullptr;
+
+        auto* ctx = getContext(env, logger, ptr);
+        if (!ctx) return nullptr;
+
+        bool output;
+        if (env->IsSameObject(flowObj, ThekoSound_AudioFlow::getField__OUT(env))) {
+            output = true;
+        } else if (env->IsSameObject(flowObj, ThekoSound_AudioFlow::getField__IN(env))) {
+            output = false;
+        } else {
+            return nullptr;
+        }
+
+        PulsePortInfo port;
+        bool found = false;
+        {
+            PulseLock lock(ctx->connection);
+            std::string defaultSink, defaultSource;
+            if (queryPulseDefaults(ctx->connection, &defaultSink, &defaultSource)) {
+                const std::string& name = output ? defaultSink : defaultSource;
+                found = !name.empty() && queryPulsePort(ctx->connection, output, name.c_str(), &port);
+            }
+        }
+        if (!found) {
+            logger->debug(env, "No default %s (%s).", output ? "sink" : "source", ctx->connection.lastError());
+            return nullptr;
+        }
+        logger->trace(env, "Default %s: %s", output ? "sink" : "source", port.name.c_str());
+
+        return PulsePortInfo_to_AudioPort(env, port);
+    }
+
+    JNIEXPORT jboolean JNICALL
+    Java_org_theko_sound_backends_pulseaudio_PulseAudioBackend_nIsFormatSupported
+    (JNIEnv* env, jobject obj, jobject jport, jobject jformat, jobject atomicClosestFormat) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: PulseAudioBackend.nIsFormatSupported");
+
+        if (!jport || !jformat) {
+            logger->info(env, "AudioPort or AudioFormat is null.");
+            return JNI_FALSE;
+        }
+
+        std::string name;
+        if (!AudioPort_to_pulse_name(env, jport, &name)) {
+            logger->warn(env, "Not a PulseAudio port.");
+            return JNI_FALSE;
+        }
+
+        // The server converts any valid sample specification to the device format
+        pa_sample_spec spec = {};
+        if (AudioFormat_to_pa_sample_spec(env, jformat, &spec)) {
+            logger->trace(env, "Format is supported on %s.", name.c_str());
+            return JNI_TRUE;
+        }
+        if (env->ExceptionCheck()) env->ExceptionClear();
+
+        // Suggest 32-bit float with the same rate and channels, if those are valid
+        pa_sample_spec closest = {};
+        closest.format = PA_SAMPLE_FLOAT32LE;
+        closest.rate = (uint32_t)std::max(ThekoSound_AudioFormat::getSampleRate(env, jformat), 0);
+        closest.channels = (uint8_t)std::min(std::max(ThekoSound_AudioFormat::getChannels(env, jformat), 0), (int)PA_CHANNELS_MAX);
+        if (atomicClosestFormat && pa_sample_spec_valid(&closest)) {
+            jobject jAudioFormat = pa_sample_spec_to_AudioFormat(env, &closest);
+            Java_Concurrent_AtomicReference::set(env, atomicClosestFormat, jAudioFormat);
+            if (jAudioFormat) env->DeleteLocalRef(jAudioFormat);
+        }
+        logger->trace(env, "Format is not supported.");
+        return JNI_FALSE;
+    }
+}
+}
@@ -0,0 +1,540 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <jni.h>
+
+#include <pulse/pulseaudio.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <string.h>
+#include <thread>
+
+#include "logger.hpp"
+#include "logger_manager.hpp"
+#include "helper_utilities.hpp"
+
+#include "org_theko_sound_backends_pulseaudio_PulseAudioInput.h"
+#include "cache/Java_Concurrent_AtomicReference.hpp"
+#include "cache/ThekoSound_UnsupportedAudioFormatException.hpp"
+#include "cache/ThekoSound_DeviceInvalidatedException.hpp"
+
+#include "libpulse_bridge.hpp"
+
+#define STREAM_NAME "Capture"
+#define PERIODS_PER_BUFFER 4
+#define LOW_LATENCY_PERIODS_PER_BUFFER 8
+
+namespace theko::sound::backend::pulseaudio::input {
+
+class InputContext {
+public:
+    PulseConnection connection;
+    pa_stream* stream = nullptr;
+    pa_sample_spec spec = {};
+    size_t frameSize = 0;
+
+    // Fragment returned by pa_stream_peek(), dropped once fully read
+    const uint8_t* fragment = nullptr;
+    size_t fragmentLength = 0;
+    size_t fragmentOffset = 0;
+
+    std::atomic<bool> started{false};
+    std::atomic<uint64_t> overflows{0};
+    std::atomic<uint64_t> holes{0};
+    uint64_t readBytes = 0;
+
+    // Signalled by the read callback, waited on by nWaitForData without the mainloop lock
+    std::mutex dataLock;
+    std::condition_variable dataReady;
+    bool dataPending = false;
+
+    InputContext() = default;
+    InputContext(const InputContext&) = delete;
+    InputContext& operator=(const InputContext&) = delete;
+};
+
+/*
+ * Stream callbacks, called on the mainloop thread.
+ */
+static void onStreamState(pa_stream* stream, void* userdata) {
+    auto context = (InputContext*)userdata;
+    pa_threaded_mainloop_signal(context->connection.mainloop, 0);
+
+    // Wake up readers, the stream cannot deliver anymore
+    if (!PA_STREAM_IS_GOOD(pa_stream_get_state(stream))) {
+        std::lock_guard<std::mutex> lock(context->dataLock);
+        context->dataPending = true;
+        context->dataReady.notify_all();
+    }
+}
+
+static void onStreamSuccess(pa_stream* stream, int success, void* userdata) {
+    pa_threaded_mainloop_signal(((InputContext*)userdata)->connection.mainloop, 0);
+}
+
+static void onStreamRead(pa_stream* stream, size_t nbytes, void* userdata) {
+    auto context = (InputContext*)userdata;
+    std::lock_guard<std::mutex> lock(context->dataLock);
+    context->dataPending = true;
+    context->dataReady.notify_all();
+}
+
+static void onStreamOverflow(pa_stream* stream, void* userdata) {
+    ((InputContext*)userdata)->overflows.fetch_add(1, std::memory_order_relaxed);
+}
+
+static void dropFragment(InputContext* context) {
+    if (context->fragmentLength > 0) pa_stream_drop(context->stream);
+    context->fragment = nullptr;
+    context->fragmentLength = 0;
+    context->fragmentOffset = 0;
+}
+
+/*
+ * Copies up to length bytes of captured data, keeping the rest of a partially read fragment
+ * for the next call. The mainloop must be locked.
+ */
+template <typename CopyFn>
+static size_t readFrames(InputContext* context, size_t length, CopyFn copy) {
+    length -= length % context->frameSize;
+
+    size_t read = 0;
+    while (read < length) {
+        if (context->fragmentLength == 0) {
+            const void* data = nullptr;
+            size_t nbytes = 0;
+            if (pa_stream_peek(context->stream, &data, &nbytes) < 0 || nbytes == 0) break;
+            if (!data) {
+                // A hole in the stream, nothing to copy
+                context->holes.fetch_add(1, std::memory_order_relaxed);
+                pa_stream_drop(context->stream);
+                continue;
+            }
+            context->fragment = (const uint8_t*)data;
+            context->fragmentLength = nbytes;
+            context->fragmentOffset = 0;
+        }
+
+        size_t chunk = std::min(length - read, context->fragmentLength - context->fragmentOffset);
+        copy(context->fragment + context->fragmentOffset, read, chunk);
+        context->fragmentOffset += chunk;
+        read += chunk;
+
+        if (context->fragmentOffset >= context->fragmentLength) dropFragment(context);
+    }
+    context->readBytes += read;
+    return read;
+}
+
+static size_t availableBytes(InputContext* context) {
+    size_t readable = pa_stream_readable_size(context->stream);
+    if (readable == (size_t)-1) readable = 0;
+    return readable + (context->fragmentLength - context->fragmentOffset);
+}
+
+extern "C" {
+    static void cleanupAndThrowError(JNIEnv* env, Logger* logger, InputContext* context, const char* msg) {
+        const char* reason = context ? context->connection.lastError() : "No context";
+        logger->error(env, "%s (%s)", msg, reason);
+        if (context) {
+            if (context->stream) {
+                pa_threaded_mainloop_lock(context->connection.mainloop);
+                pa_stream_set_state_callback(context->stream, nullptr, nullptr);
+                pa_stream_set_read_callback(context->stream, nullptr, nullptr);
+                pa_stream_set_overflow_callback(context->stream, nullptr, nullptr);
+                pa_stream_disconnect(context->stream);
+                pa_stream_unref(context->stream);
+                context->stream = nullptr;
+                pa_threaded_mainloop_unlock(context->connection.mainloop);
+            }
+            context->connection.disconnect();
+            delete context;
+        }
+        env->ThrowNew(ThekoSound_AudioBackendException::getClazz(env), msg);
+    }
+
+    static bool canRead(JNIEnv* env, Logger* logger, InputContext* context) {
+        if (!context || !context->stream) {
+            logger->info(env, "PulseAudio input not opened.");
+            return false;
+        }
+        if (pa_stream_get_state(context->stream) != PA_STREAM_READY) {
+            logger->warn(env, "Stream is no longer ready (%s).", context->connection.lastError());
+            env->ThrowNew(ThekoSound_DeviceInvalidatedException::getClazz(env), "Stream invalidated.");
+            return false;
+        }
+        return true;
+    }
+
+    JNIEXPORT jlong JNICALL
+    Java_org_theko_sound_backends_pulseaudio_PulseAudioInput_nOpen
+    (JNIEnv* env, jobject obj, jobject jport, jobject jformat, jint bufferSize /* in bytes */, jobject jAtomicRefFormat, jboolean lowLatency) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: PulseAudioInput.nOpen");
+
+        if (!jport || !jformat || !jAtomicRefFormat) return 0;
+
+        std::string device;
+        if (!AudioPort_to_pulse_name(env, jport, &device)) {
+            env->ThrowNew(ThekoSound_AudioBackendException::getClazz(env), "Not a PulseAudio port.");
+            return 0;
+        }
+
+        pa_sample_spec spec = {};
+        if (!AudioFormat_to_pa_sample_spec(env, jformat, &spec)) {
+            if (!env->ExceptionCheck()) {
+                env->ThrowNew(ThekoSound_UnsupportedAudioFormatException::getClazz(env), "Unsupported audio format.");
+            }
+            return 0;
+        }
+
+        auto context = new InputContext();
+        logger->trace(env, "InputContext allocated. Pointer: %s", FORMAT_PTR(context));
+
+        context->spec = spec;
+        context->frameSize = pa_frame_size(&spec);
+        if (!context->connection.connect(PULSE_CLIENT_NAME)) {
+            cleanupAndThrowError(env, logger, context, "Failed to connect to the PulseAudio server.");
+            return 0;
+        }
+
+        pa_channel_map map;
+        pulseChannelMap(&spec, &map);
+
+        // The server keeps up to maxlength bytes for us and delivers fragsize bytes per read callback
+        uint32_t frameSize = (uint32_t)context->frameSize;
+        uint32_t maxlength = std::max<uint32_t>((uint32_t)std::max<jint>(bufferSize, 0) / frameSize, 1) * frameSize;
+        uint32_t fragsize = std::max<uint32_t>(maxlength / (lowLatency ? LOW_LATENCY_PERIODS_PER_BUFFER : PERIODS_PER_BUFFER) / frameSize, 1) * frameSize;
+
+        pa_buffer_attr attr;
+        attr.maxlength = maxlength;
+        attr.tlength = (uint32_t)-1;
+        attr.prebuf = (uint32_t)-1;
+        attr.minreq = (uint32_t)-1;
+        attr.fragsize = fragsize;
+
+        pa_stream_flags_t flags = (pa_stream_flags_t)(PA_STREAM_START_CORKED | PA_STREAM_ADJUST_LATENCY |
+            PA_STREAM_INTERPOLATE_TIMING | PA_STREAM_AUTO_TIMING_UPDATE);
+
+        bool ready = false;
+        pa_threaded_mainloop_lock(context->connection.mainloop);
+        context->stream = pa_stream_new(context->connection.context, STREAM_NAME, &spec, &map);
+        if (context->stream) {
+            pa_stream_set_state_callback(context->stream, onStreamState, context);
+            pa_stream_set_read_callback(context->stream, onStreamRead, context);
+            pa_stream_set_overflow_callback(context->stream, onStreamOverflow, context);
+
+            if (pa_stream_connect_record(context->stream, device.empty() ? nullptr : device.c_str(), &attr, flags) >= 0) {
+                for (;;) {
+                    pa_stream_state_t state = pa_stream_get_state(context->stream);
+                    if (state == PA_STREAM_READY) {
+                        ready = true;
+                        break;
+                    }
+                    if (!PA_STREAM_IS_GOOD(state)) break;
+                    pa_threaded_mainloop_wait(context->connection.mainloop);
+                }
+            }
+        }
+
+        pa_sample_spec openedSpec = spec;
+        if (ready) {
+            const pa_buffer_attr* opened = pa_stream_get_buffer_attr(context->stream);
+            const pa_sample_spec* streamSpec = pa_stream_get_sample_spec(context->stream);
+            if (streamSpec) openedSpec = *streamSpec;
+            if (opened) {
+                logger->debug(env, "Buffer attributes. Requested maxlength: %u, fragsize: %u. Opened maxlength: %u, fragsize: %u.",
+                    maxlength, fragsize, opened->maxlength, opened->fragsize);
+            }
+        }
+        pa_threaded_mainloop_unlock(context->connection.mainloop);
+
+        if (!ready) {
+            cleanupAndThrowError(env, logger, context, "Failed to connect record stream.");
+            return 0;
+        }
+
+        jobject jOpenedFormat = pa_sample_spec_to_AudioFormat(env, &openedSpec);
+        Java_Concurrent_AtomicReference::set(env, jAtomicRefFormat, jOpenedFormat);
+        if (jOpenedFormat) env->DeleteLocalRef(jOpenedFormat);
+
+        logger->debug(env, "Opened PulseAudio input on %s. ContextPtr: %s", device.c_str(), FORMAT_PTR(context));
+        return (jlong)context;
+    }
+
+    JNIEXPORT void JNICALL
+    Java_org_theko_sound_backends_pulseaudio_PulseAudioInput_nClose
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: PulseAudioInput.nClose");
+
+        auto context = (InputContext*)ptr;
+        if (!context) {
+            logger->debug(env, "PulseAudio input already closed.");
+            return;
+        }
+
+        if (context->stream) {
+            PulseLock lock(context->connection);
+            dropFragment(context);
+            pa_stream_set_state_callback(context->stream, nullptr, nullptr);
+            pa_stream_set_read_callback(context->stream, nullptr, nullptr);
+            pa_stream_set_overflow_callback(context->stream, nullptr, nullptr);
+            pa_stream_disconnect(context->stream);
+            pa_stream_unref(context->stream);
+            context->stream = nullptr;
+        }
+        context->connection.disconnect();
+        delete context;
+
+        logger->debug(env, "Closed PulseAudio input.");
+    }
+
+    static void corkStream(JNIEnv* env, Logger* logger, InputContext* context, bool cork) {
+        if (!canRead(env, logger, context)) return;
+
+        PulseLock lock(context->connection);
+        if (!context->connection.wait(pa_stream_cork(context->stream, cork ? 1 : 0, onStreamSuccess, context))) {
+            logger->error(env, "Failed to %s stream (%s).", cork ? "cork" : "uncork", context->connection.lastError());
+            env->ThrowNew(ThekoSound_AudioBackendException::getClazz(env), cork ? "Failed to stop stream." : "Failed to start stream.");
+            return;
+        }
+        context->started.store(!cork, std::memory_order_release);
+
+        if (cork) {
+            std::lock_guard<std::mutex> dataGuard(context->dataLock);
+            context->dataPending = true; // Wake up waiting readers
+            context->dataReady.notify_all();
+        }
+    }
+
+    JNIEXPORT void JNICALL
+    Java_org_theko_sound_backends_pulseaudio_PulseAudioInput_nStart
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: PulseAudioInput.nStart");
+        corkStream(env, logger, (InputContext*)ptr, false);
+    }
+
+    JNIEXPORT void JNICALL
+    Java_org_theko_sound_backends_pulseaudio_PulseAudioInput_nStop
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: PulseAudioInput.nStop");
+        corkStream(env, logger, (InputContext*)ptr, true);
+    }
+
+    JNIEXPORT void JNICALL
+    Java_org_theko_sound_backends_pulseaudio_PulseAudioInput_nFlush
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: PulseAudioInput.nFlush");
+        auto context = (InputContext*)ptr;
+        if (!canRead(env, logger, context)) return;
+
+        PulseLock lock(context->connection);
+        dropFragment(context);
+        if (!context->connection.wait(pa_stream_flush(context->stream, onStreamSuccess, context))) {
+            logger->warn(env, "Failed to flush stream (%s).", context->connection.lastError());
+        }
+    }
+
+    JNIEXPORT void JNICALL
+    Java_org_theko_sound_backends_pulseaudio_PulseAudioInput_nDrain
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: PulseAudioInput.nDrain");
+        auto context = (InputContext*)ptr;
+        if (!canRead(env, logger, context)) return;
+
+        // Waits until the captured data has been read, polling every half period
+        uint32_t periodMs = 1;
+        {
+            PulseLock lock(context->connection);
+            const pa_buffer_attr* attr = pa_stream_get_buffer_attr(context->stream);
+            if (attr) periodMs = std::max<uint32_t>(1, (uint32_t)(pa_bytes_to_usec(attr->fragsize, &context->spec) / 2000));
+        }
+        for (;;) {
+            if (!context->started.load(std::memory_order_acquire)) break;
+            {
+                PulseLock lock(context->connection);
+                if (pa_stream_get_state(context->stream) != PA_STREAM_READY || availableBytes(context) < context->frameSize) break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(periodMs));
+        }
+    }
+
+    JNIEXPORT jint JNICALL
+    Java_org_theko_sound_backends_pulseaudio_PulseAudioInput_nRead
+    (JNIEnv* env, jobject obj, jlong ptr, jbyteArray buffer, jint offset, jint length) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: PulseAudioInput.nRead");
+
+        auto context = (InputContext*)ptr;
+        if (!canRead(env, logger, context)) return -1;
+
+        if (offset < 0 || length < 0 || offset > env->GetArrayLength(buffer) - length) {
+            logger->error(env, "Invalid read range. Offset: %d, length: %d.", offset, length);
+            return -1;
+        }
+
+        PulseLock lock(context->connection);
+        size_t read = readFrames(context, (size_t)length,
+            [env, buffer, offset](const uint8_t* src, size_t dstOffset, size_t count) {
+                env->SetByteArrayRegion(buffer, offset + (jsize)dstOffset, (jsize)count, (const jbyte*)src);
+            });
+        return (jint)read;
+    }
+
+    JNIEXPORT jint JNICALL
+    Java_org_theko_sound_backends_pulseaudio_PulseAudioInput_nReadDirect
+    (JNIEnv* env, jobject obj, jlong ptr, jobject buffer, jint offset, jint length) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: PulseAudioInput.nReadDirect");
+
+        auto context = (InputContext*)ptr;
+        if (!canRead(env, logger, context)) return -1;
+
+        uint8_t* dst = (uint8_t*)env->GetDirectBufferAddress(buffer);
+        jlong capacity = env->GetDirectBufferCapacity(buffer);
+        if (!dst || capacity < 0) {
+            logger->error(env, "Buffer is not a direct buffer.");
+            return -1;
+        }
+        if (offset < 0 || length < 0 || (jlong)offset + length > capacity) {
+            logger->error(env, "Invalid read range. Offset: %d, length: %d.", offset, length);
+            return -1;
+        }
+
+        PulseLock lock(context->connection);
+        size_t read = readFrames(context, (size_t)length,
+            [dst, offset](const uint8_t* src, size_t dstOffset, size_t count) {
+                memcpy(dst + offset + dstOffset, src, count);
+            });
+        return (jint)read;
+    }
+
+    JNIEXPORT jboolean JNICALL
+    Java_org_theko_sound_backends_pulseaudio_PulseAudioInput_nWaitForData
+    (JNIEnv* env, jobject obj, jlong ptr, jint timeoutMs) {
+        auto context = (InputContext*)ptr;
+        if (!context || !context->stream || !context->started.load(std::memory_order_acquire)) return JNI_FALSE;
+
+        std::unique_lock<std::mutex> lock(context->dataLock);
+        context->dataReady.wait_for(lock, std::chrono::milliseconds(std::max(timeoutMs, 0)),
+            [context] { return context->dataPending; });
+        bool pending = context->dataPending;
+        context->dataPending = false;
+        return pending && context->started.load(std::memory_order_acquire) ? JNI_TRUE : JNI_FALSE;
+    }
+
+    JNIEXPORT jint JNICALL
+    Java_org_theko_sound_backends_pulseaudio_PulseAudioInput_nAvailable
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: PulseAudioInput.nAvailable");
+        auto context = (InputContext*)ptr;
+        if (!canRead(env, logger, context)) return -1;
+
+        PulseLock lock(context->connection);
+        size_t available = availableBytes(context);
+        available -= available % context->frameSize;
+        return (jint)std::min<size_t>(available, INT_MAX);
+    }
+
+    JNIEXPORT jint JNICALL
+    Java_org_theko_sound_backends_pulseaudio_PulseAudioInput_nGetBufferSize
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: PulseAudioInput.nGetBufferSize");
+        auto context = (InputContext*)ptr;
+        if (!canRead(env, logger, context)) return -1;
+
+        PulseLock lock(context->connection);
+        const pa_buffer_attr* attr = pa_stream_get_buffer_attr(context->stream);
+        return attr ? (jint)std::min<uint32_t>(attr->maxlength, INT_MAX) : -1;
+    }
+
+    JNIEXPORT jlong JNICALL
+    Java_org_theko_sound_backends_pulseaudio_PulseAudioInput_nGetFramePosition
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        auto context = (InputContext*)ptr;
+        if (!context || context->frameSize == 0) return -1;
+        return (jlong)(context->readBytes / context->frameSize);
+    }
+
+    JNIEXPORT jlong JNICALL
+    Java_org_theko_sound_backends_pulseaudio_PulseAudioInput_nGetMicrosecondLatency
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: PulseAudioInput.nGetMicrosecondLatency");
+        auto context = (InputContext*)ptr;
+        if (!canRead(env, logger, context)) return -1;
+
+        pa_usec_t usec = 0;
+        int negative = 0;
+        PulseLock lock(context->connection);
+        if (pa_stream_get_latency(context->stream, &usec, &negative) < 0) {
+            return -1;
+        }
+        return negative ? 0 : (jlong)usec;
+    }
+
+    JNIEXPORT jint JNICALL
+    Java_org_theko_sound_backends_pulseaudio_PulseAudioInput_nGetPeriodFrames
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: PulseAudioInput.nGetPeriodFrames");
+        auto context = (InputContext*)ptr;
+        if (!canRead(env, logger, context)) return -1;
+
+        PulseLock lock(context->connection);
+        const pa_buffer_attr* attr = pa_stream_get_buffer_attr(context->stream);
+        return attr ? (jint)(attr->fragsize / context->frameSize) : -1;
+    }
+
+    JNIEXPORT jlong JNICALL
+    Java_org_theko_sound_backends_pulseaudio_PulseAudioInput_nGetOverflowCount
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        auto context = (InputContext*)ptr;
+        if (!context) return 0;
+        return (jlong)context->overflows.load(std::memory_order_relaxed);
+    }
+
+    JNIEXPORT jlong JNICALL
+    Java_org_theko_sound_backends_pulseaudio_PulseAudioInput_nGetDiscontinuityCount
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        auto context = (InputContext*)ptr;
+        if (!context) return 0;
+        return (jlong)context->holes.load(std::memory_order_relaxed);
+    }
+
+    JNIEXPORT jobject JNICALL
+    Java_org_theko_sound_backends_pulseaudio_PulseAudioInput_nGetCurrentAudioPort
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: PulseAudioInput.nGetCurrentAudioPort");
+        auto context = (InputContext*)ptr;
+        if (!canRead(env, logger, context)) return nullptr;
+
+        // The server may have moved the stream to another source
+        PulsePortInfo port;
+        bool found = false;
+        {
+            PulseLock lock(context->connection);
+            const char* name = pa_stream_get_device_name(context->stream);
+            found = name && queryPulsePort(context->connection, false, name, &port);
+        }
+        if (!found) {
+            logger->debug(env, "Failed to get current source (%s).", context->connection.lastError());
+            return nullptr;
+        }
+        return PulsePortInfo_to_AudioPort(env, port);
+    }
+}
+}
@@ -0,0 +1,470 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <jni.h>
+
+#include <pulse/pulseaudio.h>
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <string>
+#include <string.h>
+
+#include "logger.hpp"
+#include "logger_manager.hpp"
+#include "helper_utilities.hpp"
+
+#include "org_theko_sound_backends_pulseaudio_PulseAudioOutput.h"
+#include "cache/Java_Concurrent_AtomicReference.hpp"
+#include "cache/ThekoSound_UnsupportedAudioFormatException.hpp"
+#include "cache/ThekoSound_DeviceInvalidatedException.hpp"
+
+#include "libpulse_bridge.hpp"
+
+#define STREAM_NAME "Playback"
+#define PERIODS_PER_BUFFER 4
+#define LOW_LATENCY_PERIODS_PER_BUFFER 8
+
+namespace theko::sound::backend::pulseaudio::output {
+
+class OutputContext {
+public:
+    PulseConnection connection;
+    pa_stream* stream = nullptr;
+    pa_sample_spec spec = {};
+    size_t frameSize = 0;
+
+    std::atomic<uint64_t> underflows{0};
+    uint64_t writtenBytes = 0;
+
+    OutputContext() = default;
+    OutputContext(const OutputContext&) = delete;
+    OutputContext& operator=(const OutputContext&) = delete;
+};
+
+/*
+ * Stream callbacks, called on the mainloop thread.
+ */
+static void onStreamState(pa_stream* stream, void* userdata) {
+    pa_threaded_mainloop_signal(((OutputContext*)userdata)->connection.mainloop, 0);
+}
+
+static void onStreamSuccess(pa_stream* stream, int success, void* userdata) {
+    pa_threaded_mainloop_signal(((OutputContext*)userdata)->connection.mainloop, 0);
+}
+
+static void onStreamUnderflow(pa_stream* stream, void* userdata) {
+    ((OutputContext*)userdata)->underflows.fetch_add(1, std::memory_order_relaxed);
+}
+
+/*
+ * Writes up to length bytes without blocking, straight into the stream memory.
+ * The mainloop must be locked.
+ */
+template <typename CopyFn>
+static size_t writeFrames(OutputContext* context, size_t length, CopyFn copy) {
+    size_t writable = pa_stream_writable_size(context->stream);
+    if (writable == (size_t)-1) return 0;
+
+    size_t total = std::min(length, writable);
+    total -= total % context->frameSize;
+
+    size_t written = 0;
+    while (written < total) {
+        void* data = nullptr;
+        size_t chunk = total - written;
+        if (pa_stream_begin_write(context->stream, &data, &chunk) < 0 || !data || chunk == 0) break;
+        chunk = std::min(chunk, total - written);
+        chunk -= chunk % context->frameSize;
+        if (chunk == 0) {
+            pa_stream_cancel_write(context->stream);
+            break;
+        }
+
+        copy((uint8_t*)data, written, chunk);
+        if (pa_stream_write(context->stream, data, chunk, nullptr, 0, PA_SEEK_RELATIVE) < 0) break;
+        written += chunk;
+    }
+    context->writtenBytes += written;
+    return written;
+}
+
+extern "C" {
+    static void cleanupAndThrowError(JNIEnv* env, Logger* logger, OutputContext* context, const char* msg) {
+        const char* reason = context ? context->connection.lastError() : "No context";
+        logger->error(env, "%s (%s)", msg, reason);
+        if (context) {
+            if (context->stream) {
+                pa_threaded_mainloop_lock(context->connection.mainloop);
+                pa_stream_set_state_callback(context->stream, nullptr, nullptr);
+                pa_stream_set_underflow_callback(context->stream, nullptr, nullptr);
+                pa_stream_disconnect(context->stream);
+                pa_stream_unref(context->stream);
+                context->stream = nullptr;
+                pa_threaded_mainloop_unlock(context->connection.mainloop);
+            }
+            context->connection.disconnect();
+            delete context;
+        }
+        env->ThrowNew(ThekoSound_AudioBackendException::getClazz(env), msg);
+    }
+
+    static bool canUse(JNIEnv* env, Logger* logger, OutputContext* context) {
+        if (!context || !context->stream) {
+            logger->info(env, "PulseAudio output not opened.");
+            return false;
+        }
+        if (pa_stream_get_state(context->stream) != PA_STREAM_READY) {
+            logger->warn(env, "Stream is no longer ready (%s).", context->connection.lastError());
+            env->ThrowNew(ThekoSound_DeviceInvalidatedException::getClazz(env), "Stream invalidated.");
+            return false;
+        }
+        return true;
+    }
+
+    JNIEXPORT jlong JNICALL
+    Java_org_theko_sound_backends_pulseaudio_PulseAudioOutput_nOpen
+    (JNIEnv* env, jobject obj, jobject jport, jobject jformat, jint bufferSize /* in bytes */, jobject jAtomicRefFormat, jboolean lowLatency) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: PulseAudioOutput.nOpen");
+
+        if (!jport || !jformat || !jAtomicRefFormat) return 0;
+
+        std::string device;
+        if (!AudioPort_to_pulse_name(env, jport, &device)) {
+            env->ThrowNew(ThekoSound_AudioBackendException::getClazz(env), "Not a PulseAudio port.");
+            return 0;
+        }
+
+        pa_sample_spec spec = {};
+        if (!AudioFormat_to_pa_sample_spec(env, jformat, &spec)) {
+            if (!env->ExceptionCheck()) {
+                env->ThrowNew(ThekoSound_UnsupportedAudioFormatException::getClazz(env), "Unsupported audio format.");
+            }
+            return 0;
+        }
+
+        auto context = new OutputContext();
+        logger->trace(env, "OutputContext allocated. Pointer: %s", FORMAT_PTR(context));
+
+        context->spec = spec;
+        context->frameSize = pa_frame_size(&spec);
+        if (!context->connection.connect(PULSE_CLIENT_NAME)) {
+            cleanupAndThrowError(env, logger, context, "Failed to connect to the PulseAudio server.");
+            return 0;
+        }
+
+        pa_channel_map map;
+        pulseChannelMap(&spec, &map);
+
+        // Target latency is the requested buffer, the server asks for more data every minreq bytes
+        uint32_t frameSize = (uint32_t)context->frameSize;
+        uint32_t tlength = std::max<uint32_t>((uint32_t)std::max<jint>(bufferSize, 0) / frameSize, 1) * frameSize;
+        uint32_t minreq = std::max<uint32_t>(tlength / (lowLatency ? LOW_LATENCY_PERIODS_PER_BUFFER : PERIODS_PER_BUFFER) / frameSize, 1) * frameSize;
+
+        pa_buffer_attr attr;
+        attr.maxlength = (uint32_t)-1;
+        attr.tlength = tlength;
+        attr.prebuf = minreq; // Start after the first period, not after the whole buffer
+        attr.minreq = minreq;
+        attr.fragsize = (uint32_t)-1;
+
+        pa_stream_flags_t flags = (pa_stream_flags_t)(PA_STREAM_START_CORKED | PA_STREAM_ADJUST_LATENCY |
+            PA_STREAM_INTERPOLATE_TIMING | PA_STREAM_AUTO_TIMING_UPDATE);
+
+        bool ready = false;
+        pa_threaded_mainloop_lock(context->connection.mainloop);
+        context->stream = pa_stream_new(context->connection.context, STREAM_NAME, &spec, &map);
+        if (context->stream) {
+            pa_stream_set_state_callback(context->stream, onStreamState, context);
+            pa_stream_set_underflow_callback(context->stream, onStreamUnderflow, context);
+
+            if (pa_stream_connect_playback(context->stream, device.empty() ? nullptr : device.c_str(),
+                    &attr, flags, nullptr, nullptr) >= 0) {
+                for (;;) {
+                    pa_stream_state_t state = pa_stream_get_state(context->stream);
+                    if (state == PA_STREAM_READY) {
+                        ready = true;
+                        break;
+                    }
+                    if (!PA_STREAM_IS_GOOD(state)) break;
+                    pa_threaded_mainloop_wait(context->connection.mainloop);
+                }
+            }
+        }
+
+        pa_sample_spec openedSpec = spec;
+        if (ready) {
+            const pa_buffer_attr* opened = pa_stream_get_buffer_attr(context->stream);
+            const pa_sample_spec* streamSpec = pa_stream_get_sample_spec(context->stream);
+            if (streamSpec) openedSpec = *streamSpec;
+            if (opened) {
+                logger->debug(env, "Buffer attributes. Requested tlength: %u, minreq: %u. Opened tlength: %u, minreq: %u, prebuf: %u.",
+                    tlength, minreq, opened->tlength, opened->minreq, opened->prebuf);
+            }
+        }
+        pa_threaded_mainloop_unlock(context->connection.mainloop);
+
+        if (!ready) {
+            cleanupAndThrowError(env, logger, context, "Failed to connect playback stream.");
+            return 0;
+        }
+
+        jobject jOpenedFormat = pa_sample_spec_to_AudioFormat(env, &openedSpec);
+        Java_Concurrent_AtomicReference::set(env, jAtomicRefFormat, jOpenedFormat);
+        if (jOpenedFormat) env->DeleteLocalRef(jOpenedFormat);
+
+        logger->debug(env, "Opened PulseAudio output on %s. ContextPtr: %s", device.c_str(), FORMAT_PTR(context));
+        return (jlong)context;
+    }
+
+    JNIEXPORT void JNICALL
+    Java_org_theko_sound_backends_pulseaudio_PulseAudioOutput_nClose
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: PulseAudioOutput.nClose");
+
+        auto context = (OutputContext*)ptr;
+        if (!context) {
+            logger->debug(env, "PulseAudio output already closed.");
+            return;
+        }
+
+        uint64_t underflows = context->underflows.load(std::memory_order_relaxed);
+        if (underflows > 0) {
+            logger->info(env, "Playback underflows: %llu.", (unsigned long long)underflows);
+        }
+
+        if (context->stream) {
+            PulseLock lock(context->connection);
+            pa_stream_set_state_callback(context->stream, nullptr, nullptr);
+            pa_stream_set_underflow_callback(context->stream, nullptr, nullptr);
+            pa_stream_disconnect(context->stream);
+            pa_stream_unref(context->stream);
+            context->stream = nullptr;
+        }
+        context->connection.disconnect();
+        delete context;
+
+        logger->debug(env, "Closed PulseAudio output.");
+    }
+
+    static void corkStream(JNIEnv* env, Logger* logger, OutputContext* context, bool cork) {
+        if (!canUse(env, logger, context)) return;
+
+        PulseLock lock(context->connection);
+        if (!context->connection.wait(pa_stream_cork(context->stream, cork ? 1 : 0, onStreamSuccess, context))) {
+            logger->error(env, "Failed to %s stream (%s).", cork ? "cork" : "uncork", context->connection.lastError());
+            env->ThrowNew(ThekoSound_AudioBackendException::getClazz(env), cork ? "Failed to stop stream." : "Failed to start stream.");
+            return;
+        }
+        // Start playing what is queued even if it is less than prebuf
+        if (!cork) context->connection.wait(pa_stream_trigger(context->stream, onStreamSuccess, context));
+    }
+
+    JNIEXPORT void JNICALL
+    Java_org_theko_sound_backends_pulseaudio_PulseAudioOutput_nStart
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: PulseAudioOutput.nStart");
+        corkStream(env, logger, (OutputContext*)ptr, false);
+    }
+
+    JNIEXPORT void JNICALL
+    Java_org_theko_sound_backends_pulseaudio_PulseAudioOutput_nStop
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: PulseAudioOutput.nStop");
+        corkStream(env, logger, (OutputContext*)ptr, true);
+    }
+
+    JNIEXPORT void JNICALL
+    Java_org_theko_sound_backends_pulseaudio_PulseAudioOutput_nFlush
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: PulseAudioOutput.nFlush");
+        auto context = (OutputContext*)ptr;
+        if (!canUse(env, logger, context)) return;
+
+        PulseLock lock(context->connection);
+        if (!context->connection.wait(pa_stream_flush(context->stream, onStreamSuccess, context))) {
+            logger->warn(env, "Failed to flush stream (%s).", context->connection.lastError());
+        }
+    }
+
+    JNIEXPORT void JNICALL
+    Java_org_theko_sound_backends_pulseaudio_PulseAudioOutput_nDrain
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: PulseAudioOutput.nDrain");
+        auto context = (OutputContext*)ptr;
+        if (!canUse(env, logger, context)) return;
+
+        PulseLock lock(context->connection);
+        // A corked stream never drains
+        if (pa_stream_is_corked(context->stream) == 1) {
+            logger->debug(env, "Stream is stopped, nothing to drain.");
+            return;
+        }
+        if (!context->connection.wait(pa_stream_drain(context->stream, onStreamSuccess, context))) {
+            logger->warn(env, "Failed to drain stream (%s).", context->connection.lastError());
+        }
+    }
+
+    JNIEXPORT jint JNICALL
+    Java_org_theko_sound_backends_pulseaudio_PulseAudioOutput_nWrite
+    (JNIEnv* env, jobject obj, jlong ptr, jbyteArray buffer, jint offset, jint length) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: PulseAudioOutput.nWrite");
+
+        auto context = (OutputContext*)ptr;
+        if (!canUse(env, logger, context)) return -1;
+
+        if (offset < 0 || length < 0 || offset > env->GetArrayLength(buffer) - length) {
+            logger->error(env, "Invalid write range. Offset: %d, length: %d.", offset, length);
+            return -1;
+        }
+
+        // Copy straight from the Java array into the stream memory
+        PulseLock lock(context->connection);
+        size_t written = writeFrames(context, (size_t)length,
+            [env, buffer, offset](uint8_t* dst, size_t srcOffset, size_t count) {
+                env->GetByteArrayRegion(buffer, offset + (jsize)srcOffset, (jsize)count, (jbyte*)dst);
+            });
+        return (jint)written;
+    }
+
+    JNIEXPORT jint JNICALL
+    Java_org_theko_sound_backends_pulseaudio_PulseAudioOutput_nWriteDirect
+    (JNIEnv* env, jobject obj, jlong ptr, jobject buffer, jint offset, jint length) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: PulseAudioOutput.nWriteDirect");
+
+        auto context = (OutputContext*)ptr;
+        if (!canUse(env, logger, context)) return -1;
+
+        uint8_t* src = (uint8_t*)env->GetDirectBufferAddress(buffer);
+        jlong capacity = env->GetDirectBufferCapacity(buffer);
+        if (!src || capacity < 0) {
+            logger->error(env, "Buffer is not a direct buffer.");
+            return -1;
+        }
+        if (offset < 0 || length < 0 || (jlong)offset + length > capacity) {
+            logger->error(env, "Invalid write range. Offset: %d, length: %d.", offset, length);
+            return -1;
+        }
+
+        PulseLock lock(context->connection);
+        size_t written = writeFrames(context, (size_t)length,
+            [src, offset](uint8_t* dst, size_t srcOffset, size_t count) {
+                memcpy(dst, src + offset + srcOffset, count);
+            });
+        return (jint)written;
+    }
+
+    JNIEXPORT jint JNICALL
+    Java_org_theko_sound_backends_pulseaudio_PulseAudioOutput_nAvailable
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: PulseAudioOutput.nAvailable");
+        auto context = (OutputContext*)ptr;
+        if (!canUse(env, logger, context)) return -1;
+
+        PulseLock lock(context->connection);
+        size_t writable = pa_stream_writable_size(context->stream);
+        if (writable == (size_t)-1) return -1;
+        writable -= writable % context->frameSize;
+        return (jint)std::min<size_t>(writable, INT_MAX);
+    }
+
+    JNIEXPORT jint JNICALL
+    Java_org_theko_sound_backends_pulseaudio_PulseAudioOutput_nGetBufferSize
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: PulseAudioOutput.nGetBufferSize");
+        auto context = (OutputContext*)ptr;
+        if (!canUse(env, logger, context)) return -1;
+
+        PulseLock lock(context->connection);
+        const pa_buffer_attr* attr = pa_stream_get_buffer_attr(context->stream);
+        return attr ? (jint)std::min<uint32_t>(attr->tlength, INT_MAX) : -1;
+    }
+
+    JNIEXPORT jlong JNICALL
+    Java_org_theko_sound_backends_pulseaudio_PulseAudioOutput_nGetFramePosition
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: PulseAudioOutput.nGetFramePosition");
+        auto context = (OutputContext*)ptr;
+        if (!canUse(env, logger, context)) return -1;
+
+        // Interpolated playback time, advanced by the timing updates of the server
+        pa_usec_t usec = 0;
+        PulseLock lock(context->connection);
+        if (pa_stream_get_time(context->stream, &usec) < 0) {
+            return 0; // No timing data yet
+        }
+        return (jlong)(usec * context->spec.rate / PA_USEC_PER_SEC);
+    }
+
+    JNIEXPORT jlong JNICALL
+    Java_org_theko_sound_backends_pulseaudio_PulseAudioOutput_nGetMicrosecondLatency
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: PulseAudioOutput.nGetMicrosecondLatency");
+        auto context = (OutputContext*)ptr;
+        if (!canUse(env, logger, context)) return -1;
+
+        pa_usec_t usec = 0;
+        int negative = 0;
+        PulseLock lock(context->connection);
+        if (pa_stream_get_latency(context->stream, &usec, &negative) < 0) {
+            return -1;
+        }
+        return negative ? 0 : (jlong)usec;
+    }
+
+    JNIEXPORT jint JNICALL
+    Java_org_theko_sound_backends_pulseaudio_PulseAudioOutput_nGetPeriodFrames
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: PulseAudioOutput.nGetPeriodFrames");
+        auto context = (OutputContext*)ptr;
+        if (!canUse(env, logger, context)) return -1;
+
+        PulseLock lock(context->connection);
+        const pa_buffer_attr* attr = pa_stream_get_buffer_attr(context->stream);
+        return attr ? (jint)(attr->minreq / context->frameSize) : -1;
+    }
+
+    JNIEXPORT jlong JNICALL
+    Java_org_theko_sound_backends_pulseaudio_PulseAudioOutput_nGetUnderflowCount
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        auto context = (OutputContext*)ptr;
+        if (!context) return 0;
+        return (jlong)context->underflows.load(std::memory_order_relaxed);
+    }
+
+    JNIEXPORT jobject JNICALL
+    Java_org_theko_sound_backends_pulseaudio_PulseAudioOutput_nGetCurrentAudioPort
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: PulseAudioOutput.nGetCurrentAudioPort");
+        auto context = (OutputContext*)ptr;
+        if (!canUse(env, logger, context)) return nullptr;
+
+        // The server may have moved the stream to another sink
+        PulsePortInfo port;
+        bool found = false;
+        {
+            PulseLock lock(context->connection);
+            const char* name = pa_stream_get_device_name(context->stream);
+            found = name && queryPulsePort(context->connection, true, name, &port);
+        }
+        if (!found) {
+            logger->debug(env, "Failed to get current sink (%s).", context->connection.lastError());
+            return nullptr;
+        }
+        return PulsePortInfo_to_AudioPort(env, port);
+    }
+}
+}
@@ -55,7 +55,7 @@
  * @return a pointer to the AudioFormat object (jobject), or nullptr if the conversion fails
  */
 static jobject WAVEFORMATEX_to_AudioFormat(JNIEnv* env, const WAVEFORMATEX* waveformat) {
-    Logger* logger = LoggerManager::getManager()->getLogger(env, "NATIVE: WASAPIBridge.WAVEFORMATEX -> AudioFormat");
+    Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPIBridge.WAVEFORMATEX -> AudioFormat");
 
     if (!waveformat) return nullptr;
 
@@ -124,7 +124,7 @@ static jobject WAVEFORMATEX_to_AudioFormat(JNIEnv* env, const WAVEFORMATEX* wave
  * @return a pointer to the native WAVEFORMATEX object, or nullptr if the conversion fails
  */
 static WAVEFORMATEX* AudioFormat_to_WAVEFORMATEX(JNIEnv* env, jobject audioFormat) {
-    Logger* logger = LoggerManager::getManager()->getLogger(env, "NATIVE: WASAPIBridge.AudioFormat -> WAVEFORMATEX");
+    Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPIBridge.AudioFormat -> WAVEFORMATEX");
 
     if (!audioFormat) return nullptr;
 
@@ -196,7 +196,7 @@ static WAVEFORMATEX* AudioFormat_to_WAVEFORMATEX(JNIEnv* env, jobject audioForma
  * @return a pointer to the retrieved property value, or nullptr if the call fails
  */
 static wchar_t* getAudioDeviceProperty(JNIEnv* env, IPropertyStore* pProps, IMMDevice* device, const PROPERTYKEY& key) {
-    Logger* logger = LoggerManager::getManager()->getLogger(env, "NATIVE: WASAPIBridge.getAudioDeviceProperty");
+    Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPIBridge.getAudioDeviceProperty");
 
     if (!device) return nullptr;
     if (!pProps) return nullptr;
@@ -240,7 +240,7 @@ static wchar_t* getAudioDeviceProperty(JNIEnv* env, IPropertyStore* pProps, IMMD
  * @return The converted AudioPort, or nullptr if failed
  */
 static jobject IMMDevice_to_AudioPort(JNIEnv* env, IMMDevice* pDevice) {
-    Logger* logger = LoggerManager::getManager()->getLogger(env, "NATIVE: WASAPIBridge.IMMDevice -> AudioPort");
+    Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPIBridge.IMMDevice -> AudioPort");
 
     if (!pDevice) return nullptr;
 
@@ -353,7 +353,7 @@ static jobject IMMDevice_to_AudioPort(JNIEnv* env, IMMDevice* pDevice) {
     } else if (!mixFormat && !isActive) {
         logger->debug(env, "Device is not active, and mix format is not available.");
     }
-    logger->trace(env, "Obtained WAVEFORMATEX: %s.Pointer: %s", (mixFormat ? WAVEFORMATEX_toText(mixFormat) : "NULL"), FORMAT_PTR(mixFormat));
+    if (logger->isTraceEnabled()) logger->trace(env, "Obtained WAVEFORMATEX: %s.Pointer: %s", (mixFormat ? WAVEFORMATEX_toText(mixFormat) : "NULL"), FORMAT_PTR(mixFormat));
 
     jobject jAudioMixFormat = (mixFormat ? WAVEFORMATEX_to_AudioFormat(env, mixFormat) : nullptr);
     logger->trace(env, "Created AudioFormat. Pointer: %s", FORMAT_PTR(jAudioMixFormat));
@@ -382,7 +382,7 @@ static jobject IMMDevice_to_AudioPort(JNIEnv* env, IMMDevice* pDevice) {
  * @return The corresponding IMMDevice, or nullptr if failed
  */
 static IMMDevice* AudioPort_to_IMMDevice(JNIEnv* env, jobject jAudioPort) {
-    Logger* logger = LoggerManager::getManager()->getLogger(env, "NATIVE: WASAPIBridge.AudioPort -> IMMDevice");
+    Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPIBridge.AudioPort -> IMMDevice");
 
     if (!jAudioPort || !env->IsInstanceOf(jAudioPort, ThekoSound_AudioPort::getClazz(env))) {
         logger->warn(env, "Invalid or null AudioPort.");
@@ -0,0 +1,389 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#ifdef _WIN32
+#include <windows.h>
+#include <mmdeviceapi.h>
+#include <audioclient.h>
+#include <avrt.h>
+
+#include <jni.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "logger.hpp"
+#include "logger_manager.hpp"
+#include "helper_utilities.hpp"
+#include "spsc_ring_buffer.hpp"
+#include "sample_conversion.hpp"
+
+#include "wasapi_utils.hpp"
+
+#define SESSION_THREAD_NAME "WASAPISharedOutput-Session"
+#define SESSION_THREAD_WAIT_TIMEOUT 2000 // ms
+#define SESSION_BUFFER_PERIODS 2
+
+#define SESSION_EVENT_BUFFER_READY 0
+#define SESSION_EVENT_STOP_REQUEST 1
+
+/**
+ * One stream mixed by an endpoint session. The ring is owned by the output context
+ * that registered the voice: Java writes into it, the session render thread is its consumer.
+ */
+struct SessionVoice {
+    SpscRingBuffer* ring = nullptr;
+    std::atomic<bool> active{false};          // Mixed only while started
+    std::atomic<bool> flushRequested{false};  // The ring can only be discarded by its consumer
+    std::atomic<size_t> flushPosition{0};     // Ring write position at the last flush
+    std::atomic<uint64_t> mixedFrames{0};     // Frames moved into the endpoint buffer
+};
+
+/**
+ * A single shared-mode IAudioClient per endpoint, shared by all output streams
+ * opened with the endpoint session mode.
+ *
+ * One event-driven render thread, registered with MMCSS ("Pro Audio"), wakes up once
+ * per engine period and sums the queued frames of every started voice with the SIMD
+ * accumulation kernel straight into the endpoint buffer, so N streams cost one
+ * wake-up and one audio engine stream instead of N.
+ *
+ * The client is initialized with the mix format of the endpoint, which must be 32-bit float,
+ * and the default engine period. Sessions are reference counted in a process-wide registry,
+ * keyed by the endpoint ID; the last voice to leave releases the client.
+ */
+class EndpointSession {
+public:
+    std::wstring deviceId;
+    IAudioClient* audioClient = nullptr;
+    IAudioRenderClient* renderClient = nullptr;
+    WAVEFORMATEX* format = nullptr;
+    UINT32 bufferFrameCount = 0;
+    UINT32 periodFrames = 0;
+    UINT32 bytesPerFrame = 0;
+    REFERENCE_TIME streamLatency = 0;
+    HANDLE events[2] = { nullptr, nullptr };
+    HANDLE renderThread = nullptr;
+    JavaVM* jvm = nullptr;
+    std::atomic<bool> stopRequested{false};
+    std::atomic<bool> invalidated{false};   // The render thread failed, voices have to reopen
+
+    std::mutex voicesLock;                  // Only try-locked by the render thread
+    std::vector<SessionVoice*> voices;
+    size_t refCount = 0;                    // Guarded by the registry lock
+
+    EndpointSession() = default;
+    EndpointSession(const EndpointSession&) = delete;
+    EndpointSession& operator=(const EndpointSession&) = delete;
+
+    ~EndpointSession() {
+        if (audioClient) audioClient->Stop();
+
+        if (renderClient) renderClient->Release();
+        if (audioClient) audioClient->Release();
+
+        if (renderThread) CloseHandle(renderThread);
+        if (events[0]) CloseHandle(events[0]);
+        if (events[1]) CloseHandle(events[1]);
+
+        if (format) CoTaskMemFree(format);
+    }
+
+    void addVoice(SessionVoice* voice) {
+        std::lock_guard<std::mutex> guard(voicesLock);
+        voices.push_back(voice);
+    }
+
+    // Once this returns, the render thread no longer touches the voice
+    void removeVoice(SessionVoice* voice) {
+        std::lock_guard<std::mutex> guard(voicesLock);
+        voices.erase(std::remove(voices.begin(), voices.end(), voice), voices.end());
+    }
+
+    inline bool isInvalidated() const {
+        return invalidated.load(std::memory_order_relaxed);
+    }
+};
+
+static std::mutex& endpointSessionsLock() {
+    static std::mutex lock;
+    return lock;
+}
+
+static std::vector<EndpointSession*>& endpointSessions() {
+    static std::vector<EndpointSession*> sessions;
+    return sessions;
+}
+
+/*
+ * Mixes one period: as many frames as the fullest started voice has queued (up to the free
+ * endpoint space), voices with less data contribute silence for the rest.
+ * An empty period is an underrun for every voice; the audio engine plays silence for it.
+ */
+static HRESULT mixSessionPeriod(EndpointSession* session, UINT32 framesAvailable) {
+    const auto& kernels = theko::sound::conversion::getConversionKernels();
+    const UINT32 bytesPerFrame = session->bytesPerFrame;
+
+    // The render thread must not wait for a Java thread adding or removing a voice.
+    // Skipping the period is safe: the endpoint buffer holds more than one period,
+    // and the next wake-up mixes the frames this one missed.
+    std::unique_lock<std::mutex> guard(session->voicesLock, std::try_to_lock);
+    if (!guard.owns_lock()) return S_OK;
+
+    size_t frames = 0;
+    for (SessionVoice* voice : session->voices) {
+        if (voice->flushRequested.exchange(false, std::memory_order_acq_rel)) {
+            voice->ring->discardTo(voice->flushPosition.load(std::memory_order_acquire));
+        }
+        if (!voice->active.load(std::memory_order_acquire)) continue;
+        frames = std::max(frames, voice->ring->availableToRead() / bytesPerFrame);
+    }
+    frames = std::min<size_t>(frames, framesAvailable);
+    if (frames == 0) return S_OK;
+
+    BYTE* dest = nullptr;
+    HRESULT hr = session->renderClient->GetBuffer((UINT32)frames, &dest);
+    if (FAILED(hr)) return hr;
+
+    const size_t bytes = frames * bytesPerFrame;
+    memset(dest, 0, bytes);
+    for (SessionVoice* voice : session->voices) {
+        if (!voice->active.load(std::memory_order_acquire)) continue;
+
+        size_t queued = voice->ring->availableToRead();
+        size_t count = std::min(bytes, queued - queued % bytesPerFrame);
+        if (count == 0) continue;
+
+        // Ring capacity and positions are whole frames, so both parts hold whole samples
+        voice->ring->readWith(count, [&](const uint8_t* src, size_t dstOffset, size_t n) {
+            kernels.mixAdd((float*)(dest + dstOffset), (const float*)src, n / sizeof(float));
+        });
+        voice->mixedFrames.fetch_add(count / bytesPerFrame, std::memory_order_relaxed);
+    }
+
+    return session->renderClient->ReleaseBuffer((UINT32)frames, 0);
+}
+
+static DWORD WINAPI sessionThreadProc(LPVOID param) {
+    auto session = (EndpointSession*)param;
+
+    JNIEnv* env = nullptr;
+    JavaVMAttachArgs attachArgs;
+    attachArgs.version = JNI_VERSION_1_6;
+    attachArgs.name = (char*)SESSION_THREAD_NAME;
+    attachArgs.group = nullptr;
+    if (session->jvm->AttachCurrentThreadAsDaemon((void**)&env, &attachArgs) != JNI_OK) {
+        session->invalidated.store(true, std::memory_order_release);
+        return 1;
+    }
+    Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPISharedOutput.sessionThread");
+
+    HRESULT hrCom = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+
+    DWORD taskIndex = 0;
+    HANDLE mmcssHandle = AvSetMmThreadCharacteristicsW(L"Pro Audio", &taskIndex);
+    if (!mmcssHandle) {
+        logger->warn(env, "Failed to register session thread in MMCSS (error %lu).", GetLastError());
+    } else {
+        AvSetMmThreadPriority(mmcssHandle, AVRT_PRIORITY_HIGH);
+        logger->debug(env, "Session thread registered in MMCSS. Task index: %lu.", taskIndex);
+    }
+
+    while (!session->stopRequested.load(std::memory_order_acquire)) {
+        DWORD waitResult = WaitForMultipleObjects(2, session->events, FALSE, SESSION_THREAD_WAIT_TIMEOUT);
+
+        if (waitResult == WAIT_OBJECT_0 + SESSION_EVENT_STOP_REQUEST) {
+            break;
+        } else if (waitResult == WAIT_TIMEOUT) {
+            logger->warn(env, "No buffer event received in %d ms.", SESSION_THREAD_WAIT_TIMEOUT);
+            continue;
+        } else if (waitResult != WAIT_OBJECT_0 + SESSION_EVENT_BUFFER_READY) {
+            logger->error(env, "WaitForMultipleObjects failed: %lu", GetLastError());
+            session->invalidated.store(true, std::memory_order_release);
+            break;
+        }
+
+        UINT32 padding = 0;
+        HRESULT hr = session->audioClient->GetCurrentPadding(&padding);
+        if (SUCCEEDED(hr) && padding < session->bufferFrameCount) {
+            hr = mixSessionPeriod(session, session->bufferFrameCount - padding);
+        }
+        if (FAILED(hr)) {
+            // Device invalidated or the audio service stopped, either way every voice has to reopen
+            logger->warn(env, "Session render failed (%s), invalidating all voices.", fmtHR(hr));
+            session->invalidated.store(true, std::memory_order_release);
+            break;
+        }
+    }
+
+    if (mmcssHandle) AvRevertMmThreadCharacteristics(mmcssHandle);
+    if (SUCCEEDED(hrCom)) CoUninitialize();
+
+    logger->trace(env, "Session thread finished.");
+    session->jvm->DetachCurrentThread();
+    return 0;
+}
+
+static void stopSessionThread(EndpointSession* session) {
+    if (!session->renderThread) return;
+
+    session->stopRequested.store(true, std::memory_order_release);
+    SetEvent(session->events[SESSION_EVENT_STOP_REQUEST]);
+    WaitForSingleObject(session->renderThread, INFINITE);
+    CloseHandle(session->renderThread);
+    session->renderThread = nullptr;
+}
+
+static EndpointSession* createEndpointSession(JNIEnv* env, Logger* logger, IMMDevice* device, const std::wstring& deviceId) {
+    auto session = new EndpointSession();
+    session->deviceId = deviceId;
+
+    HRESULT hr = device->Activate(__uuidof(IAudioClient), CLSCTX_ALL, nullptr, (void**)&session->audioClient);
+    if (FAILED(hr) || !session->audioClient) {
+        logger->warn(env, "Failed to get session IAudioClient (%s).", fmtHR(hr));
+        delete session;
+        return nullptr;
+    }
+
+    hr = session->audioClient->GetMixFormat(&session->format);
+    if (FAILED(hr) || !session->format) {
+        logger->warn(env, "Failed to get session mix format (%s).", fmtHR(hr));
+        delete session;
+        return nullptr;
+    }
+    if (getSampleType(session->format) != theko::sound::conversion::SampleType::FLOAT32) {
+        logger->info(env, "Endpoint mix format is not 32-bit float, sessions are not available: %s",
+            WAVEFORMATEX_toText(session->format));
+        delete session;
+        return nullptr;
+    }
+
+    REFERENCE_TIME hnsDefaultPeriod = 0;
+    hr = session->audioClient->GetDevicePeriod(&hnsDefaultPeriod, nullptr);
+    if (FAILED(hr) || hnsDefaultPeriod <= 0) {
+        hnsDefaultPeriod = 100000; // 10 ms
+    }
+
+    hr = session->audioClient->Initialize(
+        AUDCLNT_SHAREMODE_SHARED,
+        AUDCLNT_STREAMFLAGS_EVENTCALLBACK,
+        SESSION_BUFFER_PERIODS * hnsDefaultPeriod,
+        0,
+        session->format,
+        nullptr
+    );
+    if (FAILED(hr)) {
+        logger->warn(env, "Failed to initialize session IAudioClient (%s).", fmtHR(hr));
+        delete session;
+        return nullptr;
+    }
+
+    hr = session->audioClient->GetService(__uuidof(IAudioRenderClient), (void**)&session->renderClient);
+    if (FAILED(hr) || !session->renderClient) {
+        logger->warn(env, "Failed to get session IAudioRenderClient (%s).", fmtHR(hr));
+        delete session;
+        return nullptr;
+    }
+
+    session->events[SESSION_EVENT_BUFFER_READY] = CreateEvent(NULL, FALSE, FALSE, NULL);
+    session->events[SESSION_EVENT_STOP_REQUEST] = CreateEvent(NULL, TRUE, FALSE, NULL);
+    if (!session->events[SESSION_EVENT_BUFFER_READY] || !session->events[SESSION_EVENT_STOP_REQUEST]) {
+        logger->warn(env, "Failed to create session events.");
+        delete session;
+        return nullptr;
+    }
+    session->audioClient->SetEventHandle(session->events[SESSION_EVENT_BUFFER_READY]);
+
+    hr = session->audioClient->GetBufferSize(&session->bufferFrameCount);
+    if (FAILED(hr) || session->bufferFrameCount == 0) {
+        logger->warn(env, "Failed to get session buffer size (%s).", fmtHR(FAILED(hr) ? hr : E_FAIL));
+        delete session;
+        return nullptr;
+    }
+    session->audioClient->GetStreamLatency(&session->streamLatency);
+    session->bytesPerFrame = session->format->nBlockAlign;
+    session->periodFrames = (UINT32)(hnsDefaultPeriod * session->format->nSamplesPerSec / 10000000);
+
+    if (env->GetJavaVM(&session->jvm) != JNI_OK) {
+        logger->warn(env, "Failed to get JavaVM.");
+        delete session;
+        return nullptr;
+    }
+
+    hr = session->audioClient->Start();
+    if (FAILED(hr)) {
+        logger->warn(env, "Failed to start session IAudioClient (%s).", fmtHR(hr));
+        delete session;
+        return nullptr;
+    }
+
+    session->renderThread = CreateThread(NULL, 0, sessionThreadProc, session, 0, NULL);
+    if (!session->renderThread) {
+        logger->warn(env, "Failed to create session thread (error %lu).", GetLastError());
+        delete session;
+        return nullptr;
+    }
+
+    logger->debug(env, "Endpoint session created. Format: %s, buffer: %u frames, period: %u frames. SessionPtr: %s",
+        WAVEFORMATEX_toText(session->format), session->bufferFrameCount, session->periodFrames, FORMAT_PTR(session));
+    return session;
+}
+
+/**
+ * Returns the session of the endpoint, creating it for the first voice.
+ * Invalidated sessions are skipped, they are released by their remaining voices.
+ * @return The session with one more reference, or nullptr if the endpoint cannot be shared
+ */
+static EndpointSession* acquireEndpointSession(JNIEnv* env, Logger* logger, IMMDevice* device, const std::wstring& deviceId) {
+    if (!device || deviceId.empty()) return nullptr;
+
+    std::lock_guard<std::mutex> guard(endpointSessionsLock());
+    for (EndpointSession* session : endpointSessions()) {
+        if (session->deviceId == deviceId && !session->isInvalidated()) {
+            session->refCount++;
+            logger->trace(env, "Joined endpoint session, %d references.", (int)session->refCount);
+            return session;
+        }
+    }
+
+    EndpointSession* session = createEndpointSession(env, logger, device, deviceId);
+    if (!session) return nullptr;
+    session->refCount = 1;
+    endpointSessions().push_back(session);
+    return session;
+}
+
+/**
+ * Drops one reference; the last one stops the render thread and releases the client.
+ */
+static void releaseEndpointSession(EndpointSession* session) {
+    if (!session) return;
+    {
+        std::lock_guard<std::mutex> guard(endpointSessionsLock());
+        if (--session->refCount > 0) return;
+
+        auto& sessions = endpointSessions();
+        sessions.erase(std::remove(sessions.begin(), sessions.end(), session), sessions.end());
+    }
+    stopSessionThread(session);
+    delete session;
+}
+#endif
@@ -0,0 +1,179 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <jni.h>
+
+#include <windows.h>
+#include <initguid.h>
+#include <mmdeviceapi.h>
+#include <audioclient.h>
+#include <functiondiscoverykeys.h>
+#include <Functiondiscoverykeys_devpkey.h>
+#include <vector>
+
+#include "logger.hpp"
+#include "logger_manager.hpp"
+#include "helper_utilities.hpp"
+
+#include "org_theko_sound_backends_wasapi_WASAPIExclusiveBackend.h"
+
+#include "wasapi_utils.hpp"
+#include "wasapi_bridge.hpp"
+
+namespace org_theko_sound_backend_wasapi_exclusive {
+
+// Candidates probed in exclusive mode, besides the device format
+static const DWORD PROBE_SAMPLE_RATES[] = { 44100, 48000, 88200, 96000, 176400, 192000 };
+static const struct {
+    WORD formatTag;
+    WORD bits;
+} PROBE_ENCODINGS[] = {
+    { WAVE_FORMAT_PCM, 16 },
+    { WAVE_FORMAT_PCM, 24 },
+    { WAVE_FORMAT_PCM, 32 },
+    { WAVE_FORMAT_IEEE_FLOAT, 32 }
+};
+
+static inline bool isSameFormat(const WAVEFORMATEX* a, const WAVEFORMATEX* b) {
+    return a->nSamplesPerSec == b->nSamplesPerSec && a->nChannels == b->nChannels
+        && a->wBitsPerSample == b->wBitsPerSample
+        && getSampleType(a) == getSampleType(b);
+}
+
+extern "C" {
+    JNIEXPORT jboolean JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPIExclusiveBackend_nIsExclusiveFormatSupported
+    (JNIEnv* env, jobject obj, jobject jport, jobject jformat) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPIExclusiveBackend.nIsExclusiveFormatSupported");
+
+        if (!jport || !jformat) {
+            logger->info(env, "AudioPort or AudioFormat is null.");
+            return JNI_FALSE;
+        }
+
+        IMMDevice* device = AudioPort_to_IMMDevice(env, jport);
+        if (!device) {
+            logger->warn(env, "Failed to get IMMDevice.");
+            return JNI_FALSE;
+        }
+
+        WAVEFORMATEX* format = AudioFormat_to_WAVEFORMATEX(env, jformat);
+        if (!format) {
+            device->Release();
+            logger->warn(env, "Failed to get WAVEFORMATEX.");
+            return JNI_FALSE;
+        }
+
+        IAudioClient* audioClient = nullptr;
+        HRESULT hr = device->Activate(__uuidof(IAudioClient), CLSCTX_ALL, NULL, (void**)&audioClient);
+        device->Release();
+        if (FAILED(hr) || audioClient == nullptr) {
+            CoTaskMemFree(format);
+            logger->warn(env, "Failed to get or activate IAudioClient (%s).", fmtHR(hr));
+            return JNI_FALSE;
+        }
+
+        hr = findExclusiveFormat(audioClient, format, nullptr);
+        audioClient->Release();
+        if (logger->isTraceEnabled()) logger->trace(env, "Exclusive format %s: %s", WAVEFORMATEX_toText(format), fmtHR(hr));
+        CoTaskMemFree(format);
+
+        return hr == S_OK ? JNI_TRUE : JNI_FALSE;
+    }
+
+    JNIEXPORT jobjectArray JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPIExclusiveBackend_nGetExclusiveFormats
+    (JNIEnv* env, jobject obj, jobject jport) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPIExclusiveBackend.nGetExclusiveFormats");
+
+        if (!jport) {
+            logger->info(env, "AudioPort is null.");
+            return nullptr;
+        }
+
+        IMMDevice* device = AudioPort_to_IMMDevice(env, jport);
+        if (!device) {
+            logger->warn(env, "Failed to get IMMDevice.");
+            return nullptr;
+        }
+
+        IAudioClient* audioClient = nullptr;
+        HRESULT hr = device->Activate(__uuidof(IAudioClient), CLSCTX_ALL, NULL, (void**)&audioClient);
+        if (FAILED(hr) || audioClient == nullptr) {
+            device->Release();
+            logger->warn(env, "Failed to get or activate IAudioClient (%s).", fmtHR(hr));
+            return nullptr;
+        }
+
+        std::vector<WAVEFORMATEX> supported;
+
+        // The device format goes first: opening with it skips every conversion in the driver
+        WAVEFORMATEX* deviceFormat = getDeviceFormat(device);
+        device->Release();
+        using theko::sound::conversion::SampleType;
+        if (deviceFormat && getSampleType(deviceFormat) != SampleType::UNSUPPORTED) {
+            if (logger->isTraceEnabled()) logger->trace(env, "Device format: %s", WAVEFORMATEX_toText(deviceFormat));
+            WAVEFORMATEX plain = *deviceFormat;
+            plain.wFormatTag = getSampleType(deviceFormat) == SampleType::FLOAT32 ? WAVE_FORMAT_IEEE_FLOAT : WAVE_FORMAT_PCM;
+            plain.cbSize = 0;
+            if (findExclusiveFormat(audioClient, deviceFormat, nullptr) == S_OK) {
+                supported.push_back(plain);
+            }
+        }
+
+        WORD channels = deviceFormat ? deviceFormat->nChannels : 2;
+        if (deviceFormat) CoTaskMemFree(deviceFormat);
+
+        for (DWORD sampleRate : PROBE_SAMPLE_RATES) {
+            for (const auto& encoding : PROBE_ENCODINGS) {
+                WAVEFORMATEX candidate = {};
+                candidate.wFormatTag = encoding.formatTag;
+                candidate.nChannels = channels;
+                candidate.nSamplesPerSec = sampleRate;
+                candidate.wBitsPerSample = encoding.bits;
+                candidate.nBlockAlign = (WORD)(channels * encoding.bits / 8);
+                candidate.nAvgBytesPerSec = sampleRate * candidate.nBlockAlign;
+                candidate.cbSize = 0;
+
+                bool known = false;
+                for (const WAVEFORMATEX& format : supported) {
+                    if (isSameFormat(&format, &candidate)) known = true;
+                }
+                if (!known && findExclusiveFormat(audioClient, &candidate, nullptr) == S_OK) {
+                    supported.push_back(candidate);
+                }
+            }
+        }
+        audioClient->Release();
+
+        logger->debug(env, "Found %u formats supported in exclusive mode.", (unsigned)supported.size());
+
+        jobjectArray result = env->NewObjectArray((jsize)supported.size(), ThekoSound_AudioFormat::getClazz(env), nullptr);
+        if (!result) {
+            logger->warn(env, "Failed to create AudioFormat array.");
+            return nullptr;
+        }
+        for (size_t i = 0; i < supported.size(); i++) {
+            jobject jformat = WAVEFORMATEX_to_AudioFormat(env, &supported[i]);
+            if (!jformat) continue;
+            env->SetObjectArrayElement(result, (jsize)i, jformat);
+            env->DeleteLocalRef(jformat);
+        }
+
+        return result;
+    }
+}
+}
@@ -0,0 +1,803 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <jni.h>
+
+#include <windows.h>
+#include <initguid.h>
+#include <mmdeviceapi.h>
+#include <audioclient.h>
+#include <avrt.h>
+#include <functiondiscoverykeys.h>
+#include <Functiondiscoverykeys_devpkey.h>
+#include <algorithm>
+#include <atomic>
+
+#include "logger.hpp"
+#include "logger_manager.hpp"
+#include "helper_utilities.hpp"
+#include "spsc_ring_buffer.hpp"
+#include "clock_snapshot.hpp"
+#include "stream_telemetry.hpp"
+
+#include "org_theko_sound_backends_wasapi_WASAPIExclusiveOutput.h"
+#include "cache/Java_Concurrent_AtomicReference.hpp"
+#include "cache/ThekoSound_DeviceInvalidatedException.hpp"
+
+#include "wasapi_utils.hpp"
+#include "wasapi_bridge.hpp"
+
+#define EVENT_AUDIO_BUFFER_READY 0
+#define EVENT_STOP_REQUEST 1
+
+#define RENDER_THREAD_NAME "WASAPIExclusiveOutput-Render"
+#define RENDER_THREAD_WAIT_TIMEOUT 2000 // ms
+#define MIN_RING_PERIODS 2
+
+namespace theko::sound::backend::wasapi::exclusive_output {
+
+/*
+ * In exclusive event-driven mode the endpoint buffer holds exactly one device period,
+ * and every buffer-ready event asks for a whole period. The ring buffer holds
+ * the amount of audio requested by Java.
+ */
+class ExclusiveOutputContext {
+public:
+    IMMDevice* outputDevice;
+    IAudioClient* audioClient;
+    IAudioRenderClient* renderClient;
+    IAudioClock* audioClock;
+    UINT64 clockFrequency;
+    REFERENCE_TIME streamLatency;
+    ClockSnapshot clock;        // Published every period, read by Java through nGetClockBuffer
+    StreamTelemetry telemetry;  // Written by the render thread, read by Java through nGetTelemetryBuffer
+    HANDLE events[2];
+    UINT32 bufferFrameCount;    // One device period
+    UINT32 bytesPerFrame;
+    WAVEFORMATEX* format;       // Form of the format accepted by the driver
+    REFERENCE_TIME hnsPeriod;
+
+    SpscRingBuffer ring;
+    std::atomic<bool> flushRequested;
+    std::atomic<size_t> flushPosition;      // Ring write position at the last flush
+    std::atomic<bool> deviceInvalidated;
+    std::atomic<bool> renderFailed;         // The render thread stopped on an error
+
+    JavaVM* jvm;
+    HANDLE renderThread;
+    std::atomic<bool> stopRequested;
+
+    ExclusiveOutputContext() {
+        outputDevice = nullptr;
+        audioClient = nullptr;
+        renderClient = nullptr;
+        audioClock = nullptr;
+        clockFrequency = 0;
+        streamLatency = 0;
+        events[0] = nullptr;
+        events[1] = nullptr;
+        bufferFrameCount = 0;
+        bytesPerFrame = 0;
+        format = nullptr;
+        hnsPeriod = 0;
+        jvm = nullptr;
+        renderThread = nullptr;
+        stopRequested = false;
+        flushRequested = false;
+        flushPosition = 0;
+        deviceInvalidated = false;
+        renderFailed = false;
+    }
+
+    ExclusiveOutputContext(const ExclusiveOutputContext&) = delete;
+    ExclusiveOutputContext& operator=(const ExclusiveOutputContext&) = delete;
+
+    ~ExclusiveOutputContext() {
+        if (audioClient) {
+            audioClient->Stop();
+        }
+
+        if (renderClient) renderClient->Release();
+        if (audioClock) audioClock->Release();
+        if (audioClient) audioClient->Release();
+        if (outputDevice) outputDevice->Release();
+
+        if (renderThread) CloseHandle(renderThread);
+        if (events[0]) CloseHandle(events[0]);
+        if (events[1]) CloseHandle(events[1]);
+
+        if (format) CoTaskMemFree(format);
+    }
+};
+
+extern "C" {
+    static inline void cleanupAndThrowError(
+        JNIEnv* env,
+        Logger* logger,
+        ExclusiveOutputContext* ctx,
+        HRESULT hr,
+        const char* msg
+        ) {
+        logger->error(env, "%s (%s).", msg, fmtHR(hr));
+
+        logger->trace(env, "Cleaning up output context...");
+        if (ctx) delete ctx;
+        logger->trace(env, "Output context cleaned up, throwing exception...");
+
+        env->ThrowNew(ThekoSound_AudioBackendException::getClazz(env), msg);
+    }
+
+    static inline bool isDeviceInvalidatedError(HRESULT hr) {
+        return hr == AUDCLNT_E_DEVICE_INVALIDATED || hr == AUDCLNT_E_SERVICE_NOT_RUNNING;
+    }
+
+    /*
+     * Fills one whole device period from the ring buffer, padding it with silence.
+     * An empty ring is an underrun and is rendered as a silent period.
+     */
+    static HRESULT renderPeriod(ExclusiveOutputContext* context) {
+        const UINT32 frames = context->bufferFrameCount;
+        const size_t periodBytes = (size_t)frames * context->bytesPerFrame;
+
+        int64_t bufferStart = StreamTelemetry::now();
+        BYTE* dest = nullptr;
+        HRESULT hr = context->renderClient->GetBuffer(frames, &dest);
+        if (FAILED(hr)) return hr;
+
+        size_t queued = context->ring.availableToRead();
+        size_t bytes = std::min(periodBytes, queued - queued % context->bytesPerFrame);
+        if (bytes > 0) {
+            context->ring.read(dest, bytes);
+        }
+        if (bytes < periodBytes) {
+            memset(dest + bytes, 0, periodBytes - bytes);
+            context->telemetry.onGlitch();
+        }
+        if (bytes == 0) context->telemetry.onSilentBuffer();
+
+        hr = context->renderClient->ReleaseBuffer(frames, bytes == 0 ? AUDCLNT_BUFFERFLAGS_SILENT : 0);
+        context->telemetry.onBufferReleased(StreamTelemetry::now() - bufferStart);
+        return hr;
+    }
+
+    static inline HRESULT publishExclusiveClock(ExclusiveOutputContext* context, UINT32 padding) {
+        UINT64 buffered = padding + context->ring.availableToRead() / context->bytesPerFrame;
+        return publishClock(context->audioClock, context->clockFrequency, context->format->nSamplesPerSec,
+                            context->streamLatency, buffered, &context->clock);
+    }
+
+    /*
+     * Render thread. Waits for the buffer-ready event and renders one period from the ring buffer.
+     * Registered in MMCSS as "Pro Audio".
+     */
+    static DWORD WINAPI renderThreadProc(LPVOID param) {
+        auto context = (ExclusiveOutputContext*)param;
+
+        JNIEnv* env = nullptr;
+        JavaVMAttachArgs attachArgs;
+        attachArgs.version = JNI_VERSION_1_6;
+        attachArgs.name = (char*)RENDER_THREAD_NAME;
+        attachArgs.group = nullptr;
+        if (context->jvm->AttachCurrentThreadAsDaemon((void**)&env, &attachArgs) != JNI_OK) {
+            return 1;
+        }
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPIExclusiveOutput.renderThread");
+
+        HRESULT hrCom = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+
+        DWORD taskIndex = 0;
+        HANDLE mmcssHandle = AvSetMmThreadCharacteristicsW(L"Pro Audio", &taskIndex);
+        if (!mmcssHandle) {
+            logger->warn(env, "Failed to register render thread in MMCSS (error %lu).", GetLastError());
+        } else {
+            AvSetMmThreadPriority(mmcssHandle, AVRT_PRIORITY_CRITICAL);
+            logger->debug(env, "Render thread registered in MMCSS. Task index: %lu.", taskIndex);
+        }
+
+        while (!context->stopRequested.load(std::memory_order_acquire)) {
+            DWORD waitResult = WaitForMultipleObjects(2, context->events, FALSE, RENDER_THREAD_WAIT_TIMEOUT);
+
+            if (waitResult == WAIT_OBJECT_0 + EVENT_STOP_REQUEST) {
+                break;
+            } else if (waitResult == WAIT_TIMEOUT) {
+                context->telemetry.onWakeTimeout();
+                logger->warn(env, "No buffer event received in %d ms.", RENDER_THREAD_WAIT_TIMEOUT);
+                continue;
+            } else if (waitResult != WAIT_OBJECT_0 + EVENT_AUDIO_BUFFER_READY) {
+                logger->error(env, "WaitForMultipleObjects failed: %lu", GetLastError());
+                context->renderFailed.store(true, std::memory_order_release);
+                break;
+            }
+            int64_t wakeTime = StreamTelemetry::now();
+
+            if (context->flushRequested.exchange(false, std::memory_order_acq_rel)) {
+                context->ring.discardTo(context->flushPosition.load(std::memory_order_acquire));
+            }
+
+            // The buffer-ready event means the endpoint has one period left to play
+            context->telemetry.onWake(wakeTime, context->bufferFrameCount);
+            publishExclusiveClock(context, context->bufferFrameCount);
+
+            HRESULT hr = renderPeriod(context);
+            if (FAILED(hr)) {
+                if (isDeviceInvalidatedError(hr)) {
+                    context->deviceInvalidated.store(true, std::memory_order_release);
+                    context->telemetry.onDeviceInvalidated();
+                    logger->warn(env, "Render thread stopped, device invalidated (%s).", fmtHR(hr));
+                } else {
+                    logger->error(env, "Failed to fill WASAPI output buffer (%s).", fmtHR(hr));
+                    context->renderFailed.store(true, std::memory_order_release);
+                }
+                break;
+            }
+        }
+
+        if (mmcssHandle) AvRevertMmThreadCharacteristics(mmcssHandle);
+        if (SUCCEEDED(hrCom)) CoUninitialize();
+
+        logger->trace(env, "Render thread finished.");
+        context->jvm->DetachCurrentThread();
+        return 0;
+    }
+
+    static bool startRenderThread(JNIEnv* env, Logger* logger, ExclusiveOutputContext* context) {
+        if (env->GetJavaVM(&context->jvm) != JNI_OK) {
+            logger->error(env, "Failed to get JavaVM.");
+            return false;
+        }
+
+        context->telemetry.configure(context->bufferFrameCount, context->bufferFrameCount, context->format->nSamplesPerSec);
+        context->stopRequested.store(false, std::memory_order_release);
+        context->renderThread = CreateThread(NULL, 0, renderThreadProc, context, 0, NULL);
+        if (!context->renderThread) {
+            logger->error(env, "Failed to create render thread (error %lu).", GetLastError());
+            return false;
+        }
+
+        logger->debug(env, "Render thread started. Period: %u frames.", context->bufferFrameCount);
+        return true;
+    }
+
+    static void stopRenderThread(JNIEnv* env, Logger* logger, ExclusiveOutputContext* context) {
+        if (!context->renderThread) return;
+
+        context->stopRequested.store(true, std::memory_order_release);
+        SetEvent(context->events[EVENT_STOP_REQUEST]);
+
+        DWORD waitResult = WaitForSingleObject(context->renderThread, INFINITE);
+        if (waitResult != WAIT_OBJECT_0) {
+            logger->warn(env, "Failed to wait for render thread: %lu", GetLastError());
+        }
+        CloseHandle(context->renderThread);
+        context->renderThread = nullptr;
+        logger->trace(env, "Render thread stopped.");
+    }
+
+    /*
+     * Initializes the audio client in exclusive event-driven mode, where the buffer duration
+     * must equal the periodicity. If the driver reports AUDCLNT_E_BUFFER_SIZE_NOT_ALIGNED,
+     * the period is recomputed from the aligned buffer size and the client is initialized again.
+     */
+    static HRESULT initializeExclusive(JNIEnv* env, Logger* logger, ExclusiveOutputContext* context, REFERENCE_TIME hnsPeriod) {
+        logger->trace(env, "Trying to initialize IAudioClient with %lld hns period...", hnsPeriod);
+        HRESULT hr = context->audioClient->Initialize(
+            AUDCLNT_SHAREMODE_EXCLUSIVE,
+            AUDCLNT_STREAMFLAGS_EVENTCALLBACK,
+            hnsPeriod,
+            hnsPeriod,
+            context->format,
+            nullptr
+        );
+        logger->trace(env, "IAudioClient::Initialize called. Result: %s", fmtHR(hr));
+
+        if (hr == AUDCLNT_E_BUFFER_SIZE_NOT_ALIGNED) {
+            UINT32 alignedFrames = 0;
+            hr = context->audioClient->GetBufferSize(&alignedFrames);
+            if (FAILED(hr) || alignedFrames == 0) return FAILED(hr) ? hr : AUDCLNT_E_BUFFER_SIZE_NOT_ALIGNED;
+
+            hnsPeriod = (REFERENCE_TIME)(10000000.0 * alignedFrames / context->format->nSamplesPerSec + 0.5);
+            logger->debug(env, "Buffer size is not aligned, retrying with %u frames (%lld hns).", alignedFrames, hnsPeriod);
+
+            // A failed initialization leaves the client unusable, activate a fresh one
+            context->audioClient->Release();
+            context->audioClient = nullptr;
+            hr = context->outputDevice->Activate(__uuidof(IAudioClient), CLSCTX_ALL, nullptr, (void**)&context->audioClient);
+            if (FAILED(hr) || !context->audioClient) return FAILED(hr) ? hr : E_POINTER;
+
+            hr = context->audioClient->Initialize(
+                AUDCLNT_SHAREMODE_EXCLUSIVE,
+                AUDCLNT_STREAMFLAGS_EVENTCALLBACK,
+                hnsPeriod,
+                hnsPeriod,
+                context->format,
+                nullptr
+            );
+            logger->trace(env, "IAudioClient::Initialize (aligned) called. Result: %s", fmtHR(hr));
+        }
+
+        if (SUCCEEDED(hr)) context->hnsPeriod = hnsPeriod;
+        return hr;
+    }
+
+    JNIEXPORT jlong JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPIExclusiveOutput_nOpen
+    (JNIEnv* env, jobject obj, jobject jport, jobject jformat, jint bufferSize /* in bytes */, jobject jAtomicRefFormat, jboolean lowLatency) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPIExclusiveOutput.nOpen");
+
+        if (!jport || !jformat || !jAtomicRefFormat) return 0;
+
+        auto context = new ExclusiveOutputContext();
+        logger->trace(env, "ExclusiveOutputContext allocated. Pointer: %s", FORMAT_PTR(context));
+
+        context->outputDevice = AudioPort_to_IMMDevice(env, jport);
+        if (!context->outputDevice) {
+            cleanupAndThrowError(env, logger, context, E_FAIL, "Failed to get IMMDevice.");
+            return 0;
+        }
+
+        WAVEFORMATEX* requested = AudioFormat_to_WAVEFORMATEX(env, jformat);
+        if (!requested) {
+            cleanupAndThrowError(env, logger, context, E_FAIL, "Failed to get WAVEFORMATEX.");
+            return 0;
+        }
+        if (logger->isTraceEnabled()) logger->trace(env, "WAVEFORMATEX (Request): %s", WAVEFORMATEX_toText(requested));
+
+        HRESULT hr = context->outputDevice->Activate(__uuidof(IAudioClient), CLSCTX_ALL, nullptr, (void**)&context->audioClient);
+        if (FAILED(hr) || !context->audioClient) {
+            CoTaskMemFree(requested);
+            cleanupAndThrowError(env, logger, context, hr, "Failed to get IAudioClient.");
+            return 0;
+        }
+
+        // Exclusive mode has no closest match: the stream runs in the requested format or not at all
+        hr = findExclusiveFormat(context->audioClient, requested, &context->format);
+        CoTaskMemFree(requested);
+        if (hr != S_OK || !context->format) {
+            cleanupAndThrowError(env, logger, context, hr, "Format is not supported in exclusive mode.");
+            return 0;
+        }
+        if (logger->isTraceEnabled()) logger->trace(env, "WAVEFORMATEX (Accepted): %s", WAVEFORMATEX_toText(context->format));
+
+        REFERENCE_TIME hnsDefaultPeriod = 0, hnsMinimumPeriod = 0;
+        hr = context->audioClient->GetDevicePeriod(&hnsDefaultPeriod, &hnsMinimumPeriod);
+        if (FAILED(hr) || hnsDefaultPeriod <= 0) {
+            cleanupAndThrowError(env, logger, context, hr, "Failed to get device period.");
+            return 0;
+        }
+        REFERENCE_TIME hnsPeriod = (lowLatency && hnsMinimumPeriod > 0) ? hnsMinimumPeriod : hnsDefaultPeriod;
+        logger->debug(env, "Device period (in 100-ns): default %lld, minimum %lld, using %lld",
+            hnsDefaultPeriod, hnsMinimumPeriod, hnsPeriod);
+
+        hr = initializeExclusive(env, logger, context, hnsPeriod);
+        if (hr == AUDCLNT_E_DEVICE_IN_USE) {
+            cleanupAndThrowError(env, logger, context, hr, "Device is in use.");
+            return 0;
+        } else if (hr == AUDCLNT_E_EXCLUSIVE_MODE_NOT_ALLOWED) {
+            cleanupAndThrowError(env, logger, context, hr, "Exclusive mode is not allowed for the device.");
+            return 0;
+        } else if (FAILED(hr)) {
+            cleanupAndThrowError(env, logger, context, hr, "Failed to initialize IAudioClient in exclusive mode.");
+            return 0;
+        }
+        logger->trace(env, "IAudioClient initialized.");
+
+        hr = context->audioClient->GetService(__uuidof(IAudioRenderClient), (void**)&context->renderClient);
+        if (FAILED(hr) || !context->renderClient) {
+            cleanupAndThrowError(env, logger, context, hr, "Failed to get IAudioRenderClient.");
+            return 0;
+        }
+
+        hr = context->audioClient->GetService(__uuidof(IAudioClock), (void**)&context->audioClock);
+        if (FAILED(hr) || !context->audioClock) {
+            cleanupAndThrowError(env, logger, context, hr, "Failed to get IAudioClock.");
+            return 0;
+        }
+
+        hr = context->audioClock->GetFrequency(&context->clockFrequency);
+        if (FAILED(hr) || context->clockFrequency == 0) {
+            cleanupAndThrowError(env, logger, context, FAILED(hr) ? hr : E_FAIL, "Failed to get IAudioClock frequency.");
+            return 0;
+        }
+        context->audioClient->GetStreamLatency(&context->streamLatency);
+
+        context->events[EVENT_AUDIO_BUFFER_READY] = CreateEvent(NULL, FALSE, FALSE, NULL);
+        if (!context->events[EVENT_AUDIO_BUFFER_READY]) {
+            cleanupAndThrowError(env, logger, context, E_FAIL, "Failed to create audio callback event.");
+            return 0;
+        }
+        context->audioClient->SetEventHandle(context->events[EVENT_AUDIO_BUFFER_READY]);
+
+        context->events[EVENT_STOP_REQUEST] = CreateEvent(NULL, TRUE, FALSE, NULL);
+        if (!context->events[EVENT_STOP_REQUEST]) {
+            cleanupAndThrowError(env, logger, context, E_FAIL, "Failed to create stop event.");
+            return 0;
+        }
+
+        context->audioClient->GetBufferSize(&context->bufferFrameCount);
+        context->bytesPerFrame = context->format->nBlockAlign;
+        logger->debug(env, "Period: %u frames.", context->bufferFrameCount);
+
+        UINT32 requestedFrames = (UINT32)std::max(bufferSize, 0) / context->bytesPerFrame;
+        UINT32 ringFrames = std::max(requestedFrames, MIN_RING_PERIODS * context->bufferFrameCount);
+        if (!context->ring.allocate((size_t)ringFrames * context->bytesPerFrame)) {
+            cleanupAndThrowError(env, logger, context, E_OUTOFMEMORY, "Failed to allocate ring buffer.");
+            return 0;
+        }
+        logger->debug(env, "Ring buffer size: %u frames", ringFrames);
+
+        jobject jAudioFormat = WAVEFORMATEX_to_AudioFormat(env, context->format);
+        if (!jAudioFormat) {
+            cleanupAndThrowError(env, logger, context, E_FAIL, "Failed to create audio format.");
+            return 0;
+        }
+        Java_Concurrent_AtomicReference::set(env, jAtomicRefFormat, jAudioFormat);
+        env->DeleteLocalRef(jAudioFormat);
+
+        logger->debug(env, "Opened WASAPI exclusive output. ContextPtr: %s", FORMAT_PTR(context));
+
+        return (jlong)context;
+    }
+
+    JNIEXPORT void JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPIExclusiveOutput_nClose
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPIExclusiveOutput.nClose");
+
+        auto context = (ExclusiveOutputContext*)ptr;
+        if (!context) {
+            logger->debug(env, "WASAPI exclusive output already closed.");
+            return;
+        }
+
+        stopRenderThread(env, logger, context);
+        delete context; // Stops the stream and releases its interfaces
+        logger->trace(env, "Closed WASAPI exclusive output.");
+    }
+
+    JNIEXPORT void JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPIExclusiveOutput_nStart
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPIExclusiveOutput.nStart");
+        auto context = (ExclusiveOutputContext*)ptr;
+        if (!context) {
+            logger->info(env, "WASAPI exclusive output not opened.");
+            return;
+        }
+        if (context->renderThread) return;
+
+        ResetEvent(context->events[EVENT_STOP_REQUEST]);
+        context->deviceInvalidated.store(false, std::memory_order_release);
+        context->renderFailed.store(false, std::memory_order_release);
+
+        // Pre-roll one period, so the first buffer-ready event does not start with a glitch
+        HRESULT hr = renderPeriod(context);
+        if (FAILED(hr) && hr != AUDCLNT_E_BUFFER_TOO_LARGE) {
+            logger->warn(env, "Failed to pre-roll WASAPI exclusive output (%s).", fmtHR(hr));
+        }
+
+        hr = context->audioClient->Start();
+        if (FAILED(hr)) {
+            logger->error(env, "Failed to start WASAPI exclusive output (%s).", fmtHR(hr));
+            env->ThrowNew(ThekoSound_AudioBackendException::getClazz(env), "Failed to start WASAPI exclusive output.");
+            return;
+        }
+        logger->trace(env, "Started WASAPI exclusive output.");
+
+        if (!startRenderThread(env, logger, context)) {
+            context->audioClient->Stop();
+            env->ThrowNew(ThekoSound_AudioBackendException::getClazz(env), "Failed to start render thread.");
+        }
+    }
+
+    JNIEXPORT void JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPIExclusiveOutput_nStop
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPIExclusiveOutput.nStop");
+        auto context = (ExclusiveOutputContext*)ptr;
+        if (!context) {
+            logger->info(env, "WASAPI exclusive output not opened.");
+            return;
+        }
+
+        stopRenderThread(env, logger, context);
+
+        HRESULT hr = context->audioClient->Stop();
+        if (FAILED(hr)) {
+            logger->warn(env, "Failed to stop WASAPI exclusive output (%s).", fmtHR(hr));
+        }
+        // Drop the queued period, the next start pre-rolls a fresh one
+        hr = context->audioClient->Reset();
+        if (FAILED(hr)) {
+            logger->debug(env, "Failed to reset WASAPI exclusive output (%s).", fmtHR(hr));
+        }
+        logger->trace(env, "Stopped WASAPI exclusive output.");
+    }
+
+    JNIEXPORT void JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPIExclusiveOutput_nFlush
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPIExclusiveOutput.nFlush");
+        auto context = (ExclusiveOutputContext*)ptr;
+        if (!context) {
+            logger->info(env, "WASAPI exclusive output not opened.");
+            return;
+        }
+
+        if (context->renderThread) {
+            // The ring can only be discarded by its consumer, which drops only the data
+            // written up to this point, so writes after the flush are kept
+            context->flushPosition.store(context->ring.getWritePosition(), std::memory_order_release);
+            context->flushRequested.store(true, std::memory_order_release);
+        } else {
+            context->ring.discard();
+        }
+    }
+
+    JNIEXPORT void JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPIExclusiveOutput_nDrain
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPIExclusiveOutput.nDrain");
+        auto context = (ExclusiveOutputContext*)ptr;
+        if (!context) {
+            logger->info(env, "WASAPI exclusive output not opened.");
+            return;
+        }
+
+        if (!context->renderThread) {
+            logger->debug(env, "Render thread is not running, nothing to drain.");
+            return;
+        }
+
+        // Poll on the stop event: it is manual-reset, so waiting on it does not
+        // steal buffer-ready signals from the render thread.
+        DWORD periodMs = std::max<DWORD>(1, (DWORD)(context->hnsPeriod / 10000));
+        while (context->ring.availableToRead() >= context->bytesPerFrame) {
+            if (context->deviceInvalidated.load(std::memory_order_acquire)) {
+                logger->warn(env, "Device invalidated during drain.");
+                env->ThrowNew(ThekoSound_DeviceInvalidatedException::getClazz(env), "Device invalidated during drain");
+                return;
+            }
+            if (context->renderFailed.load(std::memory_order_acquire)) {
+                logger->error(env, "Render thread stopped on an error during drain.");
+                env->ThrowNew(ThekoSound_AudioBackendException::getClazz(env), "Render thread stopped on an error during drain.");
+                return;
+            }
+            if (WaitForSingleObject(context->events[EVENT_STOP_REQUEST], periodMs) == WAIT_OBJECT_0) {
+                logger->debug(env, "Drain operation interrupted by stop event");
+                return;
+            }
+        }
+
+        // The last periods are still queued in the endpoint buffer
+        WaitForSingleObject(context->events[EVENT_STOP_REQUEST], periodMs * MIN_RING_PERIODS);
+    }
+
+    static bool canWrite(JNIEnv* env, Logger* logger, ExclusiveOutputContext* context) {
+        if (!context) {
+            logger->info(env, "WASAPI exclusive output not opened.");
+            return false;
+        }
+
+        if (context->deviceInvalidated.load(std::memory_order_relaxed)) {
+            logger->error(env, "Device invalidated, write rejected.");
+            env->ThrowNew(ThekoSound_DeviceInvalidatedException::getClazz(env), "Device invalidated.");
+            return false;
+        }
+        return true;
+    }
+
+    // Non-blocking: the number of bytes, in whole frames, that fit into the ring
+    static inline size_t writableBytes(ExclusiveOutputContext* context, jint length) {
+        size_t writable = std::min<size_t>(length, context->ring.availableToWrite());
+        return writable - writable % context->bytesPerFrame;
+    }
+
+    JNIEXPORT jint JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPIExclusiveOutput_nWrite
+    (JNIEnv* env, jobject obj, jlong ptr, jbyteArray buffer, jint offset, jint length) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPIExclusiveOutput.nWrite");
+
+        auto context = (ExclusiveOutputContext*)ptr;
+        if (!canWrite(env, logger, context)) return -1;
+
+        if (offset < 0 || length < 0 || offset > env->GetArrayLength(buffer) - length) {
+            logger->error(env, "Invalid write range. Offset: %d, length: %d.", offset, length);
+            return -1;
+        }
+
+        size_t written = context->ring.writeWith(writableBytes(context, length),
+            [env, buffer, offset](uint8_t* dst, size_t srcOffset, size_t count) {
+                env->GetByteArrayRegion(buffer, offset + (jsize)srcOffset, (jsize)count, (jbyte*)dst);
+            });
+        return (jint)written;
+    }
+
+    JNIEXPORT jint JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPIExclusiveOutput_nWriteDirect
+    (JNIEnv* env, jobject obj, jlong ptr, jobject buffer, jint offset, jint length) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPIExclusiveOutput.nWriteDirect");
+
+        auto context = (ExclusiveOutputContext*)ptr;
+        if (!canWrite(env, logger, context)) return -1;
+
+        uint8_t* src = (uint8_t*)env->GetDirectBufferAddress(buffer);
+        jlong capacity = env->GetDirectBufferCapacity(buffer);
+        if (!src || capacity < 0) {
+            logger->error(env, "Buffer is not a direct buffer.");
+            return -1;
+        }
+        if (offset < 0 || length < 0 || (jlong)offset + length > capacity) {
+            logger->error(env, "Invalid write range. Offset: %d, length: %d.", offset, length);
+            return -1;
+        }
+
+        return (jint)context->ring.write(src + offset, writableBytes(context, length));
+    }
+
+    JNIEXPORT jint JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPIExclusiveOutput_nAvailable
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPIExclusiveOutput.nAvailable");
+        auto context = (ExclusiveOutputContext*)ptr;
+        if (!context) {
+            logger->info(env, "WASAPI exclusive output not opened.");
+            return -1;
+        }
+
+        size_t available = context->ring.availableToWrite();
+        available -= available % context->bytesPerFrame;
+        if (available > INT_MAX) return -1;
+        return (jint)available;
+    }
+
+    JNIEXPORT jint JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPIExclusiveOutput_nGetBufferSize
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPIExclusiveOutput.nGetBufferSize");
+        auto context = (ExclusiveOutputContext*)ptr;
+        if (!context) {
+            logger->info(env, "WASAPI exclusive output not opened.");
+            return -1;
+        }
+
+        size_t capacity = context->ring.getCapacity();
+        if (capacity > INT_MAX) return -1;
+        return (jint)capacity;
+    }
+
+    JNIEXPORT jlong JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPIExclusiveOutput_nGetFramePosition
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPIExclusiveOutput.nGetFramePosition");
+        auto context = (ExclusiveOutputContext*)ptr;
+        if (!context) {
+            logger->info(env, "WASAPI exclusive output not opened.");
+            return -1;
+        }
+
+        UINT64 position = 0;
+        HRESULT hr = context->audioClock->GetPosition(&position, nullptr);
+        if (FAILED(hr)) {
+            logger->error(env, "Failed to get WASAPI exclusive output position (%s).", fmtHR(hr));
+            return -1;
+        }
+
+        // In exclusive mode the clock may run in bytes, or in any device-specific unit
+        UINT64 frequency = context->clockFrequency;
+        UINT32 sampleRate = context->format->nSamplesPerSec;
+        return (jlong)((position / frequency) * sampleRate + (position % frequency) * sampleRate / frequency);
+    }
+
+    JNIEXPORT jobject JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPIExclusiveOutput_nGetClockBuffer
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPIExclusiveOutput.nGetClockBuffer");
+        auto context = (ExclusiveOutputContext*)ptr;
+        if (!context) {
+            logger->info(env, "WASAPI exclusive output not opened.");
+            return nullptr;
+        }
+
+        // Valid until nClose, the Java side drops it there
+        return env->NewDirectByteBuffer(context->clock.data(), (jlong)ClockSnapshot::size());
+    }
+
+    JNIEXPORT jobject JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPIExclusiveOutput_nGetTelemetryBuffer
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPIExclusiveOutput.nGetTelemetryBuffer");
+        auto context = (ExclusiveOutputContext*)ptr;
+        if (!context) {
+            logger->info(env, "WASAPI exclusive output not opened.");
+            return nullptr;
+        }
+
+        // Valid until nClose, the Java side drops it there
+        return env->NewDirectByteBuffer(context->telemetry.data(), (jlong)StreamTelemetry::size());
+    }
+
+    JNIEXPORT jboolean JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPIExclusiveOutput_nUpdateClock
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPIExclusiveOutput.nUpdateClock");
+        auto context = (ExclusiveOutputContext*)ptr;
+        if (!context) {
+            logger->info(env, "WASAPI exclusive output not opened.");
+            return JNI_FALSE;
+        }
+
+        UINT32 padding = 0;
+        HRESULT hr = context->audioClient->GetCurrentPadding(&padding);
+        if (SUCCEEDED(hr)) hr = publishExclusiveClock(context, padding);
+        if (FAILED(hr)) {
+            logger->warn(env, "Failed to update WASAPI exclusive output clock (%s).", fmtHR(hr));
+            return JNI_FALSE;
+        }
+        return JNI_TRUE;
+    }
+
+    JNIEXPORT jlong JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPIExclusiveOutput_nGetMicrosecondLatency
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPIExclusiveOutput.nGetMicrosecondLatency");
+        auto context = (ExclusiveOutputContext*)ptr;
+        if (!context) {
+            logger->info(env, "WASAPI exclusive output not opened.");
+            return -1;
+        }
+
+        REFERENCE_TIME latency = 0;
+        HRESULT hr = context->audioClient->GetStreamLatency(&latency);
+        if (FAILED(hr)) {
+            logger->warn(env, "Failed to get WASAPI exclusive output latency (%s).", fmtHR(hr));
+            return -1;
+        }
+        // latency in 100-ns (1e-7 sec), converted to microseconds (1e-6 sec)
+        return latency > 0 ? (jlong)(latency / 10) : (jlong)(context->hnsPeriod / 10);
+    }
+
+    JNIEXPORT jint JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPIExclusiveOutput_nGetPeriodFrames
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPIExclusiveOutput.nGetPeriodFrames");
+        auto context = (ExclusiveOutputContext*)ptr;
+        if (!context) {
+            logger->info(env, "WASAPI exclusive output not opened.");
+            return -1;
+        }
+        return context->bufferFrameCount > 0 ? (jint)context->bufferFrameCount : -1;
+    }
+
+    JNIEXPORT jobject JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPIExclusiveOutput_nGetCurrentAudioPort
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPIExclusiveOutput.nGetCurrentAudioPort");
+        auto context = (ExclusiveOutputContext*)ptr;
+        if (!context) {
+            logger->info(env, "WASAPI exclusive output not opened.");
+            return nullptr;
+        }
+
+        jobject jAudioPort = IMMDevice_to_AudioPort(env, context->outputDevice);
+        if (!jAudioPort) {
+            logger->error(env, "Failed to convert IMMDevice to AudioPort.");
+            env->ThrowNew(ThekoSound_AudioBackendException::getClazz(env), "Failed to convert IMMDevice to AudioPort.");
+            return nullptr;
+        }
+        return jAudioPort;
+    }
+}
+}
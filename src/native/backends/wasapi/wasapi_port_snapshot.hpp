@@ -0,0 +1,489 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#ifdef _WIN32
+#include <windows.h>
+#include <mmdeviceapi.h>
+#include <functiondiscoverykeys.h>
+#include <Functiondiscoverykeys_devpkey.h>
+
+#include <jni.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "wasapi_utils.hpp"
+#include "wasapi_bridge.hpp"
+
+#include "logger.hpp"
+#include "logger_manager.hpp"
+
+#define FORMAT_PROBE_CACHE_LIMIT 256 // Cached probes per endpoint
+
+/**
+ * Process-wide snapshot of the WASAPI endpoints, as org.theko.sound.AudioPort objects.
+ *
+ * Converting an IMMDevice to an AudioPort opens its property store and activates an IAudioClient
+ * for the mix format, so the snapshot is filled once and then updated incrementally:
+ * an IMMNotificationClient queues the IDs of added, removed and changed endpoints,
+ * and only those are converted again on the next lookup.
+ *
+ * Notifications arrive on COM threads without a JNIEnv, they only touch the pending queue.
+ * The generation counter is increased on every change, so callers can cache the ports
+ * until it moves. The snapshot lives for the whole process, independently of backend contexts.
+ *
+ * Shared-mode IsFormatSupported results are cached per endpoint as well, and dropped
+ * when the endpoint changes (including its device format).
+ */
+class PortSnapshot : public IMMNotificationClient {
+private:
+    struct Entry {
+        std::wstring id;
+        jobject port; // Global reference
+    };
+
+    struct FormatProbe {
+        std::vector<uint8_t> format;
+        HRESULT result;
+        std::vector<uint8_t> closest; // Empty if there is no closest match
+    };
+
+    IMMDeviceEnumerator* enumerator = nullptr;
+    bool registered = false;
+
+    // Accessed from JNI threads only
+    std::mutex portsLock;
+    std::vector<Entry> ports[2]; // Indexed by EDataFlow (eRender, eCapture)
+    bool filled = false;
+
+    // Written by notifications
+    std::mutex pendingLock;
+    std::vector<std::wstring> pendingIds;
+    bool defaultStale[2] = { true, true };
+    std::wstring defaultIds[2];
+    std::atomic<uint64_t> generation{0};
+
+    // Written by JNI threads, dropped by notifications
+    std::mutex probesLock;
+    std::unordered_map<std::wstring, std::vector<FormatProbe>> probes;
+
+    PortSnapshot() = default;
+
+public:
+    PortSnapshot(const PortSnapshot&) = delete;
+    PortSnapshot& operator=(const PortSnapshot&) = delete;
+
+    /**
+     * @return The snapshot, or nullptr if it has not been created yet
+     */
+    static std::atomic<PortSnapshot*>& instance() {
+        static std::atomic<PortSnapshot*> snapshot{nullptr};
+        return snapshot;
+    }
+
+    /**
+     * Returns the snapshot, creating it and registering its notification client on first use.
+     * COM must be initialized on the calling thread.
+     */
+    static PortSnapshot* get(JNIEnv* env) {
+        static std::mutex createLock;
+        PortSnapshot* snapshot = instance().load(std::memory_order_acquire);
+        if (snapshot) return snapshot;
+
+        std::lock_guard<std::mutex> guard(createLock);
+        snapshot = instance().load(std::memory_order_relaxed);
+        if (snapshot) return snapshot;
+
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPIPortSnapshot");
+        snapshot = new PortSnapshot();
+        snapshot->enumerator = getDeviceEnumerator();
+        if (!snapshot->enumerator) {
+            logger->error(env, "Failed to create IMMDeviceEnumerator for the port snapshot.");
+            delete snapshot;
+            return nullptr;
+        }
+
+        HRESULT hr = snapshot->enumerator->RegisterEndpointNotificationCallback(snapshot);
+        snapshot->registered = SUCCEEDED(hr);
+        if (!snapshot->registered) {
+            // Without notifications, ports are enumerated again on every lookup
+            logger->warn(env, "Failed to register endpoint notifications (%s), port snapshot is disabled.", fmtHR(hr));
+        }
+
+        instance().store(snapshot, std::memory_order_release);
+        return snapshot;
+    }
+
+    /**
+     * @return True if endpoint changes are tracked, otherwise every lookup enumerates again
+     */
+    inline bool isTracking() const {
+        return registered;
+    }
+
+    /**
+     * @return The current generation, increased on every endpoint change
+     */
+    inline uint64_t getGeneration() const {
+        return generation.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Creates a Java array of all render ports followed by all capture ports.
+     */
+    jobjectArray getAllPorts(JNIEnv* env) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPIPortSnapshot.getAllPorts");
+
+        std::lock_guard<std::mutex> guard(portsLock);
+        refresh(env, logger);
+
+        jsize renderCount = (jsize)ports[eRender].size();
+        jsize captureCount = (jsize)ports[eCapture].size();
+        logger->trace(env, "Snapshot has %d render ports and %d capture ports.", renderCount, captureCount);
+
+        jobjectArray result = env->NewObjectArray(renderCount + captureCount, ThekoSound_AudioPort::getClazz(env), nullptr);
+        if (!result) {
+            logger->warn(env, "Failed to create AudioPort array.");
+            return nullptr;
+        }
+
+        jsize index = 0;
+        for (int flow = eRender; flow <= eCapture; flow++) {
+            for (const Entry& entry : ports[flow]) {
+                env->SetObjectArrayElement(result, index++, entry.port);
+            }
+        }
+        return result;
+    }
+
+    /**
+     * Returns a local reference to the default console port of the flow, or nullptr if there is none.
+     */
+    jobject getDefaultPort(JNIEnv* env, EDataFlow flow) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPIPortSnapshot.getDefaultPort");
+
+        std::wstring defaultId;
+        uint64_t seenGeneration = getGeneration();
+        {
+            std::lock_guard<std::mutex> guard(pendingLock);
+            if (!defaultStale[flow]) defaultId = defaultIds[flow];
+        }
+
+        if (defaultId.empty()) {
+            IMMDevice* device = nullptr;
+            HRESULT hr = enumerator->GetDefaultAudioEndpoint(flow, eConsole, &device);
+            if (FAILED(hr) || !device) {
+                logger->warn(env, "Failed to get default audio endpoint for flow %s (%s).",
+                    flow == eRender ? "Render" : "Capture", fmtHR(hr));
+                return nullptr;
+            }
+            LPWSTR id = nullptr;
+            if (SUCCEEDED(device->GetId(&id)) && id) {
+                defaultId = id;
+                CoTaskMemFree(id);
+            }
+            device->Release();
+            if (defaultId.empty()) return nullptr;
+
+            std::lock_guard<std::mutex> guard(pendingLock);
+            if (registered && generation.load(std::memory_order_relaxed) == seenGeneration) {
+                // Not cached if the default changed while it was queried
+                defaultIds[flow] = defaultId;
+                defaultStale[flow] = false;
+            }
+        }
+
+        std::lock_guard<std::mutex> guard(portsLock);
+        refresh(env, logger);
+        for (const Entry& entry : ports[flow]) {
+            if (entry.id == defaultId) {
+                logger->trace(env, "Default audio endpoint: %s", utf16_to_utf8(defaultId.c_str()).c_str());
+                return env->NewLocalRef(entry.port);
+            }
+        }
+
+        logger->debug(env, "Default audio endpoint is not in the snapshot.");
+        return nullptr;
+    }
+
+    /**
+     * Tests the formats in shared mode on the device, activating a single IAudioClient
+     * for all of them and reusing the cached results of the endpoint.
+     *
+     * results[i] receives the IsFormatSupported result: S_OK, S_FALSE (closest[i] is set),
+     * or an error. closest[i] is allocated with CoTaskMemAlloc and owned by the caller.
+     * Works without a snapshot too, just without caching.
+     *
+     * @return S_OK, or the error of the IAudioClient activation
+     */
+    static HRESULT probeFormats(IMMDevice* device, WAVEFORMATEX* const* formats, size_t count,
+                                HRESULT* results, WAVEFORMATEX** closest) {
+        for (size_t i = 0; i < count; i++) {
+            results[i] = formats[i] ? E_PENDING : E_POINTER;
+            closest[i] = nullptr;
+        }
+
+        PortSnapshot* snapshot = instance().load(std::memory_order_acquire);
+        std::wstring id;
+        if (snapshot && snapshot->registered) {
+            LPWSTR deviceId = nullptr;
+            if (SUCCEEDED(device->GetId(&deviceId)) && deviceId) {
+                id = deviceId;
+                CoTaskMemFree(deviceId);
+            }
+        }
+        bool cached = !id.empty();
+
+        if (cached) {
+            std::lock_guard<std::mutex> guard(snapshot->probesLock);
+            auto it = snapshot->probes.find(id);
+            if (it != snapshot->probes.end()) {
+                for (size_t i = 0; i < count; i++) {
+                    if (results[i] != E_PENDING) continue;
+                    for (const FormatProbe& probe : it->second) {
+                        if (!matches(probe.format, formats[i])) continue;
+                        results[i] = probe.result;
+                        if (!probe.closest.empty()) closest[i] = fromBytes(probe.closest);
+                        break;
+                    }
+                }
+            }
+        }
+
+        std::vector<size_t> misses;
+        for (size_t i = 0; i < count; i++) {
+            if (results[i] == E_PENDING) misses.push_back(i);
+        }
+        if (misses.empty()) return S_OK;
+
+        IAudioClient* audioClient = nullptr;
+        HRESULT hr = device->Activate(__uuidof(IAudioClient), CLSCTX_ALL, nullptr, (void**)&audioClient);
+        if (FAILED(hr) || !audioClient) {
+            for (size_t i : misses) results[i] = FAILED(hr) ? hr : E_FAIL;
+            return FAILED(hr) ? hr : E_FAIL;
+        }
+
+        for (size_t i : misses) {
+            WAVEFORMATEX* match = nullptr;
+            results[i] = audioClient->IsFormatSupported(AUDCLNT_SHAREMODE_SHARED, formats[i], &match);
+            if (results[i] != S_FALSE && match) {
+                CoTaskMemFree(match);
+                match = nullptr;
+            }
+            closest[i] = match;
+        }
+        audioClient->Release();
+
+        if (cached) {
+            std::lock_guard<std::mutex> guard(snapshot->probesLock);
+            std::vector<FormatProbe>& list = snapshot->probes[id];
+            for (size_t i : misses) {
+                // Transient errors are not cached
+                if (results[i] != S_OK && results[i] != S_FALSE && results[i] != AUDCLNT_E_UNSUPPORTED_FORMAT) continue;
+                if (list.size() >= FORMAT_PROBE_CACHE_LIMIT) list.clear();
+                list.push_back({ toBytes(formats[i]), results[i], toBytes(closest[i]) });
+            }
+        }
+        return S_OK;
+    }
+
+    ULONG STDMETHODCALLTYPE AddRef() override {
+        return 1; // Never released, lives for the whole process
+    }
+
+    ULONG STDMETHODCALLTYPE Release() override {
+        return 1;
+    }
+
+    HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** ppv) override {
+        if (riid == IID_IUnknown || riid == __uuidof(IMMNotificationClient)) {
+            *ppv = this;
+            return S_OK;
+        }
+        *ppv = nullptr;
+        return E_NOINTERFACE;
+    }
+
+    HRESULT STDMETHODCALLTYPE OnDeviceStateChanged(LPCWSTR pwstrDeviceId, DWORD dwNewState) override {
+        invalidate(pwstrDeviceId);
+        return S_OK;
+    }
+
+    HRESULT STDMETHODCALLTYPE OnDeviceAdded(LPCWSTR pwstrDeviceId) override {
+        invalidate(pwstrDeviceId);
+        return S_OK;
+    }
+
+    HRESULT STDMETHODCALLTYPE OnDeviceRemoved(LPCWSTR pwstrDeviceId) override {
+        invalidate(pwstrDeviceId);
+        return S_OK;
+    }
+
+    HRESULT STDMETHODCALLTYPE OnDefaultDeviceChanged(EDataFlow flow, ERole role, LPCWSTR pwstrDefaultDeviceId) override {
+        if (role != eConsole || (flow != eRender && flow != eCapture)) return S_OK;
+        std::lock_guard<std::mutex> guard(pendingLock);
+        defaultStale[flow] = true;
+        generation.fetch_add(1, std::memory_order_release);
+        return S_OK;
+    }
+
+    HRESULT STDMETHODCALLTYPE OnPropertyValueChanged(LPCWSTR pwstrDeviceId, const PROPERTYKEY key) override {
+        // Only the properties an AudioPort is built from
+        if (key == PKEY_AudioEngine_DeviceFormat || key == PKEY_Device_FriendlyName
+                || key == PKEY_Device_DeviceDesc || key == PKEY_Device_Manufacturer) {
+            invalidate(pwstrDeviceId);
+        }
+        return S_OK;
+    }
+
+private:
+    void invalidate(LPCWSTR pwstrDeviceId) {
+        if (!pwstrDeviceId) return;
+        {
+            std::lock_guard<std::mutex> guard(probesLock);
+            probes.erase(pwstrDeviceId);
+        }
+        std::lock_guard<std::mutex> guard(pendingLock);
+        if (std::find(pendingIds.begin(), pendingIds.end(), pwstrDeviceId) == pendingIds.end()) {
+            pendingIds.emplace_back(pwstrDeviceId);
+        }
+        generation.fetch_add(1, std::memory_order_release);
+    }
+
+    static inline size_t formatSize(const WAVEFORMATEX* format) {
+        return format->wFormatTag == WAVE_FORMAT_EXTENSIBLE ? sizeof(WAVEFORMATEXTENSIBLE) : sizeof(WAVEFORMATEX);
+    }
+
+    static std::vector<uint8_t> toBytes(const WAVEFORMATEX* format) {
+        if (!format) return {};
+        const uint8_t* bytes = (const uint8_t*)format;
+        return std::vector<uint8_t>(bytes, bytes + formatSize(format));
+    }
+
+    static WAVEFORMATEX* fromBytes(const std::vector<uint8_t>& bytes) {
+        WAVEFORMATEX* format = (WAVEFORMATEX*)CoTaskMemAlloc(bytes.size());
+        if (format) memcpy(format, bytes.data(), bytes.size());
+        return format;
+    }
+
+    static inline bool matches(const std::vector<uint8_t>& bytes, const WAVEFORMATEX* format) {
+        return bytes.size() == formatSize(format) && memcmp(bytes.data(), format, bytes.size()) == 0;
+    }
+
+    static jobject toGlobalPort(JNIEnv* env, Logger* logger, IMMDevice* device) {
+        jobject local = IMMDevice_to_AudioPort(env, device);
+        if (!local) {
+            // A single broken endpoint should not hide the others
+            if (env->ExceptionCheck()) env->ExceptionClear();
+            logger->debug(env, "Skipping endpoint that could not be converted to AudioPort.");
+            return nullptr;
+        }
+        jobject global = env->NewGlobalRef(local);
+        env->DeleteLocalRef(local);
+        return global;
+    }
+
+    void clear(JNIEnv* env) {
+        for (auto& list : ports) {
+            for (Entry& entry : list) env->DeleteGlobalRef(entry.port);
+            list.clear();
+        }
+    }
+
+    void fill(JNIEnv* env, Logger* logger) {
+        clear(env);
+        for (EDataFlow flow : { eRender, eCapture }) {
+            IMMDeviceCollection* devices = getDevicesList(enumerator, flow);
+            if (!devices) continue;
+
+            UINT count = 0;
+            devices->GetCount(&count);
+            for (UINT i = 0; i < count; i++) {
+                IMMDevice* device = nullptr;
+                if (FAILED(devices->Item(i, &device)) || !device) continue;
+
+                LPWSTR id = nullptr;
+                if (SUCCEEDED(device->GetId(&id)) && id) {
+                    jobject port = toGlobalPort(env, logger, device);
+                    if (port) ports[flow].push_back({ std::wstring(id), port });
+                    CoTaskMemFree(id);
+                }
+                device->Release();
+            }
+            devices->Release();
+        }
+        logger->debug(env, "Port snapshot filled. Render: %u, capture: %u.",
+            (unsigned)ports[eRender].size(), (unsigned)ports[eCapture].size());
+    }
+
+    void update(JNIEnv* env, Logger* logger, const std::wstring& id) {
+        for (auto& list : ports) {
+            for (auto it = list.begin(); it != list.end(); ++it) {
+                if (it->id != id) continue;
+                env->DeleteGlobalRef(it->port);
+                list.erase(it);
+                break;
+            }
+        }
+
+        IMMDevice* device = nullptr;
+        if (FAILED(enumerator->GetDevice(id.c_str(), &device)) || !device) {
+            logger->trace(env, "Endpoint removed from snapshot: %s", utf16_to_utf8(id.c_str()).c_str());
+            return;
+        }
+
+        EDataFlow flow = eRender;
+        IMMEndpoint* endpoint = nullptr;
+        if (SUCCEEDED(device->QueryInterface(IID_IMMEndpoint, (void**)&endpoint)) && endpoint) {
+            endpoint->GetDataFlow(&flow);
+            endpoint->Release();
+        }
+
+        jobject port = (flow == eRender || flow == eCapture) ? toGlobalPort(env, logger, device) : nullptr;
+        if (port) {
+            ports[flow].push_back({ id, port });
+            logger->trace(env, "Endpoint updated in snapshot: %s", utf16_to_utf8(id.c_str()).c_str());
+        }
+        device->Release();
+    }
+
+    // Must be called with portsLock held
+    void refresh(JNIEnv* env, Logger* logger) {
+        std::vector<std::wstring> changed;
+        {
+            std::lock_guard<std::mutex> guard(pendingLock);
+            changed.swap(pendingIds);
+        }
+
+        if (!filled || !registered) {
+            fill(env, logger);
+            filled = true;
+            return;
+        }
+
+        for (const std::wstring& id : changed) {
+            update(env, logger, id);
+        }
+    }
+};
+
+#endif // _WIN32
@@ -22,6 +22,7 @@
 #include <audioclient.h>
 #include <functiondiscoverykeys.h>
 #include <Functiondiscoverykeys_devpkey.h>
+#include <vector>
 
 #include "logger.hpp"
 #include "logger_manager.hpp"
@@ -32,6 +33,11 @@
 
 #include "wasapi_utils.hpp"
 #include "wasapi_bridge.hpp"
+#include "wasapi_port_snapshot.hpp"
+
+#define FORMAT_SUPPORT_UNSUPPORTED 0
+#define FORMAT_SUPPORT_SUPPORTED 1
+#define FORMAT_SUPPORT_CLOSEST 2
 
 EXTERN_C const IID IID_IUnknown = {0x00000000, 0x0000, 0x0000, {0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x46}};
 
@@ -39,13 +45,14 @@ namespace org_theko_sound_backend_wasapi {
 
 typedef struct {
     IMMDeviceEnumerator* deviceEnumerator;
+    PortSnapshot* ports; // Shared by all contexts
 } BackendContext;
 
 extern "C" {
     JNIEXPORT jlong JNICALL 
     Java_org_theko_sound_backends_wasapi_WASAPISharedBackend_nInit
     (JNIEnv* env, jobject obj) {
-        Logger* logger = LoggerManager::getManager()->getLogger(env, "NATIVE: WASAPISharedBackend.nInit");
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPISharedBackend.nInit");
 
         HRESULT hr = CoInitializeEx(NULL, COINIT_MULTITHREADED);
         logger->trace(env, "CoInitializeEx result: %s", fmtHR(hr));
@@ -55,7 +62,7 @@ extern "C" {
             return 0;
         }
 
-        auto* ctx = new BackendContext{ nullptr };
+        auto* ctx = new BackendContext{ nullptr, nullptr };
         ctx->deviceEnumerator = nullptr;
 
         hr = CoCreateInstance(
@@ -70,6 +77,15 @@ extern "C" {
             return 0;
         }
 
+        ctx->ports = PortSnapshot::get(env);
+        if (!ctx->ports) {
+            ctx->deviceEnumerator->Release();
+            delete ctx;
+            env->ThrowNew(ThekoSound_AudioBackendException::getClazz(env), "Failed to create port snapshot.");
+            CoUninitialize();
+            return 0;
+        }
+
         logger->debug(env, "Initialized WASAPI backend. ContextPtr: %s", FORMAT_PTR(ctx));
 
         return (jlong)ctx;
@@ -78,7 +94,7 @@ extern "C" {
     JNIEXPORT void JNICALL 
     Java_org_theko_sound_backends_wasapi_WASAPISharedBackend_nShutdown
     (JNIEnv* env, jobject obj, jlong ptr) {
-        Logger* logger = LoggerManager::getManager()->getLogger(env, "NATIVE: WASAPISharedBackend.nShutdown");
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPISharedBackend.nShutdown");
 
         auto* ctx = (BackendContext*)ptr;
         if (!ctx) {
@@ -93,6 +109,7 @@ extern "C" {
             deviceEnumerator->Release();
             deviceEnumerator = nullptr;
         }
+        delete ctx;
         CoUninitialize();
 
         logger->debug(env, "Shutdown WASAPI backend.");
@@ -101,7 +118,7 @@ extern "C" {
     JNIEXPORT jobjectArray JNICALL 
     Java_org_theko_sound_backends_wasapi_WASAPISharedBackend_nGetAllPorts
     (JNIEnv* env, jobject obj, jlong ptr) {
-        Logger* logger = LoggerManager::getManager()->getLogger(env, "NATIVE: WASAPISharedBackend.nGetAllPorts");
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPISharedBackend.nGetAllPorts");
 
         auto* ctx = (BackendContext*)ptr;
         if (!ctx) {
@@ -109,60 +126,13 @@ extern "C" {
             env->ThrowNew(ThekoSound_AudioBackendException::getClazz(env), "WASAPI backend not initialized.");
             return nullptr;
         }
-        IMMDeviceEnumerator* deviceEnumerator = ctx->deviceEnumerator;
-
-        if (!deviceEnumerator) {
-            logger->warn(env, "No device enumerator found in context.");
-            return nullptr;
-        }
-
-        IMMDeviceCollection* renderDevices = getDevicesList(deviceEnumerator, eRender);
-        if (!renderDevices) return nullptr;
-
-        IMMDeviceCollection* captureDevices = getDevicesList(deviceEnumerator, eCapture);
-        if (!captureDevices) return nullptr;
-
-        UINT renderCount = 0, captureCount = 0;
-        renderDevices->GetCount(&renderCount);
-        captureDevices->GetCount(&captureCount);
-        UINT totalCount = renderCount + captureCount;
-
-        logger->trace(env, "Found %d render ports and %d capture ports. Total %d ports.", renderCount, captureCount, totalCount);
-
-        jobjectArray result = env->NewObjectArray(totalCount, ThekoSound_AudioPort::getClazz(env), nullptr);
-        if (!result) {
-            logger->warn(env, "Failed to create AudioPort array.");
-            return nullptr;
-        }
-
-        UINT index = 0;
-        for (UINT i = 0; i < renderCount; i++) {
-            IMMDevice* pDevice = nullptr;
-            renderDevices->Item(i, &pDevice);
-            jobject audioPortObj = IMMDevice_to_AudioPort(env, pDevice);
-            env->SetObjectArrayElement(result, index++, audioPortObj);
-            logger->trace(env, "Render port #%d: %ls", i, pDevice);
-            pDevice->Release();
-        }
-        for (UINT i = 0; i < captureCount; i++) {
-            IMMDevice* pDevice = nullptr;
-            captureDevices->Item(i, &pDevice);
-            jobject audioPortObj = IMMDevice_to_AudioPort(env, pDevice);
-            env->SetObjectArrayElement(result, index++, audioPortObj);
-            logger->trace(env, "Capture port #%d: %ls", i, pDevice);
-            pDevice->Release();
-        }
-
-        renderDevices->Release();
-        captureDevices->Release();
-
-        return result;
+        return ctx->ports->getAllPorts(env);
     }
 
     JNIEXPORT jobject JNICALL 
     Java_org_theko_sound_backends_wasapi_WASAPISharedBackend_nGetDefaultPort
     (JNIEnv* env, jobject obj, jlong ptr, jobject flowObj) {
-        Logger* logger = LoggerManager::getManager()->getLogger(env, "NATIVE: WASAPISharedBackend.nGetDefaultPort");
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPISharedBackend.nGetDefaultPort");
         
         if (!flowObj) return nullptr;
 
@@ -172,13 +142,6 @@ extern "C" {
             env->ThrowNew(ThekoSound_AudioBackendException::getClazz(env), "WASAPI backend not initialized.");
             return nullptr;
         }
-        IMMDeviceEnumerator* deviceEnumerator = ctx->deviceEnumerator;
-
-        if (!deviceEnumerator) {
-            logger->warn(env, "No device enumerator found in context.");
-            return nullptr;
-        }
-
         EDataFlow flow = eRender;
         if (env->IsSameObject(flowObj, ThekoSound_AudioFlow::getField__OUT(env))) {
             flow = eRender;
@@ -189,43 +152,21 @@ extern "C" {
         }
         logger->trace(env, "Flow: %s", flow == eRender ? "Render" : "Capture");
 
-        IMMDevice* pDevice = nullptr;
-        HRESULT hr = deviceEnumerator->GetDefaultAudioEndpoint(flow, eConsole, &pDevice);
-        if (FAILED(hr)) {
-            logger->warn(env, "Failed to get default audio endpoint for flow %s (%s).", flow == eRender ? "Render" : "Capture", fmtHR(hr));
-            return nullptr;
-        }
-
-        if (!pDevice) {
-            logger->info(env, "No default audio endpoint.");
-            return nullptr;
-        }
-
-        logger->trace(env, "Default audio endpoint pointer: %s", FORMAT_PTR(pDevice));
-
-        wchar_t* idName = nullptr;
-        hr = pDevice->GetId(&idName);
-        if (FAILED(hr)) {
-            logger->debug(env, "Failed to get default audio endpoint ID for flow %s. %s", flow == eRender ? "Render" : "Capture", fmtHR(hr));
-        } else {
-            const char* utf8_idName = utf16_to_utf8(idName).c_str();
-            logger->trace(env, "Default audio endpoint: %s. Flow: %s", utf8_idName, flow == eRender ? "Render" : "Capture");
-        }
-
-        if (idName) {
-            CoTaskMemFree(idName);
-        }
+        return ctx->ports->getDefaultPort(env, flow);
+    }
 
-        jobject jAudioPort = IMMDevice_to_AudioPort(env, pDevice);
-        pDevice->Release();
-        
-        return jAudioPort;
+    JNIEXPORT jlong JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPISharedBackend_nGetPortsGeneration
+    (JNIEnv* env, jclass clazz) {
+        // Lock-free, callable without an initialized backend
+        PortSnapshot* snapshot = PortSnapshot::instance().load(std::memory_order_acquire);
+        return snapshot && snapshot->isTracking() ? (jlong)snapshot->getGeneration() : -1;
     }
 
     JNIEXPORT jboolean JNICALL
     Java_org_theko_sound_backends_wasapi_WASAPISharedBackend_nIsFormatSupported
     (JNIEnv* env, jobject obj, jobject jport, jobject jformat, jobject atomicClosestFormat) {
-        Logger* logger = LoggerManager::getManager()->getLogger(env, "NATIVE: WASAPISharedBackend.nIsFormatSupported");
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPISharedBackend.nIsFormatSupported");
 
         if (!jport || !jformat) {
             logger->info(env, "AudioPort or AudioFormat is null.");
@@ -246,31 +187,25 @@ extern "C" {
             return JNI_FALSE;
         }
 
-        logger->trace(env, "WAVEFORMATEX: %s. Pointer: %s", (format ? WAVEFORMATEX_toText(format) : "NULL"), FORMAT_PTR(format));
+        if (logger->isTraceEnabled()) logger->trace(env, "WAVEFORMATEX: %s. Pointer: %s", (format ? WAVEFORMATEX_toText(format) : "NULL"), FORMAT_PTR(format));
 
-        IAudioClient* audioClient = nullptr;
-        HRESULT hr = device->Activate(__uuidof(IAudioClient), CLSCTX_ALL, NULL, (void**)&audioClient);
+        HRESULT hr = S_OK;
+        WAVEFORMATEX* closest = nullptr;
+        HRESULT hrProbe = PortSnapshot::probeFormats(device, &format, 1, &hr, &closest);
         device->Release();
-        if (FAILED(hr) || audioClient == nullptr) {
-            CoTaskMemFree(format);
-            logger->warn(env, "Failed to get or activate IAudioClient (%s).", fmtHR(hr));
+        CoTaskMemFree(format);
+        if (FAILED(hrProbe)) {
+            logger->warn(env, "Failed to get or activate IAudioClient (%s).", fmtHR(hrProbe));
             return JNI_FALSE;
         }
 
-        logger->trace(env, "IAudioClient pointer: %s", FORMAT_PTR(audioClient));
-
-        WAVEFORMATEX* closest = nullptr;
-        hr = audioClient->IsFormatSupported(AUDCLNT_SHAREMODE_SHARED, format, &closest);
-        audioClient->Release();
-        CoTaskMemFree(format);
-
         if (hr == S_OK) {
             logger->trace(env, "Format is supported.");
             return JNI_TRUE;
         } else if (hr == S_FALSE) {
             logger->trace(env, "Format is not supported.");
             if (closest) {
-                logger->trace(env, "Closest format: %s. Pointer: %s", (closest ? WAVEFORMATEX_toText(closest) : "NULL"), FORMAT_PTR(closest));
+                if (logger->isTraceEnabled()) logger->trace(env, "Closest format: %s. Pointer: %s", (closest ? WAVEFORMATEX_toText(closest) : "NULL"), FORMAT_PTR(closest));
                 if (atomicClosestFormat) {
                     logger->trace(env, "AtomicClosestFormat pointer: %s", FORMAT_PTR(atomicClosestFormat));
                     jobject jAudioFormat = WAVEFORMATEX_to_AudioFormat(env, closest);
@@ -285,5 +220,127 @@ extern "C" {
             return JNI_FALSE;
         }
     }
+
+    JNIEXPORT jintArray JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPISharedBackend_nGetFormatSupport
+    (JNIEnv* env, jobject obj, jobject jport, jobjectArray jformats, jobjectArray jclosestFormats) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPISharedBackend.nGetFormatSupport");
+
+        if (!jport || !jformats || !jclosestFormats) {
+            logger->info(env, "AudioPort or format arrays are null.");
+            return nullptr;
+        }
+
+        jsize count = env->GetArrayLength(jformats);
+        if (env->GetArrayLength(jclosestFormats) < count) {
+            logger->warn(env, "Closest formats array is too short.");
+            return nullptr;
+        }
+
+        IMMDevice* device = AudioPort_to_IMMDevice(env, jport);
+        if (!device) {
+            logger->warn(env, "Failed to get IMMDevice.");
+            return nullptr;
+        }
+
+        std::vector<WAVEFORMATEX*> formats(count, nullptr);
+        std::vector<HRESULT> results(count, E_FAIL);
+        std::vector<WAVEFORMATEX*> closest(count, nullptr);
+        for (jsize i = 0; i < count; i++) {
+            jobject jformat = env->GetObjectArrayElement(jformats, i);
+            if (jformat) {
+                formats[i] = AudioFormat_to_WAVEFORMATEX(env, jformat);
+                env->DeleteLocalRef(jformat);
+            }
+            // Unconvertible formats are reported as unsupported, not thrown
+            if (env->ExceptionCheck()) env->ExceptionClear();
+        }
+
+        HRESULT hr = PortSnapshot::probeFormats(device, formats.data(), (size_t)count, results.data(), closest.data());
+        device->Release();
+        if (FAILED(hr)) {
+            logger->warn(env, "Failed to get or activate IAudioClient (%s).", fmtHR(hr));
+        }
+
+        std::vector<jint> codes(count, FORMAT_SUPPORT_UNSUPPORTED);
+        jsize supported = 0;
+        for (jsize i = 0; i < count; i++) {
+            if (results[i] == S_OK) {
+                codes[i] = FORMAT_SUPPORT_SUPPORTED;
+                supported++;
+            } else if (results[i] == S_FALSE && closest[i]) {
+                jobject jAudioFormat = WAVEFORMATEX_to_AudioFormat(env, closest[i]);
+                if (jAudioFormat) {
+                    env->SetObjectArrayElement(jclosestFormats, i, jAudioFormat);
+                    env->DeleteLocalRef(jAudioFormat);
+                    codes[i] = FORMAT_SUPPORT_CLOSEST;
+                } else if (env->ExceptionCheck()) {
+                    env->ExceptionClear();
+                }
+            }
+            if (formats[i]) CoTaskMemFree(formats[i]);
+            if (closest[i]) CoTaskMemFree(closest[i]);
+        }
+        logger->trace(env, "Probed %d formats, %d supported.", count, supported);
+
+        jintArray result = env->NewIntArray(count);
+        if (!result) return nullptr;
+        env->SetIntArrayRegion(result, 0, count, codes.data());
+        return result;
+    }
+
+    JNIEXPORT jintArray JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPISharedBackend_nGetEnginePeriods
+    (JNIEnv* env, jobject obj, jobject jport, jobject jformat) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPISharedBackend.nGetEnginePeriods");
+
+        if (!jport || !jformat) {
+            logger->info(env, "AudioPort or AudioFormat is null.");
+            return nullptr;
+        }
+
+        IMMDevice* device = AudioPort_to_IMMDevice(env, jport);
+        if (!device) {
+            logger->warn(env, "Failed to get IMMDevice.");
+            return nullptr;
+        }
+
+        WAVEFORMATEX* format = AudioFormat_to_WAVEFORMATEX(env, jformat);
+        if (!format) {
+            device->Release();
+            logger->warn(env, "Failed to get WAVEFORMATEX.");
+            return nullptr;
+        }
+
+        IAudioClient* audioClient = nullptr;
+        HRESULT hr = device->Activate(__uuidof(IAudioClient), CLSCTX_ALL, NULL, (void**)&audioClient);
+        device->Release();
+        if (FAILED(hr) || audioClient == nullptr) {
+            CoTaskMemFree(format);
+            logger->warn(env, "Failed to get or activate IAudioClient (%s).", fmtHR(hr));
+            return nullptr;
+        }
+
+        EnginePeriods periods = {};
+        hr = getEnginePeriods(audioClient, format, &periods);
+        audioClient->Release();
+        CoTaskMemFree(format);
+
+        if (FAILED(hr)) {
+            logger->debug(env, "Engine periods are not available (%s).", fmtHR(hr));
+            return nullptr;
+        }
+        logger->trace(env, "Engine periods (frames): default %u, fundamental %u, min %u, max %u.",
+            periods.defaultFrames, periods.fundamentalFrames, periods.minFrames, periods.maxFrames);
+
+        jint values[4] = {
+            (jint)periods.defaultFrames, (jint)periods.fundamentalFrames,
+            (jint)periods.minFrames, (jint)periods.maxFrames
+        };
+        jintArray result = env->NewIntArray(4);
+        if (!result) return nullptr;
+        env->SetIntArrayRegion(result, 0, 4, values);
+        return result;
+    }
 }
 }
\ No newline at end of file
@@ -0,0 +1,779 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <jni.h>
+
+#include <windows.h>
+#include <initguid.h>
+#include <mmdeviceapi.h>
+#include <audioclient.h>
+#include <avrt.h>
+#include <functiondiscoverykeys.h>
+#include <Functiondiscoverykeys_devpkey.h>
+#include <algorithm>
+#include <atomic>
+
+#include "logger.hpp"
+#include "logger_manager.hpp"
+#include "helper_utilities.hpp"
+#include "spsc_ring_buffer.hpp"
+#include "stream_telemetry.hpp"
+
+#include "org_theko_sound_backends_wasapi_WASAPISharedInput.h"
+#include "cache/Java_Concurrent_AtomicReference.hpp"
+#include "cache/ThekoSound_AudioBackendException.hpp"
+#include "cache/ThekoSound_DeviceInvalidatedException.hpp"
+
+#include "wasapi_utils.hpp"
+#include "wasapi_bridge.hpp"
+
+#define EVENT_AUDIO_BUFFER_READY 0
+#define EVENT_STOP_REQUEST 1
+
+#define CAPTURE_THREAD_NAME "WASAPISharedInput-Capture"
+#define CAPTURE_THREAD_WAIT_TIMEOUT 2000 // ms
+#define ENDPOINT_BUFFER_PERIODS 2
+
+namespace theko::sound::backend::wasapi::input {
+
+/*
+ * The capture thread is the producer of the ring buffer, Java reads are its consumer.
+ */
+class InputContext {
+public:
+    IMMDevice* inputDevice;
+    IAudioClient* audioClient;
+    IAudioCaptureClient* captureClient;
+    IAudioClock* audioClock;
+    HANDLE events[2];
+    HANDLE dataEvent;           // Auto-reset, raised after every captured packet
+    UINT32 bufferFrameCount;
+    UINT32 periodFrames;        // Engine period the stream was initialized with
+    bool lowLatency;            // Initialized through IAudioClient3 with the minimum period
+    UINT32 bytesPerFrame;
+    WAVEFORMATEX* format;
+
+    SpscRingBuffer ring;
+    std::atomic<bool> deviceInvalidated;
+    std::atomic<bool> captureFailed;        // The capture thread stopped on an error
+    std::atomic<uint64_t> discontinuities;  // Packets flagged with AUDCLNT_BUFFERFLAGS_DATA_DISCONTINUITY
+    std::atomic<uint64_t> droppedFrames;    // Captured while the ring was full
+    StreamTelemetry telemetry;  // Written by the capture thread, read by Java through nGetTelemetryBuffer
+
+    JavaVM* jvm;
+    HANDLE captureThread;
+    std::atomic<bool> stopRequested;
+
+    InputContext() {
+        inputDevice = nullptr;
+        audioClient = nullptr;
+        captureClient = nullptr;
+        audioClock = nullptr;
+        events[0] = nullptr;
+        events[1] = nullptr;
+        dataEvent = nullptr;
+        bufferFrameCount = 0;
+        periodFrames = 0;
+        lowLatency = false;
+        bytesPerFrame = 0;
+        format = nullptr;
+        jvm = nullptr;
+        captureThread = nullptr;
+        stopRequested = false;
+        deviceInvalidated = false;
+        captureFailed = false;
+        discontinuities = 0;
+        droppedFrames = 0;
+    }
+
+    InputContext(const InputContext&) = delete;
+    InputContext& operator=(const InputContext&) = delete;
+
+    ~InputContext() {
+        if (audioClient) {
+            audioClient->Stop();
+        }
+
+        if (captureClient) captureClient->Release();
+        if (audioClock) audioClock->Release();
+        if (audioClient) audioClient->Release();
+        if (inputDevice) inputDevice->Release();
+
+        if (captureThread) CloseHandle(captureThread);
+        if (events[0]) CloseHandle(events[0]);
+        if (events[1]) CloseHandle(events[1]);
+        if (dataEvent) CloseHandle(dataEvent);
+
+        if (format) CoTaskMemFree(format);
+    }
+};
+
+extern "C" {
+    static inline void cleanupAndThrowError(
+        JNIEnv* env,
+        Logger* logger,
+        InputContext* ctx,
+        HRESULT hr,
+        const char* msg
+        ) {
+        logger->error(env, "%s (%s).", msg, fmtHR(hr));
+
+        logger->trace(env, "Cleaning up input context...");
+        if (ctx) delete ctx;
+        logger->trace(env, "Input context cleaned up, throwing exception...");
+
+        env->ThrowNew(ThekoSound_AudioBackendException::getClazz(env), msg);
+    }
+
+    static inline bool isDeviceInvalidatedError(HRESULT hr) {
+        return hr == AUDCLNT_E_DEVICE_INVALIDATED || hr == AUDCLNT_E_SERVICE_NOT_RUNNING;
+    }
+
+    /*
+     * Moves every pending packet from the endpoint buffer into the ring buffer.
+     * Silent packets are written as zeros. Frames that do not fit into the ring are dropped and counted.
+     */
+    static HRESULT capturePackets(InputContext* context) {
+        const UINT32 bytesPerFrame = context->bytesPerFrame;
+
+        UINT32 packetFrames = 0;
+        HRESULT hr = context->captureClient->GetNextPacketSize(&packetFrames);
+        while (SUCCEEDED(hr) && packetFrames > 0) {
+            BYTE* data = nullptr;
+            UINT32 frames = 0;
+            DWORD flags = 0;
+            int64_t bufferStart = StreamTelemetry::now();
+            hr = context->captureClient->GetBuffer(&data, &frames, &flags, nullptr, nullptr);
+            if (FAILED(hr)) return hr;
+
+            if (flags & AUDCLNT_BUFFERFLAGS_DATA_DISCONTINUITY) {
+                context->discontinuities.fetch_add(1, std::memory_order_relaxed);
+                context->telemetry.onGlitch();
+            }
+
+            size_t writable = context->ring.availableToWrite() / bytesPerFrame;
+            UINT32 accepted = (UINT32)std::min<size_t>(frames, writable);
+            size_t bytes = (size_t)accepted * bytesPerFrame;
+
+            if (flags & AUDCLNT_BUFFERFLAGS_SILENT) {
+                context->telemetry.onSilentBuffer();
+                context->ring.writeWith(bytes, [](uint8_t* dst, size_t, size_t count) {
+                    memset(dst, 0, count);
+                });
+            } else {
+                context->ring.write(data, bytes);
+            }
+            if (accepted < frames) {
+                context->droppedFrames.fetch_add(frames - accepted, std::memory_order_relaxed);
+                context->telemetry.onGlitch();
+            }
+
+            hr = context->captureClient->ReleaseBuffer(frames);
+            if (FAILED(hr)) return hr;
+            context->telemetry.onBufferReleased(StreamTelemetry::now() - bufferStart);
+
+            hr = context->captureClient->GetNextPacketSize(&packetFrames);
+        }
+        return hr;
+    }
+
+    /*
+     * Capture thread. Waits for the buffer-ready event and moves the captured packets into the ring buffer.
+     * Registered in MMCSS as "Pro Audio".
+     */
+    static DWORD WINAPI captureThreadProc(LPVOID param) {
+        auto context = (InputContext*)param;
+
+        JNIEnv* env = nullptr;
+        JavaVMAttachArgs attachArgs;
+        attachArgs.version = JNI_VERSION_1_6;
+        attachArgs.name = (char*)CAPTURE_THREAD_NAME;
+        attachArgs.group = nullptr;
+        if (context->jvm->AttachCurrentThreadAsDaemon((void**)&env, &attachArgs) != JNI_OK) {
+            return 1;
+        }
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPISharedInput.captureThread");
+
+        HRESULT hrCom = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+
+        DWORD taskIndex = 0;
+        HANDLE mmcssHandle = AvSetMmThreadCharacteristicsW(L"Pro Audio", &taskIndex);
+        if (!mmcssHandle) {
+            logger->warn(env, "Failed to register capture thread in MMCSS (error %lu).", GetLastError());
+        } else {
+            AvSetMmThreadPriority(mmcssHandle, AVRT_PRIORITY_HIGH);
+            logger->debug(env, "Capture thread registered in MMCSS. Task index: %lu.", taskIndex);
+        }
+
+        uint64_t reportedDropped = 0;
+        while (!context->stopRequested.load(std::memory_order_acquire)) {
+            DWORD waitResult = WaitForMultipleObjects(2, context->events, FALSE, CAPTURE_THREAD_WAIT_TIMEOUT);
+
+            if (waitResult == WAIT_OBJECT_0 + EVENT_STOP_REQUEST) {
+                break;
+            } else if (waitResult == WAIT_TIMEOUT) {
+                context->telemetry.onWakeTimeout();
+                logger->warn(env, "No buffer event received in %d ms.", CAPTURE_THREAD_WAIT_TIMEOUT);
+                continue;
+            } else if (waitResult != WAIT_OBJECT_0 + EVENT_AUDIO_BUFFER_READY) {
+                logger->error(env, "WaitForMultipleObjects failed: %lu", GetLastError());
+                context->captureFailed.store(true, std::memory_order_release);
+                break;
+            }
+            int64_t wakeTime = StreamTelemetry::now();
+
+            // Frames waiting in the endpoint buffer at the wake-up, a failure shows up in capturePackets
+            UINT32 padding = 0;
+            context->audioClient->GetCurrentPadding(&padding);
+            context->telemetry.onWake(wakeTime, padding);
+
+            HRESULT hr = capturePackets(context);
+            SetEvent(context->dataEvent);
+            if (FAILED(hr)) {
+                if (isDeviceInvalidatedError(hr)) {
+                    context->deviceInvalidated.store(true, std::memory_order_release);
+                    context->telemetry.onDeviceInvalidated();
+                    logger->warn(env, "Capture thread stopped, device invalidated (%s).", fmtHR(hr));
+                } else {
+                    logger->error(env, "Failed to read WASAPI input buffer (%s).", fmtHR(hr));
+                    context->captureFailed.store(true, std::memory_order_release);
+                }
+                break;
+            }
+
+            uint64_t dropped = context->droppedFrames.load(std::memory_order_relaxed);
+            if (dropped != reportedDropped && logger->isDebugEnabled()) {
+                logger->debug(env, "Capture ring overflow, %llu frames dropped in total.", (unsigned long long)dropped);
+            }
+            reportedDropped = dropped;
+        }
+
+        SetEvent(context->dataEvent); // Wake up a waiting reader
+
+        if (mmcssHandle) AvRevertMmThreadCharacteristics(mmcssHandle);
+        if (SUCCEEDED(hrCom)) CoUninitialize();
+
+        logger->trace(env, "Capture thread finished.");
+        context->jvm->DetachCurrentThread();
+        return 0;
+    }
+
+    static bool startCaptureThread(JNIEnv* env, Logger* logger, InputContext* context) {
+        if (env->GetJavaVM(&context->jvm) != JNI_OK) {
+            logger->error(env, "Failed to get JavaVM.");
+            return false;
+        }
+
+        context->telemetry.configure(context->bufferFrameCount, context->periodFrames, context->format->nSamplesPerSec);
+        context->stopRequested.store(false, std::memory_order_release);
+        context->captureThread = CreateThread(NULL, 0, captureThreadProc, context, 0, NULL);
+        if (!context->captureThread) {
+            logger->error(env, "Failed to create capture thread (error %lu).", GetLastError());
+            return false;
+        }
+
+        logger->debug(env, "Capture thread started. Buffer: %u frames.", context->bufferFrameCount);
+        return true;
+    }
+
+    static void stopCaptureThread(JNIEnv* env, Logger* logger, InputContext* context) {
+        if (!context->captureThread) return;
+
+        context->stopRequested.store(true, std::memory_order_release);
+        SetEvent(context->events[EVENT_STOP_REQUEST]);
+
+        DWORD waitResult = WaitForSingleObject(context->captureThread, INFINITE);
+        if (waitResult != WAIT_OBJECT_0) {
+            logger->warn(env, "Failed to wait for capture thread: %lu", GetLastError());
+        }
+        CloseHandle(context->captureThread);
+        context->captureThread = nullptr;
+        logger->trace(env, "Capture thread stopped.");
+    }
+
+    JNIEXPORT jlong JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPISharedInput_nOpen
+    (JNIEnv* env, jobject obj, jobject jport, jobject jformat, jint bufferSize /* in bytes */, jobject jAtomicRefFormat, jboolean lowLatency) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPISharedInput.nOpen");
+
+        if (!jport || !jformat || !jAtomicRefFormat) return 0;
+
+        auto context = new InputContext();
+        logger->trace(env, "InputContext allocated. Pointer: %s", FORMAT_PTR(context));
+
+        context->inputDevice = AudioPort_to_IMMDevice(env, jport);
+        if (!context->inputDevice) {
+            cleanupAndThrowError(env, logger, context, E_FAIL, "Failed to get IMMDevice.");
+            return 0;
+        }
+
+        WAVEFORMATEX* format = AudioFormat_to_WAVEFORMATEX(env, jformat);
+        if (!format) {
+            cleanupAndThrowError(env, logger, context, E_FAIL, "Failed to get WAVEFORMATEX.");
+            return 0;
+        }
+        if (logger->isTraceEnabled()) logger->trace(env, "WAVEFORMATEX (Request): %s", WAVEFORMATEX_toText(format));
+
+        HRESULT hr = context->inputDevice->Activate(__uuidof(IAudioClient), CLSCTX_ALL, nullptr, (void**)&context->audioClient);
+        if (FAILED(hr) || !context->audioClient) {
+            CoTaskMemFree(format);
+            cleanupAndThrowError(env, logger, context, hr, "Failed to get IAudioClient.");
+            return 0;
+        }
+
+        WAVEFORMATEX* closestFormat = nullptr;
+        hr = context->audioClient->IsFormatSupported(AUDCLNT_SHAREMODE_SHARED, format, &closestFormat);
+        if (hr == S_FALSE && closestFormat) {
+            logger->debug(env, "Format is not supported, using closest match: %s", WAVEFORMATEX_toText(closestFormat));
+            CoTaskMemFree(format);
+            format = closestFormat;
+        } else if (hr != S_OK) {
+            if (closestFormat) CoTaskMemFree(closestFormat);
+            CoTaskMemFree(format);
+            cleanupAndThrowError(env, logger, context, FAILED(hr) ? hr : AUDCLNT_E_UNSUPPORTED_FORMAT, "Failed to check format support.");
+            return 0;
+        }
+        context->format = format;
+
+        int bufferSizeInFrames = bufferSize / format->nBlockAlign;
+        REFERENCE_TIME hnsBufferDuration = (REFERENCE_TIME)((double)bufferSizeInFrames / format->nSamplesPerSec * 1e7);
+
+        // The ring buffer holds the requested amount of audio; the endpoint buffer
+        // only has to cover the capture thread's wake-up jitter.
+        REFERENCE_TIME hnsDefaultPeriod = 0;
+        if (SUCCEEDED(context->audioClient->GetDevicePeriod(&hnsDefaultPeriod, nullptr)) && hnsDefaultPeriod > 0) {
+            hnsBufferDuration = std::min(hnsBufferDuration, ENDPOINT_BUFFER_PERIODS * hnsDefaultPeriod);
+        }
+        context->periodFrames = (UINT32)(hnsDefaultPeriod * format->nSamplesPerSec / 10000000);
+
+        hr = E_FAIL;
+        if (lowLatency) {
+            EnginePeriods periods = {};
+            IAudioClient3* audioClient3 = nullptr;
+            HRESULT hrPeriods = getEnginePeriods(context->audioClient, format, &periods);
+            if (SUCCEEDED(hrPeriods)) {
+                hrPeriods = context->audioClient->QueryInterface(__uuidof(IAudioClient3), (void**)&audioClient3);
+            }
+            if (SUCCEEDED(hrPeriods) && audioClient3) {
+                hr = audioClient3->InitializeSharedAudioStream(
+                    AUDCLNT_STREAMFLAGS_EVENTCALLBACK,
+                    periods.minFrames,
+                    format,
+                    nullptr
+                );
+                audioClient3->Release();
+                logger->trace(env, "IAudioClient3::InitializeSharedAudioStream called. Result: %s", fmtHR(hr));
+            } else {
+                hr = hrPeriods;
+            }
+
+            if (SUCCEEDED(hr)) {
+                context->periodFrames = periods.minFrames;
+                context->lowLatency = true;
+            } else {
+                logger->info(env, "Low-latency shared mode is not available (%s), falling back to the default period.", fmtHR(hr));
+                // A failed initialization leaves the client unusable, activate a fresh one
+                context->audioClient->Release();
+                context->audioClient = nullptr;
+                hr = context->inputDevice->Activate(__uuidof(IAudioClient), CLSCTX_ALL, nullptr, (void**)&context->audioClient);
+                if (FAILED(hr) || !context->audioClient) {
+                    cleanupAndThrowError(env, logger, context, hr, "Failed to get IAudioClient.");
+                    return 0;
+                }
+            }
+        }
+
+        if (!context->lowLatency) {
+            hr = context->audioClient->Initialize(
+                AUDCLNT_SHAREMODE_SHARED,
+                AUDCLNT_STREAMFLAGS_EVENTCALLBACK,
+                hnsBufferDuration,
+                0,
+                format,
+                nullptr
+            );
+            logger->trace(env, "IAudioClient::Initialize called. Result: %s", fmtHR(hr));
+        }
+        if (hr == AUDCLNT_E_DEVICE_IN_USE) {
+            cleanupAndThrowError(env, logger, context, hr, "Device is in use.");
+            return 0;
+        } else if (FAILED(hr)) {
+            cleanupAndThrowError(env, logger, context, hr, "Failed to initialize IAudioClient.");
+            return 0;
+        }
+
+        hr = context->audioClient->GetService(__uuidof(IAudioCaptureClient), (void**)&context->captureClient);
+        if (FAILED(hr) || !context->captureClient) {
+            cleanupAndThrowError(env, logger, context, hr, "Failed to get IAudioCaptureClient.");
+            return 0;
+        }
+
+        hr = context->audioClient->GetService(__uuidof(IAudioClock), (void**)&context->audioClock);
+        if (FAILED(hr) || !context->audioClock) {
+            cleanupAndThrowError(env, logger, context, hr, "Failed to get IAudioClock.");
+            return 0;
+        }
+
+        context->events[EVENT_AUDIO_BUFFER_READY] = CreateEvent(NULL, FALSE, FALSE, NULL);
+        context->events[EVENT_STOP_REQUEST] = CreateEvent(NULL, TRUE, FALSE, NULL);
+        context->dataEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
+        if (!context->events[EVENT_AUDIO_BUFFER_READY] || !context->events[EVENT_STOP_REQUEST] || !context->dataEvent) {
+            cleanupAndThrowError(env, logger, context, E_FAIL, "Failed to create capture events.");
+            return 0;
+        }
+        context->audioClient->SetEventHandle(context->events[EVENT_AUDIO_BUFFER_READY]);
+
+        context->audioClient->GetBufferSize(&context->bufferFrameCount);
+        context->bytesPerFrame = format->nBlockAlign;
+        logger->debug(env, "Actual buffer size: %u frames, period: %u frames%s", context->bufferFrameCount,
+            context->periodFrames, context->lowLatency ? " (low latency)" : "");
+
+        UINT32 ringFrames = std::max((UINT32)std::max(bufferSizeInFrames, 0), context->bufferFrameCount);
+        if (!context->ring.allocate((size_t)ringFrames * context->bytesPerFrame)) {
+            cleanupAndThrowError(env, logger, context, E_OUTOFMEMORY, "Failed to allocate ring buffer.");
+            return 0;
+        }
+        logger->debug(env, "Ring buffer size: %u frames", ringFrames);
+
+        jobject jAudioFormat = WAVEFORMATEX_to_AudioFormat(env, format);
+        if (!jAudioFormat) {
+            cleanupAndThrowError(env, logger, context, E_FAIL, "Failed to create audio format.");
+            return 0;
+        }
+        Java_Concurrent_AtomicReference::set(env, jAtomicRefFormat, jAudioFormat);
+        env->DeleteLocalRef(jAudioFormat);
+
+        logger->debug(env, "Opened WASAPI input. ContextPtr: %s", FORMAT_PTR(context));
+
+        return (jlong)context;
+    }
+
+    JNIEXPORT void JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPISharedInput_nClose
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPISharedInput.nClose");
+
+        auto context = (InputContext*)ptr;
+        if (!context) {
+            logger->debug(env, "WASAPI input already closed.");
+            return;
+        }
+
+        stopCaptureThread(env, logger, context);
+        delete context; // Stops the stream and releases its interfaces
+        logger->trace(env, "Closed WASAPI input.");
+    }
+
+    JNIEXPORT void JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPISharedInput_nStart
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPISharedInput.nStart");
+        auto context = (InputContext*)ptr;
+        if (!context) {
+            logger->info(env, "WASAPI input not opened.");
+            return;
+        }
+        if (context->captureThread) return;
+
+        ResetEvent(context->events[EVENT_STOP_REQUEST]);
+        context->deviceInvalidated.store(false, std::memory_order_release);
+        context->captureFailed.store(false, std::memory_order_release);
+
+        HRESULT hr = context->audioClient->Start();
+        if (FAILED(hr)) {
+            logger->error(env, "Failed to start WASAPI input (%s).", fmtHR(hr));
+            env->ThrowNew(ThekoSound_AudioBackendException::getClazz(env), "Failed to start WASAPI input.");
+            return;
+        }
+        logger->trace(env, "Started WASAPI input.");
+
+        if (!startCaptureThread(env, logger, context)) {
+            context->audioClient->Stop();
+            env->ThrowNew(ThekoSound_AudioBackendException::getClazz(env), "Failed to start capture thread.");
+        }
+    }
+
+    JNIEXPORT void JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPISharedInput_nStop
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPISharedInput.nStop");
+        auto context = (InputContext*)ptr;
+        if (!context) {
+            logger->info(env, "WASAPI input not opened.");
+            return;
+        }
+
+        stopCaptureThread(env, logger, context);
+
+        HRESULT hr = context->audioClient->Stop();
+        if (FAILED(hr)) {
+            logger->warn(env, "Failed to stop WASAPI input (%s).", fmtHR(hr));
+        } else {
+            logger->trace(env, "Stopped WASAPI capture client.");
+        }
+    }
+
+    JNIEXPORT void JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPISharedInput_nFlush
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPISharedInput.nFlush");
+        auto context = (InputContext*)ptr;
+        if (!context) {
+            logger->info(env, "WASAPI input not opened.");
+            return;
+        }
+
+        // Java reads are the consumer of the ring, so it can be discarded here
+        context->ring.discard();
+    }
+
+    JNIEXPORT void JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPISharedInput_nDrain
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPISharedInput.nDrain");
+        auto context = (InputContext*)ptr;
+        if (!context) {
+            logger->info(env, "WASAPI input not opened.");
+            return;
+        }
+
+        // Waits until the captured data has been read, polling on the manual-reset stop event
+        DWORD periodMs = std::max<DWORD>(1, (DWORD)(context->bufferFrameCount * 1000ull / context->format->nSamplesPerSec / 2));
+        while (context->captureThread && context->ring.availableToRead() >= context->bytesPerFrame) {
+            if (WaitForSingleObject(context->events[EVENT_STOP_REQUEST], periodMs) == WAIT_OBJECT_0) {
+                logger->debug(env, "Drain operation interrupted by stop event");
+                break;
+            }
+        }
+    }
+
+    static bool canRead(JNIEnv* env, Logger* logger, InputContext* context) {
+        if (!context) {
+            logger->info(env, "WASAPI input not opened.");
+            return false;
+        }
+
+        // Captured data stays readable until the ring is empty
+        if (context->deviceInvalidated.load(std::memory_order_relaxed)
+                && context->ring.availableToRead() < context->bytesPerFrame) {
+            logger->error(env, "Device invalidated, read rejected.");
+            env->ThrowNew(ThekoSound_DeviceInvalidatedException::getClazz(env), "Device invalidated.");
+            return false;
+        }
+        if (context->captureFailed.load(std::memory_order_relaxed)
+                && context->ring.availableToRead() < context->bytesPerFrame) {
+            logger->error(env, "Capture thread stopped on an error, read rejected.");
+            env->ThrowNew(ThekoSound_AudioBackendException::getClazz(env), "Capture thread stopped on an error.");
+            return false;
+        }
+        return true;
+    }
+
+    // Non-blocking: the number of bytes, in whole frames, that can be read from the ring
+    static inline size_t readableBytes(InputContext* context, jint length) {
+        size_t readable = std::min<size_t>(length, context->ring.availableToRead());
+        return readable - readable % context->bytesPerFrame;
+    }
+
+    JNIEXPORT jint JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPISharedInput_nRead
+    (JNIEnv* env, jobject obj, jlong ptr, jbyteArray buffer, jint offset, jint length) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPISharedInput.nRead");
+
+        auto context = (InputContext*)ptr;
+        if (!canRead(env, logger, context)) return -1;
+
+        if (offset < 0 || length < 0 || offset > env->GetArrayLength(buffer) - length) {
+            logger->error(env, "Invalid read range. Offset: %d, length: %d.", offset, length);
+            return -1;
+        }
+
+        // Copy straight from the ring into the Java array
+        size_t read = context->ring.readWith(readableBytes(context, length),
+            [env, buffer, offset](const uint8_t* src, size_t dstOffset, size_t count) {
+                env->SetByteArrayRegion(buffer, offset + (jsize)dstOffset, (jsize)count, (const jbyte*)src);
+            });
+        return (jint)read;
+    }
+
+    JNIEXPORT jint JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPISharedInput_nReadDirect
+    (JNIEnv* env, jobject obj, jlong ptr, jobject buffer, jint offset, jint length) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPISharedInput.nReadDirect");
+
+        auto context = (InputContext*)ptr;
+        if (!canRead(env, logger, context)) return -1;
+
+        uint8_t* dst = (uint8_t*)env->GetDirectBufferAddress(buffer);
+        jlong capacity = env->GetDirectBufferCapacity(buffer);
+        if (!dst || capacity < 0) {
+            logger->error(env, "Buffer is not a direct buffer.");
+            return -1;
+        }
+        if (offset < 0 || length < 0 || (jlong)offset + length > capacity) {
+            logger->error(env, "Invalid read range. Offset: %d, length: %d.", offset, length);
+            return -1;
+        }
+
+        return (jint)context->ring.read(dst + offset, readableBytes(context, length));
+    }
+
+    JNIEXPORT jboolean JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPISharedInput_nWaitForData
+    (JNIEnv* env, jobject obj, jlong ptr, jint timeoutMs) {
+        auto context = (InputContext*)ptr;
+        if (!context || !context->captureThread) return JNI_FALSE;
+        if (context->ring.availableToRead() >= context->bytesPerFrame) return JNI_TRUE;
+        // The stream ended, the next read reports it
+        if (context->captureFailed.load(std::memory_order_acquire)
+                || context->deviceInvalidated.load(std::memory_order_acquire)) return JNI_TRUE;
+
+        WaitForSingleObject(context->dataEvent, (DWORD)std::max(timeoutMs, 0));
+        return context->ring.availableToRead() >= context->bytesPerFrame ? JNI_TRUE : JNI_FALSE;
+    }
+
+    JNIEXPORT jint JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPISharedInput_nAvailable
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPISharedInput.nAvailable");
+        auto context = (InputContext*)ptr;
+        if (!context) {
+            logger->info(env, "WASAPI input not opened.");
+            return -1;
+        }
+
+        size_t available = context->ring.availableToRead();
+        available -= available % context->bytesPerFrame;
+        if (available > INT_MAX) return -1;
+        return (jint)available;
+    }
+
+    JNIEXPORT jint JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPISharedInput_nGetBufferSize
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPISharedInput.nGetBufferSize");
+        auto context = (InputContext*)ptr;
+        if (!context) {
+            logger->info(env, "WASAPI input not opened.");
+            return -1;
+        }
+
+        size_t capacity = context->ring.getCapacity();
+        if (capacity > INT_MAX) return -1;
+        return (jint)capacity;
+    }
+
+    JNIEXPORT jlong JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPISharedInput_nGetFramePosition
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPISharedInput.nGetFramePosition");
+        auto context = (InputContext*)ptr;
+        if (!context) {
+            logger->info(env, "WASAPI input not opened.");
+            return -1;
+        }
+
+        UINT64 frequency = 0, position = 0;
+        HRESULT hr = context->audioClock->GetFrequency(&frequency);
+        if (SUCCEEDED(hr)) hr = context->audioClock->GetPosition(&position, nullptr);
+        if (FAILED(hr) || frequency == 0) {
+            logger->error(env, "Failed to get WASAPI input position (%s).", fmtHR(hr));
+            return -1;
+        }
+
+        return (jlong)(position * context->format->nSamplesPerSec / frequency);
+    }
+
+    JNIEXPORT jlong JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPISharedInput_nGetMicrosecondLatency
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPISharedInput.nGetMicrosecondLatency");
+        auto context = (InputContext*)ptr;
+        if (!context) {
+            logger->info(env, "WASAPI input not opened.");
+            return -1;
+        }
+
+        REFERENCE_TIME latency = 0;
+        HRESULT hr = context->audioClient->GetStreamLatency(&latency);
+        if (FAILED(hr)) {
+            logger->warn(env, "Failed to get WASAPI input latency (%s).", fmtHR(hr));
+            return -1;
+        } else if (latency > 0) {
+            // latency in 100-ns (1e-7 sec), converted to microseconds (1e-6 sec)
+            return (jlong)(latency / 10);
+        }
+        return (jlong)(context->bufferFrameCount * 1000000ull / context->format->nSamplesPerSec);
+    }
+
+    JNIEXPORT jint JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPISharedInput_nGetPeriodFrames
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        auto context = (InputContext*)ptr;
+        if (!context) return -1;
+        return context->periodFrames > 0 ? (jint)context->periodFrames : -1;
+    }
+
+    JNIEXPORT jlong JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPISharedInput_nGetDiscontinuityCount
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        auto context = (InputContext*)ptr;
+        if (!context) return -1;
+        return (jlong)context->discontinuities.load(std::memory_order_relaxed);
+    }
+
+    JNIEXPORT jlong JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPISharedInput_nGetDroppedFrames
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        auto context = (InputContext*)ptr;
+        if (!context) return -1;
+        return (jlong)context->droppedFrames.load(std::memory_order_relaxed);
+    }
+
+    JNIEXPORT jobject JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPISharedInput_nGetTelemetryBuffer
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPISharedInput.nGetTelemetryBuffer");
+        auto context = (InputContext*)ptr;
+        if (!context) {
+            logger->info(env, "WASAPI input not opened.");
+            return nullptr;
+        }
+
+        // Valid until nClose, the Java side drops it there
+        return env->NewDirectByteBuffer(context->telemetry.data(), (jlong)StreamTelemetry::size());
+    }
+
+    JNIEXPORT jobject JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPISharedInput_nGetCurrentAudioPort
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPISharedInput.nGetCurrentAudioPort");
+        auto context = (InputContext*)ptr;
+        if (!context) {
+            logger->info(env, "WASAPI input not opened.");
+            return nullptr;
+        }
+
+        jobject jAudioPort = IMMDevice_to_AudioPort(env, context->inputDevice);
+        if (!jAudioPort) {
+            logger->error(env, "Failed to convert IMMDevice to AudioPort.");
+            env->ThrowNew(ThekoSound_AudioBackendException::getClazz(env), "Failed to convert IMMDevice to AudioPort.");
+            return nullptr;
+        }
+        return jAudioPort;
+    }
+}
+}
@@ -20,69 +20,146 @@
 #include <initguid.h>
 #include <mmdeviceapi.h>
 #include <audioclient.h>
+#include <avrt.h>
 #include <functiondiscoverykeys.h>
 #include <Functiondiscoverykeys_devpkey.h>
 #include <algorithm>
 #include <atomic>
 #include <codecvt>
-#include <queue>
 #include <string>
 #include <vector>
 
 #include "logger.hpp"
 #include "logger_manager.hpp"
 #include "helper_utilities.hpp"
+#include "spsc_ring_buffer.hpp"
+#include "mpsc_queue.hpp"
+#include "sample_conversion.hpp"
+#include "clock_snapshot.hpp"
+#include "stream_telemetry.hpp"
 
 #include "org_theko_sound_backends_wasapi_WASAPISharedOutput.h"
 #include "cache/Java_Concurrent_AtomicReference.hpp"
+#include "cache/ThekoSound_AudioRenderCallback.hpp"
 #include "cache/ThekoSound_DeviceInvalidatedException.hpp"
 #include "cache/ThekoSound_DeviceInactiveException.hpp"
 
 #include "wasapi_utils.hpp"
 #include "wasapi_bridge.hpp"
+#include "wasapi_endpoint_session.hpp"
 
 #define EVENT_AUDIO_BUFFER_READY 0
 #define EVENT_STOP_REQUEST 1
 
+#define RENDER_THREAD_NAME "WASAPISharedOutput-Render"
+#define RENDER_THREAD_WAIT_TIMEOUT 2000 // ms
+#define ENDPOINT_BUFFER_PERIODS 2
+#define MAX_PLANAR_CHANNELS 32
+
+#ifndef AUDCLNT_STREAMFLAGS_AUTOCONVERTPCM
+#define AUDCLNT_STREAMFLAGS_AUTOCONVERTPCM 0x80000000
+#endif
+#ifndef AUDCLNT_STREAMFLAGS_SRC_DEFAULT_QUALITY
+#define AUDCLNT_STREAMFLAGS_SRC_DEFAULT_QUALITY 0x08000000
+#endif
+
 namespace theko::sound::backend::wasapi::output {
 
-class OutputContext {
-private:
-    std::mutex logMutex;
+using theko::sound::conversion::SampleType;
+using theko::sound::conversion::DitherState;
+
+/*
+ * Device health word, published by the device change notifier and the render thread.
+ * Any set bit means the stream cannot continue and has to be reopened.
+ */
+enum DeviceHealth : uint32_t {
+    HEALTH_OK                 = 0,
+    HEALTH_DEVICE_LOST        = 1 << 0, // Removed, unplugged, disabled or not present
+    HEALTH_DEFAULT_CHANGED    = 1 << 1,
+    HEALTH_FORMAT_CHANGED     = 1 << 2,
+    HEALTH_CLIENT_INVALIDATED = 1 << 3  // AUDCLNT_E_DEVICE_INVALIDATED from the audio client
+};
 
+class OutputContext {
 public:
     IMMDevice* outputDevice;
     IAudioClient* audioClient;
     IAudioRenderClient* renderClient;
     IAudioClock* audioClock;
+    UINT64 clockFrequency;
+    REFERENCE_TIME streamLatency;
+    ClockSnapshot clock;        // Published every period, read by Java through nGetClockBuffer
+    StreamTelemetry telemetry;  // Written by the render thread, read by Java through nGetTelemetryBuffer
     HANDLE events[2];
     UINT32 bufferFrameCount;
+    UINT32 periodFrames;        // Engine period the stream was initialized with
+    bool lowLatency;            // Initialized through IAudioClient3 with the minimum period
+    bool engineConversion;      // The audio engine converts the format to its mix format
     UINT32 bytesPerFrame;
     WAVEFORMATEX* format;
     UINT32 pendingFrames;
     IMMDeviceEnumerator* deviceEnumerator;
     IMMNotificationClient* notificationClient;
-    std::queue<std::string> notifierLogs;
+    std::wstring deviceId;                  // Endpoint ID, to filter notifications
+    MpscQueue<std::string> notifierLogs;    // Pushed from COM notification threads
+    std::atomic<uint32_t> deviceHealth;     // DeviceHealth bits
+
+    // Push mode: Java writes into the ring, the render thread drains it
+    SpscRingBuffer ring;
+    std::atomic<bool> flushRequested;
+    std::atomic<size_t> flushPosition;      // Ring write position at the last flush
+    SampleType sampleType;      // Target of nWriteFloat
+    DitherState dither;
+
+    // Endpoint session mode: the ring is mixed by the session, there is no own audio client
+    EndpointSession* session;
+    SessionVoice voice;
+
+    // Pull mode
+    JavaVM* jvm;
+    jobject renderCallback;     // global ref, AudioRenderCallback
+    jbyteArray renderBuffer;    // global ref, bufferFrameCount * bytesPerFrame bytes
+    HANDLE renderThread;
+    std::atomic<bool> stopRequested;
 
     OutputContext() {
         outputDevice = nullptr;
         audioClient = nullptr;
         renderClient = nullptr;
         audioClock = nullptr;
+        clockFrequency = 0;
+        streamLatency = 0;
         events[0] = nullptr;
         events[1] = nullptr;
         bufferFrameCount = 0;
+        periodFrames = 0;
+        lowLatency = false;
+        engineConversion = false;
         bytesPerFrame = 0;
         format = nullptr;
         pendingFrames = 0;
         deviceEnumerator = nullptr;
         notificationClient = nullptr;
+        session = nullptr;
+        jvm = nullptr;
+        renderCallback = nullptr;
+        renderBuffer = nullptr;
+        renderThread = nullptr;
+        stopRequested = false;
+        flushRequested = false;
+        flushPosition = 0;
+        deviceHealth = HEALTH_OK;
+        sampleType = SampleType::UNSUPPORTED;
     }
 
     OutputContext(const OutputContext&) = delete;
     OutputContext& operator=(const OutputContext&) = delete;
 
     ~OutputContext() {
+        if (session) {
+            session->removeVoice(&voice);
+            releaseEndpointSession(session);
+        }
         if (audioClient) {
             audioClient->Stop();
         }
@@ -92,6 +169,7 @@ public:
         if (audioClient) audioClient->Release();
         if (outputDevice) outputDevice->Release();
 
+        if (renderThread) CloseHandle(renderThread);
         if (events[0]) CloseHandle(events[0]);
         if (events[1]) CloseHandle(events[1]);
 
@@ -100,22 +178,8 @@ public:
         if (notificationClient) notificationClient->Release();
     }
 
-    void pushLog(const std::string& message) {
-        std::lock_guard<std::mutex> lock(logMutex);
-        notifierLogs.push(message);
-    }
-
-    bool popLog(std::string& message) {
-        std::lock_guard<std::mutex> lock(logMutex);
-        if (notifierLogs.empty()) return false;
-        message = notifierLogs.front();
-        notifierLogs.pop();
-        return true;
-    }
-
-    bool isEmptyLogs() {
-        std::lock_guard<std::mutex> lock(logMutex);
-        return notifierLogs.empty();
+    inline bool isHealthy() const {
+        return deviceHealth.load(std::memory_order_relaxed) == HEALTH_OK && !(session && session->isInvalidated());
     }
 };
 
@@ -154,60 +218,60 @@ public:
     }
 
     HRESULT STDMETHODCALLTYPE OnDeviceStateChanged(LPCWSTR pwstrDeviceId, DWORD dwNewState) override {
-        std::string msg = "Device state changed: " + utf16_to_utf8(pwstrDeviceId)
-                        + " -> " + std::to_string(dwNewState);
-        context->notifierLogs.push(msg);
+        if (!isOwnDevice(pwstrDeviceId)) return S_OK;
+        context->notifierLogs.push("Device state changed: " + utf16_to_utf8(pwstrDeviceId)
+                                 + " -> " + std::to_string(dwNewState));
 
-        if (dwNewState == DEVICE_STATE_NOTPRESENT || dwNewState == DEVICE_STATE_UNPLUGGED) {
-            interruptPlayback();
+        if (dwNewState != DEVICE_STATE_ACTIVE) {
+            interruptPlayback(HEALTH_DEVICE_LOST);
         }
         return S_OK;
     }
 
     HRESULT STDMETHODCALLTYPE OnDefaultDeviceChanged(EDataFlow flow, ERole role, LPCWSTR pwstrDefaultDeviceId) override {
-        std::string msg = "Default device changed: " 
-                        + utf16_to_utf8(pwstrDefaultDeviceId)
-                        + ", flow: " + (flow == eRender ? "Render" : "Capture")
-                        + ", role: " + std::to_string(role);
-        context->notifierLogs.push(msg);
-        interruptPlayback();
+        if (flow != eRender) return S_OK;
+        context->notifierLogs.push("Default device changed: "
+                                 + utf16_to_utf8(pwstrDefaultDeviceId)
+                                 + ", flow: Render, role: " + std::to_string(role));
+        interruptPlayback(HEALTH_DEFAULT_CHANGED);
         return S_OK;
     }
 
     HRESULT STDMETHODCALLTYPE OnDeviceAdded(LPCWSTR pwstrDeviceId) override {
-        std::string msg = "Device added: " 
-                        + utf16_to_utf8(pwstrDeviceId);
-        context->notifierLogs.push(msg);
+        context->notifierLogs.push("Device added: " + utf16_to_utf8(pwstrDeviceId));
         return S_OK;
     }
 
     HRESULT STDMETHODCALLTYPE OnDeviceRemoved(LPCWSTR pwstrDeviceId) override {
-        std::string msg = "Device removed: " 
-                        + utf16_to_utf8(pwstrDeviceId);
-        context->notifierLogs.push(msg);
-        interruptPlayback();
+        if (!isOwnDevice(pwstrDeviceId)) return S_OK;
+        context->notifierLogs.push("Device removed: " + utf16_to_utf8(pwstrDeviceId));
+        interruptPlayback(HEALTH_DEVICE_LOST);
         return S_OK;
     }
 
     HRESULT STDMETHODCALLTYPE OnPropertyValueChanged(LPCWSTR pwstrDeviceId, const PROPERTYKEY key) override {
+        if (!isOwnDevice(pwstrDeviceId)) return S_OK;
         if (key == PKEY_AudioEngine_DeviceFormat) {
-            std::string msg = "Device format changed: " 
-                            + utf16_to_utf8(pwstrDeviceId);
-            context->notifierLogs.push(msg);
-            interruptPlayback();
+            context->notifierLogs.push("Device format changed: " + utf16_to_utf8(pwstrDeviceId));
+            interruptPlayback(HEALTH_FORMAT_CHANGED);
         } else if (key == PKEY_DeviceInterface_Enabled) {
-            std::string msg = "Device interface enabled changed: " 
-                            + utf16_to_utf8(pwstrDeviceId);
-            context->notifierLogs.push(msg);
-            interruptPlayback();
+            context->notifierLogs.push("Device interface enabled changed: " + utf16_to_utf8(pwstrDeviceId));
+            interruptPlayback(HEALTH_DEVICE_LOST);
         }
         return S_OK;
     }
 
-    void interruptPlayback() {
-        std::string msg = "Interrupting playback due to device change";
-        context->notifierLogs.push(msg);
+private:
+    // Without a known endpoint ID, every notification is treated as ours
+    inline bool isOwnDevice(LPCWSTR pwstrDeviceId) const {
+        return context->deviceId.empty() || (pwstrDeviceId && context->deviceId == pwstrDeviceId);
+    }
+
+    void interruptPlayback(DeviceHealth reason) {
+        uint32_t previous = context->deviceHealth.fetch_or(reason, std::memory_order_release);
+        if (previous != HEALTH_OK) return; // Already interrupted
 
+        context->notifierLogs.push("Interrupting playback due to device change");
         if (hStopEvent) {
             SetEvent(hStopEvent);
         }
@@ -217,6 +281,15 @@ public:
 extern "C" {
     static inline void cleanupContext(JNIEnv* env, Logger* logger, OutputContext* ctx) {
         if(ctx) {
+            // A registered notifier would keep calling into the deleted context
+            if (ctx->deviceEnumerator && ctx->notificationClient) {
+                ctx->deviceEnumerator->UnregisterEndpointNotificationCallback(ctx->notificationClient);
+                logger->trace(env, "Device change notification unregistered");
+            }
+            if (ctx->notificationClient) {
+                ctx->notificationClient->Release();
+                ctx->notificationClient = nullptr;
+            }
             delete ctx;
         }
     }
@@ -241,16 +314,342 @@ extern "C" {
     inline void logNotifierMessages(JNIEnv* env, Logger* logger, OutputContext* ctx) {
         if (!ctx) return;
         
-        std::string log;
-        while (ctx->popLog(log)) {
+        ctx->notifierLogs.drain([env, logger](std::string& log) {
             logger->debug(env, "%s", log.c_str());
+        });
+    }
+
+    static inline bool isDeviceInvalidatedError(HRESULT hr) {
+        return hr == AUDCLNT_E_DEVICE_INVALIDATED || hr == AUDCLNT_E_SERVICE_NOT_RUNNING;
+    }
+
+    /*
+     * Pull mode: asks the Java AudioRenderCallback for exactly the amount of
+     * frames the device can accept and copies them into the endpoint buffer.
+     */
+    static HRESULT renderFromCallback(JNIEnv* env, OutputContext* context, UINT32 framesAvailable) {
+        const jint bytesPerFrame = (jint)context->bytesPerFrame;
+        jint requested = (jint)framesAvailable * bytesPerFrame;
+        jint rendered = ThekoSound_AudioRenderCallback::render(
+            env, context->renderCallback, context->renderBuffer, 0, requested);
+        rendered = std::clamp<jint>(rendered, 0, requested);
+        rendered -= rendered % bytesPerFrame;
+
+        if (rendered < requested) context->telemetry.onGlitch();
+        if (rendered == 0) context->telemetry.onSilentBuffer();
+
+        int64_t bufferStart = StreamTelemetry::now();
+        BYTE* dest = nullptr;
+        HRESULT hr = context->renderClient->GetBuffer(framesAvailable, &dest);
+        if (FAILED(hr)) return hr;
+
+        if (rendered > 0) {
+            env->GetByteArrayRegion(context->renderBuffer, 0, rendered, (jbyte*)dest);
+        }
+        if (rendered < requested) {
+            memset(dest + rendered, 0, requested - rendered);
+        }
+
+        hr = context->renderClient->ReleaseBuffer(framesAvailable, rendered == 0 ? AUDCLNT_BUFFERFLAGS_SILENT : 0);
+        context->telemetry.onBufferReleased(StreamTelemetry::now() - bufferStart);
+        return hr;
+    }
+
+    /*
+     * Push mode: moves as many whole frames as are queued in the ring buffer
+     * (up to the free endpoint space) into the endpoint buffer.
+     * An empty ring is an underrun; the audio engine plays silence for it.
+     */
+    static HRESULT renderFromRing(OutputContext* context, UINT32 framesAvailable) {
+        UINT32 framesQueued = (UINT32)(context->ring.availableToRead() / context->bytesPerFrame);
+        UINT32 frames = std::min(framesAvailable, framesQueued);
+        if (frames == 0) {
+            context->telemetry.onGlitch();
+            return S_OK;
+        }
+
+        int64_t bufferStart = StreamTelemetry::now();
+        BYTE* dest = nullptr;
+        HRESULT hr = context->renderClient->GetBuffer(frames, &dest);
+        if (FAILED(hr)) return hr;
+
+        context->ring.read(dest, (size_t)frames * context->bytesPerFrame);
+        hr = context->renderClient->ReleaseBuffer(frames, 0);
+        context->telemetry.onBufferReleased(StreamTelemetry::now() - bufferStart);
+        return hr;
+    }
+
+    /*
+     * Render thread. Waits for the buffer-ready event and fills the endpoint buffer,
+     * either from the Java render callback (pull mode) or from the ring buffer (push mode).
+     * Registered in MMCSS as "Pro Audio".
+     */
+    static inline HRESULT publishOutputClock(OutputContext* context, UINT32 padding) {
+        UINT64 buffered = padding + context->ring.availableToRead() / context->bytesPerFrame;
+        return publishClock(context->audioClock, context->clockFrequency, context->format->nSamplesPerSec,
+                            context->streamLatency, buffered, &context->clock);
+    }
+
+    static DWORD WINAPI renderThreadProc(LPVOID param) {
+        auto context = (OutputContext*)param;
+
+        JNIEnv* env = nullptr;
+        JavaVMAttachArgs attachArgs;
+        attachArgs.version = JNI_VERSION_1_6;
+        attachArgs.name = (char*)RENDER_THREAD_NAME;
+        attachArgs.group = nullptr;
+        if (context->jvm->AttachCurrentThreadAsDaemon((void**)&env, &attachArgs) != JNI_OK) {
+            return 1;
+        }
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPISharedOutput.renderThread");
+
+        HRESULT hrCom = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+
+        DWORD taskIndex = 0;
+        HANDLE mmcssHandle = AvSetMmThreadCharacteristicsW(L"Pro Audio", &taskIndex);
+        if (!mmcssHandle) {
+            logger->warn(env, "Failed to register render thread in MMCSS (error %lu).", GetLastError());
+        } else {
+            AvSetMmThreadPriority(mmcssHandle, AVRT_PRIORITY_HIGH);
+            logger->debug(env, "Render thread registered in MMCSS. Task index: %lu.", taskIndex);
+        }
+
+        const bool pullMode = context->renderCallback != nullptr;
+        bool deviceInvalidated = false;
+
+        while (!context->stopRequested.load(std::memory_order_acquire)) {
+            DWORD waitResult = WaitForMultipleObjects(2, context->events, FALSE, RENDER_THREAD_WAIT_TIMEOUT);
+
+            if (waitResult == WAIT_OBJECT_0 + EVENT_STOP_REQUEST) {
+                // Stop event without a stop request is raised by the device change notifier
+                if (!context->stopRequested.load(std::memory_order_acquire)) {
+                    deviceInvalidated = true;
+                }
+                break;
+            } else if (waitResult == WAIT_TIMEOUT) {
+                context->telemetry.onWakeTimeout();
+                logger->warn(env, "No buffer event received in %d ms.", RENDER_THREAD_WAIT_TIMEOUT);
+                continue;
+            } else if (waitResult != WAIT_OBJECT_0 + EVENT_AUDIO_BUFFER_READY) {
+                logger->error(env, "WaitForMultipleObjects failed: %lu", GetLastError());
+                break;
+            }
+            int64_t wakeTime = StreamTelemetry::now();
+
+            if (context->flushRequested.exchange(false, std::memory_order_acq_rel)) {
+                context->ring.discardTo(context->flushPosition.load(std::memory_order_acquire));
+            }
+
+            UINT32 padding = 0;
+            HRESULT hr = context->audioClient->GetCurrentPadding(&padding);
+            if (FAILED(hr)) {
+                deviceInvalidated = isDeviceInvalidatedError(hr);
+                logger->error(env, "GetCurrentPadding in render thread failed (%s).", fmtHR(hr));
+                break;
+            }
+
+            context->telemetry.onWake(wakeTime, padding);
+            publishOutputClock(context, padding);
+
+            UINT32 framesAvailable = context->bufferFrameCount - padding;
+            if (framesAvailable == 0) continue;
+
+            hr = pullMode
+                ? renderFromCallback(env, context, framesAvailable)
+                : renderFromRing(context, framesAvailable);
+            if (FAILED(hr)) {
+                deviceInvalidated = isDeviceInvalidatedError(hr);
+                logger->error(env, "Failed to fill WASAPI output buffer (%s).", fmtHR(hr));
+                break;
+            }
+        }
+
+        if (deviceInvalidated) {
+            // Keep the notifier's reason if it got there first
+            uint32_t expected = HEALTH_OK;
+            context->deviceHealth.compare_exchange_strong(expected, HEALTH_CLIENT_INVALIDATED, std::memory_order_release);
+            context->telemetry.onDeviceInvalidated();
+            logNotifierMessages(env, logger, context);
+            logger->warn(env, "Render thread stopped, device invalidated.");
+            if (pullMode) {
+                ThekoSound_AudioRenderCallback::onDeviceInvalidated(env, context->renderCallback);
+            }
+        }
+
+        if (mmcssHandle) AvRevertMmThreadCharacteristics(mmcssHandle);
+        if (SUCCEEDED(hrCom)) CoUninitialize();
+
+        logger->trace(env, "Render thread finished.");
+        context->jvm->DetachCurrentThread();
+        return 0;
+    }
+
+    static void releaseRenderResources(JNIEnv* env, OutputContext* context) {
+        if (context->renderCallback) {
+            env->DeleteGlobalRef(context->renderCallback);
+            context->renderCallback = nullptr;
+        }
+        if (context->renderBuffer) {
+            env->DeleteGlobalRef(context->renderBuffer);
+            context->renderBuffer = nullptr;
         }
     }
 
+    static bool startRenderThread(JNIEnv* env, Logger* logger, OutputContext* context, jobject callback) {
+        if (env->GetJavaVM(&context->jvm) != JNI_OK) {
+            logger->error(env, "Failed to get JavaVM.");
+            return false;
+        }
+
+        if (callback) {
+            // Resolve the callback class here: FindClass on a natively attached thread
+            // would use the system class loader.
+            ThekoSound_AudioRenderCallback* callbackClass = ThekoSound_AudioRenderCallback::get(env);
+            if (!callbackClass || !callbackClass->isValid()) {
+                logger->error(env, "Failed to resolve AudioRenderCallback class.");
+                return false;
+            }
+
+            jbyteArray localBuffer = env->NewByteArray((jsize)(context->bufferFrameCount * context->bytesPerFrame));
+            if (!localBuffer) {
+                logger->error(env, "Failed to allocate render buffer.");
+                return false;
+            }
+            context->renderBuffer = (jbyteArray)env->NewGlobalRef(localBuffer);
+            env->DeleteLocalRef(localBuffer);
+            context->renderCallback = env->NewGlobalRef(callback);
+            if (!context->renderBuffer || !context->renderCallback) {
+                logger->error(env, "Failed to create global references for render thread.");
+                releaseRenderResources(env, context);
+                return false;
+            }
+        }
+
+        context->telemetry.configure(context->bufferFrameCount, context->periodFrames, context->format->nSamplesPerSec);
+        context->stopRequested.store(false, std::memory_order_release);
+        context->renderThread = CreateThread(NULL, 0, renderThreadProc, context, 0, NULL);
+        if (!context->renderThread) {
+            logger->error(env, "Failed to create render thread (error %lu).", GetLastError());
+            releaseRenderResources(env, context);
+            return false;
+        }
+
+        logger->debug(env, "Render thread started (%s mode). Buffer: %u frames.",
+            callback ? "pull" : "push", context->bufferFrameCount);
+        return true;
+    }
+
+    static void stopRenderThread(JNIEnv* env, Logger* logger, OutputContext* context) {
+        if (!context->renderThread) return;
+
+        context->stopRequested.store(true, std::memory_order_release);
+        SetEvent(context->events[EVENT_STOP_REQUEST]);
+
+        DWORD waitResult = WaitForSingleObject(context->renderThread, INFINITE);
+        if (waitResult != WAIT_OBJECT_0) {
+            logger->warn(env, "Failed to wait for render thread: %lu", GetLastError());
+        }
+        CloseHandle(context->renderThread);
+        context->renderThread = nullptr;
+
+        releaseRenderResources(env, context);
+        logger->trace(env, "Render thread stopped.");
+    }
+
+    /*
+     * Returns the endpoint buffer duration for the stream format and updates the period frames.
+     * The ring buffer holds the requested amount of audio; the endpoint buffer
+     * only has to cover the render thread's wake-up jitter.
+     */
+    static REFERENCE_TIME getEndpointBufferDuration(OutputContext* context, int bufferSizeInFrames) {
+        const WAVEFORMATEX* format = context->format;
+        REFERENCE_TIME hnsBufferDuration = (REFERENCE_TIME)((double)bufferSizeInFrames / format->nSamplesPerSec * 1e7);
+
+        REFERENCE_TIME hnsDefaultPeriod = 0;
+        if (SUCCEEDED(context->audioClient->GetDevicePeriod(&hnsDefaultPeriod, nullptr)) && hnsDefaultPeriod > 0) {
+            hnsBufferDuration = std::min(hnsBufferDuration, ENDPOINT_BUFFER_PERIODS * hnsDefaultPeriod);
+        }
+        context->periodFrames = (UINT32)(hnsDefaultPeriod * format->nSamplesPerSec / 10000000);
+        return hnsBufferDuration;
+    }
+
+    /*
+     * Registers the device change notifier and publishes the opened format.
+     * Shared by streams with an own audio client and endpoint session voices.
+     */
+    static jlong finishOpen(JNIEnv* env, Logger* logger, OutputContext* context, jobject jAtomicRefFormat) {
+        HRESULT hr = CoCreateInstance(__uuidof(MMDeviceEnumerator), NULL,
+            CLSCTX_ALL, __uuidof(IMMDeviceEnumerator),
+            (void**)&context->deviceEnumerator);
+    
+        if (SUCCEEDED(hr)) {
+            OutputDeviceChangeNotifier* notifier = new OutputDeviceChangeNotifier(context);
+            hr = context->deviceEnumerator->RegisterEndpointNotificationCallback(notifier);
+            
+            if (SUCCEEDED(hr)) {
+                context->notificationClient = notifier;
+                notifier->AddRef();
+                logger->trace(env, "Device change notification registered");
+            } else {
+                notifier->Release();
+                logger->warn(env, "Failed to register device notifications");
+            }
+        } else {
+            logger->warn(env, "Failed to create device enumerator");
+        }
+
+        jobject jAudioFormat = env->NewGlobalRef(WAVEFORMATEX_to_AudioFormat(env, context->format));
+        if (!jAudioFormat) {
+            cleanupAndThrowError(env, logger, context, E_FAIL, "Failed to create audio format.");
+            return 0;
+        }
+        Java_Concurrent_AtomicReference::set(env, jAtomicRefFormat, jAudioFormat);
+
+        logger->debug(env, "Opened WASAPI output%s. ContextPtr: %s",
+            context->session ? " in endpoint session" : "", FORMAT_PTR(context));
+
+        return (jlong)context;
+    }
+
+    /*
+     * Endpoint session mode: joins (or creates) the session of the endpoint and registers
+     * the ring as one of its voices. The stream uses the session mix format.
+     * Returns false if the endpoint cannot be shared, the caller opens an own stream then.
+     */
+    static bool joinEndpointSession(JNIEnv* env, Logger* logger, OutputContext* context, int requestedFrames) {
+        EndpointSession* session = acquireEndpointSession(env, logger, context->outputDevice, context->deviceId);
+        if (!session) return false;
+
+        size_t formatSize = sizeof(WAVEFORMATEX) + session->format->cbSize;
+        WAVEFORMATEX* format = (WAVEFORMATEX*)CoTaskMemAlloc(formatSize);
+        UINT32 ringFrames = std::max((UINT32)std::max(requestedFrames, 0), session->bufferFrameCount);
+        if (!format || !context->ring.allocate((size_t)ringFrames * session->bytesPerFrame)) {
+            logger->warn(env, "Failed to allocate endpoint session voice.");
+            if (format) CoTaskMemFree(format);
+            releaseEndpointSession(session);
+            return false;
+        }
+        memcpy(format, session->format, formatSize);
+
+        context->format = format;
+        context->bytesPerFrame = session->bytesPerFrame;
+        context->bufferFrameCount = session->bufferFrameCount;
+        context->periodFrames = session->periodFrames;
+        context->streamLatency = session->streamLatency;
+        context->sampleType = SampleType::FLOAT32;
+
+        context->voice.ring = &context->ring;
+        context->session = session;
+        session->addVoice(&context->voice);
+
+        logger->debug(env, "Joined endpoint session. Ring buffer size: %u frames", ringFrames);
+        return true;
+    }
+
     JNIEXPORT jlong JNICALL 
     Java_org_theko_sound_backends_wasapi_WASAPISharedOutput_nOpen
-    (JNIEnv* env, jobject obj, jobject jport, jobject jformat, jint bufferSize /* in bytes */, jobject jAtomicRefFormat) {
-        Logger* logger = LoggerManager::getManager()->getLogger(env, "NATIVE: WASAPISharedOutput.nOpen");
+    (JNIEnv* env, jobject obj, jobject jport, jobject jformat, jint bufferSize /* in bytes */, jobject jAtomicRefFormat, jboolean lowLatency, jboolean sharedSession, jboolean engineConversion) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPISharedOutput.nOpen");
 
         if (!jport || !jformat || !jAtomicRefFormat) return 0;
 
@@ -265,12 +664,29 @@ extern "C" {
         context->outputDevice = device;
         logger->trace(env, "IMMDevice pointer: %s", FORMAT_PTR(device));
 
+        LPWSTR deviceId = nullptr;
+        if (SUCCEEDED(device->GetId(&deviceId)) && deviceId) {
+            context->deviceId = deviceId;
+            CoTaskMemFree(deviceId);
+        } else {
+            logger->warn(env, "Failed to get device ID, all device notifications will interrupt playback.");
+        }
+
         WAVEFORMATEX* format = AudioFormat_to_WAVEFORMATEX(env, jformat);
         if (!format) {
             cleanupAndThrowError(env, logger, context, E_FAIL, "Failed to get WAVEFORMATEX.");
             return 0;
         }
-        logger->trace(env, "WAVEFORMATEX (Request): %s. Pointer: %s", WAVEFORMATEX_toText(format), FORMAT_PTR(format));
+        if (logger->isTraceEnabled()) logger->trace(env, "WAVEFORMATEX (Request): %s. Pointer: %s", WAVEFORMATEX_toText(format), FORMAT_PTR(format));
+
+        if (sharedSession) {
+            if (lowLatency) logger->debug(env, "Low latency is ignored in endpoint session mode.");
+            if (joinEndpointSession(env, logger, context, bufferSize / format->nBlockAlign)) {
+                CoTaskMemFree(format);
+                return finishOpen(env, logger, context, jAtomicRefFormat);
+            }
+            logger->info(env, "Endpoint session is not available, opening an own stream.");
+        }
 
         context->audioClient = nullptr;
         HRESULT hr = context->outputDevice->Activate(__uuidof(IAudioClient), CLSCTX_ALL, nullptr, (void**)&context->audioClient);
@@ -281,14 +697,18 @@ extern "C" {
         logger->trace(env, "IAudioClient pointer: %s", FORMAT_PTR(context->audioClient));
 
         WAVEFORMATEX* closestFormat = nullptr;
+        WAVEFORMATEX* fallbackFormat = nullptr; // Opened instead if the engine cannot convert
         hr = context->audioClient->IsFormatSupported(AUDCLNT_SHAREMODE_SHARED, format, &closestFormat);
-        if (FAILED(hr)) {
-            cleanupAndThrowError(env, logger, context, hr, "Failed to check format support.");
-            return 0;
-        }
-
         if (hr == S_OK) {
             logger->trace(env, "Format is supported.");
+        } else if (engineConversion && (hr == S_FALSE || hr == AUDCLNT_E_UNSUPPORTED_FORMAT)) {
+            // The engine resamples, remixes and converts the samples to its mix format
+            logger->debug(env, "Format is not supported, the audio engine converts it.");
+            fallbackFormat = closestFormat;
+            context->engineConversion = true;
+        } else if (FAILED(hr)) {
+            cleanupAndThrowError(env, logger, context, hr, "Failed to check format support.");
+            return 0;
         } else if (closestFormat) { 
             logger->debug(env, "Format is not supported, using closest match: %s" , WAVEFORMATEX_toText(closestFormat));
             logger->trace(env, "Closest format pointer: %s", FORMAT_PTR(closestFormat));
@@ -307,19 +727,106 @@ extern "C" {
 
         logger->debug(env, "Input buffer (in frames): %d", bufferSizeInFrames);
 
-        REFERENCE_TIME hnsBufferDuration = (REFERENCE_TIME)((double)bufferSizeInFrames / format->nSamplesPerSec * 1e7);
+        REFERENCE_TIME hnsBufferDuration = getEndpointBufferDuration(context, bufferSizeInFrames);
         logger->debug(env, "hnsBufferDuration (in 100-ns): %lld", hnsBufferDuration);
-        
-        logger->trace(env, "Trying to initialize IAudioClient...");
-        hr = context->audioClient->Initialize(
-            AUDCLNT_SHAREMODE_SHARED,
-            AUDCLNT_STREAMFLAGS_EVENTCALLBACK,
-            hnsBufferDuration,
-            0,
-            format,
-            nullptr 
-        );
-        logger->trace(env, "IAudioClient::Initialize called. Result: %s", fmtHR(hr));
+
+        hr = E_FAIL;
+        if (lowLatency && context->engineConversion) {
+            logger->debug(env, "Low latency is not available with engine format conversion.");
+        } else if (lowLatency) {
+            // Small engine periods (down to a few milliseconds) are only available through
+            // IAudioClient3 on Windows 10 and newer, and not for every driver
+            EnginePeriods periods = {};
+            IAudioClient3* audioClient3 = nullptr;
+            HRESULT hrPeriods = getEnginePeriods(context->audioClient, format, &periods);
+            if (SUCCEEDED(hrPeriods)) {
+                hrPeriods = context->audioClient->QueryInterface(__uuidof(IAudioClient3), (void**)&audioClient3);
+            }
+            if (SUCCEEDED(hrPeriods) && audioClient3) {
+                logger->trace(env, "Trying to initialize IAudioClient3 with %u frames period...", periods.minFrames);
+                hr = audioClient3->InitializeSharedAudioStream(
+                    AUDCLNT_STREAMFLAGS_EVENTCALLBACK,
+                    periods.minFrames,
+                    format,
+                    nullptr
+                );
+                audioClient3->Release();
+                logger->trace(env, "IAudioClient3::InitializeSharedAudioStream called. Result: %s", fmtHR(hr));
+            } else {
+                hr = hrPeriods;
+            }
+
+            if (SUCCEEDED(hr)) {
+                context->periodFrames = periods.minFrames;
+                context->lowLatency = true;
+            } else {
+                logger->info(env, "Low-latency shared mode is not available (%s), falling back to the default period.", fmtHR(hr));
+                // A failed initialization leaves the client unusable, activate a fresh one
+                context->audioClient->Release();
+                context->audioClient = nullptr;
+                hr = context->outputDevice->Activate(__uuidof(IAudioClient), CLSCTX_ALL, nullptr, (void**)&context->audioClient);
+                if (FAILED(hr) || !context->audioClient) {
+                    cleanupAndThrowError(env, logger, context, hr, "Failed to get IAudioClient.");
+                    return 0;
+                }
+                hr = E_FAIL;
+            }
+        }
+
+        if (!context->lowLatency) {
+            DWORD streamFlags = AUDCLNT_STREAMFLAGS_EVENTCALLBACK;
+            if (context->engineConversion) {
+                streamFlags |= AUDCLNT_STREAMFLAGS_AUTOCONVERTPCM | AUDCLNT_STREAMFLAGS_SRC_DEFAULT_QUALITY;
+            }
+            logger->trace(env, "Trying to initialize IAudioClient...");
+            hr = context->audioClient->Initialize(
+                AUDCLNT_SHAREMODE_SHARED,
+                streamFlags,
+                hnsBufferDuration,
+                0,
+                format,
+                nullptr 
+            );
+            logger->trace(env, "IAudioClient::Initialize called. Result: %s", fmtHR(hr));
+        }
+        if (FAILED(hr) && context->engineConversion && hr != AUDCLNT_E_DEVICE_IN_USE) {
+            // Older systems reject the conversion flags, open the closest format instead
+            logger->info(env, "Engine format conversion is not available (%s), using the closest supported format.", fmtHR(hr));
+            context->engineConversion = false;
+            context->audioClient->Release();
+            context->audioClient = nullptr;
+            hr = context->outputDevice->Activate(__uuidof(IAudioClient), CLSCTX_ALL, nullptr, (void**)&context->audioClient);
+            if (FAILED(hr) || !context->audioClient) {
+                CoTaskMemFree(fallbackFormat);
+                cleanupAndThrowError(env, logger, context, hr, "Failed to get IAudioClient.");
+                return 0;
+            }
+            if (!fallbackFormat) {
+                hr = context->audioClient->GetMixFormat(&fallbackFormat);
+                if (FAILED(hr) || !fallbackFormat) {
+                    cleanupAndThrowError(env, logger, context, FAILED(hr) ? hr : E_FAIL, "Failed to get mix format.");
+                    return 0;
+                }
+            }
+            logger->debug(env, "Fallback format: %s", WAVEFORMATEX_toText(fallbackFormat));
+            CoTaskMemFree(format);
+            format = fallbackFormat;
+            fallbackFormat = nullptr;
+            context->format = format;
+
+            bufferSizeInFrames = bufferSize / format->nBlockAlign;
+            hnsBufferDuration = getEndpointBufferDuration(context, bufferSizeInFrames);
+            hr = context->audioClient->Initialize(
+                AUDCLNT_SHAREMODE_SHARED,
+                AUDCLNT_STREAMFLAGS_EVENTCALLBACK,
+                hnsBufferDuration,
+                0,
+                format,
+                nullptr
+            );
+            logger->trace(env, "IAudioClient::Initialize called. Result: %s", fmtHR(hr));
+        }
+        CoTaskMemFree(fallbackFormat);
         if (hr == AUDCLNT_E_DEVICE_IN_USE) {
             cleanupAndThrowError(env, logger, context, hr, "Device is in use.");
             return 0; 
@@ -345,7 +852,16 @@ extern "C" {
         }
         logger->trace(env, "IAudioClock pointer: %s", FORMAT_PTR(context->audioClock));
 
-        context->events[EVENT_AUDIO_BUFFER_READY] = CreateEvent(NULL, TRUE, FALSE, NULL);
+        hr = context->audioClock->GetFrequency(&context->clockFrequency);
+        if (FAILED(hr) || context->clockFrequency == 0) {
+            cleanupAndThrowError(env, logger, context, FAILED(hr) ? hr : E_FAIL, "Failed to get IAudioClock frequency.");
+            return 0;
+        }
+        context->audioClient->GetStreamLatency(&context->streamLatency);
+        logger->trace(env, "Clock frequency: %llu, stream latency: %lld (100-ns)",
+            (unsigned long long)context->clockFrequency, (long long)context->streamLatency);
+
+        context->events[EVENT_AUDIO_BUFFER_READY] = CreateEvent(NULL, FALSE, FALSE, NULL);
         if (!context->events[EVENT_AUDIO_BUFFER_READY]) {
             cleanupAndThrowError(env, logger, context, E_FAIL, "Failed to create audio callback event.");
             return 0;
@@ -360,49 +876,48 @@ extern "C" {
         }
         logger->trace(env, "Stop event handle: %s", FORMAT_PTR(context->events[EVENT_STOP_REQUEST]));
 
-        context->audioClient->GetBufferSize(&context->bufferFrameCount);
+        hr = context->audioClient->GetBufferSize(&context->bufferFrameCount);
+        if (FAILED(hr) || context->bufferFrameCount == 0) {
+            cleanupAndThrowError(env, logger, context, FAILED(hr) ? hr : E_FAIL, "Failed to get the endpoint buffer size.");
+            return 0;
+        }
         context->bytesPerFrame = format->nBlockAlign;
         context->pendingFrames = 0;
 
-        context->audioClient->GetBufferSize(&context->bufferFrameCount);
-        logger->debug(env, "Actual buffer size: %d frames", context->bufferFrameCount);
-
-        hr = CoCreateInstance(__uuidof(MMDeviceEnumerator), NULL,
-            CLSCTX_ALL, __uuidof(IMMDeviceEnumerator),
-            (void**)&context->deviceEnumerator);
-    
-        if (SUCCEEDED(hr)) {
-            OutputDeviceChangeNotifier* notifier = new OutputDeviceChangeNotifier(context);
-            hr = context->deviceEnumerator->RegisterEndpointNotificationCallback(notifier);
-            
-            if (SUCCEEDED(hr)) {
-                context->notificationClient = notifier;
-                notifier->AddRef();
-                logger->trace(env, "Device change notification registered");
-            } else {
-                notifier->Release();
-                logger->warn(env, "Failed to register device notifications");
+        context->sampleType = getSampleType(format);
+        if (theko::sound::conversion::bytesPerSample(context->sampleType) * format->nChannels != format->nBlockAlign) {
+            context->sampleType = SampleType::UNSUPPORTED;
+        }
+        logger->debug(env, "Native float conversion: %s (%s kernels).",
+            context->sampleType != SampleType::UNSUPPORTED ? "supported" : "not supported",
+            theko::sound::conversion::getConversionKernels().name);
+
+        logger->debug(env, "Actual buffer size: %d frames, period: %u frames%s", context->bufferFrameCount,
+            context->periodFrames, context->lowLatency ? " (low latency)" : "");
+        if (context->engineConversion && logger->isDebugEnabled()) {
+            WAVEFORMATEX* mixFormat = nullptr;
+            if (SUCCEEDED(context->audioClient->GetMixFormat(&mixFormat)) && mixFormat) {
+                logger->debug(env, "Audio engine converts %lu Hz, %u channels, %u bits to %lu Hz, %u channels, %u bits.",
+                    (unsigned long)format->nSamplesPerSec, format->nChannels, format->wBitsPerSample,
+                    (unsigned long)mixFormat->nSamplesPerSec, mixFormat->nChannels, mixFormat->wBitsPerSample);
+                CoTaskMemFree(mixFormat);
             }
-        } else {
-            logger->warn(env, "Failed to create device enumerator");
         }
 
-        jobject jAudioFormat = env->NewGlobalRef(WAVEFORMATEX_to_AudioFormat(env, format));
-        if (!jAudioFormat) {
-            cleanupAndThrowError(env, logger, context, E_FAIL, "Failed to create audio format.");
+        UINT32 ringFrames = std::max((UINT32)std::max(bufferSizeInFrames, 0), context->bufferFrameCount);
+        if (!context->ring.allocate((size_t)ringFrames * context->bytesPerFrame)) {
+            cleanupAndThrowError(env, logger, context, E_OUTOFMEMORY, "Failed to allocate ring buffer.");
             return 0;
         }
-        Java_Concurrent_AtomicReference::set(env, jAtomicRefFormat, jAudioFormat);
-
-        logger->debug(env, "Opened WASAPI output. ContextPtr: %s", FORMAT_PTR(context));
+        logger->debug(env, "Ring buffer size: %u frames", ringFrames);
 
-        return (jlong)context;
+        return finishOpen(env, logger, context, jAtomicRefFormat);
     }
 
     JNIEXPORT void JNICALL
     Java_org_theko_sound_backends_wasapi_WASAPISharedOutput_nClose
     (JNIEnv* env, jobject obj, jlong ptr) {
-        Logger* logger = LoggerManager::getManager()->getLogger(env, "NATIVE: WASAPISharedOutput.nClose");
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPISharedOutput.nClose");
         
         
         auto context = (OutputContext*)ptr;
@@ -412,6 +927,14 @@ extern "C" {
         }
 
         logNotifierMessages(env, logger, context);
+        stopRenderThread(env, logger, context);
+
+        if (context->session) {
+            context->session->removeVoice(&context->voice);
+            releaseEndpointSession(context->session);
+            context->session = nullptr;
+            logger->trace(env, "Left endpoint session.");
+        }
 
         if (context->audioClock) {
             ULONG refCount = context->audioClock->Release();
@@ -479,22 +1002,44 @@ extern "C" {
 
     JNIEXPORT void JNICALL
     Java_org_theko_sound_backends_wasapi_WASAPISharedOutput_nStart
-    (JNIEnv* env, jobject obj, jlong ptr) {
-        Logger* logger = LoggerManager::getManager()->getLogger(env, "NATIVE: WASAPISharedOutput.nStart");
+    (JNIEnv* env, jobject obj, jlong ptr, jobject renderCallback) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPISharedOutput.nStart");
         auto context = (OutputContext*)ptr;
         if (!context) {
             logger->info(env, "WASAPI output not opened.");
             return;
         }
         
+        if (context->session) {
+            logNotifierMessages(env, logger, context);
+            if (renderCallback) {
+                logger->error(env, "Pull mode is not available in endpoint session mode.");
+                env->ThrowNew(ThekoSound_AudioBackendException::getClazz(env), "Pull mode is not available in endpoint session mode.");
+                return;
+            }
+            context->deviceHealth.store(HEALTH_OK, std::memory_order_release);
+            context->voice.active.store(true, std::memory_order_release);
+            logger->trace(env, "Started endpoint session voice.");
+            return;
+        }
+
         if (context) {
             logNotifierMessages(env, logger, context);
+            ResetEvent(context->events[EVENT_STOP_REQUEST]);
 
             HRESULT hr = context->audioClient->Start();
             if (FAILED(hr)) {
                 logger->error(env, "Failed to start WASAPI output (%s).", fmtHR(hr));
-            } else {
-                logger->trace(env, "Started WASAPI output.");
+                return;
+            }
+            logger->trace(env, "Started WASAPI output.");
+
+            context->deviceHealth.store(HEALTH_OK, std::memory_order_release);
+            if (!context->renderThread) {
+                if (!startRenderThread(env, logger, context, renderCallback)) {
+                    context->audioClient->Stop();
+                    env->ThrowNew(ThekoSound_AudioBackendException::getClazz(env), "Failed to start render thread.");
+                }
             }
         }
     }
@@ -527,7 +1072,7 @@ extern "C" {
     JNIEXPORT void JNICALL
     Java_org_theko_sound_backends_wasapi_WASAPISharedOutput_nStop
     (JNIEnv* env, jobject obj, jlong ptr) {
-        Logger* logger = LoggerManager::getManager()->getLogger(env, "NATIVE: WASAPISharedOutput.nStop");
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPISharedOutput.nStop");
         auto context = (OutputContext*)ptr;
         if (!context) {
             logger->info(env, "WASAPI output not opened.");
@@ -535,6 +1080,13 @@ extern "C" {
         }
 
         logNotifierMessages(env, logger, context);
+        if (context->session) {
+            // Queued data stays in the ring and is mixed again after nStart
+            context->voice.active.store(false, std::memory_order_release);
+            logger->trace(env, "Stopped endpoint session voice.");
+            return;
+        }
+        stopRenderThread(env, logger, context);
         SetEvent(context->events[EVENT_STOP_REQUEST]);
 
         HRESULT hr = context->audioClient->Stop();
@@ -550,20 +1102,63 @@ extern "C" {
     JNIEXPORT void JNICALL
     Java_org_theko_sound_backends_wasapi_WASAPISharedOutput_nFlush
     (JNIEnv* env, jobject obj, jlong ptr) {
-        Logger* logger = LoggerManager::getManager()->getLogger(env, "NATIVE: WASAPISharedOutput.nFlush");
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPISharedOutput.nFlush");
         auto context = (OutputContext*)ptr;
         if (!context) {
             logger->info(env, "WASAPI output not opened.");
             return;
         }
 
+        if (context->session) {
+            // Discarded up to this point by the session render thread on its next period
+            context->voice.flushPosition.store(context->ring.getWritePosition(), std::memory_order_release);
+            context->voice.flushRequested.store(true, std::memory_order_release);
+            return;
+        }
+
+        if (context->renderThread) {
+            // The ring can only be discarded by its consumer, which drops only the data
+            // written up to this point and renders silence on its own thread. The render
+            // client belongs to the render thread, so the endpoint buffer is not touched here.
+            context->flushPosition.store(context->ring.getWritePosition(), std::memory_order_release);
+            context->flushRequested.store(true, std::memory_order_release);
+            return;
+        }
+        context->ring.discard();
         flushBuffer(env, context, logger);
     }
 
+    /*
+     * Endpoint session mode: waits until the session has mixed the whole ring,
+     * then for one endpoint buffer, which is shared with the other voices.
+     */
+    static void drainSessionVoice(JNIEnv* env, Logger* logger, OutputContext* context) {
+        if (!context->voice.active.load(std::memory_order_acquire)) {
+            logger->debug(env, "Voice is not started, nothing to drain.");
+            return;
+        }
+
+        DWORD periodMs = std::max<DWORD>(1, (DWORD)(context->periodFrames * 1000ull / context->format->nSamplesPerSec));
+        while (context->ring.availableToRead() > 0) {
+            if (!context->isHealthy()) {
+                logNotifierMessages(env, logger, context);
+                logger->warn(env, "Device invalidated during drain (health 0x%x).", context->deviceHealth.load(std::memory_order_relaxed));
+                env->ThrowNew(ThekoSound_DeviceInvalidatedException::getClazz(env), "Device invalidated during drain");
+                return;
+            }
+            if (!context->voice.active.load(std::memory_order_acquire)) {
+                logger->debug(env, "Drain operation interrupted by stop");
+                return;
+            }
+            Sleep(periodMs);
+        }
+        Sleep((DWORD)(context->bufferFrameCount * 1000ull / context->format->nSamplesPerSec));
+    }
+
     JNIEXPORT void JNICALL
     Java_org_theko_sound_backends_wasapi_WASAPISharedOutput_nDrain
     (JNIEnv* env, jobject obj, jlong ptr) {
-        Logger* logger = LoggerManager::getManager()->getLogger(env, "NATIVE: WASAPISharedOutput.nDrain");
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPISharedOutput.nDrain");
         
         auto context = (OutputContext*)ptr;
         
@@ -572,18 +1167,29 @@ extern "C" {
             return;
         }
 
+        if (context->session) {
+            drainSessionVoice(env, logger, context);
+            return;
+        }
+
+        if (!context->renderThread) {
+            logger->debug(env, "Render thread is not running, nothing to drain.");
+            return;
+        }
+
+        // Poll on the stop event: it is manual-reset, so waiting on it does not
+        // steal buffer-ready signals from the render thread.
+        DWORD periodMs = std::max<DWORD>(1, (DWORD)(context->bufferFrameCount * 1000ull / context->format->nSamplesPerSec / 2));
         UINT32 padding;
         do {
-            DWORD deviceState;
-            HRESULT hr = context->outputDevice->GetState(&deviceState);
-            if (FAILED(hr) || deviceState != DEVICE_STATE_ACTIVE) {
+            if (!context->isHealthy()) {
                 logNotifierMessages(env, logger, context);
-                logger->warn(env, "Device invalidated during drain, state=%lu (%s).", deviceState, fmtHR(hr));
+                logger->warn(env, "Device invalidated during drain (health 0x%x).", context->deviceHealth.load(std::memory_order_relaxed));
                 env->ThrowNew(ThekoSound_DeviceInvalidatedException::getClazz(env), "Device invalidated during drain");
                 break;
             }
-            
-            hr = context->audioClient->GetCurrentPadding(&padding);
+
+            HRESULT hr = context->audioClient->GetCurrentPadding(&padding);
             if (FAILED(hr)) {
                 logNotifierMessages(env, logger, context);
                 if (hr == AUDCLNT_E_DEVICE_INVALIDATED) {
@@ -595,12 +1201,11 @@ extern "C" {
                 break;
             }
             
-            if (padding == 0) break;
+            if (padding == 0 && context->ring.availableToRead() == 0) break;
 
-            HANDLE handles[2] = { context->events[EVENT_AUDIO_BUFFER_READY], context->events[EVENT_STOP_REQUEST] };
-            DWORD waitResult = WaitForMultipleObjects(2, handles, FALSE, 100);
-            
-            if (waitResult == WAIT_OBJECT_0 + 1) {
+            DWORD waitResult = WaitForSingleObject(context->events[EVENT_STOP_REQUEST], periodMs);
+            if (waitResult == WAIT_OBJECT_0) {
+                if (!context->isHealthy()) continue; // Raised by the notifier, report it above
                 logger->debug(env, "Drain operation interrupted by stop event");
                 break;
             }
@@ -608,114 +1213,165 @@ extern "C" {
         context->pendingFrames = 0;
     }
 
+    static bool canWrite(JNIEnv* env, Logger* logger, OutputContext* context) {
+        if (!context) {
+            logger->info(env, "WASAPI output not opened.");
+            return false;
+        }
+
+        if (context->renderCallback) {
+            logger->warn(env, "Cannot write while the render thread is in pull mode.");
+            return false;
+        }
+
+        // A single relaxed load per write, the notifier publishes device changes here
+        if (!context->isHealthy()) {
+            logNotifierMessages(env, logger, context);
+            logger->error(env, "Device invalidated, write rejected (health 0x%x).", context->deviceHealth.load(std::memory_order_relaxed));
+            env->ThrowNew(ThekoSound_DeviceInvalidatedException::getClazz(env), "Device invalidated.");
+            return false;
+        }
+        return true;
+    }
+
+    // Non-blocking: the number of bytes, in whole frames, that fit into the ring
+    static inline size_t writableBytes(OutputContext* context, jint length) {
+        size_t writable = std::min<size_t>(length, context->ring.availableToWrite());
+        return writable - writable % context->bytesPerFrame;
+    }
+
     JNIEXPORT jint JNICALL
     Java_org_theko_sound_backends_wasapi_WASAPISharedOutput_nWrite
     (JNIEnv* env, jobject obj, jlong ptr, jbyteArray buffer, jint offset, jint length) {
-        Logger* logger = LoggerManager::getManager()->getLogger(env, "NATIVE: WASAPISharedOutput.nWrite");
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPISharedOutput.nWrite");
         
         auto context = (OutputContext*)ptr;
-        
-        if (!context) {
-            logger->info(env, "WASAPI output not opened.");
+        if (!canWrite(env, logger, context)) return -1;
+
+        if (offset < 0 || length < 0 || offset > env->GetArrayLength(buffer) - length) {
+            logger->error(env, "Invalid write range. Offset: %d, length: %d.", offset, length);
             return -1;
         }
 
-        jbyte* src = env->GetByteArrayElements(buffer, NULL);
-        if (!src) {
-            logger->error(env, "Failed to get array elements from byte array.");
+        // Copy straight from the Java array into the ring
+        size_t written = context->ring.writeWith(writableBytes(context, length),
+            [env, buffer, offset](uint8_t* dst, size_t srcOffset, size_t count) {
+                env->GetByteArrayRegion(buffer, offset + (jsize)srcOffset, (jsize)count, (jbyte*)dst);
+            });
+        context->pendingFrames += (UINT32)(written / context->bytesPerFrame);
+
+        return (jint)written;
+    }
+
+    JNIEXPORT jint JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPISharedOutput_nWriteDirect
+    (JNIEnv* env, jobject obj, jlong ptr, jobject buffer, jint offset, jint length) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPISharedOutput.nWriteDirect");
+
+        auto context = (OutputContext*)ptr;
+        if (!canWrite(env, logger, context)) return -1;
+
+        uint8_t* src = (uint8_t*)env->GetDirectBufferAddress(buffer);
+        jlong capacity = env->GetDirectBufferCapacity(buffer);
+        if (!src || capacity < 0) {
+            logger->error(env, "Buffer is not a direct buffer.");
+            return -1;
+        }
+        if (offset < 0 || length < 0 || (jlong)offset + length > capacity) {
+            logger->error(env, "Invalid write range. Offset: %d, length: %d.", offset, length);
             return -1;
         }
-        UINT32 totalFrames = length / context->bytesPerFrame;
-        UINT32 framesWritten = 0;
 
-        while (framesWritten < totalFrames) {
-            DWORD deviceState;
-            HRESULT hr = context->outputDevice->GetState(&deviceState);
-            if (FAILED(hr)) {
-                logNotifierMessages(env, logger, context);
-                if (hr == AUDCLNT_E_DEVICE_INVALIDATED) {
-                    logger->error(env, "Audio device invalidated during write, in GetState (%s).", fmtHR(hr));
-                    env->ReleaseByteArrayElements(buffer, src, JNI_ABORT);
-                    return -1;
-                }
-                logger->warn(env, "Audio device GetState failed (%s).", fmtHR(hr));
-                env->ReleaseByteArrayElements(buffer, src, JNI_ABORT);
-                return -1;
-            }
-            
-            if (deviceState != DEVICE_STATE_ACTIVE) {
-                logNotifierMessages(env, logger, context);
-                logger->error(env, "Audio device not active, state=%lu", deviceState);
-                env->ReleaseByteArrayElements(buffer, src, JNI_ABORT);
-                env->ThrowNew(ThekoSound_DeviceInactiveException::getClazz(env), "Audio device not active.");
-                return -1;
-            }
+        size_t written = context->ring.write(src + offset, writableBytes(context, length));
+        context->pendingFrames += (UINT32)(written / context->bytesPerFrame);
 
-            UINT32 availableFrames;
-            UINT32 padding;
-            hr = context->audioClient->GetCurrentPadding(&padding); 
-            if (FAILED(hr)) {
-                logNotifierMessages(env, logger, context);
-                if (hr == AUDCLNT_E_DEVICE_INVALIDATED) {
-                    logger->error(env, "Device invalidated during write, in GetCurrentPadding (%s).", fmtHR(hr));
-                    env->ReleaseByteArrayElements(buffer, src, JNI_ABORT);
-                    env->ThrowNew(ThekoSound_DeviceInvalidatedException::getClazz(env), "Device invalidated during write, in GetCurrentPadding.");
-                    return -1;
+        return (jint)written;
+    }
+
+    JNIEXPORT jint JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPISharedOutput_nWriteFloat
+    (JNIEnv* env, jobject obj, jlong ptr, jobjectArray samples, jint offset, jint frames) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPISharedOutput.nWriteFloat");
+
+        auto context = (OutputContext*)ptr;
+        if (!canWrite(env, logger, context)) return -1;
+
+        if (context->sampleType == SampleType::UNSUPPORTED) {
+            logger->error(env, "Native float conversion is not supported for the opened format.");
+            return -1;
+        }
+
+        const UINT32 channels = context->format->nChannels;
+        if (!samples || (UINT32)env->GetArrayLength(samples) != channels || channels > MAX_PLANAR_CHANNELS) {
+            logger->error(env, "Samples must have %u channels.", channels);
+            return -1;
+        }
+        if (offset < 0 || frames < 0) {
+            logger->error(env, "Invalid write range. Offset: %d, frames: %d.", offset, frames);
+            return -1;
+        }
+
+        // Non-blocking: convert only the frames that fit into the ring
+        size_t count = std::min<size_t>(frames, context->ring.availableToWrite() / context->bytesPerFrame);
+        if (count == 0) return 0;
+
+        jfloatArray arrays[MAX_PLANAR_CHANNELS];
+        for (UINT32 ch = 0; ch < channels; ch++) {
+            arrays[ch] = (jfloatArray)env->GetObjectArrayElement(samples, ch);
+            if (!arrays[ch] || env->GetArrayLength(arrays[ch]) - offset < (jsize)count) {
+                logger->error(env, "Channel %u is null or shorter than %d frames.", ch, offset + (jint)count);
+                for (UINT32 i = 0; i <= ch; i++) {
+                    if (arrays[i]) env->DeleteLocalRef(arrays[i]);
                 }
-                logger->error(env, "GetCurrentPadding in write failed (%s).", fmtHR(hr));
-                env->ReleaseByteArrayElements(buffer, src, JNI_ABORT);
-                env->ThrowNew(ThekoSound_AudioBackendException::getClazz(env), "GetCurrentPadding in write failed.");
                 return -1;
             }
-            availableFrames = context->bufferFrameCount - padding;
-            if (availableFrames == 0) {
-                DWORD waitResult = WaitForMultipleObjects(2, context->events, FALSE, INFINITE);
-                
-                if (waitResult == WAIT_OBJECT_0 + 1) {
-                    logger->trace(env, "Write operation interrupted by stop event");
-                    break;
-                }
-                else if (waitResult != WAIT_OBJECT_0) {
-                    logger->error(env, "WaitForMultipleObjects failed: %lu", GetLastError());
-                    env->ReleaseByteArrayElements(buffer, src, JNI_ABORT);
-                    return -1;
-                }
-                continue;
-            }
+        }
 
-            UINT32 framesToWrite = std::min(availableFrames, totalFrames - framesWritten);
-            BYTE* dest;
-            hr = context->renderClient->GetBuffer(framesToWrite, &dest);
-            if (FAILED(hr)) { 
-                logger->error(env, "Failed to get WASAPI output buffer (%s).", fmtHR(hr));
-                return -1;
-            }
+        // No JNI calls are allowed until all critical arrays are released
+        const float* planar[MAX_PLANAR_CHANNELS];
+        UINT32 acquired = 0;
+        for (; acquired < channels; acquired++) {
+            planar[acquired] = (const float*)env->GetPrimitiveArrayCritical(arrays[acquired], nullptr);
+            if (!planar[acquired]) break;
+        }
 
-            UINT32 maxFrames = (length - offset) / context->bytesPerFrame;
-            framesToWrite = std::min(framesToWrite, maxFrames);
-            memcpy(dest, src + offset + framesWritten * context->bytesPerFrame, 
-                framesToWrite * context->bytesPerFrame);
-            
-            hr = context->renderClient->ReleaseBuffer(framesToWrite, 0);
-            if (FAILED(hr)) {
-                logger->error(env, "Failed to release WASAPI output buffer (%s).", fmtHR(hr));
-                return -1;
-            }
-            framesWritten += framesToWrite;
-            context->pendingFrames += framesToWrite;
+        size_t written = 0;
+        if (acquired == channels) {
+            const UINT32 bytesPerFrame = context->bytesPerFrame;
+            written = context->ring.writeWith(count * bytesPerFrame,
+                [&](uint8_t* dst, size_t srcOffset, size_t bytes) {
+                    size_t firstFrame = offset + srcOffset / bytesPerFrame;
+                    const float* shifted[MAX_PLANAR_CHANNELS];
+                    for (UINT32 ch = 0; ch < channels; ch++) {
+                        shifted[ch] = planar[ch] + firstFrame;
+                    }
+                    theko::sound::conversion::planarToInterleaved(
+                        context->sampleType, shifted, channels, bytes / bytesPerFrame, dst, context->dither);
+                });
+        }
+
+        while (acquired > 0) {
+            acquired--;
+            env->ReleasePrimitiveArrayCritical(arrays[acquired], (void*)planar[acquired], JNI_ABORT);
+        }
+        for (UINT32 ch = 0; ch < channels; ch++) {
+            env->DeleteLocalRef(arrays[ch]);
+        }
+
+        if (written == 0 && count > 0) {
+            logger->error(env, "Failed to access sample arrays.");
+            return -1;
         }
 
-        env->ReleaseByteArrayElements(buffer, src, JNI_ABORT);
-        int32_t result = (int32_t)framesWritten * context->bytesPerFrame;
-        if (result != length)
-            logger->trace(env, "Wrote %d bytes of %d.", result, length);
-        return result;
+        size_t writtenFrames = written / context->bytesPerFrame;
+        context->pendingFrames += (UINT32)writtenFrames;
+        return (jint)writtenFrames;
     }
 
     JNIEXPORT jint JNICALL 
     Java_org_theko_sound_backends_wasapi_WASAPISharedOutput_nAvailable
     (JNIEnv* env, jobject obj, jlong ptr) {
-        Logger* logger = LoggerManager::getManager()->getLogger(env, "NATIVE: WASAPISharedOutput.nAvailable");
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPISharedOutput.nAvailable");
         auto context = (OutputContext*)ptr;
         if (!context) {
             logger->info(env, "WASAPI output not opened.");
@@ -724,61 +1380,129 @@ extern "C" {
 
         logNotifierMessages(env, logger, context);
 
-        UINT32 padding = 0;
-        HRESULT hr = context->audioClient->GetCurrentPadding(&padding);
-        if (FAILED(hr)) {
-            logger->error(env, "Failed to get WASAPI output buffer (%s).", fmtHR(hr));
-            env->ThrowNew(ThekoSound_AudioBackendException::getClazz(env), "Failed to get WASAPI output buffer.");
-            return -1;
-        }
-
-        UINT32 availableFrames = context->bufferFrameCount - padding;
-        if (availableFrames > INT_MAX) {
-            logger->debug(env, "WASAPI output buffer overflow.");
+        size_t available = context->ring.availableToWrite();
+        available -= available % context->bytesPerFrame;
+        if (available > INT_MAX) {
+            logger->debug(env, "WASAPI ring buffer overflow.");
             return -1; // overflow
         }
-        return (jint)availableFrames;
+        return (jint)available;
     }
 
     JNIEXPORT jint JNICALL 
     Java_org_theko_sound_backends_wasapi_WASAPISharedOutput_nGetBufferSize
     (JNIEnv* env, jobject obj, jlong ptr) {
-        Logger* logger = LoggerManager::getManager()->getLogger(env, "NATIVE: WASAPISharedOutput.nGetBufferSize");
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPISharedOutput.nGetBufferSize");
         auto context = (OutputContext*)ptr;
         if (!context) {
             logger->info(env, "WASAPI output not opened.");
             return -1;
         }
 
-        return (jint)context->bufferFrameCount;
+        size_t capacity = context->ring.getCapacity();
+        if (capacity > INT_MAX) return -1;
+        return (jint)capacity;
     }
 
     JNIEXPORT jlong JNICALL
     Java_org_theko_sound_backends_wasapi_WASAPISharedOutput_nGetFramePosition
     (JNIEnv* env, jobject obj, jlong ptr) {
-        Logger* logger = LoggerManager::getManager()->getLogger(env, "NATIVE: WASAPISharedOutput.nGetFramePosition");
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPISharedOutput.nGetFramePosition");
         auto context = (OutputContext*)ptr;
         if (!context) {
             logger->info(env, "WASAPI output not opened.");
             return -1;
         }
 
+        if (context->session) {
+            // Frames mixed from this voice, minus the part of the endpoint buffer not yet played
+            UINT64 mixed = context->voice.mixedFrames.load(std::memory_order_relaxed);
+            UINT32 padding = 0;
+            HRESULT hr = context->session->audioClient->GetCurrentPadding(&padding);
+            if (FAILED(hr)) {
+                logger->error(env, "Failed to get WASAPI session padding (%s).", fmtHR(hr));
+                return -1;
+            }
+            return (jlong)(mixed - std::min<UINT64>(mixed, padding));
+        }
+
         UINT64 position = 0;
-        UINT64 qpc = 0;
-        HRESULT hr = context->audioClock->GetPosition(&position, &qpc);
+        HRESULT hr = context->audioClock->GetPosition(&position, nullptr);
 
         if (FAILED(hr)) {
             logger->error(env, "Failed to get WASAPI output position (%s).", fmtHR(hr));
             return -1;
         }
 
-        return (jlong)position;
+        // Device units, usually bytes in shared mode, converted to frames
+        UINT64 frequency = context->clockFrequency;
+        UINT32 sampleRate = context->format->nSamplesPerSec;
+        return (jlong)((position / frequency) * sampleRate + (position % frequency) * sampleRate / frequency);
+    }
+
+    JNIEXPORT jobject JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPISharedOutput_nGetClockBuffer
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPISharedOutput.nGetClockBuffer");
+        auto context = (OutputContext*)ptr;
+        if (!context) {
+            logger->info(env, "WASAPI output not opened.");
+            return nullptr;
+        }
+
+        if (context->session) {
+            logger->debug(env, "Stream clock is not published in endpoint session mode.");
+            return nullptr;
+        }
+
+        // Valid until nClose, the Java side drops it there
+        return env->NewDirectByteBuffer(context->clock.data(), (jlong)ClockSnapshot::size());
+    }
+
+    JNIEXPORT jobject JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPISharedOutput_nGetTelemetryBuffer
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPISharedOutput.nGetTelemetryBuffer");
+        auto context = (OutputContext*)ptr;
+        if (!context) {
+            logger->info(env, "WASAPI output not opened.");
+            return nullptr;
+        }
+
+        if (context->session) {
+            logger->debug(env, "Stream telemetry is not recorded in endpoint session mode.");
+            return nullptr;
+        }
+
+        // Valid until nClose, the Java side drops it there
+        return env->NewDirectByteBuffer(context->telemetry.data(), (jlong)StreamTelemetry::size());
+    }
+
+    JNIEXPORT jboolean JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPISharedOutput_nUpdateClock
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPISharedOutput.nUpdateClock");
+        auto context = (OutputContext*)ptr;
+        if (context && context->session) return JNI_FALSE;
+        if (!context || !context->audioClock) {
+            logger->info(env, "WASAPI output not opened.");
+            return JNI_FALSE;
+        }
+
+        UINT32 padding = 0;
+        HRESULT hr = context->audioClient->GetCurrentPadding(&padding);
+        if (SUCCEEDED(hr)) hr = publishOutputClock(context, padding);
+        if (FAILED(hr)) {
+            logger->warn(env, "Failed to update WASAPI output clock (%s).", fmtHR(hr));
+            return JNI_FALSE;
+        }
+        return JNI_TRUE;
     }
 
     JNIEXPORT jlong JNICALL
     Java_org_theko_sound_backends_wasapi_WASAPISharedOutput_nGetMicrosecondLatency
     (JNIEnv* env, jobject obj, jlong ptr) {
-        Logger* logger = LoggerManager::getManager()->getLogger(env, "NATIVE: WASAPISharedOutput.nGetMicrosecondLatency");
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPISharedOutput.nGetMicrosecondLatency");
         auto context = (OutputContext*)ptr;
         if (!context) {
             logger->info(env, "WASAPI output not opened.");
@@ -786,7 +1510,9 @@ extern "C" {
         }
 
         REFERENCE_TIME latency = 0;
-        HRESULT hr = context->audioClient->GetStreamLatency(&latency);
+        HRESULT hr = context->session
+            ? context->session->audioClient->GetStreamLatency(&latency)
+            : context->audioClient->GetStreamLatency(&latency);
         if (FAILED(hr)) {
             logger->warn(env, "Failed to get WASAPI output latency (%s).", fmtHR(hr));
             env->ThrowNew(ThekoSound_AudioBackendException::getClazz(env), "Failed to get WASAPI output latency.");
@@ -804,10 +1530,22 @@ extern "C" {
         return -1;
     }
 
+    JNIEXPORT jint JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPISharedOutput_nGetPeriodFrames
+    (JNIEnv* env, jobject obj, jlong ptr) {
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPISharedOutput.nGetPeriodFrames");
+        auto context = (OutputContext*)ptr;
+        if (!context) {
+            logger->info(env, "WASAPI output not opened.");
+            return -1;
+        }
+        return context->periodFrames > 0 ? (jint)context->periodFrames : -1;
+    }
+
     JNIEXPORT jobject JNICALL
     Java_org_theko_sound_backends_wasapi_WASAPISharedOutput_nGetCurrentAudioPort
     (JNIEnv* env, jobject obj, jlong ptr) {
-        Logger* logger = LoggerManager::getManager()->getLogger(env, "NATIVE: WASAPISharedOutput.nGetCurrentAudioPort");
+        Logger* logger = NATIVE_LOGGER(env, "NATIVE: WASAPISharedOutput.nGetCurrentAudioPort");
         auto context = (OutputContext*)ptr;
 
         if (!context) {
@@ -18,6 +18,8 @@
 
 #ifdef _WIN32
 #include "helper_utilities.hpp"
+#include "sample_conversion.hpp"
+#include "clock_snapshot.hpp"
 
 #include <windows.h>
 #include <initguid.h>
@@ -156,4 +158,213 @@ static const char* WAVEFORMATEX_toText(WAVEFORMATEX* waveformat) {
 
     return txt.c_str();
 }
+
+/**
+ * Maps a WAVEFORMATEX to the sample type used by the native float conversion.
+ * 24-bit samples in a 32-bit container are written as left-justified 32-bit samples.
+ *
+ * @param waveformat The device format
+ * @return The sample type, or SampleType::UNSUPPORTED if the format cannot be converted to natively
+ */
+static theko::sound::conversion::SampleType getSampleType(const WAVEFORMATEX* waveformat) {
+    using theko::sound::conversion::SampleType;
+    if (!waveformat) return SampleType::UNSUPPORTED;
+
+    bool isFloat = waveformat->wFormatTag == WAVE_FORMAT_IEEE_FLOAT;
+    bool isPcm = waveformat->wFormatTag == WAVE_FORMAT_PCM;
+    if (waveformat->wFormatTag == WAVE_FORMAT_EXTENSIBLE) {
+        const WAVEFORMATEXTENSIBLE* ext = (const WAVEFORMATEXTENSIBLE*)waveformat;
+        isFloat = ext->SubFormat == KSDATAFORMAT_SUBTYPE_IEEE_FLOAT;
+        isPcm = ext->SubFormat == KSDATAFORMAT_SUBTYPE_PCM;
+    }
+
+    if (isFloat && waveformat->wBitsPerSample == 32) return SampleType::FLOAT32;
+    if (!isPcm) return SampleType::UNSUPPORTED;
+    switch (waveformat->wBitsPerSample) {
+        case 16: return SampleType::INT16;
+        case 24: return SampleType::INT24;
+        case 32: return SampleType::INT32;
+        default: return SampleType::UNSUPPORTED;
+    }
+}
+
+/**
+ * Shared-mode engine periods of an endpoint for a stream format, in frames.
+ */
+struct EnginePeriods {
+    UINT32 defaultFrames;
+    UINT32 fundamentalFrames; // Granularity of the supported periods
+    UINT32 minFrames;
+    UINT32 maxFrames;
+};
+
+/**
+ * Queries the shared-mode engine periods through IAudioClient3 (Windows 10 and newer).
+ * The audio client must not be initialized yet.
+ *
+ * @param audioClient The audio client of the endpoint
+ * @param format The format the stream will be opened with
+ * @param periods Receives the periods
+ * @return S_OK on success, E_NOINTERFACE if IAudioClient3 is not available, or the failure of the query
+ */
+static HRESULT getEnginePeriods(IAudioClient* audioClient, const WAVEFORMATEX* format, EnginePeriods* periods) {
+    if (!audioClient || !format || !periods) return E_POINTER;
+
+    IAudioClient3* audioClient3 = nullptr;
+    HRESULT hr = audioClient->QueryInterface(__uuidof(IAudioClient3), (void**)&audioClient3);
+    if (FAILED(hr) || !audioClient3) return FAILED(hr) ? hr : E_NOINTERFACE;
+
+    hr = audioClient3->GetSharedModeEnginePeriod(format,
+        &periods->defaultFrames, &periods->fundamentalFrames, &periods->minFrames, &periods->maxFrames);
+    audioClient3->Release();
+    return hr;
+}
+
+/**
+ * Returns the default speaker layout for a channel count (mono, stereo, quad, 5.1, 7.1),
+ * or 0 if there is none.
+ */
+static DWORD getDefaultChannelMask(WORD channels) {
+    switch (channels) {
+        case 1: return SPEAKER_FRONT_CENTER;
+        case 2: return SPEAKER_FRONT_LEFT | SPEAKER_FRONT_RIGHT;
+        case 4: return SPEAKER_FRONT_LEFT | SPEAKER_FRONT_RIGHT | SPEAKER_BACK_LEFT | SPEAKER_BACK_RIGHT;
+        case 6: return SPEAKER_FRONT_LEFT | SPEAKER_FRONT_RIGHT | SPEAKER_FRONT_CENTER | SPEAKER_LOW_FREQUENCY
+                     | SPEAKER_BACK_LEFT | SPEAKER_BACK_RIGHT;
+        case 8: return SPEAKER_FRONT_LEFT | SPEAKER_FRONT_RIGHT | SPEAKER_FRONT_CENTER | SPEAKER_LOW_FREQUENCY
+                     | SPEAKER_BACK_LEFT | SPEAKER_BACK_RIGHT | SPEAKER_SIDE_LEFT | SPEAKER_SIDE_RIGHT;
+        default: return 0;
+    }
+}
+
+/**
+ * Copies a WAVEFORMATEX, keeping the extensible part if there is one.
+ *
+ * @return The copy, or nullptr if the allocation fails. Caller need to free, using CoTaskMemFree(format)
+ */
+static WAVEFORMATEX* copyFormat(const WAVEFORMATEX* format) {
+    if (!format) return nullptr;
+    size_t size = format->wFormatTag == WAVE_FORMAT_EXTENSIBLE ? sizeof(WAVEFORMATEXTENSIBLE) : sizeof(WAVEFORMATEX);
+    WAVEFORMATEX* copy = (WAVEFORMATEX*)CoTaskMemAlloc(size);
+    if (copy) memcpy(copy, format, size);
+    return copy;
+}
+
+/**
+ * Converts a PCM or IEEE float WAVEFORMATEX to a WAVEFORMATEXTENSIBLE with the same sample layout
+ * and the default speaker layout. Many drivers only accept the extensible form in exclusive mode.
+ *
+ * @return The extensible format, or nullptr if the format cannot be converted or the allocation fails.
+ *         Caller need to free, using CoTaskMemFree(format)
+ */
+static WAVEFORMATEX* toExtensibleFormat(const WAVEFORMATEX* format) {
+    if (!format) return nullptr;
+    if (format->wFormatTag == WAVE_FORMAT_EXTENSIBLE) return copyFormat(format);
+    if (format->wFormatTag != WAVE_FORMAT_PCM && format->wFormatTag != WAVE_FORMAT_IEEE_FLOAT) return nullptr;
+
+    WAVEFORMATEXTENSIBLE* ext = (WAVEFORMATEXTENSIBLE*)CoTaskMemAlloc(sizeof(WAVEFORMATEXTENSIBLE));
+    if (!ext) return nullptr;
+    memset(ext, 0, sizeof(WAVEFORMATEXTENSIBLE));
+
+    ext->Format = *format;
+    ext->Format.wFormatTag = WAVE_FORMAT_EXTENSIBLE;
+    ext->Format.cbSize = sizeof(WAVEFORMATEXTENSIBLE) - sizeof(WAVEFORMATEX);
+    ext->Samples.wValidBitsPerSample = format->wBitsPerSample;
+    ext->dwChannelMask = getDefaultChannelMask(format->nChannels);
+    ext->SubFormat = format->wFormatTag == WAVE_FORMAT_IEEE_FLOAT
+        ? KSDATAFORMAT_SUBTYPE_IEEE_FLOAT : KSDATAFORMAT_SUBTYPE_PCM;
+
+    return (WAVEFORMATEX*)ext;
+}
+
+/**
+ * Checks if the endpoint accepts a format in exclusive mode, either as given
+ * or as WAVEFORMATEXTENSIBLE. Exclusive mode never suggests a closest match.
+ *
+ * @param audioClient The audio client of the endpoint
+ * @param format The requested format
+ * @param accepted Receives the accepted form of the format if it is supported, may be null.
+ *        Caller need to free, using CoTaskMemFree(format)
+ * @return S_OK if the format is supported, AUDCLNT_E_UNSUPPORTED_FORMAT if not, or the failure of the check
+ */
+static HRESULT findExclusiveFormat(IAudioClient* audioClient, const WAVEFORMATEX* format, WAVEFORMATEX** accepted) {
+    if (accepted) *accepted = nullptr;
+    if (!audioClient || !format) return E_POINTER;
+
+    HRESULT hr = audioClient->IsFormatSupported(AUDCLNT_SHAREMODE_EXCLUSIVE, format, nullptr);
+    if (hr == S_OK) {
+        if (accepted && !(*accepted = copyFormat(format))) return E_OUTOFMEMORY;
+        return S_OK;
+    }
+    if (format->wFormatTag == WAVE_FORMAT_EXTENSIBLE) {
+        return hr == S_FALSE ? AUDCLNT_E_UNSUPPORTED_FORMAT : hr;
+    }
+
+    WAVEFORMATEX* ext = toExtensibleFormat(format);
+    if (!ext) return (hr == S_FALSE || SUCCEEDED(hr)) ? AUDCLNT_E_UNSUPPORTED_FORMAT : hr;
+
+    hr = audioClient->IsFormatSupported(AUDCLNT_SHAREMODE_EXCLUSIVE, ext, nullptr);
+    if (hr == S_OK && accepted) {
+        *accepted = ext;
+        return S_OK;
+    }
+    CoTaskMemFree(ext);
+    return hr == S_OK ? S_OK : (hr == S_FALSE ? AUDCLNT_E_UNSUPPORTED_FORMAT : hr);
+}
+
+/**
+ * Reads the format the audio engine runs the endpoint in (PKEY_AudioEngine_DeviceFormat),
+ * which is the native format of the device in most cases.
+ *
+ * @param device The endpoint
+ * @return The device format, or nullptr if it is not available. Caller need to free, using CoTaskMemFree(format)
+ */
+static WAVEFORMATEX* getDeviceFormat(IMMDevice* device) {
+    if (!device) return nullptr;
+
+    IPropertyStore* props = nullptr;
+    HRESULT hr = device->OpenPropertyStore(STGM_READ, &props);
+    if (FAILED(hr) || !props) return nullptr;
+
+    PROPVARIANT value;
+    PropVariantInit(&value);
+    WAVEFORMATEX* format = nullptr;
+    hr = props->GetValue(PKEY_AudioEngine_DeviceFormat, &value);
+    if (SUCCEEDED(hr) && value.vt == VT_BLOB && value.blob.cbSize >= sizeof(WAVEFORMATEX)) {
+        const WAVEFORMATEX* blob = (const WAVEFORMATEX*)value.blob.pBlobData;
+        if (blob->wFormatTag != WAVE_FORMAT_EXTENSIBLE || value.blob.cbSize >= sizeof(WAVEFORMATEXTENSIBLE)) {
+            format = copyFormat(blob);
+        }
+    }
+    PropVariantClear(&value);
+    props->Release();
+
+    return format;
+}
+/**
+ * Reads the stream clock and publishes it, converted to frames, together with
+ * its performance counter time and the fill level of the stream.
+ *
+ * @param clock The IAudioClock of the stream
+ * @param frequency The clock frequency, from IAudioClock::GetFrequency
+ * @param sampleRate The sample rate of the stream
+ * @param latency The stream latency, in 100-ns units
+ * @param bufferedFrames The frames queued in the endpoint and the ring buffer
+ * @param snapshot The snapshot to publish to
+ * @return S_OK, or the error of IAudioClock::GetPosition
+ */
+static HRESULT publishClock(IAudioClock* clock, UINT64 frequency, UINT32 sampleRate,
+                            REFERENCE_TIME latency, UINT64 bufferedFrames, ClockSnapshot* snapshot) {
+    if (!clock || frequency == 0) return E_POINTER;
+
+    UINT64 position = 0, qpc = 0;
+    HRESULT hr = clock->GetPosition(&position, &qpc);
+    if (FAILED(hr)) return hr;
+
+    // Split to avoid overflowing position * sampleRate on long streams
+    UINT64 frames = (position / frequency) * sampleRate + (position % frequency) * sampleRate / frequency;
+    snapshot->publish((int64_t)frames, (int64_t)qpc, (int64_t)position, (int64_t)frequency,
+                      (int64_t)latency, (int64_t)bufferedFrames, (int64_t)sampleRate);
+    return S_OK;
+}
 #endif // _WIN32
\ No newline at end of file
@@ -0,0 +1,178 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Native micro-benchmarks of the backend write path, built and run with `make bench-native`.
+ *
+ * Covers the planar -> interleaved conversion behind the output backends' write
+ * (planarToInterleaved for every device sample type), the shared-session mix
+ * accumulation and the block kernels of NativeAudioKernels. Everything here is
+ * pure C++, so it runs without a JVM or an audio device.
+ *
+ * Results are written as a JSON array, one object per case:
+ *   {"name": ..., "kernels": ..., "frames": ..., "nsPerFrame": ..., "allocsPerOp": ...}
+ * nsPerFrame is the median of several timed rounds. allocsPerOp counts operator new
+ * calls per invocation, the real-time paths are expected to stay at 0.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <atomic>
+#include <algorithm>
+#include <chrono>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "sample_conversion.hpp"
+#include "audio_kernels.hpp"
+
+using namespace theko::sound;
+
+static std::atomic<uint64_t> allocations{0};
+
+void* operator new(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = malloc(size ? size : 1)) return p;
+    abort();
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    free(p);
+}
+
+static constexpr size_t FRAMES = 2048;
+static constexpr uint32_t CHANNELS = 2;
+static constexpr int ROUNDS = 15;
+static constexpr double ROUND_SECONDS = 0.02;
+
+struct Result {
+    std::string name;
+    const char* kernels;
+    double nsPerFrame;
+    double allocsPerOp;
+};
+
+static volatile double sink = 0.0;
+
+template <typename Fn>
+static Result run(const char* name, const char* kernels, Fn&& fn) {
+    using clock = std::chrono::steady_clock;
+
+    // Calibrate the invocations per round, this also warms up caches and branch predictors
+    uint64_t invocations = 1;
+    for (;;) {
+        auto start = clock::now();
+        for (uint64_t i = 0; i < invocations; i++) fn();
+        double seconds = std::chrono::duration<double>(clock::now() - start).count();
+        if (seconds >= ROUND_SECONDS || invocations >= (1ull << 30)) break;
+        invocations *= 2;
+    }
+
+    std::vector<double> rounds(ROUNDS); // Allocated before counting
+    uint64_t allocsBefore = allocations.load(std::memory_order_relaxed);
+    for (int r = 0; r < ROUNDS; r++) {
+        auto start = clock::now();
+        for (uint64_t i = 0; i < invocations; i++) fn();
+        double ns = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+        rounds[r] = ns / ((double)invocations * FRAMES);
+    }
+    uint64_t allocs = allocations.load(std::memory_order_relaxed) - allocsBefore;
+
+    std::sort(rounds.begin(), rounds.end());
+    return { name, kernels, rounds[ROUNDS / 2], (double)allocs / ((double)invocations * ROUNDS) };
+}
+
+static void fillNoise(float* dst, size_t n, uint32_t seed) {
+    for (size_t i = 0; i < n; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        dst[i] = (float)((seed >> 8) * (1.0 / 16777216.0)) - 0.5f;
+    }
+}
+
+int main(int argc, char** argv) {
+    const char* outPath = argc > 1 ? argv[1] : nullptr;
+
+    std::vector<float> left(FRAMES), right(FRAMES), mix(FRAMES);
+    fillNoise(left.data(), FRAMES, 1);
+    fillNoise(right.data(), FRAMES, 2);
+    const float* planar[CHANNELS] = { left.data(), right.data() };
+    std::vector<uint8_t> device(FRAMES * CHANNELS * 4);
+    conversion::DitherState dither;
+
+    const conversion::ConversionKernels& ck = conversion::getConversionKernels();
+    const kernels::BlockKernels& bk = kernels::getBlockKernels();
+
+    std::vector<Result> results;
+
+    // Output write path: planar float -> interleaved device buffer
+    struct { const char* name; conversion::SampleType type; } types[] = {
+        { "write.planarToInterleaved.int16", conversion::SampleType::INT16 },
+        { "write.planarToInterleaved.int24", conversion::SampleType::INT24 },
+        { "write.planarToInterleaved.int32", conversion::SampleType::INT32 },
+        { "write.planarToInterleaved.float32", conversion::SampleType::FLOAT32 },
+    };
+    for (auto& t : types) {
+        results.push_back(run(t.name, ck.name, [&]() {
+            conversion::planarToInterleaved(t.type, planar, CHANNELS, FRAMES, device.data(), dither);
+        }));
+    }
+
+    // Shared session: accumulate one stream into the endpoint mix
+    results.push_back(run("write.sharedMixAdd", ck.name, [&]() {
+        ck.mixAdd(mix.data(), left.data(), FRAMES);
+    }));
+
+    // NativeAudioKernels
+    results.push_back(run("kernels.mixAdd", bk.name, [&]() {
+        bk.mixAdd(left.data(), mix.data(), FRAMES, 0.5f);
+    }));
+    results.push_back(run("kernels.scale", bk.name, [&]() {
+        bk.scale(left.data(), mix.data(), FRAMES, 0.5f);
+    }));
+    results.push_back(run("kernels.peak", bk.name, [&]() {
+        sink = sink + bk.peak(left.data(), FRAMES);
+    }));
+    results.push_back(run("kernels.sumSquares", bk.name, [&]() {
+        sink = sink + bk.sumSquares(left.data(), FRAMES);
+    }));
+    results.push_back(run("kernels.sumAbs", bk.name, [&]() {
+        sink = sink + bk.sumAbs(left.data(), FRAMES);
+    }));
+
+    FILE* out = outPath ? fopen(outPath, "w") : stdout;
+    if (!out) {
+        fprintf(stderr, "Cannot open %s\n", outPath);
+        return 1;
+    }
+    fprintf(out, "[\n");
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result& r = results[i];
+        fprintf(out, "  {\"name\": \"%s\", \"kernels\": \"%s\", \"frames\": %zu, \"nsPerFrame\": %.4f, \"allocsPerOp\": %.4f}%s\n",
+                r.name.c_str(), r.kernels, FRAMES, r.nsPerFrame, r.allocsPerOp, i + 1 < results.size() ? "," : "");
+    }
+    fprintf(out, "]\n");
+    if (out != stdout) {
+        fclose(out);
+        fprintf(stderr, "Wrote %zu results to %s\n", results.size(), outPath);
+    }
+    return 0;
+}
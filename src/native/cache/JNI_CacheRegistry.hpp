@@ -0,0 +1,66 @@
+/*
+ * DO NOT EDIT THIS FILE - it is machine generated.
+ * Eager initialization of all JNI class caches.
+ */
+#pragma once
+#include <jni.h>
+#include "cache/Java_IllegalArgumentException.hpp"
+#include "cache/Java_RuntimeException.hpp"
+#include "cache/Java_Concurrent_AtomicReference.hpp"
+#include "cache/SLF4J_Logger.hpp"
+#include "cache/SLF4J_LoggerFactory.hpp"
+#include "cache/ThekoSound_AudioFlow.hpp"
+#include "cache/ThekoSound_AudioFormat.hpp"
+#include "cache/ThekoSound_AudioFormat_Encoding.hpp"
+#include "cache/ThekoSound_AudioPort.hpp"
+#include "cache/ThekoSound_UnsupportedAudioEncodingException.hpp"
+#include "cache/ThekoSound_UnsupportedAudioFormatException.hpp"
+#include "cache/ThekoSound_AudioBackendException.hpp"
+#include "cache/ThekoSound_AudioRenderCallback.hpp"
+#include "cache/ThekoSound_DeviceInactiveException.hpp"
+#include "cache/ThekoSound_DeviceInvalidatedException.hpp"
+#include "cache/ThekoSound_PortNotFoundException.hpp"
+#include "cache/ThekoSound_WASAPIPortHandle.hpp"
+#include "cache/ThekoSound_PulseAudioPortHandle.hpp"
+
+// Returns the number of caches that failed to initialize; those stay lazy
+static inline int initJNICaches(JNIEnv* env) {
+    int failed = 0;
+    if (!Java_IllegalArgumentException::init(env)) failed++;
+    if (env->ExceptionCheck()) env->ExceptionClear();
+    if (!Java_RuntimeException::init(env)) failed++;
+    if (env->ExceptionCheck()) env->ExceptionClear();
+    if (!Java_Concurrent_AtomicReference::init(env)) failed++;
+    if (env->ExceptionCheck()) env->ExceptionClear();
+    if (!SLF4J_Logger::init(env)) failed++;
+    if (env->ExceptionCheck()) env->ExceptionClear();
+    if (!SLF4J_LoggerFactory::init(env)) failed++;
+    if (env->ExceptionCheck()) env->ExceptionClear();
+    if (!ThekoSound_AudioFlow::init(env)) failed++;
+    if (env->ExceptionCheck()) env->ExceptionClear();
+    if (!ThekoSound_AudioFormat::init(env)) failed++;
+    if (env->ExceptionCheck()) env->ExceptionClear();
+    if (!ThekoSound_AudioFormat_Encoding::init(env)) failed++;
+    if (env->ExceptionCheck()) env->ExceptionClear();
+    if (!ThekoSound_AudioPort::init(env)) failed++;
+    if (env->ExceptionCheck()) env->ExceptionClear();
+    if (!ThekoSound_UnsupportedAudioEncodingException::init(env)) failed++;
+    if (env->ExceptionCheck()) env->ExceptionClear();
+    if (!ThekoSound_UnsupportedAudioFormatException::init(env)) failed++;
+    if (env->ExceptionCheck()) env->ExceptionClear();
+    if (!ThekoSound_AudioBackendException::init(env)) failed++;
+    if (env->ExceptionCheck()) env->ExceptionClear();
+    if (!ThekoSound_AudioRenderCallback::init(env)) failed++;
+    if (env->ExceptionCheck()) env->ExceptionClear();
+    if (!ThekoSound_DeviceInactiveException::init(env)) failed++;
+    if (env->ExceptionCheck()) env->ExceptionClear();
+    if (!ThekoSound_DeviceInvalidatedException::init(env)) failed++;
+    if (env->ExceptionCheck()) env->ExceptionClear();
+    if (!ThekoSound_PortNotFoundException::init(env)) failed++;
+    if (env->ExceptionCheck()) env->ExceptionClear();
+    if (!ThekoSound_WASAPIPortHandle::init(env)) failed++;
+    if (env->ExceptionCheck()) env->ExceptionClear();
+    if (!ThekoSound_PulseAudioPortHandle::init(env)) failed++;
+    if (env->ExceptionCheck()) env->ExceptionClear();
+    return failed;
+}
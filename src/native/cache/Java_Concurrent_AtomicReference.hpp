@@ -6,6 +6,7 @@
 #include <jni.h>
 #include <mutex>
 #include <memory>
+#include <atomic>
 
 // Target class: java/util/concurrent/atomic/AtomicReference
 class Java_Concurrent_AtomicReference {
@@ -30,7 +31,7 @@ class Java_Concurrent_AtomicReference {
         bool initialized = false; // True if all values are initialized
 
         // jclass cache
-        jclass clazz;
+        jclass clazz = nullptr;
         // jfieldID cache
         // private java.lang.invoke.VarHandle java.util.concurrent.atomic.AtomicReference.VALUE
         jfieldID fld__VALUE;
@@ -320,21 +321,40 @@ class Java_Concurrent_AtomicReference {
             return clazz && initialized;
         }
 
+        // Published once the cache is valid, read without locking
+        static inline std::atomic<Java_Concurrent_AtomicReference*> published{nullptr};
+
         static Java_Concurrent_AtomicReference* get(JNIEnv* env) {
+            Java_Concurrent_AtomicReference* self = published.load(std::memory_order_acquire);
+            if (self) return self;
+            return getLocked(env);
+        }
+
+        // Lazy fallback, used until init(env) or the first access succeeds
+        static Java_Concurrent_AtomicReference* getLocked(JNIEnv* env) {
             if (!env) return nullptr;
             static std::mutex mtx;
             static std::unique_ptr<Java_Concurrent_AtomicReference> instance;
-        
+
             std::lock_guard<std::mutex> lock(mtx);
             if (!Java_Concurrent_AtomicReference::jvm) {
                 env->GetJavaVM(&Java_Concurrent_AtomicReference::jvm);
             }
             if (!instance || !instance->isValid()) {
                 instance.reset(new Java_Concurrent_AtomicReference(env));
+                if (instance->isValid()) {
+                    published.store(instance.get(), std::memory_order_release);
+                }
             }
             return instance.get();
         }
 
+        // Creates the cache eagerly, e.g. from JNI_OnLoad
+        static bool init(JNIEnv* env) {
+            Java_Concurrent_AtomicReference* self = get(env);
+            return self && self->isValid();
+        }
+
         // Getters
         inline static jclass getClazz(JNIEnv* env) {
             return get(env)->clazz;
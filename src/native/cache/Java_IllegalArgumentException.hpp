@@ -6,6 +6,7 @@
 #include <jni.h>
 #include <mutex>
 #include <memory>
+#include <atomic>
 
 // Target class: java/lang/IllegalArgumentException
 class Java_IllegalArgumentException {
@@ -30,7 +31,7 @@ class Java_IllegalArgumentException {
         bool initialized = false; // True if all values are initialized
 
         // jclass cache
-        jclass clazz;
+        jclass clazz = nullptr;
         // jfieldID cache
         // private long java.lang.IllegalArgumentException.serialVersionUID
         jfieldID fld__serialVersionUID;
@@ -144,21 +145,40 @@ class Java_IllegalArgumentException {
             return clazz && initialized;
         }
 
+        // Published once the cache is valid, read without locking
+        static inline std::atomic<Java_IllegalArgumentException*> published{nullptr};
+
         static Java_IllegalArgumentException* get(JNIEnv* env) {
+            Java_IllegalArgumentException* self = published.load(std::memory_order_acquire);
+            if (self) return self;
+            return getLocked(env);
+        }
+
+        // Lazy fallback, used until init(env) or the first access succeeds
+        static Java_IllegalArgumentException* getLocked(JNIEnv* env) {
             if (!env) return nullptr;
             static std::mutex mtx;
             static std::unique_ptr<Java_IllegalArgumentException> instance;
-        
+
             std::lock_guard<std::mutex> lock(mtx);
             if (!Java_IllegalArgumentException::jvm) {
                 env->GetJavaVM(&Java_IllegalArgumentException::jvm);
             }
             if (!instance || !instance->isValid()) {
                 instance.reset(new Java_IllegalArgumentException(env));
+                if (instance->isValid()) {
+                    published.store(instance.get(), std::memory_order_release);
+                }
             }
             return instance.get();
         }
 
+        // Creates the cache eagerly, e.g. from JNI_OnLoad
+        static bool init(JNIEnv* env) {
+            Java_IllegalArgumentException* self = get(env);
+            return self && self->isValid();
+        }
+
         // Getters
         inline static jclass getClazz(JNIEnv* env) {
             return get(env)->clazz;
@@ -6,6 +6,7 @@
 #include <jni.h>
 #include <mutex>
 #include <memory>
+#include <atomic>
 
 // Target class: java/lang/RuntimeException
 class Java_RuntimeException {
@@ -30,7 +31,7 @@ class Java_RuntimeException {
         bool initialized = false; // True if all values are initialized
 
         // jclass cache
-        jclass clazz;
+        jclass clazz = nullptr;
         // jfieldID cache
         // package-private long java.lang.RuntimeException.serialVersionUID
         jfieldID fld__serialVersionUID;
@@ -152,21 +153,40 @@ class Java_RuntimeException {
             return clazz && initialized;
         }
 
+        // Published once the cache is valid, read without locking
+        static inline std::atomic<Java_RuntimeException*> published{nullptr};
+
         static Java_RuntimeException* get(JNIEnv* env) {
+            Java_RuntimeException* self = published.load(std::memory_order_acquire);
+            if (self) return self;
+            return getLocked(env);
+        }
+
+        // Lazy fallback, used until init(env) or the first access succeeds
+        static Java_RuntimeException* getLocked(JNIEnv* env) {
             if (!env) return nullptr;
             static std::mutex mtx;
             static std::unique_ptr<Java_RuntimeException> instance;
-        
+
             std::lock_guard<std::mutex> lock(mtx);
             if (!Java_RuntimeException::jvm) {
                 env->GetJavaVM(&Java_RuntimeException::jvm);
             }
             if (!instance || !instance->isValid()) {
                 instance.reset(new Java_RuntimeException(env));
+                if (instance->isValid()) {
+                    published.store(instance.get(), std::memory_order_release);
+                }
             }
             return instance.get();
         }
 
+        // Creates the cache eagerly, e.g. from JNI_OnLoad
+        static bool init(JNIEnv* env) {
+            Java_RuntimeException* self = get(env);
+            return self && self->isValid();
+        }
+
         // Getters
         inline static jclass getClazz(JNIEnv* env) {
             return get(env)->clazz;
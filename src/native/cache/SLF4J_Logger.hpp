@@ -6,6 +6,7 @@
 #include <jni.h>
 #include <mutex>
 #include <memory>
+#include <atomic>
 
 // Target class: org/slf4j/Logger
 class SLF4J_Logger {
@@ -30,7 +31,7 @@ class SLF4J_Logger {
         bool initialized = false; // True if all values are initialized
 
         // jclass cache
-        jclass clazz;
+        jclass clazz = nullptr;
         // jfieldID cache
         // public java.lang.String org.slf4j.Logger.ROOT_LOGGER_NAME
         jfieldID fld__ROOT_LOGGER_NAME;
@@ -636,21 +637,40 @@ class SLF4J_Logger {
             return clazz && initialized;
         }
 
+        // Published once the cache is valid, read without locking
+        static inline std::atomic<SLF4J_Logger*> published{nullptr};
+
         static SLF4J_Logger* get(JNIEnv* env) {
+            SLF4J_Logger* self = published.load(std::memory_order_acquire);
+            if (self) return self;
+            return getLocked(env);
+        }
+
+        // Lazy fallback, used until init(env) or the first access succeeds
+        static SLF4J_Logger* getLocked(JNIEnv* env) {
             if (!env) return nullptr;
             static std::mutex mtx;
             static std::unique_ptr<SLF4J_Logger> instance;
-        
+
             std::lock_guard<std::mutex> lock(mtx);
             if (!SLF4J_Logger::jvm) {
                 env->GetJavaVM(&SLF4J_Logger::jvm);
             }
             if (!instance || !instance->isValid()) {
                 instance.reset(new SLF4J_Logger(env));
+                if (instance->isValid()) {
+                    published.store(instance.get(), std::memory_order_release);
+                }
             }
             return instance.get();
         }
 
+        // Creates the cache eagerly, e.g. from JNI_OnLoad
+        static bool init(JNIEnv* env) {
+            SLF4J_Logger* self = get(env);
+            return self && self->isValid();
+        }
+
         // Getters
         inline static jclass getClazz(JNIEnv* env) {
             return get(env)->clazz;
@@ -6,6 +6,7 @@
 #include <jni.h>
 #include <mutex>
 #include <memory>
+#include <atomic>
 
 // Target class: org/slf4j/LoggerFactory
 class SLF4J_LoggerFactory {
@@ -30,7 +31,7 @@ class SLF4J_LoggerFactory {
         bool initialized = false; // True if all values are initialized
 
         // jclass cache
-        jclass clazz;
+        jclass clazz = nullptr;
         // jfieldID cache
         // private java.lang.String[] org.slf4j.LoggerFactory.API_COMPATIBILITY_LIST
         jfieldID fld__API_COMPATIBILITY_LIST;
@@ -320,21 +321,40 @@ class SLF4J_LoggerFactory {
             return clazz && initialized;
         }
 
+        // Published once the cache is valid, read without locking
+        static inline std::atomic<SLF4J_LoggerFactory*> published{nullptr};
+
         static SLF4J_LoggerFactory* get(JNIEnv* env) {
+            SLF4J_LoggerFactory* self = published.load(std::memory_order_acquire);
+            if (self) return self;
+            return getLocked(env);
+        }
+
+        // Lazy fallback, used until init(env) or the first access succeeds
+        static SLF4J_LoggerFactory* getLocked(JNIEnv* env) {
             if (!env) return nullptr;
             static std::mutex mtx;
             static std::unique_ptr<SLF4J_LoggerFactory> instance;
-        
+
             std::lock_guard<std::mutex> lock(mtx);
             if (!SLF4J_LoggerFactory::jvm) {
                 env->GetJavaVM(&SLF4J_LoggerFactory::jvm);
             }
             if (!instance || !instance->isValid()) {
                 instance.reset(new SLF4J_LoggerFactory(env));
+                if (instance->isValid()) {
+                    published.store(instance.get(), std::memory_order_release);
+                }
             }
             return instance.get();
         }
 
+        // Creates the cache eagerly, e.g. from JNI_OnLoad
+        static bool init(JNIEnv* env) {
+            SLF4J_LoggerFactory* self = get(env);
+            return self && self->isValid();
+        }
+
         // Getters
         inline static jclass getClazz(JNIEnv* env) {
             return get(env)->clazz;
@@ -6,6 +6,7 @@
 #include <jni.h>
 #include <mutex>
 #include <memory>
+#include <atomic>
 
 // Target class: org/theko/sound/AudioFlow
 class ThekoSound_AudioFlow {
@@ -30,7 +31,7 @@ class ThekoSound_AudioFlow {
         bool initialized = false; // True if all values are initialized
 
         // jclass cache
-        jclass clazz;
+        jclass clazz = nullptr;
         // jfieldID cache
         // public org.theko.sound.AudioFlow org.theko.sound.AudioFlow.IN
         jfieldID fld__IN;
@@ -136,21 +137,40 @@ class ThekoSound_AudioFlow {
             return clazz && initialized;
         }
 
+        // Published once the cache is valid, read without locking
+        static inline std::atomic<ThekoSound_AudioFlow*> published{nullptr};
+
         static ThekoSound_AudioFlow* get(JNIEnv* env) {
+            ThekoSound_AudioFlow* self = published.load(std::memory_order_acquire);
+            if (self) return self;
+            return getLocked(env);
+        }
+
+        // Lazy fallback, used until init(env) or the first access succeeds
+        static ThekoSound_AudioFlow* getLocked(JNIEnv* env) {
             if (!env) return nullptr;
             static std::mutex mtx;
             static std::unique_ptr<ThekoSound_AudioFlow> instance;
-        
+
             std::lock_guard<std::mutex> lock(mtx);
             if (!ThekoSound_AudioFlow::jvm) {
                 env->GetJavaVM(&ThekoSound_AudioFlow::jvm);
             }
             if (!instance || !instance->isValid()) {
                 instance.reset(new ThekoSound_AudioFlow(env));
+                if (instance->isValid()) {
+                    published.store(instance.get(), std::memory_order_release);
+                }
             }
             return instance.get();
         }
 
+        // Creates the cache eagerly, e.g. from JNI_OnLoad
+        static bool init(JNIEnv* env) {
+            ThekoSound_AudioFlow* self = get(env);
+            return self && self->isValid();
+        }
+
         // Getters
         inline static jclass getClazz(JNIEnv* env) {
             return get(env)->clazz;
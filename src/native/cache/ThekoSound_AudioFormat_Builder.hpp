@@ -6,6 +6,7 @@
 #include <jni.h>
 #include <mutex>
 #include <memory>
+#include <atomic>
 
 // Target class: org/theko/sound/AudioFormat$Builder
 class ThekoSound_AudioFormat_Builder {
@@ -30,7 +31,7 @@ class ThekoSound_AudioFormat_Builder {
         bool initialized = false; // True if all values are initialized
 
         // jclass cache
-        jclass clazz;
+        jclass clazz = nullptr;
         // jfieldID cache
         // private boolean org.theko.sound.AudioFormat.Builder.bigEndian
         jfieldID fld__bigEndian;
@@ -256,21 +257,40 @@ class ThekoSound_AudioFormat_Builder {
             return clazz && initialized;
         }
 
+        // Published once the cache is valid, read without locking
+        static inline std::atomic<ThekoSound_AudioFormat_Builder*> published{nullptr};
+
         static ThekoSound_AudioFormat_Builder* get(JNIEnv* env) {
+            ThekoSound_AudioFormat_Builder* self = published.load(std::memory_order_acquire);
+            if (self) return self;
+            return getLocked(env);
+        }
+
+        // Lazy fallback, used until init(env) or the first access succeeds
+        static ThekoSound_AudioFormat_Builder* getLocked(JNIEnv* env) {
             if (!env) return nullptr;
             static std::mutex mtx;
             static std::unique_ptr<ThekoSound_AudioFormat_Builder> instance;
-        
+
             std::lock_guard<std::mutex> lock(mtx);
             if (!ThekoSound_AudioFormat_Builder::jvm) {
                 env->GetJavaVM(&ThekoSound_AudioFormat_Builder::jvm);
             }
             if (!instance || !instance->isValid()) {
                 instance.reset(new ThekoSound_AudioFormat_Builder(env));
+                if (instance->isValid()) {
+                    published.store(instance.get(), std::memory_order_release);
+                }
             }
             return instance.get();
         }
 
+        // Creates the cache eagerly, e.g. from JNI_OnLoad
+        static bool init(JNIEnv* env) {
+            ThekoSound_AudioFormat_Builder* self = get(env);
+            return self && self->isValid();
+        }
+
         // Getters
         inline static jclass getClazz(JNIEnv* env) {
             return get(env)->clazz;
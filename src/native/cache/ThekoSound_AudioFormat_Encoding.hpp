@@ -6,6 +6,7 @@
 #include <jni.h>
 #include <mutex>
 #include <memory>
+#include <atomic>
 
 // Target class: org/theko/sound/AudioFormat$Encoding
 class ThekoSound_AudioFormat_Encoding {
@@ -30,7 +31,7 @@ class ThekoSound_AudioFormat_Encoding {
         bool initialized = false; // True if all values are initialized
 
         // jclass cache
-        jclass clazz;
+        jclass clazz = nullptr;
         // jfieldID cache
         // public org.theko.sound.AudioFormat.Encoding org.theko.sound.AudioFormat.Encoding.ALAW
         jfieldID fld__ALAW;
@@ -144,21 +145,40 @@ class ThekoSound_AudioFormat_Encoding {
             return clazz && initialized;
         }
 
+        // Published once the cache is valid, read without locking
+        static inline std::atomic<ThekoSound_AudioFormat_Encoding*> published{nullptr};
+
         static ThekoSound_AudioFormat_Encoding* get(JNIEnv* env) {
+            ThekoSound_AudioFormat_Encoding* self = published.load(std::memory_order_acquire);
+            if (self) return self;
+            return getLocked(env);
+        }
+
+        // Lazy fallback, used until init(env) or the first access succeeds
+        static ThekoSound_AudioFormat_Encoding* getLocked(JNIEnv* env) {
             if (!env) return nullptr;
             static std::mutex mtx;
             static std::unique_ptr<ThekoSound_AudioFormat_Encoding> instance;
-        
+
             std::lock_guard<std::mutex> lock(mtx);
             if (!ThekoSound_AudioFormat_Encoding::jvm) {
                 env->GetJavaVM(&ThekoSound_AudioFormat_Encoding::jvm);
             }
             if (!instance || !instance->isValid()) {
                 instance.reset(new ThekoSound_AudioFormat_Encoding(env));
+                if (instance->isValid()) {
+                    published.store(instance.get(), std::memory_order_release);
+                }
             }
             return instance.get();
         }
 
+        // Creates the cache eagerly, e.g. from JNI_OnLoad
+        static bool init(JNIEnv* env) {
+            ThekoSound_AudioFormat_Encoding* self = get(env);
+            return self && self->isValid();
+        }
+
         // Getters
         inline static jclass getClazz(JNIEnv* env) {
             return get(env)->clazz;
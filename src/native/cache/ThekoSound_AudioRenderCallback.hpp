@@ -0,0 +1,172 @@
+/*
+ * DO NOT EDIT THIS FILE - it is machine generated.
+ * JNI single-header class with wrappers and caching for 'org.theko.sound.backends.AudioRenderCallback'.
+ */
+#pragma once
+#include <jni.h>
+#include <mutex>
+#include <memory>
+#include <atomic>
+
+// Target class: org/theko/sound/backends/AudioRenderCallback
+class ThekoSound_AudioRenderCallback {
+    private:
+        static inline JavaVM* jvm = nullptr;
+
+        // Method to get JNIEnv for current thread
+        static JNIEnv* getEnv(bool* attached = nullptr) {
+            if (!jvm) return nullptr;
+            JNIEnv* env = nullptr;
+            if (jvm->GetEnv((void**)&env, JNI_VERSION_1_6) == JNI_OK) {
+                if (attached) *attached = false;
+                return env;
+            }
+            if (jvm->AttachCurrentThread((void**)&env, nullptr) != JNI_OK) {
+                return nullptr;
+            }
+            if (attached) *attached = true;
+            return env;
+        }
+
+        bool initialized = false; // True if all values are initialized
+
+        // jclass cache
+        jclass clazz = nullptr;
+        // jmethodID cache
+        // public void org.theko.sound.backends.AudioRenderCallback.onDeviceInvalidated()
+        jmethodID mtd__onDeviceInvalidated;
+        // public int org.theko.sound.backends.AudioRenderCallback.render(byte[], int, int)
+        jmethodID mtd__render_ArrayOf_byte__int__int;
+
+        ThekoSound_AudioRenderCallback(JNIEnv* env) {
+            initialized = false; // Reinitialize
+            if (!env) return;
+            jclass clazz_local = env->FindClass("org/theko/sound/backends/AudioRenderCallback");
+            if (!clazz_local) {
+                env->ThrowNew(env->FindClass("java/lang/RuntimeException"), "Failed to find class 'org/theko/sound/backends/AudioRenderCallback'");
+                return;
+            }
+
+            // Methods
+            mtd__onDeviceInvalidated = env->GetMethodID(clazz_local, "onDeviceInvalidated", "()V");
+            if (!mtd__onDeviceInvalidated) {
+                if (clazz_local) env->DeleteLocalRef(clazz_local);
+                env->ThrowNew(env->FindClass("java/lang/NullPointerException"), "Failed to get method 'onDeviceInvalidated'");
+                return;
+            }
+            mtd__render_ArrayOf_byte__int__int = env->GetMethodID(clazz_local, "render", "([BII)I");
+            if (!mtd__render_ArrayOf_byte__int__int) {
+                if (clazz_local) env->DeleteLocalRef(clazz_local);
+                env->ThrowNew(env->FindClass("java/lang/NullPointerException"), "Failed to get method 'render'");
+                return;
+            }
+
+            clazz = (jclass) env->NewGlobalRef(clazz_local);
+            env->DeleteLocalRef(clazz_local);
+            if (!clazz) {
+                env->ThrowNew(env->FindClass("java/lang/RuntimeException"), "Failed to create global class reference");
+                return;
+            }
+            initialized = true;
+        }
+
+    public:
+        ~ThekoSound_AudioRenderCallback() {
+            if (clazz) {
+                bool attached = false;
+                JNIEnv* env = getEnv(&attached);
+                if (env) {
+                    env->DeleteGlobalRef(clazz);
+                    clazz = nullptr;
+                }
+                if (attached && jvm) {
+                    jvm->DetachCurrentThread();
+                }
+            }
+        }
+
+        inline bool isValid() const {
+            return clazz && initialized;
+        }
+
+        // Published once the cache is valid, read without locking
+        static inline std::atomic<ThekoSound_AudioRenderCallback*> published{nullptr};
+
+        static ThekoSound_AudioRenderCallback* get(JNIEnv* env) {
+            ThekoSound_AudioRenderCallback* self = published.load(std::memory_order_acquire);
+            if (self) return self;
+            return getLocked(env);
+        }
+
+        // Lazy fallback, used until init(env) or the first access succeeds
+        static ThekoSound_AudioRenderCallback* getLocked(JNIEnv* env) {
+            if (!env) return nullptr;
+            static std::mutex mtx;
+            static std::unique_ptr<ThekoSound_AudioRenderCallback> instance;
+
+            std::lock_guard<std::mutex> lock(mtx);
+            if (!ThekoSound_AudioRenderCallback::jvm) {
+                env->GetJavaVM(&ThekoSound_AudioRenderCallback::jvm);
+            }
+            if (!instance || !instance->isValid()) {
+                instance.reset(new ThekoSound_AudioRenderCallback(env));
+                if (instance->isValid()) {
+                    published.store(instance.get(), std::memory_order_release);
+                }
+            }
+            return instance.get();
+        }
+
+        // Creates the cache eagerly, e.g. from JNI_OnLoad
+        static bool init(JNIEnv* env) {
+            ThekoSound_AudioRenderCallback* self = get(env);
+            return self && self->isValid();
+        }
+
+        // Getters
+        inline static jclass getClazz(JNIEnv* env) {
+            return get(env)->clazz;
+        }
+
+        // Method getters
+        inline static jmethodID getmtd__onDeviceInvalidated(JNIEnv* env) {
+            ThekoSound_AudioRenderCallback* self = get(env);
+            if (!self || !self->isValid()) return nullptr;
+            return self->mtd__onDeviceInvalidated;
+        }
+        inline static jmethodID getmtd__render_ArrayOf_byte__int__int(JNIEnv* env) {
+            ThekoSound_AudioRenderCallback* self = get(env);
+            if (!self || !self->isValid()) return nullptr;
+            return self->mtd__render_ArrayOf_byte__int__int;
+        }
+        // Method wrappers
+        // Fabric method for public default void org.theko.sound.backends.AudioRenderCallback.onDeviceInvalidated()
+        inline static void onDeviceInvalidated(JNIEnv* env, jobject obj) {
+            ThekoSound_AudioRenderCallback* self = get(env);
+            if (!self || !self->isValid()) return;
+            jmethodID mtd = self->mtd__onDeviceInvalidated;
+            if (!mtd) return;
+            env->CallVoidMethod(obj, mtd);
+            if (env->ExceptionCheck()) {
+                env->ExceptionDescribe();
+                env->ExceptionClear();
+            }
+        }
+
+        // Fabric method for public abstract int org.theko.sound.backends.AudioRenderCallback.render(byte[],int,int)
+        inline static jint render(JNIEnv* env, jobject obj, jbyteArray v0, jint v1, jint v2) {
+            ThekoSound_AudioRenderCallback* self = get(env);
+            if (!self || !self->isValid()) return (jint)0;
+            jmethodID mtd = self->mtd__render_ArrayOf_byte__int__int;
+            if (!mtd) return (jint)0;
+            jint ret = env->CallIntMethod(obj, mtd, v0, v1, v2);
+            if (env->ExceptionCheck()) {
+                env->ExceptionDescribe();
+                env->ExceptionClear();
+                return (jint)0;
+            }
+            return ret;
+        }
+
+    // End of class declaration
+};
@@ -6,6 +6,7 @@
 #include <jni.h>
 #include <mutex>
 #include <memory>
+#include <atomic>
 
 // Target class: org/theko/sound/backends/PortNotFoundException
 class ThekoSound_PortNotFoundException {
@@ -30,7 +31,7 @@ class ThekoSound_PortNotFoundException {
         bool initialized = false; // True if all values are initialized
 
         // jclass cache
-        jclass clazz;
+        jclass clazz = nullptr;
         // jmethodID constructor cache
         // public org.theko.sound.backends.PortNotFoundException()
         jmethodID ctor__;
@@ -132,21 +133,40 @@ class ThekoSound_PortNotFoundException {
             return clazz && initialized;
         }
 
+        // Published once the cache is valid, read without locking
+        static inline std::atomic<ThekoSound_PortNotFoundException*> published{nullptr};
+
         static ThekoSound_PortNotFoundException* get(JNIEnv* env) {
+            ThekoSound_PortNotFoundException* self = published.load(std::memory_order_acquire);
+            if (self) return self;
+            return getLocked(env);
+        }
+
+        // Lazy fallback, used until init(env) or the first access succeeds
+        static ThekoSound_PortNotFoundException* getLocked(JNIEnv* env) {
             if (!env) return nullptr;
             static std::mutex mtx;
             static std::unique_ptr<ThekoSound_PortNotFoundException> instance;
-        
+
             std::lock_guard<std::mutex> lock(mtx);
             if (!ThekoSound_PortNotFoundException::jvm) {
                 env->GetJavaVM(&ThekoSound_PortNotFoundException::jvm);
             }
             if (!instance || !instance->isValid()) {
                 instance.reset(new ThekoSound_PortNotFoundException(env));
+                if (instance->isValid()) {
+                    published.store(instance.get(), std::memory_order_release);
+                }
             }
             return instance.get();
         }
 
+        // Creates the cache eagerly, e.g. from JNI_OnLoad
+        static bool init(JNIEnv* env) {
+            ThekoSound_PortNotFoundException* self = get(env);
+            return self && self->isValid();
+        }
+
         // Getters
         inline static jclass getClazz(JNIEnv* env) {
             return get(env)->clazz;
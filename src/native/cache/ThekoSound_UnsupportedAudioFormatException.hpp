@@ -6,6 +6,7 @@
 #include <jni.h>
 #include <mutex>
 #include <memory>
+#include <atomic>
 
 // Target class: org/theko/sound/UnsupportedAudioFormatException
 class ThekoSound_UnsupportedAudioFormatException {
@@ -30,7 +31,7 @@ class ThekoSound_UnsupportedAudioFormatException {
         bool initialized = false; // True if all values are initialized
 
         // jclass cache
-        jclass clazz;
+        jclass clazz = nullptr;
         // jmethodID constructor cache
         // public org.theko.sound.UnsupportedAudioFormatException()
         jmethodID ctor__;
@@ -132,21 +133,40 @@ class ThekoSound_UnsupportedAudioFormatException {
             return clazz && initialized;
         }
 
+        // Published once the cache is valid, read without locking
+        static inline std::atomic<ThekoSound_UnsupportedAudioFormatException*> published{nullptr};
+
         static ThekoSound_UnsupportedAudioFormatException* get(JNIEnv* env) {
+            ThekoSound_UnsupportedAudioFormatException* self = published.load(std::memory_order_acquire);
+            if (self) return self;
+            return getLocked(env);
+        }
+
+        // Lazy fallback, used until init(env) or the first access succeeds
+        static ThekoSound_UnsupportedAudioFormatException* getLocked(JNIEnv* env) {
             if (!env) return nullptr;
             static std::mutex mtx;
             static std::unique_ptr<ThekoSound_UnsupportedAudioFormatException> instance;
-        
+
             std::lock_guard<std::mutex> lock(mtx);
             if (!ThekoSound_UnsupportedAudioFormatException::jvm) {
                 env->GetJavaVM(&ThekoSound_UnsupportedAudioFormatException::jvm);
             }
             if (!instance || !instance->isValid()) {
                 instance.reset(new ThekoSound_UnsupportedAudioFormatException(env));
+                if (instance->isValid()) {
+                    published.store(instance.get(), std::memory_order_release);
+                }
             }
             return instance.get();
         }
 
+        // Creates the cache eagerly, e.g. from JNI_OnLoad
+        static bool init(JNIEnv* env) {
+            ThekoSound_UnsupportedAudioFormatException* self = get(env);
+            return self && self->isValid();
+        }
+
         // Getters
         inline static jclass getClazz(JNIEnv* env) {
             return get(env)->clazz;
@@ -6,6 +6,7 @@
 #include <jni.h>
 #include <mutex>
 #include <memory>
+#include <atomic>
 
 // Target class: org/theko/sound/backends/wasapi/WASAPIPortHandle
 class ThekoSound_WASAPIPortHandle {
@@ -30,7 +31,7 @@ class ThekoSound_WASAPIPortHandle {
         bool initialized = false; // True if all values are initialized
 
         // jclass cache
-        jclass clazz;
+        jclass clazz = nullptr;
         // jfieldID cache
         // private java.lang.String org.theko.sound.backends.wasapi.WASAPIPortHandle.handle
         jfieldID fld__handle;
@@ -128,21 +129,40 @@ class ThekoSound_WASAPIPortHandle {
             return clazz && initialized;
         }
 
+        // Published once the cache is valid, read without locking
+        static inline std::atomic<ThekoSound_WASAPIPortHandle*> published{nullptr};
+
         static ThekoSound_WASAPIPortHandle* get(JNIEnv* env) {
+            ThekoSound_WASAPIPortHandle* self = published.load(std::memory_order_acquire);
+            if (self) return self;
+            return getLocked(env);
+        }
+
+        // Lazy fallback, used until init(env) or the first access succeeds
+        static ThekoSound_WASAPIPortHandle* getLocked(JNIEnv* env) {
             if (!env) return nullptr;
             static std::mutex mtx;
             static std::unique_ptr<ThekoSound_WASAPIPortHandle> instance;
-        
+
             std::lock_guard<std::mutex> lock(mtx);
             if (!ThekoSound_WASAPIPortHandle::jvm) {
                 env->GetJavaVM(&ThekoSound_WASAPIPortHandle::jvm);
             }
             if (!instance || !instance->isValid()) {
                 instance.reset(new ThekoSound_WASAPIPortHandle(env));
+                if (instance->isValid()) {
+                    published.store(instance.get(), std::memory_order_release);
+                }
             }
             return instance.get();
         }
 
+        // Creates the cache eagerly, e.g. from JNI_OnLoad
+        static bool init(JNIEnv* env) {
+            ThekoSound_WASAPIPortHandle* self = get(env);
+            return self && self->isValid();
+        }
+
         // Getters
         inline static jclass getClazz(JNIEnv* env) {
             return get(env)->clazz;
@@ -0,0 +1,95 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+/**
+ * Latest clock reading of a stream, published once per device period by the render thread
+ * and read without locks (seqlock), also from Java through a direct ByteBuffer.
+ *
+ * The memory is an array of little-endian 64-bit fields, indexed by Field.
+ * The sequence is odd while a write is in progress; readers retry until they see
+ * the same even sequence before and after reading the fields.
+ * Writers that find another write in progress skip their update instead of waiting.
+ */
+class ClockSnapshot {
+public:
+    enum Field {
+        SEQUENCE,
+        FRAME_POSITION,     // Frames played by the device
+        QPC_TIME,           // Performance counter time of FRAME_POSITION, in 100-ns units
+        DEVICE_POSITION,    // Raw IAudioClock position, in DEVICE_FREQUENCY units
+        DEVICE_FREQUENCY,   // IAudioClock frequency, in units per second
+        STREAM_LATENCY,     // In 100-ns units
+        BUFFERED_FRAMES,    // Queued in the endpoint and the ring buffer
+        SAMPLE_RATE,
+        FIELD_COUNT
+    };
+
+private:
+    static_assert(sizeof(std::atomic<int64_t>) == sizeof(int64_t), "Unexpected atomic layout");
+
+    alignas(64) std::atomic<int64_t> fields[FIELD_COUNT];
+
+public:
+    ClockSnapshot() {
+        for (size_t i = 0; i < FIELD_COUNT; i++) {
+            fields[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    ClockSnapshot(const ClockSnapshot&) = delete;
+    ClockSnapshot& operator=(const ClockSnapshot&) = delete;
+
+    /**
+     * Publishes a reading. Fields not listed keep their values.
+     * @return False if another writer was publishing at the same time and the reading was skipped
+     */
+    bool publish(int64_t framePosition, int64_t qpcTime, int64_t devicePosition,
+                 int64_t deviceFrequency, int64_t streamLatency, int64_t bufferedFrames, int64_t sampleRate) {
+        int64_t sequence = fields[SEQUENCE].load(std::memory_order_relaxed);
+        if ((sequence & 1) || !fields[SEQUENCE].compare_exchange_strong(sequence, sequence + 1, std::memory_order_acquire)) {
+            return false;
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+
+        fields[FRAME_POSITION].store(framePosition, std::memory_order_relaxed);
+        fields[QPC_TIME].store(qpcTime, std::memory_order_relaxed);
+        fields[DEVICE_POSITION].store(devicePosition, std::memory_order_relaxed);
+        fields[DEVICE_FREQUENCY].store(deviceFrequency, std::memory_order_relaxed);
+        fields[STREAM_LATENCY].store(streamLatency, std::memory_order_relaxed);
+        fields[BUFFERED_FRAMES].store(bufferedFrames, std::memory_order_relaxed);
+        fields[SAMPLE_RATE].store(sampleRate, std::memory_order_relaxed);
+
+        fields[SEQUENCE].store(sequence + 2, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @return The field memory, to be wrapped into a direct ByteBuffer
+     */
+    inline void* data() {
+        return (void*)fields;
+    }
+
+    static constexpr size_t size() {
+        return sizeof(int64_t) * FIELD_COUNT;
+    }
+};
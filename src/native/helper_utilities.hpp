@@ -108,7 +108,8 @@ static char* memalloc_literal_utf8(const char* str) {
     if (!str) return NULL;
     size_t len = strlen(str) + 1;
     char* result = (char*)malloc(len);
-    strcpy_s(result, len, str);
+    if (!result) return NULL;
+    memcpy(result, str, len);
     return result; // caller must free using 'free()'
 }
 
@@ -21,30 +21,49 @@
 #include <cstdarg>
 #include <cstdlib>
 #include <cstdio>
+#include <atomic>
 #include "cache/SLF4J_Logger.hpp"
 #include "cache/SLF4J_LoggerFactory.hpp"
 #include "helper_utilities.hpp"
+#include "native_log_queue.hpp"
 
 class Logger {
 private:
     jobject logger = nullptr;
+    std::atomic<uint32_t> enabledLevels{0}; // Bit per LogLevel, cached from SLF4J
+
+    static jmethodID getLevelMethod(JNIEnv* env, LogLevel level) {
+        switch (level) {
+            case LOG_LEVEL_TRACE: return SLF4J_Logger::getmtd__trace_java_lang_String(env);
+            case LOG_LEVEL_DEBUG: return SLF4J_Logger::getmtd__debug_java_lang_String(env);
+            case LOG_LEVEL_INFO:  return SLF4J_Logger::getmtd__info_java_lang_String(env);
+            case LOG_LEVEL_WARN:  return SLF4J_Logger::getmtd__warn_java_lang_String(env);
+            case LOG_LEVEL_ERROR: return SLF4J_Logger::getmtd__error_java_lang_String(env);
+            default: return nullptr;
+        }
+    }
 
     /**
-     * Logs a message to the logger. If the logger is null, the method is null or the message is null, the function does nothing.
+     * Logs a message to the logger. Disabled levels return after a single check.
+     * While asynchronous logging is enabled, the message is formatted into the native
+     * log queue and delivered later by the Java drain thread; otherwise SLF4J is called directly.
      *
      * @param env The JNI environment
-     * @param method The method to call on the logger
+     * @param level The level of the message
      * @param msg The message to log
      * @param args The arguments to pass to the format function
      */
-    void log(JNIEnv* env, jmethodID method, const char* msg, va_list args) {
-        if (!logger || !method || !msg) return;
-        const char* formatted = formatv(msg, args).c_str();
-        if (!formatted) return;
+    void log(JNIEnv* env, LogLevel level, const char* msg, va_list args) {
+        if (!isEnabled(level) || !msg) return;
 
-        jstring jmsg = env->NewStringUTF(formatted);
-        env->CallVoidMethod(logger, method, jmsg);
-        env->DeleteLocalRef(jmsg);
+        NativeLogQueue* queue = NativeLogQueue::getQueue();
+        if (queue->isAsync()) {
+            queue->enqueue(this, level, msg, args);
+            return;
+        }
+
+        std::string formatted = formatv(msg, args);
+        deliver(env, level, formatted.c_str());
     }
 
 public:
@@ -72,6 +91,53 @@ public:
         
         logger = env->NewGlobalRef(localLogger);
         env->DeleteLocalRef(localLogger);
+
+        refreshLevels(env);
+    }
+
+    /**
+     * Re-reads the enabled levels from the SLF4J logger.
+     *
+     * @param env The JNI environment
+     */
+    void refreshLevels(JNIEnv* env) {
+        if (!logger) return;
+        uint32_t levels = 0;
+        if (SLF4J_Logger::isTraceEnabled__(env, logger)) levels |= 1u << LOG_LEVEL_TRACE;
+        if (SLF4J_Logger::isDebugEnabled__(env, logger)) levels |= 1u << LOG_LEVEL_DEBUG;
+        if (SLF4J_Logger::isInfoEnabled__(env, logger))  levels |= 1u << LOG_LEVEL_INFO;
+        if (SLF4J_Logger::isWarnEnabled__(env, logger))  levels |= 1u << LOG_LEVEL_WARN;
+        if (SLF4J_Logger::isErrorEnabled__(env, logger)) levels |= 1u << LOG_LEVEL_ERROR;
+        enabledLevels.store(levels, std::memory_order_relaxed);
+    }
+
+    inline bool isEnabled(LogLevel level) const {
+        return (enabledLevels.load(std::memory_order_relaxed) >> level) & 1u;
+    }
+
+    inline bool isTraceEnabled() const {
+        return isEnabled(LOG_LEVEL_TRACE);
+    }
+
+    inline bool isDebugEnabled() const {
+        return isEnabled(LOG_LEVEL_DEBUG);
+    }
+
+    /**
+     * Passes an already formatted message to the SLF4J logger, on the calling thread.
+     *
+     * @param env The JNI environment
+     * @param level The level of the message
+     * @param text The formatted message
+     */
+    void deliver(JNIEnv* env, LogLevel level, const char* text) {
+        jmethodID method = getLevelMethod(env, level);
+        if (!logger || !method || !text) return;
+
+        jstring jmsg = env->NewStringUTF(text);
+        if (!jmsg) return;
+        env->CallVoidMethod(logger, method, jmsg);
+        env->DeleteLocalRef(jmsg);
     }
 
     /**
@@ -84,7 +150,7 @@ public:
     void trace(JNIEnv* env, const char* msg, ...) {
         va_list args;
         va_start(args, msg);
-        log(env, SLF4J_Logger::getmtd__trace_java_lang_String(env), msg, args);
+        log(env, LOG_LEVEL_TRACE, msg, args);
         va_end(args);
     }
 
@@ -98,7 +164,7 @@ public:
     void debug(JNIEnv* env, const char* msg, ...) {
         va_list args;
         va_start(args, msg);
-        log(env, SLF4J_Logger::getmtd__debug_java_lang_String(env), msg, args);
+        log(env, LOG_LEVEL_DEBUG, msg, args);
         va_end(args);
     }
 
@@ -112,7 +178,7 @@ public:
     void info(JNIEnv* env, const char* msg, ...) {
         va_list args;
         va_start(args, msg);
-        log(env, SLF4J_Logger::getmtd__info_java_lang_String(env), msg, args);
+        log(env, LOG_LEVEL_INFO, msg, args);
         va_end(args);
     }
 
@@ -126,7 +192,7 @@ public:
     void warn(JNIEnv* env, const char* msg, ...) {
         va_list args;
         va_start(args, msg);
-        log(env, SLF4J_Logger::getmtd__warn_java_lang_String(env), msg, args);
+        log(env, LOG_LEVEL_WARN, msg, args);
         va_end(args);
     }
 
@@ -140,7 +206,7 @@ public:
     void error(JNIEnv* env, const char* msg, ...) {
         va_list args;
         va_start(args, msg);
-        log(env, SLF4J_Logger::getmtd__error_java_lang_String(env), msg, args);
+        log(env, LOG_LEVEL_ERROR, msg, args);
         va_end(args);
     }
 
@@ -20,6 +20,7 @@
 #include <string>
 #include <unordered_map>
 #include <mutex>
+#include <atomic>
 #include "logger.hpp"
 
 class LoggerManager {
@@ -69,6 +70,10 @@ public:
      * @param env The JNIEnv pointer for the current thread
      */
     void releaseAll(JNIEnv* env) {
+        // Queued records point to the loggers, deliver them first
+        NativeLogQueue::getQueue()->setAsync(false);
+        drainQueue(env);
+
         std::lock_guard<std::mutex> guard(mutex);
 
         for (auto& [_, logger] : loggerCache) {
@@ -77,6 +82,35 @@ public:
                 delete logger;
             }
         }
+        loggerCache.clear();
+    }
+
+    /**
+     * @brief Re-reads the enabled levels of all cached loggers from SLF4J.
+     *
+     * Called periodically by the Java log drain thread, so native threads
+     * only ever check the cached levels.
+     *
+     * @param env The JNIEnv pointer for the current thread
+     */
+    void refreshLevels(JNIEnv* env) {
+        std::lock_guard<std::mutex> guard(mutex);
+
+        for (auto& [_, logger] : loggerCache) {
+            if (logger) logger->refreshLevels(env);
+        }
+    }
+
+    /**
+     * @brief Delivers all queued native log records to SLF4J on the calling thread.
+     *
+     * @param env The JNIEnv pointer for the current thread
+     * @return The number of delivered records
+     */
+    size_t drainQueue(JNIEnv* env) {
+        return NativeLogQueue::getQueue()->drain([env](Logger* logger, LogLevel level, const char* text) {
+            if (logger) logger->deliver(env, level, text);
+        });
     }
 
     ~LoggerManager() {
@@ -97,4 +131,45 @@ public:
         static LoggerManager* manager = new LoggerManager();
         return manager;
     }
-};
\ No newline at end of file
+};
+
+/**
+ * @brief Statically allocated handle to a named logger.
+ *
+ * The handle is constant-initialized, so a function-local static handle needs
+ * no initialization guard. The logger is looked up in the LoggerManager once,
+ * on first use; after that, get() is a single atomic load, with no locking,
+ * no string construction and no allocation.
+ */
+class LoggerHandle {
+private:
+    const char* name;
+    std::atomic<Logger*> logger{nullptr};
+
+public:
+    constexpr explicit LoggerHandle(const char* name) : name(name) {}
+
+    LoggerHandle(const LoggerHandle&) = delete;
+    LoggerHandle& operator=(const LoggerHandle&) = delete;
+
+    inline Logger* get(JNIEnv* env) {
+        Logger* cached = logger.load(std::memory_order_acquire);
+        if (cached) return cached;
+
+        // Racing threads get the same logger from the manager
+        cached = LoggerManager::getManager()->getLogger(env, name);
+        logger.store(cached, std::memory_order_release);
+        return cached;
+    }
+};
+
+/**
+ * @brief Returns the logger with the given literal name through a static LoggerHandle.
+ *
+ * Usage: {@code Logger* logger = NATIVE_LOGGER(env, "NATIVE: Class.method");}
+ */
+#define NATIVE_LOGGER(env, name) \
+    ([](JNIEnv* loggerEnv) -> Logger* { \
+        static LoggerHandle handle(name); \
+        return handle.get(loggerEnv); \
+    }(env))
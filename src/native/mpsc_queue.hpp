@@ -0,0 +1,87 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <atomic>
+#include <utility>
+
+/**
+ * Lock-free multi-producer queue, drained in batches.
+ *
+ * Any thread may push. Draining detaches the whole list with a single exchange,
+ * so concurrent drains are safe as well (each item is delivered exactly once)
+ * and there is no ABA problem. Items are delivered in push order per drain.
+ * Push allocates a node, so it is not meant for real-time threads.
+ */
+template <typename T>
+class MpscQueue {
+private:
+    struct Node {
+        T value;
+        Node* next;
+    };
+
+    std::atomic<Node*> head{nullptr}; // Most recently pushed node
+
+public:
+    MpscQueue() = default;
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    ~MpscQueue() {
+        drain([](T&) {});
+    }
+
+    void push(T value) {
+        Node* node = new Node{std::move(value), head.load(std::memory_order_relaxed)};
+        while (!head.compare_exchange_weak(node->next, node,
+                std::memory_order_release, std::memory_order_relaxed)) {}
+    }
+
+    inline bool isEmpty() const {
+        return head.load(std::memory_order_acquire) == nullptr;
+    }
+
+    /**
+     * Removes all queued items and passes them to {@code fn} in push order.
+     * @return The number of items drained
+     */
+    template <typename Fn>
+    size_t drain(Fn fn) {
+        Node* node = head.exchange(nullptr, std::memory_order_acquire);
+
+        // The list is LIFO, reverse it
+        Node* ordered = nullptr;
+        while (node) {
+            Node* next = node->next;
+            node->next = ordered;
+            ordered = node;
+            node = next;
+        }
+
+        size_t count = 0;
+        while (ordered) {
+            Node* next = ordered->next;
+            fn(ordered->value);
+            delete ordered;
+            ordered = next;
+            count++;
+        }
+        return count;
+    }
+};
@@ -0,0 +1,54 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <jni.h>
+
+#include "logger.hpp"
+#include "logger_manager.hpp"
+#include "native_log_queue.hpp"
+
+#include "org_theko_sound_backends_wasapi_WASAPINativeLogDrain.h"
+
+extern "C" {
+    JNIEXPORT void JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPINativeLogDrain_nSetAsync
+    (JNIEnv* env, jclass clazz, jboolean enabled) {
+        NativeLogQueue* queue = NativeLogQueue::getQueue();
+        queue->setAsync(enabled == JNI_TRUE);
+        if (!enabled) {
+            // Nothing drains the queue anymore
+            LoggerManager::getManager()->drainQueue(env);
+        }
+    }
+
+    JNIEXPORT jint JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPINativeLogDrain_nDrain
+    (JNIEnv* env, jclass clazz) {
+        return (jint)LoggerManager::getManager()->drainQueue(env);
+    }
+
+    JNIEXPORT jint JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPINativeLogDrain_nTakeDropped
+    (JNIEnv* env, jclass clazz) {
+        return (jint)NativeLogQueue::getQueue()->takeDropped();
+    }
+
+    JNIEXPORT void JNICALL
+    Java_org_theko_sound_backends_wasapi_WASAPINativeLogDrain_nRefreshLevels
+    (JNIEnv* env, jclass clazz) {
+        LoggerManager::getManager()->refreshLevels(env);
+    }
+}
@@ -0,0 +1,158 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <atomic>
+
+#define NATIVE_LOG_QUEUE_CAPACITY 1024 // Records, power of two
+#define NATIVE_LOG_RECORD_SIZE 256     // Bytes of text per record, longer messages are truncated
+
+class Logger;
+
+enum LogLevel : uint8_t {
+    LOG_LEVEL_TRACE,
+    LOG_LEVEL_DEBUG,
+    LOG_LEVEL_INFO,
+    LOG_LEVEL_WARN,
+    LOG_LEVEL_ERROR,
+    LOG_LEVEL_COUNT
+};
+
+/**
+ * Preallocated, bounded, lock-free queue of formatted native log records.
+ *
+ * Native threads format their messages straight into a claimed slot, without
+ * heap allocation or JNI calls, and a Java daemon thread drains the records
+ * into SLF4J in batches. When the queue is full, records are dropped and counted.
+ * Any number of threads may enqueue and drain (Vyukov's bounded MPMC queue).
+ */
+class NativeLogQueue {
+private:
+    struct Slot {
+        std::atomic<size_t> sequence;
+        Logger* logger;
+        LogLevel level;
+        char text[NATIVE_LOG_RECORD_SIZE];
+    };
+
+    static constexpr size_t MASK = NATIVE_LOG_QUEUE_CAPACITY - 1;
+    static_assert((NATIVE_LOG_QUEUE_CAPACITY & MASK) == 0, "Capacity must be a power of two");
+
+    Slot slots[NATIVE_LOG_QUEUE_CAPACITY];
+    alignas(64) std::atomic<size_t> enqueuePos{0};
+    alignas(64) std::atomic<size_t> dequeuePos{0};
+    alignas(64) std::atomic<uint32_t> dropped{0};
+    std::atomic<bool> async{false};
+
+    NativeLogQueue() {
+        for (size_t i = 0; i < NATIVE_LOG_QUEUE_CAPACITY; i++) {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+public:
+    NativeLogQueue(const NativeLogQueue&) = delete;
+    NativeLogQueue& operator=(const NativeLogQueue&) = delete;
+
+    /**
+     * Formats the message into a free slot and publishes it.
+     * @return False if the queue is full and the message was dropped
+     */
+    bool enqueue(Logger* logger, LogLevel level, const char* fmt, va_list args) {
+        size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        Slot* slot;
+        while (true) {
+            slot = &slots[pos & MASK];
+            size_t seq = slot->sequence.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+            if (diff == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            } else {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->logger = logger;
+        slot->level = level;
+        va_list argsCopy;
+        va_copy(argsCopy, args);
+        if (vsnprintf(slot->text, NATIVE_LOG_RECORD_SIZE, fmt, argsCopy) < 0) {
+            slot->text[0] = '\0';
+        }
+        va_end(argsCopy);
+
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Passes queued records to {@code fn(logger, level, text)} in order, until the queue is empty.
+     * @return The number of records drained
+     */
+    template <typename Fn>
+    size_t drain(Fn fn) {
+        size_t count = 0;
+        size_t pos = dequeuePos.load(std::memory_order_relaxed);
+        while (true) {
+            Slot* slot = &slots[pos & MASK];
+            size_t seq = slot->sequence.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+            if (diff == 0) {
+                if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    fn(slot->logger, slot->level, (const char*)slot->text);
+                    slot->sequence.store(pos + MASK + 1, std::memory_order_release);
+                    count++;
+                    pos++;
+                }
+            } else if (diff < 0) {
+                return count; // Empty, or the next record is still being written
+            } else {
+                pos = dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @return The number of records dropped since the last call
+     */
+    inline uint32_t takeDropped() {
+        return dropped.exchange(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * Enables or disables asynchronous delivery. While disabled, loggers call SLF4J directly.
+     */
+    inline void setAsync(bool enabled) {
+        async.store(enabled, std::memory_order_release);
+    }
+
+    inline bool isAsync() const {
+        return async.load(std::memory_order_relaxed);
+    }
+
+    static NativeLogQueue* getQueue() {
+        static NativeLogQueue* queue = new NativeLogQueue();
+        return queue;
+    }
+};
@@ -0,0 +1,53 @@
+/* DO NOT EDIT THIS FILE - it is machine generated */
+#include <jni.h>
+/* Header for class org_theko_sound_backends_pulseaudio_PulseAudioBackend */
+
+#ifndef _Included_org_theko_sound_backends_pulseaudio_PulseAudioBackend
+#define _Included_org_theko_sound_backends_pulseaudio_PulseAudioBackend
+#ifdef __cplusplus
+extern "C" {
+#endif
+/*
+ * Class:     org_theko_sound_backends_pulseaudio_PulseAudioBackend
+ * Method:    nInit
+ * Signature: ()J
+ */
+JNIEXPORT jlong JNICALL Java_org_theko_sound_backends_pulseaudio_PulseAudioBackend_nInit
+  (JNIEnv *, jobject);
+
+/*
+ * Class:     org_theko_sound_backends_pulseaudio_PulseAudioBackend
+ * Method:    nShutdown
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_org_theko_sound_backends_pulseaudio_PulseAudioBackend_nShutdown
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     org_theko_sound_backends_pulseaudio_PulseAudioBackend
+ * Method:    nGetAllPorts
+ * Signature: (J)[Lorg/theko/sound/AudioPort;
+ */
+JNIEXPORT jobjectArray JNICALL Java_org_theko_sound_backends_pulseaudio_PulseAudioBackend_nGetAllPorts
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     org_theko_sound_backends_pulseaudio_PulseAudioBackend
+ * Method:    nGetDefaultPort
+ * Signature: (JLorg/theko/sound/AudioFlow;)Lorg/theko/sound/AudioPort;
+ */
+JNIEXPORT jobject JNICALL Java_org_theko_sound_backends_pulseaudio_PulseAudioBackend_nGetDefaultPort
+  (JNIEnv *, jobject, jlong, jobject);
+
+/*
+ * Class:     org_theko_sound_backends_pulseaudio_PulseAudioBackend
+ * Method:    nIsFormatSupported
+ * Signature: (Lorg/theko/sound/AudioPort;Lorg/theko/sound/AudioFormat;Ljava/util/concurrent/atomic/AtomicReference;)Z
+ */
+JNIEXPORT jboolean JNICALL Java_org_theko_sound_backends_pulseaudio_PulseAudioBackend_nIsFormatSupported
+  (JNIEnv *, jobject, jobject, jobject, jobject);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,149 @@
+/* DO NOT EDIT THIS FILE - it is machine generated */
+#include <jni.h>
+/* Header for class org_theko_sound_backends_pulseaudio_PulseAudioInput */
+
+#ifndef _Included_org_theko_sound_backends_pulseaudio_PulseAudioInput
+#define _Included_org_theko_sound_backends_pulseaudio_PulseAudioInput
+#ifdef __cplusplus
+extern "C" {
+#endif
+/*
+ * Class:     org_theko_sound_backends_pulseaudio_PulseAudioInput
+ * Method:    nOpen
+ * Signature: (Lorg/theko/sound/AudioPort;Lorg/theko/sound/AudioFormat;ILjava/util/concurrent/atomic/AtomicReference;Z)J
+ */
+JNIEXPORT jlong JNICALL Java_org_theko_sound_backends_pulseaudio_PulseAudioInput_nOpen
+  (JNIEnv *, jobject, jobject, jobject, jint, jobject, jboolean);
+
+/*
+ * Class:     org_theko_sound_backends_pulseaudio_PulseAudioInput
+ * Method:    nClose
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_org_theko_sound_backends_pulseaudio_PulseAudioInput_nClose
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     org_theko_sound_backends_pulseaudio_PulseAudioInput
+ * Method:    nStart
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_org_theko_sound_backends_pulseaudio_PulseAudioInput_nStart
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     org_theko_sound_backends_pulseaudio_PulseAudioInput
+ * Method:    nStop
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_org_theko_sound_backends_pulseaudio_PulseAudioInput_nStop
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     org_theko_sound_backends_pulseaudio_PulseAudioInput
+ * Method:    nFlush
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_org_theko_sound_backends_pulseaudio_PulseAudioInput_nFlush
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     org_theko_sound_backends_pulseaudio_PulseAudioInput
+ * Method:    nDrain
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_org_theko_sound_backends_pulseaudio_PulseAudioInput_nDrain
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     org_theko_sound_backends_pulseaudio_PulseAudioInput
+ * Method:    nRead
+ * Signature: (J[BII)I
+ */
+JNIEXPORT jint JNICALL Java_org_theko_sound_backends_pulseaudio_PulseAudioInput_nRead
+  (JNIEnv *, jobject, jlong, jbyteArray, jint, jint);
+
+/*
+ * Class:     org_theko_sound_backends_pulseaudio_PulseAudioInput
+ * Method:    nReadDirect
+ * Signature: (JLjava/nio/ByteBuffer;II)I
+ */
+JNIEXPORT jint JNICALL Java_org_theko_sound_backends_pulseaudio_PulseAudioInput_nReadDirect
+  (JNIEnv *, jobject, jlong, jobject, jint, jint);
+
+/*
+ * Class:     org_theko_sound_backends_pulseaudio_PulseAudioInput
+ * Method:    nWaitForData
+ * Signature: (JI)Z
+ */
+JNIEXPORT jboolean JNICALL Java_org_theko_sound_backends_pulseaudio_PulseAudioInput_nWaitForData
+  (JNIEnv *, jobject, jlong, jint);
+
+/*
+ * Class:     org_theko_sound_backends_pulseaudio_PulseAudioInput
+ * Method:    nAvailable
+ * Signature: (J)I
+ */
+JNIEXPORT jint JNICALL Java_org_theko_sound_backends_pulseaudio_PulseAudioInput_nAvailable
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     org_theko_sound_backends_pulseaudio_PulseAudioInput
+ * Method:    nGetBufferSize
+ * Signature: (J)I
+ */
+JNIEXPORT jint JNICALL Java_org_theko_sound_backends_pulseaudio_PulseAudioInput_nGetBufferSize
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     org_theko_sound_backends_pulseaudio_PulseAudioInput
+ * Method:    nGetFramePosition
+ * Signature: (J)J
+ */
+JNIEXPORT jlong JNICALL Java_org_theko_sound_backends_pulseaudio_PulseAudioInput_nGetFramePosition
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     org_theko_sound_backends_pulseaudio_PulseAudioInput
+ * Method:    nGetMicrosecondLatency
+ * Signature: (J)J
+ */
+JNIEXPORT jlong JNICALL Java_org_theko_sound_backends_pulseaudio_PulseAudioInput_nGetMicrosecondLatency
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     org_theko_sound_backends_pulseaudio_PulseAudioInput
+ * Method:    nGetPeriodFrames
+ * Signature: (J)I
+ */
+JNIEXPORT jint JNICALL Java_org_theko_sound_backends_pulseaudio_PulseAudioInput_nGetPeriodFrames
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     org_theko_sound_backends_pulseaudio_PulseAudioInput
+ * Method:    nGetOverflowCount
+ * Signature: (J)J
+ */
+JNIEXPORT jlong JNICALL Java_org_theko_sound_backends_pulseaudio_PulseAudioInput_nGetOverflowCount
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     org_theko_sound_backends_pulseaudio_PulseAudioInput
+ * Method:    nGetDiscontinuityCount
+ * Signature: (J)J
+ */
+JNIEXPORT jlong JNICALL Java_org_theko_sound_backends_pulseaudio_PulseAudioInput_nGetDiscontinuityCount
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     org_theko_sound_backends_pulseaudio_PulseAudioInput
+ * Method:    nGetCurrentAudioPort
+ * Signature: (J)Lorg/theko/sound/AudioPort;
+ */
+JNIEXPORT jobject JNICALL Java_org_theko_sound_backends_pulseaudio_PulseAudioInput_nGetCurrentAudioPort
+  (JNIEnv *, jobject, jlong);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,133 @@
+/* DO NOT EDIT THIS FILE - it is machine generated */
+#include <jni.h>
+/* Header for class org_theko_sound_backends_pulseaudio_PulseAudioOutput */
+
+#ifndef _Included_org_theko_sound_backends_pulseaudio_PulseAudioOutput
+#define _Included_org_theko_sound_backends_pulseaudio_PulseAudioOutput
+#ifdef __cplusplus
+extern "C" {
+#endif
+/*
+ * Class:     org_theko_sound_backends_pulseaudio_PulseAudioOutput
+ * Method:    nOpen
+ * Signature: (Lorg/theko/sound/AudioPort;Lorg/theko/sound/AudioFormat;ILjava/util/concurrent/atomic/AtomicReference;Z)J
+ */
+JNIEXPORT jlong JNICALL Java_org_theko_sound_backends_pulseaudio_PulseAudioOutput_nOpen
+  (JNIEnv *, jobject, jobject, jobject, jint, jobject, jboolean);
+
+/*
+ * Class:     org_theko_sound_backends_pulseaudio_PulseAudioOutput
+ * Method:    nClose
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_org_theko_sound_backends_pulseaudio_PulseAudioOutput_nClose
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     org_theko_sound_backends_pulseaudio_PulseAudioOutput
+ * Method:    nStart
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_org_theko_sound_backends_pulseaudio_PulseAudioOutput_nStart
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     org_theko_sound_backends_pulseaudio_PulseAudioOutput
+ * Method:    nStop
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_org_theko_sound_backends_pulseaudio_PulseAudioOutput_nStop
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     org_theko_sound_backends_pulseaudio_PulseAudioOutput
+ * Method:    nFlush
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_org_theko_sound_backends_pulseaudio_PulseAudioOutput_nFlush
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     org_theko_sound_backends_pulseaudio_PulseAudioOutput
+ * Method:    nDrain
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_org_theko_sound_backends_pulseaudio_PulseAudioOutput_nDrain
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     org_theko_sound_backends_pulseaudio_PulseAudioOutput
+ * Method:    nWrite
+ * Signature: (J[BII)I
+ */
+JNIEXPORT jint JNICALL Java_org_theko_sound_backends_pulseaudio_PulseAudioOutput_nWrite
+  (JNIEnv *, jobject, jlong, jbyteArray, jint, jint);
+
+/*
+ * Class:     org_theko_sound_backends_pulseaudio_PulseAudioOutput
+ * Method:    nWriteDirect
+ * Signature: (JLjava/nio/ByteBuffer;II)I
+ */
+JNIEXPORT jint JNICALL Java_org_theko_sound_backends_pulseaudio_PulseAudioOutput_nWriteDirect
+  (JNIEnv *, jobject, jlong, jobject, jint, jint);
+
+/*
+ * Class:     org_theko_sound_backends_pulseaudio_PulseAudioOutput
+ * Method:    nAvailable
+ * Signature: (J)I
+ */
+JNIEXPORT jint JNICALL Java_org_theko_sound_backends_pulseaudio_PulseAudioOutput_nAvailable
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     org_theko_sound_backends_pulseaudio_PulseAudioOutput
+ * Method:    nGetBufferSize
+ * Signature: (J)I
+ */
+JNIEXPORT jint JNICALL Java_org_theko_sound_backends_pulseaudio_PulseAudioOutput_nGetBufferSize
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     org_theko_sound_backends_pulseaudio_PulseAudioOutput
+ * Method:    nGetFramePosition
+ * Signature: (J)J
+ */
+JNIEXPORT jlong JNICALL Java_org_theko_sound_backends_pulseaudio_PulseAudioOutput_nGetFramePosition
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     org_theko_sound_backends_pulseaudio_PulseAudioOutput
+ * Method:    nGetMicrosecondLatency
+ * Signature: (J)J
+ */
+JNIEXPORT jlong JNICALL Java_org_theko_sound_backends_pulseaudio_PulseAudioOutput_nGetMicrosecondLatency
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     org_theko_sound_backends_pulseaudio_PulseAudioOutput
+ * Method:    nGetPeriodFrames
+ * Signature: (J)I
+ */
+JNIEXPORT jint JNICALL Java_org_theko_sound_backends_pulseaudio_PulseAudioOutput_nGetPeriodFrames
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     org_theko_sound_backends_pulseaudio_PulseAudioOutput
+ * Method:    nGetUnderflowCount
+ * Signature: (J)J
+ */
+JNIEXPORT jlong JNICALL Java_org_theko_sound_backends_pulseaudio_PulseAudioOutput_nGetUnderflowCount
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     org_theko_sound_backends_pulseaudio_PulseAudioOutput
+ * Method:    nGetCurrentAudioPort
+ * Signature: (J)Lorg/theko/sound/AudioPort;
+ */
+JNIEXPORT jobject JNICALL Java_org_theko_sound_backends_pulseaudio_PulseAudioOutput_nGetCurrentAudioPort
+  (JNIEnv *, jobject, jlong);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,29 @@
+/* DO NOT EDIT THIS FILE - it is machine generated */
+#include <jni.h>
+/* Header for class org_theko_sound_backends_wasapi_WASAPIExclusiveBackend */
+
+#ifndef _Included_org_theko_sound_backends_wasapi_WASAPIExclusiveBackend
+#define _Included_org_theko_sound_backends_wasapi_WASAPIExclusiveBackend
+#ifdef __cplusplus
+extern "C" {
+#endif
+/*
+ * Class:     org_theko_sound_backends_wasapi_WASAPIExclusiveBackend
+ * Method:    nIsExclusiveFormatSupported
+ * Signature: (Lorg/theko/sound/AudioPort;Lorg/theko/sound/AudioFormat;)Z
+ */
+JNIEXPORT jboolean JNICALL Java_org_theko_sound_backends_wasapi_WASAPIExclusiveBackend_nIsExclusiveFormatSupported
+  (JNIEnv *, jobject, jobject, jobject);
+
+/*
+ * Class:     org_theko_sound_backends_wasapi_WASAPIExclusiveBackend
+ * Method:    nGetExclusiveFormats
+ * Signature: (Lorg/theko/sound/AudioPort;)[Lorg/theko/sound/AudioFormat;
+ */
+JNIEXPORT jobjectArray JNICALL Java_org_theko_sound_backends_wasapi_WASAPIExclusiveBackend_nGetExclusiveFormats
+  (JNIEnv *, jobject, jobject);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,149 @@
+/* DO NOT EDIT THIS FILE - it is machine generated */
+#include <jni.h>
+/* Header for class org_theko_sound_backends_wasapi_WASAPIExclusiveOutput */
+
+#ifndef _Included_org_theko_sound_backends_wasapi_WASAPIExclusiveOutput
+#define _Included_org_theko_sound_backends_wasapi_WASAPIExclusiveOutput
+#ifdef __cplusplus
+extern "C" {
+#endif
+/*
+ * Class:     org_theko_sound_backends_wasapi_WASAPIExclusiveOutput
+ * Method:    nOpen
+ * Signature: (Lorg/theko/sound/AudioPort;Lorg/theko/sound/AudioFormat;ILjava/util/concurrent/atomic/AtomicReference;Z)J
+ */
+JNIEXPORT jlong JNICALL Java_org_theko_sound_backends_wasapi_WASAPIExclusiveOutput_nOpen
+  (JNIEnv *, jobject, jobject, jobject, jint, jobject, jboolean);
+
+/*
+ * Class:     org_theko_sound_backends_wasapi_WASAPIExclusiveOutput
+ * Method:    nClose
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_org_theko_sound_backends_wasapi_WASAPIExclusiveOutput_nClose
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     org_theko_sound_backends_wasapi_WASAPIExclusiveOutput
+ * Method:    nStart
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_org_theko_sound_backends_wasapi_WASAPIExclusiveOutput_nStart
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     org_theko_sound_backends_wasapi_WASAPIExclusiveOutput
+ * Method:    nStop
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_org_theko_sound_backends_wasapi_WASAPIExclusiveOutput_nStop
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     org_theko_sound_backends_wasapi_WASAPIExclusiveOutput
+ * Method:    nFlush
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_org_theko_sound_backends_wasapi_WASAPIExclusiveOutput_nFlush
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     org_theko_sound_backends_wasapi_WASAPIExclusiveOutput
+ * Method:    nDrain
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_org_theko_sound_backends_wasapi_WASAPIExclusiveOutput_nDrain
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     org_theko_sound_backends_wasapi_WASAPIExclusiveOutput
+ * Method:    nWrite
+ * Signature: (J[BII)I
+ */
+JNIEXPORT jint JNICALL Java_org_theko_sound_backends_wasapi_WASAPIExclusiveOutput_nWrite
+  (JNIEnv *, jobject, jlong, jbyteArray, jint, jint);
+
+/*
+ * Class:     org_theko_sound_backends_wasapi_WASAPIExclusiveOutput
+ * Method:    nWriteDirect
+ * Signature: (JLjava/nio/ByteBuffer;II)I
+ */
+JNIEXPORT jint JNICALL Java_org_theko_sound_backends_wasapi_WASAPIExclusiveOutput_nWriteDirect
+  (JNIEnv *, jobject, jlong, jobject, jint, jint);
+
+/*
+ * Class:     org_theko_sound_backends_wasapi_WASAPIExclusiveOutput
+ * Method:    nAvailable
+ * Signature: (J)I
+ */
+JNIEXPORT jint JNICALL Java_org_theko_sound_backends_wasapi_WASAPIExclusiveOutput_nAvailable
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     org_theko_sound_backends_wasapi_WASAPIExclusiveOutput
+ * Method:    nGetBufferSize
+ * Signature: (J)I
+ */
+JNIEXPORT jint JNICALL Java_org_theko_sound_backends_wasapi_WASAPIExclusiveOutput_nGetBufferSize
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     org_theko_sound_backends_wasapi_WASAPIExclusiveOutput
+ * Method:    nGetFramePosition
+ * Signature: (J)J
+ */
+JNIEXPORT jlong JNICALL Java_org_theko_sound_backends_wasapi_WASAPIExclusiveOutput_nGetFramePosition
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     org_theko_sound_backends_wasapi_WASAPIExclusiveOutput
+ * Method:    nGetClockBuffer
+ * Signature: (J)Ljava/nio/ByteBuffer;
+ */
+JNIEXPORT jobject JNICALL Java_org_theko_sound_backends_wasapi_WASAPIExclusiveOutput_nGetClockBuffer
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     org_theko_sound_backends_wasapi_WASAPIExclusiveOutput
+ * Method:    nGetTelemetryBuffer
+ * Signature: (J)Ljava/nio/ByteBuffer;
+ */
+JNIEXPORT jobject JNICALL Java_org_theko_sound_backends_wasapi_WASAPIExclusiveOutput_nGetTelemetryBuffer
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     org_theko_sound_backends_wasapi_WASAPIExclusiveOutput
+ * Method:    nUpdateClock
+ * Signature: (J)Z
+ */
+JNIEXPORT jboolean JNICALL Java_org_theko_sound_backends_wasapi_WASAPIExclusiveOutput_nUpdateClock
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     org_theko_sound_backends_wasapi_WASAPIExclusiveOutput
+ * Method:    nGetMicrosecondLatency
+ * Signature: (J)J
+ */
+JNIEXPORT jlong JNICALL Java_org_theko_sound_backends_wasapi_WASAPIExclusiveOutput_nGetMicrosecondLatency
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     org_theko_sound_backends_wasapi_WASAPIExclusiveOutput
+ * Method:    nGetPeriodFrames
+ * Signature: (J)I
+ */
+JNIEXPORT jint JNICALL Java_org_theko_sound_backends_wasapi_WASAPIExclusiveOutput_nGetPeriodFrames
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     org_theko_sound_backends_wasapi_WASAPIExclusiveOutput
+ * Method:    nGetCurrentAudioPort
+ * Signature: (J)Lorg/theko/sound/AudioPort;
+ */
+JNIEXPORT jobject JNICALL Java_org_theko_sound_backends_wasapi_WASAPIExclusiveOutput_nGetCurrentAudioPort
+  (JNIEnv *, jobject, jlong);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,45 @@
+/* DO NOT EDIT THIS FILE - it is machine generated */
+#include <jni.h>
+/* Header for class org_theko_sound_backends_wasapi_WASAPINativeLogDrain */
+
+#ifndef _Included_org_theko_sound_backends_wasapi_WASAPINativeLogDrain
+#define _Included_org_theko_sound_backends_wasapi_WASAPINativeLogDrain
+#ifdef __cplusplus
+extern "C" {
+#endif
+/*
+ * Class:     org_theko_sound_backends_wasapi_WASAPINativeLogDrain
+ * Method:    nSetAsync
+ * Signature: (Z)V
+ */
+JNIEXPORT void JNICALL Java_org_theko_sound_backends_wasapi_WASAPINativeLogDrain_nSetAsync
+  (JNIEnv *, jclass, jboolean);
+
+/*
+ * Class:     org_theko_sound_backends_wasapi_WASAPINativeLogDrain
+ * Method:    nDrain
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_org_theko_sound_backends_wasapi_WASAPINativeLogDrain_nDrain
+  (JNIEnv *, jclass);
+
+/*
+ * Class:     org_theko_sound_backends_wasapi_WASAPINativeLogDrain
+ * Method:    nTakeDropped
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_org_theko_sound_backends_wasapi_WASAPINativeLogDrain_nTakeDropped
+  (JNIEnv *, jclass);
+
+/*
+ * Class:     org_theko_sound_backends_wasapi_WASAPINativeLogDrain
+ * Method:    nRefreshLevels
+ * Signature: ()V
+ */
+JNIEXPORT void JNICALL Java_org_theko_sound_backends_wasapi_WASAPINativeLogDrain_nRefreshLevels
+  (JNIEnv *, jclass);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -39,6 +39,14 @@ JNIEXPORT jobjectArray JNICALL Java_org_theko_sound_backends_wasapi_WASAPIShared
 JNIEXPORT jobject JNICALL Java_org_theko_sound_backends_wasapi_WASAPISharedBackend_nGetDefaultPort
   (JNIEnv *, jobject, jlong, jobject);
 
+/*
+ * Class:     org_theko_sound_backends_wasapi_WASAPISharedBackend
+ * Method:    nGetPortsGeneration
+ * Signature: ()J
+ */
+JNIEXPORT jlong JNICALL Java_org_theko_sound_backends_wasapi_WASAPISharedBackend_nGetPortsGeneration
+  (JNIEnv *, jclass);
+
 /*
  * Class:     org_theko_sound_backends_wasapi_WASAPISharedBackend
  * Method:    nIsFormatSupported
@@ -47,6 +55,22 @@ JNIEXPORT jobject JNICALL Java_org_theko_sound_backends_wasapi_WASAPISharedBacke
 JNIEXPORT jboolean JNICALL Java_org_theko_sound_backends_wasapi_WASAPISharedBackend_nIsFormatSupported
   (JNIEnv *, jobject, jobject, jobject, jobject);
 
+/*
+ * Class:     org_theko_sound_backends_wasapi_WASAPISharedBackend
+ * Method:    nGetFormatSupport
+ * Signature: (Lorg/theko/sound/AudioPort;[Lorg/theko/sound/AudioFormat;[Lorg/theko/sound/AudioFormat;)[I
+ */
+JNIEXPORT jintArray JNICALL Java_org_theko_sound_backends_wasapi_WASAPISharedBackend_nGetFormatSupport
+  (JNIEnv *, jobject, jobject, jobjectArray, jobjectArray);
+
+/*
+ * Class:     org_theko_sound_backends_wasapi_WASAPISharedBackend
+ * Method:    nGetEnginePeriods
+ * Signature: (Lorg/theko/sound/AudioPort;Lorg/theko/sound/AudioFormat;)[I
+ */
+JNIEXPORT jintArray JNICALL Java_org_theko_sound_backends_wasapi_WASAPISharedBackend_nGetEnginePeriods
+  (JNIEnv *, jobject, jobject, jobject);
+
 #ifdef __cplusplus
 }
 #endif
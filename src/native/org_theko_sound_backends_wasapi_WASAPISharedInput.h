@@ -10,98 +10,146 @@ extern "C" {
 /*
  * Class:     org_theko_sound_backends_wasapi_WASAPISharedInput
  * Method:    nOpen
- * Signature: (Lorg/theko/sound/AudioPort;Lorg/theko/sound/AudioFormat;I)Lorg/theko/sound/AudioFormat;
+ * Signature: (Lorg/theko/sound/AudioPort;Lorg/theko/sound/AudioFormat;ILjava/util/concurrent/atomic/AtomicReference;Z)J
  */
-JNIEXPORT jobject JNICALL Java_org_theko_sound_backends_wasapi_WASAPISharedInput_nOpen
-  (JNIEnv *, jobject, jobject, jobject, jint);
+JNIEXPORT jlong JNICALL Java_org_theko_sound_backends_wasapi_WASAPISharedInput_nOpen
+  (JNIEnv *, jobject, jobject, jobject, jint, jobject, jboolean);
 
 /*
  * Class:     org_theko_sound_backends_wasapi_WASAPISharedInput
  * Method:    nClose
- * Signature: ()V
+ * Signature: (J)V
  */
 JNIEXPORT void JNICALL Java_org_theko_sound_backends_wasapi_WASAPISharedInput_nClose
-  (JNIEnv *, jobject);
+  (JNIEnv *, jobject, jlong);
 
 /*
  * Class:     org_theko_sound_backends_wasapi_WASAPISharedInput
  * Method:    nStart
- * Signature: ()V
+ * Signature: (J)V
  */
 JNIEXPORT void JNICALL Java_org_theko_sound_backends_wasapi_WASAPISharedInput_nStart
-  (JNIEnv *, jobject);
+  (JNIEnv *, jobject, jlong);
 
 /*
  * Class:     org_theko_sound_backends_wasapi_WASAPISharedInput
  * Method:    nStop
- * Signature: ()V
+ * Signature: (J)V
  */
 JNIEXPORT void JNICALL Java_org_theko_sound_backends_wasapi_WASAPISharedInput_nStop
-  (JNIEnv *, jobject);
+  (JNIEnv *, jobject, jlong);
 
 /*
  * Class:     org_theko_sound_backends_wasapi_WASAPISharedInput
  * Method:    nFlush
- * Signature: ()V
+ * Signature: (J)V
  */
 JNIEXPORT void JNICALL Java_org_theko_sound_backends_wasapi_WASAPISharedInput_nFlush
-  (JNIEnv *, jobject);
+  (JNIEnv *, jobject, jlong);
 
 /*
  * Class:     org_theko_sound_backends_wasapi_WASAPISharedInput
  * Method:    nDrain
- * Signature: ()V
+ * Signature: (J)V
  */
 JNIEXPORT void JNICALL Java_org_theko_sound_backends_wasapi_WASAPISharedInput_nDrain
-  (JNIEnv *, jobject);
+  (JNIEnv *, jobject, jlong);
 
 /*
  * Class:     org_theko_sound_backends_wasapi_WASAPISharedInput
  * Method:    nRead
- * Signature: ([BII)I
+ * Signature: (J[BII)I
  */
 JNIEXPORT jint JNICALL Java_org_theko_sound_backends_wasapi_WASAPISharedInput_nRead
-  (JNIEnv *, jobject, jbyteArray, jint, jint);
+  (JNIEnv *, jobject, jlong, jbyteArray, jint, jint);
+
+/*
+ * Class:     org_theko_sound_backends_wasapi_WASAPISharedInput
+ * Method:    nReadDirect
+ * Signature: (JLjava/nio/ByteBuffer;II)I
+ */
+JNIEXPORT jint JNICALL Java_org_theko_sound_backends_wasapi_WASAPISharedInput_nReadDirect
+  (JNIEnv *, jobject, jlong, jobject, jint, jint);
+
+/*
+ * Class:     org_theko_sound_backends_wasapi_WASAPISharedInput
+ * Method:    nWaitForData
+ * Signature: (JI)Z
+ */
+JNIEXPORT jboolean JNICALL Java_org_theko_sound_backends_wasapi_WASAPISharedInput_nWaitForData
+  (JNIEnv *, jobject, jlong, jint);
 
 /*
  * Class:     org_theko_sound_backends_wasapi_WASAPISharedInput
  * Method:    nAvailable
- * Signature: ()I
+ * Signature: (J)I
  */
 JNIEXPORT jint JNICALL Java_org_theko_sound_backends_wasapi_WASAPISharedInput_nAvailable
-  (JNIEnv *, jobject);
+  (JNIEnv *, jobject, jlong);
 
 /*
  * Class:     org_theko_sound_backends_wasapi_WASAPISharedInput
  * Method:    nGetBufferSize
- * Signature: ()I
+ * Signature: (J)I
  */
 JNIEXPORT jint JNICALL Java_org_theko_sound_backends_wasapi_WASAPISharedInput_nGetBufferSize
-  (JNIEnv *, jobject);
+  (JNIEnv *, jobject, jlong);
 
 /*
  * Class:     org_theko_sound_backends_wasapi_WASAPISharedInput
  * Method:    nGetFramePosition
- * Signature: ()J
+ * Signature: (J)J
  */
 JNIEXPORT jlong JNICALL Java_org_theko_sound_backends_wasapi_WASAPISharedInput_nGetFramePosition
-  (JNIEnv *, jobject);
+  (JNIEnv *, jobject, jlong);
 
 /*
  * Class:     org_theko_sound_backends_wasapi_WASAPISharedInput
  * Method:    nGetMicrosecondLatency
- * Signature: ()J
+ * Signature: (J)J
  */
 JNIEXPORT jlong JNICALL Java_org_theko_sound_backends_wasapi_WASAPISharedInput_nGetMicrosecondLatency
-  (JNIEnv *, jobject);
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     org_theko_sound_backends_wasapi_WASAPISharedInput
+ * Method:    nGetPeriodFrames
+ * Signature: (J)I
+ */
+JNIEXPORT jint JNICALL Java_org_theko_sound_backends_wasapi_WASAPISharedInput_nGetPeriodFrames
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     org_theko_sound_backends_wasapi_WASAPISharedInput
+ * Method:    nGetDiscontinuityCount
+ * Signature: (J)J
+ */
+JNIEXPORT jlong JNICALL Java_org_theko_sound_backends_wasapi_WASAPISharedInput_nGetDiscontinuityCount
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     org_theko_sound_backends_wasapi_WASAPISharedInput
+ * Method:    nGetDroppedFrames
+ * Signature: (J)J
+ */
+JNIEXPORT jlong JNICALL Java_org_theko_sound_backends_wasapi_WASAPISharedInput_nGetDroppedFrames
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     org_theko_sound_backends_wasapi_WASAPISharedInput
+ * Method:    nGetTelemetryBuffer
+ * Signature: (J)Ljava/nio/ByteBuffer;
+ */
+JNIEXPORT jobject JNICALL Java_org_theko_sound_backends_wasapi_WASAPISharedInput_nGetTelemetryBuffer
+  (JNIEnv *, jobject, jlong);
 
 /*
  * Class:     org_theko_sound_backends_wasapi_WASAPISharedInput
  * Method:    nGetCurrentAudioPort
- * Signature: ()Lorg/theko/sound/AudioPort;
+ * Signature: (J)Lorg/theko/sound/AudioPort;
  */
 JNIEXPORT jobject JNICALL Java_org_theko_sound_backends_wasapi_WASAPISharedInput_nGetCurrentAudioPort
-  (JNIEnv *, jobject);
+  (JNIEnv *, jobject, jlong);
 
 #ifdef __cplusplus
 }
@@ -10,10 +10,10 @@ extern "C" {
 /*
  * Class:     org_theko_sound_backends_wasapi_WASAPISharedOutput
  * Method:    nOpen
- * Signature: (Lorg/theko/sound/AudioPort;Lorg/theko/sound/AudioFormat;ILjava/util/concurrent/atomic/AtomicReference;)J
+ * Signature: (Lorg/theko/sound/AudioPort;Lorg/theko/sound/AudioFormat;ILjava/util/concurrent/atomic/AtomicReference;ZZZ)J
  */
 JNIEXPORT jlong JNICALL Java_org_theko_sound_backends_wasapi_WASAPISharedOutput_nOpen
-  (JNIEnv *, jobject, jobject, jobject, jint, jobject);
+  (JNIEnv *, jobject, jobject, jobject, jint, jobject, jboolean, jboolean, jboolean);
 
 /*
  * Class:     org_theko_sound_backends_wasapi_WASAPISharedOutput
@@ -26,10 +26,10 @@ JNIEXPORT void JNICALL Java_org_theko_sound_backends_wasapi_WASAPISharedOutput_n
 /*
  * Class:     org_theko_sound_backends_wasapi_WASAPISharedOutput
  * Method:    nStart
- * Signature: (J)V
+ * Signature: (JLorg/theko/sound/backends/AudioRenderCallback;)V
  */
 JNIEXPORT void JNICALL Java_org_theko_sound_backends_wasapi_WASAPISharedOutput_nStart
-  (JNIEnv *, jobject, jlong);
+  (JNIEnv *, jobject, jlong, jobject);
 
 /*
  * Class:     org_theko_sound_backends_wasapi_WASAPISharedOutput
@@ -63,6 +63,22 @@ JNIEXPORT void JNICALL Java_org_theko_sound_backends_wasapi_WASAPISharedOutput_n
 JNIEXPORT jint JNICALL Java_org_theko_sound_backends_wasapi_WASAPISharedOutput_nWrite
   (JNIEnv *, jobject, jlong, jbyteArray, jint, jint);
 
+/*
+ * Class:     org_theko_sound_backends_wasapi_WASAPISharedOutput
+ * Method:    nWriteDirect
+ * Signature: (JLjava/nio/ByteBuffer;II)I
+ */
+JNIEXPORT jint JNICALL Java_org_theko_sound_backends_wasapi_WASAPISharedOutput_nWriteDirect
+  (JNIEnv *, jobject, jlong, jobject, jint, jint);
+
+/*
+ * Class:     org_theko_sound_backends_wasapi_WASAPISharedOutput
+ * Method:    nWriteFloat
+ * Signature: (J[[FII)I
+ */
+JNIEXPORT jint JNICALL Java_org_theko_sound_backends_wasapi_WASAPISharedOutput_nWriteFloat
+  (JNIEnv *, jobject, jlong, jobjectArray, jint, jint);
+
 /*
  * Class:     org_theko_sound_backends_wasapi_WASAPISharedOutput
  * Method:    nAvailable
@@ -87,6 +103,30 @@ JNIEXPORT jint JNICALL Java_org_theko_sound_backends_wasapi_WASAPISharedOutput_n
 JNIEXPORT jlong JNICALL Java_org_theko_sound_backends_wasapi_WASAPISharedOutput_nGetFramePosition
   (JNIEnv *, jobject, jlong);
 
+/*
+ * Class:     org_theko_sound_backends_wasapi_WASAPISharedOutput
+ * Method:    nGetClockBuffer
+ * Signature: (J)Ljava/nio/ByteBuffer;
+ */
+JNIEXPORT jobject JNICALL Java_org_theko_sound_backends_wasapi_WASAPISharedOutput_nGetClockBuffer
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     org_theko_sound_backends_wasapi_WASAPISharedOutput
+ * Method:    nGetTelemetryBuffer
+ * Signature: (J)Ljava/nio/ByteBuffer;
+ */
+JNIEXPORT jobject JNICALL Java_org_theko_sound_backends_wasapi_WASAPISharedOutput_nGetTelemetryBuffer
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     org_theko_sound_backends_wasapi_WASAPISharedOutput
+ * Method:    nUpdateClock
+ * Signature: (J)Z
+ */
+JNIEXPORT jboolean JNICALL Java_org_theko_sound_backends_wasapi_WASAPISharedOutput_nUpdateClock
+  (JNIEnv *, jobject, jlong);
+
 /*
  * Class:     org_theko_sound_backends_wasapi_WASAPISharedOutput
  * Method:    nGetMicrosecondLatency
@@ -95,6 +135,14 @@ JNIEXPORT jlong JNICALL Java_org_theko_sound_backends_wasapi_WASAPISharedOutput_
 JNIEXPORT jlong JNICALL Java_org_theko_sound_backends_wasapi_WASAPISharedOutput_nGetMicrosecondLatency
   (JNIEnv *, jobject, jlong);
 
+/*
+ * Class:     org_theko_sound_backends_wasapi_WASAPISharedOutput
+ * Method:    nGetPeriodFrames
+ * Signature: (J)I
+ */
+JNIEXPORT jint JNICALL Java_org_theko_sound_backends_wasapi_WASAPISharedOutput_nGetPeriodFrames
+  (JNIEnv *, jobject, jlong);
+
 /*
  * Class:     org_theko_sound_backends_wasapi_WASAPISharedOutput
  * Method:    nGetCurrentAudioPort
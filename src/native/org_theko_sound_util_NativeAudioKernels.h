@@ -0,0 +1,63 @@
+/* DO NOT EDIT THIS FILE - it is machine generated */
+#include <jni.h>
+/* Header for class org_theko_sound_util_NativeAudioKernels */
+
+#ifndef _Included_org_theko_sound_util_NativeAudioKernels
+#define _Included_org_theko_sound_util_NativeAudioKernels
+#ifdef __cplusplus
+extern "C" {
+#endif
+#undef org_theko_sound_util_NativeAudioKernels_MIN_NATIVE_LENGTH
+#define org_theko_sound_util_NativeAudioKernels_MIN_NATIVE_LENGTH 128L
+/*
+ * Class:     org_theko_sound_util_NativeAudioKernels
+ * Method:    nGetName
+ * Signature: ()Ljava/lang/String;
+ */
+JNIEXPORT jstring JNICALL Java_org_theko_sound_util_NativeAudioKernels_nGetName
+  (JNIEnv *, jclass);
+
+/*
+ * Class:     org_theko_sound_util_NativeAudioKernels
+ * Method:    nMixAdd
+ * Signature: ([F[FIF)V
+ */
+JNIEXPORT void JNICALL Java_org_theko_sound_util_NativeAudioKernels_nMixAdd
+  (JNIEnv *, jclass, jfloatArray, jfloatArray, jint, jfloat);
+
+/*
+ * Class:     org_theko_sound_util_NativeAudioKernels
+ * Method:    nScale
+ * Signature: ([F[FIF)V
+ */
+JNIEXPORT void JNICALL Java_org_theko_sound_util_NativeAudioKernels_nScale
+  (JNIEnv *, jclass, jfloatArray, jfloatArray, jint, jfloat);
+
+/*
+ * Class:     org_theko_sound_util_NativeAudioKernels
+ * Method:    nPeak
+ * Signature: ([FI)F
+ */
+JNIEXPORT jfloat JNICALL Java_org_theko_sound_util_NativeAudioKernels_nPeak
+  (JNIEnv *, jclass, jfloatArray, jint);
+
+/*
+ * Class:     org_theko_sound_util_NativeAudioKernels
+ * Method:    nSumSquares
+ * Signature: ([FI)D
+ */
+JNIEXPORT jdouble JNICALL Java_org_theko_sound_util_NativeAudioKernels_nSumSquares
+  (JNIEnv *, jclass, jfloatArray, jint);
+
+/*
+ * Class:     org_theko_sound_util_NativeAudioKernels
+ * Method:    nSumAbs
+ * Signature: ([FI)D
+ */
+JNIEXPORT jdouble JNICALL Java_org_theko_sound_util_NativeAudioKernels_nSumAbs
+  (JNIEnv *, jclass, jfloatArray, jint);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,403 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SAMPLE_CONVERSION_X86
+#endif
+
+/*
+ * Planar float -> interleaved device format conversion.
+ *
+ * Samples are clipped to [-1, 1]. Integer targets of 24 bits and less get TPDF dither
+ * of one LSB. Each channel is converted in small blocks into an L1-resident scratch
+ * buffer with the best available kernel (AVX2, SSE2 or scalar) and then scattered
+ * into the interleaved output, so source and destination are walked only once.
+ *
+ * The same dispatch provides the float accumulation kernel used to mix streams
+ * into one endpoint buffer (dst += src, without clipping).
+ */
+namespace theko::sound::conversion {
+
+enum class SampleType {
+    UNSUPPORTED,
+    INT16,
+    INT24, // Packed, 3 bytes
+    INT32,
+    FLOAT32
+};
+
+static inline uint32_t bytesPerSample(SampleType type) {
+    switch (type) {
+        case SampleType::INT16: return 2;
+        case SampleType::INT24: return 3;
+        case SampleType::INT32: return 4;
+        case SampleType::FLOAT32: return 4;
+        default: return 0;
+    }
+}
+
+/**
+ * Per-stream dither state: 8 lanes of xorshift32, so the SIMD kernels
+ * can generate one random value per sample without serial dependencies.
+ */
+struct DitherState {
+    alignas(32) uint32_t lanes[8];
+
+    explicit DitherState(uint32_t seed = 0x9E3779B9u) {
+        for (int i = 0; i < 8; i++) {
+            uint32_t s = seed ^ (0x68E31DA4u * (uint32_t)(i + 1));
+            lanes[i] = s ? s : 1;
+        }
+    }
+};
+
+// Largest float below 2^31, so the conversion to int32 cannot overflow
+static constexpr float INT32_SCALE = 2147483520.0f;
+static constexpr float INT24_SCALE = 8388607.0f;
+static constexpr float INT16_SCALE = 32767.0f;
+
+static constexpr size_t CONVERSION_BLOCK = 256; // frames
+
+/* ---------------------------------- Scalar ---------------------------------- */
+
+static inline uint32_t xorshift32(uint32_t& s) {
+    s ^= s << 13;
+    s ^= s >> 17;
+    s ^= s << 5;
+    return s;
+}
+
+// Uniform [0, 1) from the high 23 bits
+static inline float uniform01(uint32_t r) {
+    uint32_t bits = (r >> 9) | 0x3F800000u;
+    float f;
+    memcpy(&f, &bits, sizeof(f));
+    return f - 1.0f;
+}
+
+// Triangular noise in (-1, 1) LSB
+static inline float tpdf(uint32_t& s) {
+    float a = uniform01(xorshift32(s));
+    float b = uniform01(xorshift32(s));
+    return a - b;
+}
+
+static inline float clip(float v) {
+    return std::min(1.0f, std::max(-1.0f, v));
+}
+
+static void toFloatScalar(const float* src, float* dst, size_t n) {
+    for (size_t i = 0; i < n; i++) dst[i] = clip(src[i]);
+}
+
+static void toInt32Scalar(const float* src, int32_t* dst, size_t n, float scale, bool dither, DitherState& ds) {
+    uint32_t& s = ds.lanes[0];
+    for (size_t i = 0; i < n; i++) {
+        float v = clip(src[i]) * scale;
+        if (dither) v += tpdf(s);
+        v = std::min(scale, std::max(-scale, v));
+        dst[i] = (int32_t)lrintf(v);
+    }
+}
+
+static void toInt16Scalar(const float* src, int16_t* dst, size_t n, DitherState& ds) {
+    uint32_t& s = ds.lanes[0];
+    for (size_t i = 0; i < n; i++) {
+        float v = clip(src[i]) * INT16_SCALE + tpdf(s);
+        v = std::min(INT16_SCALE, std::max(-INT16_SCALE - 1.0f, v));
+        dst[i] = (int16_t)lrintf(v);
+    }
+}
+
+static void mixAddScalar(float* dst, const float* src, size_t n) {
+    for (size_t i = 0; i < n; i++) dst[i] += src[i];
+}
+
+#ifdef SAMPLE_CONVERSION_X86
+
+/* ----------------------------------- SSE2 ----------------------------------- */
+
+__attribute__((target("sse2")))
+static inline __m128i xorshift32x4(__m128i s) {
+    s = _mm_xor_si128(s, _mm_slli_epi32(s, 13));
+    s = _mm_xor_si128(s, _mm_srli_epi32(s, 17));
+    s = _mm_xor_si128(s, _mm_slli_epi32(s, 5));
+    return s;
+}
+
+__attribute__((target("sse2")))
+static inline __m128 uniform01x4(__m128i r) {
+    __m128i bits = _mm_or_si128(_mm_srli_epi32(r, 9), _mm_set1_epi32(0x3F800000));
+    return _mm_sub_ps(_mm_castsi128_ps(bits), _mm_set1_ps(1.0f));
+}
+
+__attribute__((target("sse2")))
+static void toFloatSSE2(const float* src, float* dst, size_t n) {
+    const __m128 lo = _mm_set1_ps(-1.0f), hi = _mm_set1_ps(1.0f);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 v = _mm_loadu_ps(src + i);
+        _mm_storeu_ps(dst + i, _mm_min_ps(hi, _mm_max_ps(lo, v)));
+    }
+    toFloatScalar(src + i, dst + i, n - i);
+}
+
+__attribute__((target("sse2")))
+static void toInt32SSE2(const float* src, int32_t* dst, size_t n, float scale, bool dither, DitherState& ds) {
+    const __m128 lo = _mm_set1_ps(-1.0f), hi = _mm_set1_ps(1.0f);
+    const __m128 vscale = _mm_set1_ps(scale), vmin = _mm_set1_ps(-scale);
+    __m128i s = _mm_load_si128((const __m128i*)ds.lanes);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 v = _mm_mul_ps(_mm_min_ps(hi, _mm_max_ps(lo, _mm_loadu_ps(src + i))), vscale);
+        if (dither) {
+            s = xorshift32x4(s);
+            __m128 a = uniform01x4(s);
+            s = xorshift32x4(s);
+            v = _mm_add_ps(v, _mm_sub_ps(a, uniform01x4(s)));
+            v = _mm_min_ps(vscale, _mm_max_ps(vmin, v));
+        }
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_cvtps_epi32(v));
+    }
+    _mm_store_si128((__m128i*)ds.lanes, s);
+    toInt32Scalar(src + i, dst + i, n - i, scale, dither, ds);
+}
+
+__attribute__((target("sse2")))
+static void toInt16SSE2(const float* src, int16_t* dst, size_t n, DitherState& ds) {
+    const __m128 lo = _mm_set1_ps(-1.0f), hi = _mm_set1_ps(1.0f);
+    const __m128 vscale = _mm_set1_ps(INT16_SCALE);
+    __m128i s = _mm_load_si128((const __m128i*)ds.lanes);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128 v0 = _mm_mul_ps(_mm_min_ps(hi, _mm_max_ps(lo, _mm_loadu_ps(src + i))), vscale);
+        __m128 v1 = _mm_mul_ps(_mm_min_ps(hi, _mm_max_ps(lo, _mm_loadu_ps(src + i + 4))), vscale);
+
+        s = xorshift32x4(s); __m128 a0 = uniform01x4(s);
+        s = xorshift32x4(s); __m128 b0 = uniform01x4(s);
+        s = xorshift32x4(s); __m128 a1 = uniform01x4(s);
+        s = xorshift32x4(s); __m128 b1 = uniform01x4(s);
+        v0 = _mm_add_ps(v0, _mm_sub_ps(a0, b0));
+        v1 = _mm_add_ps(v1, _mm_sub_ps(a1, b1));
+
+        // packs saturates to the int16 range
+        __m128i packed = _mm_packs_epi32(_mm_cvtps_epi32(v0), _mm_cvtps_epi32(v1));
+        _mm_storeu_si128((__m128i*)(dst + i), packed);
+    }
+    _mm_store_si128((__m128i*)ds.lanes, s);
+    toInt16Scalar(src + i, dst + i, n - i, ds);
+}
+
+__attribute__((target("sse2")))
+static void mixAddSSE2(float* dst, const float* src, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128 a0 = _mm_add_ps(_mm_loadu_ps(dst + i), _mm_loadu_ps(src + i));
+        __m128 a1 = _mm_add_ps(_mm_loadu_ps(dst + i + 4), _mm_loadu_ps(src + i + 4));
+        _mm_storeu_ps(dst + i, a0);
+        _mm_storeu_ps(dst + i + 4, a1);
+    }
+    mixAddScalar(dst + i, src + i, n - i);
+}
+
+/* ----------------------------------- AVX2 ----------------------------------- */
+
+__attribute__((target("avx2")))
+static inline __m256i xorshift32x8(__m256i s) {
+    s = _mm256_xor_si256(s, _mm256_slli_epi32(s, 13));
+    s = _mm256_xor_si256(s, _mm256_srli_epi32(s, 17));
+    s = _mm256_xor_si256(s, _mm256_slli_epi32(s, 5));
+    return s;
+}
+
+__attribute__((target("avx2")))
+static inline __m256 uniform01x8(__m256i r) {
+    __m256i bits = _mm256_or_si256(_mm256_srli_epi32(r, 9), _mm256_set1_epi32(0x3F800000));
+    return _mm256_sub_ps(_mm256_castsi256_ps(bits), _mm256_set1_ps(1.0f));
+}
+
+__attribute__((target("avx2")))
+static void toFloatAVX2(const float* src, float* dst, size_t n) {
+    const __m256 lo = _mm256_set1_ps(-1.0f), hi = _mm256_set1_ps(1.0f);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 v = _mm256_loadu_ps(src + i);
+        _mm256_storeu_ps(dst + i, _mm256_min_ps(hi, _mm256_max_ps(lo, v)));
+    }
+    toFloatScalar(src + i, dst + i, n - i);
+}
+
+__attribute__((target("avx2")))
+static void toInt32AVX2(const float* src, int32_t* dst, size_t n, float scale, bool dither, DitherState& ds) {
+    const __m256 lo = _mm256_set1_ps(-1.0f), hi = _mm256_set1_ps(1.0f);
+    const __m256 vscale = _mm256_set1_ps(scale), vmin = _mm256_set1_ps(-scale);
+    __m256i s = _mm256_load_si256((const __m256i*)ds.lanes);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 v = _mm256_mul_ps(_mm256_min_ps(hi, _mm256_max_ps(lo, _mm256_loadu_ps(src + i))), vscale);
+        if (dither) {
+            s = xorshift32x8(s);
+            __m256 a = uniform01x8(s);
+            s = xorshift32x8(s);
+            v = _mm256_add_ps(v, _mm256_sub_ps(a, uniform01x8(s)));
+            v = _mm256_min_ps(vscale, _mm256_max_ps(vmin, v));
+        }
+        _mm256_storeu_si256((__m256i*)(dst + i), _mm256_cvtps_epi32(v));
+    }
+    _mm256_store_si256((__m256i*)ds.lanes, s);
+    _mm256_zeroupper();
+    toInt32Scalar(src + i, dst + i, n - i, scale, dither, ds);
+}
+
+__attribute__((target("avx2")))
+static void toInt16AVX2(const float* src, int16_t* dst, size_t n, DitherState& ds) {
+    const __m256 lo = _mm256_set1_ps(-1.0f), hi = _mm256_set1_ps(1.0f);
+    const __m256 vscale = _mm256_set1_ps(INT16_SCALE);
+    __m256i s = _mm256_load_si256((const __m256i*)ds.lanes);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256 v0 = _mm256_mul_ps(_mm256_min_ps(hi, _mm256_max_ps(lo, _mm256_loadu_ps(src + i))), vscale);
+        __m256 v1 = _mm256_mul_ps(_mm256_min_ps(hi, _mm256_max_ps(lo, _mm256_loadu_ps(src + i + 8))), vscale);
+
+        s = xorshift32x8(s); __m256 a0 = uniform01x8(s);
+        s = xorshift32x8(s); __m256 b0 = uniform01x8(s);
+        s = xorshift32x8(s); __m256 a1 = uniform01x8(s);
+        s = xorshift32x8(s); __m256 b1 = uniform01x8(s);
+        v0 = _mm256_add_ps(v0, _mm256_sub_ps(a0, b0));
+        v1 = _mm256_add_ps(v1, _mm256_sub_ps(a1, b1));
+
+        // packs works per 128-bit lane, restore the sample order afterwards
+        __m256i packed = _mm256_packs_epi32(_mm256_cvtps_epi32(v0), _mm256_cvtps_epi32(v1));
+        packed = _mm256_permute4x64_epi64(packed, _MM_SHUFFLE(3, 1, 2, 0));
+        _mm256_storeu_si256((__m256i*)(dst + i), packed);
+    }
+    _mm256_store_si256((__m256i*)ds.lanes, s);
+    _mm256_zeroupper();
+    toInt16Scalar(src + i, dst + i, n - i, ds);
+}
+
+__attribute__((target("avx2")))
+static void mixAddAVX2(float* dst, const float* src, size_t n) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256 a0 = _mm256_add_ps(_mm256_loadu_ps(dst + i), _mm256_loadu_ps(src + i));
+        __m256 a1 = _mm256_add_ps(_mm256_loadu_ps(dst + i + 8), _mm256_loadu_ps(src + i + 8));
+        _mm256_storeu_ps(dst + i, a0);
+        _mm256_storeu_ps(dst + i + 8, a1);
+    }
+    _mm256_zeroupper();
+    mixAddScalar(dst + i, src + i, n - i);
+}
+
+#endif // SAMPLE_CONVERSION_X86
+
+/* --------------------------------- Dispatch --------------------------------- */
+
+struct ConversionKernels {
+    void (*toFloat)(const float*, float*, size_t);
+    void (*toInt32)(const float*, int32_t*, size_t, float, bool, DitherState&);
+    void (*toInt16)(const float*, int16_t*, size_t, DitherState&);
+    void (*mixAdd)(float*, const float*, size_t);
+    const char* name;
+};
+
+static const ConversionKernels& getConversionKernels() {
+    static const ConversionKernels kernels = []() -> ConversionKernels {
+#ifdef SAMPLE_CONVERSION_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return { toFloatAVX2, toInt32AVX2, toInt16AVX2, mixAddAVX2, "AVX2" };
+        }
+        if (__builtin_cpu_supports("sse2")) {
+            return { toFloatSSE2, toInt32SSE2, toInt16SSE2, mixAddSSE2, "SSE2" };
+        }
+#endif
+        return { toFloatScalar, toInt32Scalar, toInt16Scalar, mixAddScalar, "scalar" };
+    }();
+    return kernels;
+}
+
+/**
+ * Converts planar float samples into interleaved samples of the given type.
+ *
+ * @param type The output sample type
+ * @param planar Channel pointers, each pointing at the first frame to convert
+ * @param channels The number of channels
+ * @param frames The number of frames to convert
+ * @param dst The interleaved output, at least {@code frames * channels * bytesPerSample(type)} bytes
+ * @param dither The stream's dither state
+ */
+static void planarToInterleaved(
+    SampleType type, const float* const* planar, uint32_t channels,
+    size_t frames, uint8_t* dst, DitherState& dither
+) {
+    const ConversionKernels& k = getConversionKernels();
+    const uint32_t bps = bytesPerSample(type);
+    const size_t frameBytes = (size_t)bps * channels;
+
+    alignas(32) int32_t scratch[CONVERSION_BLOCK];
+
+    for (size_t f0 = 0; f0 < frames; f0 += CONVERSION_BLOCK) {
+        size_t n = std::min(CONVERSION_BLOCK, frames - f0);
+        uint8_t* block = dst + f0 * frameBytes;
+
+        for (uint32_t ch = 0; ch < channels; ch++) {
+            const float* src = planar[ch] + f0;
+            uint8_t* out = block + (size_t)ch * bps;
+
+            switch (type) {
+                case SampleType::FLOAT32: {
+                    float* tmp = (float*)scratch;
+                    k.toFloat(src, tmp, n);
+                    for (size_t i = 0; i < n; i++) memcpy(out + i * frameBytes, tmp + i, 4);
+                    break;
+                }
+                case SampleType::INT32:
+                    k.toInt32(src, scratch, n, INT32_SCALE, false, dither);
+                    for (size_t i = 0; i < n; i++) memcpy(out + i * frameBytes, scratch + i, 4);
+                    break;
+                case SampleType::INT24:
+                    k.toInt32(src, scratch, n, INT24_SCALE, true, dither);
+                    for (size_t i = 0; i < n; i++) {
+                        uint8_t* p = out + i * frameBytes;
+                        int32_t v = scratch[i];
+                        p[0] = (uint8_t)v;
+                        p[1] = (uint8_t)(v >> 8);
+                        p[2] = (uint8_t)(v >> 16);
+                    }
+                    break;
+                case SampleType::INT16: {
+                    int16_t* tmp = (int16_t*)scratch;
+                    k.toInt16(src, tmp, n, dither);
+                    for (size_t i = 0; i < n; i++) memcpy(out + i * frameBytes, tmp + i, 2);
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+    }
+}
+
+} // namespace theko::sound::conversion
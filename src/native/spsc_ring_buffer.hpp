@@ -0,0 +1,175 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+
+/**
+ * Lock-free single-producer/single-consumer byte ring buffer.
+ *
+ * Only one thread may call the producer methods (write, availableToWrite, getWritePosition) and only
+ * one thread may call the consumer methods (read, discard, discardTo, availableToRead).
+ * Positions run in [0, 2 * capacity), so full and empty states are distinguishable
+ * without a spare slot and without 64-bit atomics on 32-bit targets.
+ */
+class SpscRingBuffer {
+private:
+    uint8_t* data = nullptr;
+    size_t capacity = 0;
+
+    alignas(64) std::atomic<size_t> writePos{0}; // Owned by the producer
+    alignas(64) std::atomic<size_t> readPos{0};  // Owned by the consumer
+
+    inline size_t fill(size_t w, size_t r) const {
+        return w >= r ? w - r : w + 2 * capacity - r;
+    }
+
+    inline size_t advance(size_t pos, size_t n) const {
+        pos += n;
+        return pos >= 2 * capacity ? pos - 2 * capacity : pos;
+    }
+
+    inline size_t offsetOf(size_t pos) const {
+        return pos >= capacity ? pos - capacity : pos;
+    }
+
+public:
+    SpscRingBuffer() = default;
+    SpscRingBuffer(const SpscRingBuffer&) = delete;
+    SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+    ~SpscRingBuffer() {
+        if (data) free(data);
+    }
+
+    /**
+     * Allocates the storage. Must be called before the producer and consumer threads start.
+     * @param bytes The capacity in bytes
+     * @return True if the allocation succeeded
+     */
+    bool allocate(size_t bytes) {
+        if (data) free(data);
+        data = bytes > 0 ? (uint8_t*)malloc(bytes) : nullptr;
+        capacity = data ? bytes : 0;
+        writePos.store(0, std::memory_order_relaxed);
+        readPos.store(0, std::memory_order_relaxed);
+        return data != nullptr;
+    }
+
+    inline size_t getCapacity() const {
+        return capacity;
+    }
+
+    inline size_t availableToRead() const {
+        return fill(writePos.load(std::memory_order_acquire), readPos.load(std::memory_order_relaxed));
+    }
+
+    inline size_t availableToWrite() const {
+        return capacity - fill(writePos.load(std::memory_order_relaxed), readPos.load(std::memory_order_acquire));
+    }
+
+    /**
+     * Copies up to {@code length} bytes into the buffer with the given copy function,
+     * called once or twice (on wrap) as {@code copy(dst, srcOffset, count)}.
+     * @return The number of bytes written
+     */
+    template <typename CopyFn>
+    size_t writeWith(size_t length, CopyFn copy) {
+        size_t w = writePos.load(std::memory_order_relaxed);
+        size_t r = readPos.load(std::memory_order_acquire);
+        size_t count = std::min(length, capacity - fill(w, r));
+        if (count == 0) return 0;
+
+        size_t offset = offsetOf(w);
+        size_t first = std::min(count, capacity - offset);
+        copy(data + offset, (size_t)0, first);
+        if (count > first) {
+            copy(data, first, count - first);
+        }
+
+        writePos.store(advance(w, count), std::memory_order_release);
+        return count;
+    }
+
+    size_t write(const void* src, size_t length) {
+        const uint8_t* bytes = (const uint8_t*)src;
+        return writeWith(length, [bytes](uint8_t* dst, size_t srcOffset, size_t count) {
+            memcpy(dst, bytes + srcOffset, count);
+        });
+    }
+
+    /**
+     * Passes up to {@code length} bytes out of the buffer to the given copy function,
+     * called once or twice (on wrap) as {@code copy(src, dstOffset, count)}.
+     * The bytes are consumed when the function returns.
+     * @return The number of bytes read
+     */
+    template <typename CopyFn>
+    size_t readWith(size_t length, CopyFn copy) {
+        size_t r = readPos.load(std::memory_order_relaxed);
+        size_t w = writePos.load(std::memory_order_acquire);
+        size_t count = std::min(length, fill(w, r));
+        if (count == 0) return 0;
+
+        size_t offset = offsetOf(r);
+        size_t first = std::min(count, capacity - offset);
+        copy((const uint8_t*)data + offset, (size_t)0, first);
+        if (count > first) {
+            copy((const uint8_t*)data, first, count - first);
+        }
+
+        readPos.store(advance(r, count), std::memory_order_release);
+        return count;
+    }
+
+    size_t read(void* dst, size_t length) {
+        uint8_t* out = (uint8_t*)dst;
+        return readWith(length, [out](const uint8_t* src, size_t dstOffset, size_t count) {
+            memcpy(out + dstOffset, src, count);
+        });
+    }
+
+    /**
+     * Drops all buffered data. Consumer side only.
+     */
+    void discard() {
+        readPos.store(writePos.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+    /**
+     * Returns the current write position, to mark the data written so far. Producer side only.
+     */
+    inline size_t getWritePosition() const {
+        return writePos.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Drops the buffered data up to a position returned by getWritePosition, keeping
+     * the data written after it. Does nothing if that data was already read. Consumer side only.
+     */
+    void discardTo(size_t position) {
+        size_t r = readPos.load(std::memory_order_relaxed);
+        size_t w = writePos.load(std::memory_order_acquire);
+        if (fill(position, r) <= fill(w, r)) {
+            readPos.store(position, std::memory_order_release);
+        }
+    }
+};
@@ -0,0 +1,168 @@
+/*
+ * Copyright 2025-present Alex Soloviov (aka Theko)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+#include <chrono>
+
+/**
+ * Glitch counters and timing histograms of a stream, written by its render or capture thread
+ * and read without locks, also from Java through a direct ByteBuffer.
+ *
+ * The memory is an array of little-endian 64-bit fields, indexed by Field. Every field has
+ * a single writer (the stream thread) and only grows, so readers need no sequence: a reader
+ * sees each field up to date on its own, fields read together may be one period apart.
+ *
+ * Time histograms have log2 buckets: bucket 0 counts values below 1 us, bucket i counts
+ * values in [2^(i-1), 2^i) us, the last bucket is open-ended. The padding histogram has
+ * linear buckets: bucket i counts wake-ups with padding in [i, i + 1) / BUCKETS of BUFFER_FRAMES.
+ */
+class StreamTelemetry {
+public:
+    static constexpr size_t BUCKETS = 16;
+
+    enum Field {
+        PERIODS,                // Buffer events handled
+        GLITCHES,               // Output: periods the ring could not fill (underruns). Input: discontinuities and ring overflows
+        SILENT_BUFFERS,         // Output: periods released as silence. Input: packets flagged as silent
+        WAKE_TIMEOUTS,          // Waits that timed out without a buffer event
+        DEVICE_INVALIDATIONS,   // Stream threads stopped by an invalidated device
+        MAX_WAKE_JITTER,        // In nanoseconds
+        MAX_BUFFER_TIME,        // GetBuffer to ReleaseBuffer, in nanoseconds
+        BUFFER_FRAMES,          // Endpoint buffer size, the scale of PADDING_HISTOGRAM
+        PERIOD_TIME,            // Expected interval between wake-ups, in nanoseconds
+        WAKE_JITTER_HISTOGRAM,
+        PADDING_HISTOGRAM = WAKE_JITTER_HISTOGRAM + BUCKETS,
+        BUFFER_TIME_HISTOGRAM = PADDING_HISTOGRAM + BUCKETS,
+        FIELD_COUNT = BUFFER_TIME_HISTOGRAM + BUCKETS
+    };
+
+private:
+    static_assert(sizeof(std::atomic<int64_t>) == sizeof(int64_t), "Unexpected atomic layout");
+
+    alignas(64) std::atomic<int64_t> fields[FIELD_COUNT];
+
+    int64_t lastWake;   // Stream thread only
+
+    // Single writer: a plain read-modify-write, no locked instruction
+    inline void add(size_t field, int64_t value) {
+        fields[field].store(fields[field].load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    inline void raiseMax(size_t field, int64_t value) {
+        if (value > fields[field].load(std::memory_order_relaxed)) {
+            fields[field].store(value, std::memory_order_relaxed);
+        }
+    }
+
+    static inline size_t timeBucket(int64_t nanos) {
+        uint64_t micros = nanos > 0 ? (uint64_t)nanos / 1000 : 0;
+        size_t bucket = 0;
+        while (micros != 0 && bucket < BUCKETS - 1) {
+            micros >>= 1;
+            bucket++;
+        }
+        return bucket;
+    }
+
+public:
+    StreamTelemetry() : lastWake(0) {
+        for (size_t i = 0; i < FIELD_COUNT; i++) {
+            fields[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    StreamTelemetry(const StreamTelemetry&) = delete;
+    StreamTelemetry& operator=(const StreamTelemetry&) = delete;
+
+    static inline int64_t now() {
+        return (int64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /**
+     * Sets the scales of the histograms. Called before the stream thread starts.
+     */
+    void configure(uint32_t bufferFrames, uint32_t periodFrames, uint32_t sampleRate) {
+        fields[BUFFER_FRAMES].store(bufferFrames, std::memory_order_relaxed);
+        fields[PERIOD_TIME].store(sampleRate ? (int64_t)periodFrames * 1000000000LL / sampleRate : 0,
+                                  std::memory_order_relaxed);
+        lastWake = 0;
+    }
+
+    /**
+     * Records a buffer event: the deviation of the interval since the previous one
+     * from the period, and the padding (frames queued in the endpoint) found at the wake-up.
+     */
+    void onWake(int64_t wakeTime, uint32_t padding) {
+        add(PERIODS, 1);
+        if (lastWake != 0) {
+            int64_t jitter = (wakeTime - lastWake) - fields[PERIOD_TIME].load(std::memory_order_relaxed);
+            if (jitter < 0) jitter = -jitter;
+            add(WAKE_JITTER_HISTOGRAM + timeBucket(jitter), 1);
+            raiseMax(MAX_WAKE_JITTER, jitter);
+        }
+        lastWake = wakeTime;
+
+        int64_t bufferFrames = fields[BUFFER_FRAMES].load(std::memory_order_relaxed);
+        if (bufferFrames > 0) {
+            int64_t bucket = (int64_t)padding * (int64_t)BUCKETS / bufferFrames;
+            add(PADDING_HISTOGRAM + (size_t)(bucket < (int64_t)BUCKETS ? bucket : BUCKETS - 1), 1);
+        }
+    }
+
+    /**
+     * Records a timeout. The next wake-up is not compared to the one before it.
+     */
+    void onWakeTimeout() {
+        add(WAKE_TIMEOUTS, 1);
+        lastWake = 0;
+    }
+
+    /**
+     * Records the time from GetBuffer to ReleaseBuffer.
+     */
+    void onBufferReleased(int64_t bufferTime) {
+        add(BUFFER_TIME_HISTOGRAM + timeBucket(bufferTime), 1);
+        raiseMax(MAX_BUFFER_TIME, bufferTime);
+    }
+
+    inline void onGlitch() {
+        add(GLITCHES, 1);
+    }
+
+    inline void onSilentBuffer() {
+        add(SILENT_BUFFERS, 1);
+    }
+
+    inline void onDeviceInvalidated() {
+        add(DEVICE_INVALIDATIONS, 1);
+    }
+
+    /**
+     * @return The field memory, to be wrapped into a direct ByteBuffer
+     */
+    inline void* data() {
+        return (void*)fields;
+    }
+
+    static constexpr size_t size() {
+        return sizeof(int64_t) * FIELD_COUNT;
+    }
+};
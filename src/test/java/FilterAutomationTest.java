@@ -0,0 +1,101 @@
+import java.util.List;
+
+import org.theko.sound.Automation;
+import org.theko.sound.controls.AudioControl;
+import org.theko.sound.dsp.BiquadFilter;
+import org.theko.sound.dsp.FilterType;
+import org.theko.sound.effects.AudioFilterEffect;
+
+/**
+ * Tests that a render-synchronous {@link Automation} of a filter cutoff changes the filter output.
+ * <p>
+ * The automation sets a block ramp on the cutoff, which dispatches no events, so the
+ * filters have to see the change by polling the control. A 5 kHz sine is filtered
+ * while the cutoff of a lowpass falls from 20 kHz to 200 Hz, then the level of the last
+ * block is compared with the level of the same filter without automation.
+ */
+public class FilterAutomationTest {
+
+    private static final int SAMPLE_RATE = 48000;
+    private static final int BLOCK = 512;
+    private static final int BLOCKS = 100;
+    private static final float FREQUENCY = 5000;
+
+    private interface BlockProcessor {
+        void process(float[][] block);
+    }
+
+    public static void main(String[] args) {
+        System.out.println("Testing automated BiquadFilter cutoff");
+        BiquadFilter reference = new BiquadFilter(FilterType.LOWPASS, 2);
+        reference.getCutoff().setValue(20000);
+        BiquadFilter filter = new BiquadFilter(FilterType.LOWPASS, 2);
+        Automation automation = createAutomation(filter.getCutoff());
+        float referenceRms = render(block -> reference.process(block, SAMPLE_RATE), null);
+        float automatedRms = render(block -> filter.process(block, SAMPLE_RATE), automation);
+        report(1, referenceRms, automatedRms);
+
+        System.out.println("Testing automated AudioFilterEffect cutoff");
+        AudioFilterEffect<BiquadFilter> referenceEffect = createEffect();
+        referenceEffect.getCutoffControl().setValue(20000);
+        AudioFilterEffect<BiquadFilter> effect = createEffect();
+        automation = createAutomation(effect.getCutoffControl());
+        referenceRms = render(block -> referenceEffect.effectRender(block, SAMPLE_RATE), null);
+        automatedRms = render(block -> effect.effectRender(block, SAMPLE_RATE), automation);
+        report(2, referenceRms, automatedRms);
+    }
+
+    private static Automation createAutomation(AudioControl cutoff) {
+        Automation automation = new Automation(List.of(cutoff));
+        automation.addKeypoint(0.0f, 20000, 0);
+        automation.addKeypoint(0.5f, 200, 0);
+        automation.setRenderSynchronous(true);
+        automation.play();
+        return automation;
+    }
+
+    private static AudioFilterEffect<BiquadFilter> createEffect() {
+        AudioFilterEffect<BiquadFilter> effect = new AudioFilterEffect<>(BiquadFilter.class);
+        effect.getLowPassControl().setValue(1.0f);
+        effect.getHighPassControl().setValue(0.0f);
+        effect.getBandPassControl().setValue(0.0f);
+        return effect;
+    }
+
+    /**
+     * Filters the sine block by block and returns the RMS of the last block.
+     */
+    private static float render(BlockProcessor processor, Automation automation) {
+        float[][] block = new float[2][BLOCK];
+        double phase = 0;
+        float rms = 0;
+        for (int b = 0; b < BLOCKS; b++) {
+            for (int i = 0; i < BLOCK; i++) {
+                float sample = (float) Math.sin(phase);
+                block[0][i] = sample;
+                block[1][i] = sample;
+                phase += 2 * Math.PI * FREQUENCY / SAMPLE_RATE;
+            }
+            if (automation != null) {
+                automation.renderBlock(BLOCK, SAMPLE_RATE);
+            }
+            processor.process(block);
+
+            double sum = 0;
+            for (int i = 0; i < BLOCK; i++) {
+                sum += block[0][i] * block[0][i];
+            }
+            rms = (float) Math.sqrt(sum / BLOCK);
+        }
+        return rms;
+    }
+
+    private static void report(int test, float referenceRms, float automatedRms) {
+        System.out.println("Reference RMS: " + referenceRms + ", automated RMS: " + automatedRms);
+        if (automatedRms < referenceRms * 0.1f) {
+            System.out.println("Passed #" + test);
+        } else {
+            System.out.println("Failed #" + test);
+        }
+    }
+}
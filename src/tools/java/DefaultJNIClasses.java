@@ -18,6 +18,7 @@ import java.io.IOException;
 import java.nio.file.Files;
 import java.nio.file.Path;
 import java.nio.file.StandardOpenOption;
+import java.util.List;
 import java.util.Set;
 
 public class DefaultJNIClasses {
@@ -38,19 +39,27 @@ public class DefaultJNIClasses {
             new ClassInfo(org.theko.sound.UnsupportedAudioEncodingException.class, "ThekoSound_UnsupportedAudioEncodingException"),
             new ClassInfo(org.theko.sound.UnsupportedAudioFormatException.class, "ThekoSound_UnsupportedAudioFormatException"),
             new ClassInfo(org.theko.sound.backends.AudioBackendException.class, "ThekoSound_AudioBackendException"),
+            new ClassInfo(org.theko.sound.backends.AudioRenderCallback.class, "ThekoSound_AudioRenderCallback"),
             new ClassInfo(org.theko.sound.backends.DeviceInactiveException.class, "ThekoSound_DeviceInactiveException"),
             new ClassInfo(org.theko.sound.backends.DeviceInvalidatedException.class, "ThekoSound_DeviceInvalidatedException"),
             new ClassInfo(org.theko.sound.backends.PortNotFoundException.class, "ThekoSound_PortNotFoundException"),
             new ClassInfo(org.theko.sound.backends.wasapi.WASAPIPortHandle.class, "ThekoSound_WASAPIPortHandle")
         );
 
-        classes.stream()
+        List<ClassInfo> sorted = classes.stream()
             .sorted((a, b) -> a.cls.getCanonicalName().compareTo(b.cls.getCanonicalName()))
-            .forEach(info -> {
-                String path = "src/native/cache/" + info.outName + ".hpp";
-                System.out.println("Generating: " + info.cls.getCanonicalName() + " -> " + path);
-                writeString(path, JNIClassCacheGenerator.generate(info.cls, info.outName));
-            });
+            .toList();
+
+        sorted.forEach(info -> {
+            String path = "src/native/cache/" + info.outName + ".hpp";
+            System.out.println("Generating: " + info.cls.getCanonicalName() + " -> " + path);
+            writeString(path, JNIClassCacheGenerator.generate(info.cls, info.outName, true));
+        });
+
+        String registryPath = "src/native/cache/JNI_CacheRegistry.hpp";
+        System.out.println("Generating: cache registry -> " + registryPath);
+        writeString(registryPath, JNIClassCacheGenerator.generateRegistry(
+            sorted.stream().map(ClassInfo::outName).toList()));
     }
 
     private static void writeString(String filePath, String content) {
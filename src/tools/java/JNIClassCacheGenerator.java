@@ -88,6 +88,49 @@ public class JNIClassCacheGenerator {
             }
             """;
 
+    private static final String EAGER_SINGLETON_GET = """
+            // Published once the cache is valid, read without locking
+            static inline std::atomic<%1$s*> published{nullptr};
+
+            static %1$s* get(JNIEnv* env) {
+                %1$s* self = published.load(std::memory_order_acquire);
+                if (self) return self;
+                return getLocked(env);
+            }
+
+            // Lazy fallback, used until init(env) or the first access succeeds
+            static %1$s* getLocked(JNIEnv* env) {
+                if (!env) return nullptr;
+                static std::mutex mtx;
+                static std::unique_ptr<%1$s> instance;
+
+                std::lock_guard<std::mutex> lock(mtx);
+                if (!%1$s::jvm) {
+                    env->GetJavaVM(&%1$s::jvm);
+                }
+                if (!instance || !instance->isValid()) {
+                    instance.reset(new %1$s(env));
+                    if (instance->isValid()) {
+                        published.store(instance.get(), std::memory_order_release);
+                    }
+                }
+                return instance.get();
+            }
+
+            // Creates the cache eagerly, e.g. from JNI_OnLoad
+            static bool init(JNIEnv* env) {
+                %1$s* self = get(env);
+                return self && self->isValid();
+            }
+            """;
+
+    private static final String REGISTRY_HEADER = """
+            /*
+             * DO NOT EDIT THIS FILE - it is machine generated.
+             * Eager initialization of all JNI class caches.
+             */
+            """;
+
     private static final String CHECK_CODE = """
             if (!%s) {
                 if (clazz_local) env->DeleteLocalRef(clazz_local);
@@ -97,6 +140,20 @@ public class JNIClassCacheGenerator {
             """;
 
     public static String generate(Class<?> cls, String cppClassName) {
+        return generate(cls, cppClassName, false);
+    }
+
+    /**
+     * Generates the cache header for the class.
+     *
+     * @param cls The Java class
+     * @param cppClassName The C++ class name, or null to derive it from the Java class name
+     * @param eager If true, the cache can be created with {@code init(env)} (see {@link #generateRegistry})
+     *              and is then read through an atomic pointer without locking; the locked lazy
+     *              creation stays as the fallback
+     * @return The header source
+     */
+    public static String generate(Class<?> cls, String cppClassName, boolean eager) {
         StringBuilder sb = new StringBuilder();
         cppClassName = (cppClassName == null || cppClassName.isEmpty()) ? ("Java_" + sanitize(cls.getName())) : cppClassName;
         String jniClassName = cls.getName().replace('.', '/');
@@ -109,6 +166,7 @@ public class JNIClassCacheGenerator {
         sb.append(include("jni.h"));
         sb.append(include("mutex"));
         sb.append(include("memory"));
+        if (eager) sb.append(include("atomic"));
         sb.append("\n");
 
         // Class definition
@@ -121,7 +179,7 @@ public class JNIClassCacheGenerator {
         sb.append(multilineIndent(GET_JAVAVM, 2)).append("\n");
         sb.append(indent(2)).append("bool initialized = false; // True if all values are initialized\n\n");
         sb.append(indent(2)).append("// jclass cache\n");
-        sb.append(indent(2)).append("jclass clazz;\n");
+        sb.append(indent(2)).append("jclass clazz = nullptr;\n");
 
         // Fields of type jclass
         Field[] fields = cls.getDeclaredFields();
@@ -290,8 +348,12 @@ public class JNIClassCacheGenerator {
         sb.append(indent(2)).append("}\n\n");
 
         // Create get method to obtain singleton instance (thread-safe)
-        sb.append(multilineIndent(String.format(SINGLETON_GET,
-                cppClassName, cppClassName, cppClassName, cppClassName, cppClassName), 2));
+        if (eager) {
+            sb.append(multilineIndent(String.format(EAGER_SINGLETON_GET, cppClassName), 2));
+        } else {
+            sb.append(multilineIndent(String.format(SINGLETON_GET,
+                    cppClassName, cppClassName, cppClassName, cppClassName, cppClassName), 2));
+        }
         sb.append("\n");
 
         sb.append(indent(2)).append("// Getters\n");
@@ -519,6 +581,36 @@ public class JNIClassCacheGenerator {
         return sb.toString();
     }
 
+    /**
+     * Generates a header with {@code initJNICaches(env)}, which eagerly creates all given
+     * caches (generated with {@code eager = true}). Meant to be called from {@code JNI_OnLoad},
+     * where {@code FindClass} also resolves through the class loader of the library.
+     *
+     * @param cppClassNames The C++ class names of the caches
+     * @return The header source
+     */
+    public static String generateRegistry(List<String> cppClassNames) {
+        StringBuilder sb = new StringBuilder();
+        sb.append(REGISTRY_HEADER);
+        sb.append("#pragma once\n");
+        sb.append(include("jni.h"));
+        for (String name : cppClassNames) {
+            sb.append("#include \"cache/").append(name).append(".hpp\"\n");
+        }
+        sb.append("\n");
+
+        sb.append("// Returns the number of caches that failed to initialize; those stay lazy\n");
+        sb.append("static inline int initJNICaches(JNIEnv* env) {\n");
+        sb.append(indent(1)).append("int failed = 0;\n");
+        for (String name : cppClassNames) {
+            sb.append(indent(1)).append("if (!").append(name).append("::init(env)) failed++;\n");
+            sb.append(indent(1)).append("if (env->ExceptionCheck()) env->ExceptionClear();\n");
+        }
+        sb.append(indent(1)).append("return failed;\n");
+        sb.append("}\n");
+        return sb.toString();
+    }
+
     // Codegen helpers
 
     private static String include(String header) {